@@ -0,0 +1,711 @@
+/* benchmarks.c: performance measurement for Fuse
+   Copyright (c) 2026 Fuse contributors
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+   Author contact information:
+
+   E-mail: philip-fuse@shadowmagic.org.uk
+
+*/
+
+#include <config.h>
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined( HAVE_GETRUSAGE ) && defined( HAVE_SYS_RESOURCE_H )
+#include <sys/resource.h>
+#define BENCHMARK_RUSAGE
+#endif
+
+/* Each whole emulator workload is run in a process of its own so that its
+   peak memory use can be measured */
+#if defined( BENCHMARK_RUSAGE ) && defined( HAVE_FORK ) && \
+    defined( HAVE_WAIT4 ) && defined( HAVE_SYS_WAIT_H ) && \
+    defined( HAVE_UNISTD_H )
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#define BENCHMARK_FORK
+#endif
+
+#include <libspectrum.h>
+
+#include "benchmarks.h"
+#include "compat.h"
+#include "event.h"
+#include "fuse.h"
+#include "machine.h"
+#include "memory_pages.h"
+#include "perfstats.h"
+#include "periph.h"
+#include "peripherals/spectranet.h"
+#include "settings.h"
+#include "sound.h"
+#include "spectrum.h"
+#include "tape.h"
+#include "timer/timer.h"
+#include "ui/scaler/scaler.h"
+#include "z80/z80.h"
+
+/* How many frames to emulate for each measurement */
+#define BENCHMARK_FRAMES 500
+
+/* Print one result as a line of JSON, in the form shared with the core
+   and W5100 benchmarks run by `make bench'. The name says what was
+   measured and how, eg "z80-alu/48/contended+cache"; each name and
+   metric pair is the same from one run to the next */
+static void
+benchmark_print( const char *name, const char *metric, double value,
+                 const char *unit )
+{
+  printf( "{ \"name\": \"%s\", \"metric\": \"%s\", \"value\": %.9g, "
+          "\"unit\": \"%s\" }\n", name, metric, value, unit );
+}
+
+/* The machines the benchmarks are run on, covering each kind of memory
+   contention and paging, and whether to do so with a Spectranet, which
+   sees every write to memory while it is paged in */
+typedef struct benchmark_configuration {
+  libspectrum_machine machine;
+  int spectranet;
+} benchmark_configuration;
+
+static const benchmark_configuration benchmark_configurations[] = {
+  { LIBSPECTRUM_MACHINE_48, 0 },
+  { LIBSPECTRUM_MACHINE_128, 0 },
+  { LIBSPECTRUM_MACHINE_PLUS3, 0 },
+  { LIBSPECTRUM_MACHINE_TC2048, 0 },
+  { LIBSPECTRUM_MACHINE_PENT, 0 },
+  { LIBSPECTRUM_MACHINE_128, 1 },
+};
+
+/* Mostly arithmetic, placed at 0x8000 so that it and the data it works
+   on at 0xc000 are in uncontended memory on every machine */
+static const libspectrum_byte z80_benchmark_alu_code[] = {
+  0xf3,			/* 8000 DI */
+  0x21, 0x00, 0xc0,	/* 8001 LD HL,0xc000 */
+  0x01, 0x00, 0x01,	/* 8004 LD BC,0x0100 */
+  0x7e,			/* 8007 LD A,(HL) */
+  0x86,			/* 8008 ADD A,(HL) */
+  0xcb, 0x27,		/* 8009 SLA A */
+  0xed, 0x44,		/* 800b NEG */
+  0x77,			/* 800d LD (HL),A */
+  0x23,			/* 800e INC HL */
+  0x0b,			/* 800f DEC BC */
+  0x78,			/* 8010 LD A,B */
+  0xb1,			/* 8011 OR C */
+  0x20, 0xf3,		/* 8012 JR NZ,0x8007 */
+  0xc3, 0x01, 0x80,	/* 8014 JP 0x8001 */
+};
+
+/* Block copies from 0xc000 to 0x9000, so nearly all the time is spent
+   writing to ordinary uncontended RAM */
+static const libspectrum_byte z80_benchmark_ldir_code[] = {
+  0xf3,			/* 8000 DI */
+  0x21, 0x00, 0xc0,	/* 8001 LD HL,0xc000 */
+  0x11, 0x00, 0x90,	/* 8004 LD DE,0x9000 */
+  0x01, 0x00, 0x10,	/* 8007 LD BC,0x1000 */
+  0xed, 0xb0,		/* 800a LDIR */
+  0xc3, 0x01, 0x80,	/* 800c JP 0x8001 */
+};
+
+/* Nothing but instruction fetches: a run of NOPs at 0x6000, which is in
+   contended memory on every machine which has any */
+#define Z80_BENCHMARK_FETCH_ADDRESS 0x6000
+#define Z80_BENCHMARK_FETCH_NOPS 64
+
+typedef struct z80_benchmark_program {
+  const char *name;
+  void (*setup)( void );
+} z80_benchmark_program;
+
+static void
+z80_benchmark_start( libspectrum_word address )
+{
+  z80.pc.w = address;
+  z80.sp.w = 0xfff0;
+  z80.iff1 = z80.iff2 = 0;
+  z80.halted = 0;
+}
+
+static void
+z80_benchmark_load( const libspectrum_byte *code, size_t length )
+{
+  size_t i;
+
+  for( i = 0; i < length; i++ ) writebyte_internal( 0x8000 + i, code[ i ] );
+
+  z80_benchmark_start( 0x8000 );
+}
+
+static void
+z80_benchmark_alu_setup( void )
+{
+  z80_benchmark_load( z80_benchmark_alu_code,
+                      sizeof( z80_benchmark_alu_code ) );
+}
+
+static void
+z80_benchmark_ldir_setup( void )
+{
+  z80_benchmark_load( z80_benchmark_ldir_code,
+                      sizeof( z80_benchmark_ldir_code ) );
+}
+
+static void
+z80_benchmark_fetch_setup( void )
+{
+  libspectrum_word address = Z80_BENCHMARK_FETCH_ADDRESS;
+  size_t i;
+
+  writebyte_internal( address++, 0xf3 );			/* DI */
+  for( i = 0; i < Z80_BENCHMARK_FETCH_NOPS; i++ )
+    writebyte_internal( address++, 0x00 );			/* NOP */
+  writebyte_internal( address++, 0xc3 );			/* JP nn */
+  writebyte_internal( address++, ( Z80_BENCHMARK_FETCH_ADDRESS + 1 ) & 0xff );
+  writebyte_internal( address++, ( Z80_BENCHMARK_FETCH_ADDRESS + 1 ) >> 8 );
+
+  z80_benchmark_start( Z80_BENCHMARK_FETCH_ADDRESS );
+}
+
+static const z80_benchmark_program z80_benchmark_programs[] = {
+  { "alu", z80_benchmark_alu_setup },
+  { "fetch", z80_benchmark_fetch_setup },
+  { "ldir", z80_benchmark_ldir_setup },
+};
+
+/* Run one program on one core, returning the time taken and the number
+   of opcodes executed; as with the R register, each prefix counts as an
+   opcode */
+static double
+z80_benchmark_core( const z80_benchmark_program *program, z80_core_type core,
+                    int predecode_cache, double *opcodes )
+{
+  libspectrum_dword frame_length, next_event;
+  libspectrum_word r;
+  double start, elapsed;
+  int i, old_predecode_cache;
+
+  frame_length = machine_current->timings.tstates_per_frame;
+
+  /* Run whole frames without processing any events so that nothing but
+     the core itself is measured */
+  next_event = event_next_event;
+  event_next_event = frame_length;
+
+  old_predecode_cache = settings_current.predecode_cache;
+  settings_current.predecode_cache = predecode_cache;
+
+  program->setup();
+
+  *opcodes = 0;
+
+  start = timer_get_time();
+  for( i = 0; i < BENCHMARK_FRAMES; i++ ) {
+    tstates = 0;
+    r = z80.r;
+    z80_do_opcodes_with_core( core );
+    *opcodes += (libspectrum_word)( z80.r - r );
+  }
+  elapsed = timer_get_time() - start;
+
+  settings_current.predecode_cache = old_predecode_cache;
+
+  event_next_event = next_event;
+  tstates = 0;
+
+  return elapsed;
+}
+
+static int
+z80_benchmark( int spectranet )
+{
+  libspectrum_dword frame_length;
+  double elapsed, emulated, opcodes;
+  int core, predecode_cache;
+  size_t i;
+  char name[ 64 ];
+
+  frame_length = machine_current->timings.tstates_per_frame;
+  emulated = (double)frame_length * BENCHMARK_FRAMES /
+             machine_current->timings.processor_speed;
+
+  for( i = 0; i < ARRAY_SIZE( z80_benchmark_programs ); i++ ) {
+    for( core = 0; core < Z80_CORE_COUNT; core++ ) {
+
+      /* The hooked core never uses the predecode cache */
+      for( predecode_cache = 0;
+           predecode_cache <= ( core != Z80_CORE_HOOKED );
+           predecode_cache++ ) {
+
+        elapsed = z80_benchmark_core( &z80_benchmark_programs[ i ], core,
+                                      predecode_cache, &opcodes );
+        if( elapsed <= 0 ) elapsed = 1e-6;
+
+        snprintf( name, sizeof( name ), "z80-%s/%s%s/%s%s",
+                  z80_benchmark_programs[ i ].name, machine_current->id,
+                  spectranet ? "+spectranet" : "", z80_core_name( core ),
+                  predecode_cache ? "+cache" : "" );
+
+        benchmark_print( name, "opcodes_per_second", opcodes / elapsed,
+                         "opcodes/s" );
+        benchmark_print( name, "real_time", emulated / elapsed, "x" );
+      }
+    }
+  }
+
+  return 0;
+}
+
+/* The whole emulator workloads, run as in normal use but as fast as
+   possible, with the time in each stage of every frame recorded by the
+   performance statistics */
+#define SYSTEM_BENCHMARK_FRAMES PERFSTATS_FRAMES
+
+/* Each workload runs with interrupts in IM 2, to a routine which just
+   returns, so that it works the same with any ROM */
+#define SYSTEM_BENCHMARK_CODE 0x8000
+#define SYSTEM_BENCHMARK_STACK 0xfd00
+#define SYSTEM_BENCHMARK_HANDLER 0xfdfd
+#define SYSTEM_BENCHMARK_TABLE 0xfe00
+
+/* A square wave swept up and down in pitch, with several hundred edges a
+   frame */
+static const libspectrum_byte system_beeper_code[] = {
+  0x79,			/* 8000 LD A,C */
+  0xe6, 0x1f,		/* 8001 AND 0x1f */
+  0x3c,			/* 8003 INC A */
+  0x57,			/* 8004 LD D,A */
+  0x3e, 0x10,		/* 8005 LD A,0x10 */
+  0xd3, 0xfe,		/* 8007 OUT (0xfe),A */
+  0x42,			/* 8009 LD B,D */
+  0x10, 0xfe,		/* 800a DJNZ 0x800a */
+  0xaf,			/* 800c XOR A */
+  0xd3, 0xfe,		/* 800d OUT (0xfe),A */
+  0x42,			/* 800f LD B,D */
+  0x10, 0xfe,		/* 8010 DJNZ 0x8010 */
+  0x0c,			/* 8012 INC C */
+  0x18, 0xeb,		/* 8013 JR 0x8000 */
+};
+
+/* Every AY register written over and over with changing values */
+static const libspectrum_byte system_ay_code[] = {
+  0x1e, 0x00,		/* 8000 LD E,0x00 */
+  0x01, 0xfd, 0xff,	/* 8002 LD BC,0xfffd */
+  0xed, 0x59,		/* 8005 OUT (C),E */
+  0x06, 0xbf,		/* 8007 LD B,0xbf */
+  0x24,			/* 8009 INC H */
+  0xed, 0x61,		/* 800a OUT (C),H */
+  0x1c,			/* 800c INC E */
+  0x7b,			/* 800d LD A,E */
+  0xfe, 0x0e,		/* 800e CP 0x0e */
+  0x20, 0xf0,		/* 8010 JR NZ,0x8002 */
+  0x18, 0xec,		/* 8012 JR 0x8000 */
+};
+
+/* The whole screen moved along a byte at a time, so that every line
+   changes every frame or two */
+static const libspectrum_byte system_scroller_code[] = {
+  0x21, 0x01, 0x40,	/* 8000 LD HL,0x4001 */
+  0x11, 0x00, 0x40,	/* 8003 LD DE,0x4000 */
+  0x01, 0xff, 0x17,	/* 8006 LD BC,0x17ff */
+  0xed, 0xb0,		/* 8009 LDIR */
+  0xed, 0x5f,		/* 800b LD A,R */
+  0x32, 0xff, 0x57,	/* 800d LD (0x57ff),A */
+  0x18, 0xee,		/* 8010 JR 0x8000 */
+};
+
+/* Screens loaded one after another with the ROM loader */
+static const libspectrum_byte system_tape_code[] = {
+  0xdd, 0x21, 0x00, 0x40,	/* 8000 LD IX,0x4000 */
+  0x11, 0x00, 0x1b,	/* 8004 LD DE,0x1b00 */
+  0x3e, 0xff,		/* 8007 LD A,0xff */
+  0x37,			/* 8009 SCF */
+  0xcd, 0x56, 0x05,	/* 800a CALL 0x0556 (LD-BYTES) */
+  0x18, 0xf1,		/* 800d JR 0x8000 */
+};
+
+/* The Timex high resolution mode, with both halves of the screen moved
+   along as the scroller does */
+static const libspectrum_byte system_hires_code[] = {
+  0x3e, 0x06,		/* 8000 LD A,0x06 */
+  0xd3, 0xff,		/* 8002 OUT (0xff),A */
+  0x21, 0x01, 0x40,	/* 8004 LD HL,0x4001 */
+  0x11, 0x00, 0x40,	/* 8007 LD DE,0x4000 */
+  0x01, 0xff, 0x37,	/* 800a LD BC,0x37ff */
+  0xed, 0xb0,		/* 800d LDIR */
+  0xed, 0x5f,		/* 800f LD A,R */
+  0x32, 0xff, 0x77,	/* 8011 LD (0x77ff),A */
+  0x18, 0xee,		/* 8014 JR 0x8004 */
+};
+
+/* How many screens are on the tape */
+#define SYSTEM_TAPE_BLOCKS 20
+#define SYSTEM_TAPE_BLOCK_LENGTH 0x1b00
+
+static int system_tape_traps, system_accelerate_loader;
+
+static int
+system_tape_setup( void )
+{
+  size_t length = SYSTEM_TAPE_BLOCKS * ( SYSTEM_TAPE_BLOCK_LENGTH + 4 );
+  libspectrum_byte *buffer, *ptr, checksum;
+  size_t i, j;
+  int error;
+
+  /* A .tap file of data blocks, each with its length, flag and checksum */
+  buffer = ptr = libspectrum_new( libspectrum_byte, length );
+
+  for( i = 0; i < SYSTEM_TAPE_BLOCKS; i++ ) {
+    *ptr++ = ( SYSTEM_TAPE_BLOCK_LENGTH + 2 ) & 0xff;
+    *ptr++ = ( SYSTEM_TAPE_BLOCK_LENGTH + 2 ) >> 8;
+    *ptr++ = checksum = 0xff;
+    for( j = 0; j < SYSTEM_TAPE_BLOCK_LENGTH; j++ ) {
+      *ptr = ( i + j * 7 ) & 0xff;
+      checksum ^= *ptr++;
+    }
+    *ptr++ = checksum;
+  }
+
+  error = tape_read_buffer( buffer, length, LIBSPECTRUM_ID_TAPE_TAP, NULL, 0 );
+  libspectrum_free( buffer );
+  if( error ) return error;
+
+  /* The loader has to run for the acceleration to be measured */
+  system_tape_traps = settings_current.tape_traps;
+  system_accelerate_loader = settings_current.accelerate_loader;
+  settings_current.tape_traps = 0;
+  settings_current.accelerate_loader = 1;
+
+  return tape_do_play( 0 );
+}
+
+static void
+system_tape_teardown( void )
+{
+  tape_stop();
+  tape_close();
+
+  settings_current.tape_traps = system_tape_traps;
+  settings_current.accelerate_loader = system_accelerate_loader;
+}
+
+typedef struct system_benchmark {
+  const char *name;
+  libspectrum_machine machine;
+  const libspectrum_byte *code;
+  size_t length;
+  int (*setup)( void );
+  void (*teardown)( void );
+} system_benchmark;
+
+/* There's no TR-DOS disk workload, as the TR-DOS ROM isn't distributed with
+   Fuse */
+static const system_benchmark system_benchmarks[] = {
+  { "beeper", LIBSPECTRUM_MACHINE_48,
+    system_beeper_code, sizeof( system_beeper_code ), NULL, NULL },
+  { "ay", LIBSPECTRUM_MACHINE_128,
+    system_ay_code, sizeof( system_ay_code ), NULL, NULL },
+  { "scroller", LIBSPECTRUM_MACHINE_48,
+    system_scroller_code, sizeof( system_scroller_code ), NULL, NULL },
+  { "tape", LIBSPECTRUM_MACHINE_48,
+    system_tape_code, sizeof( system_tape_code ),
+    system_tape_setup, system_tape_teardown },
+  { "timex-hires", LIBSPECTRUM_MACHINE_TC2048,
+    system_hires_code, sizeof( system_hires_code ), NULL, NULL },
+};
+
+static void
+system_benchmark_load( const system_benchmark *benchmark )
+{
+  size_t i;
+
+  for( i = 0; i <= 0x100; i++ )
+    writebyte_internal( SYSTEM_BENCHMARK_TABLE + i,
+                        SYSTEM_BENCHMARK_HANDLER & 0xff );
+
+  writebyte_internal( SYSTEM_BENCHMARK_HANDLER, 0xfb );		/* EI */
+  writebyte_internal( SYSTEM_BENCHMARK_HANDLER + 1, 0xed );	/* RETI */
+  writebyte_internal( SYSTEM_BENCHMARK_HANDLER + 2, 0x4d );
+
+  for( i = 0; i < benchmark->length; i++ )
+    writebyte_internal( SYSTEM_BENCHMARK_CODE + i, benchmark->code[ i ] );
+
+  z80.pc.w = SYSTEM_BENCHMARK_CODE;
+  z80.sp.w = SYSTEM_BENCHMARK_STACK;
+  z80.iy.w = 0x5c3a;		/* As the ROM expects */
+  z80.i = SYSTEM_BENCHMARK_TABLE >> 8;
+  z80.im = 2;
+  z80.iff1 = z80.iff2 = 1;
+  z80.halted = 0;
+}
+
+/* What was measured for one whole emulator workload. The strings are
+   static data, so are still valid when the result is passed from a child
+   process to its parent */
+typedef struct system_benchmark_result {
+  const char *machine;
+  size_t frames;
+  double elapsed;		/* In seconds */
+  double cpu;			/* In seconds; negative if not known */
+  double stages[ PERFSTATS_STAGE_COUNT ];
+  int sound;
+  const char *scaler;
+} system_benchmark_result;
+
+/* The processor time used by Fuse so far; negative if not known */
+static double
+system_cpu_time( void )
+{
+#ifdef BENCHMARK_RUSAGE
+  struct rusage usage;
+
+  if( getrusage( RUSAGE_SELF, &usage ) ) return -1;
+
+  return usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6 +
+         usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+#else				/* #ifdef BENCHMARK_RUSAGE */
+  return -1;
+#endif				/* #ifdef BENCHMARK_RUSAGE */
+}
+
+/* Run one workload, returning non-zero if it couldn't be run */
+static int
+system_benchmark_measure( const system_benchmark *benchmark,
+                          system_benchmark_result *result )
+{
+  const perfstats_frame_t *frame;
+  double start, cpu_start;
+  size_t i, j;
+
+  if( machine_select( benchmark->machine ) ||
+      machine_current->machine != benchmark->machine )
+    return 1;
+
+  system_benchmark_load( benchmark );
+  if( benchmark->setup && benchmark->setup() ) return 1;
+
+  perfstats_start();
+  cpu_start = system_cpu_time();
+  start = timer_get_time();
+
+  while( perfstats_frame_count() < SYSTEM_BENCHMARK_FRAMES && !fuse_exiting ) {
+    perfstats_enter( PERFSTATS_STAGE_Z80 );
+    z80_do_opcodes();
+    perfstats_enter( PERFSTATS_STAGE_EVENTS );
+    event_do_events();
+  }
+
+  perfstats_enter( PERFSTATS_STAGE_OTHER );
+  result->elapsed = timer_get_time() - start;
+  result->cpu = system_cpu_time();
+  if( result->cpu >= 0 ) result->cpu -= cpu_start;
+  perfstats_stop();
+
+  result->machine = machine_current->id;
+  result->sound = sound_enabled;
+  result->scaler = scaler_is_supported( current_scaler ) ?
+                   scaler_id( current_scaler ) : "none";
+
+  sound_end();
+
+  if( benchmark->teardown ) benchmark->teardown();
+
+  if( result->elapsed <= 0 ) result->elapsed = 1e-6;
+
+  result->frames = perfstats_frame_count();
+  for( j = 0; j < PERFSTATS_STAGE_COUNT; j++ ) result->stages[ j ] = 0;
+  for( i = 0; i < result->frames; i++ ) {
+    frame = perfstats_get_frame( i );
+    for( j = 0; j < PERFSTATS_STAGE_COUNT; j++ )
+      result->stages[ j ] += frame->time[ j ];
+  }
+
+  return 0;
+}
+
+/* Print the results for a workload; peak_rss is in kilobytes, or
+   negative if not known. The name includes the sound and graphics
+   filter only when they were in use, eg "beeper/48+sound+2x" */
+static void
+system_benchmark_print( const system_benchmark *benchmark,
+                        const system_benchmark_result *result,
+                        long peak_rss )
+{
+  char name[ 64 ], metric[ 32 ];
+  size_t j;
+
+  snprintf( name, sizeof( name ), "%s/%s%s%s%s", benchmark->name,
+            result->machine, result->sound ? "+sound" : "",
+            strcmp( result->scaler, "none" ) ? "+" : "",
+            strcmp( result->scaler, "none" ) ? result->scaler : "" );
+
+  benchmark_print( name, "frames", result->frames, "frames" );
+  benchmark_print( name, "frames_per_second",
+                   result->frames / result->elapsed, "frames/s" );
+
+  for( j = 0; j < PERFSTATS_STAGE_COUNT; j++ ) {
+    snprintf( metric, sizeof( metric ), "%s_time",
+              perfstats_stage_names[ j ] );
+    benchmark_print( name, metric, result->stages[ j ] * 1000, "ms" );
+  }
+
+  if( result->cpu >= 0 )
+    benchmark_print( name, "cpu_time", result->cpu * 1000, "ms" );
+
+  if( peak_rss >= 0 ) benchmark_print( name, "peak_rss", peak_rss, "KiB" );
+}
+
+#ifdef BENCHMARK_FORK
+
+/* Run a workload in a child process, which hands back what it measured
+   through a pipe; the child's own resource usage then gives the most
+   memory the workload needed, which the process as a whole can't as its
+   peak only ever grows */
+static void
+system_benchmark_run( const system_benchmark *benchmark )
+{
+  system_benchmark_result result;
+  struct rusage usage;
+  int fds[2], status;
+  ssize_t bytes;
+  long peak_rss;
+  pid_t pid;
+
+  if( pipe( fds ) ) return;
+
+  fflush( stdout ); fflush( stderr );
+
+  pid = fork();
+  if( pid == -1 ) {
+    close( fds[0] ); close( fds[1] );
+    return;
+  }
+
+  if( pid == 0 ) {
+    close( fds[0] );
+    status = system_benchmark_measure( benchmark, &result );
+    if( !status &&
+        write( fds[1], &result, sizeof( result ) ) != sizeof( result ) )
+      status = 1;
+    close( fds[1] );
+
+    /* Leave without tidying up anything shared with the parent */
+    _exit( status );
+  }
+
+  close( fds[1] );
+  do {
+    bytes = read( fds[0], &result, sizeof( result ) );
+  } while( bytes == -1 && errno == EINTR );
+  close( fds[0] );
+
+  while( wait4( pid, &status, 0, &usage ) == -1 && errno == EINTR );
+
+  if( bytes != sizeof( result ) ) return;
+
+#ifdef __APPLE__
+  peak_rss = usage.ru_maxrss / 1024;
+#else				/* #ifdef __APPLE__ */
+  peak_rss = usage.ru_maxrss;
+#endif				/* #ifdef __APPLE__ */
+
+  system_benchmark_print( benchmark, &result, peak_rss );
+}
+
+#else				/* #ifdef BENCHMARK_FORK */
+
+static void
+system_benchmark_run( const system_benchmark *benchmark )
+{
+  system_benchmark_result result;
+
+  if( system_benchmark_measure( benchmark, &result ) ) return;
+
+  system_benchmark_print( benchmark, &result, -1 );
+}
+
+#endif				/* #ifdef BENCHMARK_FORK */
+
+static void
+system_benchmarks_run( void )
+{
+  int sound = settings_current.sound;
+  size_t i;
+
+  /* Sound is generated only if asked for with --benchmark-output, and
+     even then isn't sent to the sound device, which would hold the
+     emulation to real time */
+  sound_end();
+  settings_current.sound = settings_current.benchmark_output;
+  sound_silent = 1;
+  timer_unthrottled = 1;
+
+  for( i = 0; i < ARRAY_SIZE( system_benchmarks ) && !fuse_exiting; i++ )
+    system_benchmark_run( &system_benchmarks[ i ] );
+
+  settings_current.sound = sound;
+  sound_silent = 0;
+  timer_unthrottled = 0;
+  sound_init( settings_current.sound_device );
+  timer_estimate_reset();
+}
+
+/* Add or remove the Spectranet, returning non-zero if that couldn't be
+   done */
+static int
+benchmark_set_spectranet( int spectranet )
+{
+  settings_current.spectranet = spectranet;
+  periph_posthook();
+
+  return spectranet_available != spectranet;
+}
+
+int
+benchmarks_run( void )
+{
+  libspectrum_machine original = machine_current->machine;
+  int original_spectranet = settings_current.spectranet;
+  const benchmark_configuration *configuration;
+  size_t i;
+  int r = 0;
+
+  for( i = 0; i < ARRAY_SIZE( benchmark_configurations ); i++ ) {
+
+    configuration = &benchmark_configurations[ i ];
+
+    /* Skip any machine which can't be used, eg because its ROMs are
+       missing */
+    if( machine_select( configuration->machine ) ||
+        machine_current->machine != configuration->machine )
+      continue;
+
+    if( benchmark_set_spectranet( configuration->spectranet ) ) continue;
+
+    r += z80_benchmark( configuration->spectranet );
+  }
+
+  benchmark_set_spectranet( original_spectranet );
+
+  system_benchmarks_run();
+
+  if( machine_current->machine != original ) machine_select( original );
+
+  return r;
+}
@@ -0,0 +1,250 @@
+/* bootcache.c: save and reuse the state of a freshly booted machine
+   Copyright (c) 2026 Fuse contributors
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+   Author contact information:
+
+   E-mail: philip-fuse@shadowmagic.org.uk
+
+*/
+
+/* After a hard reset, the ROM spends a second or more testing and
+   clearing memory before it is ready for input. The first time a given
+   machine boots, its state is saved once it has settled down, in a file
+   whose name includes a hash of the machine, all the ROMs and other memory
+   it was reset with and the peripherals attached; later hard resets with
+   the same hash just load that state. Changing any ROM or peripheral
+   changes the hash, so an out of date state is never used */
+
+#include <config.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include <libspectrum.h>
+
+#include "bootcache.h"
+#include "compat.h"
+#include "debugger/debugger.h"
+#include "fuse.h"
+#include "keyboard.h"
+#include "machine.h"
+#include "memory_pages.h"
+#include "movie.h"
+#include "netplay.h"
+#include "periph.h"
+#include "phantom_typist.h"
+#include "rzx.h"
+#include "settings.h"
+#include "snapshot.h"
+#include "spectrum.h"
+#include "tape.h"
+#include "ui/ui.h"
+
+int bootcache_capturing = 0;
+
+/* How many frames the screen must stay the same, with interrupts enabled,
+   for the machine to count as waiting for input */
+#define STABLE_FRAMES 25
+
+/* Give up if the machine hasn't settled down after this many frames */
+#define MAX_FRAMES 1500
+
+/* Peripherals whose boot depends on the contents of cards or on the
+   network, which aren't part of the hash */
+static const periph_type media_peripherals[] = {
+  PERIPH_TYPE_DIVIDE,
+  PERIPH_TYPE_DIVMMC,
+  PERIPH_TYPE_SIMPLEIDE,
+  PERIPH_TYPE_SPECCYBOOT,
+  PERIPH_TYPE_SPECTRANET,
+  PERIPH_TYPE_ZXATASP,
+  PERIPH_TYPE_ZXCF,
+  PERIPH_TYPE_ZXMMC,
+};
+
+/* Nested calls to bootcache_inhibit() */
+static int inhibited = 0;
+
+/* Where the state for the current boot is kept */
+static char *filename = NULL;
+
+/* Frames since the reset, and how many of them the screen has stayed the
+   same for */
+static int frames, stable_frames;
+static libspectrum_dword screen_check;
+
+/* The time of the reset, and when the screen stopped changing */
+static double start_time, ready_time;
+static int ready_frames;
+
+static libspectrum_dword
+hash( libspectrum_dword check, const libspectrum_byte *data, size_t length )
+{
+  size_t i;
+
+  for( i = 0; i < length; i++ ) check = ( check ^ data[i] ) * 16777619UL;
+
+  return check;
+}
+
+static int
+bootcache_available( void )
+{
+  size_t i;
+
+  if( !settings_current.boot_cache || inhibited ) return 0;
+
+  if( rzx_playback || rzx_recording || movie_recording || netplay_active )
+    return 0;
+
+  for( i = 0; i < ARRAY_SIZE( media_peripherals ); i++ )
+    if( periph_is_active( media_peripherals[i] ) ) return 0;
+
+  return 1;
+}
+
+static char*
+cache_filename( void )
+{
+  libspectrum_dword check = 2166136261UL;
+  libspectrum_byte settings[2];
+  const char *id = machine_current->id;
+  char *path;
+  size_t length;
+  int type;
+
+  check = hash( check, (const libspectrum_byte*)id, strlen( id ) );
+
+  settings[0] = settings_current.late_timings;
+  settings[1] = settings_current.issue2;
+  check = hash( check, settings, sizeof( settings ) );
+
+  for( type = PERIPH_TYPE_UNKNOWN + 1;
+       type <= PERIPH_TYPE_ZXPRINTER_FULL_DECODE;
+       type++ ) {
+    settings[0] = periph_is_active( type );
+    check = hash( check, settings, 1 );
+  }
+
+  check = memory_pool_hash( check );
+
+  length = strlen( settings_current.boot_cache ) + strlen( id ) + 16;
+  path = libspectrum_new( char, length );
+  snprintf( path, length, "%s" FUSE_DIR_SEP_STR "%s-%08lx.szx",
+            settings_current.boot_cache, id, (unsigned long)check );
+
+  return path;
+}
+
+void
+bootcache_reset( void )
+{
+  double start;
+
+  bootcache_capturing = 0;
+  libspectrum_free( filename );
+  filename = NULL;
+
+  if( !bootcache_available() ) return;
+
+  start = compat_timer_get_monotonic_time();
+
+  filename = cache_filename();
+
+  if( compat_file_exists( filename ) ) {
+    if( !snapshot_read( filename ) ) {
+      if( settings_current.startup_profile )
+        printf( "%s: %s ready after %.3f s, from '%s'\n", fuse_progname,
+                libspectrum_machine_name( machine_current->machine ),
+                compat_timer_get_monotonic_time() - start, filename );
+      return;
+    }
+
+    ui_error( UI_ERROR_WARNING, "couldn't restore boot state from '%s'",
+              filename );
+  }
+
+  start_time = start;
+  frames = stable_frames = 0;
+  screen_check = 0;
+  bootcache_capturing = 1;
+}
+
+static int
+keyboard_in_use( void )
+{
+  size_t i;
+
+  for( i = 0; i < 8; i++ )
+    if( ( keyboard_return_values[i] & 0x1f ) != 0x1f ) return 1;
+
+  return 0;
+}
+
+void
+bootcache_frame( int interrupted )
+{
+  libspectrum_dword check;
+  double emulated;
+
+  /* Anything which might change what the machine settles down to means
+     there's nothing worth keeping */
+  if( ++frames > MAX_FRAMES || keyboard_in_use() || tape_is_playing() ||
+      phantom_typist_is_active() || debugger_mode != DEBUGGER_MODE_INACTIVE ||
+      !bootcache_available() ) {
+    bootcache_capturing = 0;
+    return;
+  }
+
+  check = hash( 2166136261UL, RAM[ memory_current_screen ], 0x1b00 );
+
+  if( !interrupted || check != screen_check ) {
+    screen_check = check;
+    stable_frames = 0;
+    return;
+  }
+
+  if( !stable_frames++ ) {
+    ready_time = compat_timer_get_monotonic_time();
+    ready_frames = frames;
+  }
+
+  if( stable_frames < STABLE_FRAMES ) return;
+
+  bootcache_capturing = 0;
+
+  if( snapshot_write( filename ) || !settings_current.startup_profile )
+    return;
+
+  emulated = (double)ready_frames * machine_current->timings.tstates_per_frame /
+             machine_current->timings.processor_speed;
+
+  printf( "%s: %s ready after %.3f s (%.2f s emulated), saved to '%s'\n",
+          fuse_progname, libspectrum_machine_name( machine_current->machine ),
+          ready_time - start_time, emulated, filename );
+}
+
+void
+bootcache_inhibit( int inhibit )
+{
+  if( inhibit ) {
+    inhibited++;
+    bootcache_capturing = 0;
+  } else {
+    inhibited--;
+  }
+}
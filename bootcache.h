@@ -0,0 +1,43 @@
+/* bootcache.h: save and reuse the state of a freshly booted machine
+   Copyright (c) 2026 Fuse contributors
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+   Author contact information:
+
+   E-mail: philip-fuse@shadowmagic.org.uk
+
+*/
+
+#ifndef FUSE_BOOTCACHE_H
+#define FUSE_BOOTCACHE_H
+
+/* Set while waiting for a newly reset machine to finish booting */
+extern int bootcache_capturing;
+
+/* Called at the end of a hard reset: put the machine straight into the
+   cached booted state if there is one, or otherwise start waiting for it
+   to boot so that the state can be cached */
+void bootcache_reset( void );
+
+/* Called at the end of each frame while capturing, with whether an
+   interrupt was accepted at the start of the next one */
+void bootcache_frame( int interrupted );
+
+/* Stop capturing and ignore any hard resets until the matching call with
+   'inhibit' clear, used while a snapshot is loaded */
+void bootcache_inhibit( int inhibit );
+
+#endif			/* #ifndef FUSE_BOOTCACHE_H */
@@ -173,6 +173,10 @@ int compat_closedir( compat_dir directory );
 double compat_timer_get_time( void );
 void compat_timer_sleep( int ms );
 
+/* A higher resolution clock which never goes backwards, for measuring
+   short intervals; the zero point is arbitrary */
+double compat_timer_get_monotonic_time( void );
+
 /* TUN/TAP handling */
 
 int compat_get_tap( const char *interface_name );
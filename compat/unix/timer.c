@@ -26,6 +26,7 @@
 #include <errno.h>
 #include <string.h>
 #include <sys/time.h>
+#include <time.h>
 #include <unistd.h>
 
 #include "compat.h"
@@ -46,6 +47,19 @@ compat_timer_get_time( void )
   return tv.tv_sec + tv.tv_usec / 1000000.0;
 }
 
+double
+compat_timer_get_monotonic_time( void )
+{
+#if defined( HAVE_CLOCK_GETTIME ) && defined( CLOCK_MONOTONIC )
+  struct timespec tp;
+
+  if( !clock_gettime( CLOCK_MONOTONIC, &tp ) )
+    return tp.tv_sec + tp.tv_nsec / 1000000000.0;
+#endif
+
+  return compat_timer_get_time();
+}
+
 void
 compat_timer_sleep( int ms )
 {
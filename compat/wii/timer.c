@@ -48,6 +48,12 @@ compat_timer_get_time( void )
   return tp.tv_sec + tp.tv_nsec / 1000000000.0;
 }
 
+double
+compat_timer_get_monotonic_time( void )
+{
+  return compat_timer_get_time();
+}
+
 void
 compat_timer_sleep( int ms )
 {
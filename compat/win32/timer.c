@@ -33,6 +33,20 @@ compat_timer_get_time( void )
   return GetTickCount() / 1000.0;
 }
 
+double
+compat_timer_get_monotonic_time( void )
+{
+  static LARGE_INTEGER frequency;
+  LARGE_INTEGER count;
+
+  if( !frequency.QuadPart && !QueryPerformanceFrequency( &frequency ) )
+    return compat_timer_get_time();
+
+  QueryPerformanceCounter( &count );
+
+  return (double)count.QuadPart / frequency.QuadPart;
+}
+
 void
 compat_timer_sleep( int ms )
 {
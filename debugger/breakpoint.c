@@ -41,6 +41,10 @@
 /* The current breakpoints */
 GSList *debugger_breakpoints;
 
+/* Which memory and ports have breakpoints on them */
+int debugger_memory_watched;
+libspectrum_byte debugger_port_watch[ 0x100 ];
+
 /* The next breakpoint ID to use */
 static size_t next_breakpoint_id;
 
@@ -78,6 +82,7 @@ static gint find_breakpoint_by_address( gconstpointer data,
 					gconstpointer user_data );
 static void free_breakpoint( gpointer data, gpointer user_data );
 static void add_time_event( gpointer data, gpointer user_data );
+static void update_watches( void );
 
 /* Add a breakpoint */
 int
@@ -212,6 +217,7 @@ breakpoint_add( debugger_breakpoint_type type, debugger_breakpoint_value value,
   bp->commands = NULL;
 
   debugger_breakpoints = g_slist_append( debugger_breakpoints, bp );
+  update_watches();
 
   if( debugger_mode == DEBUGGER_MODE_INACTIVE )
     debugger_mode = DEBUGGER_MODE_ACTIVE;
@@ -263,8 +269,10 @@ debugger_check( debugger_breakpoint_type type, libspectrum_dword value )
 
   }
 
-  if( signal_breakpoints_updated )
-      ui_breakpoints_updated();
+  if( signal_breakpoints_updated ) {
+    update_watches();
+    ui_breakpoints_updated();
+  }
 
   /* Debugger mode could have been reset by a breakpoint command */
   return ( debugger_mode == DEBUGGER_MODE_HALTED );
@@ -310,6 +318,74 @@ get_page( debugger_breakpoint_type type, libspectrum_word address )
   return &bank[ address >> MEMORY_PAGE_SIZE_LOGARITHM ];
 }
 
+int
+debugger_breakpoint_watches_page( debugger_breakpoint_type type, int page_num )
+{
+  GSList *ptr;
+  debugger_breakpoint *bp;
+  memory_page *page = get_page( type, page_num << MEMORY_PAGE_SIZE_LOGARITHM );
+
+  for( ptr = debugger_breakpoints; ptr; ptr = ptr->next ) {
+    bp = ptr->data;
+
+    if( bp->type != type ) continue;
+
+    /* As in breakpoint_check(), page-specific breakpoints are matched
+       against the address within a 16K page */
+    if( bp->value.address.source == memory_source_any ) {
+      if( bp->value.address.offset >> MEMORY_PAGE_SIZE_LOGARITHM ==
+          page_num ) return 1;
+    } else if( bp->value.address.source == page->source &&
+               bp->value.address.page == page->page_num &&
+               bp->value.address.offset >> MEMORY_PAGE_SIZE_LOGARITHM ==
+                 ( page_num & ( MEMORY_PAGES_IN_16K - 1 ) ) ) {
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+/* Work out which pages and ports have breakpoints on them; called
+   whenever the breakpoints change */
+static void
+update_watches( void )
+{
+  GSList *ptr;
+  debugger_breakpoint *bp;
+  libspectrum_byte flag;
+  int i;
+
+  debugger_memory_watched = 0;
+  memset( debugger_port_watch, 0, sizeof( debugger_port_watch ) );
+
+  for( ptr = debugger_breakpoints; ptr; ptr = ptr->next ) {
+    bp = ptr->data;
+
+    switch( bp->type ) {
+    case DEBUGGER_BREAKPOINT_TYPE_READ:
+    case DEBUGGER_BREAKPOINT_TYPE_WRITE:
+      debugger_memory_watched = 1;
+      continue;
+    case DEBUGGER_BREAKPOINT_TYPE_PORT_READ:
+      flag = DEBUGGER_PORT_WATCH_READ;
+      break;
+    case DEBUGGER_BREAKPOINT_TYPE_PORT_WRITE:
+      flag = DEBUGGER_PORT_WATCH_WRITE;
+      break;
+    default:
+      continue;
+    }
+
+    for( i = 0; i < 0x100; i++ )
+      if( ( i & bp->value.port.mask & 0xff ) ==
+          ( bp->value.port.port & 0xff ) )
+        debugger_port_watch[ i ] |= flag;
+  }
+
+  memory_map_update_watches();
+}
+
 int
 debugger_breakpoint_trigger( debugger_breakpoint *bp )
 {
@@ -389,6 +465,8 @@ debugger_breakpoint_remove( size_t id )
   if( debugger_mode == DEBUGGER_MODE_ACTIVE && !debugger_breakpoints )
     debugger_mode = DEBUGGER_MODE_INACTIVE;
 
+  update_watches();
+
   /* If this was a timed breakpoint, remove the event as well */
   if( bp->type == DEBUGGER_BREAKPOINT_TYPE_TIME ) {
 
@@ -481,7 +559,8 @@ debugger_breakpoint_clear( libspectrum_word address )
       ui_error( UI_ERROR_ERROR, "No breakpoint at 0x%04x", address );
     }
   } else {
-      ui_breakpoints_updated();
+    update_watches();
+    ui_breakpoints_updated();
   }
 
   return 0;
@@ -517,6 +596,8 @@ debugger_breakpoint_remove_all( void )
   /* Restart the breakpoint numbering */
   next_breakpoint_id = 1;
 
+  update_watches();
+
   ui_breakpoints_updated();
 
   return 0;
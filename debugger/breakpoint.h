@@ -114,6 +114,27 @@ typedef struct debugger_breakpoint {
 /* The current breakpoints */
 extern GSList *debugger_breakpoints;
 
+/* Non-zero if there are any read or write breakpoints, which need the
+   Z80 core which sees every memory access */
+extern int debugger_memory_watched;
+
+/* For each value of the low byte of a port address, whether any port
+   read or write breakpoints could trigger on it */
+#define DEBUGGER_PORT_WATCH_READ  0x01
+#define DEBUGGER_PORT_WATCH_WRITE 0x02
+
+extern libspectrum_byte debugger_port_watch[ 0x100 ];
+
+#define debugger_port_read_watched( port ) \
+  ( debugger_port_watch[ (port) & 0xff ] & DEBUGGER_PORT_WATCH_READ )
+#define debugger_port_write_watched( port ) \
+  ( debugger_port_watch[ (port) & 0xff ] & DEBUGGER_PORT_WATCH_WRITE )
+
+/* Could a breakpoint of 'type' trigger on an access to what is
+   currently mapped at memory page 'page_num'? */
+int debugger_breakpoint_watches_page( debugger_breakpoint_type type,
+                                      int page_num );
+
 int debugger_check( debugger_breakpoint_type type, libspectrum_dword value );
 
 void
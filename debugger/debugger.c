@@ -101,6 +101,9 @@ debugger_register_startup( void )
 int
 debugger_trap( void )
 {
+  /* The debugger may show the registers at any point */
+  z80_flags_resolve();
+
   return ui_debugger_activate();
 }
 
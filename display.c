@@ -33,9 +33,13 @@
 #include "fuse.h"
 #include "infrastructure/startup_manager.h"
 #include "machine.h"
+#include "module.h"
 #include "movie.h"
+#include "perfstats.h"
 #include "peripherals/scld.h"
 #include "rectangle.h"
+#include "runahead.h"
+#include "rzx.h"
 #include "screenshot.h"
 #include "settings.h"
 #include "spectrum.h"
@@ -125,6 +129,30 @@ static void display_get_attr( int x, int y,
 static int border_changes_last = 0;
 static struct border_change_t *border_changes = NULL;
 
+/* The copies kept by display_state_save() */
+typedef struct display_state_t {
+  int frame_count, flash_reversed;
+  libspectrum_byte lores_border, hires_border, last_border;
+  struct border_change_t border_sentinel;
+} display_state_t;
+
+static display_state_t saved_state[ MODULE_STATE_SLOTS ];
+
+static void display_state_save( int slot );
+static void display_state_restore( int slot );
+
+static module_info_t display_module_info = {
+
+  /* .reset = */ NULL,
+  /* .romcs = */ NULL,
+  /* .snapshot_enabled = */ NULL,
+  /* .snapshot_from = */ NULL,
+  /* .snapshot_to = */ NULL,
+  /* .state_save = */ display_state_save,
+  /* .state_restore = */ display_state_restore,
+
+};
+
 static struct border_change_t *
 alloc_change(void)
 {
@@ -199,6 +227,8 @@ display_init( int *argc, char ***argv )
   display_last_border = scld_last_dec.name.hires ?
                             display_hires_border : display_lores_border;
 
+  module_register( &display_module_info );
+
   return 0;
 }
 
@@ -891,6 +921,18 @@ update_ui_screen( void )
   int scale = machine_current->timex ? 2 : 1;
   size_t i;
   struct rectangle *ptr;
+  perfstats_stage stage;
+
+  /* Nothing is shown while seeking through an RZX file; the whole screen
+     is redrawn when the seek completes */
+  if( rzx_seeking ) {
+    rectangle_inactive_count = 0;
+    return;
+  }
+
+  /* When running ahead, only the last frame run ahead is shown; what
+     changed in the other frames is sent along with it */
+  if( runahead_frame_hidden() ) return;
 
   if( settings_current.frame_rate <= ++frame_count ) {
     frame_count = 0;
@@ -898,6 +940,8 @@ update_ui_screen( void )
       movie_start_frame();
     }
 
+    stage = perfstats_enter( PERFSTATS_STAGE_SCALER );
+
     if( display_redraw_all ) {
       if( movie_recording ) {
         movie_add_area( 0, 0, DISPLAY_ASPECT_WIDTH >> 3,
@@ -906,8 +950,11 @@ update_ui_screen( void )
       uidisplay_area( 0, 0,
                       scale * DISPLAY_ASPECT_WIDTH,
                       scale * DISPLAY_SCREEN_HEIGHT );
+      perfstats_count( PERFSTATS_COUNTER_RECTANGLES, 1 );
       display_redraw_all = 0;
     } else {
+      perfstats_count( PERFSTATS_COUNTER_RECTANGLES,
+                       rectangle_inactive_count );
       for( i = 0, ptr = rectangle_inactive;
            i < rectangle_inactive_count;
            i++, ptr++ ) {
@@ -921,7 +968,9 @@ update_ui_screen( void )
 
     rectangle_inactive_count = 0;
 
+    perfstats_enter( PERFSTATS_STAGE_UI );
     uidisplay_frame_end();
+    perfstats_enter( stage );
   }
 }
 
@@ -1003,6 +1052,43 @@ display_dirty_flashing_sinclair(void)
   }
 }
 
+/* State is saved only between frames, when the only border change is the
+   sentinel giving the colour at the start of the frame. What has been sent
+   to the UI is not part of the state: the next frame is drawn over
+   whatever was last shown */
+static void
+display_state_save( int slot )
+{
+  display_state_t *state = &saved_state[ slot ];
+
+  state->frame_count = display_frame_count;
+  state->flash_reversed = display_flash_reversed;
+  state->lores_border = display_lores_border;
+  state->hires_border = display_hires_border;
+  state->last_border = display_last_border;
+  state->border_sentinel = border_changes[0];
+}
+
+static void
+display_state_restore( int slot )
+{
+  const display_state_t *state = &saved_state[ slot ];
+
+  display_frame_count = state->frame_count;
+  display_flash_reversed = state->flash_reversed;
+  display_lores_border = state->lores_border;
+  display_hires_border = state->hires_border;
+  display_last_border = state->last_border;
+
+  border_changes[0] = state->border_sentinel;
+  border_changes_last = 1;
+  critical_region_x = critical_region_y = 0;
+
+  /* The screen memory has gone back, but the UI still shows the frames
+     run since the save */
+  display_refresh_main_screen();
+}
+
 void display_refresh_main_screen(void)
 {
   size_t i;
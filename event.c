@@ -30,6 +30,8 @@
 #include "event.h"
 #include "infrastructure/startup_manager.h"
 #include "fuse.h"
+#include "module.h"
+#include "perfstats.h"
 #include "ui/ui.h"
 #include "utils.h"
 
@@ -40,9 +42,21 @@ static const libspectrum_dword event_no_events = 0xffffffff;
 libspectrum_dword event_next_event;
 
 /* The actual list of events */
-static GSList *event_list = NULL;
+static event_t *event_list = NULL;
 
-/* An event ready to be reused */
+/* Events are allocated in blocks and never freed until the end, so that
+   once enough have been allocated no more memory is needed however many
+   events are added and done */
+#define EVENT_BLOCK_SIZE 64
+
+typedef struct event_block_t {
+  struct event_block_t *next;
+  event_t events[ EVENT_BLOCK_SIZE ];
+} event_block_t;
+
+static event_block_t *event_blocks = NULL;
+
+/* Events ready to be reused */
 static event_t *event_free = NULL;
 
 /* A null event */
@@ -55,15 +69,39 @@ typedef struct event_descriptor_t {
 
 static GArray *registered_events;
 
+/* The copies of the event list kept by event_state_save() */
+static GArray *saved_events[ MODULE_STATE_SLOTS ];
+
+static void event_state_save( int slot );
+static void event_state_restore( int slot );
+
+static module_info_t event_module_info = {
+
+  /* .reset = */ NULL,
+  /* .romcs = */ NULL,
+  /* .snapshot_enabled = */ NULL,
+  /* .snapshot_from = */ NULL,
+  /* .snapshot_to = */ NULL,
+  /* .state_save = */ event_state_save,
+  /* .state_restore = */ event_state_restore,
+
+};
+
 static int
 event_init( void *context )
 {
+  int i;
+
   registered_events = g_array_new( FALSE, FALSE, sizeof( event_descriptor_t ) );
+  for( i = 0; i < MODULE_STATE_SLOTS; i++ )
+    saved_events[i] = g_array_new( FALSE, FALSE, sizeof( event_t ) );
 
   event_type_null = event_register( NULL, "[Deleted event]" );
 
   event_next_event = event_no_events;
 
+  module_register( &event_module_info );
+
   return 0;
 }
 
@@ -89,18 +127,46 @@ event_add_cmp( gconstpointer a1, gconstpointer b1 )
 		                  : a->type - b->type;
 }
 
+/* Get an unused event */
+static event_t*
+event_alloc( void )
+{
+  event_block_t *block;
+  event_t *ptr;
+  size_t i;
+
+  if( !event_free ) {
+    block = libspectrum_new( event_block_t, 1 );
+    block->next = event_blocks;
+    event_blocks = block;
+
+    for( i = 0; i < EVENT_BLOCK_SIZE; i++ ) {
+      block->events[i].next = event_free;
+      event_free = &block->events[i];
+    }
+  }
+
+  ptr = event_free;
+  event_free = ptr->next;
+
+  return ptr;
+}
+
+/* Return an event to be reused */
+static void
+event_release( event_t *ptr )
+{
+  ptr->next = event_free;
+  event_free = ptr;
+}
+
 /* Add an event at the correct place in the event list */
 void
 event_add_with_data( libspectrum_dword event_time, int type, void *user_data )
 {
-  event_t *ptr;
+  event_t *ptr, **link;
 
-  if( event_free ) {
-    ptr = event_free;
-    event_free = NULL;
-  } else {
-    ptr = libspectrum_new( event_t, 1 );
-  }
+  ptr = event_alloc();
 
   ptr->tstates = event_time;
   ptr->type =type;
@@ -108,9 +174,15 @@ event_add_with_data( libspectrum_dword event_time, int type, void *user_data )
 
   if( event_time < event_next_event ) {
     event_next_event = event_time;
-    event_list = g_slist_prepend( event_list, ptr );
+    ptr->next = event_list;
+    event_list = ptr;
   } else {
-    event_list = g_slist_insert_sorted( event_list, ptr, event_add_cmp );
+    /* After any events which are due earlier, but before any equal ones */
+    for( link = &event_list; *link && event_add_cmp( ptr, *link ) > 0;
+         link = &(*link)->next )
+      ;
+    ptr->next = *link;
+    *link = ptr;
   }
 }
 
@@ -122,48 +194,38 @@ event_do_events( void )
 
   while(event_next_event <= tstates) {
     event_descriptor_t descriptor;
-    ptr = event_list->data;
+    ptr = event_list;
     descriptor =
       g_array_index( registered_events, event_descriptor_t, ptr->type );
 
     /* Remove the event from the list *before* processing */
-    event_list = g_slist_remove( event_list, ptr );
+    event_list = ptr->next;
 
     if( event_list == NULL ) {
       event_next_event = event_no_events;
     } else {
-      event_next_event = ((event_t*)(event_list->data))->tstates;
+      event_next_event = event_list->tstates;
     }
 
+    perfstats_count( PERFSTATS_COUNTER_EVENTS, 1 );
     if( descriptor.fn ) descriptor.fn( ptr->tstates, ptr->type, ptr->user_data );
 
-    if( event_free ) {
-      libspectrum_free( ptr );
-    } else {
-      event_free = ptr;
-    }
+    event_release( ptr );
   }
 
   return 0;
 }
 
-static void
-event_reduce_tstates( gpointer data, gpointer user_data )
-{
-  event_t *ptr = data;
-  libspectrum_dword *tstates_per_frame = user_data;
-
-  ptr->tstates -= *tstates_per_frame;
-}
-
 /* Called at end of frame to reduce T-state count of all entries */
 void
 event_frame( libspectrum_dword tstates_per_frame )
 {
-  g_slist_foreach( event_list, event_reduce_tstates, &tstates_per_frame );
+  event_t *ptr;
+
+  for( ptr = event_list; ptr; ptr = ptr->next )
+    ptr->tstates -= tstates_per_frame;
 
-  event_next_event = event_list ?
-    ((event_t*)(event_list->data))->tstates : event_no_events;
+  event_next_event = event_list ? event_list->tstates : event_no_events;
 }
 
 /* Do all events that would happen between the current time and when
@@ -183,69 +245,84 @@ event_force_events( void )
   }
 }
 
-static void
-set_event_null( gpointer data, gpointer user_data )
-{
-  event_t *ptr = data;
-  int *type = user_data;
-
-  if( ptr->type == *type ) ptr->type = event_type_null;
-}
-
-static void
-set_event_null_with_user_data( gpointer data, gpointer user_data )
-{
-  event_t *event = data;
-  event_t *template = user_data;
-
-  if( event->type == template->type && event->user_data == template->user_data )
-    event->type = event_type_null;
-}
-
 /* Remove all events of a specific type from the stack */
 void
 event_remove_type( int type )
 {
-  g_slist_foreach( event_list, set_event_null, &type );
+  event_t *ptr;
+
+  for( ptr = event_list; ptr; ptr = ptr->next )
+    if( ptr->type == type ) ptr->type = event_type_null;
 }
 
 /* Remove all events of a specific type and user data from the stack */
 void
 event_remove_type_user_data( int type, gpointer user_data )
 {
-  event_t template;
+  event_t *ptr;
 
-  template.type = type;
-  template.user_data = user_data;
-  g_slist_foreach( event_list, set_event_null_with_user_data, &template );
-}
-
-/* Free the memory used by a specific entry */
-static void
-event_free_entry( gpointer data, gpointer user_data GCC_UNUSED )
-{
-  libspectrum_free( data );
+  for( ptr = event_list; ptr; ptr = ptr->next )
+    if( ptr->type == type && ptr->user_data == user_data )
+      ptr->type = event_type_null;
 }
 
 /* Clear the event stack */
 void
 event_reset( void )
 {
-  g_slist_foreach( event_list, event_free_entry, NULL );
-  g_slist_free( event_list );
+  event_t *ptr, *next;
+
+  for( ptr = event_list; ptr; ptr = next ) {
+    next = ptr->next;
+    event_release( ptr );
+  }
   event_list = NULL;
 
   event_next_event = event_no_events;
-
-  libspectrum_free( event_free );
-  event_free = NULL;
 }
 
 /* Call a user-supplied function for every event in the current list */
 void
 event_foreach( GFunc function, gpointer user_data )
 {
-  g_slist_foreach( event_list, function, user_data );
+  event_t *ptr, *next;
+
+  for( ptr = event_list; ptr; ptr = next ) {
+    next = ptr->next;
+    function( ptr, user_data );
+  }
+}
+
+static void
+event_state_save( int slot )
+{
+  event_t *ptr;
+
+  g_array_set_size( saved_events[ slot ], 0 );
+  for( ptr = event_list; ptr; ptr = ptr->next )
+    g_array_append_val( saved_events[ slot ], *ptr );
+}
+
+static void
+event_state_restore( int slot )
+{
+  GArray *saved = saved_events[ slot ];
+  event_t *ptr, **link;
+  guint i;
+
+  event_reset();
+
+  /* The saved events are already in order, so just append each one */
+  link = &event_list;
+  for( i = 0; i < saved->len; i++ ) {
+    ptr = event_alloc();
+    *ptr = g_array_index( saved, event_t, i );
+    *link = ptr;
+    link = &ptr->next;
+  }
+  *link = NULL;
+
+  event_next_event = event_list ? event_list->tstates : event_no_events;
 }
 
 /* A textual representation of each event type */
@@ -276,8 +353,25 @@ registered_events_free( void )
 static void
 event_end( void )
 {
+  event_block_t *block, *next;
+  int i;
+
   event_reset();
   registered_events_free();
+
+  for( block = event_blocks; block; block = next ) {
+    next = block->next;
+    libspectrum_free( block );
+  }
+  event_blocks = NULL;
+  event_free = NULL;
+
+  for( i = 0; i < MODULE_STATE_SLOTS; i++ ) {
+    if( saved_events[i] ) {
+      g_array_free( saved_events[i], TRUE );
+      saved_events[i] = NULL;
+    }
+  }
 }
 
 void
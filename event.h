@@ -35,6 +35,7 @@ typedef struct event_t {
   libspectrum_dword tstates;
   int type;
   void *user_data;
+  struct event_t *next;		/* The next event in the list */
 } event_t;
 
 /* A null event type */
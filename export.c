@@ -0,0 +1,390 @@
+/* export.c: Raw video and audio export
+   Copyright (c) 2026 Fuse contributors
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+   Author contact information:
+
+   E-mail: philip-fuse@shadowmagic.org.uk
+
+*/
+
+/*
+  Unlike FMF movies, which need fmfconv to be turned into anything useful,
+  this writes the emulated screen directly as YUV4MPEG2 (.y4m) or raw 24-bit
+  RGB frames (.rgb), and the sound as a 16-bit PCM .wav file. One video frame
+  is written for every emulated frame, regardless of the frame rate setting.
+
+  Along with --no-sound and the null UI this allows RZX recordings to be
+  rendered to video much faster than real time.
+*/
+
+#include <config.h>
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <libspectrum.h>
+
+#include "display.h"
+#include "export.h"
+#include "machine.h"
+#include "screenshot.h"
+#include "settings.h"
+#include "sound.h"
+#include "ui/scaler/scaler.h"
+#include "ui/ui.h"
+
+typedef enum export_video_format {
+  EXPORT_VIDEO_Y4M,
+  EXPORT_VIDEO_RGB,
+} export_video_format;
+
+int export_active = 0;
+int export_audio_active = 0;
+
+static FILE *video_file = NULL;
+static export_video_format video_format;
+static ScalerProc *video_scaler;
+static size_t base_width, base_height, width, height, rgb32_stride;
+
+/* Unscaled and scaled RGB(padding) data, and one frame of output */
+static libspectrum_byte *rgb32_data, *scaled_data, *frame_data;
+static size_t frame_size;
+
+static FILE *audio_file = NULL;
+static int audio_channels;
+static libspectrum_dword audio_bytes;
+
+/* Were any samples delivered by the sound code for this frame? If not, sound
+   was paused (eg while fastloading) and we write silence to stay in sync
+   with the video */
+static int audio_delivered;
+static libspectrum_qword audio_fraction;
+
+static void
+write_le_word( libspectrum_byte *buffer, libspectrum_word value )
+{
+  buffer[0] = value & 0xff;
+  buffer[1] = value >> 8;
+}
+
+static void
+write_le_dword( libspectrum_byte *buffer, libspectrum_dword value )
+{
+  write_le_word( buffer, value & 0xffff );
+  write_le_word( buffer + 2, value >> 16 );
+}
+
+static void
+write_wav_header( void )
+{
+  libspectrum_byte header[44];
+  int freq = settings_current.sound_freq;
+
+  memcpy( header, "RIFF", 4 );
+  write_le_dword( header + 4, 36 + audio_bytes );
+  memcpy( header + 8, "WAVEfmt ", 8 );
+  write_le_dword( header + 16, 16 );			/* fmt chunk size */
+  write_le_word( header + 20, 1 );			/* PCM */
+  write_le_word( header + 22, audio_channels );
+  write_le_dword( header + 24, freq );
+  write_le_dword( header + 28, freq * audio_channels * 2 );
+  write_le_word( header + 32, audio_channels * 2 );	/* block align */
+  write_le_word( header + 34, 16 );			/* bits per sample */
+  memcpy( header + 36, "data", 4 );
+  write_le_dword( header + 40, audio_bytes );
+
+  fwrite( header, sizeof( header ), 1, audio_file );
+}
+
+static libspectrum_dword
+gcd( libspectrum_dword a, libspectrum_dword b )
+{
+  while( b ) {
+    libspectrum_dword t = a % b;
+    a = b;
+    b = t;
+  }
+
+  return a;
+}
+
+static int
+start_video( const char *filename )
+{
+  const char *extension;
+  scaler_type scaler = SCALER_NORMAL;
+  float scale;
+  libspectrum_dword rate_num, rate_den, divisor;
+  size_t i;
+
+  if( settings_current.export_scaler ) {
+    for( i = 0; i < SCALER_NUM; i++ )
+      if( !strcmp( scaler_id( i ), settings_current.export_scaler ) ) break;
+    if( i == SCALER_NUM || !screenshot_available_scalers( i ) ) {
+      ui_error( UI_ERROR_ERROR, "scaler '%s' cannot be used for export",
+                settings_current.export_scaler );
+      return 1;
+    }
+    scaler = i;
+  }
+
+  if( machine_current->timex ) {
+    base_width = DISPLAY_SCREEN_WIDTH;
+    base_height = 2 * DISPLAY_SCREEN_HEIGHT;
+  } else {
+    base_width = DISPLAY_ASPECT_WIDTH;
+    base_height = DISPLAY_SCREEN_HEIGHT;
+  }
+
+  scale = scaler_get_scaling_factor( scaler );
+  width = base_width * scale;
+  height = base_height * scale;
+
+  /* Big enough for both the unscaled and the scaled data */
+  rgb32_stride = ( scale > 1 ? width : base_width ) * 4;
+  rgb32_data = libspectrum_new( libspectrum_byte,
+                                rgb32_stride * ( scale > 1 ? height :
+                                                             base_height ) );
+  scaled_data = libspectrum_new( libspectrum_byte,
+                                 rgb32_stride * ( scale > 1 ? height :
+                                                              base_height ) );
+  video_scaler = scaler_get_proc32( scaler );
+
+  extension = strrchr( filename, '.' );
+  video_format = extension && !strcmp( extension, ".rgb" ) ?
+                 EXPORT_VIDEO_RGB : EXPORT_VIDEO_Y4M;
+
+  /* RGB is 3 bytes per pixel; Y4M is 4:4:4 so also 3 bytes per pixel */
+  frame_size = width * height * 3;
+  frame_data = libspectrum_new( libspectrum_byte, frame_size );
+
+  video_file = fopen( filename, "wb" );
+  if( !video_file ) {
+    ui_error( UI_ERROR_ERROR, "error opening export file '%s': %s", filename,
+              strerror( errno ) );
+    return 1;
+  }
+
+  if( video_format == EXPORT_VIDEO_Y4M ) {
+    rate_num = machine_current->timings.processor_speed;
+    rate_den = machine_current->timings.tstates_per_frame;
+    divisor = gcd( rate_num, rate_den );
+
+    fprintf( video_file, "YUV4MPEG2 W%lu H%lu F%lu:%lu Ip A1:1 C444\n",
+             (unsigned long)width, (unsigned long)height,
+             (unsigned long)( rate_num / divisor ),
+             (unsigned long)( rate_den / divisor ) );
+  } else {
+    ui_error( UI_ERROR_INFO, "exporting raw RGB24 video at %lux%lu",
+              (unsigned long)width, (unsigned long)height );
+  }
+
+  return 0;
+}
+
+static int
+start_audio( const char *filename )
+{
+  audio_file = fopen( filename, "wb" );
+  if( !audio_file ) {
+    ui_error( UI_ERROR_ERROR, "error opening export file '%s': %s", filename,
+              strerror( errno ) );
+    return 1;
+  }
+
+  /* Sound generation is normally tied to there being a sound device; make
+     sure we get samples even with --no-sound */
+  export_audio_active = 1;
+  if( !sound_enabled ) sound_init( settings_current.sound_device );
+
+  audio_channels = sound_stereo_ay != SOUND_STEREO_AY_NONE ? 2 : 1;
+  audio_bytes = 0;
+  audio_delivered = 0;
+  audio_fraction = 0;
+
+  /* Placeholder; the sizes are filled in when the export is stopped */
+  write_wav_header();
+
+  return 0;
+}
+
+int
+export_start( const char *video_filename, const char *audio_filename )
+{
+  if( export_active ) export_stop();
+
+  if( video_filename && *video_filename ) {
+    if( start_video( video_filename ) ) { export_stop(); return 1; }
+  }
+
+  if( audio_filename && *audio_filename ) {
+    if( start_audio( audio_filename ) ) { export_stop(); return 1; }
+  }
+
+  export_active = video_file || audio_file;
+
+  return 0;
+}
+
+void
+export_stop( void )
+{
+  if( video_file ) {
+    if( fclose( video_file ) )
+      ui_error( UI_ERROR_ERROR, "error closing video export file: %s",
+                strerror( errno ) );
+    video_file = NULL;
+  }
+
+  libspectrum_free( rgb32_data ); rgb32_data = NULL;
+  libspectrum_free( scaled_data ); scaled_data = NULL;
+  libspectrum_free( frame_data ); frame_data = NULL;
+
+  if( audio_file ) {
+    if( !fseek( audio_file, 0, SEEK_SET ) ) write_wav_header();
+    if( fclose( audio_file ) )
+      ui_error( UI_ERROR_ERROR, "error closing audio export file: %s",
+                strerror( errno ) );
+    audio_file = NULL;
+  }
+
+  export_active = 0;
+  export_audio_active = 0;
+}
+
+int
+export_unthrottled( void )
+{
+  return export_active && settings_current.export_full_speed;
+}
+
+static void
+convert_frame( void )
+{
+  libspectrum_byte *src, *y_plane, *u_plane, *v_plane, *dest;
+  size_t x, y;
+
+  screenshot_get_rgb32_data( rgb32_data, rgb32_stride, base_height,
+                             base_width );
+  video_scaler( rgb32_data, rgb32_stride, scaled_data, rgb32_stride,
+                base_width, base_height );
+
+  if( video_format == EXPORT_VIDEO_RGB ) {
+    for( y = 0, dest = frame_data; y < height; y++ ) {
+      src = &scaled_data[ y * rgb32_stride ];
+      for( x = 0; x < width; x++, src += 4 ) {
+        *dest++ = src[0]; *dest++ = src[1]; *dest++ = src[2];
+      }
+    }
+    return;
+  }
+
+  /* ITU-R BT.601 studio range, which is what Y4M consumers expect */
+  y_plane = frame_data;
+  u_plane = y_plane + width * height;
+  v_plane = u_plane + width * height;
+
+  for( y = 0; y < height; y++ ) {
+    src = &scaled_data[ y * rgb32_stride ];
+    for( x = 0; x < width; x++, src += 4 ) {
+      int r = src[0], g = src[1], b = src[2];
+      *y_plane++ = ( (  66 * r + 129 * g +  25 * b + 128 ) >> 8 ) +  16;
+      *u_plane++ = ( ( -38 * r -  74 * g + 112 * b + 128 ) >> 8 ) + 128;
+      *v_plane++ = ( ( 112 * r -  94 * g -  18 * b + 128 ) >> 8 ) + 128;
+    }
+  }
+}
+
+static void
+write_silence( void )
+{
+  static const libspectrum_byte silence[ 1024 ] = { 0 };
+  libspectrum_qword rate = settings_current.sound_freq;
+  size_t bytes;
+
+  /* The number of samples in a frame isn't an integer, so carry the
+     remainder over between frames */
+  audio_fraction += rate * machine_current->timings.tstates_per_frame;
+  bytes = audio_fraction / machine_current->timings.processor_speed *
+          audio_channels * 2;
+  audio_fraction %= machine_current->timings.processor_speed;
+
+  audio_bytes += bytes;
+
+  while( bytes ) {
+    size_t chunk = bytes > sizeof( silence ) ? sizeof( silence ) : bytes;
+    fwrite( silence, chunk, 1, audio_file );
+    bytes -= chunk;
+  }
+}
+
+void
+export_frame( void )
+{
+  if( video_file ) {
+    convert_frame();
+
+    if( video_format == EXPORT_VIDEO_Y4M )
+      fwrite( "FRAME\n", 6, 1, video_file );
+    if( fwrite( frame_data, frame_size, 1, video_file ) != 1 ) {
+      ui_error( UI_ERROR_ERROR, "error writing video export: %s",
+                strerror( errno ) );
+      export_stop();
+      return;
+    }
+  }
+
+  if( audio_file ) {
+    if( !audio_delivered ) write_silence();
+    audio_delivered = 0;
+  }
+}
+
+void
+export_add_sound( libspectrum_signed_word *buf, int len )
+{
+  if( !audio_file ) return;
+
+  audio_delivered = 1;
+  audio_bytes += len * 2;
+
+#ifdef WORDS_BIGENDIAN
+  while( len ) {
+    libspectrum_byte buffer[ 4096 ];
+    size_t i, count = len > sizeof( buffer ) / 2 ? sizeof( buffer ) / 2 : len;
+
+    for( i = 0; i < count; i++ )
+      write_le_word( buffer + 2 * i, buf[i] );
+    fwrite( buffer, count * 2, 1, audio_file );
+
+    buf += count;
+    len -= count;
+  }
+#else				/* #ifdef WORDS_BIGENDIAN */
+  fwrite( buf, len * 2, 1, audio_file );
+#endif				/* #ifdef WORDS_BIGENDIAN */
+}
+
+void
+export_init( void )
+{
+  /* Start exporting if the user requested it on the command line */
+  if( settings_current.export_video || settings_current.export_audio )
+    export_start( settings_current.export_video,
+                  settings_current.export_audio );
+}
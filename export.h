@@ -0,0 +1,49 @@
+/* export.h: Raw video and audio export
+   Copyright (c) 2026 Fuse contributors
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+   Author contact information:
+
+   E-mail: philip-fuse@shadowmagic.org.uk
+
+*/
+
+#ifndef FUSE_EXPORT_H
+#define FUSE_EXPORT_H
+
+#include <libspectrum.h>
+
+/* Is a raw video or audio export in progress? */
+extern int export_active;
+
+/* Is a raw audio export in progress (and so sound must be generated even if
+   there is no sound output)? */
+extern int export_audio_active;
+
+void export_init( void );
+int export_start( const char *video_filename, const char *audio_filename );
+void export_stop( void );
+
+/* Should the emulation run as fast as possible rather than at real speed? */
+int export_unthrottled( void );
+
+/* Called once per emulated frame after the screen has been updated */
+void export_frame( void );
+
+/* Called with each frame's worth of sound samples */
+void export_add_sound( libspectrum_signed_word *buf, int len );
+
+#endif				/* #ifndef FUSE_EXPORT_H */
@@ -53,10 +53,14 @@
 #include <libxml/encoding.h>
 #endif
 
+#include "benchmarks/benchmarks.h"
+#include "compat.h"
 #include "debugger/debugger.h"
 #include "display.h"
 #include "event.h"
+#include "export.h"
 #include "fuse.h"
+#include "fuzz/fuzz.h"
 #include "infrastructure/startup_manager.h"
 #include "keyboard.h"
 #include "machine.h"
@@ -65,6 +69,8 @@
 #include "module.h"
 #include "movie.h"
 #include "mempool.h"
+#include "netplay.h"
+#include "perfstats.h"
 #include "peripherals/ay.h"
 #include "peripherals/dck.h"
 #include "peripherals/disk/beta.h"
@@ -93,12 +99,14 @@
 #include "pokefinder/pokemem.h"
 #include "profile.h"
 #include "psg.h"
+#include "runahead.h"
 #include "rzx.h"
 #include "settings.h"
 #include "slt.h"
 #include "snapshot.h"
 #include "sound.h"
 #include "spectrum.h"
+#include "statelog.h"
 #include "tape.h"
 #include "timer/timer.h"
 #include "ui/scaler/scaler.h"
@@ -194,10 +202,20 @@ int main(int argc, char **argv)
 
   if( settings_current.unittests ) {
     r = unittests_run();
+  } else if( settings_current.benchmark ) {
+    r = benchmarks_run();
+  } else if( settings_current.fuzz ) {
+    r = fuzz_run();
+  } else if( settings_current.state_log || settings_current.state_golden ) {
+    r = statelog_run();
   } else {
     while( !fuse_exiting ) {
+      perfstats_enter( PERFSTATS_STAGE_Z80 );
       z80_do_opcodes();
+      perfstats_enter( PERFSTATS_STAGE_EVENTS );
       event_do_events();
+      if( netplay_pending ) netplay_run();
+      if( runahead_pending ) runahead_run();
     }
     r = debugger_get_exit_code();
   }
@@ -318,7 +336,9 @@ run_startup_manager( int *argc, char ***argv )
   memory_register_startup();
   mempool_register_startup();
   multiface_register_startup();
+  netplay_register_startup();
   opus_register_startup();
+  perfstats_register_startup();
   phantom_typist_register_startup();
   plusd_register_startup();
   printer_register_startup();
@@ -352,6 +372,9 @@ static int fuse_init(int argc, char **argv)
   int error, first_arg;
   char *start_scaler;
   start_files_t start_files;
+  double start, step;
+
+  start = compat_timer_get_monotonic_time();
 
   /* Seed the bad but widely-available random number
      generator with the current time */
@@ -373,6 +396,9 @@ static int fuse_init(int argc, char **argv)
 
   if( settings_init( &first_arg, argc, argv ) ) return 1;
 
+  startup_manager_profile( "settings",
+                           compat_timer_get_monotonic_time() - start );
+
   if( settings_current.show_version ) {
     fuse_show_version();
     return 0;
@@ -387,15 +413,21 @@ static int fuse_init(int argc, char **argv)
 
   if( run_startup_manager( &argc, &argv ) ) return 1;
 
+  step = compat_timer_get_monotonic_time();
   error = machine_select_id( settings_current.start_machine );
   if( error ) return error;
+  startup_manager_profile( "machine select",
+                           compat_timer_get_monotonic_time() - step );
 
   error = scaler_select_id( start_scaler ); libspectrum_free( start_scaler );
   if( error ) return error;
 
+  step = compat_timer_get_monotonic_time();
   if( setup_start_files( &start_files ) ) return 1;
   if( parse_nonoption_args( argc, argv, first_arg, &start_files ) ) return 1;
   if( do_start_files( &start_files ) ) return 1;
+  startup_manager_profile( "start files",
+                           compat_timer_get_monotonic_time() - step );
 
   /* Must do this after all subsytems are initialised */
   debugger_command_evaluate( settings_current.debugger_command );
@@ -404,6 +436,9 @@ static int fuse_init(int argc, char **argv)
 
   fuse_emulation_paused = 0;
   movie_init();
+  export_init();
+
+  startup_manager_profile( "total", compat_timer_get_monotonic_time() - start );
 
   return 0;
 }
@@ -948,6 +983,7 @@ do_start_files( start_files_t *start_files )
 static int fuse_end(void)
 {
   movie_stop();		/* stop movie recording */
+  export_stop();		/* stop raw export */
 
   startup_manager_run_end();
 
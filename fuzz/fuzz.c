@@ -0,0 +1,442 @@
+/* fuzz.c: coverage-guided fuzzing of input handling
+   Copyright (c) 2026 Fuse contributors
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+   Author contact information:
+
+   E-mail: philip-fuse@shadowmagic.org.uk
+
+*/
+
+/* Starting from whatever was loaded on the command line, the machine is
+   run for short stretches with random keyboard and joystick input, noting
+   the address of every instruction executed. Any sequence of input which
+   reaches code not seen before is kept in the corpus, and later runs start
+   from the end of, or part way through, one of the sequences already
+   kept. The states at the end of the most recent sequences are held in the
+   module state slots, so carrying on from one of them costs no more than
+   restoring the machine; otherwise the sequence is played again from the
+   start. A run which crashes the program is reported with the input which
+   caused it */
+
+#include <config.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include <libspectrum.h>
+
+#include "compat.h"
+#include "debugger/debugger.h"
+#include "fuse.h"
+#include "fuzz.h"
+#include "keyboard.h"
+#include "module.h"
+#include "netplay.h"
+#include "peripherals/joystick.h"
+#include "runahead.h"
+#include "settings.h"
+#include "ui/ui.h"
+#include "z80/z80.h"
+
+int fuzz_active = 0;
+libspectrum_byte fuzz_coverage[ FUZZ_COVERAGE_SIZE ];
+
+/* The slot holding the state loaded at startup; the other slots hold the
+   states at the end of corpus entries */
+#define FUZZ_START_SLOT 0
+
+/* The most input sequences kept */
+#define FUZZ_CORPUS_MAX 1024
+
+/* On average, the input changes once in this many frames, so that keys
+   are held down long enough for programs to notice them */
+#define FUZZ_CHANGE_FRAMES 8
+
+typedef struct fuzz_entry {
+  netplay_input_t *inputs;
+  size_t length;
+  int slot;		/* Holding the state at the end, or -1 */
+} fuzz_entry;
+
+static fuzz_entry corpus[ FUZZ_CORPUS_MAX ];
+static size_t corpus_size;
+
+/* Which corpus entry's state is in each slot, or -1 */
+static int slot_owner[ MODULE_STATE_SLOTS ];
+static int next_slot;
+
+/* The addresses reached by any run, and by the first run with nothing
+   pressed */
+static libspectrum_byte total_coverage[ FUZZ_COVERAGE_SIZE ];
+static libspectrum_byte start_coverage[ FUZZ_COVERAGE_SIZE ];
+
+/* The input for the run in progress */
+static netplay_input_t *run_inputs;
+static size_t run_length, run_allocated;
+
+/* What the machine sees */
+static netplay_input_t current;
+
+static const netplay_input_t neutral = {
+  { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff },
+  { 0x00, 0x00, 0x00, 0xff },
+};
+
+static libspectrum_dword frames, runs, crashes;
+
+/* A fixed seed, so that a crash can be found again by running the fuzzer
+   again with the same program and settings */
+static libspectrum_dword random_state = 0x2545f491;
+
+static libspectrum_dword
+fuzz_random( void )
+{
+  random_state ^= random_state << 13;
+  random_state ^= random_state >> 17;
+  random_state ^= random_state << 5;
+
+  return random_state;
+}
+
+static void
+random_input( netplay_input_t *input )
+{
+  libspectrum_dword r = fuzz_random();
+  libspectrum_byte directions;
+
+  *input = neutral;
+
+  switch( r & 0x03 ) {
+
+  case 0:			/* Nothing pressed */
+    break;
+
+  case 1:			/* One key */
+    r >>= 2;
+    input->keyboard[ r & 0x07 ] &= ~( 1 << ( ( r >> 3 ) % 5 ) );
+    break;
+
+  case 2:			/* Two keys, such as Caps Shift and another */
+    r >>= 2;
+    input->keyboard[ r & 0x07 ] &= ~( 1 << ( ( r >> 3 ) % 5 ) );
+    r >>= 6;
+    input->keyboard[ r & 0x07 ] &= ~( 1 << ( ( r >> 3 ) % 5 ) );
+    break;
+
+  case 3:			/* Joystick */
+    r >>= 2;
+    directions = r & 0x0f;
+    input->joystick.kempston = r & 0x1f;
+    input->joystick.timex1 = input->joystick.timex2 =
+      directions | ( r & 0x10 ? 0x80 : 0x00 );
+    input->joystick.fuller = ~input->joystick.timex1;
+    break;
+
+  }
+}
+
+static void
+run_append( const netplay_input_t *input )
+{
+  if( run_length == run_allocated ) {
+    run_allocated = run_allocated ? 2 * run_allocated : 256;
+    run_inputs = libspectrum_renew( netplay_input_t, run_inputs,
+                                    run_allocated );
+  }
+
+  run_inputs[ run_length++ ] = *input;
+}
+
+static void
+run_frame( const netplay_input_t *input )
+{
+  current = *input;
+  runahead_emulate( 1, 0 );
+  frames++;
+}
+
+static int
+coverage_reached( libspectrum_word address, const libspectrum_byte *map )
+{
+  return map[ address >> 3 ] & ( 1 << ( address & 0x07 ) );
+}
+
+/* Has the program crashed? Reaching the reset or error restart in the ROM
+   counts only if the program didn't do so when left alone */
+static const char*
+crash_reason( void )
+{
+  if( fuse_exiting ) return "exit from the debugger";
+
+  if( z80.halted && !z80.iff1 ) return "HALT with interrupts disabled";
+
+  if( coverage_reached( 0x0000, fuzz_coverage ) &&
+      !coverage_reached( 0x0000, start_coverage ) )
+    return "reset";
+
+  if( coverage_reached( 0x0008, fuzz_coverage ) &&
+      !coverage_reached( 0x0008, start_coverage ) )
+    return "error restart";
+
+  return NULL;
+}
+
+static void
+report_crash( const char *reason )
+{
+  const netplay_input_t *input, *previous = NULL;
+  size_t i;
+
+  crashes++;
+
+  printf( "fuzz: crash (%s) at PC 0x%04x after %lu frames of input",
+          reason, z80.pc.w, (unsigned long)run_length );
+  if( fuse_exiting )
+    printf( ", exit code %d", debugger_get_exit_code() );
+  printf( "\n" );
+
+  /* Just the frames where the input changes */
+  for( i = 0; i < run_length; i++ ) {
+    input = &run_inputs[i];
+    if( previous && !memcmp( input, previous, sizeof( *input ) ) ) continue;
+
+    printf( "  frame %5lu: keyboard %02x %02x %02x %02x %02x %02x %02x %02x"
+            " joystick %02x %02x %02x %02x\n", (unsigned long)i,
+            input->keyboard[0], input->keyboard[1], input->keyboard[2],
+            input->keyboard[3], input->keyboard[4], input->keyboard[5],
+            input->keyboard[6], input->keyboard[7], input->joystick.kempston,
+            input->joystick.timex1, input->joystick.timex2,
+            input->joystick.fuller );
+    previous = input;
+  }
+
+  fuse_exiting = 0;
+}
+
+/* Add the addresses reached by this run to the total, returning how many
+   of them are new */
+static size_t
+coverage_merge( void )
+{
+  size_t i, added = 0;
+  libspectrum_byte new_bits;
+
+  for( i = 0; i < FUZZ_COVERAGE_SIZE; i++ ) {
+    new_bits = fuzz_coverage[i] & ~total_coverage[i];
+    if( !new_bits ) continue;
+
+    total_coverage[i] |= new_bits;
+    for( ; new_bits; new_bits &= new_bits - 1 ) added++;
+  }
+
+  return added;
+}
+
+static size_t
+coverage_count( void )
+{
+  size_t i, count = 0;
+  libspectrum_byte bits;
+
+  for( i = 0; i < FUZZ_COVERAGE_SIZE; i++ )
+    for( bits = total_coverage[i]; bits; bits &= bits - 1 ) count++;
+
+  return count;
+}
+
+/* Keep the run just finished, along with the state the machine is in now
+   if there is a slot for it */
+static void
+corpus_add( void )
+{
+  fuzz_entry *entry;
+  int slot;
+
+  if( corpus_size == FUZZ_CORPUS_MAX ) return;
+
+  entry = &corpus[ corpus_size ];
+  entry->inputs = libspectrum_new( netplay_input_t, run_length );
+  memcpy( entry->inputs, run_inputs, run_length * sizeof( *run_inputs ) );
+  entry->length = run_length;
+
+  slot = next_slot;
+  next_slot = next_slot + 1 < MODULE_STATE_SLOTS ? next_slot + 1
+                                                 : FUZZ_START_SLOT + 1;
+
+  if( slot_owner[ slot ] >= 0 ) corpus[ slot_owner[ slot ] ].slot = -1;
+  slot_owner[ slot ] = corpus_size;
+  entry->slot = slot;
+  module_state_save( slot );
+
+  corpus_size++;
+}
+
+/* Put the machine at the point 'length' frames into 'entry' */
+static void
+corpus_replay( const fuzz_entry *entry, size_t length )
+{
+  size_t i;
+
+  run_length = 0;
+  memset( fuzz_coverage, 0, sizeof( fuzz_coverage ) );
+
+  if( length == entry->length && entry->slot >= 0 ) {
+    module_state_restore( entry->slot );
+    for( i = 0; i < length; i++ ) run_append( &entry->inputs[i] );
+    return;
+  }
+
+  module_state_restore( FUZZ_START_SLOT );
+  for( i = 0; i < length; i++ ) {
+    run_append( &entry->inputs[i] );
+    run_frame( &entry->inputs[i] );
+  }
+}
+
+static void
+fuzz_one( void )
+{
+  const fuzz_entry *entry = &corpus[ fuzz_random() % corpus_size ];
+  netplay_input_t input;
+  const char *reason;
+  size_t i, length, added;
+
+  /* Half the time carry on from the end of the sequence, which is cheap
+     if its state is still in a slot; otherwise branch off part way */
+  length = ( fuzz_random() & 1 ) ? entry->length
+                                 : fuzz_random() % ( entry->length + 1 );
+  corpus_replay( entry, length );
+
+  input = length ? entry->inputs[ length - 1 ] : neutral;
+
+  for( i = 0; i < (size_t)settings_current.fuzz_run_length; i++ ) {
+    if( fuzz_random() % FUZZ_CHANGE_FRAMES == 0 ) random_input( &input );
+
+    run_append( &input );
+    run_frame( &input );
+
+    reason = crash_reason();
+    if( reason ) {
+      report_crash( reason );
+      return;
+    }
+  }
+
+  runs++;
+
+  added = coverage_merge();
+  if( !added ) return;
+
+  corpus_add();
+
+  printf( "fuzz: run %lu, frame %lu: %lu new addresses, %lu in all, "
+          "corpus %lu\n", (unsigned long)runs, (unsigned long)frames,
+          (unsigned long)added, (unsigned long)coverage_count(),
+          (unsigned long)corpus_size );
+}
+
+/* The first run has nothing pressed, to see what the program does when
+   left alone */
+static int
+fuzz_start( void )
+{
+  const char *reason;
+  int i;
+
+  run_length = 0;
+  memset( fuzz_coverage, 0, sizeof( fuzz_coverage ) );
+
+  /* Whatever the program does by itself isn't a crash */
+  memset( start_coverage, 0xff, sizeof( start_coverage ) );
+
+  for( i = 0; i < settings_current.fuzz_run_length; i++ ) {
+    run_append( &neutral );
+    run_frame( &neutral );
+
+    reason = crash_reason();
+    if( reason ) {
+      report_crash( reason );
+      return 1;
+    }
+  }
+
+  memcpy( start_coverage, fuzz_coverage, sizeof( start_coverage ) );
+  coverage_merge();
+  corpus_add();
+
+  printf( "fuzz: %lu addresses reached with nothing pressed\n",
+          (unsigned long)coverage_count() );
+
+  return 0;
+}
+
+int
+fuzz_run( void )
+{
+  double start, elapsed;
+  size_t i;
+  int error;
+
+  if( !runahead_available() || netplay_active ) {
+    ui_error( UI_ERROR_ERROR,
+              "can't fuzz with the current machine, media or settings" );
+    return 1;
+  }
+
+  if( settings_current.fuzz_run_length < 1 )
+    settings_current.fuzz_run_length = 1;
+
+  for( i = 0; i < MODULE_STATE_SLOTS; i++ ) slot_owner[i] = -1;
+  next_slot = FUZZ_START_SLOT + 1;
+  corpus_size = 0;
+  frames = runs = crashes = 0;
+  memset( total_coverage, 0, sizeof( total_coverage ) );
+
+  module_state_save( FUZZ_START_SLOT );
+
+  current = neutral;
+  keyboard_override = current.keyboard;
+  joystick_override = &current.joystick;
+  fuzz_active = 1;
+
+  start = compat_timer_get_monotonic_time();
+
+  error = fuzz_start();
+
+  while( !error && frames < (libspectrum_dword)settings_current.fuzz_frames )
+    fuzz_one();
+
+  elapsed = compat_timer_get_monotonic_time() - start;
+
+  fuzz_active = 0;
+  keyboard_override = NULL;
+  joystick_override = NULL;
+
+  printf( "fuzz: %lu runs, %lu frames in %.1f s (%.0f frames/s): "
+          "%lu addresses reached, corpus %lu, %lu crashes\n",
+          (unsigned long)runs, (unsigned long)frames, elapsed,
+          elapsed > 0 ? frames / elapsed : 0.0,
+          (unsigned long)coverage_count(), (unsigned long)corpus_size,
+          (unsigned long)crashes );
+
+  for( i = 0; i < corpus_size; i++ ) libspectrum_free( corpus[i].inputs );
+  libspectrum_free( run_inputs );
+  run_inputs = NULL;
+  run_length = run_allocated = 0;
+
+  return error || crashes ? 1 : 0;
+}
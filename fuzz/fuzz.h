@@ -0,0 +1,39 @@
+/* fuzz.h: coverage-guided fuzzing of input handling
+   Copyright (c) 2026 Fuse contributors
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+   Author contact information:
+
+   E-mail: philip-fuse@shadowmagic.org.uk
+
+*/
+
+#ifndef FUSE_FUZZ_H
+#define FUSE_FUZZ_H
+
+#include <libspectrum.h>
+
+/* One bit for each address in the 64K the Z80 can see */
+#define FUZZ_COVERAGE_SIZE ( 0x10000 / 8 )
+
+/* Set while the fuzzer is running, so that the Z80 core marks the address
+   of each instruction it executes in fuzz_coverage */
+extern int fuzz_active;
+extern libspectrum_byte fuzz_coverage[ FUZZ_COVERAGE_SIZE ];
+
+int fuzz_run( void );
+
+#endif				/* #ifndef FUSE_FUZZ_H */
@@ -23,12 +23,16 @@
 
 #include <config.h>
 
+#include <stdio.h>
+
 #ifdef HAVE_LIB_GLIB
 #include <glib.h>
 #endif				/* #ifdef HAVE_LIB_GLIB */
 
 #include <libspectrum.h>
 
+#include "compat.h"
+#include "settings.h"
 #include "startup_manager.h"
 #include "ui/ui.h"
 
@@ -44,6 +48,18 @@ static GArray *registered_modules;
 
 static GArray *end_functions;
 
+/* In the same order as the startup_manager_module enum */
+static const char * const module_names[ STARTUP_MANAGER_MODULE_COUNT ] = {
+  "ay", "beta", "covox", "creator", "debugger", "didaktik", "disciple",
+  "display", "divide", "divmmc", "event", "fdd", "fuller", "if1", "if2",
+  "joystick", "kempmouse", "keyboard", "libspectrum", "libxml2", "machine",
+  "machines periph", "melodik", "memory", "mempool", "multiface", "netplay",
+  "opus", "perfstats", "phantom typist", "plusd", "printer", "profile", "psg",
+  "rzx", "scld", "settings end", "setuid", "simpleide", "slt", "sound",
+  "speccyboot", "specdrum", "spectranet", "spectrum", "tape", "timer", "ula",
+  "usource", "z80", "zxatasp", "zxcf", "zxmmc",
+};
+
 void
 startup_manager_init( void )
 {
@@ -114,12 +130,22 @@ remove_dependency( startup_manager_module module )
   }
 }
 
+void
+startup_manager_profile( const char *name, double seconds )
+{
+  if( settings_current.startup_profile )
+    printf( "startup: %-16s %9.3f ms\n", name, seconds * 1000 );
+}
+
 int
 startup_manager_run( void )
 {
   int progress_made;
   guint i;
   int error;
+  double start, module_start;
+
+  start = compat_timer_get_monotonic_time();
 
   /* Loop until we can't make any more progress; this will either be because
      we've called every function (good!) or because there's a logical error
@@ -135,10 +161,15 @@ startup_manager_run( void )
       if( registered_module->dependencies->len == 0 ) {
 
         if( registered_module->init_fn ) {
+          module_start = compat_timer_get_monotonic_time();
           error = registered_module->init_fn(
             registered_module->init_context
           );
           if( error ) return error;
+          startup_manager_profile(
+            module_names[ registered_module->module ],
+            compat_timer_get_monotonic_time() - module_start
+          );
         }
 
         if( registered_module->end_fn )
@@ -163,6 +194,9 @@ startup_manager_run( void )
     return 1;
   }
 
+  startup_manager_profile( "all modules",
+                           compat_timer_get_monotonic_time() - start );
+
   return 0;
 }
 
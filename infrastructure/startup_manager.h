@@ -53,7 +53,9 @@ typedef enum startup_manager_module {
   STARTUP_MANAGER_MODULE_MEMORY,
   STARTUP_MANAGER_MODULE_MEMPOOL,
   STARTUP_MANAGER_MODULE_MULTIFACE,
+  STARTUP_MANAGER_MODULE_NETPLAY,
   STARTUP_MANAGER_MODULE_OPUS,
+  STARTUP_MANAGER_MODULE_PERFSTATS,
   STARTUP_MANAGER_MODULE_PHANTOM_TYPIST,
   STARTUP_MANAGER_MODULE_PLUSD,
   STARTUP_MANAGER_MODULE_PRINTER,
@@ -78,7 +80,9 @@ typedef enum startup_manager_module {
   STARTUP_MANAGER_MODULE_ZXATASP,
   STARTUP_MANAGER_MODULE_ZXCF,
   STARTUP_MANAGER_MODULE_ZXMMC,
- 
+
+  STARTUP_MANAGER_MODULE_COUNT
+
 } startup_manager_module;
 
 /* Callback for each module's init function */
@@ -101,9 +105,14 @@ void startup_manager_register_no_dependencies(
   startup_manager_module module, startup_manager_init_fn init_fn,
   void *init_context, startup_manager_end_fn end_fn );
 
-/* Run all the registered init functions in the right order */
+/* Run all the registered init functions in the right order, printing how
+   long each took if --startup-profile was given */
 int startup_manager_run( void );
 
+/* Print how long something else done at startup took, if
+   --startup-profile was given */
+void startup_manager_profile( const char *name, double seconds );
+
 /* Run all the end functions in inverse order of the init functions */
 void startup_manager_run_end( void );
 
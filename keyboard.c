@@ -38,6 +38,8 @@
 */
 libspectrum_byte keyboard_return_values[8];
 
+const libspectrum_byte *keyboard_override = NULL;
+
 /* The hash used for storing the UI -> Fuse input layer key mappings */
 static GHashTable *keysyms_hash;
 
@@ -326,9 +328,11 @@ libspectrum_byte
 keyboard_read( libspectrum_byte porth )
 {
   libspectrum_byte data = 0xff; int i;
+  const libspectrum_byte *values =
+    keyboard_override ? keyboard_override : keyboard_return_values;
 
   for( i=0; i<8; i++,porth>>=1 ) {
-    if(! (porth&0x01) ) data &= keyboard_return_values[i];
+    if(! (porth&0x01) ) data &= values[i];
   }
 
   return data;
@@ -31,6 +31,10 @@
 extern libspectrum_byte keyboard_default_value;
 extern libspectrum_byte keyboard_return_values[8];
 
+/* If set, what the emulated machine sees instead of
+   keyboard_return_values; used by netplay */
+extern const libspectrum_byte *keyboard_override;
+
 /* A numeric identifier for each Spectrum key. Chosen to map to ASCII in
    most cases */
 typedef enum keyboard_key_name {
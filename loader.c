@@ -26,6 +26,7 @@
 #include "event.h"
 #include "loader.h"
 #include "memory_pages.h"
+#include "runahead.h"
 #include "rzx.h"
 #include "settings.h"
 #include "spectrum.h"
@@ -411,7 +412,8 @@ loader_detect_loader( void )
   last_tstates_read = tstates;
   last_b_read = z80.bc.b.h;
 
-  if( settings_current.detect_loader ) {
+  /* Frames run ahead must not start or stop the tape */
+  if( settings_current.detect_loader && !runahead_active ) {
 
     if( tape_is_playing() ) {
       if( tstates_diff > 1000 || ( b_diff != 1 && b_diff != 0 &&
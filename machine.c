@@ -26,7 +26,9 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "bootcache.h"
 #include "event.h"
+#include "export.h"
 #include "fuse.h"
 #include "infrastructure/startup_manager.h"
 #include "machine.h"
@@ -50,6 +52,7 @@
 #include "ui/ui.h"
 #include "ui/uidisplay.h"
 #include "utils.h"
+#include "z80/z80.h"
 
 fuse_machine_info **machine_types = NULL; /* Array of available machines */
 int machine_count = 0;
@@ -142,6 +145,7 @@ machine_select( libspectrum_machine type )
   /* We don't want to have to deal with screen size changes in the movie code
      and recording movies where we change machines seems pretty obscure */
   movie_stop();
+  export_stop();
 
   for( i=0; i < machine_count; i++ ) {
     if( machine_types[i]->machine == type ) {
@@ -207,6 +211,8 @@ machine_select_machine( fuse_machine_info *machine )
 
   machine_current = machine;
 
+  memory_ram_allocate( machine->ram.valid_pages );
+
   settings_set_string( &settings_current.start_machine, machine->id );
   
   tstates = 0;
@@ -362,12 +368,17 @@ machine_reset( int hard_reset )
     ula_contention_no_mreq[ i ] = machine_current->ram.contend_delay_no_mreq( i );
   }
 
+  /* Contention may have changed, so choose the right Z80 core */
+  z80_select_core();
+
   /* Update the disk menu items */
   ui_menu_disk_update();
 
   /* clear out old display image ready for new one */
   display_refresh_all();
 
+  if( hard_reset ) bootcache_reset();
+
   return 0;
 }
 
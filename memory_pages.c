@@ -48,6 +48,7 @@
 #include "spectrum.h"
 #include "ui/ui.h"
 #include "utils.h"
+#include "z80/z80_cache.h"
 
 /* The various sources of memory available to us */
 static GArray *memory_sources;
@@ -64,6 +65,27 @@ int memory_source_none; /* No memory attached here */
 memory_page memory_map_read[MEMORY_PAGES_IN_64K];
 memory_page memory_map_write[MEMORY_PAGES_IN_64K];
 
+/* The parts of the above used by the Z80 core */
+libspectrum_byte *memory_map_read_page[MEMORY_PAGES_IN_64K];
+libspectrum_dword memory_map_read_contended;
+libspectrum_dword memory_map_write_contended;
+libspectrum_byte *memory_map_write_page[MEMORY_PAGES_IN_64K];
+libspectrum_dword memory_map_execute_watched;
+libspectrum_dword memory_map_read_watched;
+libspectrum_dword memory_map_write_watched;
+
+/* How writes to each page are handled */
+typedef enum memory_write_type {
+  MEMORY_WRITE_ROM,		/* Ignore the write unless ROMs are writable */
+  MEMORY_WRITE_RAM,		/* Just store the byte */
+  MEMORY_WRITE_SCREEN,		/* Store the byte and redraw the screen */
+  MEMORY_WRITE_FLASH,		/* Pass to the Spectranet flash ROM first */
+  MEMORY_WRITE_W5100,		/* Spectranet W5100 registers */
+  MEMORY_WRITE_OPUS,		/* Opus Discovery FDC and PIA */
+} memory_write_type;
+
+static memory_write_type memory_map_write_type[MEMORY_PAGES_IN_64K];
+
 /* Standard mappings for the 'normal' RAM */
 memory_page memory_map_ram[SPECTRUM_RAM_PAGES * MEMORY_PAGES_IN_16K];
 
@@ -74,19 +96,39 @@ memory_page memory_map_rom[SPECTRUM_ROM_PAGES * MEMORY_PAGES_IN_16K];
 typedef struct memory_pool_entry_t {
   int persistent;
   libspectrum_byte *memory;
+  size_t length;
 } memory_pool_entry_t;
 
 /* All the memory we've allocated for this machine */
 static GSList *pool;
 
+/* The memory behind RAM[], and how many 16Kb pages of it there are */
+static libspectrum_byte *ram_block;
+static size_t ram_pages;
+
 /* Which RAM page contains the current screen */
 int memory_current_screen;
 
 /* Which bits to look at when working out where the screen is */
 libspectrum_word memory_screen_mask;
 
+/* The copies of memory kept by memory_state_save() */
+typedef struct memory_state_t {
+  libspectrum_byte *ram;
+  size_t ram_pages;
+  memory_page map_read[MEMORY_PAGES_IN_64K];
+  memory_page map_write[MEMORY_PAGES_IN_64K];
+  spectrum_raminfo raminfo;
+  int current_screen;
+  libspectrum_word screen_mask;
+} memory_state_t;
+
+static memory_state_t saved_state[ MODULE_STATE_SLOTS ];
+
 static void memory_from_snapshot( libspectrum_snap *snap );
 static void memory_to_snapshot( libspectrum_snap *snap );
+static void memory_state_save( int slot );
+static void memory_state_restore( int slot );
 
 static module_info_t memory_module_info = {
 
@@ -95,6 +137,8 @@ static module_info_t memory_module_info = {
   NULL,
   memory_from_snapshot,
   memory_to_snapshot,
+  memory_state_save,
+  memory_state_restore,
 
 };
 
@@ -129,7 +173,7 @@ memory_init( void *context )
   for( i = 0; i < SPECTRUM_RAM_PAGES; i++ )
     for( j = 0; j < MEMORY_PAGES_IN_16K; j++ ) {
       memory_page *page = &memory_map_ram[i * MEMORY_PAGES_IN_16K + j];
-      page->page = &RAM[i][j * MEMORY_PAGE_SIZE];
+      page->page = NULL;
       page->page_num = i;
       page->offset = j * MEMORY_PAGE_SIZE;
       page->writable = 1;
@@ -173,6 +217,57 @@ memory_end( void )
     g_array_free( memory_sources, TRUE );
     memory_sources = NULL;
   }
+
+  for( i = 0; i < MODULE_STATE_SLOTS; i++ ) {
+    libspectrum_free( saved_state[i].ram );
+    saved_state[i].ram = NULL;
+  }
+
+  libspectrum_free( ram_block );
+  ram_block = NULL;
+  ram_pages = 0;
+  for( i = 0; i < SPECTRUM_RAM_PAGES; i++ ) RAM[i] = NULL;
+}
+
+void
+memory_ram_allocate( size_t pages )
+{
+  libspectrum_byte *block;
+  size_t i, j;
+
+  /* The 48K machines use pages 0, 2 and 5, so always have at least the
+     first 128K */
+  if( pages < 8 ) pages = 8;
+  if( pages > SPECTRUM_RAM_PAGES ) pages = SPECTRUM_RAM_PAGES;
+
+  if( pages == ram_pages ) return;
+
+  /* A large zeroed block comes straight from the operating system, which
+     only finds memory for each part of it when that part is first written
+     to, so pages the machine never uses cost nothing */
+  block = libspectrum_new0( libspectrum_byte, pages * 0x4000 );
+
+  if( ram_block ) {
+    memcpy( block, ram_block, ( pages < ram_pages ? pages : ram_pages ) * 0x4000 );
+    libspectrum_free( ram_block );
+  }
+
+  ram_block = block;
+  ram_pages = pages;
+
+  for( i = 0; i < SPECTRUM_RAM_PAGES; i++ ) {
+    RAM[i] = i < ram_pages ? &ram_block[ i * 0x4000 ] : NULL;
+
+    for( j = 0; j < MEMORY_PAGES_IN_16K; j++ )
+      memory_map_ram[ i * MEMORY_PAGES_IN_16K + j ].page =
+        RAM[i] ? &RAM[i][ j * MEMORY_PAGE_SIZE ] : NULL;
+  }
+}
+
+size_t
+memory_ram_pages( void )
+{
+  return ram_pages;
 }
 
 void
@@ -235,6 +330,7 @@ memory_pool_allocate_persistent( size_t length, int persistent )
 
   entry->persistent = persistent;
   entry->memory = memory;
+  entry->length = length;
 
   pool = g_slist_prepend( pool, entry );
 
@@ -248,6 +344,22 @@ find_non_persistent( gconstpointer data, gconstpointer user_data GCC_UNUSED )
   return entry->persistent;
 }
 
+libspectrum_dword
+memory_pool_hash( libspectrum_dword check )
+{
+  const memory_pool_entry_t *entry;
+  GSList *ptr;
+  size_t i;
+
+  for( ptr = pool; ptr; ptr = ptr->next ) {
+    entry = ptr->data;
+    for( i = 0; i < entry->length; i++ )
+      check = ( check ^ entry->memory[i] ) * 16777619UL;
+  }
+
+  return check;
+}
+
 /* Free all non-persistent memory in the pool */
 void
 memory_pool_free( void )
@@ -273,6 +385,117 @@ memory_ram_set_16k_contention( int page_num, int contended )
     memory_map_ram[ page_num * MEMORY_PAGES_IN_16K + i ].contended = contended;
 }
 
+/* Could a write to this page change the screen? This need only be
+   conservative as memory_display_dirty() checks each write properly */
+static int
+memory_page_has_screen( const memory_page *mapping )
+{
+  if( mapping->source != memory_source_ram ) return 0;
+
+  /* The Pentagon 16 colour mode uses both halves of two pages */
+  if( memory_display_dirty == memory_display_dirty_pentagon_16_col )
+    return mapping->page_num >= 4 && mapping->page_num <= 7 &&
+           ( mapping->offset & 0xdfff ) < 0x1b00;
+
+  /* The screen is always in page 5 or page 7 */
+  return ( mapping->page_num == 5 || mapping->page_num == 7 ) &&
+         ( mapping->offset & memory_screen_mask ) < 0x1b00;
+}
+
+/* Choose how writes to one page are to be handled */
+static memory_write_type
+memory_write_type_choose( int page_num )
+{
+  memory_page *mapping = &memory_map_write[ page_num ];
+  libspectrum_word address = page_num << MEMORY_PAGE_SIZE_LOGARITHM;
+
+  if( spectranet_paged ) {
+    if( ( spectranet_w5100_paged_a && address >= 0x1000 && address < 0x2000 ) ||
+        ( spectranet_w5100_paged_b && address >= 0x2000 && address < 0x3000 ) )
+      return MEMORY_WRITE_W5100;
+
+    /* All writes need to be parsed by the flash ROM emulation */
+    return MEMORY_WRITE_FLASH;
+  }
+
+  if( opus_active && address >= 0x2800 && address < 0x3800 )
+    return MEMORY_WRITE_OPUS;
+
+  if( !mapping->writable ) return MEMORY_WRITE_ROM;
+
+  if( memory_page_has_screen( mapping ) ) return MEMORY_WRITE_SCREEN;
+
+  return MEMORY_WRITE_RAM;
+}
+
+static void
+memory_map_set_bit( libspectrum_dword *mask, int page_num, int set )
+{
+  libspectrum_dword bit = (libspectrum_dword)1 << page_num;
+
+  if( set ) {
+    *mask |= bit;
+  } else {
+    *mask &= ~bit;
+  }
+}
+
+/* Work out whether any breakpoints could trigger on one page */
+static void
+memory_map_update_watched( int page_num )
+{
+  memory_map_set_bit(
+    &memory_map_execute_watched, page_num,
+    debugger_breakpoint_watches_page( DEBUGGER_BREAKPOINT_TYPE_EXECUTE,
+                                      page_num ) );
+  memory_map_set_bit(
+    &memory_map_read_watched, page_num,
+    debugger_breakpoint_watches_page( DEBUGGER_BREAKPOINT_TYPE_READ,
+                                      page_num ) );
+  memory_map_set_bit(
+    &memory_map_write_watched, page_num,
+    debugger_breakpoint_watches_page( DEBUGGER_BREAKPOINT_TYPE_WRITE,
+                                      page_num ) );
+}
+
+void
+memory_map_update_watches( void )
+{
+  size_t i;
+
+  for( i = 0; i < MEMORY_PAGES_IN_64K; i++ ) memory_map_update_watched( i );
+}
+
+/* Copy one page's mapping into memory_map_read_page[] and the
+   contention and watch masks, and work out how writes to it are
+   handled */
+static void
+memory_map_update_compact( int page_num )
+{
+  libspectrum_dword bit = (libspectrum_dword)1 << page_num;
+  memory_write_type write_type = memory_write_type_choose( page_num );
+
+  memory_map_read_page[ page_num ] = memory_map_read[ page_num ].page;
+
+  memory_map_write_type[ page_num ] = write_type;
+  memory_map_write_page[ page_num ] =
+    write_type == MEMORY_WRITE_RAM ? memory_map_write[ page_num ].page : NULL;
+
+  if( memory_map_read[ page_num ].contended ) {
+    memory_map_read_contended |= bit;
+  } else {
+    memory_map_read_contended &= ~bit;
+  }
+
+  if( memory_map_write[ page_num ].contended ) {
+    memory_map_write_contended |= bit;
+  } else {
+    memory_map_write_contended &= ~bit;
+  }
+
+  memory_map_update_watched( page_num );
+}
+
 /* Map 16K of memory */
 void
 memory_map_16k( libspectrum_word address, memory_page source[], int page_num )
@@ -330,6 +553,7 @@ memory_map_2k_read_write( libspectrum_word address, memory_page source[],
     memory_page *page = &source[ page_num * MEMORY_PAGES_IN_2K + i ];
     if( map_read ) memory_map_read[ page_offset ] = *page;
     if( map_write ) memory_map_write[ page_offset ] = *page;
+    memory_map_update_compact( page_offset );
   }
 }
 
@@ -339,6 +563,7 @@ memory_map_page( memory_page *source[], int page_num )
 {
   memory_map_read[ page_num ] = memory_map_write[ page_num ] =
     *source[ page_num ];
+  memory_map_update_compact( page_num );
 }
 
 /* Page in 16k from /ROMCS */
@@ -378,7 +603,7 @@ readbyte( libspectrum_word address )
   bank = address >> MEMORY_PAGE_SIZE_LOGARITHM;
   mapping = &memory_map_read[ bank ];
 
-  if( debugger_mode != DEBUGGER_MODE_INACTIVE )
+  if( memory_read_watched( address ) )
     debugger_check( DEBUGGER_BREAKPOINT_TYPE_READ, address );
 
   if( mapping->contended ) tstates += ula_contention[ tstates ];
@@ -406,7 +631,7 @@ writebyte( libspectrum_word address, libspectrum_byte b )
   bank = address >> MEMORY_PAGE_SIZE_LOGARITHM;
   mapping = &memory_map_write[ bank ];
 
-  if( debugger_mode != DEBUGGER_MODE_INACTIVE )
+  if( memory_write_watched( address ) )
     debugger_check( DEBUGGER_BREAKPOINT_TYPE_WRITE, address );
 
   if( mapping->contended ) tstates += ula_contention[ tstates ];
@@ -466,43 +691,92 @@ memory_display_dirty_sinclair( libspectrum_word address, libspectrum_byte b ) \
 
 memory_display_dirty_fn memory_display_dirty;
 
-void
-writebyte_internal( libspectrum_word address, libspectrum_byte b )
+/* Store a byte in memory which is known to be writable */
+static void
+memory_store( memory_page *mapping, libspectrum_word address,
+              libspectrum_byte b )
 {
-  libspectrum_word bank = address >> MEMORY_PAGE_SIZE_LOGARITHM;
-  memory_page *mapping = &memory_map_write[ bank ];
-  
-  if( spectranet_paged ) {
-    /* all writes need to be parsed by the flash rom emulation */
-    spectranet_flash_rom_write(address, b);
-    
-    if( spectranet_w5100_paged_a && address >= 0x1000 && address < 0x2000 ) {
-      spectranet_w5100_write( mapping, address, b );
-      return;
+  mapping->page[ address & MEMORY_PAGE_SIZE_MASK ] = b;
+
+  if( z80_cache_used ) z80_cache_write( address );
+}
+
+/* Handle a write to anything other than ordinary RAM */
+static void
+memory_write_special( memory_page *mapping, memory_write_type write_type,
+                      libspectrum_word address, libspectrum_byte b )
+{
+  switch( write_type ) {
+
+  case MEMORY_WRITE_RAM:
+    memory_store( mapping, address, b );
+    break;
+
+  case MEMORY_WRITE_SCREEN:
+    memory_display_dirty( address, b );
+    memory_store( mapping, address, b );
+    break;
+
+  case MEMORY_WRITE_ROM:
+    if( mapping->source != memory_source_none &&
+        settings_current.writable_roms ) {
+      memory_display_dirty( address, b );
+      memory_store( mapping, address, b );
     }
-    if( spectranet_w5100_paged_b && address >= 0x2000 && address < 0x3000 ) {
-      spectranet_w5100_write( mapping, address, b );
-      return;
+    break;
+
+  case MEMORY_WRITE_FLASH:
+    spectranet_flash_rom_write( address, b );
+
+    /* And then whatever would have happened without the Spectranet */
+    if( opus_active && address >= 0x2800 && address < 0x3800 ) {
+      opus_write( address, b );
+    } else {
+      memory_write_special( mapping,
+                            mapping->writable ? MEMORY_WRITE_SCREEN :
+                                                MEMORY_WRITE_ROM,
+                            address, b );
     }
-  }
+    break;
+
+  case MEMORY_WRITE_W5100:
+    spectranet_flash_rom_write( address, b );
+    spectranet_w5100_write( mapping, address, b );
+    break;
 
-  if( opus_active && address >= 0x2800 && address < 0x3800 ) {
+  case MEMORY_WRITE_OPUS:
     opus_write( address, b );
-  } else if( mapping->writable ||
-             (mapping->source != memory_source_none &&
-              settings_current.writable_roms) ) {
-    libspectrum_word offset = address & MEMORY_PAGE_SIZE_MASK;
-    libspectrum_byte *memory = mapping->page;
+    break;
 
-    memory_display_dirty( address, b );
+  }
+}
+
+void
+writebyte_internal( libspectrum_word address, libspectrum_byte b )
+{
+  libspectrum_word bank = address >> MEMORY_PAGE_SIZE_LOGARITHM;
+  libspectrum_byte *memory = memory_map_write_page[ bank ];
 
-    memory[ offset ] = b;
+  if( memory ) {
+    memory[ address & MEMORY_PAGE_SIZE_MASK ] = b;
+    if( z80_cache_used ) z80_cache_write( address );
+    return;
   }
+
+  memory_write_special( &memory_map_write[ bank ],
+                        memory_map_write_type[ bank ], address, b );
 }
 
 void
 memory_romcs_map( void )
 {
+  size_t i;
+
+  /* Every machine's memory map ends up here, including when a peripheral
+     is paged in or out or the display mode changes, any of which can
+     change how writes to pages which haven't been remapped are handled */
+  for( i = 0; i < MEMORY_PAGES_IN_64K; i++ ) memory_map_update_compact( i );
+
   /* Nothing changes if /ROMCS is not set */
   if( !machine_current->ram.romcs ) return;
 
@@ -526,6 +800,48 @@ memory_romcs_map( void )
   module_romcs();
 }
 
+static void
+memory_state_save( int slot )
+{
+  memory_state_t *state = &saved_state[ slot ];
+
+  if( !state->ram || state->ram_pages != ram_pages ) {
+    state->ram = libspectrum_renew( libspectrum_byte, state->ram,
+                                    ram_pages * 0x4000 );
+    state->ram_pages = ram_pages;
+  }
+
+  memcpy( state->ram, ram_block, ram_pages * 0x4000 );
+
+  memcpy( state->map_read, memory_map_read, sizeof( memory_map_read ) );
+  memcpy( state->map_write, memory_map_write, sizeof( memory_map_write ) );
+  state->raminfo = machine_current->ram;
+  state->current_screen = memory_current_screen;
+  state->screen_mask = memory_screen_mask;
+}
+
+static void
+memory_state_restore( int slot )
+{
+  const memory_state_t *state = &saved_state[ slot ];
+  size_t i;
+
+  memcpy( ram_block, state->ram,
+          ( state->ram_pages < ram_pages ? state->ram_pages : ram_pages ) *
+          0x4000 );
+
+  memcpy( memory_map_read, state->map_read, sizeof( memory_map_read ) );
+  memcpy( memory_map_write, state->map_write, sizeof( memory_map_write ) );
+  machine_current->ram = state->raminfo;
+  memory_current_screen = state->current_screen;
+  memory_screen_mask = state->screen_mask;
+
+  for( i = 0; i < MEMORY_PAGES_IN_64K; i++ ) memory_map_update_compact( i );
+
+  /* Any instructions decoded since the save may no longer be there */
+  if( z80_cache_used ) z80_cache_flush();
+}
+
 static void
 memory_from_snapshot( libspectrum_snap *snap )
 {
@@ -550,7 +866,7 @@ memory_from_snapshot( libspectrum_snap *snap )
   }
 
   for( i = 0; i < 64; i++ )
-    if( libspectrum_snap_pages( snap, i ) )
+    if( libspectrum_snap_pages( snap, i ) && RAM[i] )
       memcpy( RAM[i], libspectrum_snap_pages( snap, i ), 0x4000 );
 
   if( libspectrum_snap_custom_rom( snap ) ) {
@@ -100,7 +100,51 @@ typedef struct memory_page {
 extern memory_page memory_map_read[MEMORY_PAGES_IN_64K];
 extern memory_page memory_map_write[MEMORY_PAGES_IN_64K];
 
-/* The number of 16Kb RAM pages we support: 1040 Kb needed for the Pentagon 1024 */
+/* The page pointers from memory_map_read[] and the contention from both
+   maps, kept together so that the Z80 core's memory accesses touch only
+   a few cache lines. Kept up to date by the memory_map_*() functions, so
+   anything which changes a mapping must go through them */
+extern libspectrum_byte *memory_map_read_page[MEMORY_PAGES_IN_64K];
+extern libspectrum_dword memory_map_read_contended;
+extern libspectrum_dword memory_map_write_contended;
+
+/* The page pointers from memory_map_write[] for pages which are ordinary
+   RAM, which can be written to with nothing more than a store; NULL for
+   any page where writes need more work, eg ROM, the current screen or a
+   peripheral's registers, which writebyte_internal() handles according
+   to the strategy chosen for the page when it was mapped */
+extern libspectrum_byte *memory_map_write_page[MEMORY_PAGES_IN_64K];
+
+/* Which pages have execute, read or write breakpoints which could
+   trigger on them, so that the debugger need be asked only about
+   accesses to those pages. Kept up to date along with the above, and by
+   memory_map_update_watches() whenever the breakpoints change */
+extern libspectrum_dword memory_map_execute_watched;
+extern libspectrum_dword memory_map_read_watched;
+extern libspectrum_dword memory_map_write_watched;
+
+#define memory_execute_watched( address ) \
+  ( ( memory_map_execute_watched >> \
+      ( (libspectrum_word)(address) >> MEMORY_PAGE_SIZE_LOGARITHM ) ) & 1 )
+#define memory_read_watched( address ) \
+  ( ( memory_map_read_watched >> \
+      ( (libspectrum_word)(address) >> MEMORY_PAGE_SIZE_LOGARITHM ) ) & 1 )
+#define memory_write_watched( address ) \
+  ( ( memory_map_write_watched >> \
+      ( (libspectrum_word)(address) >> MEMORY_PAGE_SIZE_LOGARITHM ) ) & 1 )
+
+void memory_map_update_watches( void );
+
+/* Is the page containing this address contended? */
+#define memory_read_contended( address ) \
+  ( ( memory_map_read_contended >> \
+      ( (libspectrum_word)(address) >> MEMORY_PAGE_SIZE_LOGARITHM ) ) & 1 )
+#define memory_write_contended( address ) \
+  ( ( memory_map_write_contended >> \
+      ( (libspectrum_word)(address) >> MEMORY_PAGE_SIZE_LOGARITHM ) ) & 1 )
+
+/* The maximum number of 16Kb RAM pages we support: 1040 Kb needed for the
+   Pentagon 1024 */
 #define SPECTRUM_RAM_PAGES 65
 
 /* The maximum number of 16Kb ROMs we support */
@@ -121,6 +165,17 @@ libspectrum_byte *memory_pool_allocate_persistent( size_t length,
                                                    int persistent );
 void memory_pool_free( void );
 
+/* Add the contents of everything in the pool, such as the ROMs, to the
+   32-bit FNV-1a hash 'check' */
+libspectrum_dword memory_pool_hash( libspectrum_dword check );
+
+/* Allocate 'pages' 16Kb pages of RAM for the current machine, keeping the
+   contents of any pages it had before */
+void memory_ram_allocate( size_t pages );
+
+/* The number of 16Kb RAM pages allocated */
+size_t memory_ram_pages( void );
+
 /* Map in alternate bank if ROMCS is set */
 void memory_romcs_map( void );
 
@@ -181,7 +236,7 @@ libspectrum_byte readbyte( libspectrum_word address );
 #ifndef CORETEST
 
 #define readbyte_internal( address ) \
-  memory_map_read[ (libspectrum_word)(address) >> MEMORY_PAGE_SIZE_LOGARITHM ].page[ (address) & MEMORY_PAGE_SIZE_MASK ]
+  memory_map_read_page[ (libspectrum_word)(address) >> MEMORY_PAGE_SIZE_LOGARITHM ][ (address) & MEMORY_PAGE_SIZE_MASK ]
 
 #else				/* #ifndef CORETEST */
 
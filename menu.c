@@ -31,6 +31,7 @@
 #include "menu.h"
 #include "movie.h"
 #include "machines/specplus3.h"
+#include "perfstats.h"
 #include "peripherals/dck.h"
 #include "peripherals/disk/beta.h"
 #include "peripherals/disk/didaktik.h"
@@ -161,6 +162,43 @@ MENU_CALLBACK( menu_file_recording_play )
   fuse_emulation_unpause();
 }
 
+/* How far the seek menu items move through a recording, in seconds */
+static const size_t RZX_SEEK_STEP = 10;
+
+static size_t
+rzx_seek_step_frames( void )
+{
+  return RZX_SEEK_STEP * machine_current->timings.processor_speed /
+         machine_current->timings.tstates_per_frame;
+}
+
+MENU_CALLBACK( menu_file_recording_seekforward )
+{
+  if( !rzx_playback ) return;
+
+  ui_widget_finish();
+
+  fuse_emulation_pause();
+  rzx_seek( rzx_playback_frame() + rzx_seek_step_frames() );
+  fuse_emulation_unpause();
+}
+
+MENU_CALLBACK( menu_file_recording_seekbackward )
+{
+  size_t frame, step;
+
+  if( !rzx_playback ) return;
+
+  ui_widget_finish();
+
+  frame = rzx_playback_frame();
+  step = rzx_seek_step_frames();
+
+  fuse_emulation_pause();
+  rzx_seek( frame > step ? frame - step : 0 );
+  fuse_emulation_unpause();
+}
+
 MENU_CALLBACK( menu_file_recording_stop )
 {
   if( !( rzx_recording || rzx_playback ) ) return;
@@ -351,6 +389,34 @@ MENU_CALLBACK( menu_machine_profiler_stop )
   fuse_emulation_unpause();
 }
 
+MENU_CALLBACK( menu_machine_performance_start )
+{
+  ui_widget_finish();
+  perfstats_start();
+}
+
+MENU_CALLBACK( menu_machine_performance_stop )
+{
+  ui_widget_finish();
+  perfstats_stop();
+}
+
+MENU_CALLBACK( menu_machine_performance_save )
+{
+  char *filename;
+
+  fuse_emulation_pause();
+
+  filename = ui_get_save_filename( "Fuse - Save Performance Statistics" );
+  if( !filename ) { fuse_emulation_unpause(); return; }
+
+  perfstats_write( filename );
+
+  libspectrum_free( filename );
+
+  fuse_emulation_unpause();
+}
+
 MENU_CALLBACK( menu_machine_nmi )
 {
   ui_widget_finish();
@@ -59,6 +59,8 @@ MENU_CALLBACK( menu_file_recording_insertsnapshot );
 MENU_CALLBACK( menu_file_recording_rollback );
 MENU_CALLBACK( menu_file_recording_rollbackto );
 MENU_CALLBACK( menu_file_recording_play );
+MENU_CALLBACK( menu_file_recording_seekforward );
+MENU_CALLBACK( menu_file_recording_seekbackward );
 MENU_CALLBACK( menu_file_recording_stop );
 MENU_CALLBACK( menu_file_recording_finalise );
 MENU_CALLBACK( menu_file_aylogging_stop );
@@ -81,6 +83,9 @@ MENU_CALLBACK( menu_options_save );
 
 MENU_CALLBACK( menu_machine_profiler_start );
 MENU_CALLBACK( menu_machine_profiler_stop );
+MENU_CALLBACK( menu_machine_performance_start );
+MENU_CALLBACK( menu_machine_performance_stop );
+MENU_CALLBACK( menu_machine_performance_save );
 MENU_CALLBACK( menu_machine_nmi );
 MENU_CALLBACK( menu_machine_multifaceredbutton );
 MENU_CALLBACK( menu_machine_didaktiksnap );
@@ -170,6 +175,7 @@ MENU_CALLBACK( menu_machine_debugger );
 MENU_CALLBACK( menu_machine_pokefinder );
 MENU_CALLBACK( menu_machine_pokememory );
 MENU_CALLBACK( menu_machine_memorybrowser );
+MENU_CALLBACK( menu_machine_performance_show );
 
 MENU_CALLBACK( menu_help_keyboard );
 MENU_CALLBACK( menu_help_about );
@@ -122,3 +122,34 @@ module_snapshot_to( libspectrum_snap *snap )
 {
   g_slist_foreach( registered_modules, snapshot_to, snap );
 }
+
+static void
+state_save( gpointer data, gpointer user_data )
+{
+  const module_info_t *module = data;
+  int slot = GPOINTER_TO_INT( user_data );
+
+  if( module->state_save ) module->state_save( slot );
+}
+
+void
+module_state_save( int slot )
+{
+  g_slist_foreach( registered_modules, state_save, GINT_TO_POINTER( slot ) );
+}
+
+static void
+state_restore( gpointer data, gpointer user_data )
+{
+  const module_info_t *module = data;
+  int slot = GPOINTER_TO_INT( user_data );
+
+  if( module->state_restore ) module->state_restore( slot );
+}
+
+void
+module_state_restore( int slot )
+{
+  g_slist_foreach( registered_modules, state_restore,
+                   GINT_TO_POINTER( slot ) );
+}
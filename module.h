@@ -31,6 +31,11 @@ typedef void (*module_romcs_fn)( void );
 typedef void (*module_snapshot_enabled_fn)( libspectrum_snap *snap );
 typedef void (*module_snapshot_from_fn)( libspectrum_snap *snap );
 typedef void (*module_snapshot_to_fn)( libspectrum_snap *snap );
+typedef void (*module_state_fn)( int slot );
+
+/* How many copies of the machine's state can be kept at once: one for
+   run-ahead and the rest for netplay's rollback */
+#define MODULE_STATE_SLOTS 10
 
 typedef struct module_info_t
 {
@@ -41,6 +46,12 @@ typedef struct module_info_t
   module_snapshot_from_fn snapshot_from;
   module_snapshot_to_fn snapshot_to;
 
+  /* Copy the module's state to and from one of MODULE_STATE_SLOTS areas
+     of memory it owns, without going through a snapshot; used for
+     run-ahead and netplay, so must be quick */
+  module_state_fn state_save;
+  module_state_fn state_restore;
+
 } module_info_t;
 
 int module_register( module_info_t *module );
@@ -51,5 +62,7 @@ void module_romcs( void );
 void module_snapshot_enabled( libspectrum_snap *snap );
 void module_snapshot_from( libspectrum_snap *snap );
 void module_snapshot_to( libspectrum_snap *snap );
+void module_state_save( int slot );
+void module_state_restore( int slot );
 
 #endif			/* #ifndef FUSE_MODULE_H */
@@ -31,6 +31,10 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#ifdef HAVE_PTHREAD
+#include <pthread.h>
+#endif				/* #ifdef HAVE_PTHREAD */
+
 #include <libspectrum.h>
 #ifdef HAVE_ZLIB_H
 #define ZLIB_CONST
@@ -47,6 +51,7 @@
 #include "screenshot.h"
 #include "settings.h"
 #include "sound.h"
+#include "timer/timer.h"
 #include "ui/ui.h"
 
 #undef MOVIE_DEBUG_PRINT
@@ -115,6 +120,52 @@
       concat several FMF file without any problem...
 */
 
+/*
+  Encoding pipeline
+
+  The emulation thread only copies the changed screen areas and the sound
+  samples of each frame into a bounded queue of items; RLE encoding, zlib
+  compression and file I/O are all done by a worker thread. If the worker
+  falls behind and the queue fills up, the emulation thread waits for a free
+  slot and the stall is counted in the statistics.
+
+  Without POSIX threads, each item is encoded as soon as it is queued.
+*/
+
+/* Number of items which may be waiting for the encoder */
+#define MOVIE_QUEUE_LENGTH 256
+
+typedef enum movie_item_type {
+  MOVIE_ITEM_FRAME,		/* 'N' chunk */
+  MOVIE_ITEM_AREA,		/* '$' chunk */
+  MOVIE_ITEM_SOUND,		/* one or more 'S' chunks */
+} movie_item_type;
+
+typedef struct movie_item {
+  movie_item_type type;
+  libspectrum_byte head[8];	/* chunk header */
+  int w, h, screen;		/* AREA: size of the copied area */
+  int len;			/* SOUND: number of samples */
+  char format, stereo;		/* SOUND: format when the samples were queued */
+  int freq;			/* SOUND: frequency in Hz */
+  void *data;			/* copied screen data or sound samples */
+  size_t data_alloc;		/* bytes allocated in data */
+} movie_item;
+
+static movie_item queue[ MOVIE_QUEUE_LENGTH ];
+static size_t queue_head, queue_tail, queue_count;
+
+static movie_statistics statistics;
+
+#ifdef HAVE_PTHREAD
+static pthread_t encoder_thread;
+static pthread_mutex_t queue_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t queue_not_empty = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t queue_not_full = PTHREAD_COND_INITIALIZER;
+static int encoder_running = 0;
+static int encoder_stop = 0;
+#endif				/* #ifdef HAVE_PTHREAD */
+
 int movie_recording = 0;
 static int movie_paused = 0;
 
@@ -126,7 +177,6 @@ static libspectrum_byte head[8];
 static int freq = 0;
 static char stereo = 'M';
 static char format = '?';
-static int framesiz = 4;
 
 static libspectrum_byte sbuff[ 4096 ];
 #ifdef HAVE_ZLIB_H
@@ -213,18 +263,18 @@ fwrite_compr( const void *b, size_t n, size_t m, FILE *f )
 #endif	/* HAVE_ZLIB_H */
 
 static void
-movie_compress_area( int x, int y, int w, int h, int s )
+movie_compress_area( const libspectrum_dword *data, int w, int h, int s )
 {
-  libspectrum_dword *dpoint, *dline;
+  const libspectrum_dword *dpoint, *dline;
   libspectrum_byte d, d1, *b;
   libspectrum_byte buff[ 960 ];
   int w0, h0, l;
 
-  dline = &display_last_screen[x + 40 * y];
+  dline = data;
   b = buff; l = -1;
   d1 = ( ( *dline >> s ) & 0xff ) + 1;		/* *d1 != dpoint :-) */
 
-  for( h0 = h; h0 > 0; h0--, dline += 40 ) {
+  for( h0 = h; h0 > 0; h0--, dline += w ) {
     dpoint = dline;
     for( w0 = w; w0 > 0; w0--, dpoint++) {
       d = ( *dpoint >> s ) & 0xff;	/* bitmask1 */
@@ -259,6 +309,191 @@ movie_compress_area( int x, int y, int w, int h, int s )
   }
 }
 
+static void
+add_sound( const movie_item *item, libspectrum_signed_word *buff, int len );
+
+/* Write one queued item to the movie file; called from the encoder thread
+   (or directly when threads are not available) */
+static void
+encode_item( movie_item *item )
+{
+  libspectrum_signed_word *buff;
+  int len;
+
+  switch( item->type ) {
+
+  case MOVIE_ITEM_FRAME:
+    fwrite_compr( item->head, 4, 1, of );	/* New frame! */
+    break;
+
+  case MOVIE_ITEM_AREA:
+    fwrite_compr( item->head, 7, 1, of );
+    movie_compress_area( item->data, item->w, item->h, 0 );	/* Bitmap1 */
+    movie_compress_area( item->data, item->w, item->h, 8 );	/* Attrib/B2 */
+    if( item->screen == 'R' ) {
+      movie_compress_area( item->data, item->w, item->h, 16 ); /* HiRes attrib */
+    }
+    break;
+
+  case MOVIE_ITEM_SOUND:
+    buff = item->data;
+    len = item->len;
+    while( len ) {
+      if( item->stereo == 'S' ) {
+        add_sound( item, buff, len > 131072 ? 65536 : len >> 1 );
+        buff += len > 131072 ? 131072 : len;
+        len -= len > 131072 ? 131072 : len;
+      } else {
+        add_sound( item, buff, len > 65536 ? 65536 : len );
+        buff += len > 65536 ? 65536 : len;
+        len -= len > 65536 ? 65536 : len;
+      }
+    }
+    break;
+
+  }
+}
+
+#ifdef HAVE_PTHREAD
+
+static void*
+encoder_thread_fn( void *arg GCC_UNUSED )
+{
+  movie_item *item;
+
+  pthread_mutex_lock( &queue_lock );
+
+  while( 1 ) {
+
+    while( !queue_count && !encoder_stop )
+      pthread_cond_wait( &queue_not_empty, &queue_lock );
+
+    if( !queue_count ) break;
+
+    item = &queue[ queue_head ];
+
+    /* The producer never touches an item between queuing it and us
+       releasing it, so we can encode without holding the lock */
+    pthread_mutex_unlock( &queue_lock );
+    encode_item( item );
+    pthread_mutex_lock( &queue_lock );
+
+    queue_head = ( queue_head + 1 ) % MOVIE_QUEUE_LENGTH;
+    queue_count--;
+    pthread_cond_signal( &queue_not_full );
+  }
+
+  pthread_mutex_unlock( &queue_lock );
+
+  return NULL;
+}
+
+static void
+encoder_start( void )
+{
+  int error;
+
+  encoder_stop = 0;
+
+  error = pthread_create( &encoder_thread, NULL, encoder_thread_fn, NULL );
+  if( error ) {
+    ui_error( UI_ERROR_WARNING,
+              "movie: error %d creating encoder thread; encoding synchronously",
+              error );
+    return;
+  }
+
+  encoder_running = 1;
+}
+
+/* Wait for the encoder to empty the queue and then stop it */
+static void
+encoder_end( void )
+{
+  if( !encoder_running ) return;
+
+  pthread_mutex_lock( &queue_lock );
+  encoder_stop = 1;
+  pthread_cond_signal( &queue_not_empty );
+  pthread_mutex_unlock( &queue_lock );
+
+  pthread_join( encoder_thread, NULL );
+  encoder_running = 0;
+}
+
+#endif				/* #ifdef HAVE_PTHREAD */
+
+/* Get the next free item from the queue, waiting for the encoder if the
+   queue is full. Ensures the item has room for at least 'size' bytes of
+   payload */
+static movie_item*
+get_free_item( movie_item_type type, size_t size )
+{
+  movie_item *item;
+
+#ifdef HAVE_PTHREAD
+  if( encoder_running ) {
+    pthread_mutex_lock( &queue_lock );
+
+    if( queue_count == MOVIE_QUEUE_LENGTH ) {
+      double start = timer_get_time();
+
+      statistics.stalls++;
+      while( queue_count == MOVIE_QUEUE_LENGTH )
+        pthread_cond_wait( &queue_not_full, &queue_lock );
+
+      if( start >= 0 ) statistics.stall_time += timer_get_time() - start;
+    }
+
+    pthread_mutex_unlock( &queue_lock );
+  }
+#endif				/* #ifdef HAVE_PTHREAD */
+
+  item = &queue[ queue_tail ];
+  item->type = type;
+
+  if( item->data_alloc < size ) {
+    item->data = libspectrum_renew( libspectrum_byte, item->data, size );
+    item->data_alloc = size;
+  }
+
+  return item;
+}
+
+/* Pass a filled item on to the encoder */
+static void
+queue_item( movie_item *item )
+{
+  statistics.items++;
+
+#ifdef HAVE_PTHREAD
+  if( encoder_running ) {
+    pthread_mutex_lock( &queue_lock );
+    queue_tail = ( queue_tail + 1 ) % MOVIE_QUEUE_LENGTH;
+    queue_count++;
+    if( queue_count > statistics.max_queue_depth )
+      statistics.max_queue_depth = queue_count;
+    pthread_cond_signal( &queue_not_empty );
+    pthread_mutex_unlock( &queue_lock );
+    return;
+  }
+#endif				/* #ifdef HAVE_PTHREAD */
+
+  encode_item( item );
+}
+
+static void
+free_queue( void )
+{
+  size_t i;
+
+  for( i = 0; i < MOVIE_QUEUE_LENGTH; i++ ) {
+    libspectrum_free( queue[i].data );
+    queue[i].data = NULL;
+    queue[i].data_alloc = 0;
+  }
+}
+
 /* Fetch pixel (x, y). On a Timex this will be a point on a 640x480 canvas,
    on a Sinclair/Amstrad/Russian clone this will be a point on a 320x240
    canvas */
@@ -270,23 +505,34 @@ movie_compress_area( int x, int y, int w, int h, int s )
 void
 movie_add_area( int x, int y, int w, int h )
 {
+  movie_item *item;
+  libspectrum_dword *dest;
+  int i;
+
   if( movie_paused ) {
     movie_start_frame();
     return;
   }
-  head[0] = '$';			/* RLE compressed data... */
-  head[1] = x;
-  head[2] = y & 0xff;
-  head[3] = y >> 8;
-  head[4] = w;
-  head[5] = h & 0xff;
-  head[6] = h >> 8;
-  fwrite_compr( head, 7, 1, of );
-  movie_compress_area( x, y, w, h, 0 );	/* Bitmap1 */
-  movie_compress_area( x, y, w, h, 8 );	/* Attrib/B2 */
-  if( fmf_screen == 'R' ) {
-    movie_compress_area( x, y, w, h, 16 );	/* HiRes attrib */
-  }
+
+  item = get_free_item( MOVIE_ITEM_AREA,
+                        w * h * sizeof( libspectrum_dword ) );
+
+  item->head[0] = '$';			/* RLE compressed data... */
+  item->head[1] = x;
+  item->head[2] = y & 0xff;
+  item->head[3] = y >> 8;
+  item->head[4] = w;
+  item->head[5] = h & 0xff;
+  item->head[6] = h >> 8;
+  item->w = w;
+  item->h = h;
+  item->screen = fmf_screen;
+
+  for( i = 0, dest = item->data; i < h; i++, dest += w )
+    memcpy( dest, &display_last_screen[ x + 40 * ( y + i ) ],
+            w * sizeof( libspectrum_dword ) );
+
+  queue_item( item );
   slice_no++;
 }
 
@@ -308,7 +554,8 @@ movie_start_fmf( const char *name )
     fmf_compr = 0;
     fwrite( "U", 1, 1, of );		/* not compressed */
   } else {
-    fmf_compr = Z_DEFAULT_COMPRESSION;
+    fmf_compr = settings_current.movie_compr_fast ? Z_BEST_SPEED :
+                                                    Z_DEFAULT_COMPRESSION;
     fwrite( "Z", 1, 1, of );		/* compressed */
   }
   if( fmf_compr != 0 ) {
@@ -333,6 +580,13 @@ movie_start_fmf( const char *name )
   head[6] = stereo;
   head[7] = '\n';	/* padding */
   fwrite( head, 8, 1, of );		/* write initial params */
+
+  memset( &statistics, 0, sizeof( statistics ) );
+  queue_head = queue_tail = queue_count = 0;
+#ifdef HAVE_PTHREAD
+  encoder_start();
+#endif				/* #ifdef HAVE_PTHREAD */
+
   movie_add_area( 0, 0, 40, 240 );
 }
 
@@ -354,6 +608,11 @@ movie_stop( void )
 {
   if( !movie_paused && !movie_recording ) return;
 
+#ifdef HAVE_PTHREAD
+  encoder_end();
+#endif				/* #ifdef HAVE_PTHREAD */
+  free_queue();
+
   fwrite_compr( "X", 1, 1, of );	/* End of Recording! */
 #ifdef HAVE_ZLIB_H
   {
@@ -378,7 +637,15 @@ movie_stop( void )
   }
 #ifdef MOVIE_DEBUG_PRINT
   fprintf( stderr, "Debug movie: saved %d.%d frame(.slice)\n", frame_no, slice_no );
+  fprintf( stderr, "Debug movie: %lu items, max queue depth %lu, "
+           "%lu stalls (%.3fs)\n", (unsigned long)statistics.items,
+           (unsigned long)statistics.max_queue_depth,
+           (unsigned long)statistics.stalls, statistics.stall_time );
 #endif 	/* MOVIE_DEBUG_PRINT */
+  if( statistics.stalls )
+    ui_error( UI_ERROR_INFO,
+              "Movie encoder fell behind %lu times; emulation waited %.1fs",
+              (unsigned long)statistics.stalls, statistics.stall_time );
   movie_recording = 0;
   movie_paused = 0;
   ui_menu_activate( UI_MENU_ITEM_FILE_MOVIE_RECORDING, 0 );
@@ -407,7 +674,6 @@ movie_init_sound( int f, int s )
   format = option_enumerate_movie_movie_compr() == 2 ? 'A' : 'P';
   freq = f;
   stereo = ( s ? 'S' : 'M' );
-  framesiz = ( stereo == 'S' ? 2 : 1 ) * ( format == 'P' ? 2 : 1 );
 }
 
 static inline void
@@ -429,50 +695,61 @@ write_alaw( libspectrum_signed_word *buff, int len )
     fwrite_compr( sbuff, i, 1, of );	/* write remaind */
 }
 
+/* Write one 'S' chunk; the format is taken from the queued item, as the
+   sound settings may have been changed since by the emulation thread */
 static void
-add_sound( libspectrum_signed_word *buff, int len )
+add_sound( const movie_item *item, libspectrum_signed_word *buff, int len )
 {
-  head[0] = 'S';	/* sound frame */
-  head[1] = format;	/* sound format */
-  head[2] = freq & 0xff;
-  head[3] = freq >> 8;
-  head[4] = stereo;
+  libspectrum_byte sound_head[7];
+  int framesiz;
+
+  framesiz = ( item->stereo == 'S' ? 2 : 1 ) * ( item->format == 'P' ? 2 : 1 );
+
+  sound_head[0] = 'S';	/* sound frame */
+  sound_head[1] = item->format;	/* sound format */
+  sound_head[2] = item->freq & 0xff;
+  sound_head[3] = item->freq >> 8;
+  sound_head[4] = item->stereo;
   len--;		/*len - 1*/
-  head[5] = len & 0xff;
-  head[6] = len >> 8;
+  sound_head[5] = len & 0xff;
+  sound_head[6] = len >> 8;
   len++;		/* len :-) */
-  fwrite_compr( head, 7, 1, of );	/* Sound frame */
-  if( format == 'P' )
+  fwrite_compr( sound_head, 7, 1, of );	/* Sound frame */
+  if( item->format == 'P' )
     fwrite_compr( buff, len * framesiz , 1, of );	/* write frame */
-  else if( format == 'A' )
+  else if( item->format == 'A' )
     write_alaw( buff, len * framesiz );
 }
 
 void
 movie_add_sound( libspectrum_signed_word *buff, int len )
 {
-  while( len ) {
-    if( stereo == 'S' ) {
-      add_sound( buff, len > 131072 ? 65536 : len >> 1 );
-      buff += len > 131072 ? 131072 : len;
-      len -= len > 131072 ? 131072 : len;
-    } else {
-      add_sound( buff, len > 65536 ? 65536 : len );
-      buff += len > 65536 ? 65536 : len;
-      len -= len > 65536 ? 65536 : len;
-    }
-  }
+  movie_item *item;
+
+  if( len <= 0 ) return;
+
+  item = get_free_item( MOVIE_ITEM_SOUND,
+                        len * sizeof( libspectrum_signed_word ) );
+  item->len = len;
+  item->format = format;
+  item->freq = freq;
+  item->stereo = stereo;
+  memcpy( item->data, buff, len * sizeof( libspectrum_signed_word ) );
+
+  queue_item( item );
 }
 
 void
 movie_start_frame( void )
 {
+  movie_item *item = get_free_item( MOVIE_ITEM_FRAME, 0 );
+
   /* $ - ZX$, T - TX$, C - HiCol, R - HiRes */
-  head[0] = 'N';
-  head[1] = settings_current.frame_rate;
-  head[2] = get_screentype();
-  head[3] = get_timing();
-  fwrite_compr( head, 4, 1, of );	/* New frame! */
+  item->head[0] = 'N';
+  item->head[1] = settings_current.frame_rate;
+  item->head[2] = get_screentype();
+  item->head[3] = get_timing();
+  queue_item( item );
   frame_no++;
   if( movie_paused ) {
     movie_paused = 0;
@@ -480,6 +757,12 @@ movie_start_frame( void )
   }
 }
 
+void
+movie_get_statistics( movie_statistics *stats )
+{
+  *stats = statistics;
+}
+
 void
 movie_init( void )
 {
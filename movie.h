@@ -26,6 +26,14 @@
 */
 extern int movie_recording;
 
+/* Encoder queue statistics for the current (or last) recording */
+typedef struct movie_statistics {
+  size_t items;			/* items passed to the encoder */
+  size_t max_queue_depth;	/* most items ever waiting at once */
+  size_t stalls;		/* times the emulation waited for the encoder */
+  double stall_time;		/* total time spent waiting, in seconds */
+} movie_statistics;
+
 void movie_init( void );
 void movie_start( const char *name );
 void movie_stop( void );
@@ -34,3 +42,4 @@ void movie_add_area( int x, int y, int w, int h );
 void movie_start_frame( void );
 void movie_init_sound( int f, int s );
 void movie_add_sound( libspectrum_signed_word *buf, int len );
+void movie_get_statistics( movie_statistics *stats );
@@ -0,0 +1,921 @@
+/* netplay.c: two player netplay over UDP
+   Copyright (c) 2026 Fuse contributors
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+   Author contact information:
+
+   E-mail: philip-fuse@shadowmagic.org.uk
+
+*/
+
+
+/* Each instance sends its own keyboard and joystick input for every frame
+   to the other, and the machine sees the two combined. The machines start
+   in step and stay that way as long as both see the same input for every
+   frame.
+
+   Rather than wait for the other player's input, each frame is run with a
+   guess at it: whatever the other player was doing in the last frame we
+   heard about. The state of the machine is saved at the start of each
+   frame which was run with a guess. When the real input arrives and the
+   guess was wrong, the machine is put back to the start of that frame
+   and the frames since then are run again, quickly and without sound or
+   being shown. If the guesses get too far ahead, or the machine cannot be
+   saved, the emulation waits for the other player instead */
+
+#include <config.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef BUILD_NETPLAY
+#ifdef WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#endif
+#endif				/* #ifdef BUILD_NETPLAY */
+
+#include <libspectrum.h>
+
+#include "compat.h"
+#include "fuse.h"
+#include "infrastructure/startup_manager.h"
+#include "keyboard.h"
+#include "memory_pages.h"
+#include "module.h"
+#include "netplay.h"
+#include "perfstats.h"
+#include "runahead.h"
+#include "settings.h"
+#include "spectrum.h"
+#include "ui/ui.h"
+#include "unittests/unittests.h"
+#include "utils.h"
+#include "z80/z80.h"
+
+int netplay_active = 0;
+int netplay_pending = 0;
+
+void
+netplay_input_merge( netplay_input_t *merged, const netplay_input_t *a,
+                     const netplay_input_t *b )
+{
+  size_t i;
+
+  /* The keyboard and the Fuller box are active low; the others active
+     high */
+  for( i = 0; i < 8; i++ )
+    merged->keyboard[i] = a->keyboard[i] & b->keyboard[i];
+
+  merged->joystick.kempston = a->joystick.kempston | b->joystick.kempston;
+  merged->joystick.timex1 = a->joystick.timex1 | b->joystick.timex1;
+  merged->joystick.timex2 = a->joystick.timex2 | b->joystick.timex2;
+  merged->joystick.fuller = a->joystick.fuller & b->joystick.fuller;
+}
+
+#ifdef BUILD_NETPLAY
+
+/* How many frames of input are remembered */
+#define NETPLAY_HISTORY 64
+
+/* The state slots used are the ones after run-ahead's, so this is the
+   furthest back the machine can be put */
+#define NETPLAY_MAX_ROLLBACK ( MODULE_STATE_SLOTS - 2 )
+
+/* How long to wait for the other player before giving up, in seconds */
+#define NETPLAY_TIMEOUT 10
+
+/* How often to send again while waiting, in milliseconds */
+#define NETPLAY_RESEND 20
+
+/* Packets start with this, followed by the type */
+static const libspectrum_byte netplay_magic[4] = { 'F', 'N', 'P', '1' };
+
+typedef enum netplay_packet_type {
+  NETPLAY_PACKET_HELLO,		/* frame, check */
+  NETPLAY_PACKET_INPUT,		/* ack, first frame, count, inputs */
+  NETPLAY_PACKET_QUIT,
+} netplay_packet_type;
+
+#define NETPLAY_INPUT_LENGTH 12
+#define NETPLAY_HEADER_LENGTH 5
+#define NETPLAY_MAX_PACKET \
+  ( NETPLAY_HEADER_LENGTH + 9 + NETPLAY_HISTORY * NETPLAY_INPUT_LENGTH )
+
+static compat_socket_t netplay_socket;
+static struct sockaddr_storage peer_address;
+static socklen_t peer_address_length;
+
+/* Have we heard from the other player yet? */
+static int connected;
+
+/* What we told the other player when we started */
+static libspectrum_dword hello_frame, hello_check;
+
+/* The next frame to be run */
+static libspectrum_dword frame;
+
+/* We have the other player's input for every frame before this */
+static libspectrum_dword remote_frames;
+
+/* Every frame before this was run with the other player's real input */
+static libspectrum_dword verified;
+
+/* The other player has our input for every frame before this */
+static libspectrum_dword peer_needs;
+
+/* Each player's input, and what was used for the other player's when
+   each frame was run, indexed by frame number modulo NETPLAY_HISTORY */
+static netplay_input_t local_input[ NETPLAY_HISTORY ];
+static netplay_input_t remote_input[ NETPLAY_HISTORY ];
+static netplay_input_t used_input[ NETPLAY_HISTORY ];
+
+/* What the machine sees */
+static netplay_input_t current;
+
+static const netplay_input_t neutral = {
+  { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff },
+  { 0x00, 0x00, 0x00, 0xff },
+};
+
+static double last_heard, last_sent;
+
+static void netplay_stop( int tell_peer );
+
+static int
+netplay_slot( libspectrum_dword n )
+{
+  return 1 + n % ( NETPLAY_MAX_ROLLBACK + 1 );
+}
+
+/* How many frames may be run on a guess */
+static libspectrum_dword
+netplay_window( void )
+{
+  int window = settings_current.netplay_rollback;
+
+  if( !runahead_available() ) return 0;
+
+  if( window < 0 ) window = 0;
+  if( window > NETPLAY_MAX_ROLLBACK ) window = NETPLAY_MAX_ROLLBACK;
+
+  return window;
+}
+
+static void
+netplay_input_read( netplay_input_t *input )
+{
+  memcpy( input->keyboard, keyboard_return_values,
+          sizeof( input->keyboard ) );
+  joystick_get_values( &input->joystick );
+}
+
+static void
+netplay_input_write( libspectrum_byte **ptr, const netplay_input_t *input )
+{
+  memcpy( *ptr, input->keyboard, 8 ); *ptr += 8;
+  *(*ptr)++ = input->joystick.kempston;
+  *(*ptr)++ = input->joystick.timex1;
+  *(*ptr)++ = input->joystick.timex2;
+  *(*ptr)++ = input->joystick.fuller;
+}
+
+static void
+netplay_input_parse( const libspectrum_byte **ptr, netplay_input_t *input )
+{
+  memcpy( input->keyboard, *ptr, 8 ); *ptr += 8;
+  input->joystick.kempston = *(*ptr)++;
+  input->joystick.timex1 = *(*ptr)++;
+  input->joystick.timex2 = *(*ptr)++;
+  input->joystick.fuller = *(*ptr)++;
+}
+
+static void
+netplay_send_packet( const libspectrum_byte *buffer, size_t length )
+{
+  sendto( netplay_socket, (const char*)buffer, length, 0,
+          (const struct sockaddr*)&peer_address, peer_address_length );
+  last_sent = compat_timer_get_monotonic_time();
+}
+
+static libspectrum_byte*
+netplay_packet_start( libspectrum_byte *buffer, netplay_packet_type type )
+{
+  memcpy( buffer, netplay_magic, 4 );
+  buffer[4] = type;
+
+  return buffer + NETPLAY_HEADER_LENGTH;
+}
+
+static void
+netplay_send_hello( void )
+{
+  libspectrum_byte buffer[ NETPLAY_HEADER_LENGTH + 8 ], *ptr;
+
+  ptr = netplay_packet_start( buffer, NETPLAY_PACKET_HELLO );
+  libspectrum_write_dword( &ptr, hello_frame );
+  libspectrum_write_dword( &ptr, hello_check );
+
+  netplay_send_packet( buffer, ptr - buffer );
+}
+
+/* Send all our input the other player doesn't yet have */
+static void
+netplay_send_input( void )
+{
+  libspectrum_byte buffer[ NETPLAY_MAX_PACKET ], *ptr;
+  libspectrum_dword first, count, i;
+
+  first = peer_needs;
+  count = frame + settings_current.netplay_delay + 1 - first;
+  if( count > NETPLAY_HISTORY ) {
+    first += count - NETPLAY_HISTORY;
+    count = NETPLAY_HISTORY;
+  }
+
+  ptr = netplay_packet_start( buffer, NETPLAY_PACKET_INPUT );
+  libspectrum_write_dword( &ptr, remote_frames );
+  libspectrum_write_dword( &ptr, first );
+  *ptr++ = count;
+
+  for( i = 0; i < count; i++ )
+    netplay_input_write( &ptr,
+                         &local_input[ ( first + i ) % NETPLAY_HISTORY ] );
+
+  netplay_send_packet( buffer, ptr - buffer );
+}
+
+static void
+netplay_send_quit( void )
+{
+  libspectrum_byte buffer[ NETPLAY_HEADER_LENGTH ];
+
+  netplay_packet_start( buffer, NETPLAY_PACKET_QUIT );
+  netplay_send_packet( buffer, sizeof( buffer ) );
+}
+
+/* A check that both machines start in the same state */
+static libspectrum_dword
+netplay_state_check( void )
+{
+  libspectrum_dword check = 2166136261UL;
+  size_t i, j;
+
+  for( i = 0; i < 8; i++ )
+    for( j = 0; j < 0x4000; j++ )
+      check = ( check ^ RAM[i][j] ) * 16777619UL;
+
+  check = ( check ^ z80.pc.w ) * 16777619UL;
+  check = ( check ^ z80.sp.w ) * 16777619UL;
+
+  return check;
+}
+
+static void
+netplay_receive_hello( const libspectrum_byte *ptr, const libspectrum_byte *end )
+{
+  libspectrum_dword peer_frame, peer_check;
+
+  if( end - ptr < 8 ) return;
+
+  peer_frame = libspectrum_read_dword( &ptr );
+  peer_check = libspectrum_read_dword( &ptr );
+
+  if( peer_frame != hello_frame || peer_check != hello_check ) {
+    ui_error( UI_ERROR_ERROR,
+              "netplay: the other machine is not in the same state; both "
+              "must start with the same machine and files" );
+    netplay_stop( 1 );
+    return;
+  }
+
+  /* Let the other player know we're here too */
+  if( connected ) {
+    netplay_send_hello();
+    return;
+  }
+
+  connected = 1;
+  remote_frames = verified = peer_needs = frame;
+}
+
+static void
+netplay_receive_input( const libspectrum_byte *ptr, const libspectrum_byte *end )
+{
+  libspectrum_dword ack, first, count, i;
+
+  if( !connected || end - ptr < 9 ) return;
+
+  ack = libspectrum_read_dword( &ptr );
+  first = libspectrum_read_dword( &ptr );
+  count = *ptr++;
+
+  if( ack > peer_needs && ack <= frame + settings_current.netplay_delay + 1 )
+    peer_needs = ack;
+
+  for( i = 0; i < count && end - ptr >= NETPLAY_INPUT_LENGTH; i++ ) {
+    netplay_input_t input;
+
+    netplay_input_parse( &ptr, &input );
+
+    /* Take only the next frame we need, and don't let the other player
+       get so far ahead that we would forget a frame we haven't checked */
+    if( first + i == remote_frames &&
+        remote_frames - verified < NETPLAY_HISTORY ) {
+      remote_input[ remote_frames % NETPLAY_HISTORY ] = input;
+      remote_frames++;
+    }
+  }
+}
+
+/* Deal with everything the other player has sent */
+static void
+netplay_receive( void )
+{
+  libspectrum_byte buffer[ NETPLAY_MAX_PACKET ];
+  const libspectrum_byte *ptr, *end;
+  struct timeval timeout;
+  fd_set readfds;
+  int length;
+
+  while( netplay_active ) {
+
+    FD_ZERO( &readfds );
+    FD_SET( netplay_socket, &readfds );
+    timeout.tv_sec = timeout.tv_usec = 0;
+
+    if( select( netplay_socket + 1, &readfds, NULL, NULL, &timeout ) <= 0 )
+      return;
+
+    length = recvfrom( netplay_socket, (char*)buffer, sizeof( buffer ), 0,
+                       NULL, NULL );
+    if( length < NETPLAY_HEADER_LENGTH ) continue;
+    if( memcmp( buffer, netplay_magic, 4 ) ) continue;
+
+    last_heard = compat_timer_get_monotonic_time();
+
+    ptr = buffer + NETPLAY_HEADER_LENGTH; end = buffer + length;
+
+    switch( buffer[4] ) {
+
+    case NETPLAY_PACKET_HELLO: netplay_receive_hello( ptr, end ); break;
+    case NETPLAY_PACKET_INPUT: netplay_receive_input( ptr, end ); break;
+
+    case NETPLAY_PACKET_QUIT:
+      ui_error( UI_ERROR_INFO, "netplay: the other player has left" );
+      netplay_stop( 0 );
+      return;
+
+    }
+  }
+}
+
+/* Wait a moment for something to arrive, keeping the user interface
+   alive */
+static void
+netplay_wait( void )
+{
+  perfstats_stage stage = perfstats_enter( PERFSTATS_STAGE_SLEEP );
+
+  compat_timer_sleep( 1 );
+  ui_event();
+
+  perfstats_enter( stage );
+}
+
+/* Wait for the other player to start */
+static void
+netplay_connect( void )
+{
+  hello_frame = frame;
+  hello_check = netplay_state_check();
+
+  while( netplay_active && !connected && !fuse_exiting ) {
+    if( compat_timer_get_monotonic_time() - last_sent > 0.1 )
+      netplay_send_hello();
+    netplay_receive();
+    if( !connected ) netplay_wait();
+  }
+
+  if( connected ) netplay_send_hello();
+}
+
+/* The other player's input for a frame, or our guess at it */
+static const netplay_input_t*
+netplay_remote_input( libspectrum_dword n )
+{
+  if( n < remote_frames ) return &remote_input[ n % NETPLAY_HISTORY ];
+
+  if( remote_frames == 0 ) return &neutral;
+
+  return &remote_input[ ( remote_frames - 1 ) % NETPLAY_HISTORY ];
+}
+
+/* Set up what the machine sees for a frame */
+static void
+netplay_set_input( libspectrum_dword n )
+{
+  netplay_input_t *used = &used_input[ n % NETPLAY_HISTORY ];
+
+  *used = *netplay_remote_input( n );
+  netplay_input_merge( &current, &local_input[ n % NETPLAY_HISTORY ], used );
+}
+
+/* Put the machine back to the start of frame 'first' and run it up to
+   the current frame again */
+static void
+netplay_rollback( libspectrum_dword first )
+{
+  perfstats_stage stage;
+  int perfstats_was_active;
+  libspectrum_dword n;
+
+  stage = perfstats_enter( PERFSTATS_STAGE_ROLLBACK );
+  perfstats_was_active = perfstats_active;
+  perfstats_active = 0;
+
+  module_state_restore( netplay_slot( first ) );
+
+  for( n = first; n < frame && !fuse_exiting; n++ ) {
+    if( n > first ) module_state_save( netplay_slot( n ) );
+    netplay_set_input( n );
+    runahead_emulate( 1, 0 );
+  }
+
+  perfstats_active = perfstats_was_active;
+  perfstats_count( PERFSTATS_COUNTER_ROLLBACKS, 1 );
+  perfstats_count( PERFSTATS_COUNTER_RESIMULATED, frame - first );
+  perfstats_enter( stage );
+}
+
+/* Check the guesses made for frames whose real input has now arrived */
+static void
+netplay_check_guesses( void )
+{
+  libspectrum_dword known, n;
+
+  known = remote_frames < frame ? remote_frames : frame;
+
+  for( n = verified; n < known; n++ ) {
+    if( memcmp( &used_input[ n % NETPLAY_HISTORY ],
+                &remote_input[ n % NETPLAY_HISTORY ],
+                sizeof( netplay_input_t ) ) ) {
+
+      if( !runahead_available() ) {
+        ui_error( UI_ERROR_ERROR,
+                  "netplay: unable to go back to frame %lu; the machines "
+                  "are no longer in step", (unsigned long)n );
+        netplay_stop( 1 );
+        return;
+      }
+
+      netplay_rollback( n );
+      break;
+    }
+  }
+
+  if( known > verified ) verified = known;
+}
+
+void
+netplay_frame( void )
+{
+  /* Frames run again or run ahead are not new frames */
+  if( runahead_active ) return;
+
+  frame++;
+  netplay_pending = 1;
+}
+
+void
+netplay_run( void )
+{
+  libspectrum_dword window;
+
+  netplay_pending = 0;
+
+  if( !netplay_active ) return;
+
+  if( !connected ) {
+    netplay_connect();
+    if( !connected ) return;
+  }
+
+  netplay_input_read(
+    &local_input[ ( frame + settings_current.netplay_delay ) %
+                  NETPLAY_HISTORY ]
+  );
+  netplay_send_input();
+
+  netplay_receive();
+  if( netplay_active ) netplay_check_guesses();
+
+  /* Don't guess further ahead than can be undone */
+  window = netplay_window();
+  while( netplay_active && remote_frames <= frame &&
+         frame + 1 - verified > window && !fuse_exiting ) {
+
+    if( compat_timer_get_monotonic_time() - last_heard > NETPLAY_TIMEOUT ) {
+      ui_error( UI_ERROR_ERROR,
+                "netplay: nothing heard from the other player for %d "
+                "seconds", NETPLAY_TIMEOUT );
+      netplay_stop( 1 );
+      break;
+    }
+
+    if( compat_timer_get_monotonic_time() - last_sent >
+        NETPLAY_RESEND / 1000.0 )
+      netplay_send_input();
+
+    netplay_wait();
+    netplay_receive();
+    if( netplay_active ) netplay_check_guesses();
+    window = netplay_window();
+  }
+
+  if( !netplay_active ) return;
+
+  if( window ) module_state_save( netplay_slot( frame ) );
+  netplay_set_input( frame );
+}
+
+static int
+netplay_open( const char *peer )
+{
+  struct addrinfo hints, *peer_info, *local_info;
+  char *host, *port, local_port[ 16 ];
+  int error;
+
+  host = utils_safe_strdup( peer );
+  port = strrchr( host, ':' );
+  if( !port ) {
+    ui_error( UI_ERROR_ERROR, "netplay: '%s' should be host:port", peer );
+    libspectrum_free( host );
+    return 1;
+  }
+  *port++ = '\0';
+
+  memset( &hints, 0, sizeof( hints ) );
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_DGRAM;
+
+  error = getaddrinfo( host, port, &hints, &peer_info );
+  libspectrum_free( host );
+  if( error ) {
+    ui_error( UI_ERROR_ERROR, "netplay: unable to find '%s': %s", peer,
+              gai_strerror( error ) );
+    return 1;
+  }
+
+  memcpy( &peer_address, peer_info->ai_addr, peer_info->ai_addrlen );
+  peer_address_length = peer_info->ai_addrlen;
+
+  hints.ai_family = peer_info->ai_family;
+  hints.ai_flags = AI_PASSIVE;
+  freeaddrinfo( peer_info );
+
+  snprintf( local_port, sizeof( local_port ), "%d",
+            settings_current.netplay_port );
+  error = getaddrinfo( NULL, local_port, &hints, &local_info );
+  if( error ) {
+    ui_error( UI_ERROR_ERROR, "netplay: unable to use port %d: %s",
+              settings_current.netplay_port, gai_strerror( error ) );
+    return 1;
+  }
+
+  netplay_socket = socket( local_info->ai_family, SOCK_DGRAM, 0 );
+  if( netplay_socket == compat_socket_invalid ) {
+    ui_error( UI_ERROR_ERROR, "netplay: unable to create socket: %s",
+              compat_socket_get_strerror() );
+    freeaddrinfo( local_info );
+    return 1;
+  }
+
+  if( bind( netplay_socket, local_info->ai_addr, local_info->ai_addrlen ) ) {
+    ui_error( UI_ERROR_ERROR, "netplay: unable to bind to port %d: %s",
+              settings_current.netplay_port, compat_socket_get_strerror() );
+    compat_socket_close( netplay_socket );
+    freeaddrinfo( local_info );
+    return 1;
+  }
+
+  freeaddrinfo( local_info );
+
+  return 0;
+}
+
+static void
+netplay_start( void )
+{
+  size_t i;
+
+  compat_socket_networking_init();
+
+  if( netplay_open( settings_current.netplay_peer ) ) {
+    compat_socket_networking_end();
+    return;
+  }
+
+  if( settings_current.netplay_delay < 0 )
+    settings_current.netplay_delay = 0;
+  if( settings_current.netplay_delay > NETPLAY_HISTORY / 4 )
+    settings_current.netplay_delay = NETPLAY_HISTORY / 4;
+
+  connected = 0;
+  frame = 0;
+  last_heard = last_sent = compat_timer_get_monotonic_time();
+
+  for( i = 0; i < NETPLAY_HISTORY; i++ ) local_input[i] = neutral;
+
+  /* Until the other player turns up, the machine sees nothing pressed */
+  current = neutral;
+  keyboard_override = current.keyboard;
+  joystick_override = &current.joystick;
+
+  netplay_active = 1;
+}
+
+static void
+netplay_stop( int tell_peer )
+{
+  if( !netplay_active ) return;
+
+  if( tell_peer && connected ) netplay_send_quit();
+
+  compat_socket_close( netplay_socket );
+  compat_socket_networking_end();
+
+  keyboard_override = NULL;
+  joystick_override = NULL;
+
+  netplay_active = 0;
+  netplay_pending = 0;
+}
+
+static int
+netplay_init( void *context )
+{
+  if( settings_current.netplay_peer ) netplay_start();
+
+  return 0;
+}
+
+static void
+netplay_end( void )
+{
+  netplay_stop( 1 );
+}
+
+void
+netplay_register_startup( void )
+{
+  /* The other player's address is freed by settings_end */
+  startup_manager_module dependencies[] = {
+    STARTUP_MANAGER_MODULE_SETTINGS_END,
+  };
+  startup_manager_register( STARTUP_MANAGER_MODULE_NETPLAY, dependencies,
+                            ARRAY_SIZE( dependencies ), netplay_init, NULL,
+                            netplay_end );
+}
+
+/* Frames run by the unit test, and how many of them have the other
+   player's input before any are run on a guess */
+#define NETPLAY_TEST_FRAMES ( 2 * NETPLAY_MAX_ROLLBACK + 4 )
+#define NETPLAY_TEST_KNOWN 2
+
+/* Code which stores what the B to SPACE half row reads as just after each
+   interrupt, from 0x7002 on */
+static const libspectrum_byte netplay_test_code[] = {
+  0xfb,			/* 6000 EI */
+  0x76,			/* 6001 HALT */
+  0x3e, 0x7f,		/* 6002 LD A,0x7f */
+  0xdb, 0xfe,		/* 6004 IN A,(0xfe) */
+  0x2a, 0x00, 0x70,	/* 6006 LD HL,(0x7000) */
+  0x77,			/* 6009 LD (HL),A */
+  0x23,			/* 600a INC HL */
+  0x22, 0x00, 0x70,	/* 600b LD (0x7000),HL */
+  0x18, 0xf0,		/* 600e JR 0x6000 */
+};
+
+/* The other player presses a different key in each frame, so guessing
+   that they are doing what they did last time is always wrong */
+static void
+netplay_test_input( libspectrum_dword n, netplay_input_t *input )
+{
+  *input = neutral;
+  input->keyboard[7] = 0xff ^ ( 1 << ( n % 5 ) );
+}
+
+/* Receive the other player's input for 'count' frames from 'first' */
+static void
+netplay_test_receive( libspectrum_dword ack, libspectrum_dword first,
+                      libspectrum_dword count )
+{
+  libspectrum_byte buffer[ NETPLAY_MAX_PACKET ], *ptr = buffer;
+  netplay_input_t input;
+  libspectrum_dword i;
+
+  libspectrum_write_dword( &ptr, ack );
+  libspectrum_write_dword( &ptr, first );
+  *ptr++ = count;
+
+  for( i = 0; i < count; i++ ) {
+    netplay_test_input( first + i, &input );
+    netplay_input_write( &ptr, &input );
+  }
+
+  netplay_receive_input( buffer, ptr );
+}
+
+/* Put the machine back as it was before the test and start a session
+   with nothing yet heard from the other player */
+static void
+netplay_test_start( void )
+{
+  size_t i;
+
+  module_state_restore( 0 );
+
+  for( i = 0; i < ARRAY_SIZE( netplay_test_code ); i++ )
+    writebyte_internal( 0x6000 + i, netplay_test_code[i] );
+  writebyte_internal( 0x7000, 0x02 );
+  writebyte_internal( 0x7001, 0x70 );
+
+  z80.pc.w = 0x6000;
+  z80.sp.w = 0x7ff0;
+  z80.iy.w = 0x5c3a;
+  z80.im = 1;
+  z80.iff1 = z80.iff2 = 0;
+  z80.halted = 0;
+
+  connected = 1;
+  frame = remote_frames = verified = peer_needs = 0;
+  for( i = 0; i < NETPLAY_HISTORY; i++ ) local_input[i] = neutral;
+
+  current = neutral;
+  keyboard_override = current.keyboard;
+  joystick_override = &current.joystick;
+}
+
+/* Run the next frame, as netplay_run and the main loop would */
+static void
+netplay_test_frame( void )
+{
+  module_state_save( netplay_slot( frame ) );
+  netplay_set_input( frame );
+  runahead_emulate( 1, 0 );
+  frame++;
+}
+
+/* Run the next frame with the other player's real input */
+static void
+netplay_test_frame_known( void )
+{
+  netplay_test_receive( frame, frame, 1 );
+  netplay_check_guesses();
+  netplay_test_frame();
+}
+
+/* Run twice through 'depth' frames on a guess at the other player's
+   input before it arrives, checking that each time the machine ends up
+   just as it did with the real input from the start */
+static int
+netplay_test_rollback( libspectrum_dword depth,
+                       const libspectrum_dword *expected )
+{
+  libspectrum_dword first, acknowledged, rollbacks, resimulated;
+  int r = 0, pass;
+
+  netplay_test_start();
+
+  while( frame < NETPLAY_TEST_KNOWN ) netplay_test_frame_known();
+
+  for( pass = 0; pass < 2; pass++ ) {
+
+    first = frame;
+    while( frame < first + depth ) netplay_test_frame();
+    TEST_ASSERT( netplay_state_check() != expected[ frame ] );
+
+    /* An acknowledgement of input we haven't sent yet is ignored */
+    acknowledged = peer_needs;
+    netplay_test_receive( frame + 2, frame, 0 );
+    TEST_ASSERT( peer_needs == acknowledged );
+
+    rollbacks = perfstats_counts[ PERFSTATS_COUNTER_ROLLBACKS ];
+    resimulated = perfstats_counts[ PERFSTATS_COUNTER_RESIMULATED ];
+
+    /* The input for the last frame we already have comes again with that
+       for the frames which were guessed */
+    netplay_test_receive( frame, first - 1, depth + 1 );
+    TEST_ASSERT( remote_frames == frame );
+    TEST_ASSERT( peer_needs == frame );
+
+    netplay_check_guesses();
+    TEST_ASSERT( verified == frame );
+    TEST_ASSERT( perfstats_counts[ PERFSTATS_COUNTER_ROLLBACKS ] ==
+                 rollbacks + 1 );
+    TEST_ASSERT( perfstats_counts[ PERFSTATS_COUNTER_RESIMULATED ] ==
+                 resimulated + depth );
+    TEST_ASSERT( netplay_state_check() == expected[ frame ] );
+  }
+
+  while( frame < NETPLAY_TEST_FRAMES ) netplay_test_frame_known();
+  TEST_ASSERT( netplay_state_check() == expected[ frame ] );
+
+  return r;
+}
+
+int
+netplay_unittest( void )
+{
+  libspectrum_dword expected[ NETPLAY_TEST_FRAMES + 1 ];
+  int r = 0, delay;
+
+  /* Peripherals which can't be saved mean nothing can be undone */
+  if( netplay_active || !runahead_available() ) return 0;
+
+  module_state_save( 0 );
+  delay = settings_current.netplay_delay;
+  settings_current.netplay_delay = 0;
+  perfstats_start();
+
+  /* What the machine looks like after each frame when the other player's
+     input is always there in time */
+  netplay_test_start();
+  expected[ frame ] = netplay_state_check();
+  while( frame < NETPLAY_TEST_FRAMES ) {
+    netplay_test_frame_known();
+    expected[ frame ] = netplay_state_check();
+  }
+
+  r += netplay_test_rollback( 1, expected );
+  r += netplay_test_rollback( NETPLAY_MAX_ROLLBACK, expected );
+
+  perfstats_stop();
+  settings_current.netplay_delay = delay;
+
+  keyboard_override = NULL;
+  joystick_override = NULL;
+  connected = 0;
+  module_state_restore( 0 );
+
+  return r;
+}
+
+#else			/* #ifdef BUILD_NETPLAY */
+
+/* No netplay support */
+
+static int
+netplay_init( void *context )
+{
+  if( settings_current.netplay_peer )
+    ui_error( UI_ERROR_ERROR, "netplay is not supported on this system" );
+
+  return 0;
+}
+
+void
+netplay_register_startup( void )
+{
+  startup_manager_register_no_dependencies( STARTUP_MANAGER_MODULE_NETPLAY,
+                                            netplay_init, NULL, NULL );
+}
+
+void
+netplay_frame( void )
+{
+}
+
+void
+netplay_run( void )
+{
+}
+
+int
+netplay_unittest( void )
+{
+  return 0;
+}
+
+#endif			/* #ifdef BUILD_NETPLAY */
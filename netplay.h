@@ -0,0 +1,60 @@
+/* netplay.h: two player netplay over UDP
+   Copyright (c) 2026 Fuse contributors
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+   Author contact information:
+
+   E-mail: philip-fuse@shadowmagic.org.uk
+
+*/
+
+
+#ifndef FUSE_NETPLAY_H
+#define FUSE_NETPLAY_H
+
+#include <libspectrum.h>
+
+#include "peripherals/joystick.h"
+
+/* Everything one player can do to the machine in a frame */
+typedef struct netplay_input_t {
+  libspectrum_byte keyboard[8];
+  joystick_values_t joystick;
+} netplay_input_t;
+
+/* Set while a netplay session is running */
+extern int netplay_active;
+
+/* Set when a frame has finished and the inputs must be exchanged before
+   the next one starts */
+extern int netplay_pending;
+
+void netplay_register_startup( void );
+
+/* Called at the end of each frame */
+void netplay_frame( void );
+
+/* Exchange inputs with the other player, rolling back and running again
+   any frames which were run with the wrong guess at their input */
+void netplay_run( void );
+
+/* Combine the two players' input as the machine sees it */
+void netplay_input_merge( netplay_input_t *merged, const netplay_input_t *a,
+                          const netplay_input_t *b );
+
+int netplay_unittest( void );
+
+#endif			/* #ifndef FUSE_NETPLAY_H */
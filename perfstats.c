@@ -0,0 +1,331 @@
+/* perfstats.c: per-frame performance statistics
+   Copyright (c) 2026 Fuse contributors
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+   Author contact information:
+
+   E-mail: philip-fuse@shadowmagic.org.uk
+
+*/
+
+/* The wall time of each frame is charged to whichever stage was last
+   entered, so every moment between two frames ends up in exactly one
+   stage and the stages of a frame add up to its total length */
+
+#include <config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef HAVE_STRINGS_STRCASECMP
+#include <strings.h>
+#endif      /* #ifdef HAVE_STRINGS_STRCASECMP */
+
+#include <glib.h>
+#include <libspectrum.h>
+
+#include "compat.h"
+#include "event.h"
+#include "infrastructure/startup_manager.h"
+#include "perfstats.h"
+#include "settings.h"
+#include "rzx.h"
+#include "ui/ui.h"
+#include "z80/z80.h"
+
+int perfstats_active = 0;
+
+libspectrum_dword perfstats_counts[ PERFSTATS_COUNTER_COUNT ];
+
+const char * const perfstats_stage_names[ PERFSTATS_STAGE_COUNT ] = {
+  "other", "z80", "events", "display", "sound", "scaler", "ui", "runahead",
+  "rollback", "sleep",
+};
+
+const char * const perfstats_counter_names[ PERFSTATS_COUNTER_COUNT ] = {
+  "fetches", "events", "port_reads", "port_writes", "rectangles",
+  "samples", "rollbacks", "resimulated", "allocations",
+};
+
+/* The most recent frames, as a ring buffer */
+static perfstats_frame_t frames[ PERFSTATS_FRAMES ];
+static size_t frames_first, frames_used;
+
+/* The frame being recorded */
+static perfstats_frame_t current;
+static perfstats_stage current_stage;
+static double stage_start;
+
+/* The opcode fetch count when the Z80 stage was entered. This is the
+   count RZX files use, which is R corrected for LD R,A and interrupts, so
+   the core itself needs no changes and can still use the predecode cache.
+   It counts M1 cycles rather than instructions: each prefix is a fetch of
+   its own, so CB, DD, ED and FD prefixed opcodes count two (as do DDCB and
+   FDCB ones, whose last opcode byte isn't an M1 cycle). Only the low 16
+   bits are kept, which is plenty as the core never runs as many as 65536
+   fetches in one go */
+static libspectrum_word z80_start_fetches;
+
+static libspectrum_word
+perfstats_fetches( void )
+{
+  return z80.r + rzx_instructions_offset;
+}
+
+/* Every allocation made through libspectrum_new() and friends is counted,
+   so that anything which allocates memory every frame shows up */
+static volatile gint allocations;
+static libspectrum_dword frame_start_allocations;
+
+static void*
+perfstats_malloc( size_t size )
+{
+  g_atomic_int_inc( &allocations );
+  return malloc( size );
+}
+
+static void*
+perfstats_calloc( size_t nmemb, size_t size )
+{
+  g_atomic_int_inc( &allocations );
+  return calloc( nmemb, size );
+}
+
+static void*
+perfstats_realloc( void *ptr, size_t size )
+{
+  g_atomic_int_inc( &allocations );
+  return realloc( ptr, size );
+}
+
+static libspectrum_mem_vtable_t perfstats_mem_vtable = {
+  perfstats_malloc,
+  perfstats_calloc,
+  perfstats_realloc,
+  free,
+};
+
+static int
+perfstats_init( void *context )
+{
+  /* The functions just count and pass the call on, so memory allocated
+     before this can still be freed afterwards and vice versa */
+  libspectrum_mem_set_vtable( &perfstats_mem_vtable );
+
+  if( settings_current.perfstats || settings_current.perfstats_file )
+    perfstats_start();
+
+  return 0;
+}
+
+static void
+perfstats_end( void )
+{
+  if( settings_current.perfstats_file && frames_used )
+    perfstats_write( settings_current.perfstats_file );
+
+  perfstats_active = 0;
+}
+
+void
+perfstats_register_startup( void )
+{
+  /* The file to write to is freed by settings_end */
+  startup_manager_module dependencies[] = {
+    STARTUP_MANAGER_MODULE_SETTINGS_END,
+  };
+  startup_manager_register( STARTUP_MANAGER_MODULE_PERFSTATS, dependencies,
+                            ARRAY_SIZE( dependencies ), perfstats_init, NULL,
+                            perfstats_end );
+}
+
+static void
+perfstats_reset_frame( void )
+{
+  memset( &current, 0, sizeof( current ) );
+  memset( perfstats_counts, 0, sizeof( perfstats_counts ) );
+  frame_start_allocations = perfstats_allocation_count();
+}
+
+void
+perfstats_start( void )
+{
+  frames_first = frames_used = 0;
+  perfstats_reset_frame();
+
+  current_stage = PERFSTATS_STAGE_OTHER;
+  stage_start = compat_timer_get_monotonic_time();
+
+  perfstats_active = 1;
+
+  /* Schedule an event so that the Z80 core returns and its stage, and
+     the opcode fetches in it, start being counted straight away */
+  event_add( tstates, event_type_null );
+}
+
+void
+perfstats_stop( void )
+{
+  perfstats_active = 0;
+
+  event_add( tstates, event_type_null );
+}
+
+perfstats_stage
+perfstats_enter( perfstats_stage stage )
+{
+  perfstats_stage previous = current_stage;
+  double now;
+
+  if( !perfstats_active ) return previous;
+
+  now = compat_timer_get_monotonic_time();
+  current.time[ current_stage ] += now - stage_start;
+
+  if( current_stage == PERFSTATS_STAGE_Z80 )
+    perfstats_counts[ PERFSTATS_COUNTER_FETCHES ] +=
+      (libspectrum_word)( perfstats_fetches() - z80_start_fetches );
+  if( stage == PERFSTATS_STAGE_Z80 ) z80_start_fetches = perfstats_fetches();
+
+  current_stage = stage;
+  stage_start = now;
+
+  return previous;
+}
+
+void
+perfstats_frame( void )
+{
+  perfstats_frame_t *frame;
+
+  /* Close off the time spent so far without changing stage */
+  perfstats_enter( current_stage );
+
+  if( frames_used < PERFSTATS_FRAMES ) {
+    frame = &frames[ ( frames_first + frames_used++ ) % PERFSTATS_FRAMES ];
+  } else {
+    frame = &frames[ frames_first ];
+    frames_first = ( frames_first + 1 ) % PERFSTATS_FRAMES;
+  }
+
+  perfstats_counts[ PERFSTATS_COUNTER_ALLOCATIONS ] =
+    perfstats_allocation_count() - frame_start_allocations;
+
+  memcpy( current.count, perfstats_counts, sizeof( current.count ) );
+  *frame = current;
+
+  perfstats_reset_frame();
+  current.frame = frame->frame + 1;
+}
+
+libspectrum_dword
+perfstats_allocation_count( void )
+{
+  return (libspectrum_dword)g_atomic_int_get( &allocations );
+}
+
+size_t
+perfstats_frame_count( void )
+{
+  return frames_used;
+}
+
+const perfstats_frame_t*
+perfstats_get_frame( size_t n )
+{
+  if( n >= frames_used ) return NULL;
+
+  return &frames[ ( frames_first + n ) % PERFSTATS_FRAMES ];
+}
+
+static void
+write_csv( FILE *f )
+{
+  const perfstats_frame_t *frame;
+  size_t i, j;
+
+  fprintf( f, "frame" );
+  for( j = 0; j < PERFSTATS_STAGE_COUNT; j++ )
+    fprintf( f, ",%s_ms", perfstats_stage_names[ j ] );
+  for( j = 0; j < PERFSTATS_COUNTER_COUNT; j++ )
+    fprintf( f, ",%s", perfstats_counter_names[ j ] );
+  fprintf( f, "\n" );
+
+  for( i = 0; i < frames_used; i++ ) {
+    frame = perfstats_get_frame( i );
+
+    fprintf( f, "%lu", (unsigned long)frame->frame );
+    for( j = 0; j < PERFSTATS_STAGE_COUNT; j++ )
+      fprintf( f, ",%.3f", frame->time[ j ] * 1000 );
+    for( j = 0; j < PERFSTATS_COUNTER_COUNT; j++ )
+      fprintf( f, ",%lu", (unsigned long)frame->count[ j ] );
+    fprintf( f, "\n" );
+  }
+}
+
+static void
+write_json( FILE *f )
+{
+  const perfstats_frame_t *frame;
+  size_t i, j;
+
+  fprintf( f, "[\n" );
+
+  for( i = 0; i < frames_used; i++ ) {
+    frame = perfstats_get_frame( i );
+
+    fprintf( f, "  { \"frame\": %lu", (unsigned long)frame->frame );
+    for( j = 0; j < PERFSTATS_STAGE_COUNT; j++ )
+      fprintf( f, ", \"%s_ms\": %.3f", perfstats_stage_names[ j ],
+               frame->time[ j ] * 1000 );
+    for( j = 0; j < PERFSTATS_COUNTER_COUNT; j++ )
+      fprintf( f, ", \"%s\": %lu", perfstats_counter_names[ j ],
+               (unsigned long)frame->count[ j ] );
+    fprintf( f, " }%s\n", i + 1 < frames_used ? "," : "" );
+  }
+
+  fprintf( f, "]\n" );
+}
+
+int
+perfstats_write( const char *filename )
+{
+  const char *extension;
+  FILE *f;
+
+  f = fopen( filename, "w" );
+  if( !f ) {
+    ui_error( UI_ERROR_ERROR,
+              "unable to open performance statistics '%s' for writing",
+              filename );
+    return 1;
+  }
+
+  extension = strrchr( filename, '.' );
+  if( extension && !strcasecmp( extension, ".json" ) ) {
+    write_json( f );
+  } else {
+    write_csv( f );
+  }
+
+  if( fclose( f ) ) {
+    ui_error( UI_ERROR_ERROR, "error writing performance statistics '%s'",
+              filename );
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,105 @@
+/* perfstats.h: per-frame performance statistics
+   Copyright (c) 2026 Fuse contributors
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+   Author contact information:
+
+   E-mail: philip-fuse@shadowmagic.org.uk
+
+*/
+
+#ifndef FUSE_PERFSTATS_H
+#define FUSE_PERFSTATS_H
+
+#include <libspectrum.h>
+
+/* Where the time in each frame goes */
+typedef enum perfstats_stage {
+  PERFSTATS_STAGE_OTHER,	/* Anything not listed below */
+  PERFSTATS_STAGE_Z80,		/* Running the Z80 core */
+  PERFSTATS_STAGE_EVENTS,	/* Events other than those below */
+  PERFSTATS_STAGE_DISPLAY,	/* Finishing the frame in display_frame() */
+  PERFSTATS_STAGE_SOUND,	/* AY overlay and filling the sound buffer */
+  PERFSTATS_STAGE_SCALER,	/* Scaling changed areas for the UI */
+  PERFSTATS_STAGE_UI,		/* uidisplay_frame_end() */
+  PERFSTATS_STAGE_RUNAHEAD,	/* Frames run ahead and then thrown away */
+  PERFSTATS_STAGE_ROLLBACK,	/* Frames run again by netplay */
+  PERFSTATS_STAGE_SLEEP,	/* Waiting for the timer or sound device */
+
+  PERFSTATS_STAGE_COUNT
+} perfstats_stage;
+
+/* What is counted in each frame */
+typedef enum perfstats_counter {
+  PERFSTATS_COUNTER_FETCHES,	/* Opcode fetches (M1 cycles) */
+  PERFSTATS_COUNTER_EVENTS,
+  PERFSTATS_COUNTER_PORT_READS,
+  PERFSTATS_COUNTER_PORT_WRITES,
+  PERFSTATS_COUNTER_RECTANGLES,	/* Areas sent to the UI */
+  PERFSTATS_COUNTER_SAMPLES,	/* Audio samples */
+  PERFSTATS_COUNTER_ROLLBACKS,	/* Times netplay went back */
+  PERFSTATS_COUNTER_RESIMULATED,	/* Frames netplay ran again */
+  PERFSTATS_COUNTER_ALLOCATIONS,	/* Memory allocated via libspectrum */
+
+  PERFSTATS_COUNTER_COUNT
+} perfstats_counter;
+
+/* The statistics for one frame */
+typedef struct perfstats_frame_t {
+  libspectrum_dword frame;
+  double time[ PERFSTATS_STAGE_COUNT ];	/* In seconds */
+  libspectrum_dword count[ PERFSTATS_COUNTER_COUNT ];
+} perfstats_frame_t;
+
+/* How many frames are kept */
+#define PERFSTATS_FRAMES 500
+
+extern int perfstats_active;
+
+/* The counts for the current frame */
+extern libspectrum_dword perfstats_counts[ PERFSTATS_COUNTER_COUNT ];
+
+extern const char * const perfstats_stage_names[ PERFSTATS_STAGE_COUNT ];
+extern const char * const perfstats_counter_names[ PERFSTATS_COUNTER_COUNT ];
+
+#define perfstats_count( counter, n ) \
+  do { if( perfstats_active ) perfstats_counts[ counter ] += (n); } while( 0 )
+
+void perfstats_register_startup( void );
+
+void perfstats_start( void );
+void perfstats_stop( void );
+
+/* Start timing 'stage', returning the stage which was being timed so
+   that it can be restored afterwards */
+perfstats_stage perfstats_enter( perfstats_stage stage );
+
+/* Called at the end of each frame */
+void perfstats_frame( void );
+
+/* The number of frames recorded, and each of them, oldest first */
+size_t perfstats_frame_count( void );
+const perfstats_frame_t* perfstats_get_frame( size_t n );
+
+/* The number of memory allocations made via libspectrum since startup,
+   from any thread */
+libspectrum_dword perfstats_allocation_count( void );
+
+/* Write the recorded frames as JSON if the filename ends in .json, or as
+   CSV otherwise */
+int perfstats_write( const char *filename );
+
+#endif			/* #ifndef FUSE_PERFSTATS_H */
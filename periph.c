@@ -29,6 +29,7 @@
 #include "debugger/debugger.h"
 #include "event.h"
 #include "fuse.h"
+#include "perfstats.h"
 #include "periph.h"
 #include "peripherals/if1.h"
 #include "peripherals/multiface.h"
@@ -313,8 +314,10 @@ readport_internal( libspectrum_word port )
 {
   struct peripheral_data_t callback_info;
 
+  perfstats_count( PERFSTATS_COUNTER_PORT_READS, 1 );
+
   /* Trigger the debugger if wanted */
-  if( debugger_mode != DEBUGGER_MODE_INACTIVE )
+  if( debugger_port_read_watched( port ) )
     debugger_check( DEBUGGER_BREAKPOINT_TYPE_PORT_READ, port );
 
   /* If we're doing RZX playback, get a byte from the RZX file */
@@ -392,8 +395,10 @@ writeport_internal( libspectrum_word port, libspectrum_byte b )
 {
   struct peripheral_data_t callback_info;
 
+  perfstats_count( PERFSTATS_COUNTER_PORT_WRITES, 1 );
+
   /* Trigger the debugger if wanted */
-  if( debugger_mode != DEBUGGER_MODE_INACTIVE )
+  if( debugger_port_write_watched( port ) )
     debugger_check( DEBUGGER_BREAKPOINT_TYPE_PORT_WRITE, port );
 
   callback_info.port = port;
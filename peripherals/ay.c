@@ -50,6 +50,8 @@ static void ay_from_snapshot( libspectrum_snap *snap );
 static void ay_to_snapshot( libspectrum_snap *snap );
 static libspectrum_dword get_current_register( void );
 static void set_current_register( libspectrum_dword value );
+static void ay_state_save( int slot );
+static void ay_state_restore( int slot );
 
 static module_info_t ay_module_info = {
 
@@ -58,6 +60,8 @@ static module_info_t ay_module_info = {
   /* .snapshot_enabled = */ NULL,
   /* .snapshot_from = */ ay_from_snapshot,
   /* .snapshot_to = */ ay_to_snapshot,
+  /* .state_save = */ ay_state_save,
+  /* .state_restore = */ ay_state_restore,
 
 };
 
@@ -247,6 +251,20 @@ ay_to_snapshot( libspectrum_snap *snap )
 				       machine_current->ay.registers[i] );
 }
 
+static ayinfo saved_ay[ MODULE_STATE_SLOTS ];
+
+static void
+ay_state_save( int slot )
+{
+  saved_ay[ slot ] = machine_current->ay;
+}
+
+static void
+ay_state_restore( int slot )
+{
+  machine_current->ay = saved_ay[ slot ];
+}
+
 static libspectrum_dword
 get_current_register( void )
 {
@@ -42,6 +42,9 @@
 /* Number of joysticks known about & initialised */
 int joysticks_supported = 0;
 
+/* Whether the UI has looked for joysticks yet */
+static int joysticks_probed = 0;
+
 /* The bit masks used by the various joysticks. The order is the same
    as the ordering of buttons in joystick.h:joystick_button (left,
    right, up, down, fire ) */
@@ -66,6 +69,8 @@ static libspectrum_byte timex1_value;
 static libspectrum_byte timex2_value;
 static libspectrum_byte fuller_value;
 
+const joystick_values_t *joystick_override = NULL;
+
 /* The names of the joysticks we can emulate. Order must correspond to
    that of joystick.h:joystick_type_t */
 const char *joystick_name[ JOYSTICK_TYPE_COUNT ] = {
@@ -126,7 +131,6 @@ static const periph_t kempston_loose_periph = {
 int
 joystick_init( void *context )
 {
-  joysticks_supported = ui_joystick_init();
   kempston_value = timex1_value = timex2_value = 0x00;
   fuller_value = 0xff;
 
@@ -140,7 +144,21 @@ joystick_init( void *context )
 void
 joystick_end( void )
 {
-  ui_joystick_end();
+  if( joysticks_probed ) ui_joystick_end();
+}
+
+void
+joystick_poll( void )
+{
+  /* Looking for joysticks can take a while, so it's left until they're
+     first needed at the end of the first frame rather than holding up
+     startup */
+  if( !joysticks_probed ) {
+    joysticks_supported = ui_joystick_init();
+    joysticks_probed = 1;
+  }
+
+  ui_joystick_poll();
 }
 
 void
@@ -237,18 +255,30 @@ joystick_press( int which, joystick_button button, int press )
   fuse_abort();
 }
 
+void
+joystick_get_values( joystick_values_t *values )
+{
+  values->kempston = kempston_value;
+  values->timex1 = timex1_value;
+  values->timex2 = timex2_value;
+  values->fuller = fuller_value;
+}
+
 /* Read functions for specific interfaces */
 
 libspectrum_byte
 joystick_kempston_read( libspectrum_word port GCC_UNUSED, libspectrum_byte *attached )
 {
   *attached = 0xff; /* TODO: check this */
-  return kempston_value;
+  return joystick_override ? joystick_override->kempston : kempston_value;
 }
 
 libspectrum_byte
 joystick_timex_read( libspectrum_word port GCC_UNUSED, libspectrum_byte which )
 {
+  if( joystick_override )
+    return which ? joystick_override->timex2 : joystick_override->timex1;
+
   return which ? timex2_value : timex1_value;
 }
 
@@ -256,7 +286,7 @@ libspectrum_byte
 joystick_fuller_read( libspectrum_word port GCC_UNUSED, libspectrum_byte *attached )
 {
   *attached = 0xff; /* TODO: check this */
-  return fuller_value;
+  return joystick_override ? joystick_override->fuller : fuller_value;
 }
 
 static void
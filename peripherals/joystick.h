@@ -33,6 +33,9 @@ extern int joysticks_supported;
 
 void joystick_register_startup( void );
 
+/* Poll the host's joysticks, looking for them the first time */
+void joystick_poll( void );
+
 /* A constant to identify the joystick emulated via the keyboard */
 #define JOYSTICK_KEYBOARD 2
 
@@ -66,6 +69,20 @@ typedef enum joystick_button {
 
 } joystick_button;
 
+/* What the joystick interfaces return */
+typedef struct joystick_values_t {
+  libspectrum_byte kempston;
+  libspectrum_byte timex1, timex2;
+  libspectrum_byte fuller;
+} joystick_values_t;
+
+/* If set, what the emulated machine sees instead of the joysticks
+   themselves; used by netplay */
+extern const joystick_values_t *joystick_override;
+
+/* The values set by the joysticks themselves */
+void joystick_get_values( joystick_values_t *values );
+
 /* Called whenever the (Spectrum) joystick is moved or the fire button
    pressed */
 int joystick_press( int which, joystick_button button, int press );
@@ -26,6 +26,7 @@
 
 #include <config.h>
 
+#include <errno.h>
 #include <pthread.h>
 #include <string.h>
 #include <sys/types.h>
@@ -83,6 +84,78 @@ nic_w5100_reset( nic_w5100_t *self )
     nic_w5100_socket_reset( &self->socket[i] );
 }
 
+#ifdef HAVE_SYS_EPOLL_H
+
+/* Wait for the host sockets with epoll, so that the set of sockets is
+   only passed to the kernel when it changes */
+static void*
+w5100_io_thread( void *arg )
+{
+  nic_w5100_t *self = arg;
+  struct epoll_event events[5];
+  int i, active, id;
+
+  while( !self->stop_io_thread ) {
+    for( i = 0; i < 4; i++ )
+      nic_w5100_socket_update_epoll( &self->socket[i], self->epoll_fd );
+
+    nic_w5100_debug( "w5100: io thread epoll_wait\n" );
+
+    active = epoll_wait( self->epoll_fd, events, ARRAY_SIZE( events ), -1 );
+
+    nic_w5100_debug( "w5100: io thread wake; %d active\n", active );
+
+    if( active == -1 ) {
+      if( errno != EINTR )
+        nic_w5100_debug( "w5100: epoll_wait returned unexpected errno %d: %s\n",
+                         compat_socket_get_error(),
+                         compat_socket_get_strerror() );
+      continue;
+    }
+
+    for( i = 0; i < active; i++ ) {
+      if( events[i].data.u64 == W5100_EPOLL_SELFPIPE ) {
+        nic_w5100_debug( "w5100: discarding selfpipe data\n" );
+        compat_socket_selfpipe_discard_data( self->selfpipe );
+        continue;
+      }
+
+      id = W5100_EPOLL_ID( events[i].data.u64 );
+      nic_w5100_socket_process_events( &self->socket[id],
+                                       W5100_EPOLL_GENERATION( events[i].data.u64 ),
+                                       events[i].events );
+    }
+  }
+
+  return NULL;
+}
+
+static void
+w5100_epoll_init( nic_w5100_t *self )
+{
+  struct epoll_event event;
+
+  self->epoll_fd = epoll_create( 5 );
+  if( self->epoll_fd == -1 ) {
+    ui_error( UI_ERROR_ERROR, "w5100: error %d creating epoll instance",
+              errno );
+    fuse_abort();
+  }
+
+  memset( &event, 0, sizeof( event ) );
+  event.events = EPOLLIN;
+  event.data.u64 = W5100_EPOLL_SELFPIPE;
+  if( epoll_ctl( self->epoll_fd, EPOLL_CTL_ADD,
+                 compat_socket_selfpipe_get_read_fd( self->selfpipe ),
+                 &event ) == -1 ) {
+    ui_error( UI_ERROR_ERROR, "w5100: error %d adding selfpipe to epoll",
+              errno );
+    fuse_abort();
+  }
+}
+
+#else				/* #ifdef HAVE_SYS_EPOLL_H */
+
 static void*
 w5100_io_thread( void *arg )
 {
@@ -139,6 +212,8 @@ w5100_io_thread( void *arg )
   return NULL;
 }
 
+#endif				/* #ifdef HAVE_SYS_EPOLL_H */
+
 nic_w5100_t*
 nic_w5100_alloc( void )
 {
@@ -152,6 +227,10 @@ nic_w5100_alloc( void )
 
   self->selfpipe = compat_socket_selfpipe_alloc();
 
+#ifdef HAVE_SYS_EPOLL_H
+  w5100_epoll_init( self );
+#endif
+
   for( i = 0; i < 4; i++ )
     nic_w5100_socket_init( &self->socket[i], i );
 
@@ -182,6 +261,10 @@ nic_w5100_free( nic_w5100_t *self )
     for( i = 0; i < 4; i++ )
       nic_w5100_socket_end( &self->socket[i] );
 
+#ifdef HAVE_SYS_EPOLL_H
+    close( self->epoll_fd );
+#endif
+
     compat_socket_selfpipe_free( self->selfpipe );
 
     compat_socket_networking_end();
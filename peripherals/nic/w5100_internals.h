@@ -33,6 +33,25 @@
 #include <sys/select.h>
 #endif
 
+#ifdef HAVE_SYS_EPOLL_H
+#include <sys/epoll.h>
+#endif
+
+/* Fields shared between the emulation and the I/O thread without taking
+   the socket's lock are accessed only through these */
+#ifdef __ATOMIC_ACQUIRE
+#define w5100_load( x ) __atomic_load_n( &(x), __ATOMIC_ACQUIRE )
+#define w5100_store( x, v ) __atomic_store_n( &(x), (v), __ATOMIC_RELEASE )
+#define w5100_or( x, v ) __atomic_fetch_or( &(x), (v), __ATOMIC_ACQ_REL )
+#define w5100_and( x, v ) __atomic_fetch_and( &(x), (v), __ATOMIC_ACQ_REL )
+#else
+#define w5100_load( x ) __sync_fetch_and_or( &(x), 0 )
+#define w5100_store( x, v ) \
+  do { __sync_synchronize(); (x) = (v); __sync_synchronize(); } while( 0 )
+#define w5100_or( x, v ) __sync_fetch_and_or( &(x), (v) )
+#define w5100_and( x, v ) __sync_fetch_and_and( &(x), (v) )
+#endif
+
 typedef enum w5100_socket_mode {
   W5100_SOCKET_MODE_CLOSED = 0x00,
   W5100_SOCKET_MODE_TCP,
@@ -83,6 +102,21 @@ enum w5100_socket_registers {
   W5100_SOCKET_RX_RD1,
 };
 
+/* The number of UDP datagrams which can be waiting to be sent */
+#define W5100_DATAGRAMS 0x20
+
+typedef struct w5100_datagram_t {
+  int length;
+  libspectrum_byte dip[4];  /* Where it's going, as at the SEND command */
+  libspectrum_byte dport[2];
+} w5100_datagram_t;
+
+/* The buffers are rings with one writer and one reader each: the emulation
+   fills tx_buffer and empties rx_buffer, and the I/O thread does the
+   opposite. Register reads and writes, and the SEND and RECV commands,
+   don't take the socket's lock, so the emulation never waits for the I/O
+   thread; the lock is held only while the host socket itself is changed or
+   used */
 typedef struct nic_w5100_socket_t {
 
   int id; /* For debug use only */
@@ -94,20 +128,23 @@ typedef struct nic_w5100_socket_t {
 
   w5100_socket_state state;
 
-  libspectrum_byte ir;      /* Interrupt register */
+  libspectrum_byte ir;      /* Interrupt register; set by both threads */
 
   libspectrum_byte port[2]; /* Source port */
 
   libspectrum_byte dip[4];  /* Destination IP address */
   libspectrum_byte dport[2];/* Destination port */
 
-  libspectrum_word tx_rr;   /* Transmit read pointer */
+  libspectrum_word tx_rr;   /* Transmit read pointer; I/O thread */
   libspectrum_word tx_wr;   /* Transmit write pointer */
+  libspectrum_word tx_end;  /* Sn_TX_WR at the last SEND command */
 
-  libspectrum_word rx_rsr;  /* Received size */
+  libspectrum_word rx_wr;   /* Where received data goes next; I/O thread */
   libspectrum_word rx_rd;   /* Received read pointer */
 
-  libspectrum_word old_rx_rd; /* Used in RECV command processing */
+  /* Sn_RX_RD at the last RECV command; the received size is the distance
+     from here to rx_wr */
+  libspectrum_word old_rx_rd;
 
   libspectrum_byte tx_buffer[0x800];  /* Transmit buffer */
   libspectrum_byte rx_buffer[0x800];  /* Received buffer */
@@ -117,17 +154,25 @@ typedef struct nic_w5100_socket_t {
   compat_socket_t fd;       /* Socket file descriptor */
   int bind_count;           /* Number of writes to the Sn_PORTx registers we've received */
   int socket_bound;         /* True once we've bound the socket to a port */
-  int write_pending;        /* True if we're waiting to write data on this socket */
 
   int last_send;            /* The value of Sn_TX_WR when the SEND command was last sent */
-  int datagram_lengths[0x20]; /* The lengths of datagrams to be sent */
-  int datagram_count;
+  w5100_datagram_t datagrams[W5100_DATAGRAMS]; /* Datagrams to be sent */
+  unsigned datagram_head;   /* Next datagram to be queued; emulation */
+  unsigned datagram_tail;   /* Next datagram to be sent; I/O thread */
 
   /* Flag used to indicate that a socket has been closed since we started
      waiting for it in a select() call and therefore the socket should no
      longer be used */
   int ok_for_io;
 
+  /* Changed every time fd is, so that events for a host socket which has
+     since been closed can be recognised */
+  unsigned generation;
+
+  /* What the I/O thread has registered with epoll for this socket */
+  unsigned registered_generation;
+  int registered_events;    /* -1 if not registered */
+
   pthread_mutex_t lock;     /* Mutex for this socket */
 
 } nic_w5100_socket_t;
@@ -141,6 +186,9 @@ struct nic_w5100_t {
   nic_w5100_socket_t socket[4];
 
   pthread_t thread;         /* Thread for doing I/O */
+#ifdef HAVE_SYS_EPOLL_H
+  int epoll_fd;             /* The host sockets the I/O thread waits on */
+#endif
   sig_atomic_t stop_io_thread; /* Flag to stop I/O thread */
   compat_socket_selfpipe_t *selfpipe; /* Device for waking I/O thread */
 };
@@ -161,6 +209,19 @@ void nic_w5100_socket_add_to_sets( nic_w5100_socket_t *socket, fd_set *readfds,
 void nic_w5100_socket_process_io( nic_w5100_socket_t *socket, fd_set readfds,
   fd_set writefds );
 
+#ifdef HAVE_SYS_EPOLL_H
+/* epoll data for the self-pipe; sockets use their generation and id */
+#define W5100_EPOLL_SELFPIPE 0
+#define W5100_EPOLL_DATA( generation, id ) \
+  ( ( (libspectrum_qword)(generation) << 8 ) | ( (id) + 1 ) )
+#define W5100_EPOLL_ID( data ) ( (int)( (data) & 0xff ) - 1 )
+#define W5100_EPOLL_GENERATION( data ) ( (unsigned)( (data) >> 8 ) )
+
+void nic_w5100_socket_update_epoll( nic_w5100_socket_t *socket, int epoll_fd );
+void nic_w5100_socket_process_events( nic_w5100_socket_t *socket,
+  unsigned generation, libspectrum_dword events );
+#endif
+
 /* Debug routines */
 
 /* Define this to spew debugging info to stdout */
@@ -59,16 +59,19 @@ static void
 w5100_socket_init_common( nic_w5100_socket_t *socket )
 {
   socket->fd = compat_socket_invalid;
+  socket->generation++;
   socket->bind_count = 0;
   socket->socket_bound = 0;
   socket->ok_for_io = 0;
-  socket->write_pending = 0;
 }
 
 void
 nic_w5100_socket_init( nic_w5100_socket_t *socket, int which )
 {
   socket->id = which;
+  socket->generation = 0;
+  socket->registered_generation = 0;
+  socket->registered_events = -1;
   w5100_socket_init_common( socket );
   pthread_mutex_init( &socket->lock, NULL );
 }
@@ -109,12 +112,12 @@ w5100_socket_clean( nic_w5100_socket_t *socket )
   memset( socket->port, 0, sizeof( socket->port ) );
   memset( socket->dip, 0, sizeof( socket->dip ) );
   memset( socket->dport, 0, sizeof( socket->dport ) );
-  socket->tx_rr = socket->tx_wr = 0;
-  socket->rx_rsr = 0;
+  socket->tx_rr = socket->tx_wr = socket->tx_end = 0;
+  socket->rx_wr = 0;
   socket->old_rx_rd = socket->rx_rd = 0;
 
   socket->last_send = 0;
-  socket->datagram_count = 0;
+  socket->datagram_head = socket->datagram_tail = 0;
 
   if( socket->fd != compat_socket_invalid ) {
     compat_socket_close( socket->fd );
@@ -193,6 +196,7 @@ w5100_socket_open( nic_w5100_socket_t *socket_obj )
     w5100_socket_clean( socket_obj );
 
     socket_obj->fd = socket( AF_INET, type, protocol );
+    socket_obj->generation++;
     if( socket_obj->fd == compat_socket_invalid ) {
       nic_w5100_error( UI_ERROR_ERROR,
         "w5100: failed to open %s socket for socket %d; errno %d: %s\n",
@@ -235,7 +239,7 @@ w5100_socket_bind_port( nic_w5100_t *self, nic_w5100_socket_t *socket )
                      socket->id, compat_socket_get_error(),
                      compat_socket_get_strerror() );
 
-    socket->ir |= 1 << 3;
+    w5100_or( socket->ir, 1 << 3 );
     socket->state = W5100_SOCKET_STATE_CLOSED;
     return -1;
   }
@@ -292,12 +296,12 @@ w5100_socket_connect( nic_w5100_t *self, nic_w5100_socket_t *socket )
         socket->id, ntohl(sa.sin_addr.s_addr), ntohs(sa.sin_port),
         compat_socket_get_error(), compat_socket_get_strerror() );
 
-      socket->ir |= 1 << 3;
+      w5100_or( socket->ir, 1 << 3 );
       socket->state = W5100_SOCKET_STATE_CLOSED;
       return;
     }
 
-    socket->ir |= 1 << 0;
+    w5100_or( socket->ir, 1 << 0 );
     socket->state = W5100_SOCKET_STATE_ESTABLISHED;
   }
 }
@@ -307,7 +311,7 @@ w5100_socket_discon( nic_w5100_t *self, nic_w5100_socket_t *socket )
 {
   if( socket->state == W5100_SOCKET_STATE_ESTABLISHED ||
     socket->state == W5100_SOCKET_STATE_CLOSE_WAIT ) {
-    socket->ir |= 1 << 1;
+    w5100_or( socket->ir, 1 << 1 );
     socket->state = W5100_SOCKET_STATE_CLOSED;
     compat_socket_selfpipe_wake( self->selfpipe );
 
@@ -321,6 +325,7 @@ w5100_socket_close( nic_w5100_t *self, nic_w5100_socket_t *socket )
   if( socket->fd != compat_socket_invalid ) {
     compat_socket_close( socket->fd );
     socket->fd = compat_socket_invalid;
+    socket->generation++;
     socket->socket_bound = 0;
     socket->ok_for_io = 0;
     socket->state = W5100_SOCKET_STATE_CLOSED;
@@ -329,36 +334,56 @@ w5100_socket_close( nic_w5100_t *self, nic_w5100_socket_t *socket )
   }
 }
 
+/* Called without the socket's lock held */
 static void
 w5100_socket_send( nic_w5100_t *self, nic_w5100_socket_t *socket )
 {
-  if( socket->state == W5100_SOCKET_STATE_UDP ) {
+  w5100_socket_state state = w5100_load( socket->state );
 
-    if( !socket->socket_bound )
-      if( w5100_socket_bind_port( self, socket ) )
-        return;
+  if( state == W5100_SOCKET_STATE_UDP ) {
+    w5100_datagram_t *datagram;
+
+    if( !socket->socket_bound ) {
+      int error;
+
+      w5100_socket_acquire_lock( socket );
+      error = w5100_socket_bind_port( self, socket );
+      w5100_socket_release_lock( socket );
+      if( error ) return;
+    }
 
-    socket->datagram_lengths[socket->datagram_count++] =
-      socket->tx_wr - socket->last_send;
+    if( socket->datagram_head - w5100_load( socket->datagram_tail ) >=
+        W5100_DATAGRAMS ) {
+      nic_w5100_debug( "w5100: too many datagrams queued on socket %d\n",
+                       socket->id );
+      return;
+    }
+
+    datagram = &socket->datagrams[ socket->datagram_head % W5100_DATAGRAMS ];
+    datagram->length = (libspectrum_word)( socket->tx_wr - socket->last_send );
+    memcpy( datagram->dip, socket->dip, sizeof( datagram->dip ) );
+    memcpy( datagram->dport, socket->dport, sizeof( datagram->dport ) );
     socket->last_send = socket->tx_wr;
-    socket->write_pending = 1;
+    w5100_store( socket->datagram_head, socket->datagram_head + 1 );
     compat_socket_selfpipe_wake( self->selfpipe );
   }
-  else if( socket->state == W5100_SOCKET_STATE_ESTABLISHED ) {
-    socket->write_pending = 1;
+  else if( state == W5100_SOCKET_STATE_ESTABLISHED ) {
+    w5100_store( socket->tx_end, socket->tx_wr );
     compat_socket_selfpipe_wake( self->selfpipe );
   }
 }
 
+/* Called without the socket's lock held */
 static void
 w5100_socket_recv( nic_w5100_t *self, nic_w5100_socket_t *socket )
 {
-  if( socket->state == W5100_SOCKET_STATE_UDP ||
-    socket->state == W5100_SOCKET_STATE_ESTABLISHED ) {
-    socket->rx_rsr -= socket->rx_rd - socket->old_rx_rd;
-    socket->old_rx_rd = socket->rx_rd;
-    if( socket->rx_rsr != 0 )
-      socket->ir |= 1 << 2;
+  w5100_socket_state state = w5100_load( socket->state );
+
+  if( state == W5100_SOCKET_STATE_UDP ||
+    state == W5100_SOCKET_STATE_ESTABLISHED ) {
+    w5100_store( socket->old_rx_rd, socket->rx_rd );
+    if( w5100_load( socket->rx_wr ) != socket->rx_rd )
+      w5100_or( socket->ir, 1 << 2 );
     compat_socket_selfpipe_wake( self->selfpipe );
   }
 }
@@ -368,6 +393,19 @@ w5100_write_socket_cr( nic_w5100_t *self, nic_w5100_socket_t *socket, libspectru
 {
   nic_w5100_debug( "w5100: writing 0x%02x to S%d_CR\n", b, socket->id );
 
+  /* Sending and receiving happen far more often than the other commands,
+     and don't need to wait for the I/O thread */
+  if( b == W5100_SOCKET_COMMAND_SEND ) {
+    w5100_socket_send( self, socket );
+    return;
+  }
+  else if( b == W5100_SOCKET_COMMAND_RECV ) {
+    w5100_socket_recv( self, socket );
+    return;
+  }
+
+  w5100_socket_acquire_lock( socket );
+
   switch( b ) {
     case W5100_SOCKET_COMMAND_OPEN:
       w5100_socket_open( socket );
@@ -384,16 +422,12 @@ w5100_write_socket_cr( nic_w5100_t *self, nic_w5100_socket_t *socket, libspectru
     case W5100_SOCKET_COMMAND_CLOSE:
       w5100_socket_close( self, socket );
       break;
-    case W5100_SOCKET_COMMAND_SEND:
-      w5100_socket_send( self, socket );
-      break;
-    case W5100_SOCKET_COMMAND_RECV:
-      w5100_socket_recv( self, socket );
-      break;
     default:
       ui_error( UI_ERROR_WARNING, "w5100: unknown command 0x%02x sent to socket %d\n", b, socket->id );
       break;
   }
+
+  w5100_socket_release_lock( socket );
 }
 
 static void
@@ -402,8 +436,15 @@ w5100_write_socket_port( nic_w5100_t *self, nic_w5100_socket_t *socket, int whic
   nic_w5100_debug( "w5100: writing 0x%02x to S%d_PORT%d\n", b, socket->id, which );
   socket->port[which] = b;
   if( ++socket->bind_count == 2 ) {
-    if( socket->state == W5100_SOCKET_STATE_UDP && !socket->socket_bound ) {
-      if( w5100_socket_bind_port( self, socket ) ) {
+    if( w5100_load( socket->state ) == W5100_SOCKET_STATE_UDP &&
+        !socket->socket_bound ) {
+      int error;
+
+      w5100_socket_acquire_lock( socket );
+      error = w5100_socket_bind_port( self, socket );
+      w5100_socket_release_lock( socket );
+
+      if( error ) {
         socket->bind_count = 0;
         return;
       }
@@ -419,22 +460,20 @@ nic_w5100_socket_read( nic_w5100_t *self, libspectrum_word reg )
   nic_w5100_socket_t *socket = &self->socket[(reg >> 8) - 4];
   int socket_reg = reg & 0xff;
   int reg_offset;
-  libspectrum_word fsr;
+  libspectrum_word fsr, rsr;
   libspectrum_byte b;
 
-  w5100_socket_acquire_lock( socket );
-
   switch( socket_reg ) {
     case W5100_SOCKET_MR:
       b = socket->mode;
       nic_w5100_debug( "w5100: reading 0x%02x from S%d_MR\n", b, socket->id );
       break;
     case W5100_SOCKET_IR:
-      b = socket->ir;
+      b = w5100_load( socket->ir );
       nic_w5100_debug( "w5100: reading 0x%02x from S%d_IR\n", b, socket->id );
       break;
     case W5100_SOCKET_SR:
-      b = socket->state;
+      b = w5100_load( socket->state );
       nic_w5100_debug( "w5100: reading 0x%02x from S%d_SR\n", b, socket->id );
       break;
     case W5100_SOCKET_PORT0: case W5100_SOCKET_PORT1:
@@ -443,13 +482,13 @@ nic_w5100_socket_read( nic_w5100_t *self, libspectrum_word reg )
       break;
     case W5100_SOCKET_TX_FSR0: case W5100_SOCKET_TX_FSR1:
       reg_offset = socket_reg - W5100_SOCKET_TX_FSR0;
-      fsr = 0x0800 - (socket->tx_wr - socket->tx_rr);
+      fsr = 0x0800 - (socket->tx_wr - w5100_load( socket->tx_rr ));
       b = ( fsr >> ( 8 * ( 1 - reg_offset ) ) ) & 0xff;
       nic_w5100_debug( "w5100: reading 0x%02x from S%d_TX_FSR%d\n", b, socket->id, reg_offset );
       break;
     case W5100_SOCKET_TX_RR0: case W5100_SOCKET_TX_RR1:
       reg_offset = socket_reg - W5100_SOCKET_TX_RR0;
-      b = ( socket->tx_rr >> ( 8 * ( 1 - reg_offset ) ) ) & 0xff;
+      b = ( w5100_load( socket->tx_rr ) >> ( 8 * ( 1 - reg_offset ) ) ) & 0xff;
       nic_w5100_debug( "w5100: reading 0x%02x from S%d_TX_RR%d\n", b, socket->id, reg_offset );
       break;
     case W5100_SOCKET_TX_WR0: case W5100_SOCKET_TX_WR1:
@@ -459,7 +498,8 @@ nic_w5100_socket_read( nic_w5100_t *self, libspectrum_word reg )
       break;
     case W5100_SOCKET_RX_RSR0: case W5100_SOCKET_RX_RSR1:
       reg_offset = socket_reg - W5100_SOCKET_RX_RSR0;
-      b = ( socket->rx_rsr >> ( 8 * ( 1 - reg_offset ) ) ) & 0xff;
+      rsr = w5100_load( socket->rx_wr ) - socket->old_rx_rd;
+      b = ( rsr >> ( 8 * ( 1 - reg_offset ) ) ) & 0xff;
       nic_w5100_debug( "w5100: reading 0x%02x from S%d_RX_RSR%d\n", b, socket->id, reg_offset );
       break;
     case W5100_SOCKET_RX_RD0: case W5100_SOCKET_RX_RD1:
@@ -473,8 +513,6 @@ nic_w5100_socket_read( nic_w5100_t *self, libspectrum_word reg )
       break;
   }
 
-  w5100_socket_release_lock( socket );
-
   return b;
 }
 
@@ -484,8 +522,6 @@ nic_w5100_socket_write( nic_w5100_t *self, libspectrum_word reg, libspectrum_byt
   nic_w5100_socket_t *socket = &self->socket[(reg >> 8) - 4];
   int socket_reg = reg & 0xff;
 
-  w5100_socket_acquire_lock( socket );
-
   switch( socket_reg ) {
     case W5100_SOCKET_MR:
       w5100_write_socket_mr( socket, b );
@@ -495,7 +531,7 @@ nic_w5100_socket_write( nic_w5100_t *self, libspectrum_word reg, libspectrum_byt
       break;
     case W5100_SOCKET_IR:
       nic_w5100_debug( "w5100: writing 0x%02x to S%d_IR\n", b, socket->id );
-      socket->ir &= ~b;
+      w5100_and( socket->ir, ~b );
       break;
     case W5100_SOCKET_PORT0: case W5100_SOCKET_PORT1:
       w5100_write_socket_port( self, socket, socket_reg - W5100_SOCKET_PORT0, b );
@@ -531,8 +567,6 @@ nic_w5100_socket_write( nic_w5100_t *self, libspectrum_word reg, libspectrum_byt
 
   if( socket_reg != W5100_SOCKET_PORT0 && socket_reg != W5100_SOCKET_PORT1 )
     socket->bind_count = 0;
-
-  w5100_socket_release_lock( socket );
 }
 
 libspectrum_byte
@@ -554,35 +588,62 @@ nic_w5100_socket_write_tx_buffer( nic_w5100_t *self, libspectrum_word reg, libsp
   socket->tx_buffer[offset] = b;
 }
 
+/* Work out what the I/O thread should wait for on this socket. Called with
+   the socket's lock held */
+static void
+w5100_socket_io_wanted( nic_w5100_socket_t *socket, int *read, int *write )
+{
+  libspectrum_word rx_free;
+
+  *read = *write = 0;
+
+  if( socket->fd == compat_socket_invalid ) return;
+
+  rx_free = 0x800 - (libspectrum_word)( socket->rx_wr -
+                                        w5100_load( socket->old_rx_rd ) );
+
+  switch( socket->state ) {
+    case W5100_SOCKET_STATE_UDP:
+      /* We can process a UDP read if there are at least 9 bytes free in our
+         buffer (8 byte UDP header and 1 byte of actual data) */
+      *read = rx_free >= 9;
+      *write = w5100_load( socket->datagram_head ) != socket->datagram_tail;
+      break;
+    case W5100_SOCKET_STATE_ESTABLISHED:
+      /* We can process a TCP read if we have any room in our buffer (no
+         header necessary for TCP) */
+      *read = rx_free >= 1;
+      *write = w5100_load( socket->tx_end ) != socket->tx_rr;
+      break;
+    case W5100_SOCKET_STATE_LISTEN:
+      *read = 1;
+      break;
+    default:
+      break;
+  }
+}
+
 void
 nic_w5100_socket_add_to_sets( nic_w5100_socket_t *socket, fd_set *readfds,
   fd_set *writefds, int *max_fd )
 {
+  int read, write;
+
   w5100_socket_acquire_lock( socket );
 
   if( socket->fd != compat_socket_invalid ) {
-    /* We can process a UDP read if we're in a UDP state and there are at least
-       9 bytes free in our buffer (8 byte UDP header and 1 byte of actual
-       data). */
-    int udp_read = socket->state == W5100_SOCKET_STATE_UDP &&
-      0x800 - socket->rx_rsr >= 9;
-    /* We can process a TCP read if we're in the established state and have
-       any room in our buffer (no header necessary for TCP). */
-    int tcp_read = socket->state == W5100_SOCKET_STATE_ESTABLISHED &&
-      0x800 - socket->rx_rsr >= 1;
-
-    int tcp_listen = socket->state == W5100_SOCKET_STATE_LISTEN;
+    w5100_socket_io_wanted( socket, &read, &write );
 
     socket->ok_for_io = 1;
 
-    if( udp_read || tcp_read || tcp_listen ) {
+    if( read ) {
       FD_SET( socket->fd, readfds );
       if( socket->fd > *max_fd )
         *max_fd = socket->fd;
       nic_w5100_debug( "w5100: checking for read on socket %d with fd %d; max fd %d\n", socket->id, socket->fd, *max_fd );
     }
 
-    if( socket->write_pending ) {
+    if( write ) {
       FD_SET( socket->fd, writefds );
       if( socket->fd > *max_fd )
         *max_fd = socket->fd;
@@ -616,14 +677,16 @@ w5100_socket_process_accept( nic_w5100_socket_t *socket )
     nic_w5100_debug( "w5100: error attempting to close fd %d for socket %d\n", socket->fd, socket->id );
 
   socket->fd = new_fd;
-  socket->state = W5100_SOCKET_STATE_ESTABLISHED;
+  socket->generation++;
+  w5100_store( socket->state, W5100_SOCKET_STATE_ESTABLISHED );
 }
 
 static void
 w5100_socket_process_read( nic_w5100_socket_t *socket )
 {
   libspectrum_byte buffer[0x800];
-  int bytes_free = 0x800 - socket->rx_rsr;
+  int bytes_free = 0x800 - (libspectrum_word)( socket->rx_wr -
+                                               w5100_load( socket->old_rx_rd ) );
   ssize_t bytes_read;
   struct sockaddr_in sa;
 
@@ -643,7 +706,7 @@ w5100_socket_process_read( nic_w5100_socket_t *socket )
   nic_w5100_debug( "w5100: read 0x%03x bytes from %s socket %d\n", (int)bytes_read, description, socket->id );
 
   if( bytes_read > 0 || (udp && bytes_read == 0) ) {
-    int offset = (socket->old_rx_rd + socket->rx_rsr) & 0x7ff;
+    int offset = socket->rx_wr & 0x7ff;
     libspectrum_byte *dest = &socket->rx_buffer[offset];
 
     if( udp ) {
@@ -655,9 +718,6 @@ w5100_socket_process_read( nic_w5100_socket_t *socket )
       bytes_read += 8;
     }
 
-    socket->rx_rsr += bytes_read;
-    socket->ir |= 1 << 2;
-
     if( offset + bytes_read <= 0x800 ) {
       memcpy( dest, buffer, bytes_read );
     }
@@ -666,9 +726,13 @@ w5100_socket_process_read( nic_w5100_socket_t *socket )
       memcpy( dest, buffer, first_chunk );
       memcpy( socket->rx_buffer, buffer + first_chunk, bytes_read - first_chunk );
     }
+
+    /* Make the data visible to the emulation only once it's all there */
+    w5100_store( socket->rx_wr, socket->rx_wr + bytes_read );
+    w5100_or( socket->ir, 1 << 2 );
   }
   else if( bytes_read == 0 ) {  /* TCP */
-    socket->state = W5100_SOCKET_STATE_CLOSE_WAIT;
+    w5100_store( socket->state, W5100_SOCKET_STATE_CLOSE_WAIT );
     nic_w5100_debug( "w5100: EOF on %s socket %d; errno %d: %s\n",
                      description, socket->id, compat_socket_get_error(),
                      compat_socket_get_strerror() );
@@ -685,7 +749,9 @@ w5100_socket_process_udp_write( nic_w5100_socket_t *socket )
 {
   ssize_t bytes_sent;
   int offset = socket->tx_rr & 0x7ff;
-  libspectrum_word length = socket->datagram_lengths[0];
+  w5100_datagram_t *datagram =
+    &socket->datagrams[ socket->datagram_tail % W5100_DATAGRAMS ];
+  libspectrum_word length = datagram->length;
   libspectrum_byte *data = &socket->tx_buffer[ offset ];
   struct sockaddr_in sa;
   libspectrum_byte buffer[0x800];
@@ -703,23 +769,18 @@ w5100_socket_process_udp_write( nic_w5100_socket_t *socket )
 
   memset( &sa, 0, sizeof(sa) );
   sa.sin_family = AF_INET;
-  memcpy( &sa.sin_port, socket->dport, 2 );
-  memcpy( &sa.sin_addr.s_addr, socket->dip, 4 );
+  memcpy( &sa.sin_port, datagram->dport, 2 );
+  memcpy( &sa.sin_addr.s_addr, datagram->dip, 4 );
 
   bytes_sent = sendto( socket->fd, (const char*)data, length, 0, (struct sockaddr*)&sa, sizeof(sa) );
   nic_w5100_debug( "w5100: sent 0x%03x bytes of 0x%03x to UDP socket %d\n",
                    (int)bytes_sent, length, socket->id );
 
   if( bytes_sent == length ) {
-    if( --socket->datagram_count )
-      memmove( socket->datagram_lengths, &socket->datagram_lengths[1],
-        0x1f * sizeof(int) );
-
-    socket->tx_rr += bytes_sent;
-    if( socket->datagram_count == 0 ) {
-      socket->write_pending = 0;
-      socket->ir |= 1 << 4;
-    }
+    w5100_store( socket->tx_rr, socket->tx_rr + bytes_sent );
+    w5100_store( socket->datagram_tail, socket->datagram_tail + 1 );
+    if( socket->datagram_tail == w5100_load( socket->datagram_head ) )
+      w5100_or( socket->ir, 1 << 4 );
   }
   else if( bytes_sent != -1 )
     nic_w5100_debug( "w5100: didn't manage to send full datagram to UDP socket %d?\n", socket->id );
@@ -734,7 +795,8 @@ w5100_socket_process_tcp_write( nic_w5100_socket_t *socket )
 {
   ssize_t bytes_sent;
   int offset = socket->tx_rr & 0x7ff;
-  libspectrum_word length = socket->tx_wr - socket->tx_rr;
+  libspectrum_word tx_end = w5100_load( socket->tx_end );
+  libspectrum_word length = tx_end - socket->tx_rr;
   libspectrum_byte *data = &socket->tx_buffer[ offset ];
 
   nic_w5100_debug( "w5100: writing to TCP socket %d\n", socket->id );
@@ -748,11 +810,9 @@ w5100_socket_process_tcp_write( nic_w5100_socket_t *socket )
                    (int)bytes_sent, length, socket->id );
 
   if( bytes_sent != -1 ) {
-    socket->tx_rr += bytes_sent;
-    if( socket->tx_rr == socket->tx_wr ) {
-      socket->write_pending = 0;
-      socket->ir |= 1 << 4;
-    }
+    w5100_store( socket->tx_rr, socket->tx_rr + bytes_sent );
+    if( socket->tx_rr == tx_end )
+      w5100_or( socket->ir, 1 << 4 );
   }
   else
     nic_w5100_debug( "w5100: error %d writing to TCP socket %d: %s\n",
@@ -760,6 +820,28 @@ w5100_socket_process_tcp_write( nic_w5100_socket_t *socket )
                      compat_socket_get_strerror() );
 }
 
+/* Do whatever I/O the host socket is ready for. Called with the socket's
+   lock held */
+static void
+w5100_socket_do_io( nic_w5100_socket_t *socket, int readable, int writable )
+{
+  if( readable ) {
+    if( socket->state == W5100_SOCKET_STATE_LISTEN )
+      w5100_socket_process_accept( socket );
+    else
+      w5100_socket_process_read( socket );
+  }
+
+  if( writable ) {
+    if( socket->state == W5100_SOCKET_STATE_UDP ) {
+      w5100_socket_process_udp_write( socket );
+    }
+    else if( socket->state == W5100_SOCKET_STATE_ESTABLISHED ) {
+      w5100_socket_process_tcp_write( socket );
+    }
+  }
+}
+
 void
 nic_w5100_socket_process_io( nic_w5100_socket_t *socket, fd_set readfds,
   fd_set writefds )
@@ -768,23 +850,87 @@ nic_w5100_socket_process_io( nic_w5100_socket_t *socket, fd_set readfds,
 
   /* Process only if we're an open socket, and we haven't been closed and
      re-opened since the select() started */
-  if( socket->fd != compat_socket_invalid && socket->ok_for_io ) {
-    if( FD_ISSET( socket->fd, &readfds ) ) {
-      if( socket->state == W5100_SOCKET_STATE_LISTEN )
-        w5100_socket_process_accept( socket );
-      else
-        w5100_socket_process_read( socket );
-    }
+  if( socket->fd != compat_socket_invalid && socket->ok_for_io )
+    w5100_socket_do_io( socket, FD_ISSET( socket->fd, &readfds ),
+                        FD_ISSET( socket->fd, &writefds ) );
 
-    if( FD_ISSET( socket->fd, &writefds ) ) {
-      if( socket->state == W5100_SOCKET_STATE_UDP ) {
-        w5100_socket_process_udp_write( socket );
-      }
-      else if( socket->state == W5100_SOCKET_STATE_ESTABLISHED ) {
-        w5100_socket_process_tcp_write( socket );
-      }
-    }
+  w5100_socket_release_lock( socket );
+}
+
+#ifdef HAVE_SYS_EPOLL_H
+
+/* Bring what epoll waits for on this socket up to date. Only the I/O
+   thread calls this, and epoll_ctl() is called only when something has
+   changed */
+void
+nic_w5100_socket_update_epoll( nic_w5100_socket_t *socket, int epoll_fd )
+{
+  struct epoll_event event;
+  int read, write, events, op;
+
+  w5100_socket_acquire_lock( socket );
+
+  w5100_socket_io_wanted( socket, &read, &write );
+  events = ( read ? EPOLLIN : 0 ) | ( write ? EPOLLOUT : 0 );
+
+  /* A host socket which has been closed has already left the set */
+  if( socket->registered_events != -1 &&
+      socket->registered_generation != socket->generation ) {
+    socket->registered_events = -1;
+  }
+
+  if( events == socket->registered_events ||
+      ( !events && socket->registered_events == -1 ) ) {
+    w5100_socket_release_lock( socket );
+    return;
+  }
+
+  memset( &event, 0, sizeof( event ) );
+  event.events = events;
+  event.data.u64 = W5100_EPOLL_DATA( socket->generation, socket->id );
+
+  /* Sockets with nothing to wait for are taken out of the set entirely so
+     that hangups and errors don't wake the thread until there's something
+     to do about them */
+  if( !events ) {
+    op = EPOLL_CTL_DEL;
+  } else if( socket->registered_events == -1 ) {
+    op = EPOLL_CTL_ADD;
+  } else {
+    op = EPOLL_CTL_MOD;
+  }
+
+  if( epoll_ctl( epoll_fd, op, socket->fd, &event ) == -1 ) {
+    nic_w5100_debug( "w5100: epoll_ctl %d failed for socket %d; errno %d: %s\n",
+                     op, socket->id, compat_socket_get_error(),
+                     compat_socket_get_strerror() );
+    socket->registered_events = -1;
+  } else {
+    socket->registered_generation = socket->generation;
+    socket->registered_events = events ? events : -1;
   }
 
   w5100_socket_release_lock( socket );
 }
+
+void
+nic_w5100_socket_process_events( nic_w5100_socket_t *socket,
+  unsigned generation, libspectrum_dword events )
+{
+  int read, write;
+
+  w5100_socket_acquire_lock( socket );
+
+  /* Skip events for a host socket which has been closed since, and
+     anything which is no longer wanted */
+  if( generation == socket->generation ) {
+    w5100_socket_io_wanted( socket, &read, &write );
+    w5100_socket_do_io( socket,
+                        read && ( events & ( EPOLLIN | EPOLLHUP | EPOLLERR ) ),
+                        write && ( events & ( EPOLLOUT | EPOLLERR ) ) );
+  }
+
+  w5100_socket_release_lock( socket );
+}
+
+#endif				/* #ifdef HAVE_SYS_EPOLL_H */
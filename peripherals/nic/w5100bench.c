@@ -0,0 +1,270 @@
+/* w5100bench.c: Loopback throughput benchmark for the W5100 emulation
+   Copyright (c) 2026 Fuse contributors
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+   Author contact information:
+
+   E-mail: philip-fuse@shadowmagic.org.uk
+
+*/
+
+/* Sends data through a W5100 TCP socket to an echo server on the loopback
+   interface and reads it back, a byte at a time through the registers as
+   the Spectranet ROM does, and reports how many bytes a second made the
+   round trip */
+
+#include <config.h>
+
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include "compat.h"
+#include "fuse.h"
+#include "ui/ui.h"
+#include "w5100.h"
+
+/* The registers used, all for socket 0 */
+enum {
+  W5100_SIPR0 = 0x00f,
+
+  W5100_S0_MR = 0x400,
+  W5100_S0_CR = 0x401,
+  W5100_S0_SR = 0x403,
+  W5100_S0_DIPR0 = 0x40c,
+  W5100_S0_DPORT0 = 0x410,
+  W5100_S0_TX_FSR0 = 0x420,
+  W5100_S0_TX_WR0 = 0x424,
+  W5100_S0_RX_RSR0 = 0x426,
+  W5100_S0_RX_RD0 = 0x428,
+
+  W5100_S0_TX_BUFFER = 0x4000,
+  W5100_S0_RX_BUFFER = 0x6000,
+};
+
+enum {
+  COMMAND_OPEN = 0x01,
+  COMMAND_CONNECT = 0x04,
+  COMMAND_CLOSE = 0x10,
+  COMMAND_SEND = 0x20,
+  COMMAND_RECV = 0x40,
+};
+
+#define STATE_ESTABLISHED 0x17
+
+/* Give up if the data hasn't all come back after this many seconds */
+#define TIMEOUT 60
+
+static int listen_fd;
+
+static void*
+echo_thread( void *arg GCC_UNUSED )
+{
+  char buffer[0x1000];
+  ssize_t length, sent, n;
+  int fd;
+
+  fd = accept( listen_fd, NULL, NULL );
+  if( fd == -1 ) {
+    perror( "w5100bench: accept" );
+    exit( 1 );
+  }
+
+  while( ( length = recv( fd, buffer, sizeof( buffer ), 0 ) ) > 0 ) {
+    for( sent = 0; sent < length; sent += n ) {
+      n = send( fd, buffer + sent, length - sent, 0 );
+      if( n == -1 ) {
+        perror( "w5100bench: send" );
+        exit( 1 );
+      }
+    }
+  }
+
+  close( fd );
+
+  return NULL;
+}
+
+/* Start the echo server, returning the port it's listening on */
+static int
+start_echo_server( pthread_t *thread )
+{
+  struct sockaddr_in sa;
+  socklen_t sa_length = sizeof( sa );
+  int error;
+
+  listen_fd = socket( AF_INET, SOCK_STREAM, IPPROTO_TCP );
+  if( listen_fd == -1 ) {
+    perror( "w5100bench: socket" );
+    exit( 1 );
+  }
+
+  memset( &sa, 0, sizeof( sa ) );
+  sa.sin_family = AF_INET;
+  sa.sin_addr.s_addr = htonl( INADDR_LOOPBACK );
+  sa.sin_port = 0;
+
+  if( bind( listen_fd, (struct sockaddr*)&sa, sizeof( sa ) ) == -1 ||
+      listen( listen_fd, 1 ) == -1 ||
+      getsockname( listen_fd, (struct sockaddr*)&sa, &sa_length ) == -1 ) {
+    perror( "w5100bench: listen" );
+    exit( 1 );
+  }
+
+  error = pthread_create( thread, NULL, echo_thread, NULL );
+  if( error ) {
+    fprintf( stderr, "w5100bench: error %d creating thread\n", error );
+    exit( 1 );
+  }
+
+  return ntohs( sa.sin_port );
+}
+
+static libspectrum_word
+read_word( nic_w5100_t *w5100, libspectrum_word reg )
+{
+  return ( nic_w5100_read( w5100, reg ) << 8 ) |
+           nic_w5100_read( w5100, reg + 1 );
+}
+
+static void
+write_word( nic_w5100_t *w5100, libspectrum_word reg, libspectrum_word w )
+{
+  nic_w5100_write( w5100, reg, w >> 8 );
+  nic_w5100_write( w5100, reg + 1, w & 0xff );
+}
+
+/* What the nth byte sent should be */
+static libspectrum_byte
+pattern( size_t n )
+{
+  return ( n * 7 ) ^ ( n >> 11 );
+}
+
+int
+main( int argc, char **argv )
+{
+  nic_w5100_t *w5100;
+  pthread_t thread;
+  size_t total, sent, received, free_space, size, i;
+  libspectrum_word tx_wr, rx_rd;
+  double start, elapsed;
+  int port;
+
+  total = ( argc > 1 ? atoi( argv[1] ) : 16 ) * 1024 * 1024;
+
+  port = start_echo_server( &thread );
+
+  w5100 = nic_w5100_alloc();
+
+  nic_w5100_write( w5100, W5100_SIPR0, 127 );
+  nic_w5100_write( w5100, W5100_SIPR0 + 1, 0 );
+  nic_w5100_write( w5100, W5100_SIPR0 + 2, 0 );
+  nic_w5100_write( w5100, W5100_SIPR0 + 3, 1 );
+
+  nic_w5100_write( w5100, W5100_S0_MR, 0x21 );
+  nic_w5100_write( w5100, W5100_S0_CR, COMMAND_OPEN );
+
+  nic_w5100_write( w5100, W5100_S0_DIPR0, 127 );
+  nic_w5100_write( w5100, W5100_S0_DIPR0 + 1, 0 );
+  nic_w5100_write( w5100, W5100_S0_DIPR0 + 2, 0 );
+  nic_w5100_write( w5100, W5100_S0_DIPR0 + 3, 1 );
+  write_word( w5100, W5100_S0_DPORT0, port );
+  nic_w5100_write( w5100, W5100_S0_CR, COMMAND_CONNECT );
+
+  if( nic_w5100_read( w5100, W5100_S0_SR ) != STATE_ESTABLISHED ) {
+    fprintf( stderr, "w5100bench: couldn't connect to port %d\n", port );
+    return 1;
+  }
+
+  tx_wr = read_word( w5100, W5100_S0_TX_WR0 );
+  rx_rd = read_word( w5100, W5100_S0_RX_RD0 );
+  sent = received = 0;
+
+  start = compat_timer_get_monotonic_time();
+
+  while( received < total ) {
+
+    free_space = read_word( w5100, W5100_S0_TX_FSR0 );
+    if( free_space > total - sent ) free_space = total - sent;
+    if( free_space ) {
+      for( i = 0; i < free_space; i++, tx_wr++ )
+        nic_w5100_write( w5100, W5100_S0_TX_BUFFER + ( tx_wr & 0x7ff ),
+                         pattern( sent++ ) );
+      write_word( w5100, W5100_S0_TX_WR0, tx_wr );
+      nic_w5100_write( w5100, W5100_S0_CR, COMMAND_SEND );
+    }
+
+    size = read_word( w5100, W5100_S0_RX_RSR0 );
+    if( size ) {
+      for( i = 0; i < size; i++, rx_rd++ ) {
+        if( nic_w5100_read( w5100, W5100_S0_RX_BUFFER + ( rx_rd & 0x7ff ) ) !=
+            pattern( received++ ) ) {
+          fprintf( stderr, "w5100bench: byte %lu came back wrong\n",
+                   (unsigned long)( received - 1 ) );
+          return 1;
+        }
+      }
+      write_word( w5100, W5100_S0_RX_RD0, rx_rd );
+      nic_w5100_write( w5100, W5100_S0_CR, COMMAND_RECV );
+    }
+
+    if( compat_timer_get_monotonic_time() - start > TIMEOUT ) {
+      fprintf( stderr, "w5100bench: timed out with %lu of %lu bytes back\n",
+               (unsigned long)received, (unsigned long)total );
+      return 1;
+    }
+  }
+
+  elapsed = compat_timer_get_monotonic_time() - start;
+
+  nic_w5100_write( w5100, W5100_S0_CR, COMMAND_CLOSE );
+  pthread_join( thread, NULL );
+  close( listen_fd );
+
+  nic_w5100_free( w5100 );
+
+  /* As a line of JSON, in the same form as from `fuse --benchmark' */
+  printf( "{ \"name\": \"w5100-echo\", \"metric\": \"bytes_per_second\", "
+          "\"value\": %.9g, \"unit\": \"bytes/s\" }\n", total / elapsed );
+
+  return 0;
+}
+
+void
+fuse_abort( void )
+{
+  abort();
+}
+
+int
+ui_error( ui_error_level severity GCC_UNUSED, const char *format, ... )
+{
+  va_list ap;
+
+  va_start( ap, format );
+  vfprintf( stderr, format, ap );
+  va_end( ap );
+
+  return 0;
+}
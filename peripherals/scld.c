@@ -54,6 +54,8 @@ memory_page timex_dock[MEMORY_PAGES_IN_64K];
 static void scld_reset( int hard_reset );
 static void scld_from_snapshot( libspectrum_snap *snap );
 static void scld_to_snapshot( libspectrum_snap *snap );
+static void scld_state_save( int slot );
+static void scld_state_restore( int slot );
 
 static module_info_t scld_module_info = {
 
@@ -62,6 +64,8 @@ static module_info_t scld_module_info = {
   /* .snapshot_enabled = */ NULL,
   /* .snapshot_from = */ scld_from_snapshot,
   /* .snapshot_to = */ scld_to_snapshot,
+  /* .state_save = */ scld_state_save,
+  /* .state_restore = */ scld_state_restore,
 
 };
 
@@ -330,6 +334,27 @@ scld_to_snapshot( libspectrum_snap *snap )
   }
 }
 
+static scld saved_last_dec[ MODULE_STATE_SLOTS ];
+static libspectrum_byte saved_last_hsr[ MODULE_STATE_SLOTS ];
+static memory_page *saved_home[ MODULE_STATE_SLOTS ][MEMORY_PAGES_IN_64K];
+
+static void
+scld_state_save( int slot )
+{
+  saved_last_dec[ slot ] = scld_last_dec;
+  saved_last_hsr[ slot ] = scld_last_hsr;
+  memcpy( saved_home[ slot ], timex_home, sizeof( timex_home ) );
+}
+
+/* The memory map itself is put back by memory_state_restore() */
+static void
+scld_state_restore( int slot )
+{
+  scld_last_dec = saved_last_dec[ slot ];
+  scld_last_hsr = saved_last_hsr[ slot ];
+  memcpy( timex_home, saved_home[ slot ], sizeof( timex_home ) );
+}
+
 /* Map 16K of memory and record default mapping for dock */
 void
 scld_home_map_16k( libspectrum_word address, memory_page source[],
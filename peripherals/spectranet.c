@@ -174,6 +174,10 @@ spectranet_reset( int hard_reset )
     return;
   }
 
+  /* The W5100 has a thread and sockets of its own, so only create it
+     once a Spectranet is actually used */
+  if( !w5100 ) w5100 = nic_w5100_alloc();
+
   spectranet_available = 1;
   spectranet_paged = !settings_current.spectranet_disable;
 
@@ -448,7 +452,6 @@ spectranet_init( void *context )
   periph_register_paging_events( event_type_string, &page_event,
 				 &unpage_event );
 
-  w5100 = nic_w5100_alloc();
   flash_rom = flash_am29f010_alloc();
 
   return 0;
@@ -458,6 +461,7 @@ static void
 spectranet_end( void )
 {
   nic_w5100_free( w5100 );
+  w5100 = NULL;
   flash_am29f010_free( flash_rom );
 }
 
@@ -58,6 +58,8 @@ static void ula_from_snapshot( libspectrum_snap *snap );
 static void ula_to_snapshot( libspectrum_snap *snap );
 static libspectrum_byte ula_read( libspectrum_word port, libspectrum_byte *attached );
 static void ula_write( libspectrum_word port, libspectrum_byte b );
+static void ula_state_save( int slot );
+static void ula_state_restore( int slot );
 
 static module_info_t ula_module_info = {
 
@@ -66,6 +68,8 @@ static module_info_t ula_module_info = {
   /* .snapshot_enabled = */ NULL,
   /* .snapshot_from = */ ula_from_snapshot,
   /* .snapshot_to = */ ula_to_snapshot,
+  /* .state_save = */ ula_state_save,
+  /* .state_restore = */ ula_state_restore,
 
 };
 
@@ -256,10 +260,27 @@ ula_to_snapshot( libspectrum_snap *snap )
   libspectrum_snap_set_issue2( snap, settings_current.issue2 );
 }  
 
+static libspectrum_byte saved_last_byte[ MODULE_STATE_SLOTS ];
+static libspectrum_byte saved_default_value[ MODULE_STATE_SLOTS ];
+
+static void
+ula_state_save( int slot )
+{
+  saved_last_byte[ slot ] = last_byte;
+  saved_default_value[ slot ] = ula_default_value;
+}
+
+static void
+ula_state_restore( int slot )
+{
+  last_byte = saved_last_byte[ slot ];
+  ula_default_value = saved_default_value[ slot ];
+}
+
 void
 ula_contend_port_early( libspectrum_word port )
 {
-  if( memory_map_read[ port >> MEMORY_PAGE_SIZE_LOGARITHM ].contended )
+  if( memory_read_contended( port ) )
     tstates += ula_contention_no_mreq[ tstates ];
    
   tstates++;
@@ -274,7 +295,7 @@ ula_contend_port_late( libspectrum_word port )
 
   } else {
 
-    if( memory_map_read[ port >> MEMORY_PAGE_SIZE_LOGARITHM ].contended ) {
+    if( memory_read_contended( port ) ) {
       tstates += ula_contention_no_mreq[ tstates ]; tstates++;
       tstates += ula_contention_no_mreq[ tstates ]; tstates++;
       tstates += ula_contention_no_mreq[ tstates ];
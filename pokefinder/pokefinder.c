@@ -32,8 +32,11 @@
 #include "pokefinder.h"
 #include "spectrum.h"
 
-libspectrum_byte pokefinder_possible[ MEMORY_PAGES_IN_16K * SPECTRUM_RAM_PAGES ][ MEMORY_PAGE_SIZE ];
-libspectrum_byte pokefinder_impossible[ MEMORY_PAGES_IN_16K * SPECTRUM_RAM_PAGES ][ MEMORY_PAGE_SIZE / 8 ];
+/* One entry for each of the current machine's RAM pages, reallocated by
+   pokefinder_clear() when the machine changes */
+libspectrum_byte ( *pokefinder_possible )[ MEMORY_PAGE_SIZE ];
+libspectrum_byte ( *pokefinder_impossible )[ MEMORY_PAGE_SIZE / 8 ];
+size_t pokefinder_pages;
 size_t pokefinder_count;
 
 void
@@ -42,9 +45,19 @@ pokefinder_clear( void )
   size_t page, max_page;
 
   max_page = MEMORY_PAGES_IN_16K * machine_current->ram.valid_pages;
+  if( max_page != pokefinder_pages ) {
+    libspectrum_free( pokefinder_possible );
+    libspectrum_free( pokefinder_impossible );
+    pokefinder_possible =
+      libspectrum_malloc_n( max_page, sizeof( *pokefinder_possible ) );
+    pokefinder_impossible =
+      libspectrum_malloc_n( max_page, sizeof( *pokefinder_impossible ) );
+    pokefinder_pages = max_page;
+  }
+
   pokefinder_count = 0;
-  for( page = 0; page < MEMORY_PAGES_IN_16K * SPECTRUM_RAM_PAGES; ++page )
-    if( page < max_page && memory_map_ram[page].writable ) {
+  for( page = 0; page < pokefinder_pages; ++page )
+    if( memory_map_ram[page].writable && memory_map_ram[page].page ) {
       pokefinder_count += MEMORY_PAGE_SIZE;
       memcpy( pokefinder_possible[page], memory_map_ram[page].page, MEMORY_PAGE_SIZE );
       memset( pokefinder_impossible[page], 0, MEMORY_PAGE_SIZE / 8 );
@@ -57,7 +70,7 @@ pokefinder_search( libspectrum_byte value )
 {
   size_t page, offset;
 
-  for( page = 0; page < MEMORY_PAGES_IN_16K * SPECTRUM_RAM_PAGES; page++ ) {
+  for( page = 0; page < pokefinder_pages; page++ ) {
     memory_page *mapping = &memory_map_ram[ page ];
 
     for( offset = 0; offset < MEMORY_PAGE_SIZE; offset++ ) {
@@ -78,7 +91,7 @@ pokefinder_incremented( void )
 {
   size_t page, offset;
 
-  for( page = 0; page < MEMORY_PAGES_IN_16K * SPECTRUM_RAM_PAGES; page++ ) {
+  for( page = 0; page < pokefinder_pages; page++ ) {
     memory_page *mapping = &memory_map_ram[ page ];
 
     for( offset = 0; offset < MEMORY_PAGE_SIZE; offset++ ) {
@@ -102,7 +115,7 @@ pokefinder_decremented( void )
 {
   size_t page, offset;
 
-  for( page = 0; page < MEMORY_PAGES_IN_16K * SPECTRUM_RAM_PAGES; page++ ) {
+  for( page = 0; page < pokefinder_pages; page++ ) {
     memory_page *mapping = &memory_map_ram[ page ];
 
     for( offset = 0; offset < MEMORY_PAGE_SIZE; offset++ ) {
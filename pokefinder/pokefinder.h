@@ -26,8 +26,9 @@
 
 #include <libspectrum.h>
 
-extern libspectrum_byte pokefinder_possible[][ MEMORY_PAGE_SIZE ];
-extern libspectrum_byte pokefinder_impossible[][ MEMORY_PAGE_SIZE / 8 ];
+extern libspectrum_byte ( *pokefinder_possible )[ MEMORY_PAGE_SIZE ];
+extern libspectrum_byte ( *pokefinder_impossible )[ MEMORY_PAGE_SIZE / 8 ];
+extern size_t pokefinder_pages;	/* Entries in the two arrays above */
 extern size_t pokefinder_count;
 
 void pokefinder_clear( void );
@@ -32,6 +32,7 @@
 #include "pokemem.h"
 #include "spectrum.h"
 #include "utils.h"
+#include "z80/z80_cache.h"
 
 enum {
   POKEFILE_NEXT_TRAINER = 'N',
@@ -306,6 +307,12 @@ pokemem_poke_add( trainer_t *trainer, int bank, int address, int value,
     return NULL;
   }
 
+  /* RAM bank this machine doesn't have */
+  if( bank != 8 && ( bank < 0 || (size_t)bank >= memory_ram_pages() ) ) {
+    trainer->disabled = 1;
+    return NULL;
+  }
+
   if( value < 0 || value > 256 ) {
     trainer->disabled = 1;
     return NULL;
@@ -411,6 +418,7 @@ pokemem_poke_activate( gpointer data, gpointer user_data )
     address &= 0x3fff;
     poke->restore = RAM[ bank ][ address ];
     RAM[ bank ][ address ] = value;
+    z80_cache_flush();
   }
 }
 
@@ -439,6 +447,7 @@ pokemem_poke_deactivate( gpointer data, gpointer user_data GCC_UNUSED )
     writebyte_internal( address, value );
   } else {
     RAM[ bank ][ address & 0x3fff ] = value;
+    z80_cache_flush();
   }
 
 }
@@ -0,0 +1,169 @@
+/* runahead.c: run frames ahead to hide input latency
+   Copyright (c) 2026 Fuse contributors
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+   Author contact information:
+
+   E-mail: philip-fuse@shadowmagic.org.uk
+
+*/
+
+
+/* At the end of each real frame, the state of the machine is saved and
+   the emulation is run on for settings_current.run_ahead frames with the
+   input as it is now. The last of those frames is what is shown; the
+   machine is then put back and carries on, with the real frames drawn
+   but not shown. Sound comes only from the real frames */
+
+#include <config.h>
+
+#include <libspectrum.h>
+
+#include "compat.h"
+#include "debugger/debugger.h"
+#include "event.h"
+#include "export.h"
+#include "fuse.h"
+#include "module.h"
+#include "movie.h"
+#include "perfstats.h"
+#include "periph.h"
+#include "peripherals/dck.h"
+#include "phantom_typist.h"
+#include "profile.h"
+#include "psg.h"
+#include "runahead.h"
+#include "rzx.h"
+#include "settings.h"
+#include "tape.h"
+#include "z80/z80.h"
+
+int runahead_active = 0;
+int runahead_pending = 0;
+
+/* The state slot used to put the machine back */
+#define RUNAHEAD_STATE_SLOT 0
+
+/* How many frames have been run this time, how many are to be run, and
+   whether the last of them is to be shown */
+static int frames_run, frames_target, show_last;
+
+/* Peripherals which keep state of their own that is not saved, such as
+   paged ROMs or RAM, or which talk to the outside world */
+static const periph_type unsaved_peripherals[] = {
+  PERIPH_TYPE_BETA128,
+  PERIPH_TYPE_BETA128_PENTAGON,
+  PERIPH_TYPE_BETA128_PENTAGON_LATE,
+  PERIPH_TYPE_DIVIDE,
+  PERIPH_TYPE_DIVMMC,
+  PERIPH_TYPE_PLUSD,
+  PERIPH_TYPE_DIDAKTIK80,
+  PERIPH_TYPE_DISCIPLE,
+  PERIPH_TYPE_INTERFACE1,
+  PERIPH_TYPE_MULTIFACE_1,
+  PERIPH_TYPE_MULTIFACE_128,
+  PERIPH_TYPE_MULTIFACE_3,
+  PERIPH_TYPE_OPUS,
+  PERIPH_TYPE_SIMPLEIDE,
+  PERIPH_TYPE_SPECCYBOOT,
+  PERIPH_TYPE_SPECTRANET,
+  PERIPH_TYPE_UPD765,
+  PERIPH_TYPE_USOURCE,
+  PERIPH_TYPE_ZXATASP,
+  PERIPH_TYPE_ZXCF,
+  PERIPH_TYPE_ZXMMC,
+};
+
+int
+runahead_available( void )
+{
+  size_t i;
+
+  if( rzx_playback || rzx_recording || movie_recording || export_active ||
+      psg_recording || profile_active )
+    return 0;
+
+  if( debugger_mode != DEBUGGER_MODE_INACTIVE ) return 0;
+
+  if( tape_is_playing() || phantom_typist_is_active() ) return 0;
+
+  if( settings_current.printer || settings_current.writable_roms ||
+      dck_active )
+    return 0;
+
+  for( i = 0; i < ARRAY_SIZE( unsaved_peripherals ); i++ )
+    if( periph_is_active( unsaved_peripherals[i] ) ) return 0;
+
+  return 1;
+}
+
+void
+runahead_frame( void )
+{
+  if( runahead_active ) {
+    frames_run++;
+  } else if( settings_current.run_ahead ) {
+    runahead_pending = 1;
+  }
+}
+
+void
+runahead_emulate( int frames, int show )
+{
+  runahead_active = 1;
+  frames_run = 0;
+  frames_target = frames;
+  show_last = show;
+
+  while( frames_run < frames_target && !fuse_exiting ) {
+    z80_do_opcodes();
+    event_do_events();
+  }
+
+  runahead_active = 0;
+}
+
+void
+runahead_run( void )
+{
+  perfstats_stage stage;
+  int perfstats_was_active;
+
+  runahead_pending = 0;
+
+  if( !runahead_available() ) return;
+
+  /* The time taken is charged to its own stage, but nothing done while
+     running ahead is counted */
+  stage = perfstats_enter( PERFSTATS_STAGE_RUNAHEAD );
+  perfstats_was_active = perfstats_active;
+  perfstats_active = 0;
+
+  module_state_save( RUNAHEAD_STATE_SLOT );
+  runahead_emulate( settings_current.run_ahead, 1 );
+  module_state_restore( RUNAHEAD_STATE_SLOT );
+
+  perfstats_active = perfstats_was_active;
+  perfstats_enter( stage );
+}
+
+int
+runahead_frame_hidden( void )
+{
+  if( runahead_active ) return !show_last || frames_run + 1 < frames_target;
+
+  return settings_current.run_ahead > 0 && runahead_available();
+}
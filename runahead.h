@@ -0,0 +1,53 @@
+/* runahead.h: run frames ahead to hide input latency
+   Copyright (c) 2026 Fuse contributors
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+   Author contact information:
+
+   E-mail: philip-fuse@shadowmagic.org.uk
+
+*/
+
+
+#ifndef FUSE_RUNAHEAD_H
+#define FUSE_RUNAHEAD_H
+
+/* Set while frames are being run ahead and will be thrown away */
+extern int runahead_active;
+
+/* Set when a real frame has finished and frames should be run ahead
+   before the next one starts */
+extern int runahead_pending;
+
+/* Called at the end of each frame */
+void runahead_frame( void );
+
+/* Can the machine be saved, run on and put back as it is now? */
+int runahead_available( void );
+
+/* Run 'frames' frames without sound, host input or waiting for the timer,
+   showing only the last of them if 'show' is set; the frames are not
+   undone */
+void runahead_emulate( int frames, int show );
+
+/* Save the machine, run the configured number of frames, show the last of
+   them and then put the machine back */
+void runahead_run( void );
+
+/* Is the frame just finished one which should not be shown? */
+int runahead_frame_hidden( void );
+
+#endif			/* #ifndef FUSE_RUNAHEAD_H */
@@ -34,15 +34,19 @@
 #endif				/* #ifdef WIN32 */
 
 #include "debugger/debugger.h"
+#include "display.h"
 #include "event.h"
+#include "export.h"
 #include "fuse.h"
 #include "infrastructure/startup_manager.h"
 #include "machine.h"
 #include "movie.h"
 #include "peripherals/ula.h"
 #include "rzx.h"
+#include "rzx_stream.h"
 #include "settings.h"
 #include "snapshot.h"
+#include "sound.h"
 #include "timer/timer.h"
 #include "ui/ui.h"
 #include "utils.h"
@@ -74,6 +78,9 @@ int rzx_recording;
 /* Is the .rzx file being recorded in competition mode? */
 int rzx_competition_mode;
 
+/* Is the .rzx file being written to disk as it is recorded? */
+int rzx_streaming;
+
 /* The filename we'll save this recording into */
 static char *rzx_filename;
 
@@ -88,6 +95,30 @@ size_t rzx_instruction_count;
 /* The current RZX data */
 libspectrum_rzx *rzx;
 
+/* Are we currently fast-forwarding to a seek target? */
+int rzx_seeking;
+
+/* An entry in the seek index: an input recording block which can be
+   started from without replaying what came before it */
+typedef struct rzx_index_entry {
+  size_t frame;			/* The frame number at the start of the block */
+  int input_block;		/* The input recording block number */
+  libspectrum_snap *snap;	/* The state at the start of the block */
+} rzx_index_entry;
+
+/* The seek index for the file being played back */
+static GArray *playback_index;
+
+/* The state before the first frame, if the recording didn't embed one */
+static libspectrum_snap *initial_snap;
+
+/* The number of frames played back so far, and in the whole file */
+static size_t playback_position;
+static size_t playback_length;
+
+/* The frame we are fast-forwarding to */
+static size_t seek_target;
+
 /* Fuse's DSA key */
 libspectrum_rzx_dsa_key rzx_key = {
   "A9E3BD74E136A9ABD41E614383BB1B01EB24B2CD7B920ED6A62F786A879AC8B00F2FF318BF96F81654214B1A064889FF6D8078858ED00CF61D2047B2AAB7888949F35D166A2BBAAE23A331BD4728A736E76901D74B195B68C4A2BBFB9F005E3655BDE8256C279A626E00C7087A2D575F78D7DC5CA6E392A535FFE47A816BA503", /* p */
@@ -107,10 +138,19 @@ static const size_t AUTOSAVE_INTERVAL = 5 * 50;
 /* Debugger events */
 static const char * const event_type_string = "rzx";
 static const char * const end_event_detail_string = "end";
+static const char * const seek_event_detail_string = "seek";
+static const char * const frame_detail_string = "frame";
+static const char * const length_detail_string = "length";
 
 int end_event;
+static int seek_event;
 
 static int start_playback( libspectrum_rzx *from_rzx );
+static int start_playback_at( libspectrum_rzx *from_rzx, int input_block,
+                              libspectrum_snap *fallback_snap );
+static int build_playback_index( libspectrum_rzx *from_rzx );
+static void free_playback_index( void );
+static void seek_done( void );
 static void start_recording( libspectrum_rzx *to_rzx, int competition_mode );
 static int recording_frame( void );
 static int playback_frame( void );
@@ -120,6 +160,24 @@ static void rzx_sentinel( libspectrum_dword ts, int type,
 
 static int sentinel_event;
 
+static libspectrum_dword
+get_frame( void )
+{
+  return rzx_playback ? playback_position : 0;
+}
+
+static void
+set_frame( libspectrum_dword value )
+{
+  rzx_seek( value );
+}
+
+static libspectrum_dword
+get_length( void )
+{
+  return rzx_playback ? playback_length : 0;
+}
+
 static int
 rzx_init( void *context )
 {
@@ -132,6 +190,13 @@ rzx_init( void *context )
   sentinel_event = event_register( rzx_sentinel, "RZX sentinel" );
 
   end_event = debugger_event_register( event_type_string, end_event_detail_string );
+  seek_event = debugger_event_register( event_type_string,
+                                        seek_event_detail_string );
+
+  debugger_system_variable_register(
+    event_type_string, frame_detail_string, get_frame, set_frame );
+  debugger_system_variable_register(
+    event_type_string, length_detail_string, get_length, NULL );
 
   return 0;
 }
@@ -157,12 +222,42 @@ rzx_add_snap( libspectrum_rzx *to_rzx, int automatic )
   return 0;
 }
 
+static int
+start_stream_recording( const char *filename, int embed_snapshot )
+{
+  libspectrum_snap *snap = NULL;
+  int error;
+
+  if( embed_snapshot ) {
+    snap = libspectrum_snap_alloc();
+    error = snapshot_copy_to( snap );
+    if( error ) {
+      libspectrum_snap_free( snap );
+      return error;
+    }
+  }
+
+  error = rzx_stream_start( filename, snap );
+  if( snap ) libspectrum_snap_free( snap );
+  if( error ) return error;
+
+  rzx_streaming = 1;
+  start_recording( NULL, 0 );
+
+  return 0;
+}
+
 int rzx_start_recording( const char *filename, int embed_snapshot )
 {
   int error;
 
   if( rzx_playback ) return 1;
 
+  /* Competition mode files must be signed as a whole, so can't be
+     streamed */
+  if( settings_current.rzx_stream && !settings_current.competition_mode )
+    return start_stream_recording( filename, embed_snapshot );
+
   rzx = libspectrum_rzx_alloc();
 
   /* Store the filename */
@@ -184,6 +279,28 @@ int rzx_start_recording( const char *filename, int embed_snapshot )
   return 0;
 }
 
+static int
+stop_stream_recording( void )
+{
+  libspectrum_snap *snap;
+
+  rzx_streaming = 0;
+
+  /* Embed final snapshot */
+  snap = libspectrum_snap_alloc();
+  if( !snapshot_copy_to( snap ) ) rzx_stream_add_snap( snap );
+  libspectrum_snap_free( snap );
+
+  libspectrum_free( rzx_in_bytes );
+  rzx_in_bytes = NULL;
+  rzx_in_allocated = 0;
+
+  ui_menu_activate( UI_MENU_ITEM_RECORDING, 0 );
+  ui_menu_activate( UI_MENU_ITEM_RECORDING_ROLLBACK, 0 );
+
+  return rzx_stream_stop();
+}
+
 int rzx_stop_recording( void )
 {
   libspectrum_byte *buffer; size_t length;
@@ -193,7 +310,9 @@ int rzx_stop_recording( void )
 
   /* Stop recording data */
   rzx_recording = 0;
-  if( settings_current.movie_stop_after_rzx ) movie_stop();
+  if( settings_current.movie_stop_after_rzx ) { movie_stop(); export_stop(); }
+
+  if( rzx_streaming ) return stop_stream_recording();
 
   /* Embed final snapshot */
   if( !rzx_competition_mode ) rzx_add_snap( rzx, 0 );
@@ -274,6 +393,7 @@ int rzx_start_playback( const char *filename, int check_snapshot )
   utils_file file;
   libspectrum_error libspec_error; int error;
   libspectrum_snap* snap;
+  size_t length;
 
   if( rzx_recording ) return 1;
 
@@ -284,8 +404,24 @@ int rzx_start_playback( const char *filename, int check_snapshot )
 
   libspec_error = libspectrum_rzx_read( rzx, file.buffer, file.length );
   if( libspec_error != LIBSPECTRUM_ERROR_NONE ) {
-    utils_close_file( &file );
-    return libspec_error;
+
+    /* A streamed recording may have been cut off part way through writing
+       a block; if so, play back everything before that */
+    length = rzx_stream_complete_length( file.buffer, file.length );
+    if( length < file.length ) {
+      libspectrum_rzx_free( rzx );
+      rzx = libspectrum_rzx_alloc();
+      libspec_error = libspectrum_rzx_read( rzx, file.buffer, length );
+    }
+
+    if( libspec_error != LIBSPECTRUM_ERROR_NONE ) {
+      utils_close_file( &file );
+      return libspec_error;
+    }
+
+    ui_error( UI_ERROR_WARNING,
+              "RZX file '%s' is incomplete; playing back the complete part",
+              filename );
   }
 
   utils_close_file( &file );
@@ -340,13 +476,44 @@ rzx_start_playback_from_buffer( const unsigned char *buffer, size_t length )
 
 static int
 start_playback( libspectrum_rzx *from_rzx )
+{
+  int error;
+
+  error = start_playback_at( from_rzx, 0, NULL );
+  if( error ) return error;
+
+  /* Build the seek index now we know the state before the first frame */
+  error = build_playback_index( from_rzx );
+  if( error ) {
+    free_playback_index();
+    return error;
+  }
+
+  sentinel_warning = 0;
+  rzx_playback = 1;
+  rzx_seeking = 0;
+
+  ui_menu_activate( UI_MENU_ITEM_RECORDING, 1 );
+  ui_menu_activate( UI_MENU_ITEM_RECORDING_ROLLBACK, 0 );
+  ui_menu_activate( UI_MENU_ITEM_RECORDING_SEEK, 1 );
+
+  return 0;
+}
+
+/* Start playing back from the given input recording block, restoring the
+   snapshot before it or, if there is none, 'fallback_snap' */
+static int
+start_playback_at( libspectrum_rzx *from_rzx, int input_block,
+                   libspectrum_snap *fallback_snap )
 {
   int error;
   libspectrum_snap *snap;
 
-  error = libspectrum_rzx_start_playback( from_rzx, 0, &snap );
+  error = libspectrum_rzx_start_playback( from_rzx, input_block, &snap );
   if( error ) return error;
 
+  if( !snap ) snap = fallback_snap;
+
   if( snap ) {
     error = snapshot_copy_from( snap );
     if( error ) return error;
@@ -356,20 +523,168 @@ start_playback( libspectrum_rzx *from_rzx )
   event_remove_type( spectrum_frame_event );
 
   /* Add a sentinel event to prevent tstates overrun (bug #25) */
+  event_remove_type( sentinel_event );
   event_add( RZX_SENTINEL_TIME, sentinel_event );
 
-  sentinel_warning = 0;
   tstates = libspectrum_rzx_tstates( from_rzx );
   rzx_instruction_count = libspectrum_rzx_instructions( from_rzx );
-  rzx_playback = 1;
   counter_reset();
 
-  ui_menu_activate( UI_MENU_ITEM_RECORDING, 1 );
-  ui_menu_activate( UI_MENU_ITEM_RECORDING_ROLLBACK, 0 );
+  return 0;
+}
+
+/* Find every point in the recording from which playback can start: the
+   first input recording block, and every one which directly follows an
+   embedded snapshot */
+static int
+build_playback_index( libspectrum_rzx *from_rzx )
+{
+  libspectrum_rzx_iterator it;
+  libspectrum_snap *snap = NULL;
+  rzx_index_entry entry;
+  int input_block = 0;
+  size_t frames = 0;
+
+  free_playback_index();
+  playback_index = g_array_new( FALSE, FALSE, sizeof( rzx_index_entry ) );
+
+  for( it = libspectrum_rzx_iterator_begin( from_rzx );
+       it;
+       it = libspectrum_rzx_iterator_next( it ) ) {
+
+    libspectrum_rzx_block_id id = libspectrum_rzx_iterator_get_type( it );
+
+    switch( id ) {
+
+    case LIBSPECTRUM_RZX_INPUT_BLOCK:
+      if( !input_block && !snap ) {
+        /* The recording started from an external snapshot, so keep our own
+           copy of the state to come back to */
+        initial_snap = libspectrum_snap_alloc();
+        if( snapshot_copy_to( initial_snap ) ) {
+          libspectrum_snap_free( initial_snap );
+          initial_snap = NULL;
+          return 1;
+        }
+        snap = initial_snap;
+      }
+
+      if( snap ) {
+        entry.frame = frames;
+        entry.input_block = input_block;
+        entry.snap = snap;
+        g_array_append_val( playback_index, entry );
+      }
+
+      frames += libspectrum_rzx_iterator_get_frames( it );
+      input_block++;
+      snap = NULL;
+      break;
+
+    case LIBSPECTRUM_RZX_SNAPSHOT_BLOCK:
+      snap = libspectrum_rzx_iterator_get_snap( it );
+      break;
+
+    default:
+      break;
+    }
+  }
+
+  playback_position = 0;
+  playback_length = frames;
 
   return 0;
 }
 
+static void
+free_playback_index( void )
+{
+  if( playback_index ) {
+    g_array_free( playback_index, TRUE );
+    playback_index = NULL;
+  }
+
+  if( initial_snap ) {
+    libspectrum_snap_free( initial_snap );
+    initial_snap = NULL;
+  }
+
+  playback_position = playback_length = 0;
+}
+
+int
+rzx_seek( size_t frame )
+{
+  rzx_index_entry *entry = NULL;
+  size_t i;
+  int error;
+
+  if( !rzx_playback || !playback_length ) return 1;
+
+  /* Seeking onto the last frame would just end the playback */
+  if( frame >= playback_length ) frame = playback_length - 1;
+
+  /* Find the last restart point at or before the target */
+  for( i = 0; i < playback_index->len; i++ ) {
+    rzx_index_entry *candidate =
+      &g_array_index( playback_index, rzx_index_entry, i );
+    if( candidate->frame > frame ) break;
+    entry = candidate;
+  }
+
+  if( !entry ) return 1;
+
+  /* Only restore state if we can't just run forward from where we are */
+  if( frame < playback_position || entry->frame > playback_position ) {
+    error = start_playback_at( rzx, entry->input_block, entry->snap );
+    if( error ) {
+      rzx_stop_playback( 0 );
+      return error;
+    }
+    playback_position = entry->frame;
+  }
+
+  if( playback_position == frame ) {
+    if( rzx_seeking ) seek_done();
+    display_refresh_all();
+    return 0;
+  }
+
+  /* Replay the remaining frames as quickly as possible, with no sound or
+     screen updates */
+  seek_target = frame;
+  if( !rzx_seeking ) {
+    rzx_seeking = 1;
+    sound_pause();
+  }
+
+  return 0;
+}
+
+size_t
+rzx_playback_frame( void )
+{
+  return playback_position;
+}
+
+size_t
+rzx_playback_frames( void )
+{
+  return playback_length;
+}
+
+static void
+seek_done( void )
+{
+  rzx_seeking = 0;
+
+  sound_unpause();
+  timer_estimate_reset();
+  display_refresh_all();
+
+  debugger_event( seek_event );
+}
+
 int rzx_stop_playback( int add_interrupt )
 {
   libspectrum_error libspec_error;
@@ -377,10 +692,18 @@ int rzx_stop_playback( int add_interrupt )
   if( !rzx_playback ) return 0;
 
   rzx_playback = 0;
-  if( settings_current.movie_stop_after_rzx ) movie_stop();
+  if( settings_current.movie_stop_after_rzx ) { movie_stop(); export_stop(); }
+
+  if( rzx_seeking ) {
+    rzx_seeking = 0;
+    sound_unpause();
+    timer_estimate_reset();
+    display_refresh_all();
+  }
 
   ui_menu_activate( UI_MENU_ITEM_RECORDING, 0 );
   ui_menu_activate( UI_MENU_ITEM_RECORDING_ROLLBACK, 0 );
+  ui_menu_activate( UI_MENU_ITEM_RECORDING_SEEK, 0 );
 
   event_remove_type( sentinel_event );
 
@@ -406,6 +729,8 @@ int rzx_stop_playback( int add_interrupt )
 
   }
 
+  free_playback_index();
+
   libspec_error = libspectrum_rzx_free( rzx );
   if( libspec_error != LIBSPECTRUM_ERROR_NONE ) return libspec_error;
 
@@ -417,7 +742,7 @@ int rzx_stop_playback( int add_interrupt )
 static void
 start_recording( libspectrum_rzx *to_rzx, int competition_mode )
 {
-  libspectrum_rzx_start_input( to_rzx, tstates );
+  if( to_rzx ) libspectrum_rzx_start_input( to_rzx, tstates );
 
   counter_reset();
   rzx_in_count = 0;
@@ -438,7 +763,9 @@ start_recording( libspectrum_rzx *to_rzx, int competition_mode )
 
   } else {
 
-    ui_menu_activate( UI_MENU_ITEM_RECORDING_ROLLBACK, 1 );
+    /* Streamed recordings can't be rolled back as what has been recorded
+       is already on disk */
+    ui_menu_activate( UI_MENU_ITEM_RECORDING_ROLLBACK, !rzx_streaming );
     rzx_competition_mode = 0;
 
   }
@@ -651,10 +978,37 @@ autosave_reset( void )
   autosave_frame_count = frames % AUTOSAVE_INTERVAL;
 }
 
+static int
+stream_recording_frame( void )
+{
+  libspectrum_snap *snap;
+
+  if( rzx_stream_frame( R + rzx_instructions_offset, rzx_in_count,
+                        rzx_in_bytes ) ) {
+    rzx_stop_recording();
+    return 1;
+  }
+
+  rzx_in_count = 0; counter_reset();
+
+  /* There's no rollback, so the autosaves are just for seeking during
+     playback and never need pruning */
+  if( settings_current.rzx_autosaves &&
+      !( ++autosave_frame_count % AUTOSAVE_INTERVAL ) ) {
+    snap = libspectrum_snap_alloc();
+    if( !snapshot_copy_to( snap ) ) rzx_stream_add_snap( snap );
+    libspectrum_snap_free( snap );
+  }
+
+  return 0;
+}
+
 static int recording_frame( void )
 {
   libspectrum_error error;
 
+  if( rzx_streaming ) return stream_recording_frame();
+
   error = libspectrum_rzx_store_frame( rzx, R + rzx_instructions_offset,
 				       rzx_in_count, rzx_in_bytes );
   if( error ) {
@@ -715,6 +1069,9 @@ static int playback_frame( void )
   rzx_instruction_count = libspectrum_rzx_instructions( rzx );
   counter_reset();
 
+  playback_position++;
+  if( rzx_seeking && playback_position >= seek_target ) seek_done();
+
   return 0;
 }
 
@@ -47,12 +47,18 @@ extern int rzx_playback;
 /* Is the .rzx file being recorded in competition mode? */
 extern int rzx_competition_mode;
 
+/* Is the .rzx file being written to disk as it is recorded? */
+extern int rzx_streaming;
+
 /* The number of instructions in the current .rzx playback frame */
 extern size_t rzx_instruction_count;
 
 /* The actual RZX data */
 extern libspectrum_rzx *rzx;
 
+/* Are we currently fast-forwarding to a seek target during playback? */
+extern int rzx_seeking;
+
 void rzx_register_startup( void );
 
 int rzx_start_recording( const char *filename, int embed_snapshot );
@@ -66,6 +72,14 @@ rzx_start_playback_from_buffer( const unsigned char *buffer, size_t length );
 
 int rzx_stop_playback( int add_interrupt );
 
+/* Move playback to just before the given frame; this restores the nearest
+   embedded snapshot and replays from there with no display or sound */
+int rzx_seek( size_t frame );
+
+/* The current playback frame, and the total number of frames */
+size_t rzx_playback_frame( void );
+size_t rzx_playback_frames( void );
+
 int rzx_frame( void );
 
 int rzx_store_byte( libspectrum_byte value );
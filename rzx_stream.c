@@ -0,0 +1,510 @@
+/* rzx_stream.c: Append-only RZX recording
+   Copyright (c) 2026 Fuse contributors
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+   Author contact information:
+
+   E-mail: philip-fuse@shadowmagic.org.uk
+
+*/
+
+/*
+  Normal RZX recording keeps the whole recording in a libspectrum_rzx and
+  writes it out when recording stops. Here, frames are instead collected
+  into short input recording blocks which are written to the end of the
+  file as soon as they are complete, along with any snapshots. Only the
+  block currently being filled is kept in memory, and the file on disk
+  always consists of complete blocks apart from, possibly, a partially
+  written last one if Fuse crashes at the wrong moment; see
+  rzx_stream_complete_length() for recovering such files.
+
+  Compression and writing are done on a background thread if possible.
+*/
+
+#include <config.h>
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef HAVE_PTHREAD
+#include <pthread.h>
+#endif				/* #ifdef HAVE_PTHREAD */
+
+#include <libspectrum.h>
+#ifdef HAVE_ZLIB_H
+#include <zlib.h>
+#endif				/* #ifdef HAVE_ZLIB_H */
+
+#include "fuse.h"
+#include "rzx_stream.h"
+#include "settings.h"
+#include "spectrum.h"
+#include "ui/ui.h"
+
+/* Block IDs and flags from the RZX specification */
+#define RZX_STREAM_CREATOR_BLOCK 0x10
+#define RZX_STREAM_SNAPSHOT_BLOCK 0x30
+#define RZX_STREAM_INPUT_BLOCK 0x80
+#define RZX_STREAM_FLAG_COMPRESSED 0x02
+
+/* The number of blocks which can be waiting to be written */
+#define RZX_STREAM_QUEUE_LENGTH 4
+
+typedef enum stream_block_type {
+  STREAM_BLOCK_INPUT,
+  STREAM_BLOCK_SNAPSHOT,
+} stream_block_type;
+
+typedef struct stream_block {
+  stream_block_type type;
+  libspectrum_dword frames;	/* Input blocks only */
+  libspectrum_dword tstates;	/* Input blocks only */
+  libspectrum_byte *data;
+  size_t length, allocated;
+} stream_block;
+
+static stream_block queue[ RZX_STREAM_QUEUE_LENGTH ];
+static size_t queue_head, queue_tail, queue_count;
+
+#ifdef HAVE_PTHREAD
+static pthread_t writer_thread;
+static pthread_mutex_t queue_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t queue_not_empty = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t queue_not_full = PTHREAD_COND_INITIALIZER;
+static int writer_running = 0;
+static int writer_stop = 0;
+#endif				/* #ifdef HAVE_PTHREAD */
+
+static FILE *stream_file = NULL;
+static int stream_compress;
+
+/* The first error seen by the writer, as an errno value */
+static int write_error;
+
+/* The input recording block currently being filled */
+static stream_block *current;
+
+/* The IN bytes of the previous frame, so repeated frames can be stored
+   with the "same as last frame" marker */
+static libspectrum_byte *last_in_bytes;
+static size_t last_in_count, last_in_allocated;
+static int last_in_valid;
+
+/* Scratch space for the writer */
+static libspectrum_byte *compressed;
+static size_t compressed_allocated;
+
+static void
+ensure_space( libspectrum_byte **buffer, size_t *allocated, size_t size )
+{
+  size_t new_allocated;
+
+  if( *allocated >= size ) return;
+
+  new_allocated = *allocated >= 256 ? *allocated : 256;
+  while( new_allocated < size ) new_allocated *= 2;
+
+  *buffer = libspectrum_renew( libspectrum_byte, *buffer, new_allocated );
+  *allocated = new_allocated;
+}
+
+/* Compress and write one block; called from the writer thread if there
+   is one */
+static void
+write_block( stream_block *block )
+{
+  libspectrum_byte header[18], *ptr = header, *payload = block->data;
+  size_t payload_length = block->length, header_length;
+  libspectrum_dword flags = 0;
+
+  if( write_error ) return;
+
+#ifdef HAVE_ZLIB_H
+  if( stream_compress ) {
+    uLongf length = compressBound( block->length );
+
+    ensure_space( &compressed, &compressed_allocated, length );
+    if( compress2( compressed, &length, block->data, block->length,
+                   Z_DEFAULT_COMPRESSION ) == Z_OK ) {
+      payload = compressed;
+      payload_length = length;
+      flags |= RZX_STREAM_FLAG_COMPRESSED;
+    }
+  }
+#endif				/* #ifdef HAVE_ZLIB_H */
+
+  switch( block->type ) {
+
+  case STREAM_BLOCK_INPUT:
+    header_length = 18;
+    *ptr++ = RZX_STREAM_INPUT_BLOCK;
+    libspectrum_write_dword( &ptr, header_length + payload_length );
+    libspectrum_write_dword( &ptr, block->frames );
+    *ptr++ = 0;			/* Reserved */
+    libspectrum_write_dword( &ptr, block->tstates );
+    libspectrum_write_dword( &ptr, flags );
+    break;
+
+  case STREAM_BLOCK_SNAPSHOT:
+    header_length = 17;
+    *ptr++ = RZX_STREAM_SNAPSHOT_BLOCK;
+    libspectrum_write_dword( &ptr, header_length + payload_length );
+    libspectrum_write_dword( &ptr, flags );
+    memcpy( ptr, "szx", 4 ); ptr += 4;
+    libspectrum_write_dword( &ptr, block->length );
+    break;
+
+  default:
+    return;
+  }
+
+  /* Flush after every block so the file on disk is always usable */
+  if( fwrite( header, header_length, 1, stream_file ) != 1 ||
+      fwrite( payload, payload_length, 1, stream_file ) != 1 ||
+      fflush( stream_file ) )
+    write_error = errno ? errno : EIO;
+}
+
+#ifdef HAVE_PTHREAD
+
+static void*
+writer_thread_fn( void *arg GCC_UNUSED )
+{
+  stream_block *block;
+
+  pthread_mutex_lock( &queue_lock );
+
+  while( 1 ) {
+
+    while( !queue_count && !writer_stop )
+      pthread_cond_wait( &queue_not_empty, &queue_lock );
+
+    if( !queue_count ) break;
+
+    block = &queue[ queue_head ];
+
+    /* The producer never touches a block between queuing it and us
+       releasing it, so we can write without holding the lock */
+    pthread_mutex_unlock( &queue_lock );
+    write_block( block );
+    pthread_mutex_lock( &queue_lock );
+
+    queue_head = ( queue_head + 1 ) % RZX_STREAM_QUEUE_LENGTH;
+    queue_count--;
+    pthread_cond_signal( &queue_not_full );
+  }
+
+  pthread_mutex_unlock( &queue_lock );
+
+  return NULL;
+}
+
+static void
+writer_start( void )
+{
+  int error;
+
+  writer_stop = 0;
+
+  error = pthread_create( &writer_thread, NULL, writer_thread_fn, NULL );
+  if( error ) {
+    ui_error( UI_ERROR_WARNING,
+              "rzx: error %d creating writer thread; writing synchronously",
+              error );
+    return;
+  }
+
+  writer_running = 1;
+}
+
+/* Wait for the writer to empty the queue and then stop it */
+static void
+writer_end( void )
+{
+  if( !writer_running ) return;
+
+  pthread_mutex_lock( &queue_lock );
+  writer_stop = 1;
+  pthread_cond_signal( &queue_not_empty );
+  pthread_mutex_unlock( &queue_lock );
+
+  pthread_join( writer_thread, NULL );
+  writer_running = 0;
+}
+
+#endif				/* #ifdef HAVE_PTHREAD */
+
+/* Get the next free block, waiting for the writer if the queue is full */
+static stream_block*
+get_free_block( stream_block_type type )
+{
+  stream_block *block;
+
+#ifdef HAVE_PTHREAD
+  if( writer_running ) {
+    pthread_mutex_lock( &queue_lock );
+    while( queue_count == RZX_STREAM_QUEUE_LENGTH )
+      pthread_cond_wait( &queue_not_full, &queue_lock );
+    pthread_mutex_unlock( &queue_lock );
+  }
+#endif				/* #ifdef HAVE_PTHREAD */
+
+  block = &queue[ queue_tail ];
+  block->type = type;
+  block->frames = 0;
+  block->tstates = 0;
+  block->length = 0;
+
+  return block;
+}
+
+/* Hand a block obtained from get_free_block() to the writer */
+static void
+queue_block( stream_block *block )
+{
+#ifdef HAVE_PTHREAD
+  if( writer_running ) {
+    pthread_mutex_lock( &queue_lock );
+    queue_tail = ( queue_tail + 1 ) % RZX_STREAM_QUEUE_LENGTH;
+    queue_count++;
+    pthread_cond_signal( &queue_not_empty );
+    pthread_mutex_unlock( &queue_lock );
+    return;
+  }
+#endif				/* #ifdef HAVE_PTHREAD */
+
+  write_block( block );
+}
+
+static void
+start_input_block( void )
+{
+  current = get_free_block( STREAM_BLOCK_INPUT );
+  current->tstates = tstates;
+  last_in_valid = 0;
+}
+
+/* Queue the current input block if it has anything in it */
+static void
+end_input_block( void )
+{
+  if( current && current->frames ) queue_block( current );
+  current = NULL;
+}
+
+static int
+check_write_error( void )
+{
+  if( !write_error ) return 0;
+
+  ui_error( UI_ERROR_ERROR, "error writing RZX file: %s",
+            strerror( write_error ) );
+  return 1;
+}
+
+static int
+write_header( void )
+{
+  libspectrum_byte buffer[ 39 ], *ptr = buffer;
+  const char *program = libspectrum_creator_program( fuse_creator );
+  const libspectrum_byte *custom = libspectrum_creator_custom( fuse_creator );
+  size_t custom_length = libspectrum_creator_custom_length( fuse_creator );
+
+  /* File header: version 0.13, not signed */
+  memcpy( ptr, "RZX!", 4 ); ptr += 4;
+  *ptr++ = 0; *ptr++ = 13;
+  libspectrum_write_dword( &ptr, 0 );
+
+  /* Creator information */
+  *ptr++ = RZX_STREAM_CREATOR_BLOCK;
+  libspectrum_write_dword( &ptr, 29 + custom_length );
+  memset( ptr, 0, 20 );
+  strncpy( (char*)ptr, program, 20 ); ptr += 20;
+  libspectrum_write_word( &ptr, libspectrum_creator_major( fuse_creator ) );
+  libspectrum_write_word( &ptr, libspectrum_creator_minor( fuse_creator ) );
+
+  if( fwrite( buffer, ptr - buffer, 1, stream_file ) != 1 ) return 1;
+  if( custom_length &&
+      fwrite( custom, custom_length, 1, stream_file ) != 1 )
+    return 1;
+
+  return fflush( stream_file ) ? 1 : 0;
+}
+
+int
+rzx_stream_start( const char *filename, libspectrum_snap *snap )
+{
+  if( stream_file ) rzx_stream_stop();
+
+  stream_file = fopen( filename, "wb" );
+  if( !stream_file ) {
+    ui_error( UI_ERROR_ERROR, "error opening RZX file '%s': %s", filename,
+              strerror( errno ) );
+    return 1;
+  }
+
+  if( write_header() ) {
+    ui_error( UI_ERROR_ERROR, "error writing RZX file '%s': %s", filename,
+              strerror( errno ) );
+    fclose( stream_file ); stream_file = NULL;
+    return 1;
+  }
+
+  stream_compress = settings_current.rzx_compression;
+  write_error = 0;
+  queue_head = queue_tail = queue_count = 0;
+
+#ifdef HAVE_PTHREAD
+  writer_start();
+#endif				/* #ifdef HAVE_PTHREAD */
+
+  if( snap && rzx_stream_add_snap( snap ) ) {
+    rzx_stream_stop();
+    return 1;
+  }
+
+  if( !current ) start_input_block();
+
+  return 0;
+}
+
+int
+rzx_stream_frame( libspectrum_word instructions, size_t in_count,
+                  const libspectrum_byte *in_bytes )
+{
+  libspectrum_byte *ptr;
+
+  if( !stream_file ) return 1;
+  if( check_write_error() ) return 1;
+
+  ensure_space( &current->data, &current->allocated,
+                current->length + 4 + in_count );
+  ptr = current->data + current->length;
+
+  libspectrum_write_word( &ptr, instructions );
+
+  if( last_in_valid && in_count == last_in_count &&
+      !memcmp( in_bytes, last_in_bytes, in_count ) ) {
+    libspectrum_write_word( &ptr, 0xffff );
+  } else {
+    libspectrum_write_word( &ptr, in_count );
+    memcpy( ptr, in_bytes, in_count ); ptr += in_count;
+
+    ensure_space( &last_in_bytes, &last_in_allocated, in_count );
+    memcpy( last_in_bytes, in_bytes, in_count );
+    last_in_count = in_count;
+    last_in_valid = 1;
+  }
+
+  current->length = ptr - current->data;
+  current->frames++;
+
+  if( settings_current.rzx_stream_frames <= 0 ||
+      current->frames >= (libspectrum_dword)settings_current.rzx_stream_frames ) {
+    end_input_block();
+    start_input_block();
+  }
+
+  return 0;
+}
+
+int
+rzx_stream_add_snap( libspectrum_snap *snap )
+{
+  libspectrum_byte *buffer = NULL;
+  size_t length = 0;
+  stream_block *block;
+  int flags, error;
+
+  if( !stream_file ) return 1;
+  if( check_write_error() ) return 1;
+
+  error = libspectrum_snap_write( &buffer, &length, &flags, snap,
+                                  LIBSPECTRUM_ID_SNAPSHOT_SZX, fuse_creator,
+                                  0 );
+  if( error ) return error;
+
+  end_input_block();
+
+  block = get_free_block( STREAM_BLOCK_SNAPSHOT );
+  ensure_space( &block->data, &block->allocated, length );
+  memcpy( block->data, buffer, length );
+  block->length = length;
+  queue_block( block );
+
+  libspectrum_free( buffer );
+
+  start_input_block();
+
+  return 0;
+}
+
+int
+rzx_stream_stop( void )
+{
+  size_t i;
+  int error = 0;
+
+  if( !stream_file ) return 0;
+
+  end_input_block();
+
+#ifdef HAVE_PTHREAD
+  writer_end();
+#endif				/* #ifdef HAVE_PTHREAD */
+
+  error = check_write_error();
+
+  if( fclose( stream_file ) ) {
+    ui_error( UI_ERROR_ERROR, "error closing RZX file: %s",
+              strerror( errno ) );
+    error = 1;
+  }
+  stream_file = NULL;
+
+  for( i = 0; i < RZX_STREAM_QUEUE_LENGTH; i++ ) {
+    libspectrum_free( queue[i].data );
+    queue[i].data = NULL;
+    queue[i].allocated = 0;
+  }
+
+  libspectrum_free( last_in_bytes ); last_in_bytes = NULL;
+  last_in_allocated = 0;
+  libspectrum_free( compressed ); compressed = NULL;
+  compressed_allocated = 0;
+
+  return error;
+}
+
+size_t
+rzx_stream_complete_length( const libspectrum_byte *buffer, size_t length )
+{
+  const libspectrum_byte *ptr;
+  size_t offset = 10, block_length;
+
+  if( length < offset || memcmp( buffer, "RZX!", 4 ) ) return length;
+
+  /* Each block starts with its ID and its length including those 5 bytes */
+  while( offset + 5 <= length ) {
+    ptr = buffer + offset + 1;
+    block_length = libspectrum_read_dword( &ptr );
+    if( block_length < 5 || block_length > length - offset ) break;
+    offset += block_length;
+  }
+
+  return offset;
+}
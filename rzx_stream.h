@@ -0,0 +1,47 @@
+/* rzx_stream.h: Append-only RZX recording
+   Copyright (c) 2026 Fuse contributors
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+   Author contact information:
+
+   E-mail: philip-fuse@shadowmagic.org.uk
+
+*/
+
+#ifndef FUSE_RZX_STREAM_H
+#define FUSE_RZX_STREAM_H
+
+#include <libspectrum.h>
+
+/* Start a recording in 'filename', beginning with 'snap' if not NULL */
+int rzx_stream_start( const char *filename, libspectrum_snap *snap );
+
+/* Add one frame of input to the recording */
+int rzx_stream_frame( libspectrum_word instructions, size_t in_count,
+                      const libspectrum_byte *in_bytes );
+
+/* Add a snapshot to the recording after any frames already added */
+int rzx_stream_add_snap( libspectrum_snap *snap );
+
+/* Write out everything pending and close the file */
+int rzx_stream_stop( void );
+
+/* Return the length of the part of an RZX file made of complete blocks,
+   for recovering a recording which was interrupted while being written */
+size_t rzx_stream_complete_length( const libspectrum_byte *buffer,
+                                   size_t length );
+
+#endif			/* #ifndef FUSE_RZX_STREAM_H */
@@ -44,6 +44,102 @@
 #define HIRES_ATTR HICOLOUR_SCR_SIZE
 #define HIRES_SCR_SIZE (HICOLOUR_SCR_SIZE + 1)
 
+/* Convert the current screen into 32-bit RGB(padding) data */
+int
+screenshot_get_rgb32_data( libspectrum_byte *rgb32_data, size_t stride,
+			   size_t height, size_t width )
+{
+  size_t i, x, y;
+
+  static const			      /*  R    G    B */
+  libspectrum_byte palette[16][3] = { {   0,   0,   0 },
+				      {   0,   0, 192 },
+				      { 192,   0,   0 },
+				      { 192,   0, 192 },
+				      {   0, 192,   0 },
+				      {   0, 192, 192 },
+				      { 192, 192,   0 },
+				      { 192, 192, 192 },
+				      {   0,   0,   0 },
+				      {   0,   0, 255 },
+				      { 255,   0,   0 },
+				      { 255,   0, 255 },
+				      {   0, 255,   0 },
+				      {   0, 255, 255 },
+				      { 255, 255,   0 },
+				      { 255, 255, 255 } };
+
+  libspectrum_byte grey_palette[16];
+
+  /* Addition of 0.5 is to avoid rounding errors */
+  for( i = 0; i < 16; i++ )
+    grey_palette[i] = ( 0.299 * palette[i][0] +
+			0.587 * palette[i][1] +
+			0.114 * palette[i][2]   ) + 0.5;
+
+  for( y = 0; y < height; y++ ) {
+    for( x = 0; x < width; x++ ) {
+
+      size_t colour;
+      libspectrum_byte red, green, blue;
+
+      colour = display_getpixel( x, y );
+
+      if( settings_current.bw_tv ) {
+
+	red = green = blue = grey_palette[colour];
+
+      } else {
+
+	red   = palette[colour][0];
+	green = palette[colour][1];
+	blue  = palette[colour][2];
+
+      }
+      
+      rgb32_data[ y * stride + 4 * x     ] = red;
+      rgb32_data[ y * stride + 4 * x + 1 ] = green;
+      rgb32_data[ y * stride + 4 * x + 2 ] = blue;
+      rgb32_data[ y * stride + 4 * x + 3 ] = 0;		 /* padding */
+
+    }
+  }
+
+  return 0;
+}
+
+int
+screenshot_available_scalers( scaler_type scaler )
+{
+  if( machine_current->timex ) {
+
+    switch( scaler ) {
+
+    case SCALER_HALF: case SCALER_HALFSKIP: case SCALER_NORMAL:
+    case SCALER_TIMEXTV: case SCALER_PALTV:
+      return 1;
+    default:
+      return 0;
+
+    }
+
+  } else {
+    
+    switch( scaler ) {
+
+    case SCALER_NORMAL: case SCALER_DOUBLESIZE: case SCALER_TRIPLESIZE:
+    case SCALER_2XSAI: case SCALER_SUPER2XSAI: case SCALER_SUPEREAGLE:
+    case SCALER_ADVMAME2X: case SCALER_ADVMAME3X: case SCALER_TV2X:
+    case SCALER_DOTMATRIX: case SCALER_PALTV2X: case SCALER_PALTV3X:
+    case SCALER_HQ2X: case SCALER_HQ3X:
+      return 1;
+    default:
+      return 0;
+
+    }
+  }
+}
+
 #ifdef USE_LIBPNG
 
 #include <png.h>
@@ -52,8 +148,6 @@
 #include <zlib.h>
 #endif				/* #ifdef HAVE_ZLIB_H */
 
-static int get_rgb32_data( libspectrum_byte *rgb32_data, size_t stride,
-			   size_t height, size_t width );
 static int rgb32_to_rgb24( libspectrum_byte *rgb24_data, size_t rgb24_stride,
 			   libspectrum_byte *rgb32_data, size_t rgb32_stride,
 			   size_t height, size_t width );
@@ -93,7 +187,8 @@ screenshot_write( const char *filename, scaler_type scaler )
   }
 
   /* Change from paletted data to RGB data */
-  error = get_rgb32_data( rgb_data1, rgb_stride, base_height, base_width );
+  error = screenshot_get_rgb32_data( rgb_data1, rgb_stride, base_height,
+                                     base_width );
   if( error ) return error;
 
   /* Actually scale the data here */
@@ -170,69 +265,6 @@ screenshot_write( const char *filename, scaler_type scaler )
   return 0;
 }
 
-static int
-get_rgb32_data( libspectrum_byte *rgb32_data, size_t stride,
-		size_t height, size_t width )
-{
-  size_t i, x, y;
-
-  static const			      /*  R    G    B */
-  libspectrum_byte palette[16][3] = { {   0,   0,   0 },
-				      {   0,   0, 192 },
-				      { 192,   0,   0 },
-				      { 192,   0, 192 },
-				      {   0, 192,   0 },
-				      {   0, 192, 192 },
-				      { 192, 192,   0 },
-				      { 192, 192, 192 },
-				      {   0,   0,   0 },
-				      {   0,   0, 255 },
-				      { 255,   0,   0 },
-				      { 255,   0, 255 },
-				      {   0, 255,   0 },
-				      {   0, 255, 255 },
-				      { 255, 255,   0 },
-				      { 255, 255, 255 } };
-
-  libspectrum_byte grey_palette[16];
-
-  /* Addition of 0.5 is to avoid rounding errors */
-  for( i = 0; i < 16; i++ )
-    grey_palette[i] = ( 0.299 * palette[i][0] +
-			0.587 * palette[i][1] +
-			0.114 * palette[i][2]   ) + 0.5;
-
-  for( y = 0; y < height; y++ ) {
-    for( x = 0; x < width; x++ ) {
-
-      size_t colour;
-      libspectrum_byte red, green, blue;
-
-      colour = display_getpixel( x, y );
-
-      if( settings_current.bw_tv ) {
-
-	red = green = blue = grey_palette[colour];
-
-      } else {
-
-	red   = palette[colour][0];
-	green = palette[colour][1];
-	blue  = palette[colour][2];
-
-      }
-      
-      rgb32_data[ y * stride + 4 * x     ] = red;
-      rgb32_data[ y * stride + 4 * x + 1 ] = green;
-      rgb32_data[ y * stride + 4 * x + 2 ] = blue;
-      rgb32_data[ y * stride + 4 * x + 3 ] = 0;		 /* padding */
-
-    }
-  }
-
-  return 0;
-}
-
 static int
 rgb32_to_rgb24( libspectrum_byte *rgb24_data, size_t rgb24_stride,
 		libspectrum_byte *rgb32_data, size_t rgb32_stride,
@@ -251,38 +283,6 @@ rgb32_to_rgb24( libspectrum_byte *rgb24_data, size_t rgb24_stride,
   return 0;
 }
 
-int
-screenshot_available_scalers( scaler_type scaler )
-{
-  if( machine_current->timex ) {
-
-    switch( scaler ) {
-
-    case SCALER_HALF: case SCALER_HALFSKIP: case SCALER_NORMAL:
-    case SCALER_TIMEXTV: case SCALER_PALTV:
-      return 1;
-    default:
-      return 0;
-
-    }
-
-  } else {
-    
-    switch( scaler ) {
-
-    case SCALER_NORMAL: case SCALER_DOUBLESIZE: case SCALER_TRIPLESIZE:
-    case SCALER_2XSAI: case SCALER_SUPER2XSAI: case SCALER_SUPEREAGLE:
-    case SCALER_ADVMAME2X: case SCALER_ADVMAME3X: case SCALER_TV2X:
-    case SCALER_DOTMATRIX: case SCALER_PALTV2X: case SCALER_PALTV3X:
-    case SCALER_HQ2X: case SCALER_HQ3X:
-      return 1;
-    default:
-      return 0;
-
-    }
-  }
-}
-
 #endif				/* #ifdef USE_LIBPNG */
 
 static int
@@ -31,10 +31,13 @@
 #ifdef USE_LIBPNG
 
 int screenshot_write( const char *filename, scaler_type scaler );
-int screenshot_available_scalers( scaler_type scaler );
 
 #endif				/* #ifdef USE_LIBPNG */
 
+int screenshot_available_scalers( scaler_type scaler );
+int screenshot_get_rgb32_data( libspectrum_byte *rgb32_data, size_t stride,
+                               size_t height, size_t width );
+
 int screenshot_scr_write( const char *filename );
 int screenshot_scr_read( const char *filename );
 
@@ -73,9 +73,12 @@ settings_info settings_default = {
   /* aspect_hint */ 1,
   /* auto_load */ 1,
   /* autosave_settings */ 0,
+  /* benchmark */ 0,
+  /* benchmark_output */ 0,
   /* beta128 */ 0,
   /* beta128_48boot */ 1,
   /* betadisk_file */ (char *)NULL,
+  /* boot_cache */ (char *)NULL,
   /* bw_tv */ 0,
   /* competition_code */ 0,
   /* competition_mode */ 0,
@@ -116,11 +119,18 @@ settings_info settings_default = {
   /* drive_plusd2_type */ (char *)NULL,
   /* embed_snapshot */ 1,
   /* emulation_speed */ 100,
+  /* export_audio */ (char *)NULL,
+  /* export_full_speed */ 1,
+  /* export_scaler */ (char *)NULL,
+  /* export_video */ (char *)NULL,
   /* fastload */ 1,
   /* fb_mode */ 320,
   /* frame_rate */ 1,
   /* full_screen */ 0,
   /* fuller */ 0,
+  /* fuzz */ 0,
+  /* fuzz_frames */ 100000,
+  /* fuzz_run_length */ 100,
   /* if2_file */ (char *)NULL,
   /* interface1 */ 0,
   /* interface2 */ 1,
@@ -183,21 +193,29 @@ settings_info settings_default = {
   /* melodik */ 0,
   /* mouse_swap_buttons */ 0,
   /* movie_compr */ (char *)NULL,
+  /* movie_compr_fast */ 0,
   /* movie_start */ (char *)NULL,
   /* movie_stop_after_rzx */ 1,
   /* multiface1 */ 0,
   /* multiface128 */ 0,
   /* multiface1_stealth */ 0,
   /* multiface3 */ 0,
+  /* netplay_delay */ 1,
+  /* netplay_peer */ (char *)NULL,
+  /* netplay_port */ 5000,
+  /* netplay_rollback */ 8,
   /* opus */ 0,
   /* opusdisk_file */ (char *)NULL,
   /* pal_tv2x */ 0,
+  /* perfstats */ 0,
+  /* perfstats_file */ (char *)NULL,
   /* phantom_typist_mode */ (char *)"Auto",
   /* playback_file */ (char *)NULL,
   /* plus3_detect_speedlock */ 1,
   /* plus3disk_file */ (char *)NULL,
   /* plusd */ 0,
   /* plusddisk_file */ (char *)NULL,
+  /* predecode_cache */ 0,
   /* printer */ 0,
   /* printer_graphics_filename */ (char *)"printout.pbm",
   /* printer_text_filename */ (char *)"printout.txt",
@@ -258,8 +276,11 @@ settings_info settings_default = {
   /* rs232_handshake */ 0,
   /* rs232_rx */ (char *)NULL,
   /* rs232_tx */ (char *)NULL,
+  /* run_ahead */ 0,
   /* rzx_autosaves */ 1,
   /* rzx_compression */ 1,
+  /* rzx_stream */ 0,
+  /* rzx_stream_frames */ 50,
   /* sdl_fullscreen_mode */ (char *)NULL,
   /* simpleide_active */ 0,
   /* simpleide_master_file */ (char *)NULL,
@@ -272,6 +293,7 @@ settings_info settings_default = {
   /* sound_force_8bit */ 0,
   /* sound_freq */ 44100,
   /* sound_load */ 1,
+  /* sound_thread */ 0,
   /* speaker_type */ (char *)NULL,
   /* speccyboot */ 0,
   /* speccyboot_tap */ (char *)"tap0",
@@ -280,6 +302,10 @@ settings_info settings_default = {
   /* spectranet_disable */ 0,
   /* start_machine */ (char *)"48",
   /* start_scaler_mode */ (char *)"normal",
+  /* startup_profile */ 0,
+  /* state_frames */ 3000,
+  /* state_golden */ (char *)NULL,
+  /* state_log */ (char *)NULL,
   /* statusbar */ 1,
   /* stereo_ay */ (char *)NULL,
   /* strict_aspect_hint */ 0,
@@ -425,6 +451,20 @@ parse_xml( xmlDocPtr doc, settings_info *settings )
         xmlFree( xmlstring );
       }
     } else
+    if( !strcmp( (const char*)node->name, "benchmark" ) ) {
+      xmlstring = xmlNodeListGetString( doc, node->xmlChildrenNode, 1 );
+      if( xmlstring ) {
+        settings->benchmark = atoi( (char*)xmlstring );
+        xmlFree( xmlstring );
+      }
+    } else
+    if( !strcmp( (const char*)node->name, "benchmarkoutput" ) ) {
+      xmlstring = xmlNodeListGetString( doc, node->xmlChildrenNode, 1 );
+      if( xmlstring ) {
+        settings->benchmark_output = atoi( (char*)xmlstring );
+        xmlFree( xmlstring );
+      }
+    } else
     if( !strcmp( (const char*)node->name, "beta128" ) ) {
       xmlstring = xmlNodeListGetString( doc, node->xmlChildrenNode, 1 );
       if( xmlstring ) {
@@ -447,6 +487,14 @@ parse_xml( xmlDocPtr doc, settings_info *settings )
         xmlFree( xmlstring );
       }
     } else
+    if( !strcmp( (const char*)node->name, "bootcache" ) ) {
+      xmlstring = xmlNodeListGetString( doc, node->xmlChildrenNode, 1 );
+      if( xmlstring ) {
+        libspectrum_free( settings->boot_cache );
+        settings->boot_cache = utils_safe_strdup( (char*)xmlstring );
+        xmlFree( xmlstring );
+      }
+    } else
     if( !strcmp( (const char*)node->name, "bwtv" ) ) {
       xmlstring = xmlNodeListGetString( doc, node->xmlChildrenNode, 1 );
       if( xmlstring ) {
@@ -752,6 +800,37 @@ parse_xml( xmlDocPtr doc, settings_info *settings )
         xmlFree( xmlstring );
       }
     } else
+    if( !strcmp( (const char*)node->name, "exportaudio" ) ) {
+      xmlstring = xmlNodeListGetString( doc, node->xmlChildrenNode, 1 );
+      if( xmlstring ) {
+        libspectrum_free( settings->export_audio );
+        settings->export_audio = utils_safe_strdup( (char*)xmlstring );
+        xmlFree( xmlstring );
+      }
+    } else
+    if( !strcmp( (const char*)node->name, "exportfullspeed" ) ) {
+      xmlstring = xmlNodeListGetString( doc, node->xmlChildrenNode, 1 );
+      if( xmlstring ) {
+        settings->export_full_speed = atoi( (char*)xmlstring );
+        xmlFree( xmlstring );
+      }
+    } else
+    if( !strcmp( (const char*)node->name, "exportscaler" ) ) {
+      xmlstring = xmlNodeListGetString( doc, node->xmlChildrenNode, 1 );
+      if( xmlstring ) {
+        libspectrum_free( settings->export_scaler );
+        settings->export_scaler = utils_safe_strdup( (char*)xmlstring );
+        xmlFree( xmlstring );
+      }
+    } else
+    if( !strcmp( (const char*)node->name, "exportvideo" ) ) {
+      xmlstring = xmlNodeListGetString( doc, node->xmlChildrenNode, 1 );
+      if( xmlstring ) {
+        libspectrum_free( settings->export_video );
+        settings->export_video = utils_safe_strdup( (char*)xmlstring );
+        xmlFree( xmlstring );
+      }
+    } else
     if( !strcmp( (const char*)node->name, "fastload" ) ) {
       xmlstring = xmlNodeListGetString( doc, node->xmlChildrenNode, 1 );
       if( xmlstring ) {
@@ -787,6 +866,27 @@ parse_xml( xmlDocPtr doc, settings_info *settings )
         xmlFree( xmlstring );
       }
     } else
+    if( !strcmp( (const char*)node->name, "fuzz" ) ) {
+      xmlstring = xmlNodeListGetString( doc, node->xmlChildrenNode, 1 );
+      if( xmlstring ) {
+        settings->fuzz = atoi( (char*)xmlstring );
+        xmlFree( xmlstring );
+      }
+    } else
+    if( !strcmp( (const char*)node->name, "fuzzframes" ) ) {
+      xmlstring = xmlNodeListGetString( doc, node->xmlChildrenNode, 1 );
+      if( xmlstring ) {
+        settings->fuzz_frames = atoi( (char*)xmlstring );
+        xmlFree( xmlstring );
+      }
+    } else
+    if( !strcmp( (const char*)node->name, "fuzzrunlength" ) ) {
+      xmlstring = xmlNodeListGetString( doc, node->xmlChildrenNode, 1 );
+      if( xmlstring ) {
+        settings->fuzz_run_length = atoi( (char*)xmlstring );
+        xmlFree( xmlstring );
+      }
+    } else
     if( !strcmp( (const char*)node->name, "if2cart" ) ) {
       xmlstring = xmlNodeListGetString( doc, node->xmlChildrenNode, 1 );
       if( xmlstring ) {
@@ -1233,6 +1333,13 @@ parse_xml( xmlDocPtr doc, settings_info *settings )
         xmlFree( xmlstring );
       }
     } else
+    if( !strcmp( (const char*)node->name, "moviecomprfast" ) ) {
+      xmlstring = xmlNodeListGetString( doc, node->xmlChildrenNode, 1 );
+      if( xmlstring ) {
+        settings->movie_compr_fast = atoi( (char*)xmlstring );
+        xmlFree( xmlstring );
+      }
+    } else
     if( !strcmp( (const char*)node->name, "moviestart" ) ) {
       xmlstring = xmlNodeListGetString( doc, node->xmlChildrenNode, 1 );
       if( xmlstring ) {
@@ -1276,6 +1383,35 @@ parse_xml( xmlDocPtr doc, settings_info *settings )
         xmlFree( xmlstring );
       }
     } else
+    if( !strcmp( (const char*)node->name, "netplaydelay" ) ) {
+      xmlstring = xmlNodeListGetString( doc, node->xmlChildrenNode, 1 );
+      if( xmlstring ) {
+        settings->netplay_delay = atoi( (char*)xmlstring );
+        xmlFree( xmlstring );
+      }
+    } else
+    if( !strcmp( (const char*)node->name, "netplaypeer" ) ) {
+      xmlstring = xmlNodeListGetString( doc, node->xmlChildrenNode, 1 );
+      if( xmlstring ) {
+        libspectrum_free( settings->netplay_peer );
+        settings->netplay_peer = utils_safe_strdup( (char*)xmlstring );
+        xmlFree( xmlstring );
+      }
+    } else
+    if( !strcmp( (const char*)node->name, "netplayport" ) ) {
+      xmlstring = xmlNodeListGetString( doc, node->xmlChildrenNode, 1 );
+      if( xmlstring ) {
+        settings->netplay_port = atoi( (char*)xmlstring );
+        xmlFree( xmlstring );
+      }
+    } else
+    if( !strcmp( (const char*)node->name, "netplayrollback" ) ) {
+      xmlstring = xmlNodeListGetString( doc, node->xmlChildrenNode, 1 );
+      if( xmlstring ) {
+        settings->netplay_rollback = atoi( (char*)xmlstring );
+        xmlFree( xmlstring );
+      }
+    } else
     if( !strcmp( (const char*)node->name, "opus" ) ) {
       xmlstring = xmlNodeListGetString( doc, node->xmlChildrenNode, 1 );
       if( xmlstring ) {
@@ -1298,6 +1434,21 @@ parse_xml( xmlDocPtr doc, settings_info *settings )
         xmlFree( xmlstring );
       }
     } else
+    if( !strcmp( (const char*)node->name, "perfstats" ) ) {
+      xmlstring = xmlNodeListGetString( doc, node->xmlChildrenNode, 1 );
+      if( xmlstring ) {
+        settings->perfstats = atoi( (char*)xmlstring );
+        xmlFree( xmlstring );
+      }
+    } else
+    if( !strcmp( (const char*)node->name, "perfstatsfile" ) ) {
+      xmlstring = xmlNodeListGetString( doc, node->xmlChildrenNode, 1 );
+      if( xmlstring ) {
+        libspectrum_free( settings->perfstats_file );
+        settings->perfstats_file = utils_safe_strdup( (char*)xmlstring );
+        xmlFree( xmlstring );
+      }
+    } else
     if( !strcmp( (const char*)node->name, "phantomtypistmode" ) ) {
       xmlstring = xmlNodeListGetString( doc, node->xmlChildrenNode, 1 );
       if( xmlstring ) {
@@ -1344,6 +1495,13 @@ parse_xml( xmlDocPtr doc, settings_info *settings )
         xmlFree( xmlstring );
       }
     } else
+    if( !strcmp( (const char*)node->name, "predecodecache" ) ) {
+      xmlstring = xmlNodeListGetString( doc, node->xmlChildrenNode, 1 );
+      if( xmlstring ) {
+        settings->predecode_cache = atoi( (char*)xmlstring );
+        xmlFree( xmlstring );
+      }
+    } else
     if( !strcmp( (const char*)node->name, "printer" ) ) {
       xmlstring = xmlNodeListGetString( doc, node->xmlChildrenNode, 1 );
       if( xmlstring ) {
@@ -1823,6 +1981,13 @@ parse_xml( xmlDocPtr doc, settings_info *settings )
         xmlFree( xmlstring );
       }
     } else
+    if( !strcmp( (const char*)node->name, "runahead" ) ) {
+      xmlstring = xmlNodeListGetString( doc, node->xmlChildrenNode, 1 );
+      if( xmlstring ) {
+        settings->run_ahead = atoi( (char*)xmlstring );
+        xmlFree( xmlstring );
+      }
+    } else
     if( !strcmp( (const char*)node->name, "rzxautosaves" ) ) {
       xmlstring = xmlNodeListGetString( doc, node->xmlChildrenNode, 1 );
       if( xmlstring ) {
@@ -1837,6 +2002,20 @@ parse_xml( xmlDocPtr doc, settings_info *settings )
         xmlFree( xmlstring );
       }
     } else
+    if( !strcmp( (const char*)node->name, "rzxstream" ) ) {
+      xmlstring = xmlNodeListGetString( doc, node->xmlChildrenNode, 1 );
+      if( xmlstring ) {
+        settings->rzx_stream = atoi( (char*)xmlstring );
+        xmlFree( xmlstring );
+      }
+    } else
+    if( !strcmp( (const char*)node->name, "rzxstreamframes" ) ) {
+      xmlstring = xmlNodeListGetString( doc, node->xmlChildrenNode, 1 );
+      if( xmlstring ) {
+        settings->rzx_stream_frames = atoi( (char*)xmlstring );
+        xmlFree( xmlstring );
+      }
+    } else
     if( !strcmp( (const char*)node->name, "sdlfullscreenmode" ) ) {
       xmlstring = xmlNodeListGetString( doc, node->xmlChildrenNode, 1 );
       if( xmlstring ) {
@@ -1930,6 +2109,13 @@ parse_xml( xmlDocPtr doc, settings_info *settings )
         xmlFree( xmlstring );
       }
     } else
+    if( !strcmp( (const char*)node->name, "soundthread" ) ) {
+      xmlstring = xmlNodeListGetString( doc, node->xmlChildrenNode, 1 );
+      if( xmlstring ) {
+        settings->sound_thread = atoi( (char*)xmlstring );
+        xmlFree( xmlstring );
+      }
+    } else
     if( !strcmp( (const char*)node->name, "speakertype" ) ) {
       xmlstring = xmlNodeListGetString( doc, node->xmlChildrenNode, 1 );
       if( xmlstring ) {
@@ -1990,6 +2176,36 @@ parse_xml( xmlDocPtr doc, settings_info *settings )
         xmlFree( xmlstring );
       }
     } else
+    if( !strcmp( (const char*)node->name, "startupprofile" ) ) {
+      xmlstring = xmlNodeListGetString( doc, node->xmlChildrenNode, 1 );
+      if( xmlstring ) {
+        settings->startup_profile = atoi( (char*)xmlstring );
+        xmlFree( xmlstring );
+      }
+    } else
+    if( !strcmp( (const char*)node->name, "stateframes" ) ) {
+      xmlstring = xmlNodeListGetString( doc, node->xmlChildrenNode, 1 );
+      if( xmlstring ) {
+        settings->state_frames = atoi( (char*)xmlstring );
+        xmlFree( xmlstring );
+      }
+    } else
+    if( !strcmp( (const char*)node->name, "stategolden" ) ) {
+      xmlstring = xmlNodeListGetString( doc, node->xmlChildrenNode, 1 );
+      if( xmlstring ) {
+        libspectrum_free( settings->state_golden );
+        settings->state_golden = utils_safe_strdup( (char*)xmlstring );
+        xmlFree( xmlstring );
+      }
+    } else
+    if( !strcmp( (const char*)node->name, "statelog" ) ) {
+      xmlstring = xmlNodeListGetString( doc, node->xmlChildrenNode, 1 );
+      if( xmlstring ) {
+        libspectrum_free( settings->state_log );
+        settings->state_log = utils_safe_strdup( (char*)xmlstring );
+        xmlFree( xmlstring );
+      }
+    } else
     if( !strcmp( (const char*)node->name, "statusbar" ) ) {
       xmlstring = xmlNodeListGetString( doc, node->xmlChildrenNode, 1 );
       if( xmlstring ) {
@@ -2206,10 +2422,14 @@ settings_write_config( settings_info *settings )
   xmlNewTextChild( root, NULL, (const xmlChar*)"aspecthint", (const xmlChar*)(settings->aspect_hint ? "1" : "0") );
   xmlNewTextChild( root, NULL, (const xmlChar*)"autoload", (const xmlChar*)(settings->auto_load ? "1" : "0") );
   xmlNewTextChild( root, NULL, (const xmlChar*)"autosavesettings", (const xmlChar*)(settings->autosave_settings ? "1" : "0") );
+  xmlNewTextChild( root, NULL, (const xmlChar*)"benchmark", (const xmlChar*)(settings->benchmark ? "1" : "0") );
+  xmlNewTextChild( root, NULL, (const xmlChar*)"benchmarkoutput", (const xmlChar*)(settings->benchmark_output ? "1" : "0") );
   xmlNewTextChild( root, NULL, (const xmlChar*)"beta128", (const xmlChar*)(settings->beta128 ? "1" : "0") );
   xmlNewTextChild( root, NULL, (const xmlChar*)"beta12848boot", (const xmlChar*)(settings->beta128_48boot ? "1" : "0") );
   if( settings->betadisk_file )
     xmlNewTextChild( root, NULL, (const xmlChar*)"betadisk", (const xmlChar*)settings->betadisk_file );
+  if( settings->boot_cache )
+    xmlNewTextChild( root, NULL, (const xmlChar*)"bootcache", (const xmlChar*)settings->boot_cache );
   xmlNewTextChild( root, NULL, (const xmlChar*)"bwtv", (const xmlChar*)(settings->bw_tv ? "1" : "0") );
   snprintf( buffer, 80, "%d", settings->competition_code );
   xmlNewTextChild( root, NULL, (const xmlChar*)"competitioncode", (const xmlChar*)buffer );
@@ -2277,6 +2497,13 @@ settings_write_config( settings_info *settings )
   xmlNewTextChild( root, NULL, (const xmlChar*)"embedsnapshot", (const xmlChar*)(settings->embed_snapshot ? "1" : "0") );
   snprintf( buffer, 80, "%d", settings->emulation_speed );
   xmlNewTextChild( root, NULL, (const xmlChar*)"speed", (const xmlChar*)buffer );
+  if( settings->export_audio )
+    xmlNewTextChild( root, NULL, (const xmlChar*)"exportaudio", (const xmlChar*)settings->export_audio );
+  xmlNewTextChild( root, NULL, (const xmlChar*)"exportfullspeed", (const xmlChar*)(settings->export_full_speed ? "1" : "0") );
+  if( settings->export_scaler )
+    xmlNewTextChild( root, NULL, (const xmlChar*)"exportscaler", (const xmlChar*)settings->export_scaler );
+  if( settings->export_video )
+    xmlNewTextChild( root, NULL, (const xmlChar*)"exportvideo", (const xmlChar*)settings->export_video );
   xmlNewTextChild( root, NULL, (const xmlChar*)"fastload", (const xmlChar*)(settings->fastload ? "1" : "0") );
   snprintf( buffer, 80, "%d", settings->fb_mode );
   xmlNewTextChild( root, NULL, (const xmlChar*)"fbmode", (const xmlChar*)buffer );
@@ -2284,6 +2511,11 @@ settings_write_config( settings_info *settings )
   xmlNewTextChild( root, NULL, (const xmlChar*)"rate", (const xmlChar*)buffer );
   xmlNewTextChild( root, NULL, (const xmlChar*)"fullscreen", (const xmlChar*)(settings->full_screen ? "1" : "0") );
   xmlNewTextChild( root, NULL, (const xmlChar*)"fuller", (const xmlChar*)(settings->fuller ? "1" : "0") );
+  xmlNewTextChild( root, NULL, (const xmlChar*)"fuzz", (const xmlChar*)(settings->fuzz ? "1" : "0") );
+  snprintf( buffer, 80, "%d", settings->fuzz_frames );
+  xmlNewTextChild( root, NULL, (const xmlChar*)"fuzzframes", (const xmlChar*)buffer );
+  snprintf( buffer, 80, "%d", settings->fuzz_run_length );
+  xmlNewTextChild( root, NULL, (const xmlChar*)"fuzzrunlength", (const xmlChar*)buffer );
   if( settings->if2_file )
     xmlNewTextChild( root, NULL, (const xmlChar*)"if2cart", (const xmlChar*)settings->if2_file );
   xmlNewTextChild( root, NULL, (const xmlChar*)"interface1", (const xmlChar*)(settings->interface1 ? "1" : "0") );
@@ -2397,6 +2629,7 @@ settings_write_config( settings_info *settings )
   xmlNewTextChild( root, NULL, (const xmlChar*)"mouseswapbuttons", (const xmlChar*)(settings->mouse_swap_buttons ? "1" : "0") );
   if( settings->movie_compr )
     xmlNewTextChild( root, NULL, (const xmlChar*)"moviecompr", (const xmlChar*)settings->movie_compr );
+  xmlNewTextChild( root, NULL, (const xmlChar*)"moviecomprfast", (const xmlChar*)(settings->movie_compr_fast ? "1" : "0") );
   if( settings->movie_start )
     xmlNewTextChild( root, NULL, (const xmlChar*)"moviestart", (const xmlChar*)settings->movie_start );
   xmlNewTextChild( root, NULL, (const xmlChar*)"moviestopafterrzx", (const xmlChar*)(settings->movie_stop_after_rzx ? "1" : "0") );
@@ -2404,10 +2637,21 @@ settings_write_config( settings_info *settings )
   xmlNewTextChild( root, NULL, (const xmlChar*)"multiface128", (const xmlChar*)(settings->multiface128 ? "1" : "0") );
   xmlNewTextChild( root, NULL, (const xmlChar*)"multiface1stealth", (const xmlChar*)(settings->multiface1_stealth ? "1" : "0") );
   xmlNewTextChild( root, NULL, (const xmlChar*)"multiface3", (const xmlChar*)(settings->multiface3 ? "1" : "0") );
+  snprintf( buffer, 80, "%d", settings->netplay_delay );
+  xmlNewTextChild( root, NULL, (const xmlChar*)"netplaydelay", (const xmlChar*)buffer );
+  if( settings->netplay_peer )
+    xmlNewTextChild( root, NULL, (const xmlChar*)"netplaypeer", (const xmlChar*)settings->netplay_peer );
+  snprintf( buffer, 80, "%d", settings->netplay_port );
+  xmlNewTextChild( root, NULL, (const xmlChar*)"netplayport", (const xmlChar*)buffer );
+  snprintf( buffer, 80, "%d", settings->netplay_rollback );
+  xmlNewTextChild( root, NULL, (const xmlChar*)"netplayrollback", (const xmlChar*)buffer );
   xmlNewTextChild( root, NULL, (const xmlChar*)"opus", (const xmlChar*)(settings->opus ? "1" : "0") );
   if( settings->opusdisk_file )
     xmlNewTextChild( root, NULL, (const xmlChar*)"opusdisk", (const xmlChar*)settings->opusdisk_file );
   xmlNewTextChild( root, NULL, (const xmlChar*)"paltv2x", (const xmlChar*)(settings->pal_tv2x ? "1" : "0") );
+  xmlNewTextChild( root, NULL, (const xmlChar*)"perfstats", (const xmlChar*)(settings->perfstats ? "1" : "0") );
+  if( settings->perfstats_file )
+    xmlNewTextChild( root, NULL, (const xmlChar*)"perfstatsfile", (const xmlChar*)settings->perfstats_file );
   if( settings->phantom_typist_mode )
     xmlNewTextChild( root, NULL, (const xmlChar*)"phantomtypistmode", (const xmlChar*)settings->phantom_typist_mode );
   if( settings->playback_file )
@@ -2418,6 +2662,7 @@ settings_write_config( settings_info *settings )
   xmlNewTextChild( root, NULL, (const xmlChar*)"plusd", (const xmlChar*)(settings->plusd ? "1" : "0") );
   if( settings->plusddisk_file )
     xmlNewTextChild( root, NULL, (const xmlChar*)"plusddisk", (const xmlChar*)settings->plusddisk_file );
+  xmlNewTextChild( root, NULL, (const xmlChar*)"predecodecache", (const xmlChar*)(settings->predecode_cache ? "1" : "0") );
   xmlNewTextChild( root, NULL, (const xmlChar*)"printer", (const xmlChar*)(settings->printer ? "1" : "0") );
   if( settings->printer_graphics_filename )
     xmlNewTextChild( root, NULL, (const xmlChar*)"graphicsfile", (const xmlChar*)settings->printer_graphics_filename );
@@ -2534,8 +2779,13 @@ settings_write_config( settings_info *settings )
     xmlNewTextChild( root, NULL, (const xmlChar*)"rs232rx", (const xmlChar*)settings->rs232_rx );
   if( settings->rs232_tx )
     xmlNewTextChild( root, NULL, (const xmlChar*)"rs232tx", (const xmlChar*)settings->rs232_tx );
+  snprintf( buffer, 80, "%d", settings->run_ahead );
+  xmlNewTextChild( root, NULL, (const xmlChar*)"runahead", (const xmlChar*)buffer );
   xmlNewTextChild( root, NULL, (const xmlChar*)"rzxautosaves", (const xmlChar*)(settings->rzx_autosaves ? "1" : "0") );
   xmlNewTextChild( root, NULL, (const xmlChar*)"compressrzx", (const xmlChar*)(settings->rzx_compression ? "1" : "0") );
+  xmlNewTextChild( root, NULL, (const xmlChar*)"rzxstream", (const xmlChar*)(settings->rzx_stream ? "1" : "0") );
+  snprintf( buffer, 80, "%d", settings->rzx_stream_frames );
+  xmlNewTextChild( root, NULL, (const xmlChar*)"rzxstreamframes", (const xmlChar*)buffer );
   if( settings->sdl_fullscreen_mode )
     xmlNewTextChild( root, NULL, (const xmlChar*)"sdlfullscreenmode", (const xmlChar*)settings->sdl_fullscreen_mode );
   xmlNewTextChild( root, NULL, (const xmlChar*)"simpleide", (const xmlChar*)(settings->simpleide_active ? "1" : "0") );
@@ -2555,6 +2805,7 @@ settings_write_config( settings_info *settings )
   snprintf( buffer, 80, "%d", settings->sound_freq );
   xmlNewTextChild( root, NULL, (const xmlChar*)"soundfreq", (const xmlChar*)buffer );
   xmlNewTextChild( root, NULL, (const xmlChar*)"loadingsound", (const xmlChar*)(settings->sound_load ? "1" : "0") );
+  xmlNewTextChild( root, NULL, (const xmlChar*)"soundthread", (const xmlChar*)(settings->sound_thread ? "1" : "0") );
   if( settings->speaker_type )
     xmlNewTextChild( root, NULL, (const xmlChar*)"speakertype", (const xmlChar*)settings->speaker_type );
   xmlNewTextChild( root, NULL, (const xmlChar*)"speccyboot", (const xmlChar*)(settings->speccyboot ? "1" : "0") );
@@ -2567,6 +2818,13 @@ settings_write_config( settings_info *settings )
     xmlNewTextChild( root, NULL, (const xmlChar*)"machine", (const xmlChar*)settings->start_machine );
   if( settings->start_scaler_mode )
     xmlNewTextChild( root, NULL, (const xmlChar*)"graphicsfilter", (const xmlChar*)settings->start_scaler_mode );
+  xmlNewTextChild( root, NULL, (const xmlChar*)"startupprofile", (const xmlChar*)(settings->startup_profile ? "1" : "0") );
+  snprintf( buffer, 80, "%d", settings->state_frames );
+  xmlNewTextChild( root, NULL, (const xmlChar*)"stateframes", (const xmlChar*)buffer );
+  if( settings->state_golden )
+    xmlNewTextChild( root, NULL, (const xmlChar*)"stategolden", (const xmlChar*)settings->state_golden );
+  if( settings->state_log )
+    xmlNewTextChild( root, NULL, (const xmlChar*)"statelog", (const xmlChar*)settings->state_log );
   xmlNewTextChild( root, NULL, (const xmlChar*)"statusbar", (const xmlChar*)(settings->statusbar ? "1" : "0") );
   if( settings->stereo_ay )
     xmlNewTextChild( root, NULL, (const xmlChar*)"separation", (const xmlChar*)settings->stereo_ay );
@@ -2699,6 +2957,14 @@ settings_var( settings_info *settings, unsigned char *name, unsigned char *last,
     *val_int = &settings->autosave_settings;
     return 0;
   }
+  if( n == 9 && !strncmp( (const char *)name, "benchmark", n ) ) {
+    *val_int = &settings->benchmark;
+    return 0;
+  }
+  if( n == 15 && !strncmp( (const char *)name, "benchmarkoutput", n ) ) {
+    *val_int = &settings->benchmark_output;
+    return 0;
+  }
   if( n == 7 && !strncmp( (const char *)name, "beta128", n ) ) {
     *val_int = &settings->beta128;
     return 0;
@@ -2711,6 +2977,10 @@ settings_var( settings_info *settings, unsigned char *name, unsigned char *last,
     *val_char = &settings->betadisk_file;
     return 0;
   }
+  if( n == 9 && !strncmp( (const char *)name, "bootcache", n ) ) {
+    *val_char = &settings->boot_cache;
+    return 0;
+  }
   if( n == 4 && !strncmp( (const char *)name, "bwtv", n ) ) {
     *val_int = &settings->bw_tv;
     return 0;
@@ -2875,6 +3145,22 @@ settings_var( settings_info *settings, unsigned char *name, unsigned char *last,
     *val_int = &settings->emulation_speed;
     return 0;
   }
+  if( n == 11 && !strncmp( (const char *)name, "exportaudio", n ) ) {
+    *val_char = &settings->export_audio;
+    return 0;
+  }
+  if( n == 15 && !strncmp( (const char *)name, "exportfullspeed", n ) ) {
+    *val_int = &settings->export_full_speed;
+    return 0;
+  }
+  if( n == 12 && !strncmp( (const char *)name, "exportscaler", n ) ) {
+    *val_char = &settings->export_scaler;
+    return 0;
+  }
+  if( n == 11 && !strncmp( (const char *)name, "exportvideo", n ) ) {
+    *val_char = &settings->export_video;
+    return 0;
+  }
   if( n == 8 && !strncmp( (const char *)name, "fastload", n ) ) {
     *val_int = &settings->fastload;
     return 0;
@@ -2895,6 +3181,18 @@ settings_var( settings_info *settings, unsigned char *name, unsigned char *last,
     *val_int = &settings->fuller;
     return 0;
   }
+  if( n == 4 && !strncmp( (const char *)name, "fuzz", n ) ) {
+    *val_int = &settings->fuzz;
+    return 0;
+  }
+  if( n == 10 && !strncmp( (const char *)name, "fuzzframes", n ) ) {
+    *val_int = &settings->fuzz_frames;
+    return 0;
+  }
+  if( n == 13 && !strncmp( (const char *)name, "fuzzrunlength", n ) ) {
+    *val_int = &settings->fuzz_run_length;
+    return 0;
+  }
   if( n == 7 && !strncmp( (const char *)name, "if2cart", n ) ) {
     *val_char = &settings->if2_file;
     return 0;
@@ -3143,6 +3441,10 @@ settings_var( settings_info *settings, unsigned char *name, unsigned char *last,
     *val_char = &settings->movie_compr;
     return 0;
   }
+  if( n == 14 && !strncmp( (const char *)name, "moviecomprfast", n ) ) {
+    *val_int = &settings->movie_compr_fast;
+    return 0;
+  }
   if( n == 10 && !strncmp( (const char *)name, "moviestart", n ) ) {
     *val_char = &settings->movie_start;
     return 0;
@@ -3167,6 +3469,22 @@ settings_var( settings_info *settings, unsigned char *name, unsigned char *last,
     *val_int = &settings->multiface3;
     return 0;
   }
+  if( n == 12 && !strncmp( (const char *)name, "netplaydelay", n ) ) {
+    *val_int = &settings->netplay_delay;
+    return 0;
+  }
+  if( n == 11 && !strncmp( (const char *)name, "netplaypeer", n ) ) {
+    *val_char = &settings->netplay_peer;
+    return 0;
+  }
+  if( n == 11 && !strncmp( (const char *)name, "netplayport", n ) ) {
+    *val_int = &settings->netplay_port;
+    return 0;
+  }
+  if( n == 15 && !strncmp( (const char *)name, "netplayrollback", n ) ) {
+    *val_int = &settings->netplay_rollback;
+    return 0;
+  }
   if( n == 4 && !strncmp( (const char *)name, "opus", n ) ) {
     *val_int = &settings->opus;
     return 0;
@@ -3179,6 +3497,14 @@ settings_var( settings_info *settings, unsigned char *name, unsigned char *last,
     *val_int = &settings->pal_tv2x;
     return 0;
   }
+  if( n == 9 && !strncmp( (const char *)name, "perfstats", n ) ) {
+    *val_int = &settings->perfstats;
+    return 0;
+  }
+  if( n == 13 && !strncmp( (const char *)name, "perfstatsfile", n ) ) {
+    *val_char = &settings->perfstats_file;
+    return 0;
+  }
   if( n == 17 && !strncmp( (const char *)name, "phantomtypistmode", n ) ) {
     *val_char = &settings->phantom_typist_mode;
     return 0;
@@ -3203,6 +3529,10 @@ settings_var( settings_info *settings, unsigned char *name, unsigned char *last,
     *val_char = &settings->plusddisk_file;
     return 0;
   }
+  if( n == 14 && !strncmp( (const char *)name, "predecodecache", n ) ) {
+    *val_int = &settings->predecode_cache;
+    return 0;
+  }
   if( n == 7 && !strncmp( (const char *)name, "printer", n ) ) {
     *val_int = &settings->printer;
     return 0;
@@ -3447,6 +3777,10 @@ settings_var( settings_info *settings, unsigned char *name, unsigned char *last,
     *val_char = &settings->rs232_tx;
     return 0;
   }
+  if( n == 8 && !strncmp( (const char *)name, "runahead", n ) ) {
+    *val_int = &settings->run_ahead;
+    return 0;
+  }
   if( n == 12 && !strncmp( (const char *)name, "rzxautosaves", n ) ) {
     *val_int = &settings->rzx_autosaves;
     return 0;
@@ -3455,6 +3789,14 @@ settings_var( settings_info *settings, unsigned char *name, unsigned char *last,
     *val_int = &settings->rzx_compression;
     return 0;
   }
+  if( n == 9 && !strncmp( (const char *)name, "rzxstream", n ) ) {
+    *val_int = &settings->rzx_stream;
+    return 0;
+  }
+  if( n == 15 && !strncmp( (const char *)name, "rzxstreamframes", n ) ) {
+    *val_int = &settings->rzx_stream_frames;
+    return 0;
+  }
   if( n == 17 && !strncmp( (const char *)name, "sdlfullscreenmode", n ) ) {
     *val_char = &settings->sdl_fullscreen_mode;
     return 0;
@@ -3507,6 +3849,10 @@ settings_var( settings_info *settings, unsigned char *name, unsigned char *last,
     *val_int = &settings->sound_load;
     return 0;
   }
+  if( n == 11 && !strncmp( (const char *)name, "soundthread", n ) ) {
+    *val_int = &settings->sound_thread;
+    return 0;
+  }
   if( n == 11 && !strncmp( (const char *)name, "speakertype", n ) ) {
     *val_char = &settings->speaker_type;
     return 0;
@@ -3539,6 +3885,22 @@ settings_var( settings_info *settings, unsigned char *name, unsigned char *last,
     *val_char = &settings->start_scaler_mode;
     return 0;
   }
+  if( n == 14 && !strncmp( (const char *)name, "startupprofile", n ) ) {
+    *val_int = &settings->startup_profile;
+    return 0;
+  }
+  if( n == 11 && !strncmp( (const char *)name, "stateframes", n ) ) {
+    *val_int = &settings->state_frames;
+    return 0;
+  }
+  if( n == 11 && !strncmp( (const char *)name, "stategolden", n ) ) {
+    *val_char = &settings->state_golden;
+    return 0;
+  }
+  if( n == 8 && !strncmp( (const char *)name, "statelog", n ) ) {
+    *val_char = &settings->state_log;
+    return 0;
+  }
   if( n == 9 && !strncmp( (const char *)name, "statusbar", n ) ) {
     *val_int = &settings->statusbar;
     return 0;
@@ -3754,6 +4116,12 @@ settings_write_config( settings_info *settings )
   if( settings_boolean_write( doc, "autosavesettings",
                               settings->autosave_settings ) )
     goto error;
+  if( settings_boolean_write( doc, "benchmark",
+                              settings->benchmark ) )
+    goto error;
+  if( settings_boolean_write( doc, "benchmarkoutput",
+                              settings->benchmark_output ) )
+    goto error;
   if( settings_boolean_write( doc, "beta128",
                               settings->beta128 ) )
     goto error;
@@ -3763,6 +4131,9 @@ settings_write_config( settings_info *settings )
   if( settings_string_write( doc, "betadisk",
                              settings->betadisk_file ) )
     goto error;
+  if( settings_string_write( doc, "bootcache",
+                             settings->boot_cache ) )
+    goto error;
   if( settings_boolean_write( doc, "bwtv",
                               settings->bw_tv ) )
     goto error;
@@ -3883,6 +4254,18 @@ settings_write_config( settings_info *settings )
   if( settings_numeric_write( doc, "speed",
                               settings->emulation_speed ) )
     goto error;
+  if( settings_string_write( doc, "exportaudio",
+                             settings->export_audio ) )
+    goto error;
+  if( settings_boolean_write( doc, "exportfullspeed",
+                              settings->export_full_speed ) )
+    goto error;
+  if( settings_string_write( doc, "exportscaler",
+                             settings->export_scaler ) )
+    goto error;
+  if( settings_string_write( doc, "exportvideo",
+                             settings->export_video ) )
+    goto error;
   if( settings_boolean_write( doc, "fastload",
                               settings->fastload ) )
     goto error;
@@ -3898,6 +4281,15 @@ settings_write_config( settings_info *settings )
   if( settings_boolean_write( doc, "fuller",
                               settings->fuller ) )
     goto error;
+  if( settings_boolean_write( doc, "fuzz",
+                              settings->fuzz ) )
+    goto error;
+  if( settings_numeric_write( doc, "fuzzframes",
+                              settings->fuzz_frames ) )
+    goto error;
+  if( settings_numeric_write( doc, "fuzzrunlength",
+                              settings->fuzz_run_length ) )
+    goto error;
   if( settings_string_write( doc, "if2cart",
                              settings->if2_file ) )
     goto error;
@@ -4084,6 +4476,9 @@ settings_write_config( settings_info *settings )
   if( settings_string_write( doc, "moviecompr",
                              settings->movie_compr ) )
     goto error;
+  if( settings_boolean_write( doc, "moviecomprfast",
+                              settings->movie_compr_fast ) )
+    goto error;
   if( settings_string_write( doc, "moviestart",
                              settings->movie_start ) )
     goto error;
@@ -4102,6 +4497,18 @@ settings_write_config( settings_info *settings )
   if( settings_boolean_write( doc, "multiface3",
                               settings->multiface3 ) )
     goto error;
+  if( settings_numeric_write( doc, "netplaydelay",
+                              settings->netplay_delay ) )
+    goto error;
+  if( settings_string_write( doc, "netplaypeer",
+                             settings->netplay_peer ) )
+    goto error;
+  if( settings_numeric_write( doc, "netplayport",
+                              settings->netplay_port ) )
+    goto error;
+  if( settings_numeric_write( doc, "netplayrollback",
+                              settings->netplay_rollback ) )
+    goto error;
   if( settings_boolean_write( doc, "opus",
                               settings->opus ) )
     goto error;
@@ -4111,6 +4518,12 @@ settings_write_config( settings_info *settings )
   if( settings_boolean_write( doc, "paltv2x",
                               settings->pal_tv2x ) )
     goto error;
+  if( settings_boolean_write( doc, "perfstats",
+                              settings->perfstats ) )
+    goto error;
+  if( settings_string_write( doc, "perfstatsfile",
+                             settings->perfstats_file ) )
+    goto error;
   if( settings_string_write( doc, "phantomtypistmode",
                              settings->phantom_typist_mode ) )
     goto error;
@@ -4129,6 +4542,9 @@ settings_write_config( settings_info *settings )
   if( settings_string_write( doc, "plusddisk",
                              settings->plusddisk_file ) )
     goto error;
+  if( settings_boolean_write( doc, "predecodecache",
+                              settings->predecode_cache ) )
+    goto error;
   if( settings_boolean_write( doc, "printer",
                               settings->printer ) )
     goto error;
@@ -4309,12 +4725,21 @@ settings_write_config( settings_info *settings )
   if( settings_string_write( doc, "rs232tx",
                              settings->rs232_tx ) )
     goto error;
+  if( settings_numeric_write( doc, "runahead",
+                              settings->run_ahead ) )
+    goto error;
   if( settings_boolean_write( doc, "rzxautosaves",
                               settings->rzx_autosaves ) )
     goto error;
   if( settings_boolean_write( doc, "compressrzx",
                               settings->rzx_compression ) )
     goto error;
+  if( settings_boolean_write( doc, "rzxstream",
+                              settings->rzx_stream ) )
+    goto error;
+  if( settings_numeric_write( doc, "rzxstreamframes",
+                              settings->rzx_stream_frames ) )
+    goto error;
   if( settings_string_write( doc, "sdlfullscreenmode",
                              settings->sdl_fullscreen_mode ) )
     goto error;
@@ -4351,6 +4776,9 @@ settings_write_config( settings_info *settings )
   if( settings_boolean_write( doc, "loadingsound",
                               settings->sound_load ) )
     goto error;
+  if( settings_boolean_write( doc, "soundthread",
+                              settings->sound_thread ) )
+    goto error;
   if( settings_string_write( doc, "speakertype",
                              settings->speaker_type ) )
     goto error;
@@ -4375,6 +4803,18 @@ settings_write_config( settings_info *settings )
   if( settings_string_write( doc, "graphicsfilter",
                              settings->start_scaler_mode ) )
     goto error;
+  if( settings_boolean_write( doc, "startupprofile",
+                              settings->startup_profile ) )
+    goto error;
+  if( settings_numeric_write( doc, "stateframes",
+                              settings->state_frames ) )
+    goto error;
+  if( settings_string_write( doc, "stategolden",
+                             settings->state_golden ) )
+    goto error;
+  if( settings_string_write( doc, "statelog",
+                             settings->state_log ) )
+    goto error;
   if( settings_boolean_write( doc, "statusbar",
                               settings->statusbar ) )
     goto error;
@@ -4485,73 +4925,87 @@ settings_command_line( settings_info *settings, int *first_arg,
     { "no-auto-load", 0, &(settings->auto_load), 0 },
     {    "autosave-settings", 0, &(settings->autosave_settings), 1 },
     { "no-autosave-settings", 0, &(settings->autosave_settings), 0 },
+    {    "benchmark", 0, &(settings->benchmark), 1 },
+    { "no-benchmark", 0, &(settings->benchmark), 0 },
+    {    "benchmark-output", 0, &(settings->benchmark_output), 1 },
+    { "no-benchmark-output", 0, &(settings->benchmark_output), 0 },
     {    "beta128", 0, &(settings->beta128), 1 },
     { "no-beta128", 0, &(settings->beta128), 0 },
     {    "beta128-48boot", 0, &(settings->beta128_48boot), 1 },
     { "no-beta128-48boot", 0, &(settings->beta128_48boot), 0 },
     { "betadisk", 1, NULL, 256 },
+    { "boot-cache", 1, NULL, 257 },
     {    "bw-tv", 0, &(settings->bw_tv), 1 },
     { "no-bw-tv", 0, &(settings->bw_tv), 0 },
-    { "competition-code", 1, NULL, 257 },
+    { "competition-code", 1, NULL, 258 },
     {    "competition-mode", 0, &(settings->competition_mode), 1 },
     { "no-competition-mode", 0, &(settings->competition_mode), 0 },
     {    "confirm-actions", 0, &(settings->confirm_actions), 1 },
     { "no-confirm-actions", 0, &(settings->confirm_actions), 0 },
     {    "covox", 0, &(settings->covox), 1 },
     { "no-covox", 0, &(settings->covox), 0 },
-    { "dock", 1, NULL, 258 },
-    { "debugger-command", 1, NULL, 259 },
+    { "dock", 1, NULL, 259 },
+    { "debugger-command", 1, NULL, 260 },
     {    "detect-loader", 0, &(settings->detect_loader), 1 },
     { "no-detect-loader", 0, &(settings->detect_loader), 0 },
     {    "didaktik80", 0, &(settings->didaktik80), 1 },
     { "no-didaktik80", 0, &(settings->didaktik80), 0 },
-    { "didaktik80disk", 1, NULL, 260 },
+    { "didaktik80disk", 1, NULL, 261 },
     {    "disciple", 0, &(settings->disciple), 1 },
     { "no-disciple", 0, &(settings->disciple), 0 },
-    { "discipledisk", 1, NULL, 261 },
+    { "discipledisk", 1, NULL, 262 },
     {    "disk-ask-merge", 0, &(settings->disk_ask_merge), 1 },
     { "no-disk-ask-merge", 0, &(settings->disk_ask_merge), 0 },
-    { "disk-try-merge", 1, NULL, 262 },
+    { "disk-try-merge", 1, NULL, 263 },
     {    "divide", 0, &(settings->divide_enabled), 1 },
     { "no-divide", 0, &(settings->divide_enabled), 0 },
-    { "divide-masterfile", 1, NULL, 263 },
-    { "divide-slavefile", 1, NULL, 264 },
+    { "divide-masterfile", 1, NULL, 264 },
+    { "divide-slavefile", 1, NULL, 265 },
     {    "divide-write-protect", 0, &(settings->divide_wp), 1 },
     { "no-divide-write-protect", 0, &(settings->divide_wp), 0 },
     {    "divmmc", 0, &(settings->divmmc_enabled), 1 },
     { "no-divmmc", 0, &(settings->divmmc_enabled), 0 },
-    { "divmmc-file", 1, NULL, 265 },
+    { "divmmc-file", 1, NULL, 266 },
     {    "divmmc-write-protect", 0, &(settings->divmmc_wp), 1 },
     { "no-divmmc-write-protect", 0, &(settings->divmmc_wp), 0 },
     { "doublescan-mode", 1, NULL, 'D' },
-    { "drive-40-max-track", 1, NULL, 267 },
-    { "drive-80-max-track", 1, NULL, 268 },
-    { "drive-beta128a-type", 1, NULL, 269 },
-    { "drive-beta128b-type", 1, NULL, 270 },
-    { "drive-beta128c-type", 1, NULL, 271 },
-    { "drive-beta128d-type", 1, NULL, 272 },
-    { "drive-didaktik80a-type", 1, NULL, 273 },
-    { "drive-didaktik80b-type", 1, NULL, 274 },
-    { "drive-disciple1-type", 1, NULL, 275 },
-    { "drive-disciple2-type", 1, NULL, 276 },
-    { "drive-opus1-type", 1, NULL, 277 },
-    { "drive-opus2-type", 1, NULL, 278 },
-    { "drive-plus3a-type", 1, NULL, 279 },
-    { "drive-plus3b-type", 1, NULL, 280 },
-    { "drive-plusd1-type", 1, NULL, 281 },
-    { "drive-plusd2-type", 1, NULL, 282 },
+    { "drive-40-max-track", 1, NULL, 268 },
+    { "drive-80-max-track", 1, NULL, 269 },
+    { "drive-beta128a-type", 1, NULL, 270 },
+    { "drive-beta128b-type", 1, NULL, 271 },
+    { "drive-beta128c-type", 1, NULL, 272 },
+    { "drive-beta128d-type", 1, NULL, 273 },
+    { "drive-didaktik80a-type", 1, NULL, 274 },
+    { "drive-didaktik80b-type", 1, NULL, 275 },
+    { "drive-disciple1-type", 1, NULL, 276 },
+    { "drive-disciple2-type", 1, NULL, 277 },
+    { "drive-opus1-type", 1, NULL, 278 },
+    { "drive-opus2-type", 1, NULL, 279 },
+    { "drive-plus3a-type", 1, NULL, 280 },
+    { "drive-plus3b-type", 1, NULL, 281 },
+    { "drive-plusd1-type", 1, NULL, 282 },
+    { "drive-plusd2-type", 1, NULL, 283 },
     {    "embed-snapshot", 0, &(settings->embed_snapshot), 1 },
     { "no-embed-snapshot", 0, &(settings->embed_snapshot), 0 },
-    { "speed", 1, NULL, 283 },
+    { "speed", 1, NULL, 284 },
+    { "export-audio", 1, NULL, 285 },
+    {    "export-full-speed", 0, &(settings->export_full_speed), 1 },
+    { "no-export-full-speed", 0, &(settings->export_full_speed), 0 },
+    { "export-scaler", 1, NULL, 286 },
+    { "export-video", 1, NULL, 287 },
     {    "fastload", 0, &(settings->fastload), 1 },
     { "no-fastload", 0, &(settings->fastload), 0 },
     { "fbmode", 1, NULL, 'v' },
-    { "rate", 1, NULL, 284 },
+    { "rate", 1, NULL, 288 },
     {    "full-screen", 0, &(settings->full_screen), 1 },
     { "no-full-screen", 0, &(settings->full_screen), 0 },
     {    "fuller", 0, &(settings->fuller), 1 },
     { "no-fuller", 0, &(settings->fuller), 0 },
-    { "if2cart", 1, NULL, 285 },
+    {    "fuzz", 0, &(settings->fuzz), 1 },
+    { "no-fuzz", 0, &(settings->fuzz), 0 },
+    { "fuzz-frames", 1, NULL, 289 },
+    { "fuzz-run-length", 1, NULL, 290 },
+    { "if2cart", 1, NULL, 291 },
     {    "interface1", 0, &(settings->interface1), 1 },
     { "no-interface1", 0, &(settings->interface1), 0 },
     {    "interface2", 0, &(settings->interface2), 1 },
@@ -4563,68 +5017,70 @@ settings_command_line( settings_info *settings, int *first_arg,
     {    "joystick-prompt", 0, &(settings->joy_prompt), 1 },
     { "no-joystick-prompt", 0, &(settings->joy_prompt), 0 },
     { "joystick-1", 1, NULL, 'j' },
-    { "joystick-1-fire-1", 1, NULL, 286 },
-    { "joystick-1-fire-10", 1, NULL, 287 },
-    { "joystick-1-fire-11", 1, NULL, 288 },
-    { "joystick-1-fire-12", 1, NULL, 289 },
-    { "joystick-1-fire-13", 1, NULL, 290 },
-    { "joystick-1-fire-14", 1, NULL, 291 },
-    { "joystick-1-fire-15", 1, NULL, 292 },
-    { "joystick-1-fire-2", 1, NULL, 293 },
-    { "joystick-1-fire-3", 1, NULL, 294 },
-    { "joystick-1-fire-4", 1, NULL, 295 },
-    { "joystick-1-fire-5", 1, NULL, 296 },
-    { "joystick-1-fire-6", 1, NULL, 297 },
-    { "joystick-1-fire-7", 1, NULL, 298 },
-    { "joystick-1-fire-8", 1, NULL, 299 },
-    { "joystick-1-fire-9", 1, NULL, 300 },
-    { "joystick-1-output", 1, NULL, 301 },
-    { "joystick-2", 1, NULL, 302 },
-    { "joystick-2-fire-1", 1, NULL, 303 },
-    { "joystick-2-fire-10", 1, NULL, 304 },
-    { "joystick-2-fire-11", 1, NULL, 305 },
-    { "joystick-2-fire-12", 1, NULL, 306 },
-    { "joystick-2-fire-13", 1, NULL, 307 },
-    { "joystick-2-fire-14", 1, NULL, 308 },
-    { "joystick-2-fire-15", 1, NULL, 309 },
-    { "joystick-2-fire-2", 1, NULL, 310 },
-    { "joystick-2-fire-3", 1, NULL, 311 },
-    { "joystick-2-fire-4", 1, NULL, 312 },
-    { "joystick-2-fire-5", 1, NULL, 313 },
-    { "joystick-2-fire-6", 1, NULL, 314 },
-    { "joystick-2-fire-7", 1, NULL, 315 },
-    { "joystick-2-fire-8", 1, NULL, 316 },
-    { "joystick-2-fire-9", 1, NULL, 317 },
-    { "joystick-2-output", 1, NULL, 318 },
-    { "joystick-keyboard-down", 1, NULL, 319 },
-    { "joystick-keyboard-fire", 1, NULL, 320 },
-    { "joystick-keyboard-left", 1, NULL, 321 },
-    { "joystick-keyboard-output", 1, NULL, 322 },
-    { "joystick-keyboard-right", 1, NULL, 323 },
-    { "joystick-keyboard-up", 1, NULL, 324 },
+    { "joystick-1-fire-1", 1, NULL, 292 },
+    { "joystick-1-fire-10", 1, NULL, 293 },
+    { "joystick-1-fire-11", 1, NULL, 294 },
+    { "joystick-1-fire-12", 1, NULL, 295 },
+    { "joystick-1-fire-13", 1, NULL, 296 },
+    { "joystick-1-fire-14", 1, NULL, 297 },
+    { "joystick-1-fire-15", 1, NULL, 298 },
+    { "joystick-1-fire-2", 1, NULL, 299 },
+    { "joystick-1-fire-3", 1, NULL, 300 },
+    { "joystick-1-fire-4", 1, NULL, 301 },
+    { "joystick-1-fire-5", 1, NULL, 302 },
+    { "joystick-1-fire-6", 1, NULL, 303 },
+    { "joystick-1-fire-7", 1, NULL, 304 },
+    { "joystick-1-fire-8", 1, NULL, 305 },
+    { "joystick-1-fire-9", 1, NULL, 306 },
+    { "joystick-1-output", 1, NULL, 307 },
+    { "joystick-2", 1, NULL, 308 },
+    { "joystick-2-fire-1", 1, NULL, 309 },
+    { "joystick-2-fire-10", 1, NULL, 310 },
+    { "joystick-2-fire-11", 1, NULL, 311 },
+    { "joystick-2-fire-12", 1, NULL, 312 },
+    { "joystick-2-fire-13", 1, NULL, 313 },
+    { "joystick-2-fire-14", 1, NULL, 314 },
+    { "joystick-2-fire-15", 1, NULL, 315 },
+    { "joystick-2-fire-2", 1, NULL, 316 },
+    { "joystick-2-fire-3", 1, NULL, 317 },
+    { "joystick-2-fire-4", 1, NULL, 318 },
+    { "joystick-2-fire-5", 1, NULL, 319 },
+    { "joystick-2-fire-6", 1, NULL, 320 },
+    { "joystick-2-fire-7", 1, NULL, 321 },
+    { "joystick-2-fire-8", 1, NULL, 322 },
+    { "joystick-2-fire-9", 1, NULL, 323 },
+    { "joystick-2-output", 1, NULL, 324 },
+    { "joystick-keyboard-down", 1, NULL, 325 },
+    { "joystick-keyboard-fire", 1, NULL, 326 },
+    { "joystick-keyboard-left", 1, NULL, 327 },
+    { "joystick-keyboard-output", 1, NULL, 328 },
+    { "joystick-keyboard-right", 1, NULL, 329 },
+    { "joystick-keyboard-up", 1, NULL, 330 },
     {    "kempston-mouse", 0, &(settings->kempston_mouse), 1 },
     { "no-kempston-mouse", 0, &(settings->kempston_mouse), 0 },
     {    "keyboard-arrows-shifted", 0, &(settings->keyboard_arrows_shifted), 1 },
     { "no-keyboard-arrows-shifted", 0, &(settings->keyboard_arrows_shifted), 0 },
     {    "late-timings", 0, &(settings->late_timings), 1 },
     { "no-late-timings", 0, &(settings->late_timings), 0 },
-    { "microdrive-file", 1, NULL, 325 },
-    { "microdrive-2-file", 1, NULL, 326 },
-    { "microdrive-3-file", 1, NULL, 327 },
-    { "microdrive-4-file", 1, NULL, 328 },
-    { "microdrive-5-file", 1, NULL, 329 },
-    { "microdrive-6-file", 1, NULL, 330 },
-    { "microdrive-7-file", 1, NULL, 331 },
-    { "microdrive-8-file", 1, NULL, 332 },
-    { "mdr-len", 1, NULL, 333 },
+    { "microdrive-file", 1, NULL, 331 },
+    { "microdrive-2-file", 1, NULL, 332 },
+    { "microdrive-3-file", 1, NULL, 333 },
+    { "microdrive-4-file", 1, NULL, 334 },
+    { "microdrive-5-file", 1, NULL, 335 },
+    { "microdrive-6-file", 1, NULL, 336 },
+    { "microdrive-7-file", 1, NULL, 337 },
+    { "microdrive-8-file", 1, NULL, 338 },
+    { "mdr-len", 1, NULL, 339 },
     {    "mdr-random-len", 0, &(settings->mdr_random_len), 1 },
     { "no-mdr-random-len", 0, &(settings->mdr_random_len), 0 },
     {    "melodik", 0, &(settings->melodik), 1 },
     { "no-melodik", 0, &(settings->melodik), 0 },
     {    "mouse-swap-buttons", 0, &(settings->mouse_swap_buttons), 1 },
     { "no-mouse-swap-buttons", 0, &(settings->mouse_swap_buttons), 0 },
-    { "movie-compr", 1, NULL, 334 },
-    { "movie-start", 1, NULL, 335 },
+    { "movie-compr", 1, NULL, 340 },
+    {    "movie-compr-fast", 0, &(settings->movie_compr_fast), 1 },
+    { "no-movie-compr-fast", 0, &(settings->movie_compr_fast), 0 },
+    { "movie-start", 1, NULL, 341 },
     {    "movie-stop-after-rzx", 0, &(settings->movie_stop_after_rzx), 1 },
     { "no-movie-stop-after-rzx", 0, &(settings->movie_stop_after_rzx), 0 },
     {    "multiface1", 0, &(settings->multiface1), 1 },
@@ -4635,96 +5091,109 @@ settings_command_line( settings_info *settings, int *first_arg,
     { "no-multiface1-stealth", 0, &(settings->multiface1_stealth), 0 },
     {    "multiface3", 0, &(settings->multiface3), 1 },
     { "no-multiface3", 0, &(settings->multiface3), 0 },
+    { "netplay-delay", 1, NULL, 342 },
+    { "netplay-peer", 1, NULL, 343 },
+    { "netplay-port", 1, NULL, 344 },
+    { "netplay-rollback", 1, NULL, 345 },
     {    "opus", 0, &(settings->opus), 1 },
     { "no-opus", 0, &(settings->opus), 0 },
-    { "opusdisk", 1, NULL, 336 },
+    { "opusdisk", 1, NULL, 346 },
     {    "pal-tv2x", 0, &(settings->pal_tv2x), 1 },
     { "no-pal-tv2x", 0, &(settings->pal_tv2x), 0 },
-    { "phantom-typist-mode", 1, NULL, 337 },
+    {    "perfstats", 0, &(settings->perfstats), 1 },
+    { "no-perfstats", 0, &(settings->perfstats), 0 },
+    { "perfstats-file", 1, NULL, 347 },
+    { "phantom-typist-mode", 1, NULL, 348 },
     { "playback", 1, NULL, 'p' },
     {    "plus3-detect-speedlock", 0, &(settings->plus3_detect_speedlock), 1 },
     { "no-plus3-detect-speedlock", 0, &(settings->plus3_detect_speedlock), 0 },
-    { "plus3disk", 1, NULL, 338 },
+    { "plus3disk", 1, NULL, 349 },
     {    "plusd", 0, &(settings->plusd), 1 },
     { "no-plusd", 0, &(settings->plusd), 0 },
-    { "plusddisk", 1, NULL, 339 },
+    { "plusddisk", 1, NULL, 350 },
+    {    "predecode-cache", 0, &(settings->predecode_cache), 1 },
+    { "no-predecode-cache", 0, &(settings->predecode_cache), 0 },
     {    "printer", 0, &(settings->printer), 1 },
     { "no-printer", 0, &(settings->printer), 0 },
-    { "graphicsfile", 1, NULL, 340 },
-    { "textfile", 1, NULL, 341 },
+    { "graphicsfile", 1, NULL, 351 },
+    { "textfile", 1, NULL, 352 },
     {    "raw-s-net", 0, &(settings->raw_s_net), 1 },
     { "no-raw-s-net", 0, &(settings->raw_s_net), 0 },
     { "record", 1, NULL, 'r' },
     {    "recreated-spectrum", 0, &(settings->recreated_spectrum), 1 },
     { "no-recreated-spectrum", 0, &(settings->recreated_spectrum), 0 },
-    { "rom-128-0", 1, NULL, 343 },
-    { "rom-128-1", 1, NULL, 344 },
-    { "rom-16", 1, NULL, 345 },
-    { "rom-48", 1, NULL, 346 },
-    { "rom-beta128", 1, NULL, 347 },
-    { "rom-didaktik80", 1, NULL, 348 },
-    { "rom-disciple", 1, NULL, 349 },
-    { "rom-interface-1", 1, NULL, 350 },
-    { "rom-multiface1", 1, NULL, 351 },
-    { "rom-multiface128", 1, NULL, 352 },
-    { "rom-multiface3", 1, NULL, 353 },
-    { "rom-opus", 1, NULL, 354 },
-    { "rom-pentagon1024-0", 1, NULL, 355 },
-    { "rom-pentagon1024-1", 1, NULL, 356 },
-    { "rom-pentagon1024-2", 1, NULL, 357 },
-    { "rom-pentagon1024-3", 1, NULL, 358 },
-    { "rom-pentagon512-0", 1, NULL, 359 },
-    { "rom-pentagon512-1", 1, NULL, 360 },
-    { "rom-pentagon512-2", 1, NULL, 361 },
-    { "rom-pentagon512-3", 1, NULL, 362 },
-    { "rom-pentagon-0", 1, NULL, 363 },
-    { "rom-pentagon-1", 1, NULL, 364 },
-    { "rom-pentagon-2", 1, NULL, 365 },
-    { "rom-plus2-0", 1, NULL, 366 },
-    { "rom-plus2-1", 1, NULL, 367 },
-    { "rom-plus2a-0", 1, NULL, 368 },
-    { "rom-plus2a-1", 1, NULL, 369 },
-    { "rom-plus2a-2", 1, NULL, 370 },
-    { "rom-plus2a-3", 1, NULL, 371 },
-    { "rom-plus3-0", 1, NULL, 372 },
-    { "rom-plus3-1", 1, NULL, 373 },
-    { "rom-plus3-2", 1, NULL, 374 },
-    { "rom-plus3-3", 1, NULL, 375 },
-    { "rom-plus3e-0", 1, NULL, 376 },
-    { "rom-plus3e-1", 1, NULL, 377 },
-    { "rom-plus3e-2", 1, NULL, 378 },
-    { "rom-plus3e-3", 1, NULL, 379 },
-    { "rom-plusd", 1, NULL, 380 },
-    { "rom-scorpion-0", 1, NULL, 381 },
-    { "rom-scorpion-1", 1, NULL, 382 },
-    { "rom-scorpion-2", 1, NULL, 383 },
-    { "rom-scorpion-3", 1, NULL, 384 },
-    { "rom-spec-se-0", 1, NULL, 385 },
-    { "rom-spec-se-1", 1, NULL, 386 },
-    { "rom-speccyboot", 1, NULL, 387 },
-    { "rom-tc2048", 1, NULL, 388 },
-    { "rom-tc2068-0", 1, NULL, 389 },
-    { "rom-tc2068-1", 1, NULL, 390 },
-    { "rom-ts2068-0", 1, NULL, 391 },
-    { "rom-ts2068-1", 1, NULL, 392 },
-    { "rom-usource", 1, NULL, 393 },
+    { "rom-128-0", 1, NULL, 354 },
+    { "rom-128-1", 1, NULL, 355 },
+    { "rom-16", 1, NULL, 356 },
+    { "rom-48", 1, NULL, 357 },
+    { "rom-beta128", 1, NULL, 358 },
+    { "rom-didaktik80", 1, NULL, 359 },
+    { "rom-disciple", 1, NULL, 360 },
+    { "rom-interface-1", 1, NULL, 361 },
+    { "rom-multiface1", 1, NULL, 362 },
+    { "rom-multiface128", 1, NULL, 363 },
+    { "rom-multiface3", 1, NULL, 364 },
+    { "rom-opus", 1, NULL, 365 },
+    { "rom-pentagon1024-0", 1, NULL, 366 },
+    { "rom-pentagon1024-1", 1, NULL, 367 },
+    { "rom-pentagon1024-2", 1, NULL, 368 },
+    { "rom-pentagon1024-3", 1, NULL, 369 },
+    { "rom-pentagon512-0", 1, NULL, 370 },
+    { "rom-pentagon512-1", 1, NULL, 371 },
+    { "rom-pentagon512-2", 1, NULL, 372 },
+    { "rom-pentagon512-3", 1, NULL, 373 },
+    { "rom-pentagon-0", 1, NULL, 374 },
+    { "rom-pentagon-1", 1, NULL, 375 },
+    { "rom-pentagon-2", 1, NULL, 376 },
+    { "rom-plus2-0", 1, NULL, 377 },
+    { "rom-plus2-1", 1, NULL, 378 },
+    { "rom-plus2a-0", 1, NULL, 379 },
+    { "rom-plus2a-1", 1, NULL, 380 },
+    { "rom-plus2a-2", 1, NULL, 381 },
+    { "rom-plus2a-3", 1, NULL, 382 },
+    { "rom-plus3-0", 1, NULL, 383 },
+    { "rom-plus3-1", 1, NULL, 384 },
+    { "rom-plus3-2", 1, NULL, 385 },
+    { "rom-plus3-3", 1, NULL, 386 },
+    { "rom-plus3e-0", 1, NULL, 387 },
+    { "rom-plus3e-1", 1, NULL, 388 },
+    { "rom-plus3e-2", 1, NULL, 389 },
+    { "rom-plus3e-3", 1, NULL, 390 },
+    { "rom-plusd", 1, NULL, 391 },
+    { "rom-scorpion-0", 1, NULL, 392 },
+    { "rom-scorpion-1", 1, NULL, 393 },
+    { "rom-scorpion-2", 1, NULL, 394 },
+    { "rom-scorpion-3", 1, NULL, 395 },
+    { "rom-spec-se-0", 1, NULL, 396 },
+    { "rom-spec-se-1", 1, NULL, 397 },
+    { "rom-speccyboot", 1, NULL, 398 },
+    { "rom-tc2048", 1, NULL, 399 },
+    { "rom-tc2068-0", 1, NULL, 400 },
+    { "rom-tc2068-1", 1, NULL, 401 },
+    { "rom-ts2068-0", 1, NULL, 402 },
+    { "rom-ts2068-1", 1, NULL, 403 },
+    { "rom-usource", 1, NULL, 404 },
     {    "rs232-handshake", 0, &(settings->rs232_handshake), 1 },
     { "no-rs232-handshake", 0, &(settings->rs232_handshake), 0 },
-    { "rs232-rx", 1, NULL, 394 },
-    { "rs232-tx", 1, NULL, 395 },
+    { "rs232-rx", 1, NULL, 405 },
+    { "rs232-tx", 1, NULL, 406 },
+    { "run-ahead", 1, NULL, 407 },
     {    "rzx-autosaves", 0, &(settings->rzx_autosaves), 1 },
     { "no-rzx-autosaves", 0, &(settings->rzx_autosaves), 0 },
     {    "compress-rzx", 0, &(settings->rzx_compression), 1 },
     { "no-compress-rzx", 0, &(settings->rzx_compression), 0 },
-    { "sdl-fullscreen-mode", 1, NULL, 396 },
+    {    "rzx-stream", 0, &(settings->rzx_stream), 1 },
+    { "no-rzx-stream", 0, &(settings->rzx_stream), 0 },
+    { "rzx-stream-frames", 1, NULL, 408 },
+    { "sdl-fullscreen-mode", 1, NULL, 409 },
     {    "simpleide", 0, &(settings->simpleide_active), 1 },
     { "no-simpleide", 0, &(settings->simpleide_active), 0 },
-    { "simpleide-masterfile", 1, NULL, 397 },
-    { "simpleide-slavefile", 1, NULL, 398 },
+    { "simpleide-masterfile", 1, NULL, 410 },
+    { "simpleide-slavefile", 1, NULL, 411 },
     {    "slt", 0, &(settings->slt_traps), 1 },
     { "no-slt", 0, &(settings->slt_traps), 0 },
     { "snapshot", 1, NULL, 's' },
-    { "snet", 1, NULL, 400 },
+    { "snet", 1, NULL, 413 },
     {    "sound", 0, &(settings->sound), 1 },
     { "no-sound", 0, &(settings->sound), 0 },
     { "sound-device", 1, NULL, 'd' },
@@ -4733,10 +5202,12 @@ settings_command_line( settings_info *settings, int *first_arg,
     { "sound-freq", 1, NULL, 'f' },
     {    "loading-sound", 0, &(settings->sound_load), 1 },
     { "no-loading-sound", 0, &(settings->sound_load), 0 },
-    { "speaker-type", 1, NULL, 401 },
+    {    "sound-thread", 0, &(settings->sound_thread), 1 },
+    { "no-sound-thread", 0, &(settings->sound_thread), 0 },
+    { "speaker-type", 1, NULL, 414 },
     {    "speccyboot", 0, &(settings->speccyboot), 1 },
     { "no-speccyboot", 0, &(settings->speccyboot), 0 },
-    { "speccyboot-tap", 1, NULL, 402 },
+    { "speccyboot-tap", 1, NULL, 415 },
     {    "specdrum", 0, &(settings->specdrum), 1 },
     { "no-specdrum", 0, &(settings->specdrum), 0 },
     {    "spectranet", 0, &(settings->spectranet), 1 },
@@ -4745,12 +5216,17 @@ settings_command_line( settings_info *settings, int *first_arg,
     { "no-spectranet-disable", 0, &(settings->spectranet_disable), 0 },
     { "machine", 1, NULL, 'm' },
     { "graphics-filter", 1, NULL, 'g' },
+    {    "startup-profile", 0, &(settings->startup_profile), 1 },
+    { "no-startup-profile", 0, &(settings->startup_profile), 0 },
+    { "state-frames", 1, NULL, 416 },
+    { "state-golden", 1, NULL, 417 },
+    { "state-log", 1, NULL, 418 },
     {    "statusbar", 0, &(settings->statusbar), 1 },
     { "no-statusbar", 0, &(settings->statusbar), 0 },
-    { "separation", 1, NULL, 403 },
+    { "separation", 1, NULL, 419 },
     {    "strict-aspect-hint", 0, &(settings->strict_aspect_hint), 1 },
     { "no-strict-aspect-hint", 0, &(settings->strict_aspect_hint), 0 },
-    { "svga-modes", 1, NULL, 404 },
+    { "svga-modes", 1, NULL, 420 },
     { "tape", 1, NULL, 't' },
     {    "traps", 0, &(settings->tape_traps), 1 },
     { "no-traps", 0, &(settings->tape_traps), 0 },
@@ -4758,30 +5234,30 @@ settings_command_line( settings_info *settings, int *first_arg,
     { "no-unittests", 0, &(settings->unittests), 0 },
     {    "usource", 0, &(settings->usource), 1 },
     { "no-usource", 0, &(settings->usource), 0 },
-    { "volume-ay", 1, NULL, 405 },
-    { "volume-beeper", 1, NULL, 406 },
-    { "volume-covox", 1, NULL, 407 },
-    { "volume-specdrum", 1, NULL, 408 },
+    { "volume-ay", 1, NULL, 421 },
+    { "volume-beeper", 1, NULL, 422 },
+    { "volume-covox", 1, NULL, 423 },
+    { "volume-specdrum", 1, NULL, 424 },
     {    "writable-roms", 0, &(settings->writable_roms), 1 },
     { "no-writable-roms", 0, &(settings->writable_roms), 0 },
     {    "cmos-z80", 0, &(settings->z80_is_cmos), 1 },
     { "no-cmos-z80", 0, &(settings->z80_is_cmos), 0 },
     {    "zxatasp", 0, &(settings->zxatasp_active), 1 },
     { "no-zxatasp", 0, &(settings->zxatasp_active), 0 },
-    { "zxatasp-masterfile", 1, NULL, 409 },
-    { "zxatasp-slavefile", 1, NULL, 410 },
+    { "zxatasp-masterfile", 1, NULL, 425 },
+    { "zxatasp-slavefile", 1, NULL, 426 },
     {    "zxatasp-upload", 0, &(settings->zxatasp_upload), 1 },
     { "no-zxatasp-upload", 0, &(settings->zxatasp_upload), 0 },
     {    "zxatasp-write-protect", 0, &(settings->zxatasp_wp), 1 },
     { "no-zxatasp-write-protect", 0, &(settings->zxatasp_wp), 0 },
     {    "zxcf", 0, &(settings->zxcf_active), 1 },
     { "no-zxcf", 0, &(settings->zxcf_active), 0 },
-    { "zxcf-cffile", 1, NULL, 411 },
+    { "zxcf-cffile", 1, NULL, 427 },
     {    "zxcf-upload", 0, &(settings->zxcf_upload), 1 },
     { "no-zxcf-upload", 0, &(settings->zxcf_upload), 0 },
     {    "zxmmc", 0, &(settings->zxmmc_enabled), 1 },
     { "no-zxmmc", 0, &(settings->zxmmc_enabled), 0 },
-    { "zxmmc-file", 1, NULL, 412 },
+    { "zxmmc-file", 1, NULL, 428 },
     {    "zxprinter", 0, &(settings->zxprinter), 1 },
     { "no-zxprinter", 0, &(settings->zxprinter), 0 },
 #line 607"./settings.pl"
@@ -4811,170 +5287,186 @@ settings_command_line( settings_info *settings, int *first_arg,
     case 0: break;	/* Used for long option returns */
 
     case 256: settings_set_string( &settings->betadisk_file, optarg ); break;
-    case 257: settings->competition_code = atoi( optarg ); break;
-    case 258: settings_set_string( &settings->dck_file, optarg ); break;
-    case 259: settings_set_string( &settings->debugger_command, optarg ); break;
-    case 260: settings_set_string( &settings->didaktik80disk_file, optarg ); break;
-    case 261: settings_set_string( &settings->discipledisk_file, optarg ); break;
-    case 262: settings_set_string( &settings->disk_try_merge, optarg ); break;
-    case 263: settings_set_string( &settings->divide_master_file, optarg ); break;
-    case 264: settings_set_string( &settings->divide_slave_file, optarg ); break;
-    case 265: settings_set_string( &settings->divmmc_file, optarg ); break;
+    case 257: settings_set_string( &settings->boot_cache, optarg ); break;
+    case 258: settings->competition_code = atoi( optarg ); break;
+    case 259: settings_set_string( &settings->dck_file, optarg ); break;
+    case 260: settings_set_string( &settings->debugger_command, optarg ); break;
+    case 261: settings_set_string( &settings->didaktik80disk_file, optarg ); break;
+    case 262: settings_set_string( &settings->discipledisk_file, optarg ); break;
+    case 263: settings_set_string( &settings->disk_try_merge, optarg ); break;
+    case 264: settings_set_string( &settings->divide_master_file, optarg ); break;
+    case 265: settings_set_string( &settings->divide_slave_file, optarg ); break;
+    case 266: settings_set_string( &settings->divmmc_file, optarg ); break;
     case 'D': settings->doublescan_mode = atoi( optarg ); break;
-    case 267: settings->drive_40_max_track = atoi( optarg ); break;
-    case 268: settings->drive_80_max_track = atoi( optarg ); break;
-    case 269: settings_set_string( &settings->drive_beta128a_type, optarg ); break;
-    case 270: settings_set_string( &settings->drive_beta128b_type, optarg ); break;
-    case 271: settings_set_string( &settings->drive_beta128c_type, optarg ); break;
-    case 272: settings_set_string( &settings->drive_beta128d_type, optarg ); break;
-    case 273: settings_set_string( &settings->drive_didaktik80a_type, optarg ); break;
-    case 274: settings_set_string( &settings->drive_didaktik80b_type, optarg ); break;
-    case 275: settings_set_string( &settings->drive_disciple1_type, optarg ); break;
-    case 276: settings_set_string( &settings->drive_disciple2_type, optarg ); break;
-    case 277: settings_set_string( &settings->drive_opus1_type, optarg ); break;
-    case 278: settings_set_string( &settings->drive_opus2_type, optarg ); break;
-    case 279: settings_set_string( &settings->drive_plus3a_type, optarg ); break;
-    case 280: settings_set_string( &settings->drive_plus3b_type, optarg ); break;
-    case 281: settings_set_string( &settings->drive_plusd1_type, optarg ); break;
-    case 282: settings_set_string( &settings->drive_plusd2_type, optarg ); break;
-    case 283: settings->emulation_speed = atoi( optarg ); break;
+    case 268: settings->drive_40_max_track = atoi( optarg ); break;
+    case 269: settings->drive_80_max_track = atoi( optarg ); break;
+    case 270: settings_set_string( &settings->drive_beta128a_type, optarg ); break;
+    case 271: settings_set_string( &settings->drive_beta128b_type, optarg ); break;
+    case 272: settings_set_string( &settings->drive_beta128c_type, optarg ); break;
+    case 273: settings_set_string( &settings->drive_beta128d_type, optarg ); break;
+    case 274: settings_set_string( &settings->drive_didaktik80a_type, optarg ); break;
+    case 275: settings_set_string( &settings->drive_didaktik80b_type, optarg ); break;
+    case 276: settings_set_string( &settings->drive_disciple1_type, optarg ); break;
+    case 277: settings_set_string( &settings->drive_disciple2_type, optarg ); break;
+    case 278: settings_set_string( &settings->drive_opus1_type, optarg ); break;
+    case 279: settings_set_string( &settings->drive_opus2_type, optarg ); break;
+    case 280: settings_set_string( &settings->drive_plus3a_type, optarg ); break;
+    case 281: settings_set_string( &settings->drive_plus3b_type, optarg ); break;
+    case 282: settings_set_string( &settings->drive_plusd1_type, optarg ); break;
+    case 283: settings_set_string( &settings->drive_plusd2_type, optarg ); break;
+    case 284: settings->emulation_speed = atoi( optarg ); break;
+    case 285: settings_set_string( &settings->export_audio, optarg ); break;
+    case 286: settings_set_string( &settings->export_scaler, optarg ); break;
+    case 287: settings_set_string( &settings->export_video, optarg ); break;
     case 'v': settings->fb_mode = atoi( optarg ); break;
-    case 284: settings->frame_rate = atoi( optarg ); break;
-    case 285: settings_set_string( &settings->if2_file, optarg ); break;
+    case 288: settings->frame_rate = atoi( optarg ); break;
+    case 289: settings->fuzz_frames = atoi( optarg ); break;
+    case 290: settings->fuzz_run_length = atoi( optarg ); break;
+    case 291: settings_set_string( &settings->if2_file, optarg ); break;
     case 'j': settings_set_string( &settings->joystick_1, optarg ); break;
-    case 286: settings->joystick_1_fire_1 = atoi( optarg ); break;
-    case 287: settings->joystick_1_fire_10 = atoi( optarg ); break;
-    case 288: settings->joystick_1_fire_11 = atoi( optarg ); break;
-    case 289: settings->joystick_1_fire_12 = atoi( optarg ); break;
-    case 290: settings->joystick_1_fire_13 = atoi( optarg ); break;
-    case 291: settings->joystick_1_fire_14 = atoi( optarg ); break;
-    case 292: settings->joystick_1_fire_15 = atoi( optarg ); break;
-    case 293: settings->joystick_1_fire_2 = atoi( optarg ); break;
-    case 294: settings->joystick_1_fire_3 = atoi( optarg ); break;
-    case 295: settings->joystick_1_fire_4 = atoi( optarg ); break;
-    case 296: settings->joystick_1_fire_5 = atoi( optarg ); break;
-    case 297: settings->joystick_1_fire_6 = atoi( optarg ); break;
-    case 298: settings->joystick_1_fire_7 = atoi( optarg ); break;
-    case 299: settings->joystick_1_fire_8 = atoi( optarg ); break;
-    case 300: settings->joystick_1_fire_9 = atoi( optarg ); break;
-    case 301: settings->joystick_1_output = atoi( optarg ); break;
-    case 302: settings_set_string( &settings->joystick_2, optarg ); break;
-    case 303: settings->joystick_2_fire_1 = atoi( optarg ); break;
-    case 304: settings->joystick_2_fire_10 = atoi( optarg ); break;
-    case 305: settings->joystick_2_fire_11 = atoi( optarg ); break;
-    case 306: settings->joystick_2_fire_12 = atoi( optarg ); break;
-    case 307: settings->joystick_2_fire_13 = atoi( optarg ); break;
-    case 308: settings->joystick_2_fire_14 = atoi( optarg ); break;
-    case 309: settings->joystick_2_fire_15 = atoi( optarg ); break;
-    case 310: settings->joystick_2_fire_2 = atoi( optarg ); break;
-    case 311: settings->joystick_2_fire_3 = atoi( optarg ); break;
-    case 312: settings->joystick_2_fire_4 = atoi( optarg ); break;
-    case 313: settings->joystick_2_fire_5 = atoi( optarg ); break;
-    case 314: settings->joystick_2_fire_6 = atoi( optarg ); break;
-    case 315: settings->joystick_2_fire_7 = atoi( optarg ); break;
-    case 316: settings->joystick_2_fire_8 = atoi( optarg ); break;
-    case 317: settings->joystick_2_fire_9 = atoi( optarg ); break;
-    case 318: settings->joystick_2_output = atoi( optarg ); break;
-    case 319: settings->joystick_keyboard_down = atoi( optarg ); break;
-    case 320: settings->joystick_keyboard_fire = atoi( optarg ); break;
-    case 321: settings->joystick_keyboard_left = atoi( optarg ); break;
-    case 322: settings->joystick_keyboard_output = atoi( optarg ); break;
-    case 323: settings->joystick_keyboard_right = atoi( optarg ); break;
-    case 324: settings->joystick_keyboard_up = atoi( optarg ); break;
-    case 325: settings_set_string( &settings->mdr_file, optarg ); break;
-    case 326: settings_set_string( &settings->mdr_file2, optarg ); break;
-    case 327: settings_set_string( &settings->mdr_file3, optarg ); break;
-    case 328: settings_set_string( &settings->mdr_file4, optarg ); break;
-    case 329: settings_set_string( &settings->mdr_file5, optarg ); break;
-    case 330: settings_set_string( &settings->mdr_file6, optarg ); break;
-    case 331: settings_set_string( &settings->mdr_file7, optarg ); break;
-    case 332: settings_set_string( &settings->mdr_file8, optarg ); break;
-    case 333: settings->mdr_len = atoi( optarg ); break;
-    case 334: settings_set_string( &settings->movie_compr, optarg ); break;
-    case 335: settings_set_string( &settings->movie_start, optarg ); break;
-    case 336: settings_set_string( &settings->opusdisk_file, optarg ); break;
-    case 337: settings_set_string( &settings->phantom_typist_mode, optarg ); break;
+    case 292: settings->joystick_1_fire_1 = atoi( optarg ); break;
+    case 293: settings->joystick_1_fire_10 = atoi( optarg ); break;
+    case 294: settings->joystick_1_fire_11 = atoi( optarg ); break;
+    case 295: settings->joystick_1_fire_12 = atoi( optarg ); break;
+    case 296: settings->joystick_1_fire_13 = atoi( optarg ); break;
+    case 297: settings->joystick_1_fire_14 = atoi( optarg ); break;
+    case 298: settings->joystick_1_fire_15 = atoi( optarg ); break;
+    case 299: settings->joystick_1_fire_2 = atoi( optarg ); break;
+    case 300: settings->joystick_1_fire_3 = atoi( optarg ); break;
+    case 301: settings->joystick_1_fire_4 = atoi( optarg ); break;
+    case 302: settings->joystick_1_fire_5 = atoi( optarg ); break;
+    case 303: settings->joystick_1_fire_6 = atoi( optarg ); break;
+    case 304: settings->joystick_1_fire_7 = atoi( optarg ); break;
+    case 305: settings->joystick_1_fire_8 = atoi( optarg ); break;
+    case 306: settings->joystick_1_fire_9 = atoi( optarg ); break;
+    case 307: settings->joystick_1_output = atoi( optarg ); break;
+    case 308: settings_set_string( &settings->joystick_2, optarg ); break;
+    case 309: settings->joystick_2_fire_1 = atoi( optarg ); break;
+    case 310: settings->joystick_2_fire_10 = atoi( optarg ); break;
+    case 311: settings->joystick_2_fire_11 = atoi( optarg ); break;
+    case 312: settings->joystick_2_fire_12 = atoi( optarg ); break;
+    case 313: settings->joystick_2_fire_13 = atoi( optarg ); break;
+    case 314: settings->joystick_2_fire_14 = atoi( optarg ); break;
+    case 315: settings->joystick_2_fire_15 = atoi( optarg ); break;
+    case 316: settings->joystick_2_fire_2 = atoi( optarg ); break;
+    case 317: settings->joystick_2_fire_3 = atoi( optarg ); break;
+    case 318: settings->joystick_2_fire_4 = atoi( optarg ); break;
+    case 319: settings->joystick_2_fire_5 = atoi( optarg ); break;
+    case 320: settings->joystick_2_fire_6 = atoi( optarg ); break;
+    case 321: settings->joystick_2_fire_7 = atoi( optarg ); break;
+    case 322: settings->joystick_2_fire_8 = atoi( optarg ); break;
+    case 323: settings->joystick_2_fire_9 = atoi( optarg ); break;
+    case 324: settings->joystick_2_output = atoi( optarg ); break;
+    case 325: settings->joystick_keyboard_down = atoi( optarg ); break;
+    case 326: settings->joystick_keyboard_fire = atoi( optarg ); break;
+    case 327: settings->joystick_keyboard_left = atoi( optarg ); break;
+    case 328: settings->joystick_keyboard_output = atoi( optarg ); break;
+    case 329: settings->joystick_keyboard_right = atoi( optarg ); break;
+    case 330: settings->joystick_keyboard_up = atoi( optarg ); break;
+    case 331: settings_set_string( &settings->mdr_file, optarg ); break;
+    case 332: settings_set_string( &settings->mdr_file2, optarg ); break;
+    case 333: settings_set_string( &settings->mdr_file3, optarg ); break;
+    case 334: settings_set_string( &settings->mdr_file4, optarg ); break;
+    case 335: settings_set_string( &settings->mdr_file5, optarg ); break;
+    case 336: settings_set_string( &settings->mdr_file6, optarg ); break;
+    case 337: settings_set_string( &settings->mdr_file7, optarg ); break;
+    case 338: settings_set_string( &settings->mdr_file8, optarg ); break;
+    case 339: settings->mdr_len = atoi( optarg ); break;
+    case 340: settings_set_string( &settings->movie_compr, optarg ); break;
+    case 341: settings_set_string( &settings->movie_start, optarg ); break;
+    case 342: settings->netplay_delay = atoi( optarg ); break;
+    case 343: settings_set_string( &settings->netplay_peer, optarg ); break;
+    case 344: settings->netplay_port = atoi( optarg ); break;
+    case 345: settings->netplay_rollback = atoi( optarg ); break;
+    case 346: settings_set_string( &settings->opusdisk_file, optarg ); break;
+    case 347: settings_set_string( &settings->perfstats_file, optarg ); break;
+    case 348: settings_set_string( &settings->phantom_typist_mode, optarg ); break;
     case 'p': settings_set_string( &settings->playback_file, optarg ); break;
-    case 338: settings_set_string( &settings->plus3disk_file, optarg ); break;
-    case 339: settings_set_string( &settings->plusddisk_file, optarg ); break;
-    case 340: settings_set_string( &settings->printer_graphics_filename, optarg ); break;
-    case 341: settings_set_string( &settings->printer_text_filename, optarg ); break;
+    case 349: settings_set_string( &settings->plus3disk_file, optarg ); break;
+    case 350: settings_set_string( &settings->plusddisk_file, optarg ); break;
+    case 351: settings_set_string( &settings->printer_graphics_filename, optarg ); break;
+    case 352: settings_set_string( &settings->printer_text_filename, optarg ); break;
     case 'r': settings_set_string( &settings->record_file, optarg ); break;
-    case 343: settings_set_string( &settings->rom_128_0, optarg ); break;
-    case 344: settings_set_string( &settings->rom_128_1, optarg ); break;
-    case 345: settings_set_string( &settings->rom_16, optarg ); break;
-    case 346: settings_set_string( &settings->rom_48, optarg ); break;
-    case 347: settings_set_string( &settings->rom_beta128, optarg ); break;
-    case 348: settings_set_string( &settings->rom_didaktik80, optarg ); break;
-    case 349: settings_set_string( &settings->rom_disciple, optarg ); break;
-    case 350: settings_set_string( &settings->rom_interface_1, optarg ); break;
-    case 351: settings_set_string( &settings->rom_multiface1, optarg ); break;
-    case 352: settings_set_string( &settings->rom_multiface128, optarg ); break;
-    case 353: settings_set_string( &settings->rom_multiface3, optarg ); break;
-    case 354: settings_set_string( &settings->rom_opus, optarg ); break;
-    case 355: settings_set_string( &settings->rom_pentagon1024_0, optarg ); break;
-    case 356: settings_set_string( &settings->rom_pentagon1024_1, optarg ); break;
-    case 357: settings_set_string( &settings->rom_pentagon1024_2, optarg ); break;
-    case 358: settings_set_string( &settings->rom_pentagon1024_3, optarg ); break;
-    case 359: settings_set_string( &settings->rom_pentagon512_0, optarg ); break;
-    case 360: settings_set_string( &settings->rom_pentagon512_1, optarg ); break;
-    case 361: settings_set_string( &settings->rom_pentagon512_2, optarg ); break;
-    case 362: settings_set_string( &settings->rom_pentagon512_3, optarg ); break;
-    case 363: settings_set_string( &settings->rom_pentagon_0, optarg ); break;
-    case 364: settings_set_string( &settings->rom_pentagon_1, optarg ); break;
-    case 365: settings_set_string( &settings->rom_pentagon_2, optarg ); break;
-    case 366: settings_set_string( &settings->rom_plus2_0, optarg ); break;
-    case 367: settings_set_string( &settings->rom_plus2_1, optarg ); break;
-    case 368: settings_set_string( &settings->rom_plus2a_0, optarg ); break;
-    case 369: settings_set_string( &settings->rom_plus2a_1, optarg ); break;
-    case 370: settings_set_string( &settings->rom_plus2a_2, optarg ); break;
-    case 371: settings_set_string( &settings->rom_plus2a_3, optarg ); break;
-    case 372: settings_set_string( &settings->rom_plus3_0, optarg ); break;
-    case 373: settings_set_string( &settings->rom_plus3_1, optarg ); break;
-    case 374: settings_set_string( &settings->rom_plus3_2, optarg ); break;
-    case 375: settings_set_string( &settings->rom_plus3_3, optarg ); break;
-    case 376: settings_set_string( &settings->rom_plus3e_0, optarg ); break;
-    case 377: settings_set_string( &settings->rom_plus3e_1, optarg ); break;
-    case 378: settings_set_string( &settings->rom_plus3e_2, optarg ); break;
-    case 379: settings_set_string( &settings->rom_plus3e_3, optarg ); break;
-    case 380: settings_set_string( &settings->rom_plusd, optarg ); break;
-    case 381: settings_set_string( &settings->rom_scorpion_0, optarg ); break;
-    case 382: settings_set_string( &settings->rom_scorpion_1, optarg ); break;
-    case 383: settings_set_string( &settings->rom_scorpion_2, optarg ); break;
-    case 384: settings_set_string( &settings->rom_scorpion_3, optarg ); break;
-    case 385: settings_set_string( &settings->rom_spec_se_0, optarg ); break;
-    case 386: settings_set_string( &settings->rom_spec_se_1, optarg ); break;
-    case 387: settings_set_string( &settings->rom_speccyboot, optarg ); break;
-    case 388: settings_set_string( &settings->rom_tc2048, optarg ); break;
-    case 389: settings_set_string( &settings->rom_tc2068_0, optarg ); break;
-    case 390: settings_set_string( &settings->rom_tc2068_1, optarg ); break;
-    case 391: settings_set_string( &settings->rom_ts2068_0, optarg ); break;
-    case 392: settings_set_string( &settings->rom_ts2068_1, optarg ); break;
-    case 393: settings_set_string( &settings->rom_usource, optarg ); break;
-    case 394: settings_set_string( &settings->rs232_rx, optarg ); break;
-    case 395: settings_set_string( &settings->rs232_tx, optarg ); break;
-    case 396: settings_set_string( &settings->sdl_fullscreen_mode, optarg ); break;
-    case 397: settings_set_string( &settings->simpleide_master_file, optarg ); break;
-    case 398: settings_set_string( &settings->simpleide_slave_file, optarg ); break;
+    case 354: settings_set_string( &settings->rom_128_0, optarg ); break;
+    case 355: settings_set_string( &settings->rom_128_1, optarg ); break;
+    case 356: settings_set_string( &settings->rom_16, optarg ); break;
+    case 357: settings_set_string( &settings->rom_48, optarg ); break;
+    case 358: settings_set_string( &settings->rom_beta128, optarg ); break;
+    case 359: settings_set_string( &settings->rom_didaktik80, optarg ); break;
+    case 360: settings_set_string( &settings->rom_disciple, optarg ); break;
+    case 361: settings_set_string( &settings->rom_interface_1, optarg ); break;
+    case 362: settings_set_string( &settings->rom_multiface1, optarg ); break;
+    case 363: settings_set_string( &settings->rom_multiface128, optarg ); break;
+    case 364: settings_set_string( &settings->rom_multiface3, optarg ); break;
+    case 365: settings_set_string( &settings->rom_opus, optarg ); break;
+    case 366: settings_set_string( &settings->rom_pentagon1024_0, optarg ); break;
+    case 367: settings_set_string( &settings->rom_pentagon1024_1, optarg ); break;
+    case 368: settings_set_string( &settings->rom_pentagon1024_2, optarg ); break;
+    case 369: settings_set_string( &settings->rom_pentagon1024_3, optarg ); break;
+    case 370: settings_set_string( &settings->rom_pentagon512_0, optarg ); break;
+    case 371: settings_set_string( &settings->rom_pentagon512_1, optarg ); break;
+    case 372: settings_set_string( &settings->rom_pentagon512_2, optarg ); break;
+    case 373: settings_set_string( &settings->rom_pentagon512_3, optarg ); break;
+    case 374: settings_set_string( &settings->rom_pentagon_0, optarg ); break;
+    case 375: settings_set_string( &settings->rom_pentagon_1, optarg ); break;
+    case 376: settings_set_string( &settings->rom_pentagon_2, optarg ); break;
+    case 377: settings_set_string( &settings->rom_plus2_0, optarg ); break;
+    case 378: settings_set_string( &settings->rom_plus2_1, optarg ); break;
+    case 379: settings_set_string( &settings->rom_plus2a_0, optarg ); break;
+    case 380: settings_set_string( &settings->rom_plus2a_1, optarg ); break;
+    case 381: settings_set_string( &settings->rom_plus2a_2, optarg ); break;
+    case 382: settings_set_string( &settings->rom_plus2a_3, optarg ); break;
+    case 383: settings_set_string( &settings->rom_plus3_0, optarg ); break;
+    case 384: settings_set_string( &settings->rom_plus3_1, optarg ); break;
+    case 385: settings_set_string( &settings->rom_plus3_2, optarg ); break;
+    case 386: settings_set_string( &settings->rom_plus3_3, optarg ); break;
+    case 387: settings_set_string( &settings->rom_plus3e_0, optarg ); break;
+    case 388: settings_set_string( &settings->rom_plus3e_1, optarg ); break;
+    case 389: settings_set_string( &settings->rom_plus3e_2, optarg ); break;
+    case 390: settings_set_string( &settings->rom_plus3e_3, optarg ); break;
+    case 391: settings_set_string( &settings->rom_plusd, optarg ); break;
+    case 392: settings_set_string( &settings->rom_scorpion_0, optarg ); break;
+    case 393: settings_set_string( &settings->rom_scorpion_1, optarg ); break;
+    case 394: settings_set_string( &settings->rom_scorpion_2, optarg ); break;
+    case 395: settings_set_string( &settings->rom_scorpion_3, optarg ); break;
+    case 396: settings_set_string( &settings->rom_spec_se_0, optarg ); break;
+    case 397: settings_set_string( &settings->rom_spec_se_1, optarg ); break;
+    case 398: settings_set_string( &settings->rom_speccyboot, optarg ); break;
+    case 399: settings_set_string( &settings->rom_tc2048, optarg ); break;
+    case 400: settings_set_string( &settings->rom_tc2068_0, optarg ); break;
+    case 401: settings_set_string( &settings->rom_tc2068_1, optarg ); break;
+    case 402: settings_set_string( &settings->rom_ts2068_0, optarg ); break;
+    case 403: settings_set_string( &settings->rom_ts2068_1, optarg ); break;
+    case 404: settings_set_string( &settings->rom_usource, optarg ); break;
+    case 405: settings_set_string( &settings->rs232_rx, optarg ); break;
+    case 406: settings_set_string( &settings->rs232_tx, optarg ); break;
+    case 407: settings->run_ahead = atoi( optarg ); break;
+    case 408: settings->rzx_stream_frames = atoi( optarg ); break;
+    case 409: settings_set_string( &settings->sdl_fullscreen_mode, optarg ); break;
+    case 410: settings_set_string( &settings->simpleide_master_file, optarg ); break;
+    case 411: settings_set_string( &settings->simpleide_slave_file, optarg ); break;
     case 's': settings_set_string( &settings->snapshot, optarg ); break;
-    case 400: settings_set_string( &settings->snet, optarg ); break;
+    case 413: settings_set_string( &settings->snet, optarg ); break;
     case 'd': settings_set_string( &settings->sound_device, optarg ); break;
     case 'f': settings->sound_freq = atoi( optarg ); break;
-    case 401: settings_set_string( &settings->speaker_type, optarg ); break;
-    case 402: settings_set_string( &settings->speccyboot_tap, optarg ); break;
+    case 414: settings_set_string( &settings->speaker_type, optarg ); break;
+    case 415: settings_set_string( &settings->speccyboot_tap, optarg ); break;
     case 'm': settings_set_string( &settings->start_machine, optarg ); break;
     case 'g': settings_set_string( &settings->start_scaler_mode, optarg ); break;
-    case 403: settings_set_string( &settings->stereo_ay, optarg ); break;
-    case 404: settings_set_string( &settings->svga_modes, optarg ); break;
+    case 416: settings->state_frames = atoi( optarg ); break;
+    case 417: settings_set_string( &settings->state_golden, optarg ); break;
+    case 418: settings_set_string( &settings->state_log, optarg ); break;
+    case 419: settings_set_string( &settings->stereo_ay, optarg ); break;
+    case 420: settings_set_string( &settings->svga_modes, optarg ); break;
     case 't': settings_set_string( &settings->tape_file, optarg ); break;
-    case 405: settings->volume_ay = atoi( optarg ); break;
-    case 406: settings->volume_beeper = atoi( optarg ); break;
-    case 407: settings->volume_covox = atoi( optarg ); break;
-    case 408: settings->volume_specdrum = atoi( optarg ); break;
-    case 409: settings_set_string( &settings->zxatasp_master_file, optarg ); break;
-    case 410: settings_set_string( &settings->zxatasp_slave_file, optarg ); break;
-    case 411: settings_set_string( &settings->zxcf_pri_file, optarg ); break;
-    case 412: settings_set_string( &settings->zxmmc_file, optarg ); break;
+    case 421: settings->volume_ay = atoi( optarg ); break;
+    case 422: settings->volume_beeper = atoi( optarg ); break;
+    case 423: settings->volume_covox = atoi( optarg ); break;
+    case 424: settings->volume_specdrum = atoi( optarg ); break;
+    case 425: settings_set_string( &settings->zxatasp_master_file, optarg ); break;
+    case 426: settings_set_string( &settings->zxatasp_slave_file, optarg ); break;
+    case 427: settings_set_string( &settings->zxcf_pri_file, optarg ); break;
+    case 428: settings_set_string( &settings->zxmmc_file, optarg ); break;
 #line 657"./settings.pl"
 
     case 'h': settings->show_help = 1; break;
@@ -5008,12 +5500,18 @@ settings_copy_internal( settings_info *dest, settings_info *src )
   dest->aspect_hint = src->aspect_hint;
   dest->auto_load = src->auto_load;
   dest->autosave_settings = src->autosave_settings;
+  dest->benchmark = src->benchmark;
+  dest->benchmark_output = src->benchmark_output;
   dest->beta128 = src->beta128;
   dest->beta128_48boot = src->beta128_48boot;
   dest->betadisk_file = NULL;
   if( src->betadisk_file ) {
     dest->betadisk_file = utils_safe_strdup( src->betadisk_file );
   }
+  dest->boot_cache = NULL;
+  if( src->boot_cache ) {
+    dest->boot_cache = utils_safe_strdup( src->boot_cache );
+  }
   dest->bw_tv = src->bw_tv;
   dest->competition_code = src->competition_code;
   dest->competition_mode = src->competition_mode;
@@ -5120,11 +5618,27 @@ settings_copy_internal( settings_info *dest, settings_info *src )
   }
   dest->embed_snapshot = src->embed_snapshot;
   dest->emulation_speed = src->emulation_speed;
+  dest->export_audio = NULL;
+  if( src->export_audio ) {
+    dest->export_audio = utils_safe_strdup( src->export_audio );
+  }
+  dest->export_full_speed = src->export_full_speed;
+  dest->export_scaler = NULL;
+  if( src->export_scaler ) {
+    dest->export_scaler = utils_safe_strdup( src->export_scaler );
+  }
+  dest->export_video = NULL;
+  if( src->export_video ) {
+    dest->export_video = utils_safe_strdup( src->export_video );
+  }
   dest->fastload = src->fastload;
   dest->fb_mode = src->fb_mode;
   dest->frame_rate = src->frame_rate;
   dest->full_screen = src->full_screen;
   dest->fuller = src->fuller;
+  dest->fuzz = src->fuzz;
+  dest->fuzz_frames = src->fuzz_frames;
+  dest->fuzz_run_length = src->fuzz_run_length;
   dest->if2_file = NULL;
   if( src->if2_file ) {
     dest->if2_file = utils_safe_strdup( src->if2_file );
@@ -5223,6 +5737,7 @@ settings_copy_internal( settings_info *dest, settings_info *src )
   if( src->movie_compr ) {
     dest->movie_compr = utils_safe_strdup( src->movie_compr );
   }
+  dest->movie_compr_fast = src->movie_compr_fast;
   dest->movie_start = NULL;
   if( src->movie_start ) {
     dest->movie_start = utils_safe_strdup( src->movie_start );
@@ -5232,12 +5747,24 @@ settings_copy_internal( settings_info *dest, settings_info *src )
   dest->multiface128 = src->multiface128;
   dest->multiface1_stealth = src->multiface1_stealth;
   dest->multiface3 = src->multiface3;
+  dest->netplay_delay = src->netplay_delay;
+  dest->netplay_peer = NULL;
+  if( src->netplay_peer ) {
+    dest->netplay_peer = utils_safe_strdup( src->netplay_peer );
+  }
+  dest->netplay_port = src->netplay_port;
+  dest->netplay_rollback = src->netplay_rollback;
   dest->opus = src->opus;
   dest->opusdisk_file = NULL;
   if( src->opusdisk_file ) {
     dest->opusdisk_file = utils_safe_strdup( src->opusdisk_file );
   }
   dest->pal_tv2x = src->pal_tv2x;
+  dest->perfstats = src->perfstats;
+  dest->perfstats_file = NULL;
+  if( src->perfstats_file ) {
+    dest->perfstats_file = utils_safe_strdup( src->perfstats_file );
+  }
   dest->phantom_typist_mode = NULL;
   if( src->phantom_typist_mode ) {
     dest->phantom_typist_mode = utils_safe_strdup( src->phantom_typist_mode );
@@ -5256,6 +5783,7 @@ settings_copy_internal( settings_info *dest, settings_info *src )
   if( src->plusddisk_file ) {
     dest->plusddisk_file = utils_safe_strdup( src->plusddisk_file );
   }
+  dest->predecode_cache = src->predecode_cache;
   dest->printer = src->printer;
   dest->printer_graphics_filename = NULL;
   if( src->printer_graphics_filename ) {
@@ -5484,8 +6012,11 @@ settings_copy_internal( settings_info *dest, settings_info *src )
   if( src->rs232_tx ) {
     dest->rs232_tx = utils_safe_strdup( src->rs232_tx );
   }
+  dest->run_ahead = src->run_ahead;
   dest->rzx_autosaves = src->rzx_autosaves;
   dest->rzx_compression = src->rzx_compression;
+  dest->rzx_stream = src->rzx_stream;
+  dest->rzx_stream_frames = src->rzx_stream_frames;
   dest->sdl_fullscreen_mode = NULL;
   if( src->sdl_fullscreen_mode ) {
     dest->sdl_fullscreen_mode = utils_safe_strdup( src->sdl_fullscreen_mode );
@@ -5516,6 +6047,7 @@ settings_copy_internal( settings_info *dest, settings_info *src )
   dest->sound_force_8bit = src->sound_force_8bit;
   dest->sound_freq = src->sound_freq;
   dest->sound_load = src->sound_load;
+  dest->sound_thread = src->sound_thread;
   dest->speaker_type = NULL;
   if( src->speaker_type ) {
     dest->speaker_type = utils_safe_strdup( src->speaker_type );
@@ -5536,6 +6068,16 @@ settings_copy_internal( settings_info *dest, settings_info *src )
   if( src->start_scaler_mode ) {
     dest->start_scaler_mode = utils_safe_strdup( src->start_scaler_mode );
   }
+  dest->startup_profile = src->startup_profile;
+  dest->state_frames = src->state_frames;
+  dest->state_golden = NULL;
+  if( src->state_golden ) {
+    dest->state_golden = utils_safe_strdup( src->state_golden );
+  }
+  dest->state_log = NULL;
+  if( src->state_log ) {
+    dest->state_log = utils_safe_strdup( src->state_log );
+  }
   dest->statusbar = src->statusbar;
   dest->stereo_ay = NULL;
   if( src->stereo_ay ) {
@@ -5673,6 +6215,7 @@ int
 settings_free( settings_info *settings )
 {
   if( settings->betadisk_file ) libspectrum_free( settings->betadisk_file );
+  if( settings->boot_cache ) libspectrum_free( settings->boot_cache );
   if( settings->dck_file ) libspectrum_free( settings->dck_file );
   if( settings->debugger_command ) libspectrum_free( settings->debugger_command );
   if( settings->didaktik80disk_file ) libspectrum_free( settings->didaktik80disk_file );
@@ -5695,6 +6238,9 @@ settings_free( settings_info *settings )
   if( settings->drive_plus3b_type ) libspectrum_free( settings->drive_plus3b_type );
   if( settings->drive_plusd1_type ) libspectrum_free( settings->drive_plusd1_type );
   if( settings->drive_plusd2_type ) libspectrum_free( settings->drive_plusd2_type );
+  if( settings->export_audio ) libspectrum_free( settings->export_audio );
+  if( settings->export_scaler ) libspectrum_free( settings->export_scaler );
+  if( settings->export_video ) libspectrum_free( settings->export_video );
   if( settings->if2_file ) libspectrum_free( settings->if2_file );
   if( settings->joystick_1 ) libspectrum_free( settings->joystick_1 );
   if( settings->joystick_2 ) libspectrum_free( settings->joystick_2 );
@@ -5708,7 +6254,9 @@ settings_free( settings_info *settings )
   if( settings->mdr_file8 ) libspectrum_free( settings->mdr_file8 );
   if( settings->movie_compr ) libspectrum_free( settings->movie_compr );
   if( settings->movie_start ) libspectrum_free( settings->movie_start );
+  if( settings->netplay_peer ) libspectrum_free( settings->netplay_peer );
   if( settings->opusdisk_file ) libspectrum_free( settings->opusdisk_file );
+  if( settings->perfstats_file ) libspectrum_free( settings->perfstats_file );
   if( settings->phantom_typist_mode ) libspectrum_free( settings->phantom_typist_mode );
   if( settings->playback_file ) libspectrum_free( settings->playback_file );
   if( settings->plus3disk_file ) libspectrum_free( settings->plus3disk_file );
@@ -5779,6 +6327,8 @@ settings_free( settings_info *settings )
   if( settings->speccyboot_tap ) libspectrum_free( settings->speccyboot_tap );
   if( settings->start_machine ) libspectrum_free( settings->start_machine );
   if( settings->start_scaler_mode ) libspectrum_free( settings->start_scaler_mode );
+  if( settings->state_golden ) libspectrum_free( settings->state_golden );
+  if( settings->state_log ) libspectrum_free( settings->state_log );
   if( settings->stereo_ay ) libspectrum_free( settings->stereo_ay );
   if( settings->svga_modes ) libspectrum_free( settings->svga_modes );
   if( settings->tape_file ) libspectrum_free( settings->tape_file );
@@ -35,9 +35,12 @@ typedef struct settings_info {
    int aspect_hint;
    int auto_load;
    int autosave_settings;
+   int benchmark;
+   int benchmark_output;
    int beta128;
    int beta128_48boot;
   char *betadisk_file;
+  char *boot_cache;
    int bw_tv;
    int competition_code;
    int competition_mode;
@@ -78,11 +81,18 @@ typedef struct settings_info {
   char *drive_plusd2_type;
    int embed_snapshot;
    int emulation_speed;
+  char *export_audio;
+   int export_full_speed;
+  char *export_scaler;
+  char *export_video;
    int fastload;
    int fb_mode;
    int frame_rate;
    int full_screen;
    int fuller;
+   int fuzz;
+   int fuzz_frames;
+   int fuzz_run_length;
   char *if2_file;
    int interface1;
    int interface2;
@@ -145,21 +155,29 @@ typedef struct settings_info {
    int melodik;
    int mouse_swap_buttons;
   char *movie_compr;
+   int movie_compr_fast;
   char *movie_start;
    int movie_stop_after_rzx;
    int multiface1;
    int multiface128;
    int multiface1_stealth;
    int multiface3;
+   int netplay_delay;
+  char *netplay_peer;
+   int netplay_port;
+   int netplay_rollback;
    int opus;
   char *opusdisk_file;
    int pal_tv2x;
+   int perfstats;
+  char *perfstats_file;
   char *phantom_typist_mode;
   char *playback_file;
    int plus3_detect_speedlock;
   char *plus3disk_file;
    int plusd;
   char *plusddisk_file;
+   int predecode_cache;
    int printer;
   char *printer_graphics_filename;
   char *printer_text_filename;
@@ -220,8 +238,11 @@ typedef struct settings_info {
    int rs232_handshake;
   char *rs232_rx;
   char *rs232_tx;
+   int run_ahead;
    int rzx_autosaves;
    int rzx_compression;
+   int rzx_stream;
+   int rzx_stream_frames;
   char *sdl_fullscreen_mode;
    int simpleide_active;
   char *simpleide_master_file;
@@ -234,6 +255,7 @@ typedef struct settings_info {
    int sound_force_8bit;
    int sound_freq;
    int sound_load;
+   int sound_thread;
   char *speaker_type;
    int speccyboot;
   char *speccyboot_tap;
@@ -242,6 +264,10 @@ typedef struct settings_info {
    int spectranet_disable;
   char *start_machine;
   char *start_scaler_mode;
+   int startup_profile;
+   int state_frames;
+  char *state_golden;
+  char *state_log;
    int statusbar;
   char *stereo_ay;
    int strict_aspect_hint;
@@ -25,6 +25,7 @@
 
 #include <libspectrum.h>
 
+#include "bootcache.h"
 #include "fuse.h"
 #include "machine.h"
 #include "memory_pages.h"
@@ -84,6 +85,9 @@ snapshot_copy_from( libspectrum_snap *snap )
   int error;
   libspectrum_machine machine;
 
+  /* Whatever the machine does next isn't a fresh boot */
+  bootcache_inhibit( 1 );
+
   periph_disable_optional();
   module_snapshot_enabled( snap );
 
@@ -108,6 +112,8 @@ snapshot_copy_from( libspectrum_snap *snap )
      initialising from the snapshot */
   machine_current->memory_map();
 
+  bootcache_inhibit( 0 );
+
   return 0;
 }
 
@@ -28,11 +28,20 @@
 
 #include <config.h>
 
+#ifdef HAVE_PTHREAD
+#include <pthread.h>
+#endif				/* #ifdef HAVE_PTHREAD */
+
+#include <glib.h>
+
 #include "fuse.h"
 #include "infrastructure/startup_manager.h"
 #include "machine.h"
+#include "export.h"
 #include "movie.h"
 #include "options.h"
+#include "perfstats.h"
+#include "runahead.h"
 #include "settings.h"
 #include "sound.h"
 #include "tape.h"
@@ -44,6 +53,7 @@
 
 /* configuration */
 int sound_enabled = 0;		/* Are we currently using the sound card */
+int sound_silent = 0;		/* Generate sound but don't output it */
 
 static int sound_enabled_ever = 0; /* whether sound has *ever* been in use; see
 				      sound_ay_write() and sound_ay_reset() */
@@ -83,8 +93,62 @@ struct ay_change_tag
   unsigned char reg, val;
 };
 
-static struct ay_change_tag ay_change[ AY_CHANGE_MAX ];
-static int ay_change_count;
+/* Everything else which makes a sound during a frame, each with its own
+   list of changes so that they can be passed to their synths in one go */
+typedef enum sound_source {
+  SOUND_SOURCE_BEEPER,
+  SOUND_SOURCE_SPECDRUM,
+  SOUND_SOURCE_COVOX,
+
+  SOUND_SOURCE_COUNT
+} sound_source;
+
+typedef struct sound_changes {
+  blip_change_t *changes;
+  long count, allocated;
+} sound_changes;
+
+/* The emulation only logs what happens to the sound during each frame;
+   the log is turned into samples at the end of the frame, either straight
+   away or by the synthesis thread */
+typedef struct sound_frame_log {
+  struct ay_change_tag ay_change[ AY_CHANGE_MAX ];
+  int ay_change_count;
+
+  sound_changes changes[ SOUND_SOURCE_COUNT ];
+
+  libspectrum_dword frame_length;
+  int ay;			/* Is there an AY to be heard? */
+
+  long samples;			/* How many samples were made from it */
+} sound_frame_log;
+
+/* The logs for one frame being emulated and the frames waiting for the
+   synthesis thread */
+#define SOUND_QUEUE_LENGTH 3
+
+static sound_frame_log frame_logs[ SOUND_QUEUE_LENGTH ];
+
+/* The synthesis thread works through the logs from queue_head, and the
+   emulation fills in the log at queue_tail. The logs are passed between
+   the two without locking; the mutex is used only for one to sleep until
+   the other has done something */
+static volatile gint queue_head = 0, queue_tail = 0;
+
+#define current_log ( &frame_logs[ queue_tail ] )
+
+#ifdef HAVE_PTHREAD
+static pthread_t synthesis_thread;
+static pthread_mutex_t queue_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t queue_not_empty = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t queue_not_full = PTHREAD_COND_INITIALIZER;
+static int synthesis_running = 0;
+static int synthesis_stop = 0;
+#endif				/* #ifdef HAVE_PTHREAD */
+
+static void sound_synthesis_start( void );
+static void sound_synthesis_end( void );
+static void sound_synthesis_wait( void );
 
 Blip_Buffer *left_buf = NULL;
 Blip_Buffer *right_buf = NULL;
@@ -176,7 +240,7 @@ sound_ay_init( void )
   for( f = 0; f < 3; f++ )
     ay_tone_tick[f] = ay_tone_high[f] = 0, ay_tone_period[f] = 1;
 
-  ay_change_count = 0;
+  current_log->ay_change_count = 0;
 }
 
 #ifndef UI_WIN32
@@ -189,6 +253,13 @@ sound_ay_init( void )
 #define MAX_SPEED_PERCENTAGE 300
 #endif                       /* #ifndef UI_WIN32 */
 
+/* Is the sound being sent to the sound device? */
+static int
+sound_output( void )
+{
+  return settings_current.sound && !sound_silent;
+}
+
 static int
 is_in_sound_enabled_range( void )
 {
@@ -210,14 +281,15 @@ sound_init( const char *device )
      (less than that and a single Speccy frame generates more
      than a seconds worth of sound which is bigger than the
      maximum Blip_Buffer of 1 second) */
-  if( !( !sound_enabled && settings_current.sound &&
+  if( !( !sound_enabled &&
+         ( settings_current.sound || export_audio_active ) &&
          is_in_sound_enabled_range() ) )
     return;
 
   /* only try for stereo if we need it */
   sound_stereo_ay = option_enumerate_sound_stereo_ay();
 
-  if( settings_current.sound &&
+  if( sound_output() &&
       sound_lowlevel_init( device, &settings_current.sound_freq,
                            &sound_stereo_ay ) )
     return;
@@ -329,6 +401,8 @@ sound_init( const char *device )
   /* initialize movie settings... */
   movie_init_sound( settings_current.sound_freq, sound_stereo_ay );
 
+  sound_synthesis_start();
+
 }
 
 void
@@ -351,7 +425,11 @@ sound_unpause( void )
 void
 sound_end( void )
 {
+  size_t i, j;
+
   if( sound_enabled ) {
+    sound_synthesis_end();
+
     delete_Blip_Synth( &left_beeper_synth );
     delete_Blip_Synth( &right_beeper_synth );
 
@@ -371,10 +449,19 @@ sound_end( void )
     delete_Blip_Buffer( &left_buf );
     delete_Blip_Buffer( &right_buf );
 
-    if( settings_current.sound ) 
+    if( sound_output() )
       sound_lowlevel_end();
     libspectrum_free( samples );
     sound_enabled = 0;
+
+    /* Anything logged since the last frame is lost with the synths */
+    for( i = 0; i < SOUND_QUEUE_LENGTH; i++ ) {
+      for( j = 0; j < SOUND_SOURCE_COUNT; j++ ) {
+        libspectrum_free( frame_logs[i].changes[j].changes );
+        frame_logs[i].changes[j].changes = NULL;
+        frame_logs[i].changes[j].count = frame_logs[i].changes[j].allocated = 0;
+      }
+    }
   }
 }
 
@@ -421,7 +508,7 @@ ay_do_tone( int level, unsigned int tone_count, int *var, int chan )
 #define AY_CLOCK_RATIO 2
 
 static void
-sound_ay_overlay( void )
+sound_ay_overlay( const sound_frame_log *log )
 {
   static int rng = 1;
   static int noise_toggle = 0;
@@ -430,20 +517,17 @@ sound_ay_overlay( void )
   int mixer, envshape;
   int g, level;
   libspectrum_dword f;
-  struct ay_change_tag *change_ptr = ay_change;
-  int changes_left = ay_change_count;
+  const struct ay_change_tag *change_ptr = log->ay_change;
+  int changes_left = log->ay_change_count;
   int reg, r;
   int chan1, chan2, chan3;
   int last_chan1 = 0, last_chan2 = 0, last_chan3 = 0;
   unsigned int tone_count, noise_count;
 
   /* If no AY chip, don't produce any AY sound (!) */
-  if( !( periph_is_active( PERIPH_TYPE_FULLER) ||
-         periph_is_active( PERIPH_TYPE_MELODIK ) ||
-         machine_current->capabilities & LIBSPECTRUM_MACHINE_CAPABILITY_AY ) )
-    return;
+  if( !log->ay ) return;
 
-  for( f = 0; f < machine_current->timings.tstates_per_frame;
+  for( f = 0; f < log->frame_length;
        f+= AY_CLOCK_DIVISOR * AY_CLOCK_RATIO ) {
     /* update ay registers. */
     while( changes_left && f >= change_ptr->tstates ) {
@@ -622,17 +706,213 @@ sound_ay_overlay( void )
   }
 }
 
+static void
+sound_log_event( sound_source source, libspectrum_dword at_tstates,
+                 int level )
+{
+  sound_changes *changes = &current_log->changes[ source ];
+  blip_change_t *change;
+
+  if( changes->count == changes->allocated ) {
+    changes->allocated = changes->allocated ? changes->allocated * 2 : 1024;
+    changes->changes = libspectrum_renew( blip_change_t, changes->changes,
+                                          changes->allocated );
+  }
+
+  change = &changes->changes[ changes->count++ ];
+  change->time = at_tstates;
+  change->amplitude = level;
+}
+
+static void
+sound_log_clear( sound_frame_log *log )
+{
+  size_t i;
+
+  log->ay_change_count = 0;
+  for( i = 0; i < SOUND_SOURCE_COUNT; i++ ) log->changes[i].count = 0;
+}
+
+static void
+sound_synth_changes( Blip_Synth *left_synth, Blip_Synth *right_synth,
+                     const sound_changes *changes )
+{
+  blip_synth_update_batch( left_synth, changes->changes, changes->count );
+  if( right_synth )
+    blip_synth_update_batch( right_synth, changes->changes, changes->count );
+}
+
+/* Turn one frame's log into samples */
+static void
+sound_synthesise( sound_frame_log *log )
+{
+  long count;
+
+  sound_synth_changes( left_beeper_synth, right_beeper_synth,
+                       &log->changes[ SOUND_SOURCE_BEEPER ] );
+  sound_synth_changes( left_specdrum_synth, right_specdrum_synth,
+                       &log->changes[ SOUND_SOURCE_SPECDRUM ] );
+  sound_synth_changes( left_covox_synth, right_covox_synth,
+                       &log->changes[ SOUND_SOURCE_COVOX ] );
+
+  /* overlay AY sound */
+  sound_ay_overlay( log );
+
+  blip_buffer_end_frame( left_buf, log->frame_length );
+
+  if( sound_stereo_ay != SOUND_STEREO_AY_NONE ) {
+    blip_buffer_end_frame( right_buf, log->frame_length );
+
+    /* Left channel into even samples, right channel into odd samples:
+       LRLRLRLRLR... */
+    count = blip_buffer_read_samples_stereo( left_buf, right_buf, samples,
+                                             sound_framesiz );
+    count <<= 1;
+  } else {
+    count = blip_buffer_read_samples( left_buf, samples, sound_framesiz, BLIP_BUFFER_DEF_STEREO );
+  }
+
+  log->samples = count;
+}
+
+#ifdef HAVE_PTHREAD
+
+static void*
+synthesis_thread_fn( void *arg GCC_UNUSED )
+{
+  sound_frame_log *log;
+  int head;
+
+  while( 1 ) {
+
+    pthread_mutex_lock( &queue_lock );
+    while( g_atomic_int_get( &queue_head ) == g_atomic_int_get( &queue_tail ) &&
+           !synthesis_stop )
+      pthread_cond_wait( &queue_not_empty, &queue_lock );
+    pthread_mutex_unlock( &queue_lock );
+
+    head = g_atomic_int_get( &queue_head );
+    if( head == g_atomic_int_get( &queue_tail ) ) break;
+
+    /* The sound device may block until it has room for this frame, which
+       in turn holds up the emulation once the queue is full */
+    log = &frame_logs[ head ];
+    sound_synthesise( log );
+    if( sound_output() ) sound_lowlevel_frame( samples, log->samples );
+    sound_log_clear( log );
+
+    g_atomic_int_set( &queue_head, ( head + 1 ) % SOUND_QUEUE_LENGTH );
+
+    pthread_mutex_lock( &queue_lock );
+    pthread_cond_signal( &queue_not_full );
+    pthread_mutex_unlock( &queue_lock );
+  }
+
+  return NULL;
+}
+
+/* Pass the current log to the synthesis thread and start on the next one,
+   waiting if the thread is a whole queue behind */
+static void
+sound_queue_log( void )
+{
+  int next = ( queue_tail + 1 ) % SOUND_QUEUE_LENGTH;
+  perfstats_stage stage;
+  sound_frame_log *log;
+
+  if( next == g_atomic_int_get( &queue_head ) ) {
+    stage = perfstats_enter( PERFSTATS_STAGE_SLEEP );
+    pthread_mutex_lock( &queue_lock );
+    while( next == g_atomic_int_get( &queue_head ) )
+      pthread_cond_wait( &queue_not_full, &queue_lock );
+    pthread_mutex_unlock( &queue_lock );
+    perfstats_enter( stage );
+  }
+
+  g_atomic_int_set( &queue_tail, next );
+
+  pthread_mutex_lock( &queue_lock );
+  pthread_cond_signal( &queue_not_empty );
+  pthread_mutex_unlock( &queue_lock );
+
+  /* Count the samples made from the next log when it last went round */
+  log = current_log;
+  perfstats_count( PERFSTATS_COUNTER_SAMPLES, log->samples );
+  log->samples = 0;
+}
+
+#endif				/* #ifdef HAVE_PTHREAD */
+
+static void
+sound_synthesis_start( void )
+{
+#ifdef HAVE_PTHREAD
+  int error;
+
+  if( !settings_current.sound_thread ) return;
+
+  synthesis_stop = 0;
+
+  error = pthread_create( &synthesis_thread, NULL, synthesis_thread_fn, NULL );
+  if( error ) {
+    ui_error( UI_ERROR_WARNING,
+              "sound: error %d creating synthesis thread; "
+              "synthesising synchronously", error );
+    return;
+  }
+
+  synthesis_running = 1;
+#endif				/* #ifdef HAVE_PTHREAD */
+}
+
+/* Wait for the synthesis thread to empty the queue and then stop it */
+static void
+sound_synthesis_end( void )
+{
+#ifdef HAVE_PTHREAD
+  if( !synthesis_running ) return;
+
+  pthread_mutex_lock( &queue_lock );
+  synthesis_stop = 1;
+  pthread_cond_signal( &queue_not_empty );
+  pthread_mutex_unlock( &queue_lock );
+
+  pthread_join( synthesis_thread, NULL );
+  synthesis_running = 0;
+#endif				/* #ifdef HAVE_PTHREAD */
+}
+
+/* Wait until the synthesis thread has dealt with every frame passed to
+   it, after which only the emulation touches the sound state */
+static void
+sound_synthesis_wait( void )
+{
+#ifdef HAVE_PTHREAD
+  if( !synthesis_running ) return;
+
+  pthread_mutex_lock( &queue_lock );
+  while( g_atomic_int_get( &queue_head ) != g_atomic_int_get( &queue_tail ) )
+    pthread_cond_wait( &queue_not_full, &queue_lock );
+  pthread_mutex_unlock( &queue_lock );
+#endif				/* #ifdef HAVE_PTHREAD */
+}
+
 /* don't make the change immediately; record it for later,
- * to be made by sound_frame() (via sound_ay_overlay()).
+ * to be made at the end of the frame (via sound_ay_overlay()).
+ * Sound comes only from the real timeline, never from frames run ahead.
  */
 void
 sound_ay_write( int reg, int val, libspectrum_dword now )
 {
-  if( ay_change_count < AY_CHANGE_MAX ) {
-    ay_change[ ay_change_count ].tstates = now;
-    ay_change[ ay_change_count ].reg = ( reg & 15 );
-    ay_change[ ay_change_count ].val = val;
-    ay_change_count++;
+  sound_frame_log *log = current_log;
+
+  if( runahead_active ) return;
+
+  if( log->ay_change_count < AY_CHANGE_MAX ) {
+    log->ay_change[ log->ay_change_count ].tstates = now;
+    log->ay_change[ log->ay_change_count ].reg = ( reg & 15 );
+    log->ay_change[ log->ay_change_count ].val = val;
+    log->ay_change_count++;
   }
 }
 
@@ -644,10 +924,12 @@ sound_ay_reset( void )
 {
   int f;
 
+  /* The AY state belongs to the synthesis thread until it has caught up */
+  sound_synthesis_wait();
+
   /* recalculate timings based on new machines ay clock */
   sound_ay_init();
 
-  ay_change_count = 0;
   for( f = 0; f < 16; f++ )
     sound_ay_write( f, 0, 0 );
   for( f = 0; f < 3; f++ )
@@ -662,11 +944,11 @@ sound_ay_reset( void )
 void
 sound_specdrum_write( libspectrum_word port GCC_UNUSED, libspectrum_byte val )
 {
+  if( runahead_active ) return;
+
   if( periph_is_active( PERIPH_TYPE_SPECDRUM ) ) {
-    blip_synth_update( left_specdrum_synth, tstates, ( val - 128) * 128);
-    if( right_specdrum_synth ) {
-      blip_synth_update( right_specdrum_synth, tstates, ( val - 128) * 128);
-    }
+    if( sound_enabled )
+      sound_log_event( SOUND_SOURCE_SPECDRUM, tstates, ( val - 128 ) * 128 );
     machine_current->specdrum.specdrum_dac = val - 128;
   }
 }
@@ -678,12 +960,12 @@ sound_specdrum_write( libspectrum_word port GCC_UNUSED, libspectrum_byte val )
 void
 sound_covox_write( libspectrum_word port GCC_UNUSED, libspectrum_byte val )
 {
+  if( runahead_active ) return;
+
   if( periph_is_active( PERIPH_TYPE_COVOX_FB ) ||
       periph_is_active( PERIPH_TYPE_COVOX_DD ) ) {
-    blip_synth_update( left_covox_synth, tstates, val * 128);
-    if( right_covox_synth ) {
-      blip_synth_update( right_covox_synth, tstates, val * 128);
-    }
+    if( sound_enabled )
+      sound_log_event( SOUND_SOURCE_COVOX, tstates, val * 128 );
     machine_current->covox.covox_dac = val;
   }
 }
@@ -691,34 +973,45 @@ sound_covox_write( libspectrum_word port GCC_UNUSED, libspectrum_byte val )
 void
 sound_frame( void )
 {
-  long count;
+  sound_frame_log *log = current_log;
+  perfstats_stage stage;
 
-  if( !sound_enabled )
+  if( !sound_enabled || runahead_active )
     return;
 
-  /* overlay AY sound */
-  sound_ay_overlay();
+  log->frame_length = machine_current->timings.tstates_per_frame;
+  log->ay = periph_is_active( PERIPH_TYPE_FULLER ) ||
+            periph_is_active( PERIPH_TYPE_MELODIK ) ||
+            machine_current->capabilities & LIBSPECTRUM_MACHINE_CAPABILITY_AY;
 
-  blip_buffer_end_frame( left_buf, machine_current->timings.tstates_per_frame );
+#ifdef HAVE_PTHREAD
+  /* Movies and exports need the samples in step with the frames, so are
+     always made here */
+  if( synthesis_running && !movie_recording && !export_active ) {
+    sound_queue_log();
+    return;
+  }
+#endif				/* #ifdef HAVE_PTHREAD */
 
-  if( sound_stereo_ay != SOUND_STEREO_AY_NONE ) {
-    blip_buffer_end_frame( right_buf, machine_current->timings.tstates_per_frame );
+  sound_synthesis_wait();
 
-    /* Read left channel into even samples, right channel into odd samples:
-       LRLRLRLRLR... */
-    count = blip_buffer_read_samples( left_buf, samples, sound_framesiz, 1 );
-    blip_buffer_read_samples( right_buf, samples + 1, count, 1 );
-    count <<= 1;
-  } else {
-    count = blip_buffer_read_samples( left_buf, samples, sound_framesiz, BLIP_BUFFER_DEF_STEREO );
-  }
+  sound_synthesise( log );
 
-  if( settings_current.sound ) 
-    sound_lowlevel_frame( samples, count );
+  perfstats_count( PERFSTATS_COUNTER_SAMPLES, log->samples );
+
+  /* The sound device may block until it has room for this frame */
+  if( sound_output() ) {
+    stage = perfstats_enter( PERFSTATS_STAGE_SLEEP );
+    sound_lowlevel_frame( samples, log->samples );
+    perfstats_enter( stage );
+  }
 
   if( movie_recording )
-      movie_add_sound( samples, count );
-  ay_change_count = 0;
+      movie_add_sound( samples, log->samples );
+  if( export_active )
+    export_add_sound( samples, log->samples );
+
+  sound_log_clear( log );
 }
 
 void
@@ -728,7 +1021,7 @@ sound_beeper( libspectrum_dword at_tstates, int on )
                                AMPL_BEEPER+AMPL_TAPE };
   int val;
 
-  if( !sound_enabled ) return;
+  if( !sound_enabled || runahead_active ) return;
 
   if( tape_is_playing() ) {
     /* Timex machines have no loading noise */
@@ -741,7 +1034,5 @@ sound_beeper( libspectrum_dword at_tstates, int on )
 
   val = beeper_ampl[on];
 
-  blip_synth_update( left_beeper_synth, at_tstates, val );
-  if( sound_stereo_ay != SOUND_STEREO_AY_NONE )
-    blip_synth_update( right_beeper_synth, at_tstates, val );
+  sound_log_event( SOUND_SOURCE_BEEPER, at_tstates, val );
 }
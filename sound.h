@@ -44,6 +44,11 @@ libspectrum_dword sound_get_effective_processor_speed( void );
 extern int sound_enabled;
 extern int sound_framesiz;
 
+/* If set, sound is generated as usual but never sent to the sound device,
+   so that the emulation isn't held to real time by it; only to be changed
+   while the sound is not in use */
+extern int sound_silent;
+
 /* Stereo separation types:
  *  * ACB is used in the Melodik interface.
  *  * ABC stereo is used in the Pentagon/Scorpion.
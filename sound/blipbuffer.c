@@ -30,6 +30,8 @@ partially reimplemented in C by Gergely Szasz for FUSE
 
 static void _blip_synth_init( Blip_Synth_ * synth_, short *impulses );
 
+static void blip_synth_build_kernels( Blip_Synth * synth );
+
 inline void
 blip_buffer_set_clock_rate( Blip_Buffer * buff, long cps )
 {
@@ -58,6 +60,7 @@ blip_synth_set_volume( Blip_Synth * synth, double v )
                                  ( BLIP_SYNTH_RANGE <
                                    0 ? -( BLIP_SYNTH_RANGE ) :
                                    BLIP_SYNTH_RANGE ) ) );
+  blip_synth_build_kernels( synth );
 }
 
 #define BLIP_FWD( i )                     \
@@ -128,16 +131,90 @@ blip_synth_offset_resampled( Blip_Synth * synth, blip_resampled_time_t time,
 #undef BLIP_FWD
 #undef BLIP_REV
 
+/* The same as blip_synth_offset_resampled(), but with the impulse for the
+   phase already laid out in order, so that it's a plain multiply and add
+   which the compiler can vectorise */
+static inline void
+blip_synth_add_kernel( const Blip_Synth * synth, blip_resampled_time_t time,
+                       int delta, Blip_Buffer * blip_buf )
+{
+  const imp_t *kernel;
+
+  long *buf;
+
+  int phase, i;
+
+  delta *= synth->impl.delta_factor;
+  phase =
+    ( int )( time >> ( BLIP_BUFFER_ACCURACY - BLIP_PHASE_BITS ) &
+             ( BLIP_RES - 1 ) );
+  kernel = synth->kernels + phase * BLIP_SYNTH_QUALITY;
+  buf = blip_buf->buffer_ + ( time >> BLIP_BUFFER_ACCURACY ) +
+        ( BLIP_WIDEST_IMPULSE_ - BLIP_SYNTH_QUALITY ) / 2;
+
+  for( i = 0; i < BLIP_SYNTH_QUALITY; i++ )
+    buf[i] += ( long )kernel[i] * delta;
+}
+
+static void
+blip_synth_build_kernels( Blip_Synth * synth )
+{
+  const imp_t *fwd, *rev;
+
+  imp_t *kernel;
+
+  int phase, i;
+
+  for( phase = 0; phase < BLIP_RES; phase++ ) {
+    fwd = synth->impulses + BLIP_RES - phase;
+    rev = synth->impulses + phase;
+    kernel = synth->kernels + phase * BLIP_SYNTH_QUALITY;
+
+    for( i = 0; i < BLIP_SYNTH_QUALITY / 2; i++ ) {
+      kernel[i] = fwd[BLIP_RES * i];
+      kernel[BLIP_SYNTH_QUALITY - 1 - i] = rev[BLIP_RES * i];
+    }
+  }
+}
+
 void
 blip_synth_update( Blip_Synth * synth, blip_time_t t, int amp )
 {
   int delta = amp - synth->impl.last_amp;
 
   synth->impl.last_amp = amp;
-  blip_synth_offset_resampled( synth,
-                               t * synth->impl.buf->factor_ +
-                               synth->impl.buf->offset_, delta,
-                               synth->impl.buf );
+  blip_synth_add_kernel( synth,
+                         t * synth->impl.buf->factor_ +
+                         synth->impl.buf->offset_, delta,
+                         synth->impl.buf );
+}
+
+void
+blip_synth_update_batch( Blip_Synth * synth, const blip_change_t * changes,
+                         long count )
+{
+  Blip_Buffer *buf = synth->impl.buf;
+
+  unsigned long factor = buf->factor_;
+
+  blip_resampled_time_t offset = buf->offset_;
+
+  int last_amp = synth->impl.last_amp, delta;
+
+  long i;
+
+  for( i = 0; i < count; i++ ) {
+    /* No change means nothing to add */
+    delta = changes[i].amplitude - last_amp;
+    if( !delta )
+      continue;
+
+    last_amp = changes[i].amplitude;
+    blip_synth_add_kernel( synth, changes[i].time * factor + offset, delta,
+                           buf );
+  }
+
+  synth->impl.last_amp = last_amp;
 }
 
 int
@@ -154,6 +231,7 @@ blip_synth_set_treble_eq( Blip_Synth * synth, double treble )
   eq.treble = treble;
 
   _blip_synth_treble_eq( &synth->impl, &eq );
+  blip_synth_build_kernels( synth );
 }
 
 #define BUFFER_EXTRA ( BLIP_WIDEST_IMPULSE_ + 2 )
@@ -210,6 +288,8 @@ blip_synth_init( Blip_Synth * synth )
   synth->impulses =
     malloc( ( BLIP_RES * ( BLIP_SYNTH_QUALITY / 2 ) +
               1 ) * sizeof( imp_t ) * 4 );
+  synth->kernels =
+    calloc( BLIP_RES * BLIP_SYNTH_QUALITY, sizeof( imp_t ) );
   if( synth->impulses ) {
     _blip_synth_init( &synth->impl, ( short * )synth->impulses );       /* sorry, somewhere imp_t, somewhere short ???? */
   }
@@ -222,6 +302,10 @@ blip_synth_end( Blip_Synth * synth )
     free( synth->impulses );
     synth->impulses = NULL;
   }
+  if( synth->kernels ) {
+    free( synth->kernels );
+    synth->kernels = NULL;
+  }
 }
 
 Blip_Synth *
@@ -232,7 +316,8 @@ new_Blip_Synth( void )
   ret = malloc( sizeof( Blip_Synth ) );
   if( ret ) {
     blip_synth_init( ret );
-    if( !ret->impulses ) {
+    if( !ret->impulses || !ret->kernels ) {
+      blip_synth_end( ret );
       free( ret );
       return NULL;
     }
@@ -560,6 +645,14 @@ _blip_synth_volume_unit( Blip_Synth_ * synth_, double new_unit )
   }
 }
 
+/* Clamp to the range of a sample */
+static inline blip_sample_t
+blip_clamp_sample( long s )
+{
+  return ( blip_sample_t ) s == s ? ( blip_sample_t ) s :
+                                    ( blip_sample_t ) ( 0x7FFF - ( s >> 24 ) );
+}
+
 long
 blip_buffer_read_samples( Blip_Buffer * buff, blip_sample_t * out,
                           long max_samples, int stereo )
@@ -615,3 +708,56 @@ blip_buffer_read_samples( Blip_Buffer * buff, blip_sample_t * out,
 
   return count;
 }
+
+long
+blip_buffer_read_samples_stereo( Blip_Buffer * left, Blip_Buffer * right,
+                                 blip_sample_t * out, long max_samples )
+{
+  long count = blip_buffer_samples_avail( left );
+
+  if( count > blip_buffer_samples_avail( right ) )
+    count = blip_buffer_samples_avail( right );
+  if( count > max_samples )
+    count = max_samples;
+
+  if( count ) {
+    int sample_shift = BLIP_SAMPLE_BITS - 16;
+
+    int left_bass_shift = left->bass_shift;
+
+    int right_bass_shift = right->bass_shift;
+
+    long left_accum = left->reader_accum;
+
+    long right_accum = right->reader_accum;
+
+    buf_t_ *left_in = left->buffer_;
+
+    buf_t_ *right_in = right->buffer_;
+
+    long n;
+
+    /* The two channels are independent, so each step of one can overlap
+       with the other */
+    for( n = 0; n < count; n++ ) {
+      long l = left_accum >> sample_shift;
+
+      long r = right_accum >> sample_shift;
+
+      left_accum -= left_accum >> left_bass_shift;
+      left_accum += left_in[n];
+      right_accum -= right_accum >> right_bass_shift;
+      right_accum += right_in[n];
+
+      out[2 * n] = blip_clamp_sample( l );
+      out[2 * n + 1] = blip_clamp_sample( r );
+    }
+
+    left->reader_accum = left_accum;
+    right->reader_accum = right_accum;
+    blip_buffer_remove_samples( left, count );
+    blip_buffer_remove_samples( right, count );
+  }
+
+  return count;
+}
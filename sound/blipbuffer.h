@@ -100,6 +100,14 @@ void blip_buffer_end_frame( Blip_Buffer * buff, blip_time_t time );
 long blip_buffer_read_samples( Blip_Buffer * buff, blip_sample_t * dest,
                                long max_samples, int stereo );
 
+/*  Read at most 'max_samples' out of both buffers into 'dest', interleaved
+ left then right, in a single pass. Gives exactly the same samples as reading
+ each buffer with 'stereo' true. Returns the number of samples read from each
+ buffer.
+*/
+long blip_buffer_read_samples_stereo( Blip_Buffer * left, Blip_Buffer * right,
+                                      blip_sample_t * dest, long max_samples );
+
 /*  Additional optional features */
 
 /*  Set frequency high-pass filter frequency, where higher values reduce bass more */
@@ -180,6 +188,10 @@ typedef short imp_t;
 typedef struct Blip_Synth_s {
   imp_t *impulses;
   Blip_Synth_ impl;
+
+  /* The impulse for each phase as BLIP_SYNTH_QUALITY contiguous values,
+     rebuilt whenever the impulses change */
+  imp_t *kernels;
 } Blip_Synth;
 
 void blip_synth_set_volume( Blip_Synth * synth, double v );
@@ -195,6 +207,17 @@ Blip_Synth for each waveform. */
 void blip_synth_update( Blip_Synth * synth, blip_time_t time,
                         int amplitude );
 
+/*  An amplitude change for blip_synth_update_batch() */
+typedef struct blip_change_s {
+  blip_time_t time;
+  int amplitude;
+} blip_change_t;
+
+/*  Make 'count' amplitude changes, in time order, in one call; the same as
+ calling blip_synth_update() for each of them */
+void blip_synth_update_batch( Blip_Synth * synth,
+                              const blip_change_t * changes, long count );
+
 /*  Low-level interface */
 
 void blip_synth_offset_resampled( Blip_Synth * synth,
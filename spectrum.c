@@ -25,33 +25,40 @@
 
 #include <libspectrum.h>
 
+#include "bootcache.h"
 #include "compat.h"
 #include "debugger/debugger.h"
 #include "display.h"
 #include "event.h"
+#include "export.h"
 #include "keyboard.h"
 #include "infrastructure/startup_manager.h"
 #include "loader.h"
 #include "machine.h"
 #include "memory_pages.h"
 #include "module.h"
+#include "netplay.h"
+#include "perfstats.h"
+#include "peripherals/joystick.h"
 #include "peripherals/printer.h"
 #include "peripherals/ula.h"
 #include "phantom_typist.h"
 #include "psg.h"
 #include "profile.h"
+#include "runahead.h"
 #include "rzx.h"
 #include "settings.h"
 #include "sound.h"
 #include "spectrum.h"
+#include "statelog.h"
 #include "tape.h"
 #include "timer/timer.h"
 #include "ui/ui.h"
-#include "ui/uijoystick.h"
 #include "z80/z80.h"
 
-/* 1040 KB of RAM */
-libspectrum_byte RAM[ SPECTRUM_RAM_PAGES ][0x4000];
+/* The RAM pages the current machine has; allocated by memory_ram_allocate()
+   and NULL for pages it doesn't have */
+libspectrum_byte *RAM[ SPECTRUM_RAM_PAGES ];
 
 /* How many tstates have elapsed since the last interrupt? (or more
    precisely, since the ULA last pulled the /INT line to the Z80 low) */
@@ -73,34 +80,64 @@ static const char * const frame_count_name = "frames";
 /* Count of frames since last reset */
 static libspectrum_dword frames_since_reset;
 
+/* The copies kept by spectrum_state_save() */
+static libspectrum_dword saved_tstates[ MODULE_STATE_SLOTS ];
+static libspectrum_dword saved_frames_since_reset[ MODULE_STATE_SLOTS ];
+
 static void
 spectrum_reset( int hard_reset )
 {
   frames_since_reset = 0;
 }
 
+static void
+spectrum_state_save( int slot )
+{
+  saved_tstates[ slot ] = tstates;
+  saved_frames_since_reset[ slot ] = frames_since_reset;
+}
+
+static void
+spectrum_state_restore( int slot )
+{
+  tstates = saved_tstates[ slot ];
+  frames_since_reset = saved_frames_since_reset[ slot ];
+}
+
 static module_info_t module_info = {
   /* .reset = */ spectrum_reset,
   /* .romcs = */ NULL,
   /* .snapshot_enabled = */ NULL,
   /* .snapshot_from = */ NULL,
-  /* .snapshot_to = */ NULL
+  /* .snapshot_to = */ NULL,
+  /* .state_save = */ spectrum_state_save,
+  /* .state_restore = */ spectrum_state_restore
 };
 
 static void
 spectrum_frame_event_fn( libspectrum_dword last_tstates, int type,
 			 void *user_data )
 {
+  int interrupted;
+
   if( rzx_playback ) event_force_events();
   rzx_frame();
   psg_frame();
   spectrum_frame();
-  z80_interrupt();
-  ui_joystick_poll();
+  interrupted = z80_interrupt();
+
+  /* Frames run ahead use the input already read, and the host side of
+     things happens only once per real frame */
+  if( runahead_active ) return;
+
+  joystick_poll();
   timer_estimate_speed();
   debugger_add_time_events();
   ui_event();
   ui_error_frame();
+
+  if( bootcache_capturing ) bootcache_frame( interrupted );
+  if( statelog_active ) statelog_frame();
 }
 
 static libspectrum_dword
@@ -140,6 +177,8 @@ int
 spectrum_frame( void )
 {
   libspectrum_dword frame_length;
+  perfstats_stage stage;
+  int error;
 
   /* Reduce the t-state count of both the processor and all the events
      scheduled to occur. Done slightly differently if RZX playback is
@@ -153,9 +192,15 @@ spectrum_frame( void )
   if( z80.interrupts_enabled_at >= 0 )
     z80.interrupts_enabled_at -= frame_length;
 
+  stage = perfstats_enter( PERFSTATS_STAGE_SOUND );
   if( sound_enabled ) sound_frame();
 
-  if( display_frame() ) return 1;
+  perfstats_enter( PERFSTATS_STAGE_DISPLAY );
+  error = display_frame();
+  perfstats_enter( stage );
+  if( error ) return 1;
+
+  if( export_active ) export_frame();
   if( profile_active ) profile_frame( frame_length );
   printer_frame();
 
@@ -169,6 +214,11 @@ spectrum_frame( void )
 
   frames_since_reset++;
 
+  if( perfstats_active ) perfstats_frame();
+
+  if( netplay_active ) netplay_frame();
+  runahead_frame();
+
   return 0;
 }
 
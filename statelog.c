@@ -0,0 +1,458 @@
+/* statelog.c: per-frame hashes of the machine state
+   Copyright (c) 2026 Fuse contributors
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+   Author contact information:
+
+   E-mail: philip-fuse@shadowmagic.org.uk
+
+*/
+
+/* Each frame, the state of the machine is hashed in several parts and
+   written to a log of fixed size records, or compared with such a log
+   from an earlier run. Any change which should leave the emulation
+   exactly the same, such as an optimisation, can then be checked by
+   playing back long recordings, with the first frame and part of the
+   machine where things went wrong reported */
+
+#include <config.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include <libspectrum.h>
+
+#include "compat.h"
+#include "display.h"
+#include "event.h"
+#include "fuse.h"
+#include "machine.h"
+#include "memory_pages.h"
+#include "peripherals/scld.h"
+#include "rzx.h"
+#include "settings.h"
+#include "sound.h"
+#include "spectrum.h"
+#include "statelog.h"
+#include "timer/timer.h"
+#include "ui/ui.h"
+#include "z80/z80.h"
+
+int statelog_active = 0;
+
+static const char * const component_names[ STATELOG_COMPONENT_COUNT ] = {
+  "cpu", "memory", "ula", "ay", "display",
+};
+
+/* The log starts with this, then the version and the number of hashes in
+   each record; each hash is stored little endian */
+static const char signature[] = "FuseStat";
+#define STATELOG_VERSION 1
+#define RECORD_LENGTH ( STATELOG_COMPONENT_COUNT * 4 )
+
+static FILE *log_file, *golden_file;
+
+/* Frames hashed so far */
+static libspectrum_dword frames;
+
+/* Set once the log can't be written or something differed from the golden
+   log, to stop the run */
+static int error, differs;
+
+/* The small parts of the state are gathered here to be hashed */
+static libspectrum_byte buffer[ 64 ];
+static size_t buffer_used;
+
+#define PRIME1 2654435761UL
+#define PRIME2 2246822519UL
+#define PRIME3 3266489917UL
+#define PRIME4 668265263UL
+#define PRIME5 374761393UL
+
+#define rotate( x, n ) \
+  ( (libspectrum_dword)( ( (x) << (n) ) | ( (x) >> ( 32 - (n) ) ) ) )
+
+static libspectrum_dword
+read_dword( const libspectrum_byte *data )
+{
+  return data[0] | ( data[1] << 8 ) | ( data[2] << 16 ) |
+         ( (libspectrum_dword)data[3] << 24 );
+}
+
+static libspectrum_dword
+round32( libspectrum_dword value, const libspectrum_byte *data )
+{
+  value += read_dword( data ) * PRIME2;
+  return rotate( value, 13 ) * PRIME1;
+}
+
+libspectrum_dword
+statelog_hash( libspectrum_dword seed, const libspectrum_byte *data,
+               size_t length )
+{
+  const libspectrum_byte *end = data + length;
+  libspectrum_dword h, v1, v2, v3, v4;
+
+  if( length >= 16 ) {
+    v1 = seed + PRIME1 + PRIME2;
+    v2 = seed + PRIME2;
+    v3 = seed;
+    v4 = seed - PRIME1;
+
+    for( ; end - data >= 16; data += 16 ) {
+      v1 = round32( v1, data );
+      v2 = round32( v2, data + 4 );
+      v3 = round32( v3, data + 8 );
+      v4 = round32( v4, data + 12 );
+    }
+
+    h = rotate( v1, 1 ) + rotate( v2, 7 ) + rotate( v3, 12 ) +
+        rotate( v4, 18 );
+  } else {
+    h = seed + PRIME5;
+  }
+
+  h += (libspectrum_dword)length;
+
+  for( ; end - data >= 4; data += 4 ) {
+    h += read_dword( data ) * PRIME3;
+    h = rotate( h, 17 ) * PRIME4;
+  }
+
+  for( ; data < end; data++ ) {
+    h += *data * PRIME5;
+    h = rotate( h, 11 ) * PRIME1;
+  }
+
+  h ^= h >> 15;
+  h *= PRIME2;
+  h ^= h >> 13;
+  h *= PRIME3;
+  h ^= h >> 16;
+
+  return h;
+}
+
+static void
+put_byte( libspectrum_byte value )
+{
+  buffer[ buffer_used++ ] = value;
+}
+
+static void
+put_word( libspectrum_word value )
+{
+  put_byte( value & 0xff );
+  put_byte( value >> 8 );
+}
+
+static void
+put_dword( libspectrum_dword value )
+{
+  put_word( value & 0xffff );
+  put_word( value >> 16 );
+}
+
+static libspectrum_dword
+hash_buffer( void )
+{
+  libspectrum_dword h = statelog_hash( 0, buffer, buffer_used );
+
+  buffer_used = 0;
+
+  return h;
+}
+
+static libspectrum_dword
+hash_cpu( void )
+{
+  /* The flags are worked out so that the hash doesn't depend on whether
+     the core has done so yet */
+  if( z80.flags_op ) z80_flags_resolve();
+
+  put_word( z80.af.w ); put_word( z80.bc.w );
+  put_word( z80.de.w ); put_word( z80.hl.w );
+  put_word( z80.af_.w ); put_word( z80.bc_.w );
+  put_word( z80.de_.w ); put_word( z80.hl_.w );
+  put_word( z80.ix.w ); put_word( z80.iy.w );
+  put_byte( z80.i ); put_byte( ( z80.r & 0x7f ) | ( z80.r7 & 0x80 ) );
+  put_word( z80.sp.w ); put_word( z80.pc.w );
+  put_word( z80.memptr.w ); put_word( z80.q );
+  put_byte( z80.iff1 ); put_byte( z80.iff2 ); put_byte( z80.im );
+  put_byte( z80.halted );
+  put_dword( z80.interrupts_enabled_at );
+  put_dword( tstates );
+
+  return hash_buffer();
+}
+
+static libspectrum_dword
+hash_memory( void )
+{
+  libspectrum_dword h = 0;
+  size_t i, pages = memory_ram_pages();
+
+  for( i = 0; i < pages; i++ ) h = statelog_hash( h, RAM[i], 0x4000 );
+
+  for( i = 0; i < MEMORY_PAGES_IN_64K; i++ ) {
+    put_byte( memory_map_read[i].source );
+    put_byte( memory_map_read[i].page_num );
+    put_word( memory_map_read[i].offset );
+    put_byte( memory_map_read[i].writable );
+    put_byte( memory_map_read[i].contended );
+    h = statelog_hash( h, buffer, buffer_used );
+    buffer_used = 0;
+  }
+
+  return h;
+}
+
+static libspectrum_dword
+hash_ula( void )
+{
+  put_byte( display_lores_border );
+  put_byte( display_hires_border );
+  put_byte( memory_current_screen );
+  put_byte( machine_current->ram.locked );
+  put_byte( machine_current->ram.current_page );
+  put_byte( machine_current->ram.current_rom );
+  put_byte( machine_current->ram.last_byte );
+  put_byte( machine_current->ram.last_byte2 );
+  put_byte( machine_current->ram.special );
+  put_byte( machine_current->ram.romcs );
+  put_byte( scld_last_dec.byte );
+  put_byte( scld_last_hsr );
+
+  return hash_buffer();
+}
+
+static libspectrum_dword
+hash_ay( void )
+{
+  put_byte( machine_current->ay.current_register );
+
+  return statelog_hash( hash_buffer(), machine_current->ay.registers,
+                        sizeof( machine_current->ay.registers ) );
+}
+
+static libspectrum_dword
+hash_display( void )
+{
+#ifdef WORDS_BIGENDIAN
+  /* Hashed in the same byte order as on little endian hosts */
+  static libspectrum_byte
+    swapped[ sizeof( display_last_screen ) ];
+  size_t i;
+
+  for( i = 0; i < ARRAY_SIZE( display_last_screen ); i++ ) {
+    swapped[ i * 4     ] = display_last_screen[i] & 0xff;
+    swapped[ i * 4 + 1 ] = ( display_last_screen[i] >> 8 ) & 0xff;
+    swapped[ i * 4 + 2 ] = ( display_last_screen[i] >> 16 ) & 0xff;
+    swapped[ i * 4 + 3 ] = display_last_screen[i] >> 24;
+  }
+
+  return statelog_hash( 0, swapped, sizeof( swapped ) );
+#else				/* #ifdef WORDS_BIGENDIAN */
+  return statelog_hash( 0, (const libspectrum_byte*)display_last_screen,
+                        sizeof( display_last_screen ) );
+#endif				/* #ifdef WORDS_BIGENDIAN */
+}
+
+static void
+compare( const libspectrum_byte *record )
+{
+  libspectrum_byte golden[ RECORD_LENGTH ];
+  size_t i;
+  int first = 1;
+
+  if( fread( golden, RECORD_LENGTH, 1, golden_file ) != 1 ) {
+    printf( "%s: golden log ends after %lu frames\n", fuse_progname,
+            (unsigned long)frames );
+    differs = 1;
+    return;
+  }
+
+  if( !memcmp( golden, record, RECORD_LENGTH ) ) return;
+
+  printf( "%s: frame %lu differs from golden log in", fuse_progname,
+          (unsigned long)frames );
+  for( i = 0; i < STATELOG_COMPONENT_COUNT; i++ ) {
+    if( memcmp( &golden[ i * 4 ], &record[ i * 4 ], 4 ) ) {
+      printf( "%s %s (%08lx, was %08lx)", first ? ":" : ",",
+              component_names[i], (unsigned long)read_dword( &record[ i * 4 ] ),
+              (unsigned long)read_dword( &golden[ i * 4 ] ) );
+      first = 0;
+    }
+  }
+  printf( "\n" );
+
+  differs = 1;
+}
+
+void
+statelog_frame( void )
+{
+  libspectrum_dword hashes[ STATELOG_COMPONENT_COUNT ];
+  libspectrum_byte record[ RECORD_LENGTH ];
+  size_t i;
+
+  if( error || differs ) return;
+
+  hashes[ STATELOG_COMPONENT_CPU ] = hash_cpu();
+  hashes[ STATELOG_COMPONENT_MEMORY ] = hash_memory();
+  hashes[ STATELOG_COMPONENT_ULA ] = hash_ula();
+  hashes[ STATELOG_COMPONENT_AY ] = hash_ay();
+  hashes[ STATELOG_COMPONENT_DISPLAY ] = hash_display();
+
+  for( i = 0; i < STATELOG_COMPONENT_COUNT; i++ ) {
+    record[ i * 4     ] = hashes[i] & 0xff;
+    record[ i * 4 + 1 ] = ( hashes[i] >> 8 ) & 0xff;
+    record[ i * 4 + 2 ] = ( hashes[i] >> 16 ) & 0xff;
+    record[ i * 4 + 3 ] = hashes[i] >> 24;
+  }
+
+  if( log_file && fwrite( record, RECORD_LENGTH, 1, log_file ) != 1 ) {
+    ui_error( UI_ERROR_ERROR, "error writing state log '%s'",
+              settings_current.state_log );
+    error = 1;
+    return;
+  }
+
+  if( golden_file ) compare( record );
+
+  frames++;
+}
+
+static int
+open_files( void )
+{
+  libspectrum_byte header[ sizeof( signature ) + 1 ];
+
+  memcpy( header, signature, sizeof( signature ) - 1 );
+  header[ sizeof( signature ) - 1 ] = STATELOG_VERSION;
+  header[ sizeof( signature ) ] = STATELOG_COMPONENT_COUNT;
+
+  if( settings_current.state_golden ) {
+    libspectrum_byte golden[ sizeof( header ) ];
+
+    golden_file = fopen( settings_current.state_golden, "rb" );
+    if( !golden_file ) {
+      ui_error( UI_ERROR_ERROR, "couldn't open golden log '%s'",
+                settings_current.state_golden );
+      return 1;
+    }
+
+    if( fread( golden, sizeof( golden ), 1, golden_file ) != 1 ||
+        memcmp( golden, header, sizeof( header ) ) ) {
+      ui_error( UI_ERROR_ERROR, "'%s' is not a state log from this version",
+                settings_current.state_golden );
+      return 1;
+    }
+  }
+
+  if( settings_current.state_log ) {
+    log_file = fopen( settings_current.state_log, "wb" );
+    if( !log_file ) {
+      ui_error( UI_ERROR_ERROR, "couldn't open state log '%s' for writing",
+                settings_current.state_log );
+      return 1;
+    }
+
+    if( fwrite( header, sizeof( header ), 1, log_file ) != 1 ) {
+      ui_error( UI_ERROR_ERROR, "error writing state log '%s'",
+                settings_current.state_log );
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+static void
+close_files( void )
+{
+  if( golden_file ) {
+    /* A golden log for a longer run is a difference too */
+    if( !error && !differs && fgetc( golden_file ) != EOF ) {
+      printf( "%s: golden log continues after %lu frames\n", fuse_progname,
+              (unsigned long)frames );
+      differs = 1;
+    }
+
+    fclose( golden_file );
+    golden_file = NULL;
+  }
+
+  if( log_file ) {
+    if( fclose( log_file ) ) {
+      ui_error( UI_ERROR_ERROR, "error writing state log '%s'",
+                settings_current.state_log );
+      error = 1;
+    }
+    log_file = NULL;
+  }
+}
+
+int
+statelog_run( void )
+{
+  int playback = rzx_playback;
+  double start, elapsed;
+
+  frames = 0;
+  error = differs = 0;
+
+  if( open_files() ) {
+    close_files();
+    return 1;
+  }
+
+  /* The sound is still generated, as it would be normally, but the sound
+     device doesn't hold the emulation to real time */
+  sound_end();
+  sound_silent = 1;
+  timer_unthrottled = 1;
+  sound_init( settings_current.sound_device );
+
+  statelog_active = 1;
+  start = compat_timer_get_monotonic_time();
+
+  /* A recording runs until it ends, anything else for a fixed time */
+  while( !fuse_exiting && !error && !differs &&
+         ( playback ? rzx_playback :
+                      frames < (libspectrum_dword)settings_current.state_frames ) ) {
+    z80_do_opcodes();
+    event_do_events();
+  }
+
+  elapsed = compat_timer_get_monotonic_time() - start;
+  statelog_active = 0;
+
+  sound_end();
+  sound_silent = 0;
+  timer_unthrottled = 0;
+  sound_init( settings_current.sound_device );
+
+  close_files();
+
+  printf( "%s: %lu frames in %.1f s (%.0f frames/s)%s\n", fuse_progname,
+          (unsigned long)frames, elapsed, elapsed > 0 ? frames / elapsed : 0.0,
+          settings_current.state_golden ?
+            ( differs ? ", differs from golden log" : ", same as golden log" ) :
+            "" );
+
+  return error || differs ? 1 : 0;
+}
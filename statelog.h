@@ -0,0 +1,57 @@
+/* statelog.h: per-frame hashes of the machine state
+   Copyright (c) 2026 Fuse contributors
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+   Author contact information:
+
+   E-mail: philip-fuse@shadowmagic.org.uk
+
+*/
+
+#ifndef FUSE_STATELOG_H
+#define FUSE_STATELOG_H
+
+#include <libspectrum.h>
+
+/* The parts of the machine hashed separately each frame, so that a
+   difference can be tracked down to one of them */
+typedef enum statelog_component {
+  STATELOG_COMPONENT_CPU,	/* Z80 registers and t-state count */
+  STATELOG_COMPONENT_MEMORY,	/* All RAM and how it is paged in */
+  STATELOG_COMPONENT_ULA,	/* Border, paging ports and screen */
+  STATELOG_COMPONENT_AY,	/* AY registers */
+  STATELOG_COMPONENT_DISPLAY,	/* The rendered display */
+
+  STATELOG_COMPONENT_COUNT
+} statelog_component;
+
+/* Set while the hashes are being logged or compared */
+extern int statelog_active;
+
+/* Called at the end of each frame */
+void statelog_frame( void );
+
+/* Run the snapshot or recording given on the command line, without
+   throttling, writing a hash of each frame's state and/or comparing it
+   against a golden log. Returns non-zero if anything differed */
+int statelog_run( void );
+
+/* Add 'length' bytes to the hash 'seed'; the same as XXH32 with that seed,
+   so that logs can be compared between hosts */
+libspectrum_dword statelog_hash( libspectrum_dword seed,
+                                 const libspectrum_byte *data, size_t length );
+
+#endif				/* #ifndef FUSE_STATELOG_H */
@@ -41,6 +41,7 @@
 #include "memory_pages.h"
 #include "peripherals/ula.h"
 #include "phantom_typist.h"
+#include "runahead.h"
 #include "rzx.h"
 #include "settings.h"
 #include "sound.h"
@@ -387,7 +388,7 @@ tape_load_trap( void )
 
   /* Do nothing if tape traps aren't active, or the tape is already playing */
   if( !settings_current.tape_traps || tape_playing ||
-      rzx_playback || rzx_recording )
+      rzx_playback || rzx_recording || runahead_active )
     return 2;
 
   /* Do nothing if we're not in the correct ROM */
@@ -575,7 +576,7 @@ tape_save_trap( void )
 
   /* Do nothing if tape traps aren't active */
   if( !settings_current.tape_traps || tape_recording ||
-      rzx_playback || rzx_recording )
+      rzx_playback || rzx_recording || runahead_active )
     return 2;
 
   /* Check we're in the right ROM */
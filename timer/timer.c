@@ -24,9 +24,13 @@
 #include <config.h>
 
 #include "event.h"
+#include "export.h"
 #include "infrastructure/startup_manager.h"
 #include "movie.h"
+#include "perfstats.h"
 #include "phantom_typist.h"
+#include "runahead.h"
+#include "rzx.h"
 #include "settings.h"
 #include "sound.h"
 #include "tape.h"
@@ -59,6 +63,8 @@ static const int TEN_MS = 10;
 
 int timer_event;
 
+int timer_unthrottled = 0;
+
 static void timer_frame( libspectrum_dword last_tstates, int event GCC_UNUSED,
 			 void *user_data GCC_UNUSED );
 
@@ -138,6 +144,15 @@ timer_register_startup( void )
                             timer_end );
 }
 
+/* Sleep, charging the time to waiting rather than to the timer event */
+static void
+timer_wait( int ms )
+{
+  perfstats_stage stage = perfstats_enter( PERFSTATS_STAGE_SLEEP );
+  timer_sleep( ms );
+  perfstats_enter( stage );
+}
+
 #ifdef SOUND_FIFO
 
 /* Callback-style sound based timer */
@@ -152,7 +167,7 @@ timer_frame_callback_sound( libspectrum_dword last_tstates )
 
     /* Sleep while fifo is full */
     if( sfifo_space( &sound_fifo ) < sound_framesiz ) {
-      timer_sleep( TEN_MS );
+      timer_wait( TEN_MS );
     } else {
       break;
     }
@@ -206,14 +221,23 @@ timer_frame( libspectrum_dword last_tstates, int event GCC_UNUSED,
   double current_time, difference;
   long tstates;
 
-  if( sound_enabled && settings_current.sound ) {
+  /* Frames run ahead happen as fast as possible */
+  if( runahead_active ) {
+    event_add( last_tstates + machine_current->timings.tstates_per_frame,
+               timer_event );
+    return;
+  }
+
+  if( sound_enabled && settings_current.sound && !sound_silent ) {
     timer_frame_callback_sound( last_tstates );
     return;
   }
 
-  /* If we're fastloading, just schedule another check in a frame's time
+  /* If we're fastloading, seeking in an RZX file, exporting at full speed
+     or running unthrottled, just schedule another check in a frame's time
      and do nothing else */
-  if( settings_current.fastload && timer_fastloading_active() ) {
+  if( ( settings_current.fastload && timer_fastloading_active() ) ||
+      rzx_seeking || export_unthrottled() || timer_unthrottled ) {
 
     libspectrum_dword next_check_time =
       last_tstates + machine_current->timings.tstates_per_frame;
@@ -233,7 +257,7 @@ timer_frame( libspectrum_dword last_tstates, int event GCC_UNUSED,
 
       /* Sleep while we are still 10ms ahead */
       if( difference < 0 ) {
-        timer_sleep( TEN_MS );
+        timer_wait( TEN_MS );
       } else {
 	break;
       }
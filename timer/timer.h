@@ -34,6 +34,9 @@ void timer_register_startup( void );
 extern float current_speed;
 extern int timer_event;
 
+/* Set to run the emulation as fast as possible */
+extern int timer_unthrottled;
+
 void timer_start_fastloading( void );
 void timer_stop_fastloading( void );
 int timer_fastloading_active( void );
@@ -656,6 +656,10 @@ static const struct menu_item_entries menu_item_lookup[] = {
     "/File/Recording/Rollback", 0,
     "/File/Recording/Rollback to...", 0 },
 
+  { UI_MENU_ITEM_RECORDING_SEEK,
+    "/File/Recording/Seek forward",
+    "/File/Recording/Seek backward", 0 },
+
   { UI_MENU_ITEM_AY_LOGGING,
     "/File/AY Logging/Stop",
     "/File/AY Logging/Record...", 1, },
@@ -1248,6 +1248,8 @@ GtkActionEntry gtkui_menu_data[] = {
   { "FILE_RECORDING_INSERTSNAPSHOT", NULL, "_Insert snapshot", "Insert", NULL, G_CALLBACK( menu_file_recording_insertsnapshot ) },
   { "FILE_RECORDING_ROLLBACK", NULL, "Roll_back", "Delete", NULL, G_CALLBACK( menu_file_recording_rollback ) },
   { "FILE_RECORDING_PLAY", NULL, "_Play...", NULL, NULL, G_CALLBACK( menu_file_recording_play ) },
+  { "FILE_RECORDING_SEEKFORWARD", NULL, "Seek for_ward", NULL, NULL, G_CALLBACK( menu_file_recording_seekforward ) },
+  { "FILE_RECORDING_SEEKBACKWARD", NULL, "Seek bac_kward", NULL, NULL, G_CALLBACK( menu_file_recording_seekbackward ) },
   { "FILE_RECORDING_STOP", NULL, "_Stop", NULL, NULL, G_CALLBACK( menu_file_recording_stop ) },
   { "FILE_RECORDING_FINALISE", NULL, "_Finalise...", NULL, NULL, G_CALLBACK( menu_file_recording_finalise ) },
   { "FILE_AYLOGGING", NULL, "A_Y Logging", NULL, NULL, NULL },
@@ -1319,6 +1321,11 @@ GtkActionEntry gtkui_menu_data[] = {
   { "MACHINE_PROFILER", NULL, "Pro_filer", NULL, NULL, NULL },
   { "MACHINE_PROFILER_START", NULL, "_Start", NULL, NULL, G_CALLBACK( menu_machine_profiler_start ) },
   { "MACHINE_PROFILER_STOP", NULL, "_Stop", NULL, NULL, G_CALLBACK( menu_machine_profiler_stop ) },
+  { "MACHINE_PERFORMANCE", NULL, "P_erformance", NULL, NULL, NULL },
+  { "MACHINE_PERFORMANCE_START", NULL, "_Start", NULL, NULL, G_CALLBACK( menu_machine_performance_start ) },
+  { "MACHINE_PERFORMANCE_STOP", NULL, "Sto_p", NULL, NULL, G_CALLBACK( menu_machine_performance_stop ) },
+  { "MACHINE_PERFORMANCE_SHOW", NULL, "S_how...", NULL, NULL, G_CALLBACK( menu_machine_performance_show ) },
+  { "MACHINE_PERFORMANCE_SAVE", NULL, "Sa_ve...", NULL, NULL, G_CALLBACK( menu_machine_performance_save ) },
   { "MACHINE_NMI", NULL, "_NMI", NULL, NULL, G_CALLBACK( menu_machine_nmi ) },
   { "MACHINE_MULTIFACEREDBUTTON", NULL, "Multiface Red _Button", NULL, NULL, G_CALLBACK( menu_machine_multifaceredbutton ) },
   { "MACHINE_DIDAKTIKSNAP", NULL, "Didaktik SNA_P", NULL, NULL, G_CALLBACK( menu_machine_didaktiksnap ) },
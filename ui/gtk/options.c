@@ -124,6 +124,29 @@ menu_options_general( GtkWidget *widget GCC_UNUSED,
     gtk_box_pack_start( GTK_BOX( hbox ), text, FALSE, FALSE, 5 );
   }
 
+  {
+    GtkWidget *frame = gtk_frame_new( "Run ahead" );
+    GtkWidget *hbox = gtk_box_new( GTK_ORIENTATION_HORIZONTAL, 0 );
+    GtkWidget *text = gtk_label_new( "frames" );
+    gchar buffer[80];
+
+    gtk_box_pack_start( GTK_BOX( content_area ), frame, TRUE, TRUE, 0 );
+
+    gtk_container_set_border_width( GTK_CONTAINER( hbox ), 4 );
+    gtk_container_add( GTK_CONTAINER( frame ), hbox );
+
+    dialog.run_ahead = gtk_entry_new();
+    gtk_entry_set_max_length( GTK_ENTRY( dialog.run_ahead ),
+                              1 );
+    snprintf( buffer, 80, "%d", settings_current.run_ahead );
+    gtk_entry_set_text( GTK_ENTRY( dialog.run_ahead ), buffer );
+    gtk_entry_set_activates_default( GTK_ENTRY( dialog.run_ahead ), TRUE );
+
+    gtk_box_pack_start( GTK_BOX( hbox ), dialog.run_ahead, TRUE, TRUE, 0 );
+
+    gtk_box_pack_start( GTK_BOX( hbox ), text, FALSE, FALSE, 5 );
+  }
+
   dialog.issue2 =
     gtk_check_button_new_with_label( "Issue 2 keyboard" );
   gtk_toggle_button_set_active( GTK_TOGGLE_BUTTON( dialog.issue2 ),
@@ -232,6 +255,9 @@ menu_options_general_done( GtkWidget *widget GCC_UNUSED,
   settings_current.frame_rate =
     atoi( gtk_entry_get_text( GTK_ENTRY( ptr->frame_rate ) ) );
 
+  settings_current.run_ahead =
+    atoi( gtk_entry_get_text( GTK_ENTRY( ptr->run_ahead ) ) );
+
   settings_current.issue2 =
     gtk_toggle_button_get_active( GTK_TOGGLE_BUTTON( ptr->issue2 ) );
 
@@ -982,6 +1008,35 @@ menu_options_rzx( GtkWidget *widget GCC_UNUSED,
                                 settings_current.embed_snapshot );
   gtk_container_add( GTK_CONTAINER( content_area ), dialog.embed_snapshot );
 
+  dialog.rzx_stream =
+    gtk_check_button_new_with_label( "Stream recording to disk" );
+  gtk_toggle_button_set_active( GTK_TOGGLE_BUTTON( dialog.rzx_stream ),
+                                settings_current.rzx_stream );
+  gtk_container_add( GTK_CONTAINER( content_area ), dialog.rzx_stream );
+
+  {
+    GtkWidget *frame = gtk_frame_new( "Stream flush interval" );
+    GtkWidget *hbox = gtk_box_new( GTK_ORIENTATION_HORIZONTAL, 0 );
+    GtkWidget *text = gtk_label_new( "frames" );
+    gchar buffer[80];
+
+    gtk_box_pack_start( GTK_BOX( content_area ), frame, TRUE, TRUE, 0 );
+
+    gtk_container_set_border_width( GTK_CONTAINER( hbox ), 4 );
+    gtk_container_add( GTK_CONTAINER( frame ), hbox );
+
+    dialog.rzx_stream_frames = gtk_entry_new();
+    gtk_entry_set_max_length( GTK_ENTRY( dialog.rzx_stream_frames ),
+                              4 );
+    snprintf( buffer, 80, "%d", settings_current.rzx_stream_frames );
+    gtk_entry_set_text( GTK_ENTRY( dialog.rzx_stream_frames ), buffer );
+    gtk_entry_set_activates_default( GTK_ENTRY( dialog.rzx_stream_frames ), TRUE );
+
+    gtk_box_pack_start( GTK_BOX( hbox ), dialog.rzx_stream_frames, TRUE, TRUE, 0 );
+
+    gtk_box_pack_start( GTK_BOX( hbox ), text, FALSE, FALSE, 5 );
+  }
+
   /* Create the OK and Cancel buttons */
   gtkstock_create_ok_cancel( dialog.dialog, NULL,
                              G_CALLBACK( menu_options_rzx_done ),
@@ -1021,6 +1076,12 @@ menu_options_rzx_done( GtkWidget *widget GCC_UNUSED,
   settings_current.embed_snapshot =
     gtk_toggle_button_get_active( GTK_TOGGLE_BUTTON( ptr->embed_snapshot ) );
 
+  settings_current.rzx_stream =
+    gtk_toggle_button_get_active( GTK_TOGGLE_BUTTON( ptr->rzx_stream ) );
+
+  settings_current.rzx_stream_frames =
+    atoi( gtk_entry_get_text( GTK_ENTRY( ptr->rzx_stream_frames ) ) );
+
   gtk_widget_destroy( ptr->dialog );
 
   gtkstatusbar_set_visibility( settings_current.statusbar );
@@ -2123,6 +2184,12 @@ menu_options_movie( GtkWidget *widget GCC_UNUSED,
     gtk_box_pack_start( GTK_BOX( content_area ), hbox, TRUE, TRUE, 0 );
   }
 
+  dialog.movie_compr_fast =
+    gtk_check_button_new_with_label( "Fast compression" );
+  gtk_toggle_button_set_active( GTK_TOGGLE_BUTTON( dialog.movie_compr_fast ),
+                                settings_current.movie_compr_fast );
+  gtk_container_add( GTK_CONTAINER( content_area ), dialog.movie_compr_fast );
+
   dialog.movie_stop_after_rzx =
     gtk_check_button_new_with_label( "Stop recording after RZX ends" );
   gtk_toggle_button_set_active( GTK_TOGGLE_BUTTON( dialog.movie_stop_after_rzx ),
@@ -2157,6 +2224,9 @@ menu_options_movie_done( GtkWidget *widget GCC_UNUSED,
   settings_current.movie_compr = utils_safe_strdup( movie_movie_compr_combo[
     gtk_combo_box_get_active( GTK_COMBO_BOX( ptr->movie_compr ) ) ] );
 
+  settings_current.movie_compr_fast =
+    gtk_toggle_button_get_active( GTK_TOGGLE_BUTTON( ptr->movie_compr_fast ) );
+
   settings_current.movie_stop_after_rzx =
     gtk_toggle_button_get_active( GTK_TOGGLE_BUTTON( ptr->movie_stop_after_rzx ) );
 
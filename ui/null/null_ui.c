@@ -23,8 +23,15 @@
 
 #include <config.h>
 
+#include <stddef.h>
+
+#include "display.h"
 #include "keyboard.h"
+#include "machine.h"
+#include "settings.h"
+#include "ui/scaler/scaler.h"
 #include "ui/ui.h"
+#include "ui/uidisplay.h"
 
 #include "../uijoystick.c"
 
@@ -205,10 +212,119 @@ ui_widgets_reset( void )
   return 0;
 }
 
+/* With --benchmark-output, the screen is drawn into memory and scaled
+   just as the other UIs do, so that the cost of doing so can be measured
+   without a display */
+static int null_render = 0;
+
+static int null_image_width, null_image_height;
+
+/* The colour of every pixel on the screen */
+static libspectrum_byte
+  null_image[ 2 * DISPLAY_SCREEN_HEIGHT ][ DISPLAY_SCREEN_WIDTH ];
+
+/* A 16 bit image of the screen; slightly bigger than the real screen to
+   handle the smoothing filters which read around each pixel */
+static libspectrum_word
+  null_rgb_image[ 2 * ( DISPLAY_SCREEN_HEIGHT + 4 ) ][ DISPLAY_SCREEN_WIDTH + 3 ];
+static const ptrdiff_t null_rgb_pitch =
+  ( DISPLAY_SCREEN_WIDTH + 3 ) * sizeof( libspectrum_word );
+
+/* The scaled image */
+static libspectrum_word
+  null_scaled_image[ 3 * DISPLAY_SCREEN_HEIGHT ][ 3 * DISPLAY_SCREEN_WIDTH / 2 ];
+static const ptrdiff_t null_scaled_pitch =
+  3 * DISPLAY_SCREEN_WIDTH / 2 * sizeof( libspectrum_word );
+
+static libspectrum_word null_colours[16], null_bw_colours[16];
+
+static void
+null_init_colours( void )
+{
+  int i, red, green, blue, grey, bright;
+
+  for( i = 0; i < 16; i++ ) {
+    bright = ( i & 0x08 ) ? 255 : 192;
+    red   = ( i & 0x02 ) ? bright : 0;
+    green = ( i & 0x04 ) ? bright : 0;
+    blue  = ( i & 0x01 ) ? bright : 0;
+
+    /* Addition of 0.5 is to avoid rounding errors */
+    grey = ( 0.299 * red + 0.587 * green + 0.114 * blue ) + 0.5;
+
+    null_colours[i] = ( red >> 3 ) << 11 | ( green >> 2 ) << 5 | blue >> 3;
+    null_bw_colours[i] = ( grey >> 3 ) << 11 | ( grey >> 2 ) << 5 | grey >> 3;
+  }
+}
+
+static void
+null_init_scalers( void )
+{
+  scaler_register_clear();
+
+  if( machine_current->timex ) {
+    scaler_register( SCALER_HALF );
+    scaler_register( SCALER_HALFSKIP );
+    scaler_register( SCALER_TIMEXTV );
+    scaler_register( SCALER_TIMEX1_5X );
+  } else {
+    scaler_register( SCALER_DOUBLESIZE );
+    scaler_register( SCALER_TRIPLESIZE );
+    scaler_register( SCALER_TV2X );
+    scaler_register( SCALER_TV3X );
+    scaler_register( SCALER_PALTV2X );
+    scaler_register( SCALER_PALTV3X );
+    scaler_register( SCALER_HQ2X );
+    scaler_register( SCALER_HQ3X );
+    scaler_register( SCALER_ADVMAME2X );
+    scaler_register( SCALER_ADVMAME3X );
+    scaler_register( SCALER_2XSAI );
+    scaler_register( SCALER_SUPER2XSAI );
+    scaler_register( SCALER_SUPEREAGLE );
+    scaler_register( SCALER_DOTMATRIX );
+  }
+  scaler_register( SCALER_NORMAL );
+  scaler_register( SCALER_PALTV );
+
+  scaler_select_bitformat( 565 );
+
+  if( !scaler_is_supported( current_scaler ) )
+    scaler_select_scaler( SCALER_NORMAL );
+}
+
 void
 uidisplay_area( int x, int y, int w, int h )
 {
-  /* Do nothing */
+  float scale;
+  int scaled_x, scaled_y, i, yy;
+  libspectrum_word *palette, *rgb;
+  libspectrum_byte *display;
+
+  if( !null_render ) return;
+
+  /* Extend the dirty region by 1 pixel for scalers
+     that "smear" the screen, e.g. 2xSAI */
+  if( scaler_flags & SCALER_FLAGS_EXPAND )
+    scaler_expander( &x, &y, &w, &h, null_image_width, null_image_height );
+
+  scale = scaler_get_scaling_factor( current_scaler );
+  scaled_x = scale * x; scaled_y = scale * y;
+
+  palette = settings_current.bw_tv ? null_bw_colours : null_colours;
+
+  /* Create the 16 bit image */
+  for( yy = y; yy < y + h; yy++ ) {
+    rgb = &null_rgb_image[ yy + 2 ][ x + 1 ];
+    display = &null_image[ yy ][ x ];
+
+    for( i = 0; i < w; i++ ) *(rgb++) = palette[ *(display++) ];
+  }
+
+  /* Create scaled image */
+  scaler_proc16( (libspectrum_byte*)&null_rgb_image[ y + 2 ][ x + 1 ],
+                 null_rgb_pitch,
+                 (libspectrum_byte*)&null_scaled_image[ scaled_y ][ scaled_x ],
+                 null_scaled_pitch, w, h );
 }
 
 int
@@ -234,6 +350,16 @@ uidisplay_hotswap_gfx_mode( void )
 int
 uidisplay_init( int width, int height )
 {
+  null_render = settings_current.benchmark_output;
+  if( !null_render ) return 0;
+
+  null_image_width = width; null_image_height = height;
+
+  null_init_colours();
+  null_init_scalers();
+
+  display_refresh_all();
+
   /* No error */
   return 0;
 }
@@ -242,18 +368,61 @@ void
 uidisplay_plot16( int x, int y, libspectrum_word data,
     libspectrum_byte ink, libspectrum_byte paper )
 {
-  /* Do nothing */
+  int i;
+  libspectrum_word mask;
+  libspectrum_byte *dest;
+
+  if( !null_render ) return;
+
+  x <<= 4; y <<= 1;
+
+  for( i = 0; i < 2; i++, y++ ) {
+    dest = &null_image[y][x];
+    for( mask = 0x8000; mask; mask >>= 1 )
+      *(dest++) = ( data & mask ) ? ink : paper;
+  }
 }
 
 void
 uidisplay_plot8( int x, int y, libspectrum_byte data,
     libspectrum_byte ink, libspectrum_byte paper )
 {
-  /* Do nothing */
+  int i;
+  libspectrum_byte mask, colour, *dest;
+
+  if( !null_render ) return;
+
+  x <<= 3;
+
+  if( machine_current->timex ) {
+    x <<= 1; y <<= 1;
+    for( i = 0; i < 2; i++, y++ ) {
+      dest = &null_image[y][x];
+      for( mask = 0x80; mask; mask >>= 1 ) {
+        colour = ( data & mask ) ? ink : paper;
+        *(dest++) = colour;
+        *(dest++) = colour;
+      }
+    }
+  } else {
+    dest = &null_image[y][x];
+    for( mask = 0x80; mask; mask >>= 1 )
+      *(dest++) = ( data & mask ) ? ink : paper;
+  }
 }
 
 void
 uidisplay_putpixel( int x, int y, int colour )
 {
-  /* Do nothing */
+  if( !null_render ) return;
+
+  if( machine_current->timex ) {
+    x <<= 1; y <<= 1;
+    null_image[y  ][x  ] = colour;
+    null_image[y  ][x+1] = colour;
+    null_image[y+1][x  ] = colour;
+    null_image[y+1][x+1] = colour;
+  } else {
+    null_image[y][x] = colour;
+  }
 }
@@ -179,6 +179,12 @@ scaler_is_supported( scaler_type scaler )
   return ( scaler >= SCALER_NUM ? 0 : scaler_supported[scaler] );
 }
 
+const char *
+scaler_id( scaler_type scaler )
+{
+  return available_scalers[scaler].id;
+}
+
 const char *
 scaler_name( scaler_type scaler )
 {
@@ -80,6 +80,7 @@ int scaler_select_scaler( scaler_type scaler );
 void scaler_register( scaler_type scaler );
 int scaler_is_supported( scaler_type scaler );
 const char *scaler_name( scaler_type scaler );
+const char *scaler_id( scaler_type scaler );
 ScalerProc *scaler_get_proc16( scaler_type scaler );
 ScalerProc *scaler_get_proc32( scaler_type scaler );
 scaler_flags_t scaler_get_flags( scaler_type scaler );
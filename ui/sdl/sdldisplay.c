@@ -54,6 +54,13 @@ static int sdl_status_updated;
 
 static int tmp_screen_width;
 
+/* The depth of the screen surface, chosen the first time it is created.
+   We render at the screen's own depth where we have scalers for it so
+   the scaled output goes straight into the surface SDL hands to the
+   display, rather than through a 16 bit shadow surface which SDL then
+   has to convert on every update */
+static int sdldisplay_bpp = 0;
+
 static Uint32 colour_values[16];
 
 static SDL_Color colour_palette[] = {
@@ -105,6 +112,44 @@ static int sdldisplay_allocate_colours( int numColours, Uint32 *colour_values,
                                         Uint32 *bw_values );
 
 static int sdldisplay_load_gfx_mode( void );
+static ScalerProc *sdldisplay_scaler_proc( SDL_Surface *surface,
+                                           scaler_type scaler );
+
+/* The routines which write pixels into tmp_screen at each depth */
+#define SDL_PLOT_TYPE libspectrum_word
+#define SDL_PLOT( name ) name##_16
+#include "sdlplot.c"
+#undef SDL_PLOT_TYPE
+#undef SDL_PLOT
+
+#define SDL_PLOT_TYPE libspectrum_dword
+#define SDL_PLOT( name ) name##_32
+#include "sdlplot.c"
+#undef SDL_PLOT_TYPE
+#undef SDL_PLOT
+
+typedef struct sdldisplay_plot_fns {
+  void (*fill)( libspectrum_byte *dest, Uint32 colour, int count );
+  void (*plot8)( libspectrum_byte *dest, libspectrum_byte data,
+                 Uint32 ink, Uint32 paper );
+  void (*plot8_wide)( libspectrum_byte *dest, libspectrum_byte data,
+                      Uint32 ink, Uint32 paper );
+  void (*plot16)( libspectrum_byte *dest, libspectrum_word data,
+                  Uint32 ink, Uint32 paper );
+} sdldisplay_plot_fns;
+
+static const sdldisplay_plot_fns sdldisplay_plot_fns_16 = {
+  sdl_plot_fill_16, sdl_plot8_16, sdl_plot8_wide_16, sdl_plot16_16
+};
+
+static const sdldisplay_plot_fns sdldisplay_plot_fns_32 = {
+  sdl_plot_fill_32, sdl_plot8_32, sdl_plot8_wide_32, sdl_plot16_32
+};
+
+/* The routines for the depth tmp_screen is at, chosen whenever it is
+   created */
+static const sdldisplay_plot_fns *sdldisplay_plotter =
+  &sdldisplay_plot_fns_16;
 
 static void
 init_scalers( void )
@@ -173,7 +218,7 @@ sdl_convert_icon( SDL_Surface *source, SDL_Surface **icon, int red )
                                   icon[0]->format->Amask
                                 );
 
-  ( scaler_get_proc16( SCALER_DOUBLESIZE ) )(
+  ( sdldisplay_scaler_proc( icon[0], SCALER_DOUBLESIZE ) )(
         (libspectrum_byte*)icon[0]->pixels,
         icon[0]->pitch,
         (libspectrum_byte*)icon[1]->pixels,
@@ -364,10 +409,20 @@ sdldisplay_find_best_fullscreen_scaler( void )
   }
 }
 
+/* Get the scaler which writes pixels in the same format as `surface' */
+static ScalerProc *
+sdldisplay_scaler_proc( SDL_Surface *surface, scaler_type scaler )
+{
+  return surface->format->BytesPerPixel == 4 ? scaler_get_proc32( scaler ) :
+                                               scaler_get_proc16( scaler );
+}
+
 static int
 sdldisplay_load_gfx_mode( void )
 {
-  Uint16 *tmp_screen_pixels;
+  libspectrum_byte *tmp_screen_pixels;
+  int width, height, bytes_per_pixel;
+  Uint32 flags;
 
   sdldisplay_force_full_refresh = 1;
 
@@ -384,16 +439,32 @@ sdldisplay_load_gfx_mode( void )
 
   sdldisplay_find_best_fullscreen_scaler();
 
-  /* Create the surface that contains the scaled graphics in 16 bit mode */
-  sdldisplay_gc = SDL_SetVideoMode(
-    settings_current.full_screen && fullscreen_width ? fullscreen_width :
-      image_width * sdldisplay_current_size,
-    settings_current.full_screen && fullscreen_width ? max_fullscreen_height :
-      image_height * sdldisplay_current_size,
-    16,
-    settings_current.full_screen ? (SDL_FULLSCREEN|SDL_SWSURFACE)
-                                 : SDL_SWSURFACE
-  );
+  width = settings_current.full_screen && fullscreen_width ?
+            fullscreen_width : image_width * sdldisplay_current_size;
+  height = settings_current.full_screen && fullscreen_width ?
+             max_fullscreen_height : image_height * sdldisplay_current_size;
+  flags = settings_current.full_screen ? (SDL_FULLSCREEN|SDL_SWSURFACE)
+                                       : SDL_SWSURFACE;
+
+  /* Create the surface that contains the scaled graphics. The first time
+     through, take whatever depth the screen is at; if we don't have
+     scalers for that, fall back to 16 bit mode and let SDL convert */
+  if( sdldisplay_bpp ) {
+    sdldisplay_gc = SDL_SetVideoMode( width, height, sdldisplay_bpp, flags );
+  } else {
+    sdldisplay_gc = SDL_SetVideoMode( width, height, 16,
+                                      flags | SDL_ANYFORMAT );
+    if( sdldisplay_gc ) {
+      bytes_per_pixel = sdldisplay_gc->format->BytesPerPixel;
+      if( bytes_per_pixel == 2 || bytes_per_pixel == 4 ) {
+        sdldisplay_bpp = sdldisplay_gc->format->BitsPerPixel;
+      } else {
+        sdldisplay_bpp = 16;
+        sdldisplay_gc = SDL_SetVideoMode( width, height, sdldisplay_bpp,
+                                          flags );
+      }
+    }
+  }
   if( !sdldisplay_gc ) {
     fprintf( stderr, "%s: couldn't create SDL graphics context\n", fuse_progname );
     fuse_abort();
@@ -409,14 +480,20 @@ sdldisplay_load_gfx_mode( void )
   else
     scaler_select_bitformat( 565 );
 
-  /* Create the surface used for the graphics in 16 bit before scaling */
+  /* Create the surface used for the graphics before scaling, in the same
+     format as the screen */
+  bytes_per_pixel = sdldisplay_gc->format->BytesPerPixel;
+  sdldisplay_plotter = bytes_per_pixel == 4 ? &sdldisplay_plot_fns_32 :
+                                              &sdldisplay_plot_fns_16;
 
   /* Need some extra bytes around when using 2xSaI */
-  tmp_screen_pixels = (Uint16*)calloc(tmp_screen_width*(image_height+3), sizeof(Uint16));
+  tmp_screen_pixels = calloc( tmp_screen_width * ( image_height + 3 ),
+                              bytes_per_pixel );
   tmp_screen = SDL_CreateRGBSurfaceFrom(tmp_screen_pixels,
                                         tmp_screen_width,
                                         image_height + 3,
-                                        16, tmp_screen_width*2,
+                                        sdldisplay_gc->format->BitsPerPixel,
+                                        tmp_screen_width * bytes_per_pixel,
                                         sdldisplay_gc->format->Rmask,
                                         sdldisplay_gc->format->Gmask,
                                         sdldisplay_gc->format->Bmask,
@@ -526,7 +603,7 @@ sdl_blit_icon( SDL_Surface **icon,
   dst_h = h;
   dst_x = x * sdldisplay_current_size + fullscreen_x_off;
 
-  scaler_proc16(
+  ( sdldisplay_scaler_proc( tmp_screen, current_scaler ) )(
 	(libspectrum_byte*)tmp_screen->pixels +
 			(x+1) * tmp_screen->format->BytesPerPixel +
 	                (y+1) * tmp_screen_pitch,
@@ -601,11 +678,19 @@ sdl_icon_overlay( Uint32 tmp_screen_pitch, Uint32 dstPitch )
   sdl_status_updated = 0;
 }
 
+/* Get the address of pixel ( x, y ) in tmp_screen */
+static libspectrum_byte*
+sdl_tmp_screen_pixel( int x, int y )
+{
+  return (libspectrum_byte*)tmp_screen->pixels +
+         (x+1) * tmp_screen->format->BytesPerPixel +
+         (y+1) * tmp_screen->pitch;
+}
+
 /* Set one pixel in the display */
 void
 uidisplay_putpixel( int x, int y, int colour )
 {
-  libspectrum_word *dest_base, *dest;
   Uint32 *palette_values = settings_current.bw_tv ? bw_values :
                            colour_values;
 
@@ -613,24 +698,13 @@ uidisplay_putpixel( int x, int y, int colour )
 
   if( machine_current->timex ) {
     x <<= 1; y <<= 1;
-    dest_base = dest =
-      (libspectrum_word*)( (libspectrum_byte*)tmp_screen->pixels +
-                           (x+1) * tmp_screen->format->BytesPerPixel +
-                           (y+1) * tmp_screen->pitch);
-
-    *(dest++) = palette_colour;
-    *(dest++) = palette_colour;
-    dest = (libspectrum_word*)
-      ( (libspectrum_byte*)dest_base + tmp_screen->pitch);
-    *(dest++) = palette_colour;
-    *(dest++) = palette_colour;
+    sdldisplay_plotter->fill( sdl_tmp_screen_pixel( x, y     ),
+                              palette_colour, 2 );
+    sdldisplay_plotter->fill( sdl_tmp_screen_pixel( x, y + 1 ),
+                              palette_colour, 2 );
   } else {
-    dest =
-      (libspectrum_word*)( (libspectrum_byte*)tmp_screen->pixels +
-                           (x+1) * tmp_screen->format->BytesPerPixel +
-                           (y+1) * tmp_screen->pitch);
-
-    *dest = palette_colour;
+    sdldisplay_plotter->fill( sdl_tmp_screen_pixel( x, y ),
+                              palette_colour, 1 );
   }
 }
 
@@ -640,7 +714,6 @@ void
 uidisplay_plot8( int x, int y, libspectrum_byte data,
 	         libspectrum_byte ink, libspectrum_byte paper )
 {
-  libspectrum_word *dest;
   Uint32 *palette_values = settings_current.bw_tv ? bw_values :
                            colour_values;
 
@@ -648,55 +721,17 @@ uidisplay_plot8( int x, int y, libspectrum_byte data,
   Uint32 palette_paper = palette_values[ paper ];
 
   if( machine_current->timex ) {
-    int i;
-    libspectrum_word *dest_base;
-
     x <<= 4; y <<= 1;
 
-    dest_base =
-      (libspectrum_word*)( (libspectrum_byte*)tmp_screen->pixels +
-                           (x+1) * tmp_screen->format->BytesPerPixel +
-                           (y+1) * tmp_screen->pitch);
-
-    for( i=0; i<2; i++ ) {
-      dest = dest_base;
-
-      *(dest++) = ( data & 0x80 ) ? palette_ink : palette_paper;
-      *(dest++) = ( data & 0x80 ) ? palette_ink : palette_paper;
-      *(dest++) = ( data & 0x40 ) ? palette_ink : palette_paper;
-      *(dest++) = ( data & 0x40 ) ? palette_ink : palette_paper;
-      *(dest++) = ( data & 0x20 ) ? palette_ink : palette_paper;
-      *(dest++) = ( data & 0x20 ) ? palette_ink : palette_paper;
-      *(dest++) = ( data & 0x10 ) ? palette_ink : palette_paper;
-      *(dest++) = ( data & 0x10 ) ? palette_ink : palette_paper;
-      *(dest++) = ( data & 0x08 ) ? palette_ink : palette_paper;
-      *(dest++) = ( data & 0x08 ) ? palette_ink : palette_paper;
-      *(dest++) = ( data & 0x04 ) ? palette_ink : palette_paper;
-      *(dest++) = ( data & 0x04 ) ? palette_ink : palette_paper;
-      *(dest++) = ( data & 0x02 ) ? palette_ink : palette_paper;
-      *(dest++) = ( data & 0x02 ) ? palette_ink : palette_paper;
-      *(dest++) = ( data & 0x01 ) ? palette_ink : palette_paper;
-      *dest     = ( data & 0x01 ) ? palette_ink : palette_paper;
-
-      dest_base = (libspectrum_word*)
-        ( (libspectrum_byte*)dest_base + tmp_screen->pitch);
-    }
+    sdldisplay_plotter->plot8_wide( sdl_tmp_screen_pixel( x, y     ), data,
+                                    palette_ink, palette_paper );
+    sdldisplay_plotter->plot8_wide( sdl_tmp_screen_pixel( x, y + 1 ), data,
+                                    palette_ink, palette_paper );
   } else {
     x <<= 3;
 
-    dest =
-      (libspectrum_word*)( (libspectrum_byte*)tmp_screen->pixels +
-                           (x+1) * tmp_screen->format->BytesPerPixel +
-                           (y+1) * tmp_screen->pitch);
-
-    *(dest++) = ( data & 0x80 ) ? palette_ink : palette_paper;
-    *(dest++) = ( data & 0x40 ) ? palette_ink : palette_paper;
-    *(dest++) = ( data & 0x20 ) ? palette_ink : palette_paper;
-    *(dest++) = ( data & 0x10 ) ? palette_ink : palette_paper;
-    *(dest++) = ( data & 0x08 ) ? palette_ink : palette_paper;
-    *(dest++) = ( data & 0x04 ) ? palette_ink : palette_paper;
-    *(dest++) = ( data & 0x02 ) ? palette_ink : palette_paper;
-    *dest     = ( data & 0x01 ) ? palette_ink : palette_paper;
+    sdldisplay_plotter->plot8( sdl_tmp_screen_pixel( x, y ), data,
+                               palette_ink, palette_paper );
   }
 }
 
@@ -706,42 +741,16 @@ void
 uidisplay_plot16( int x, int y, libspectrum_word data,
 		  libspectrum_byte ink, libspectrum_byte paper )
 {
-  libspectrum_word *dest_base, *dest;
-  int i;
   Uint32 *palette_values = settings_current.bw_tv ? bw_values :
                            colour_values;
   Uint32 palette_ink = palette_values[ ink ];
   Uint32 palette_paper = palette_values[ paper ];
   x <<= 4; y <<= 1;
 
-  dest_base =
-    (libspectrum_word*)( (libspectrum_byte*)tmp_screen->pixels +
-                         (x+1) * tmp_screen->format->BytesPerPixel +
-                         (y+1) * tmp_screen->pitch);
-
-  for( i=0; i<2; i++ ) {
-    dest = dest_base;
-
-    *(dest++) = ( data & 0x8000 ) ? palette_ink : palette_paper;
-    *(dest++) = ( data & 0x4000 ) ? palette_ink : palette_paper;
-    *(dest++) = ( data & 0x2000 ) ? palette_ink : palette_paper;
-    *(dest++) = ( data & 0x1000 ) ? palette_ink : palette_paper;
-    *(dest++) = ( data & 0x0800 ) ? palette_ink : palette_paper;
-    *(dest++) = ( data & 0x0400 ) ? palette_ink : palette_paper;
-    *(dest++) = ( data & 0x0200 ) ? palette_ink : palette_paper;
-    *(dest++) = ( data & 0x0100 ) ? palette_ink : palette_paper;
-    *(dest++) = ( data & 0x0080 ) ? palette_ink : palette_paper;
-    *(dest++) = ( data & 0x0040 ) ? palette_ink : palette_paper;
-    *(dest++) = ( data & 0x0020 ) ? palette_ink : palette_paper;
-    *(dest++) = ( data & 0x0010 ) ? palette_ink : palette_paper;
-    *(dest++) = ( data & 0x0008 ) ? palette_ink : palette_paper;
-    *(dest++) = ( data & 0x0004 ) ? palette_ink : palette_paper;
-    *(dest++) = ( data & 0x0002 ) ? palette_ink : palette_paper;
-    *dest     = ( data & 0x0001 ) ? palette_ink : palette_paper;
-
-    dest_base = (libspectrum_word*)
-      ( (libspectrum_byte*)dest_base + tmp_screen->pitch);
-  }
+  sdldisplay_plotter->plot16( sdl_tmp_screen_pixel( x, y     ), data,
+                              palette_ink, palette_paper );
+  sdldisplay_plotter->plot16( sdl_tmp_screen_pixel( x, y + 1 ), data,
+                              palette_ink, palette_paper );
 }
 
 void
@@ -750,6 +759,7 @@ uidisplay_frame_end( void )
   SDL_Rect *r;
   Uint32 tmp_screen_pitch, dstPitch;
   SDL_Rect *last_rect;
+  ScalerProc *scaler_proc;
 
   /* We check for a switch to fullscreen here to give systems with a
      windowed-only UI a chance to free menu etc. resources before
@@ -781,13 +791,15 @@ uidisplay_frame_end( void )
 
   last_rect = updated_rects + num_rects;
 
+  scaler_proc = sdldisplay_scaler_proc( tmp_screen, current_scaler );
+
   for( r = updated_rects; r != last_rect; r++ ) {
 
     int dst_y = r->y * sdldisplay_current_size + fullscreen_y_off;
     int dst_h = r->h;
     int dst_x = r->x * sdldisplay_current_size + fullscreen_x_off;
 
-    scaler_proc16(
+    scaler_proc(
       (libspectrum_byte*)tmp_screen->pixels +
                         (r->x+1) * tmp_screen->format->BytesPerPixel +
 	                (r->y+1)*tmp_screen_pitch,
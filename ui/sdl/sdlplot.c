@@ -0,0 +1,105 @@
+/* sdlplot.c: Plot pixels into the SDL display at one depth
+   Copyright (c) 2000-2006 Philip Kendall, Matan Ziv-Av, Fredrick Meunier
+   Copyright (c) 2015 Adrien Destugues
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+   Author contact information:
+
+   E-mail: philip-fuse@shadowmagic.org.uk
+
+*/
+
+/* This file is included by sdldisplay.c once for each depth, with
+   SDL_PLOT_TYPE defined as the type of one pixel and SDL_PLOT( name ) as
+   the name of each function at that depth */
+
+/* Set `count' pixels to `colour' */
+static void
+SDL_PLOT( sdl_plot_fill )( libspectrum_byte *dest, Uint32 colour, int count )
+{
+  SDL_PLOT_TYPE *pixel = (SDL_PLOT_TYPE*)dest;
+
+  while( count-- ) *(pixel++) = colour;
+}
+
+/* Print the 8 pixels in `data' using ink colour `ink' and paper
+   colour `paper' */
+static void
+SDL_PLOT( sdl_plot8 )( libspectrum_byte *dest, libspectrum_byte data,
+                       Uint32 ink, Uint32 paper )
+{
+  SDL_PLOT_TYPE *pixel = (SDL_PLOT_TYPE*)dest;
+
+  *(pixel++) = ( data & 0x80 ) ? ink : paper;
+  *(pixel++) = ( data & 0x40 ) ? ink : paper;
+  *(pixel++) = ( data & 0x20 ) ? ink : paper;
+  *(pixel++) = ( data & 0x10 ) ? ink : paper;
+  *(pixel++) = ( data & 0x08 ) ? ink : paper;
+  *(pixel++) = ( data & 0x04 ) ? ink : paper;
+  *(pixel++) = ( data & 0x02 ) ? ink : paper;
+  *pixel     = ( data & 0x01 ) ? ink : paper;
+}
+
+/* As sdl_plot8(), but with each pixel two wide */
+static void
+SDL_PLOT( sdl_plot8_wide )( libspectrum_byte *dest, libspectrum_byte data,
+                            Uint32 ink, Uint32 paper )
+{
+  SDL_PLOT_TYPE *pixel = (SDL_PLOT_TYPE*)dest;
+
+  *(pixel++) = ( data & 0x80 ) ? ink : paper;
+  *(pixel++) = ( data & 0x80 ) ? ink : paper;
+  *(pixel++) = ( data & 0x40 ) ? ink : paper;
+  *(pixel++) = ( data & 0x40 ) ? ink : paper;
+  *(pixel++) = ( data & 0x20 ) ? ink : paper;
+  *(pixel++) = ( data & 0x20 ) ? ink : paper;
+  *(pixel++) = ( data & 0x10 ) ? ink : paper;
+  *(pixel++) = ( data & 0x10 ) ? ink : paper;
+  *(pixel++) = ( data & 0x08 ) ? ink : paper;
+  *(pixel++) = ( data & 0x08 ) ? ink : paper;
+  *(pixel++) = ( data & 0x04 ) ? ink : paper;
+  *(pixel++) = ( data & 0x04 ) ? ink : paper;
+  *(pixel++) = ( data & 0x02 ) ? ink : paper;
+  *(pixel++) = ( data & 0x02 ) ? ink : paper;
+  *(pixel++) = ( data & 0x01 ) ? ink : paper;
+  *pixel     = ( data & 0x01 ) ? ink : paper;
+}
+
+/* Print the 16 pixels in `data' using ink colour `ink' and paper
+   colour `paper' */
+static void
+SDL_PLOT( sdl_plot16 )( libspectrum_byte *dest, libspectrum_word data,
+                        Uint32 ink, Uint32 paper )
+{
+  SDL_PLOT_TYPE *pixel = (SDL_PLOT_TYPE*)dest;
+
+  *(pixel++) = ( data & 0x8000 ) ? ink : paper;
+  *(pixel++) = ( data & 0x4000 ) ? ink : paper;
+  *(pixel++) = ( data & 0x2000 ) ? ink : paper;
+  *(pixel++) = ( data & 0x1000 ) ? ink : paper;
+  *(pixel++) = ( data & 0x0800 ) ? ink : paper;
+  *(pixel++) = ( data & 0x0400 ) ? ink : paper;
+  *(pixel++) = ( data & 0x0200 ) ? ink : paper;
+  *(pixel++) = ( data & 0x0100 ) ? ink : paper;
+  *(pixel++) = ( data & 0x0080 ) ? ink : paper;
+  *(pixel++) = ( data & 0x0040 ) ? ink : paper;
+  *(pixel++) = ( data & 0x0020 ) ? ink : paper;
+  *(pixel++) = ( data & 0x0010 ) ? ink : paper;
+  *(pixel++) = ( data & 0x0008 ) ? ink : paper;
+  *(pixel++) = ( data & 0x0004 ) ? ink : paper;
+  *(pixel++) = ( data & 0x0002 ) ? ink : paper;
+  *pixel     = ( data & 0x0001 ) ? ink : paper;
+}
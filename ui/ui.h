@@ -240,6 +240,7 @@ typedef enum ui_menu_item {
   UI_MENU_ITEM_MEDIA_IDE_ZXMMC_EJECT,
   UI_MENU_ITEM_RECORDING,
   UI_MENU_ITEM_RECORDING_ROLLBACK,
+  UI_MENU_ITEM_RECORDING_SEEK,
   UI_MENU_ITEM_AY_LOGGING,
   UI_MENU_ITEM_TAPE_RECORDING,
 
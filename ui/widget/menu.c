@@ -696,6 +696,12 @@ menu_machine_memorybrowser( int action )
   widget_do_memorybrowser();
 }
 
+void
+menu_machine_performance_show( int action )
+{
+  widget_do_perfstats();
+}
+
 void
 menu_media_tape_browse( int action )
 {
@@ -40,6 +40,8 @@ static widget_menu_entry menu_file_recording[] = {
   { "\012I\011nsert snapshot", INPUT_KEY_i, NULL, menu_file_recording_insertsnapshot, NULL, 0 },
   { "Roll\012b\011ack", INPUT_KEY_b, NULL, menu_file_recording_rollback, NULL, 0 },
   { "\012P\011lay...", INPUT_KEY_p, NULL, menu_file_recording_play, NULL, 0 },
+  { "Seek for\012w\011ard", INPUT_KEY_w, NULL, menu_file_recording_seekforward, NULL, 0 },
+  { "Seek bac\012k\011ward", INPUT_KEY_k, NULL, menu_file_recording_seekbackward, NULL, 0 },
   { "\012S\011top", INPUT_KEY_s, NULL, menu_file_recording_stop, NULL, 0 },
   { "\012F\011inalise...", INPUT_KEY_f, NULL, menu_file_recording_finalise, NULL, 0 },
   { NULL }
@@ -162,6 +164,15 @@ static widget_menu_entry menu_machine_profiler[] = {
   { NULL }
 };
 
+static widget_menu_entry menu_machine_performance[] = {
+  { "Performance" },
+  { "\012S\011tart", INPUT_KEY_s, NULL, menu_machine_performance_start, NULL, 0 },
+  { "Sto\012p\011", INPUT_KEY_p, NULL, menu_machine_performance_stop, NULL, 0 },
+  { "S\012h\011ow...", INPUT_KEY_h, NULL, menu_machine_performance_show, NULL, 0 },
+  { "Sa\012v\011e...", INPUT_KEY_v, NULL, menu_machine_performance_save, NULL, 0 },
+  { NULL }
+};
+
 static widget_menu_entry menu_machine[] = {
   { "Machine" },
   { "\012R\011eset...", INPUT_KEY_r, NULL, menu_machine_reset, NULL, 0 },
@@ -172,6 +183,7 @@ static widget_menu_entry menu_machine[] = {
   { "Po\012k\011e Memory...", INPUT_KEY_k, NULL, menu_machine_pokememory, NULL, 0 },
   { "\012M\011emory Browser...", INPUT_KEY_m, NULL, menu_machine_memorybrowser, NULL, 0 },
   { "Pro\012f\011iler", INPUT_KEY_f, menu_machine_profiler, NULL, NULL, 0 },
+  { "P\012e\011rformance", INPUT_KEY_e, menu_machine_performance, NULL, NULL, 0 },
   { "\012N\011MI", INPUT_KEY_n, NULL, menu_machine_nmi, NULL, 0 },
   { "Multiface Red \012B\011utton", INPUT_KEY_b, NULL, menu_machine_multifaceredbutton, NULL, 0 },
   { "Didaktik SNA\012P\011", INPUT_KEY_p, NULL, menu_machine_didaktiksnap, NULL, 0 },
@@ -310,6 +310,8 @@ static void widget_emulation_speed_click( void );
 static void widget_option_emulation_speed_draw( int left_edge, int width, struct widget_option_entry *menu, settings_info *show );
 static void widget_frame_rate_click( void );
 static void widget_option_frame_rate_draw( int left_edge, int width, struct widget_option_entry *menu, settings_info *show );
+static void widget_run_ahead_click( void );
+static void widget_option_run_ahead_draw( int left_edge, int width, struct widget_option_entry *menu, settings_info *show );
 static void widget_issue2_click( void );
 static void widget_option_issue2_draw( int left_edge, int width, struct widget_option_entry *menu, settings_info *show );
 static void widget_recreated_spectrum_click( void );
@@ -436,6 +438,10 @@ static void widget_competition_code_click( void );
 static void widget_option_competition_code_draw( int left_edge, int width, struct widget_option_entry *menu, settings_info *show );
 static void widget_embed_snapshot_click( void );
 static void widget_option_embed_snapshot_draw( int left_edge, int width, struct widget_option_entry *menu, settings_info *show );
+static void widget_rzx_stream_click( void );
+static void widget_option_rzx_stream_draw( int left_edge, int width, struct widget_option_entry *menu, settings_info *show );
+static void widget_rzx_stream_frames_click( void );
+static void widget_option_rzx_stream_frames_draw( int left_edge, int width, struct widget_option_entry *menu, settings_info *show );
 static int  widget_sound_running = 0;
 static void widget_sound_click( void );
 static void widget_option_sound_draw( int left_edge, int width, struct widget_option_entry *menu, settings_info *show );
@@ -493,6 +499,8 @@ static void widget_option_disk_ask_merge_draw( int left_edge, int width, struct
 static int  widget_movie_running = 0;
 static void widget_movie_compr_click( void );
 static void widget_option_movie_compr_draw( int left_edge, int width, struct widget_option_entry *menu, settings_info *show );
+static void widget_movie_compr_fast_click( void );
+static void widget_option_movie_compr_fast_draw( int left_edge, int width, struct widget_option_entry *menu, settings_info *show );
 static void widget_movie_stop_after_rzx_click( void );
 static void widget_option_movie_stop_after_rzx_draw( int left_edge, int width, struct widget_option_entry *menu, settings_info *show );
 
@@ -500,19 +508,20 @@ static widget_option_entry options_general[] = {
   { "General Options" },
   { "\012E\001mulation speed", 0, INPUT_KEY_e, "%", NULL, widget_emulation_speed_click, widget_option_emulation_speed_draw },
   { "F\012r\001ame rate (1:n)", 1, INPUT_KEY_r, "frames", NULL, widget_frame_rate_click, widget_option_frame_rate_draw },
-  { "Issue \0122\001 keyboard", 2, INPUT_KEY_2, NULL, NULL, widget_issue2_click, widget_option_issue2_draw },
-  { "Recrea\012t\001ed ZX Spectrum", 3, INPUT_KEY_t, NULL, NULL, widget_recreated_spectrum_click, widget_option_recreated_spectrum_draw },
-  { "Use shift with \012a\001rrow keys", 4, INPUT_KEY_a, NULL, NULL, widget_keyboard_arrows_shifted_click, widget_option_keyboard_arrows_shifted_draw },
-  { "Allow \012w\001rites to ROM", 5, INPUT_KEY_w, NULL, NULL, widget_writable_roms_click, widget_option_writable_roms_draw },
-  { "Late t\012i\001mings", 6, INPUT_KEY_i, NULL, NULL, widget_late_timings_click, widget_option_late_timings_draw },
-  { "\012Z\00180 is CMOS", 7, INPUT_KEY_z, NULL, NULL, widget_z80_is_cmos_click, widget_option_z80_is_cmos_draw },
-  { "RS-232 \012h\001andshake", 8, INPUT_KEY_h, NULL, NULL, widget_rs232_handshake_click, widget_option_rs232_handshake_draw },
-  { "Black and white T\012V\001", 9, INPUT_KEY_v, NULL, NULL, widget_bw_tv_click, widget_option_bw_tv_draw },
-  { "\012P\001AL-TV use TV2x effect", 10, INPUT_KEY_p, NULL, NULL, widget_pal_tv2x_click, widget_option_pal_tv2x_draw },
-  { "Show status\012b\001ar", 11, INPUT_KEY_b, NULL, NULL, widget_statusbar_click, widget_option_statusbar_draw },
-  { "Snap \012j\001oystick prompt", 12, INPUT_KEY_j, NULL, NULL, widget_joy_prompt_click, widget_option_joy_prompt_draw },
-  { "\012C\001onfirm actions", 13, INPUT_KEY_c, NULL, NULL, widget_confirm_actions_click, widget_option_confirm_actions_draw },
-  { "A\012u\001to-save settings", 14, INPUT_KEY_u, NULL, NULL, widget_autosave_settings_click, widget_option_autosave_settings_draw },
+  { "Run ahea\012d\001", 2, INPUT_KEY_d, "frames", NULL, widget_run_ahead_click, widget_option_run_ahead_draw },
+  { "Issue \0122\001 keyboard", 3, INPUT_KEY_2, NULL, NULL, widget_issue2_click, widget_option_issue2_draw },
+  { "Recrea\012t\001ed ZX Spectrum", 4, INPUT_KEY_t, NULL, NULL, widget_recreated_spectrum_click, widget_option_recreated_spectrum_draw },
+  { "Use shift with \012a\001rrow keys", 5, INPUT_KEY_a, NULL, NULL, widget_keyboard_arrows_shifted_click, widget_option_keyboard_arrows_shifted_draw },
+  { "Allow \012w\001rites to ROM", 6, INPUT_KEY_w, NULL, NULL, widget_writable_roms_click, widget_option_writable_roms_draw },
+  { "Late t\012i\001mings", 7, INPUT_KEY_i, NULL, NULL, widget_late_timings_click, widget_option_late_timings_draw },
+  { "\012Z\00180 is CMOS", 8, INPUT_KEY_z, NULL, NULL, widget_z80_is_cmos_click, widget_option_z80_is_cmos_draw },
+  { "RS-232 \012h\001andshake", 9, INPUT_KEY_h, NULL, NULL, widget_rs232_handshake_click, widget_option_rs232_handshake_draw },
+  { "Black and white T\012V\001", 10, INPUT_KEY_v, NULL, NULL, widget_bw_tv_click, widget_option_bw_tv_draw },
+  { "\012P\001AL-TV use TV2x effect", 11, INPUT_KEY_p, NULL, NULL, widget_pal_tv2x_click, widget_option_pal_tv2x_draw },
+  { "Show status\012b\001ar", 12, INPUT_KEY_b, NULL, NULL, widget_statusbar_click, widget_option_statusbar_draw },
+  { "Snap \012j\001oystick prompt", 13, INPUT_KEY_j, NULL, NULL, widget_joy_prompt_click, widget_option_joy_prompt_draw },
+  { "\012C\001onfirm actions", 14, INPUT_KEY_c, NULL, NULL, widget_confirm_actions_click, widget_option_confirm_actions_draw },
+  { "A\012u\001to-save settings", 15, INPUT_KEY_u, NULL, NULL, widget_autosave_settings_click, widget_option_autosave_settings_draw },
   { NULL }
 };
 
@@ -581,6 +590,8 @@ static widget_option_entry options_rzx[] = {
   { "C\012o\001mpetition mode", 2, INPUT_KEY_o, NULL, NULL, widget_competition_mode_click, widget_option_competition_mode_draw },
   { "Co\012m\001petition code", 3, INPUT_KEY_m, "", NULL, widget_competition_code_click, widget_option_competition_code_draw },
   { "Always \012e\001mbed snapshot", 4, INPUT_KEY_e, NULL, NULL, widget_embed_snapshot_click, widget_option_embed_snapshot_draw },
+  { "S\012t\001ream recording to disk", 5, INPUT_KEY_t, NULL, NULL, widget_rzx_stream_click, widget_option_rzx_stream_draw },
+  { "Stream \012f\001lush interval", 6, INPUT_KEY_f, "frames", NULL, widget_rzx_stream_frames_click, widget_option_rzx_stream_frames_draw },
   { NULL }
 };
 
@@ -623,7 +634,8 @@ static widget_option_entry options_diskoptions[] = {
 static widget_option_entry options_movie[] = {
   { "Movie Options" },
   { "Movie \012c\001ompression", 0, INPUT_KEY_c, NULL, widget_movie_compr_combo, widget_movie_compr_click, widget_option_movie_compr_draw },
-  { "\012S\001top recording after RZX ends", 1, INPUT_KEY_S, NULL, NULL, widget_movie_stop_after_rzx_click, widget_option_movie_stop_after_rzx_draw },
+  { "\012F\001ast compression", 1, INPUT_KEY_f, NULL, NULL, widget_movie_compr_fast_click, widget_option_movie_compr_fast_draw },
+  { "\012S\001top recording after RZX ends", 2, INPUT_KEY_S, NULL, NULL, widget_movie_stop_after_rzx_click, widget_option_movie_stop_after_rzx_draw },
   { NULL }
 };
 
@@ -910,6 +922,30 @@ widget_option_frame_rate_draw( int left_edge, int width, struct widget_option_en
                               menu->suffix );
 }
 
+static void
+widget_run_ahead_click( void )
+{
+  widget_text_t text_data;
+
+  text_data.title = "Run ahead";
+  text_data.allow = WIDGET_INPUT_DIGIT;
+  text_data.max_length = 1;
+  snprintf( text_data.text, 40, "%d",
+            widget_options_settings.run_ahead );
+  widget_do_text( &text_data );
+
+  if( widget_text_text ) {
+    widget_options_settings.run_ahead = atoi( widget_text_text );
+  }
+}
+
+static void
+widget_option_run_ahead_draw( int left_edge, int width, struct widget_option_entry *menu, settings_info *show )
+{
+  widget_options_print_entry( left_edge, width, menu->index, menu->text, show->run_ahead,
+                              menu->suffix );
+}
+
 static void
 widget_issue2_click( void )
 {
@@ -1079,7 +1115,7 @@ widget_general_keyhandler( input_key key )
 
 #if 0
   case INPUT_KEY_Resize:	/* Fake keypress used on window resize */
-    widget_dialog_with_border( 1, 2, 30, 2 + 15 );
+    widget_dialog_with_border( 1, 2, 30, 2 + 16 );
     widget_general_show_all( &widget_options_settings );
     break;
 #endif
@@ -1102,7 +1138,7 @@ widget_general_keyhandler( input_key key )
   case INPUT_KEY_Down:
   case INPUT_KEY_6:
   case INPUT_JOYSTICK_DOWN:
-    if ( highlight_line + 1 < 15 ) {
+    if ( highlight_line + 1 < 16 ) {
       new_highlight_line = highlight_line + 1;
       cursor_pressed = 1;
     }
@@ -1116,8 +1152,8 @@ widget_general_keyhandler( input_key key )
     break;
 
   case INPUT_KEY_End:
-    if ( highlight_line + 2 < 15 ) {
-      new_highlight_line = 15 - 1;
+    if ( highlight_line + 2 < 16 ) {
+      new_highlight_line = 16 - 1;
       cursor_pressed = 1;
     }
     break;
@@ -2125,6 +2161,42 @@ widget_option_embed_snapshot_draw( int left_edge, int width, struct widget_optio
   widget_options_print_option( left_edge, width, menu->index, menu->text, show->embed_snapshot );
 }
 
+static void
+widget_rzx_stream_click( void )
+{
+  widget_options_settings.rzx_stream = ! widget_options_settings.rzx_stream;
+}
+
+static void
+widget_option_rzx_stream_draw( int left_edge, int width, struct widget_option_entry *menu, settings_info *show )
+{
+  widget_options_print_option( left_edge, width, menu->index, menu->text, show->rzx_stream );
+}
+
+static void
+widget_rzx_stream_frames_click( void )
+{
+  widget_text_t text_data;
+
+  text_data.title = "Stream flush interval";
+  text_data.allow = WIDGET_INPUT_DIGIT;
+  text_data.max_length = 4;
+  snprintf( text_data.text, 40, "%d",
+            widget_options_settings.rzx_stream_frames );
+  widget_do_text( &text_data );
+
+  if( widget_text_text ) {
+    widget_options_settings.rzx_stream_frames = atoi( widget_text_text );
+  }
+}
+
+static void
+widget_option_rzx_stream_frames_draw( int left_edge, int width, struct widget_option_entry *menu, settings_info *show )
+{
+  widget_options_print_entry( left_edge, width, menu->index, menu->text, show->rzx_stream_frames,
+                              menu->suffix );
+}
+
 void
 widget_rzx_keyhandler( input_key key )
 {
@@ -2138,7 +2210,7 @@ widget_rzx_keyhandler( input_key key )
 
 #if 0
   case INPUT_KEY_Resize:	/* Fake keypress used on window resize */
-    widget_dialog_with_border( 1, 2, 30, 2 + 5 );
+    widget_dialog_with_border( 1, 2, 30, 2 + 7 );
     widget_rzx_show_all( &widget_options_settings );
     break;
 #endif
@@ -2161,7 +2233,7 @@ widget_rzx_keyhandler( input_key key )
   case INPUT_KEY_Down:
   case INPUT_KEY_6:
   case INPUT_JOYSTICK_DOWN:
-    if ( highlight_line + 1 < 5 ) {
+    if ( highlight_line + 1 < 7 ) {
       new_highlight_line = highlight_line + 1;
       cursor_pressed = 1;
     }
@@ -2175,8 +2247,8 @@ widget_rzx_keyhandler( input_key key )
     break;
 
   case INPUT_KEY_End:
-    if ( highlight_line + 2 < 5 ) {
-      new_highlight_line = 5 - 1;
+    if ( highlight_line + 2 < 7 ) {
+      new_highlight_line = 7 - 1;
       cursor_pressed = 1;
     }
     break;
@@ -2893,6 +2965,18 @@ widget_option_movie_compr_draw( int left_edge, int width, struct widget_option_e
 			      show->movie_compr, 1 );
 }
 
+static void
+widget_movie_compr_fast_click( void )
+{
+  widget_options_settings.movie_compr_fast = ! widget_options_settings.movie_compr_fast;
+}
+
+static void
+widget_option_movie_compr_fast_draw( int left_edge, int width, struct widget_option_entry *menu, settings_info *show )
+{
+  widget_options_print_option( left_edge, width, menu->index, menu->text, show->movie_compr_fast );
+}
+
 static void
 widget_movie_stop_after_rzx_click( void )
 {
@@ -2918,7 +3002,7 @@ widget_movie_keyhandler( input_key key )
 
 #if 0
   case INPUT_KEY_Resize:	/* Fake keypress used on window resize */
-    widget_dialog_with_border( 1, 2, 30, 2 + 2 );
+    widget_dialog_with_border( 1, 2, 30, 2 + 3 );
     widget_movie_show_all( &widget_options_settings );
     break;
 #endif
@@ -2941,7 +3025,7 @@ widget_movie_keyhandler( input_key key )
   case INPUT_KEY_Down:
   case INPUT_KEY_6:
   case INPUT_JOYSTICK_DOWN:
-    if ( highlight_line + 1 < 2 ) {
+    if ( highlight_line + 1 < 3 ) {
       new_highlight_line = highlight_line + 1;
       cursor_pressed = 1;
     }
@@ -2955,8 +3039,8 @@ widget_movie_keyhandler( input_key key )
     break;
 
   case INPUT_KEY_End:
-    if ( highlight_line + 2 < 2 ) {
-      new_highlight_line = 2 - 1;
+    if ( highlight_line + 2 < 3 ) {
+      new_highlight_line = 3 - 1;
       cursor_pressed = 1;
     }
     break;
@@ -0,0 +1,160 @@
+/* perfstats.c: Performance statistics widget
+   Copyright (c) 2026 Fuse contributors
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+   Author contact information:
+
+   E-mail: philip-fuse@shadowmagic.org.uk
+
+*/
+
+#include <config.h>
+
+#include <stdio.h>
+
+#include "perfstats.h"
+#include "settings.h"
+#include "widget.h"
+#include "widget_internals.h"
+
+/* Where the columns of numbers end */
+#define AVERAGE_RIGHT 168
+#define MAXIMUM_RIGHT 232
+
+/* The counters are shown two to a row */
+#define COUNTER_RIGHT 120
+#define COUNTER2_LEFT 128
+#define COUNTER_ROWS ( ( PERFSTATS_COUNTER_COUNT + 1 ) / 2 )
+
+static void
+print_row( int line, const char *label, const char *average,
+           const char *maximum )
+{
+  int y = line * 8 + 24;
+
+  widget_printstring( 16, y, WIDGET_COLOUR_FOREGROUND, label );
+  widget_printstring_right( AVERAGE_RIGHT, y, WIDGET_COLOUR_FOREGROUND,
+                            average );
+  widget_printstring_right( MAXIMUM_RIGHT, y, WIDGET_COLOUR_FOREGROUND,
+                            maximum );
+}
+
+int
+widget_perfstats_draw( void *data GCC_UNUSED )
+{
+  double total[ PERFSTATS_STAGE_COUNT ], longest[ PERFSTATS_STAGE_COUNT ];
+  double count[ PERFSTATS_COUNTER_COUNT ];
+  const perfstats_frame_t *frame;
+  char average[ 16 ], maximum[ 16 ], buffer[ 40 ];
+  size_t frames, i, j;
+  int line;
+
+  frames = perfstats_frame_count();
+
+  for( j = 0; j < PERFSTATS_STAGE_COUNT; j++ ) total[ j ] = longest[ j ] = 0;
+  for( j = 0; j < PERFSTATS_COUNTER_COUNT; j++ ) count[ j ] = 0;
+
+  for( i = 0; i < frames; i++ ) {
+    frame = perfstats_get_frame( i );
+    for( j = 0; j < PERFSTATS_STAGE_COUNT; j++ ) {
+      total[ j ] += frame->time[ j ];
+      if( frame->time[ j ] > longest[ j ] ) longest[ j ] = frame->time[ j ];
+    }
+    for( j = 0; j < PERFSTATS_COUNTER_COUNT; j++ )
+      count[ j ] += frame->count[ j ];
+  }
+
+  line = 0;
+
+  if( !frames ) {
+    widget_dialog_with_border( 1, 2, 30, 4 );
+    widget_printstring( 10, 16, WIDGET_COLOUR_TITLE, "Performance" );
+    widget_printstring( 16, ++line * 8 + 24, WIDGET_COLOUR_FOREGROUND,
+                        perfstats_active ? "No frames recorded yet" :
+                                           "Statistics are not running" );
+    widget_display_lines( 2, line + 3 );
+    return 0;
+  }
+
+  widget_dialog_with_border( 1, 2, 30,
+                             PERFSTATS_STAGE_COUNT + COUNTER_ROWS + 6 +
+                             ( settings_current.run_ahead > 0 ) );
+  widget_printstring( 10, 16, WIDGET_COLOUR_TITLE, "Performance" );
+
+  snprintf( buffer, sizeof( buffer ), "Last %lu frames%s",
+            (unsigned long)frames, perfstats_active ? "" : " (stopped)" );
+  widget_printstring( 16, ++line * 8 + 24, WIDGET_COLOUR_FOREGROUND, buffer );
+
+  print_row( ++line, "ms", "average", "max" );
+
+  for( j = 0; j < PERFSTATS_STAGE_COUNT; j++ ) {
+    snprintf( average, sizeof( average ), "%.2f", total[ j ] * 1000 / frames );
+    snprintf( maximum, sizeof( maximum ), "%.2f", longest[ j ] * 1000 );
+    print_row( ++line, perfstats_stage_names[ j ], average, maximum );
+  }
+
+  /* What each frame run ahead costs */
+  if( settings_current.run_ahead > 0 ) {
+    j = PERFSTATS_STAGE_RUNAHEAD;
+    snprintf( average, sizeof( average ), "%.2f",
+              total[ j ] * 1000 / frames / settings_current.run_ahead );
+    snprintf( maximum, sizeof( maximum ), "%.2f",
+              longest[ j ] * 1000 / settings_current.run_ahead );
+    print_row( ++line, " each ahead", average, maximum );
+  }
+
+  print_row( ++line, "per frame", "average", "" );
+
+  for( j = 0; j < PERFSTATS_COUNTER_COUNT; j++ ) {
+    int x = j % 2 ? COUNTER2_LEFT : 16,
+      right = j % 2 ? MAXIMUM_RIGHT : COUNTER_RIGHT;
+    int y;
+
+    if( j % 2 == 0 ) line++;
+    y = line * 8 + 24;
+
+    snprintf( average, sizeof( average ), "%.0f", count[ j ] / frames );
+    widget_printstring( x, y, WIDGET_COLOUR_FOREGROUND,
+                        perfstats_counter_names[ j ] );
+    widget_printstring_right( right, y, WIDGET_COLOUR_FOREGROUND, average );
+  }
+
+  widget_display_lines( 2, line + 3 );
+
+  return 0;
+}
+
+void
+widget_perfstats_keyhandler( input_key key )
+{
+  switch( key ) {
+
+  case INPUT_KEY_Escape:
+  case INPUT_JOYSTICK_FIRE_2:
+    widget_end_widget( WIDGET_FINISHED_CANCEL );
+    return;
+
+  case INPUT_KEY_Return:
+  case INPUT_KEY_KP_Enter:
+  case INPUT_JOYSTICK_FIRE_1:
+    widget_end_widget( WIDGET_FINISHED_OK );
+    return;
+
+  default:	/* Keep gcc happy */
+    break;
+
+  }
+}
@@ -79,7 +79,7 @@ update_possible( void )
   if( !FEW_ENOUGH() )
     return;
 
-  for( page = 0; page < MEMORY_PAGES_IN_16K * SPECTRUM_RAM_PAGES; page++ ) {
+  for( page = 0; page < pokefinder_pages; page++ ) {
     memory_page *mapping = &memory_map_ram[page];
     bank = mapping->page_num;
 
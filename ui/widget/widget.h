@@ -60,6 +60,7 @@ typedef enum widget_type {
   WIDGET_TYPE_QUERY,		/* Query (yes/no) */
   WIDGET_TYPE_QUERY_SAVE,	/* Query (save/don't save/cancel) */
   WIDGET_TYPE_DISKOPTIONS,	/* Disk options widget */
+  WIDGET_TYPE_PERFSTATS,	/* Performance statistics */
 } widget_type;
 
 /* Activate a widget */
@@ -267,4 +268,10 @@ static inline int widget_do_diskoptions( void )
   return widget_do( WIDGET_TYPE_DISKOPTIONS, NULL );
 }
 
+/* Performance statistics widget */
+static inline int widget_do_perfstats( void )
+{
+  return widget_do( WIDGET_TYPE_PERFSTATS, NULL );
+}
+
 #endif				/* #ifndef FUSE_WIDGET_H */
@@ -231,6 +231,11 @@ void widget_pokefinder_keyhandler( input_key key );
 int widget_memory_draw( void *data );
 void widget_memory_keyhandler( input_key key );
 
+/* The performance statistics widget */
+
+int widget_perfstats_draw( void *data );
+void widget_perfstats_keyhandler( input_key key );
+
 /* The about fuse widget */
 
 int widget_about_draw( void *data );
@@ -50,6 +50,10 @@ int handle_menu( DWORD cmd, HWND window )
       menu_file_recording_rollback( 0 ); return 0;
     case IDM_MENU_FILE_RECORDING_PLAY:
       menu_file_recording_play( 0 ); return 0;
+    case IDM_MENU_FILE_RECORDING_SEEKFORWARD:
+      menu_file_recording_seekforward( 0 ); return 0;
+    case IDM_MENU_FILE_RECORDING_SEEKBACKWARD:
+      menu_file_recording_seekbackward( 0 ); return 0;
     case IDM_MENU_FILE_RECORDING_STOP:
       menu_file_recording_stop( 0 ); return 0;
     case IDM_MENU_FILE_RECORDING_FINALISE:
@@ -170,6 +174,14 @@ int handle_menu( DWORD cmd, HWND window )
       menu_machine_profiler_start( 0 ); return 0;
     case IDM_MENU_MACHINE_PROFILER_STOP:
       menu_machine_profiler_stop( 0 ); return 0;
+    case IDM_MENU_MACHINE_PERFORMANCE_START:
+      menu_machine_performance_start( 0 ); return 0;
+    case IDM_MENU_MACHINE_PERFORMANCE_STOP:
+      menu_machine_performance_stop( 0 ); return 0;
+    case IDM_MENU_MACHINE_PERFORMANCE_SHOW:
+      menu_machine_performance_show( 0 ); return 0;
+    case IDM_MENU_MACHINE_PERFORMANCE_SAVE:
+      menu_machine_performance_save( 0 ); return 0;
     case IDM_MENU_MACHINE_NMI:
       menu_machine_nmi( 0 ); return 0;
     case IDM_MENU_MACHINE_MULTIFACEREDBUTTON:
@@ -76,6 +76,13 @@ menu_options_general_init( HWND hwndDlg )
   SendDlgItemMessage( hwndDlg, IDC_OPT_GENERAL_FRAME_RATE, WM_SETTEXT,
                       0, (LPARAM) buffer );
 
+  SendDlgItemMessage( hwndDlg, IDC_OPT_GENERAL_RUN_AHEAD, EM_LIMITTEXT,
+                      1, 0 );
+  /* FIXME This is asuming SendDlgItemMessage is not UNICODE */
+  snprintf( buffer, 80, "%d", settings_current.run_ahead );
+  SendDlgItemMessage( hwndDlg, IDC_OPT_GENERAL_RUN_AHEAD, WM_SETTEXT,
+                      0, (LPARAM) buffer );
+
   SendDlgItemMessage( hwndDlg, IDC_OPT_GENERAL_ISSUE2, BM_SETCHECK,
     settings_current.issue2 ? BST_CHECKED : BST_UNCHECKED, 0 );
 
@@ -135,6 +142,11 @@ menu_options_general_done( HWND hwndDlg )
                       80, (LPARAM) buffer );
   settings_current.frame_rate = atoi( buffer );
 
+  /* FIXME This is asuming SendDlgItemMessage is not UNICODE */
+  SendDlgItemMessage( hwndDlg, IDC_OPT_GENERAL_RUN_AHEAD, WM_GETTEXT,
+                      80, (LPARAM) buffer );
+  settings_current.run_ahead = atoi( buffer );
+
   settings_current.issue2 =
     IsDlgButtonChecked( hwndDlg, IDC_OPT_GENERAL_ISSUE2 );
 
@@ -840,6 +852,16 @@ menu_options_rzx_init( HWND hwndDlg )
   SendDlgItemMessage( hwndDlg, IDC_OPT_RZX_EMBED_SNAPSHOT, BM_SETCHECK,
     settings_current.embed_snapshot ? BST_CHECKED : BST_UNCHECKED, 0 );
 
+  SendDlgItemMessage( hwndDlg, IDC_OPT_RZX_RZX_STREAM, BM_SETCHECK,
+    settings_current.rzx_stream ? BST_CHECKED : BST_UNCHECKED, 0 );
+
+  SendDlgItemMessage( hwndDlg, IDC_OPT_RZX_RZX_STREAM_FRAMES, EM_LIMITTEXT,
+                      4, 0 );
+  /* FIXME This is asuming SendDlgItemMessage is not UNICODE */
+  snprintf( buffer, 80, "%d", settings_current.rzx_stream_frames );
+  SendDlgItemMessage( hwndDlg, IDC_OPT_RZX_RZX_STREAM_FRAMES, WM_SETTEXT,
+                      0, (LPARAM) buffer );
+
 }
 
 static void
@@ -867,6 +889,14 @@ menu_options_rzx_done( HWND hwndDlg )
   settings_current.embed_snapshot =
     IsDlgButtonChecked( hwndDlg, IDC_OPT_RZX_EMBED_SNAPSHOT );
 
+  settings_current.rzx_stream =
+    IsDlgButtonChecked( hwndDlg, IDC_OPT_RZX_RZX_STREAM );
+
+  /* FIXME This is asuming SendDlgItemMessage is not UNICODE */
+  SendDlgItemMessage( hwndDlg, IDC_OPT_RZX_RZX_STREAM_FRAMES, WM_GETTEXT,
+                      80, (LPARAM) buffer );
+  settings_current.rzx_stream_frames = atoi( buffer );
+
   win32statusbar_set_visibility( settings_current.statusbar );
   display_refresh_all();
 
@@ -1776,6 +1806,9 @@ menu_options_movie_init( HWND hwndDlg )
       }
     }
   }
+  SendDlgItemMessage( hwndDlg, IDC_OPT_MOVIE_MOVIE_COMPR_FAST, BM_SETCHECK,
+    settings_current.movie_compr_fast ? BST_CHECKED : BST_UNCHECKED, 0 );
+
   SendDlgItemMessage( hwndDlg, IDC_OPT_MOVIE_MOVIE_STOP_AFTER_RZX, BM_SETCHECK,
     settings_current.movie_stop_after_rzx ? BST_CHECKED : BST_UNCHECKED, 0 );
 
@@ -1794,6 +1827,9 @@ menu_options_movie_done( HWND hwndDlg )
     utils_safe_strdup( movie_movie_compr_combo[
     SendDlgItemMessage( hwndDlg, IDC_OPT_MOVIE_MOVIE_COMPR, CB_GETCURSEL, 0, 0 ) ] );
 
+  settings_current.movie_compr_fast =
+    IsDlgButtonChecked( hwndDlg, IDC_OPT_MOVIE_MOVIE_COMPR_FAST );
+
   settings_current.movie_stop_after_rzx =
     IsDlgButtonChecked( hwndDlg, IDC_OPT_MOVIE_MOVIE_STOP_AFTER_RZX );
 
@@ -24,12 +24,19 @@
 
 #include <config.h>
 
+#include <string.h>
+
 #include <libspectrum.h>
 
 #include "debugger/debugger.h"
+#include "event.h"
 #include "fuse.h"
 #include "machine.h"
+#include "memory_pages.h"
 #include "mempool.h"
+#include "module.h"
+#include "netplay.h"
+#include "perfstats.h"
 #include "periph.h"
 #include "peripherals/disk/beta.h"
 #include "peripherals/disk/didaktik.h"
@@ -46,8 +53,13 @@
 #include "peripherals/speccyboot.h"
 #include "peripherals/ula.h"
 #include "peripherals/usource.h"
+#include "runahead.h"
 #include "settings.h"
+#include "sound/blipbuffer.h"
+#include "statelog.h"
 #include "unittests.h"
+#include "z80/z80.h"
+#include "z80/z80_cache.h"
 
 static int
 contention_test( void )
@@ -225,8 +237,6 @@ floating_bus_test( void )
   return error;
 }
 
-#define TEST_ASSERT(x) do { if( !(x) ) { printf("Test assertion failed at %s:%d: %s\n", __FILE__, __LINE__, #x ); return 1; } } while( 0 )
-
 static int
 floating_bus_merge_test( void )
 {
@@ -319,6 +329,23 @@ assert_page( libspectrum_word base, libspectrum_word length, int source, int pag
     TEST_ASSERT( memory_map_read[ base_index + i ].page_num == page );
     TEST_ASSERT( memory_map_write[ base_index + i ].source == source );
     TEST_ASSERT( memory_map_write[ base_index + i ].page_num == page );
+    TEST_ASSERT( memory_map_read_page[ base_index + i ] ==
+                 memory_map_read[ base_index + i ].page );
+    TEST_ASSERT( memory_read_contended( base + i * MEMORY_PAGE_SIZE ) ==
+                 !!memory_map_read[ base_index + i ].contended );
+    TEST_ASSERT( memory_write_contended( base + i * MEMORY_PAGE_SIZE ) ==
+                 !!memory_map_write[ base_index + i ].contended );
+
+    /* Only ordinary RAM may be written to directly, never the screen */
+    if( memory_map_write_page[ base_index + i ] ) {
+      memory_page *mapping = &memory_map_write[ base_index + i ];
+
+      TEST_ASSERT( memory_map_write_page[ base_index + i ] == mapping->page );
+      TEST_ASSERT( mapping->writable );
+      TEST_ASSERT( !( source == memory_source_ram &&
+                      page == memory_current_screen &&
+                      ( mapping->offset & memory_screen_mask ) < 0x1b00 ) );
+    }
   }
 
   return 0;
@@ -700,6 +727,466 @@ paging_test_se( void )
   return r;
 }
 
+static int
+watchpoint_test( void )
+{
+  int r = 0;
+
+  TEST_ASSERT( !memory_map_read_watched && !memory_map_write_watched );
+  TEST_ASSERT( !debugger_port_read_watched( 0x00fe ) );
+
+  /* An absolute address watches only its own page... */
+  debugger_breakpoint_add_address( DEBUGGER_BREAKPOINT_TYPE_WRITE,
+                                   memory_source_any, 0, 0x5c3a, 0,
+                                   DEBUGGER_BREAKPOINT_LIFE_PERMANENT, NULL );
+  TEST_ASSERT( memory_write_watched( 0x5c3a ) );
+  TEST_ASSERT( memory_write_watched( 0x5800 ) );
+  TEST_ASSERT( !memory_write_watched( 0x6000 ) );
+  TEST_ASSERT( !memory_read_watched( 0x5c3a ) );
+  TEST_ASSERT( !memory_execute_watched( 0x5c3a ) );
+  TEST_ASSERT( debugger_memory_watched );
+
+  /* ...and a page-specific one wherever that page is mapped */
+  debugger_breakpoint_add_address( DEBUGGER_BREAKPOINT_TYPE_READ,
+                                   memory_source_ram, 5, 0x1000, 0,
+                                   DEBUGGER_BREAKPOINT_LIFE_PERMANENT, NULL );
+  TEST_ASSERT( memory_read_watched( 0x5000 ) );
+  TEST_ASSERT( !memory_read_watched( 0x4000 ) );
+  TEST_ASSERT( !memory_read_watched( 0x1000 ) );
+
+  debugger_breakpoint_add_port( DEBUGGER_BREAKPOINT_TYPE_PORT_READ, 0x00fe,
+                                0x00ff, 0, DEBUGGER_BREAKPOINT_LIFE_PERMANENT,
+                                NULL );
+  TEST_ASSERT( debugger_port_read_watched( 0x7ffe ) );
+  TEST_ASSERT( !debugger_port_read_watched( 0x7ffd ) );
+  TEST_ASSERT( !debugger_port_write_watched( 0x7ffe ) );
+
+  debugger_command_evaluate( "delete" );
+
+  TEST_ASSERT( !memory_map_read_watched && !memory_map_write_watched );
+  TEST_ASSERT( !debugger_port_read_watched( 0x00fe ) );
+  TEST_ASSERT( !debugger_memory_watched );
+
+  return r;
+}
+
+static int
+perfstats_test( void )
+{
+  int r = 0;
+  size_t i;
+
+  perfstats_start();
+
+  /* Fill the ring buffer and then go round it a bit more */
+  for( i = 0; i < PERFSTATS_FRAMES + 3; i++ ) {
+    perfstats_count( PERFSTATS_COUNTER_PORT_READS, i );
+    perfstats_frame();
+  }
+
+  TEST_ASSERT( perfstats_frame_count() == PERFSTATS_FRAMES );
+  TEST_ASSERT( perfstats_get_frame( 0 )->frame == 3 );
+  TEST_ASSERT( perfstats_get_frame( 0 )->count[ PERFSTATS_COUNTER_PORT_READS ]
+               == 3 );
+  TEST_ASSERT( perfstats_get_frame( PERFSTATS_FRAMES - 1 )->frame ==
+               PERFSTATS_FRAMES + 2 );
+  TEST_ASSERT( !perfstats_get_frame( PERFSTATS_FRAMES ) );
+
+  perfstats_stop();
+
+  /* Nothing is counted once stopped */
+  perfstats_count( PERFSTATS_COUNTER_PORT_READS, 1 );
+  TEST_ASSERT( !perfstats_counts[ PERFSTATS_COUNTER_PORT_READS ] );
+
+  return r;
+}
+
+/* Check that the state hash is XXH32, so that logs written on one host can
+   be compared on another */
+static int
+statelog_test( void )
+{
+  int r = 0;
+  const libspectrum_byte *text =
+    (const libspectrum_byte*)"Nobody inspects the spammish repetition";
+
+  TEST_ASSERT( statelog_hash( 0, text, 0 ) == 0x02cc5d05 );
+  TEST_ASSERT( statelog_hash( 0, text, 3 ) == 0x08e99f85 );
+  TEST_ASSERT( statelog_hash( 0, text, 39 ) == 0xe2293b2f );
+
+  return r;
+}
+
+#define BLIP_TEST_FRAMES 50
+#define BLIP_TEST_CHANGES 400
+#define BLIP_TEST_FRAME_LENGTH 70908
+#define BLIP_TEST_MAX_SAMPLES ( 192000 / 40 )
+
+static Blip_Buffer*
+blip_test_buffer( long rate, long clock )
+{
+  Blip_Buffer *buffer = new_Blip_Buffer();
+
+  blip_buffer_set_clock_rate( buffer, clock );
+  blip_buffer_set_sample_rate( buffer, rate, 1000 );
+  blip_buffer_set_bass_freq( buffer, 200 );
+
+  return buffer;
+}
+
+static Blip_Synth*
+blip_test_synth( Blip_Buffer *buffer )
+{
+  Blip_Synth *synth = new_Blip_Synth();
+
+  blip_synth_set_volume( synth, 1.0 );
+  blip_synth_set_output( synth, buffer );
+  blip_synth_set_treble_eq( synth, -37.0 );
+
+  return synth;
+}
+
+/* Add the changes one at a time via the original, unbatched code */
+static void
+blip_test_reference( Blip_Synth *synth, const blip_change_t *changes,
+                     long count, int *last_amp )
+{
+  Blip_Buffer *buffer = synth->impl.buf;
+  long i;
+
+  for( i = 0; i < count; i++ ) {
+    blip_synth_offset_resampled( synth,
+                                 changes[i].time * buffer->factor_ +
+                                 buffer->offset_,
+                                 changes[i].amplitude - *last_amp, buffer );
+    *last_amp = changes[i].amplitude;
+  }
+}
+
+static int
+blip_buffer_rate_test( long rate, long clock )
+{
+  static blip_change_t changes[2][ BLIP_TEST_CHANGES ];
+  static blip_sample_t expected[ 2 * BLIP_TEST_MAX_SAMPLES ];
+  static blip_sample_t actual[ 2 * BLIP_TEST_MAX_SAMPLES ];
+  static const int levels[] = { 0, 0, 512, 12800, 13312, -32768, 65535 };
+  Blip_Buffer *buffers[4];
+  Blip_Synth *synths[4];
+  int last_amp[2] = { 0, 0 };
+  libspectrum_dword seed = 1;
+  long count, i, j;
+  int frame, r = 0;
+
+  for( i = 0; i < 4; i++ ) {
+    buffers[i] = blip_test_buffer( rate, clock );
+    synths[i] = blip_test_synth( buffers[i] );
+  }
+
+  for( frame = 0; frame < BLIP_TEST_FRAMES && !r; frame++ ) {
+
+    /* Changes at random times, including repeats of the same level and
+       levels big enough to need clamping */
+    for( i = 0; i < 2; i++ ) {
+      for( j = 0; j < BLIP_TEST_CHANGES; j++ ) {
+        seed = seed * 1103515245 + 12345;
+        changes[i][j].time = BLIP_TEST_FRAME_LENGTH / BLIP_TEST_CHANGES * j +
+                             ( seed >> 16 ) % 150;
+        changes[i][j].amplitude =
+          levels[ ( seed >> 8 ) % ARRAY_SIZE( levels ) ];
+      }
+    }
+
+    for( i = 0; i < 2; i++ ) {
+      blip_test_reference( synths[i], changes[i], BLIP_TEST_CHANGES,
+                           &last_amp[i] );
+      blip_synth_update_batch( synths[ i + 2 ], changes[i],
+                               BLIP_TEST_CHANGES );
+    }
+
+    for( i = 0; i < 4; i++ )
+      blip_buffer_end_frame( buffers[i], BLIP_TEST_FRAME_LENGTH );
+
+    count = blip_buffer_read_samples( buffers[0], expected,
+                                      BLIP_TEST_MAX_SAMPLES, 1 );
+    blip_buffer_read_samples( buffers[1], expected + 1, count, 1 );
+
+    r = blip_buffer_read_samples_stereo( buffers[2], buffers[3], actual,
+                                         BLIP_TEST_MAX_SAMPLES ) != count ||
+        memcmp( expected, actual, 2 * count * sizeof( blip_sample_t ) );
+  }
+
+  for( i = 0; i < 4; i++ ) {
+    delete_Blip_Synth( &synths[i] );
+    delete_Blip_Buffer( &buffers[i] );
+  }
+
+  if( r )
+    printf( "%s: blip_buffer output differs at %ld Hz from %ld Hz clock\n",
+            fuse_progname, rate, clock );
+
+  return r;
+}
+
+/* Check that the batched synth updates and the single pass stereo read
+   give exactly the same samples as the original code at the usual sample
+   rates */
+static int
+blip_buffer_test( void )
+{
+  static const long rates[] = {
+    8000, 11025, 16000, 22050, 32000, 44100, 48000, 96000, 192000,
+  };
+  static const long clocks[] = { 3500000, 3546900 };
+  size_t i, j;
+  int r = 0;
+
+  for( i = 0; i < ARRAY_SIZE( rates ); i++ )
+    for( j = 0; j < ARRAY_SIZE( clocks ); j++ )
+      r += blip_buffer_rate_test( rates[i], clocks[j] );
+
+  return r;
+}
+
+/* Check that only the current machine's RAM is allocated */
+static int
+ram_test( void )
+{
+  int r = 0;
+  size_t i, pages = memory_ram_pages();
+
+  TEST_ASSERT( pages >= machine_current->ram.valid_pages );
+  TEST_ASSERT( pages >= 8 );
+
+  for( i = 0; i < SPECTRUM_RAM_PAGES; i++ ) {
+    if( i < pages ) {
+      TEST_ASSERT( RAM[ i ] != NULL );
+      TEST_ASSERT( memory_map_ram[ i * MEMORY_PAGES_IN_16K + 1 ].page ==
+                   RAM[ i ] + MEMORY_PAGE_SIZE );
+    } else {
+      TEST_ASSERT( RAM[ i ] == NULL );
+      TEST_ASSERT( memory_map_ram[ i * MEMORY_PAGES_IN_16K ].page == NULL );
+    }
+  }
+
+  return r;
+}
+
+/* Check that the state used for running ahead comes back as it was */
+static int
+state_test( void )
+{
+  int r = 0;
+  libspectrum_byte ram_byte = RAM[ 0 ][ 0x1234 ];
+  libspectrum_word pc = z80.pc.w;
+  libspectrum_dword saved_tstates = tstates;
+  libspectrum_dword next_event = event_next_event;
+  memory_page mapping = memory_map_read[ 0 ];
+
+  module_state_save( 0 );
+
+  RAM[ 0 ][ 0x1234 ] ^= 0xff;
+  z80.pc.w ^= 0xffff;
+  tstates = 0;
+  event_add( 0, event_type_null );
+  memory_map_read[ 0 ] = memory_map_ram[ 0 ];
+
+  module_state_restore( 0 );
+
+  TEST_ASSERT( RAM[ 0 ][ 0x1234 ] == ram_byte );
+  TEST_ASSERT( z80.pc.w == pc );
+  TEST_ASSERT( tstates == saved_tstates );
+  TEST_ASSERT( event_next_event == next_event );
+  TEST_ASSERT( memory_map_read[ 0 ].page == mapping.page );
+  TEST_ASSERT( memory_map_read_page[ 0 ] == mapping.page );
+
+  return r;
+}
+
+/* Check that both players' input reaches the machine */
+static int
+netplay_test( void )
+{
+  int r = 0;
+  netplay_input_t a, b, merged;
+  size_t i;
+
+  for( i = 0; i < 8; i++ ) a.keyboard[i] = b.keyboard[i] = 0xff;
+  a.keyboard[3] = 0xfe; b.keyboard[3] = 0xef; b.keyboard[7] = 0xfd;
+  a.joystick.kempston = 0x10; b.joystick.kempston = 0x01;
+  a.joystick.timex1 = 0x80; b.joystick.timex1 = 0x00;
+  a.joystick.timex2 = 0x00; b.joystick.timex2 = 0x04;
+  a.joystick.fuller = 0x7f; b.joystick.fuller = 0xfe;
+
+  netplay_input_merge( &merged, &a, &b );
+
+  TEST_ASSERT( merged.keyboard[0] == 0xff );
+  TEST_ASSERT( merged.keyboard[3] == 0xee );
+  TEST_ASSERT( merged.keyboard[7] == 0xfd );
+  TEST_ASSERT( merged.joystick.kempston == 0x11 );
+  TEST_ASSERT( merged.joystick.timex1 == 0x80 );
+  TEST_ASSERT( merged.joystick.timex2 == 0x04 );
+  TEST_ASSERT( merged.joystick.fuller == 0x7e );
+
+  return r;
+}
+
+/* Code which runs a block of instructions, then overwrites an opcode and
+   the second byte of each prefixed instruction in it and runs it again */
+static const libspectrum_byte predecode_cache_test_code[] = {
+  0xf3,			/* 6000 DI */
+  0xcd, 0x20, 0x60,	/* 6001 CALL 0x6020 */
+  0x3e, 0x0c,		/* 6004 LD A,0x0c */
+  0x32, 0x20, 0x60,	/* 6006 LD (0x6020),A: INC B -> INC C */
+  0x3e, 0x01,		/* 6009 LD A,0x01 */
+  0x32, 0x22, 0x60,	/* 600b LD (0x6022),A: RLC B -> RLC C */
+  0x3e, 0x2b,		/* 600e LD A,0x2b */
+  0x32, 0x24, 0x60,	/* 6010 LD (0x6024),A: INC IX -> DEC IX */
+  0x32, 0x28, 0x60,	/* 6013 LD (0x6028),A: INC IY -> DEC IY */
+  0x3e, 0x57,		/* 6016 LD A,0x57 */
+  0x32, 0x26, 0x60,	/* 6018 LD (0x6026),A: NEG -> LD A,I */
+  0xcd, 0x20, 0x60,	/* 601b CALL 0x6020 */
+  0x76,			/* 601e HALT */
+  0x00,			/* 601f NOP */
+  0x04,			/* 6020 INC B */
+  0xcb, 0x00,		/* 6021 RLC B */
+  0xdd, 0x23,		/* 6023 INC IX */
+  0xed, 0x44,		/* 6025 NEG */
+  0xfd, 0x23,		/* 6027 INC IY */
+  0xc9,			/* 6029 RET */
+};
+
+/* Check that code which changes itself runs the new instructions when
+   the predecode cache is in use */
+static int
+predecode_cache_test( void )
+{
+  int r = 0;
+  int predecode_cache = settings_current.predecode_cache;
+  libspectrum_byte a, b, c, i;
+  libspectrum_word ix, iy;
+  int cache_used;
+  size_t j;
+
+  module_state_save( 0 );
+  settings_current.predecode_cache = 1;
+
+  for( j = 0; j < ARRAY_SIZE( predecode_cache_test_code ); j++ )
+    writebyte_internal( 0x6000 + j, predecode_cache_test_code[ j ] );
+
+  z80.pc.w = 0x6000;
+  z80.sp.w = 0x7ff0;
+  z80.af.b.h = 0x05;
+  z80.bc.w = 0x0110;
+  z80.ix.w = 0x1000;
+  z80.iy.w = 0x2000;
+  z80.i = 0x3f;
+  z80.iff1 = z80.iff2 = 0;
+  z80.halted = 0;
+
+  while( !z80.halted && !fuse_exiting ) {
+    z80_do_opcodes();
+    event_do_events();
+  }
+
+  a = z80.af.b.h; b = z80.bc.b.h; c = z80.bc.b.l; i = z80.i;
+  ix = z80.ix.w; iy = z80.iy.w;
+  cache_used = z80_cache_used;
+
+  settings_current.predecode_cache = predecode_cache;
+  module_state_restore( 0 );
+
+  /* The first pass changes B, IX and IY and negates A... */
+  TEST_ASSERT( b == 0x04 );
+  /* ...and the second changes C, IX and IY back and loads A from I */
+  TEST_ASSERT( c == 0x22 );
+  TEST_ASSERT( ix == 0x1000 );
+  TEST_ASSERT( iy == 0x2000 );
+  TEST_ASSERT( a == i );
+
+  /* Only the TR-DOS paging check, on machines with a built-in Beta disk
+     interface, keeps the cache out of use here */
+  TEST_ASSERT( cache_used || beta_available );
+
+  return r;
+}
+
+/* Frames run before and in total while checking for allocations */
+#define ALLOCATION_TEST_WARMUP 5
+#define ALLOCATION_TEST_FRAMES 15
+
+/* Check that once things have settled down, neither events nor whole
+   frames need any memory allocating */
+static int
+allocation_test( void )
+{
+  int r = 0;
+  libspectrum_dword allocations, frame_allocations;
+  const perfstats_frame_t *frame;
+  int run_ahead;
+  size_t i;
+  int pass;
+
+  module_state_save( 0 );
+
+  for( pass = 0; pass < 2; pass++ ) {
+    allocations = perfstats_allocation_count();
+    for( i = 0; i < 200; i++ ) event_add( tstates, event_type_null );
+    event_do_events();
+  }
+  TEST_ASSERT( perfstats_allocation_count() == allocations );
+
+  /* A loop which waits for each interrupt, so the same code runs every
+     frame */
+  writebyte_internal( 0x6000, 0xfb );	/* EI */
+  writebyte_internal( 0x6001, 0x76 );	/* HALT */
+  writebyte_internal( 0x6002, 0x18 );	/* JR 0x6000 */
+  writebyte_internal( 0x6003, 0xfc );
+  z80.pc.w = 0x6000;
+  z80.sp.w = 0x7ff0;
+  z80.iy.w = 0x5c3a;
+  z80.im = 1;
+  z80.iff1 = z80.iff2 = 0;
+  z80.halted = 0;
+
+  runahead_emulate( 5, 0 );
+  allocations = perfstats_allocation_count();
+  runahead_emulate( 10, 0 );
+  TEST_ASSERT( perfstats_allocation_count() == allocations );
+
+  /* Frames run ahead skip the display, sound and UI, so also run real
+     frames, exactly as the main loop does */
+  run_ahead = settings_current.run_ahead;
+  settings_current.run_ahead = 0;
+  perfstats_start();
+
+  while( perfstats_frame_count() < ALLOCATION_TEST_WARMUP && !fuse_exiting ) {
+    z80_do_opcodes();
+    event_do_events();
+  }
+  allocations = perfstats_allocation_count();
+  while( perfstats_frame_count() < ALLOCATION_TEST_FRAMES && !fuse_exiting ) {
+    z80_do_opcodes();
+    event_do_events();
+  }
+  allocations = perfstats_allocation_count() - allocations;
+
+  frame_allocations = 0;
+  for( i = ALLOCATION_TEST_WARMUP; i < perfstats_frame_count(); i++ ) {
+    frame = perfstats_get_frame( i );
+    frame_allocations += frame->count[ PERFSTATS_COUNTER_ALLOCATIONS ];
+  }
+
+  perfstats_stop();
+  settings_current.run_ahead = run_ahead;
+
+  module_state_restore( 0 );
+
+  TEST_ASSERT( allocations == 0 );
+  TEST_ASSERT( frame_allocations == 0 );
+
+  return r;
+}
+
 static int
 paging_test( void )
 {
@@ -785,6 +1272,16 @@ unittests_run( void )
   r += floating_bus_merge_test();
   r += mempool_test();
   r += paging_test();
+  r += watchpoint_test();
+  r += perfstats_test();
+  r += statelog_test();
+  r += blip_buffer_test();
+  r += ram_test();
+  r += state_test();
+  r += netplay_test();
+  r += netplay_unittest();
+  r += predecode_cache_test();
+  r += allocation_test();
   r += debugger_disassemble_unittest();
 
   printf("Final return value: %d (should be 0)\n", r);
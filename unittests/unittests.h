@@ -26,6 +26,8 @@
 
 int unittests_run( void );
 
+#define TEST_ASSERT(x) do { if( !(x) ) { printf("Test assertion failed at %s:%d: %s\n", __FILE__, __LINE__, #x ); return 1; } } while( 0 )
+
 int unittests_assert_2k_page( libspectrum_word base, int source, int page );
 int unittests_assert_4k_page( libspectrum_word base, int source, int page );
 int unittests_assert_8k_page( libspectrum_word base, int source, int page );
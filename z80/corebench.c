@@ -0,0 +1,526 @@
+/* corebench.c: Z80 core microbenchmarks
+   Copyright (c) 2026 Fuse contributors
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+   Author contact information:
+
+   E-mail: philip-fuse@shadowmagic.org.uk
+
+*/
+
+/* The core tester's dummy machine, with a flat 64K of memory, used to
+   time each of the cores Fuse runs: first over runs of instructions from
+   each opcode group, then over some more realistic code. The cores are
+   built from z80_ops.c exactly as for Fuse itself, rather than as for
+   the core tester, so the contended and uncontended cores are timed with
+   and without the predecode cache; only the hooked core's memory
+   accesses go through the core tester's functions. Each measurement is
+   the fastest of several runs over the same emulated time, and the
+   number of instructions is counted in a separate run so that counting
+   them doesn't affect the timing. Each result is a line of JSON in the
+   same form as from `fuse --benchmark', with the same names every time,
+   so that results can be compared between versions of the core and
+   between compilers or compiler flags */
+
+#define COREBENCH
+#include "coretest.c"
+
+#include <time.h>
+
+#include "z80_cache.h"
+
+/* How many frames are emulated for each measurement, and how many times
+   each measurement is made */
+#define COREBENCH_FRAMES 250
+#define COREBENCH_RUNS 5
+
+/* The length of a 48K Spectrum's frame and its clock speed */
+#define COREBENCH_FRAME_LENGTH 69888
+#define COREBENCH_CLOCK_SPEED 3500000
+
+/* How many frames a 48K Spectrum takes to get from reset to the copyright
+   message, with some to spare */
+#define COREBENCH_BOOT_FRAMES 150
+
+/* Where the code being timed is put, and the data it works on */
+#define COREBENCH_CODE 0x8000
+#define COREBENCH_DATA 0xc000
+
+/* How many instructions are in the loop for each opcode group */
+#define COREBENCH_GROUP_LENGTH 240
+
+/* Where a 48K Spectrum's screen is fetched and its memory contended */
+#define COREBENCH_CONTENTION_START 14335
+#define COREBENCH_CONTENTION_LINES 192
+#define COREBENCH_LINE_LENGTH 224
+#define COREBENCH_CONTENDED_PAGES 0x0000ff00
+
+typedef struct corebench_core {
+  const char *name;
+  z80_core_type core;
+  int predecode_cache;
+  int contended;		/* Run with a 48K Spectrum's contention */
+} corebench_core;
+
+static const corebench_core corebench_cores[] = {
+  { "hooked", Z80_CORE_HOOKED, 0, 0 },
+  { "contended", Z80_CORE_CONTENDED, 0, 1 },
+  { "contended+cache", Z80_CORE_CONTENDED, 1, 1 },
+  { "uncontended", Z80_CORE_UNCONTENDED, 0, 0 },
+  { "uncontended+cache", Z80_CORE_UNCONTENDED, 1, 0 },
+};
+
+/* The core being timed */
+static const corebench_core *corebench_core_current;
+
+typedef struct corebench_instruction {
+  size_t length;
+  libspectrum_byte bytes[4];
+} corebench_instruction;
+
+/* Instructions which don't change HL, IX or IY or jump, so that they
+   can simply be repeated; every memory access is to the data area */
+static const corebench_instruction base_instructions[] = {
+  { 1, { 0x78 } },			/* LD A,B */
+  { 1, { 0x80 } },			/* ADD A,B */
+  { 1, { 0x04 } },			/* INC B */
+  { 1, { 0x0d } },			/* DEC C */
+  { 1, { 0x7e } },			/* LD A,(HL) */
+  { 1, { 0x77 } },			/* LD (HL),A */
+  { 1, { 0xa9 } },			/* XOR C */
+  { 1, { 0x17 } },			/* RLA */
+  { 1, { 0x27 } },			/* DAA */
+  { 1, { 0x13 } },			/* INC DE */
+  { 2, { 0x3e, 0x55 } },		/* LD A,0x55 */
+  { 2, { 0xe6, 0x0f } },		/* AND 0x0f */
+  { 1, { 0x08 } },			/* EX AF,AF' */
+  { 3, { 0x3a, 0x10, 0xc0 } },		/* LD A,(0xc010) */
+  { 3, { 0x32, 0x11, 0xc0 } },		/* LD (0xc011),A */
+  { 1, { 0x34 } },			/* INC (HL) */
+};
+
+static const corebench_instruction cb_instructions[] = {
+  { 2, { 0xcb, 0x00 } },		/* RLC B */
+  { 2, { 0xcb, 0x39 } },		/* SRL C */
+  { 2, { 0xcb, 0x5f } },		/* BIT 3,A */
+  { 2, { 0xcb, 0xca } },		/* SET 1,D */
+  { 2, { 0xcb, 0xbb } },		/* RES 7,E */
+  { 2, { 0xcb, 0x16 } },		/* RL (HL) */
+  { 2, { 0xcb, 0x46 } },		/* BIT 0,(HL) */
+  { 2, { 0xcb, 0x27 } },		/* SLA A */
+};
+
+static const corebench_instruction ed_instructions[] = {
+  { 2, { 0xed, 0x44 } },		/* NEG */
+  { 2, { 0xed, 0x57 } },		/* LD A,I */
+  { 2, { 0xed, 0x5f } },		/* LD A,R */
+  { 2, { 0xed, 0x6f } },		/* RLD */
+  { 4, { 0xed, 0x43, 0x40, 0xc0 } },	/* LD (0xc040),BC */
+  { 4, { 0xed, 0x5b, 0x42, 0xc0 } },	/* LD DE,(0xc042) */
+  { 2, { 0xed, 0x78 } },		/* IN A,(C) */
+  { 2, { 0xed, 0x79 } },		/* OUT (C),A */
+  { 2, { 0xed, 0x67 } },		/* RRD */
+};
+
+static const corebench_instruction ddfd_instructions[] = {
+  { 3, { 0xdd, 0x7e, 0x01 } },		/* LD A,(IX+1) */
+  { 3, { 0xfd, 0x86, 0x02 } },		/* ADD A,(IY+2) */
+  { 3, { 0xdd, 0x70, 0x03 } },		/* LD (IX+3),B */
+  { 3, { 0xfd, 0x34, 0x04 } },		/* INC (IY+4) */
+  { 3, { 0xdd, 0x77, 0x05 } },		/* LD (IX+5),A */
+  { 3, { 0xfd, 0x96, 0x06 } },		/* SUB (IY+6) */
+  { 3, { 0xdd, 0x46, 0x07 } },		/* LD B,(IX+7) */
+};
+
+static const corebench_instruction ddfdcb_instructions[] = {
+  { 4, { 0xdd, 0xcb, 0x01, 0x06 } },	/* RLC (IX+1) */
+  { 4, { 0xfd, 0xcb, 0x02, 0x56 } },	/* BIT 2,(IY+2) */
+  { 4, { 0xdd, 0xcb, 0x03, 0xde } },	/* SET 3,(IX+3) */
+  { 4, { 0xfd, 0xcb, 0x04, 0xa6 } },	/* RES 4,(IY+4) */
+  { 4, { 0xdd, 0xcb, 0x05, 0x1e } },	/* RR (IX+5) */
+};
+
+typedef struct corebench_group {
+  const char *name;
+  const corebench_instruction *instructions;
+  size_t count;
+} corebench_group;
+
+static const corebench_group corebench_groups[] = {
+  { "base", base_instructions, ARRAY_SIZE( base_instructions ) },
+  { "cb", cb_instructions, ARRAY_SIZE( cb_instructions ) },
+  { "ed", ed_instructions, ARRAY_SIZE( ed_instructions ) },
+  { "ddfd", ddfd_instructions, ARRAY_SIZE( ddfd_instructions ) },
+  { "ddfdcb", ddfdcb_instructions, ARRAY_SIZE( ddfdcb_instructions ) },
+};
+
+/* Block copies of 4K */
+static const libspectrum_byte ldir_code[] = {
+  0x21, 0x00, 0xc0,	/* 8000 LD HL,0xc000 */
+  0x11, 0x00, 0x90,	/* 8003 LD DE,0x9000 */
+  0x01, 0x00, 0x10,	/* 8006 LD BC,0x1000 */
+  0xed, 0xb0,		/* 8009 LDIR */
+  0x18, 0xf3,		/* 800b JR 0x8000 */
+};
+
+/* The tightest possible loop */
+static const libspectrum_byte djnz_code[] = {
+  0x06, 0x00,		/* 8000 LD B,0x00 */
+  0x10, 0xfe,		/* 8002 DJNZ 0x8002 */
+  0x18, 0xfa,		/* 8004 JR 0x8000 */
+};
+
+/* The sort of routine a music player runs on each interrupt: move the
+   tone and volume on a little, then write all the AY registers from a
+   table. It's called over and over, so that it's nearly all that runs */
+static const libspectrum_byte ay_code[] = {
+  0xcd, 0x00, 0x81,	/* 8000 CALL 0x8100 */
+  0x18, 0xfb,		/* 8003 JR 0x8000 */
+};
+
+static const libspectrum_byte ay_player_code[] = {
+  0x2a, 0x00, 0xc1,	/* 8100 LD HL,(0xc100) */
+  0x23,			/* 8103 INC HL */
+  0x22, 0x00, 0xc1,	/* 8104 LD (0xc100),HL */
+  0x3a, 0x08, 0xc1,	/* 8107 LD A,(0xc108) */
+  0x3d,			/* 810a DEC A */
+  0xe6, 0x0f,		/* 810b AND 0x0f */
+  0x32, 0x08, 0xc1,	/* 810d LD (0xc108),A */
+  0x21, 0x00, 0xc1,	/* 8110 LD HL,0xc100 */
+  0xaf,			/* 8113 XOR A */
+  0x01, 0xfd, 0xff,	/* 8114 LD BC,0xfffd */
+  0xed, 0x79,		/* 8117 OUT (C),A */
+  0x06, 0xbf,		/* 8119 LD B,0xbf */
+  0x5e,			/* 811b LD E,(HL) */
+  0xed, 0x59,		/* 811c OUT (C),E */
+  0x23,			/* 811e INC HL */
+  0x3c,			/* 811f INC A */
+  0xfe, 0x0e,		/* 8120 CP 0x0e */
+  0x20, 0xf0,		/* 8122 JR NZ,0x8114 */
+  0xc9,			/* 8124 RET */
+};
+
+/* Floating point arithmetic with the ROM's calculator, as used by BASIC
+   for all its arithmetic */
+static const libspectrum_byte calculator_code[] = {
+  0x01, 0xd2, 0x04,	/* 8000 LD BC,1234 */
+  0xcd, 0x2b, 0x2d,	/* 8003 CALL 0x2d2b (STACK-BC) */
+  0x01, 0x37, 0x02,	/* 8006 LD BC,567 */
+  0xcd, 0x2b, 0x2d,	/* 8009 CALL 0x2d2b (STACK-BC) */
+  0xef,			/* 800c RST 0x28 (FP-CALC) */
+  0x04,			/* 800d multiply */
+  0x28,			/* 800e sqr */
+  0x1f,			/* 800f sin */
+  0x38,			/* 8010 end-calc */
+  0xcd, 0xa2, 0x2d,	/* 8011 CALL 0x2da2 (FP-TO-BC) */
+  0x18, 0xea,		/* 8014 JR 0x8000 */
+};
+
+/* Used by the contended and uncontended cores in place of the
+   emulator's memory map and ULA */
+libspectrum_dword memory_map_read_contended;
+libspectrum_dword memory_map_write_contended;
+libspectrum_byte ula_contention[ ULA_CONTENTION_SIZE ];
+libspectrum_byte ula_contention_no_mreq[ ULA_CONTENTION_SIZE ];
+
+/* The 48K ROM, if one was given */
+static libspectrum_byte rom[ 0x4000 ];
+static int rom_loaded = 0;
+
+/* The state each measurement starts from; the memory is kept in the core
+   tester's initial_memory */
+static processor initial_z80;
+static libspectrum_dword initial_tstates;
+
+static void
+corebench_clear( void )
+{
+  memset( memory, 0, sizeof( memory ) );
+
+  z80_reset( 1 );
+  tstates = 0;
+  SP = 0xfff0;
+  HL = COREBENCH_DATA;
+  IX = COREBENCH_DATA + 0x80;
+  IY = COREBENCH_DATA + 0xc0;
+  BC = 0x10fe;
+}
+
+static void
+corebench_load( libspectrum_word address, const libspectrum_byte *code,
+                size_t length )
+{
+  memcpy( &memory[ address ], code, length );
+}
+
+static void
+corebench_save( void )
+{
+  memcpy( initial_memory, memory, sizeof( memory ) );
+  initial_z80 = z80;
+  initial_tstates = tstates;
+}
+
+static void
+corebench_restore( void )
+{
+  memcpy( memory, initial_memory, sizeof( memory ) );
+  z80 = initial_z80;
+  tstates = initial_tstates;
+
+  /* The memory was changed behind the cache's back */
+  z80_cache_flush();
+}
+
+/* Set up the memory contention and cache for a core */
+static void
+corebench_select_core( const corebench_core *core )
+{
+  static const libspectrum_byte pattern[8] = { 6, 5, 4, 3, 2, 1, 0, 0 };
+  libspectrum_dword line, i, t;
+
+  corebench_core_current = core;
+  settings_current.predecode_cache = core->predecode_cache;
+
+  memset( ula_contention, 0, sizeof( ula_contention ) );
+  memory_map_read_contended = memory_map_write_contended = 0;
+
+  if( core->contended ) {
+    for( line = 0; line < COREBENCH_CONTENTION_LINES; line++ ) {
+      t = COREBENCH_CONTENTION_START + line * COREBENCH_LINE_LENGTH;
+      for( i = 0; i < 128; i++ ) ula_contention[ t + i ] = pattern[ i % 8 ];
+    }
+    memory_map_read_contended = memory_map_write_contended =
+      COREBENCH_CONTENDED_PAGES;
+  }
+
+  memcpy( ula_contention_no_mreq, ula_contention,
+          sizeof( ula_contention_no_mreq ) );
+
+  z80_cache_flush();
+}
+
+/* Run one frame with the core being timed */
+static void
+corebench_frame( int interrupts )
+{
+  if( interrupts ) z80_interrupt();
+  z80_do_opcodes_with_core( corebench_core_current->core );
+  tstates -= COREBENCH_FRAME_LENGTH;
+}
+
+/* Run from the saved state, returning the processor time taken */
+static double
+corebench_frames( int interrupts )
+{
+  clock_t start;
+  int i;
+
+  corebench_restore();
+
+  start = clock();
+
+  for( i = 0; i < COREBENCH_FRAMES; i++ ) corebench_frame( interrupts );
+
+  return (double)( clock() - start ) / CLOCKS_PER_SEC;
+}
+
+static void
+corebench_print( const char *name, const char *metric, double value,
+                 const char *unit )
+{
+  printf( "{ \"name\": \"%s\", \"metric\": \"%s\", \"value\": %.9g, "
+          "\"unit\": \"%s\" }\n", name, metric, value, unit );
+}
+
+static void
+corebench_measure( const char *kind, const char *name, int interrupts )
+{
+  double elapsed, best = 0, emulated;
+  char result[ 64 ];
+  int i;
+
+  corebench_save();
+
+  profile_active = 1;
+  coretest_instructions = 0;
+  corebench_frames( interrupts );
+  profile_active = 0;
+
+  for( i = 0; i < COREBENCH_RUNS; i++ ) {
+    elapsed = corebench_frames( interrupts );
+    if( !i || elapsed < best ) best = elapsed;
+  }
+
+  if( best <= 0 ) best = 1e-6;
+
+  emulated = (double)COREBENCH_FRAMES * COREBENCH_FRAME_LENGTH /
+             COREBENCH_CLOCK_SPEED;
+
+  /* eg "group-cb/uncontended+cache" */
+  snprintf( result, sizeof( result ), "%s-%s/%s", kind, name,
+            corebench_core_current->name );
+
+  corebench_print( result, "ns_per_instruction",
+                   best * 1e9 / coretest_instructions, "ns" );
+  corebench_print( result, "instructions_per_second",
+                   coretest_instructions / best, "instructions/s" );
+  corebench_print( result, "real_time", emulated / best, "x" );
+}
+
+static void
+corebench_group_run( const corebench_group *group )
+{
+  libspectrum_word address = COREBENCH_CODE;
+  const corebench_instruction *instruction;
+  size_t i;
+
+  corebench_clear();
+
+  for( i = 0; i < COREBENCH_GROUP_LENGTH; i++ ) {
+    instruction = &group->instructions[ i % group->count ];
+    corebench_load( address, instruction->bytes, instruction->length );
+    address += instruction->length;
+  }
+
+  memory[ address++ ] = 0xc3;			/* JP nn */
+  memory[ address++ ] = COREBENCH_CODE & 0xff;
+  memory[ address++ ] = COREBENCH_CODE >> 8;
+
+  PC = COREBENCH_CODE;
+
+  corebench_measure( "group", group->name, 0 );
+}
+
+static void
+corebench_program_run( const char *name, const libspectrum_byte *code,
+                       size_t length )
+{
+  corebench_clear();
+  corebench_load( COREBENCH_CODE, code, length );
+  PC = COREBENCH_CODE;
+
+  corebench_measure( "workload", name, 0 );
+}
+
+static void
+corebench_ay_run( void )
+{
+  corebench_clear();
+  corebench_load( COREBENCH_CODE, ay_code, sizeof( ay_code ) );
+  corebench_load( COREBENCH_CODE + 0x100, ay_player_code,
+                  sizeof( ay_player_code ) );
+  PC = COREBENCH_CODE;
+
+  corebench_measure( "workload", "ay", 0 );
+}
+
+/* Reset the machine with the ROM in place, and leave it to boot for
+   'frames' frames; the ROM's interrupt routine runs at the start of each
+   frame */
+static void
+corebench_rom_reset( int frames )
+{
+  int i;
+
+  corebench_clear();
+  memcpy( memory, rom, sizeof( rom ) );
+  z80_reset( 1 );
+  tstates = 0;
+
+  for( i = 0; i < frames; i++ ) corebench_frame( 1 );
+}
+
+static void
+corebench_rom_run( void )
+{
+  corebench_rom_reset( 0 );
+  corebench_measure( "workload", "rom-boot", 1 );
+
+  corebench_rom_reset( COREBENCH_BOOT_FRAMES );
+  corebench_load( COREBENCH_CODE, calculator_code,
+                  sizeof( calculator_code ) );
+  PC = COREBENCH_CODE;
+  corebench_measure( "workload", "rom-calc", 1 );
+}
+
+static int
+corebench_read_rom( const char *progname, const char *filename )
+{
+  FILE *f;
+  size_t length;
+
+  f = fopen( filename, "rb" );
+  if( !f ) {
+    fprintf( stderr, "%s: couldn't open ROM `%s': %s\n", progname, filename,
+             strerror( errno ) );
+    return 1;
+  }
+
+  length = fread( rom, 1, sizeof( rom ), f );
+  fclose( f );
+
+  if( length != sizeof( rom ) ) {
+    fprintf( stderr, "%s: ROM `%s' is not 16K long\n", progname, filename );
+    return 1;
+  }
+
+  rom_loaded = 1;
+
+  return 0;
+}
+
+int
+main( int argc, char **argv )
+{
+  size_t i, j;
+
+  if( argc > 2 ) {
+    fprintf( stderr, "Usage: %s [48.rom]\n", argv[0] );
+    return 1;
+  }
+
+  if( argc == 2 && corebench_read_rom( argv[0], argv[1] ) ) return 1;
+
+  if( init_dummies() ) return 1;
+
+  /* Interrupts last as long as on a 48K Spectrum */
+  dummy_machine.timings.interrupt_length = 32;
+
+  z80_init( NULL );
+
+  event_next_event = COREBENCH_FRAME_LENGTH;
+
+  for( i = 0; i < ARRAY_SIZE( corebench_cores ); i++ ) {
+
+    corebench_select_core( &corebench_cores[ i ] );
+
+    for( j = 0; j < ARRAY_SIZE( corebench_groups ); j++ )
+      corebench_group_run( &corebench_groups[ j ] );
+
+    corebench_program_run( "ldir", ldir_code, sizeof( ldir_code ) );
+    corebench_program_run( "djnz", djnz_code, sizeof( djnz_code ) );
+    corebench_ay_run();
+
+    if( rom_loaded ) corebench_rom_run();
+  }
+
+  if( !rom_loaded )
+    fprintf( stderr, "%s: no 48K ROM given: skipping the ROM workloads\n",
+             argv[0] );
+
+  return 0;
+}
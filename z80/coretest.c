@@ -29,6 +29,7 @@
 #include <string.h>
 
 #include "fuse.h"
+#include "fuzz/fuzz.h"
 #include "peripherals/disk/beta.h"
 #include "peripherals/disk/didaktik.h"
 #include "peripherals/disk/disciple.h"
@@ -51,10 +52,22 @@
 #include "spectrum.h"
 #include "ui/ui.h"
 #include "z80.h"
+#include "z80_cache.h"
 #include "z80_macros.h"
 
+/* The core benchmarks in corebench.c include this file and use all of it
+   apart from the tests themselves, with memory and port accesses no
+   longer printed */
+#ifdef COREBENCH
+#define CORETEST_TRACE 0
+#else				/* #ifdef COREBENCH */
+#define CORETEST_TRACE 1
+#endif				/* #ifdef COREBENCH */
+
+#ifndef COREBENCH
 static const char *progname;		/* argv[0] */
 static const char *testsfile;		/* argv[1] */
+#endif				/* #ifndef COREBENCH */
 
 static int init_dummies( void );
 
@@ -70,6 +83,7 @@ libspectrum_byte readbyte_internal( libspectrum_word address );
 void writebyte( libspectrum_word address, libspectrum_byte b );
 void writebyte_internal( libspectrum_word address, libspectrum_byte b );
 
+#ifndef COREBENCH
 static int run_test( FILE *f );
 static int read_test( FILE *f, libspectrum_dword *end_tstates );
 
@@ -115,10 +129,12 @@ main( int argc, char **argv )
   return 0;
 }
 
+#endif				/* #ifndef COREBENCH */
+
 libspectrum_byte
 readbyte( libspectrum_word address )
 {
-  printf( "%5d MC %04x\n", tstates, address );
+  if( CORETEST_TRACE ) printf( "%5d MC %04x\n", tstates, address );
   tstates += 3;
   return readbyte_internal( address );
 }
@@ -126,14 +142,15 @@ readbyte( libspectrum_word address )
 libspectrum_byte
 readbyte_internal( libspectrum_word address )
 {
-  printf( "%5d MR %04x %02x\n", tstates, address, memory[ address ] );
+  if( CORETEST_TRACE )
+    printf( "%5d MR %04x %02x\n", tstates, address, memory[ address ] );
   return memory[ address ];
 }
 
 void
 writebyte( libspectrum_word address, libspectrum_byte b )
 {
-  printf( "%5d MC %04x\n", tstates, address );
+  if( CORETEST_TRACE ) printf( "%5d MC %04x\n", tstates, address );
   tstates += 3;
   writebyte_internal( address, b );
 }
@@ -141,14 +158,16 @@ writebyte( libspectrum_word address, libspectrum_byte b )
 void
 writebyte_internal( libspectrum_word address, libspectrum_byte b )
 {
-  printf( "%5d MW %04x %02x\n", tstates, address, b );
+  if( CORETEST_TRACE ) printf( "%5d MW %04x %02x\n", tstates, address, b );
   memory[ address ] = b;
+
+  if( z80_cache_used ) z80_cache_write( address );
 }
 
 void
 contend_read( libspectrum_word address, libspectrum_dword time )
 {
-  printf( "%5d MC %04x\n", tstates, address );
+  if( CORETEST_TRACE ) printf( "%5d MC %04x\n", tstates, address );
   tstates += time;
 }
 
@@ -161,7 +180,7 @@ contend_read_no_mreq( libspectrum_word address, libspectrum_dword time )
 void
 contend_write_no_mreq( libspectrum_word address, libspectrum_dword time )
 {
-  printf( "%5d MC %04x\n", tstates, address );
+  if( CORETEST_TRACE ) printf( "%5d MC %04x\n", tstates, address );
   tstates += time;
 }
 
@@ -169,7 +188,7 @@ static void
 contend_port_preio( libspectrum_word port )
 {
   if( ( port & 0xc000 ) == 0x4000 ) {
-    printf( "%5d PC %04x\n", tstates, port );
+    if( CORETEST_TRACE ) printf( "%5d PC %04x\n", tstates, port );
   }
 
   tstates++;
@@ -181,16 +200,20 @@ contend_port_postio( libspectrum_word port )
   if( port & 0x0001 ) {
     
     if( ( port & 0xc000 ) == 0x4000 ) {
-      printf( "%5d PC %04x\n", tstates, port ); tstates++;
-      printf( "%5d PC %04x\n", tstates, port ); tstates++;
-      printf( "%5d PC %04x\n", tstates, port ); tstates++;
+      if( CORETEST_TRACE ) printf( "%5d PC %04x\n", tstates, port );
+      tstates++;
+      if( CORETEST_TRACE ) printf( "%5d PC %04x\n", tstates, port );
+      tstates++;
+      if( CORETEST_TRACE ) printf( "%5d PC %04x\n", tstates, port );
+      tstates++;
     } else {
       tstates += 3;
     }
 
   } else {
 
-    printf( "%5d PC %04x\n", tstates, port ); tstates += 3;
+    if( CORETEST_TRACE ) printf( "%5d PC %04x\n", tstates, port );
+    tstates += 3;
 
   }
 }
@@ -202,7 +225,7 @@ readport( libspectrum_word port )
 
   contend_port_preio( port );
 
-  printf( "%5d PR %04x %02x\n", tstates, port, r );
+  if( CORETEST_TRACE ) printf( "%5d PR %04x %02x\n", tstates, port, r );
 
   contend_port_postio( port );
 
@@ -214,11 +237,13 @@ writeport( libspectrum_word port, libspectrum_byte b )
 {
   contend_port_preio( port );
 
-  printf( "%5d PW %04x %02x\n", tstates, port, b );
+  if( CORETEST_TRACE ) printf( "%5d PW %04x %02x\n", tstates, port, b );
 
   contend_port_postio( port );
 }
 
+#ifndef COREBENCH
+
 static int
 run_test( FILE *f )
 {
@@ -236,6 +261,9 @@ run_test( FILE *f )
   /* Grab a copy of the memory for comparison at the end */
   memcpy( initial_memory, memory, 0x10000 );
 
+  /* Forget anything decoded from the last test's code */
+  z80_cache_flush();
+
   z80_do_opcodes();
 
   /* And dump our final state */
@@ -351,6 +379,8 @@ dump_memory_state( void )
   }
 }
 
+#endif				/* #ifndef COREBENCH */
+
 /* Error 'handing': dump core as these should never be called */
 
 void
@@ -405,14 +435,35 @@ int rzx_playback;
 int rzx_instructions_offset;
 
 enum debugger_mode_t debugger_mode;
+int debugger_memory_watched;
+libspectrum_dword memory_map_execute_watched;
 
 libspectrum_byte **ROM = NULL;
 memory_page memory_map[8];
+memory_page memory_map_read[ MEMORY_PAGES_IN_64K ];
+memory_page memory_map_write[ MEMORY_PAGES_IN_64K ];
+libspectrum_byte *memory_map_read_page[ MEMORY_PAGES_IN_64K ];
+libspectrum_byte *memory_map_write_page[ MEMORY_PAGES_IN_64K ];
 memory_page *memory_map_home[MEMORY_PAGES_IN_64K];
 memory_page memory_map_rom[SPECTRUM_ROM_PAGES * MEMORY_PAGES_IN_16K];
 int memory_contended[8] = { 1 };
 libspectrum_byte spectrum_contention[ 80000 ] = { 0 };
 int profile_active = 0;
+int fuzz_active = 0;
+libspectrum_byte fuzz_coverage[ FUZZ_COVERAGE_SIZE ];
+
+#ifdef COREBENCH
+
+/* Used by the core benchmarks to count instructions */
+libspectrum_dword coretest_instructions = 0;
+
+void
+profile_map( libspectrum_word pc GCC_UNUSED )
+{
+  coretest_instructions++;
+}
+
+#else				/* #ifdef COREBENCH */
 
 void
 profile_map( libspectrum_word pc GCC_UNUSED )
@@ -420,6 +471,8 @@ profile_map( libspectrum_word pc GCC_UNUSED )
   abort();
 }
 
+#endif				/* #ifdef COREBENCH */
+
 int
 debugger_check( debugger_breakpoint_type type GCC_UNUSED, libspectrum_dword value GCC_UNUSED )
 {
@@ -658,6 +711,15 @@ init_dummies( void )
     memory_map[i].page = &memory[ i * MEMORY_PAGE_SIZE ];
   }
 
+  /* All of the 64K is plain RAM, for the predecode cache */
+  for( i = 0; i < MEMORY_PAGES_IN_64K; i++ ) {
+    memory_map_read[i].page = &memory[ i * MEMORY_PAGE_SIZE ];
+    memory_map_read[i].page_num = i;
+    memory_map_write[i] = memory_map_read[i];
+    memory_map_read_page[i] = memory_map_write_page[i] =
+      memory_map_read[i].page;
+  }
+
   debugger_mode = DEBUGGER_MODE_INACTIVE;
   dummy_machine.capabilities = 0;
   dummy_machine.ram.current_rom = 0;
@@ -668,6 +730,7 @@ init_dummies( void )
   settings_current.divide_enabled = 0;
   settings_current.divmmc_enabled = 0;
   settings_current.z80_is_cmos = 0;
+  settings_current.predecode_cache = 1;
   beta_pc_mask = 0xfe00;
   beta_pc_value = 0x3c00;
   spectranet_programmable_trap_active = 0;
@@ -24,38 +24,49 @@
 /* NB: this file is autogenerated by './z80/z80.pl' from 'opcodes_base.dat',
    and included in 'z80_ops.c' */
 
+#ifndef Z80_CACHE_HANDLERS_ONLY
+
     case 0x00:		/* NOP */
+      Z80_CACHE_LABEL( base, 0x00 )
       break;
     case 0x01:		/* LD BC,nnnn */
+      Z80_CACHE_LABEL( base, 0x01 )
       C=readbyte(PC++);
       B=readbyte(PC++);
       break;
     case 0x02:		/* LD (BC),A */
+      Z80_CACHE_LABEL( base, 0x02 )
       z80.memptr.b.l=BC+1;
       z80.memptr.b.h=A;
       writebyte(BC,A);
       break;
     case 0x03:		/* INC BC */
+      Z80_CACHE_LABEL( base, 0x03 )
 	contend_read_no_mreq( IR, 1 );
 	contend_read_no_mreq( IR, 1 );
 	BC++;
       break;
     case 0x04:		/* INC B */
+      Z80_CACHE_LABEL( base, 0x04 )
       INC(B);
       break;
     case 0x05:		/* DEC B */
+      Z80_CACHE_LABEL( base, 0x05 )
       DEC(B);
       break;
     case 0x06:		/* LD B,nn */
+      Z80_CACHE_LABEL( base, 0x06 )
       B = readbyte( PC++ );
       break;
     case 0x07:		/* RLCA */
+      Z80_CACHE_LABEL( base, 0x07 )
       A = ( A << 1 ) | ( A >> 7 );
       F = ( F & ( FLAG_P | FLAG_Z | FLAG_S ) ) |
 	( A & ( FLAG_C | FLAG_3 | FLAG_5 ) );
       Q = F;
       break;
     case 0x08:		/* EX AF,AF' */
+      Z80_CACHE_LABEL( base, 0x08 )
       /* Tape saving trap: note this traps the EX AF,AF' at #04d0, not
 	 #04d1 as PC has already been incremented */
       /* 0x76 - Timex 2068 save routine in EXROM */
@@ -68,6 +79,7 @@
       }
       break;
     case 0x09:		/* ADD HL,BC */
+      Z80_CACHE_LABEL( base, 0x09 )
       contend_read_no_mreq( IR, 1 );
       contend_read_no_mreq( IR, 1 );
       contend_read_no_mreq( IR, 1 );
@@ -78,30 +90,37 @@
       ADD16(HL,BC);
       break;
     case 0x0a:		/* LD A,(BC) */
+      Z80_CACHE_LABEL( base, 0x0a )
       z80.memptr.w=BC+1;
       A=readbyte(BC);
       break;
     case 0x0b:		/* DEC BC */
+      Z80_CACHE_LABEL( base, 0x0b )
 	contend_read_no_mreq( IR, 1 );
 	contend_read_no_mreq( IR, 1 );
 	BC--;
       break;
     case 0x0c:		/* INC C */
+      Z80_CACHE_LABEL( base, 0x0c )
       INC(C);
       break;
     case 0x0d:		/* DEC C */
+      Z80_CACHE_LABEL( base, 0x0d )
       DEC(C);
       break;
     case 0x0e:		/* LD C,nn */
+      Z80_CACHE_LABEL( base, 0x0e )
       C = readbyte( PC++ );
       break;
     case 0x0f:		/* RRCA */
+      Z80_CACHE_LABEL( base, 0x0f )
       F = ( F & ( FLAG_P | FLAG_Z | FLAG_S ) ) | ( A & FLAG_C );
       A = ( A >> 1) | ( A << 7 );
       F |= ( A & ( FLAG_3 | FLAG_5 ) );
       Q = F;
       break;
     case 0x10:		/* DJNZ offset */
+      Z80_CACHE_LABEL( base, 0x10 )
       contend_read_no_mreq( IR, 1 );
       B--;
       if(B) {
@@ -112,29 +131,36 @@
       }
       break;
     case 0x11:		/* LD DE,nnnn */
+      Z80_CACHE_LABEL( base, 0x11 )
       E=readbyte(PC++);
       D=readbyte(PC++);
       break;
     case 0x12:		/* LD (DE),A */
+      Z80_CACHE_LABEL( base, 0x12 )
       z80.memptr.b.l=DE+1;
       z80.memptr.b.h=A;
       writebyte(DE,A);
       break;
     case 0x13:		/* INC DE */
+      Z80_CACHE_LABEL( base, 0x13 )
 	contend_read_no_mreq( IR, 1 );
 	contend_read_no_mreq( IR, 1 );
 	DE++;
       break;
     case 0x14:		/* INC D */
+      Z80_CACHE_LABEL( base, 0x14 )
       INC(D);
       break;
     case 0x15:		/* DEC D */
+      Z80_CACHE_LABEL( base, 0x15 )
       DEC(D);
       break;
     case 0x16:		/* LD D,nn */
+      Z80_CACHE_LABEL( base, 0x16 )
       D = readbyte( PC++ );
       break;
     case 0x17:		/* RLA */
+      Z80_CACHE_LABEL( base, 0x17 )
       {
 	libspectrum_byte bytetemp = A;
 	A = ( A << 1 ) | ( F & FLAG_C );
@@ -144,9 +170,11 @@
       }
       break;
     case 0x18:		/* JR offset */
+      Z80_CACHE_LABEL( base, 0x18 )
       JR();
       break;
     case 0x19:		/* ADD HL,DE */
+      Z80_CACHE_LABEL( base, 0x19 )
       contend_read_no_mreq( IR, 1 );
       contend_read_no_mreq( IR, 1 );
       contend_read_no_mreq( IR, 1 );
@@ -157,24 +185,30 @@
       ADD16(HL,DE);
       break;
     case 0x1a:		/* LD A,(DE) */
+      Z80_CACHE_LABEL( base, 0x1a )
       z80.memptr.w=DE+1;
       A=readbyte(DE);
       break;
     case 0x1b:		/* DEC DE */
+      Z80_CACHE_LABEL( base, 0x1b )
 	contend_read_no_mreq( IR, 1 );
 	contend_read_no_mreq( IR, 1 );
 	DE--;
       break;
     case 0x1c:		/* INC E */
+      Z80_CACHE_LABEL( base, 0x1c )
       INC(E);
       break;
     case 0x1d:		/* DEC E */
+      Z80_CACHE_LABEL( base, 0x1d )
       DEC(E);
       break;
     case 0x1e:		/* LD E,nn */
+      Z80_CACHE_LABEL( base, 0x1e )
       E = readbyte( PC++ );
       break;
     case 0x1f:		/* RRA */
+      Z80_CACHE_LABEL( base, 0x1f )
       {
 	libspectrum_byte bytetemp = A;
 	A = ( A >> 1 ) | ( F << 7 );
@@ -184,7 +218,8 @@
       }
       break;
     case 0x20:		/* JR NZ,offset */
-      if( ! ( F & FLAG_Z ) ) {
+      Z80_CACHE_LABEL( base, 0x20 )
+      if( ! IS_FLAG_Z ) {
         JR();
       } else {
         contend_read( PC, 3 );
@@ -192,27 +227,34 @@
       }
       break;
     case 0x21:		/* LD HL,nnnn */
+      Z80_CACHE_LABEL( base, 0x21 )
       L=readbyte(PC++);
       H=readbyte(PC++);
       break;
     case 0x22:		/* LD (nnnn),HL */
+      Z80_CACHE_LABEL( base, 0x22 )
       LD16_NNRR(L,H);
       break;
     case 0x23:		/* INC HL */
+      Z80_CACHE_LABEL( base, 0x23 )
 	contend_read_no_mreq( IR, 1 );
 	contend_read_no_mreq( IR, 1 );
 	HL++;
       break;
     case 0x24:		/* INC H */
+      Z80_CACHE_LABEL( base, 0x24 )
       INC(H);
       break;
     case 0x25:		/* DEC H */
+      Z80_CACHE_LABEL( base, 0x25 )
       DEC(H);
       break;
     case 0x26:		/* LD H,nn */
+      Z80_CACHE_LABEL( base, 0x26 )
       H = readbyte( PC++ );
       break;
     case 0x27:		/* DAA */
+      Z80_CACHE_LABEL( base, 0x27 )
       {
 	libspectrum_byte add = 0, carry = ( F & FLAG_C );
 	if( ( F & FLAG_H ) || ( ( A & 0x0f ) > 9 ) ) add = 6;
@@ -228,7 +270,8 @@
       }
       break;
     case 0x28:		/* JR Z,offset */
-      if( F & FLAG_Z ) {
+      Z80_CACHE_LABEL( base, 0x28 )
+      if( IS_FLAG_Z ) {
         JR();
       } else {
         contend_read( PC, 3 );
@@ -236,6 +279,7 @@
       }
       break;
     case 0x29:		/* ADD HL,HL */
+      Z80_CACHE_LABEL( base, 0x29 )
       contend_read_no_mreq( IR, 1 );
       contend_read_no_mreq( IR, 1 );
       contend_read_no_mreq( IR, 1 );
@@ -246,30 +290,37 @@
       ADD16(HL,HL);
       break;
     case 0x2a:		/* LD HL,(nnnn) */
+      Z80_CACHE_LABEL( base, 0x2a )
       LD16_RRNN(L,H);
       break;
     case 0x2b:		/* DEC HL */
+      Z80_CACHE_LABEL( base, 0x2b )
 	contend_read_no_mreq( IR, 1 );
 	contend_read_no_mreq( IR, 1 );
 	HL--;
       break;
     case 0x2c:		/* INC L */
+      Z80_CACHE_LABEL( base, 0x2c )
       INC(L);
       break;
     case 0x2d:		/* DEC L */
+      Z80_CACHE_LABEL( base, 0x2d )
       DEC(L);
       break;
     case 0x2e:		/* LD L,nn */
+      Z80_CACHE_LABEL( base, 0x2e )
       L = readbyte( PC++ );
       break;
     case 0x2f:		/* CPL */
+      Z80_CACHE_LABEL( base, 0x2f )
       A ^= 0xff;
       F = ( F & ( FLAG_C | FLAG_P | FLAG_Z | FLAG_S ) ) |
 	( A & ( FLAG_3 | FLAG_5 ) ) | ( FLAG_N | FLAG_H );
       Q = F;
       break;
     case 0x30:		/* JR NC,offset */
-      if( ! ( F & FLAG_C ) ) {
+      Z80_CACHE_LABEL( base, 0x30 )
+      if( ! IS_FLAG_C ) {
         JR();
       } else {
         contend_read( PC, 3 );
@@ -277,10 +328,12 @@
       }
       break;
     case 0x31:		/* LD SP,nnnn */
+      Z80_CACHE_LABEL( base, 0x31 )
       SPL=readbyte(PC++);
       SPH=readbyte(PC++);
       break;
     case 0x32:		/* LD (nnnn),A */
+      Z80_CACHE_LABEL( base, 0x32 )
       {
 	libspectrum_word wordtemp = readbyte( PC++ );
 	wordtemp|=readbyte(PC++) << 8;
@@ -290,11 +343,13 @@
       }
       break;
     case 0x33:		/* INC SP */
+      Z80_CACHE_LABEL( base, 0x33 )
 	contend_read_no_mreq( IR, 1 );
 	contend_read_no_mreq( IR, 1 );
 	SP++;
       break;
     case 0x34:		/* INC (HL) */
+      Z80_CACHE_LABEL( base, 0x34 )
       {
 	libspectrum_byte bytetemp = readbyte( HL );
 	contend_read_no_mreq( HL, 1 );
@@ -303,6 +358,7 @@
       }
       break;
     case 0x35:		/* DEC (HL) */
+      Z80_CACHE_LABEL( base, 0x35 )
       {
 	libspectrum_byte bytetemp = readbyte( HL );
 	contend_read_no_mreq( HL, 1 );
@@ -311,16 +367,19 @@
       }
       break;
     case 0x36:		/* LD (HL),nn */
+      Z80_CACHE_LABEL( base, 0x36 )
       writebyte(HL,readbyte(PC++));
       break;
     case 0x37:		/* SCF */
+      Z80_CACHE_LABEL( base, 0x37 )
       F = ( F & ( FLAG_P | FLAG_Z | FLAG_S ) ) |
-          ( ( IS_CMOS ? A : ( ( last_Q ^ F ) | A ) ) & ( FLAG_3 | FLAG_5 ) ) |
+          ( ( IS_CMOS ? A : ( ( Q_VALUE( last_Q ) ^ F ) | A ) ) & ( FLAG_3 | FLAG_5 ) ) |
           FLAG_C;
       Q = F;
       break;
     case 0x38:		/* JR C,offset */
-      if( F & FLAG_C ) {
+      Z80_CACHE_LABEL( base, 0x38 )
+      if( IS_FLAG_C ) {
         JR();
       } else {
         contend_read( PC, 3 );
@@ -328,6 +387,7 @@
       }
       break;
     case 0x39:		/* ADD HL,SP */
+      Z80_CACHE_LABEL( base, 0x39 )
       contend_read_no_mreq( IR, 1 );
       contend_read_no_mreq( IR, 1 );
       contend_read_no_mreq( IR, 1 );
@@ -338,6 +398,7 @@
       ADD16(HL,SP);
       break;
     case 0x3a:		/* LD A,(nnnn) */
+      Z80_CACHE_LABEL( base, 0x3a )
       {
 	z80.memptr.b.l = readbyte(PC++);
 	z80.memptr.b.h = readbyte(PC++);
@@ -345,491 +406,636 @@
       }
       break;
     case 0x3b:		/* DEC SP */
+      Z80_CACHE_LABEL( base, 0x3b )
 	contend_read_no_mreq( IR, 1 );
 	contend_read_no_mreq( IR, 1 );
 	SP--;
       break;
     case 0x3c:		/* INC A */
+      Z80_CACHE_LABEL( base, 0x3c )
       INC(A);
       break;
     case 0x3d:		/* DEC A */
+      Z80_CACHE_LABEL( base, 0x3d )
       DEC(A);
       break;
     case 0x3e:		/* LD A,nn */
+      Z80_CACHE_LABEL( base, 0x3e )
       A = readbyte( PC++ );
       break;
     case 0x3f:		/* CCF */
+      Z80_CACHE_LABEL( base, 0x3f )
       F = ( F & ( FLAG_P | FLAG_Z | FLAG_S ) ) |
           ( ( F & FLAG_C ) ? FLAG_H : FLAG_C ) |
-          ( ( IS_CMOS ? A : ( ( last_Q ^ F ) | A ) ) & ( FLAG_3 | FLAG_5 ) );
+          ( ( IS_CMOS ? A : ( ( Q_VALUE( last_Q ) ^ F ) | A ) ) & ( FLAG_3 | FLAG_5 ) );
       Q = F;
       break;
     case 0x40:		/* LD B,B */
+      Z80_CACHE_LABEL( base, 0x40 )
       break;
     case 0x41:		/* LD B,C */
+      Z80_CACHE_LABEL( base, 0x41 )
       B=C;
       break;
     case 0x42:		/* LD B,D */
+      Z80_CACHE_LABEL( base, 0x42 )
       B=D;
       break;
     case 0x43:		/* LD B,E */
+      Z80_CACHE_LABEL( base, 0x43 )
       B=E;
       break;
     case 0x44:		/* LD B,H */
+      Z80_CACHE_LABEL( base, 0x44 )
       B=H;
       break;
     case 0x45:		/* LD B,L */
+      Z80_CACHE_LABEL( base, 0x45 )
       B=L;
       break;
     case 0x46:		/* LD B,(HL) */
+      Z80_CACHE_LABEL( base, 0x46 )
       B=readbyte(HL);
       break;
     case 0x47:		/* LD B,A */
+      Z80_CACHE_LABEL( base, 0x47 )
       B=A;
       break;
     case 0x48:		/* LD C,B */
+      Z80_CACHE_LABEL( base, 0x48 )
       C=B;
       break;
     case 0x49:		/* LD C,C */
+      Z80_CACHE_LABEL( base, 0x49 )
       break;
     case 0x4a:		/* LD C,D */
+      Z80_CACHE_LABEL( base, 0x4a )
       C=D;
       break;
     case 0x4b:		/* LD C,E */
+      Z80_CACHE_LABEL( base, 0x4b )
       C=E;
       break;
     case 0x4c:		/* LD C,H */
+      Z80_CACHE_LABEL( base, 0x4c )
       C=H;
       break;
     case 0x4d:		/* LD C,L */
+      Z80_CACHE_LABEL( base, 0x4d )
       C=L;
       break;
     case 0x4e:		/* LD C,(HL) */
+      Z80_CACHE_LABEL( base, 0x4e )
       C=readbyte(HL);
       break;
     case 0x4f:		/* LD C,A */
+      Z80_CACHE_LABEL( base, 0x4f )
       C=A;
       break;
     case 0x50:		/* LD D,B */
+      Z80_CACHE_LABEL( base, 0x50 )
       D=B;
       break;
     case 0x51:		/* LD D,C */
+      Z80_CACHE_LABEL( base, 0x51 )
       D=C;
       break;
     case 0x52:		/* LD D,D */
+      Z80_CACHE_LABEL( base, 0x52 )
       break;
     case 0x53:		/* LD D,E */
+      Z80_CACHE_LABEL( base, 0x53 )
       D=E;
       break;
     case 0x54:		/* LD D,H */
+      Z80_CACHE_LABEL( base, 0x54 )
       D=H;
       break;
     case 0x55:		/* LD D,L */
+      Z80_CACHE_LABEL( base, 0x55 )
       D=L;
       break;
     case 0x56:		/* LD D,(HL) */
+      Z80_CACHE_LABEL( base, 0x56 )
       D=readbyte(HL);
       break;
     case 0x57:		/* LD D,A */
+      Z80_CACHE_LABEL( base, 0x57 )
       D=A;
       break;
     case 0x58:		/* LD E,B */
+      Z80_CACHE_LABEL( base, 0x58 )
       E=B;
       break;
     case 0x59:		/* LD E,C */
+      Z80_CACHE_LABEL( base, 0x59 )
       E=C;
       break;
     case 0x5a:		/* LD E,D */
+      Z80_CACHE_LABEL( base, 0x5a )
       E=D;
       break;
     case 0x5b:		/* LD E,E */
+      Z80_CACHE_LABEL( base, 0x5b )
       break;
     case 0x5c:		/* LD E,H */
+      Z80_CACHE_LABEL( base, 0x5c )
       E=H;
       break;
     case 0x5d:		/* LD E,L */
+      Z80_CACHE_LABEL( base, 0x5d )
       E=L;
       break;
     case 0x5e:		/* LD E,(HL) */
+      Z80_CACHE_LABEL( base, 0x5e )
       E=readbyte(HL);
       break;
     case 0x5f:		/* LD E,A */
+      Z80_CACHE_LABEL( base, 0x5f )
       E=A;
       break;
     case 0x60:		/* LD H,B */
+      Z80_CACHE_LABEL( base, 0x60 )
       H=B;
       break;
     case 0x61:		/* LD H,C */
+      Z80_CACHE_LABEL( base, 0x61 )
       H=C;
       break;
     case 0x62:		/* LD H,D */
+      Z80_CACHE_LABEL( base, 0x62 )
       H=D;
       break;
     case 0x63:		/* LD H,E */
+      Z80_CACHE_LABEL( base, 0x63 )
       H=E;
       break;
     case 0x64:		/* LD H,H */
+      Z80_CACHE_LABEL( base, 0x64 )
       break;
     case 0x65:		/* LD H,L */
+      Z80_CACHE_LABEL( base, 0x65 )
       H=L;
       break;
     case 0x66:		/* LD H,(HL) */
+      Z80_CACHE_LABEL( base, 0x66 )
       H=readbyte(HL);
       break;
     case 0x67:		/* LD H,A */
+      Z80_CACHE_LABEL( base, 0x67 )
       H=A;
       break;
     case 0x68:		/* LD L,B */
+      Z80_CACHE_LABEL( base, 0x68 )
       L=B;
       break;
     case 0x69:		/* LD L,C */
+      Z80_CACHE_LABEL( base, 0x69 )
       L=C;
       break;
     case 0x6a:		/* LD L,D */
+      Z80_CACHE_LABEL( base, 0x6a )
       L=D;
       break;
     case 0x6b:		/* LD L,E */
+      Z80_CACHE_LABEL( base, 0x6b )
       L=E;
       break;
     case 0x6c:		/* LD L,H */
+      Z80_CACHE_LABEL( base, 0x6c )
       L=H;
       break;
     case 0x6d:		/* LD L,L */
+      Z80_CACHE_LABEL( base, 0x6d )
       break;
     case 0x6e:		/* LD L,(HL) */
+      Z80_CACHE_LABEL( base, 0x6e )
       L=readbyte(HL);
       break;
     case 0x6f:		/* LD L,A */
+      Z80_CACHE_LABEL( base, 0x6f )
       L=A;
       break;
     case 0x70:		/* LD (HL),B */
+      Z80_CACHE_LABEL( base, 0x70 )
       writebyte(HL,B);
       break;
     case 0x71:		/* LD (HL),C */
+      Z80_CACHE_LABEL( base, 0x71 )
       writebyte(HL,C);
       break;
     case 0x72:		/* LD (HL),D */
+      Z80_CACHE_LABEL( base, 0x72 )
       writebyte(HL,D);
       break;
     case 0x73:		/* LD (HL),E */
+      Z80_CACHE_LABEL( base, 0x73 )
       writebyte(HL,E);
       break;
     case 0x74:		/* LD (HL),H */
+      Z80_CACHE_LABEL( base, 0x74 )
       writebyte(HL,H);
       break;
     case 0x75:		/* LD (HL),L */
+      Z80_CACHE_LABEL( base, 0x75 )
       writebyte(HL,L);
       break;
     case 0x76:		/* HALT */
+      Z80_CACHE_LABEL( base, 0x76 )
       z80.halted=1;
       PC--;
       break;
     case 0x77:		/* LD (HL),A */
+      Z80_CACHE_LABEL( base, 0x77 )
       writebyte(HL,A);
       break;
     case 0x78:		/* LD A,B */
+      Z80_CACHE_LABEL( base, 0x78 )
       A=B;
       break;
     case 0x79:		/* LD A,C */
+      Z80_CACHE_LABEL( base, 0x79 )
       A=C;
       break;
     case 0x7a:		/* LD A,D */
+      Z80_CACHE_LABEL( base, 0x7a )
       A=D;
       break;
     case 0x7b:		/* LD A,E */
+      Z80_CACHE_LABEL( base, 0x7b )
       A=E;
       break;
     case 0x7c:		/* LD A,H */
+      Z80_CACHE_LABEL( base, 0x7c )
       A=H;
       break;
     case 0x7d:		/* LD A,L */
+      Z80_CACHE_LABEL( base, 0x7d )
       A=L;
       break;
     case 0x7e:		/* LD A,(HL) */
+      Z80_CACHE_LABEL( base, 0x7e )
       A=readbyte(HL);
       break;
     case 0x7f:		/* LD A,A */
+      Z80_CACHE_LABEL( base, 0x7f )
       break;
     case 0x80:		/* ADD A,B */
+      Z80_CACHE_LABEL( base, 0x80 )
       ADD(B);
       break;
     case 0x81:		/* ADD A,C */
+      Z80_CACHE_LABEL( base, 0x81 )
       ADD(C);
       break;
     case 0x82:		/* ADD A,D */
+      Z80_CACHE_LABEL( base, 0x82 )
       ADD(D);
       break;
     case 0x83:		/* ADD A,E */
+      Z80_CACHE_LABEL( base, 0x83 )
       ADD(E);
       break;
     case 0x84:		/* ADD A,H */
+      Z80_CACHE_LABEL( base, 0x84 )
       ADD(H);
       break;
     case 0x85:		/* ADD A,L */
+      Z80_CACHE_LABEL( base, 0x85 )
       ADD(L);
       break;
     case 0x86:		/* ADD A,(HL) */
+      Z80_CACHE_LABEL( base, 0x86 )
       {
 	libspectrum_byte bytetemp = readbyte( HL );
 	ADD(bytetemp);
       }
       break;
     case 0x87:		/* ADD A,A */
+      Z80_CACHE_LABEL( base, 0x87 )
       ADD(A);
       break;
     case 0x88:		/* ADC A,B */
+      Z80_CACHE_LABEL( base, 0x88 )
       ADC(B);
       break;
     case 0x89:		/* ADC A,C */
+      Z80_CACHE_LABEL( base, 0x89 )
       ADC(C);
       break;
     case 0x8a:		/* ADC A,D */
+      Z80_CACHE_LABEL( base, 0x8a )
       ADC(D);
       break;
     case 0x8b:		/* ADC A,E */
+      Z80_CACHE_LABEL( base, 0x8b )
       ADC(E);
       break;
     case 0x8c:		/* ADC A,H */
+      Z80_CACHE_LABEL( base, 0x8c )
       ADC(H);
       break;
     case 0x8d:		/* ADC A,L */
+      Z80_CACHE_LABEL( base, 0x8d )
       ADC(L);
       break;
     case 0x8e:		/* ADC A,(HL) */
+      Z80_CACHE_LABEL( base, 0x8e )
       {
 	libspectrum_byte bytetemp = readbyte( HL );
 	ADC(bytetemp);
       }
       break;
     case 0x8f:		/* ADC A,A */
+      Z80_CACHE_LABEL( base, 0x8f )
       ADC(A);
       break;
     case 0x90:		/* SUB A,B */
+      Z80_CACHE_LABEL( base, 0x90 )
       SUB(B);
       break;
     case 0x91:		/* SUB A,C */
+      Z80_CACHE_LABEL( base, 0x91 )
       SUB(C);
       break;
     case 0x92:		/* SUB A,D */
+      Z80_CACHE_LABEL( base, 0x92 )
       SUB(D);
       break;
     case 0x93:		/* SUB A,E */
+      Z80_CACHE_LABEL( base, 0x93 )
       SUB(E);
       break;
     case 0x94:		/* SUB A,H */
+      Z80_CACHE_LABEL( base, 0x94 )
       SUB(H);
       break;
     case 0x95:		/* SUB A,L */
+      Z80_CACHE_LABEL( base, 0x95 )
       SUB(L);
       break;
     case 0x96:		/* SUB A,(HL) */
+      Z80_CACHE_LABEL( base, 0x96 )
       {
 	libspectrum_byte bytetemp = readbyte( HL );
 	SUB(bytetemp);
       }
       break;
     case 0x97:		/* SUB A,A */
+      Z80_CACHE_LABEL( base, 0x97 )
       SUB(A);
       break;
     case 0x98:		/* SBC A,B */
+      Z80_CACHE_LABEL( base, 0x98 )
       SBC(B);
       break;
     case 0x99:		/* SBC A,C */
+      Z80_CACHE_LABEL( base, 0x99 )
       SBC(C);
       break;
     case 0x9a:		/* SBC A,D */
+      Z80_CACHE_LABEL( base, 0x9a )
       SBC(D);
       break;
     case 0x9b:		/* SBC A,E */
+      Z80_CACHE_LABEL( base, 0x9b )
       SBC(E);
       break;
     case 0x9c:		/* SBC A,H */
+      Z80_CACHE_LABEL( base, 0x9c )
       SBC(H);
       break;
     case 0x9d:		/* SBC A,L */
+      Z80_CACHE_LABEL( base, 0x9d )
       SBC(L);
       break;
     case 0x9e:		/* SBC A,(HL) */
+      Z80_CACHE_LABEL( base, 0x9e )
       {
 	libspectrum_byte bytetemp = readbyte( HL );
 	SBC(bytetemp);
       }
       break;
     case 0x9f:		/* SBC A,A */
+      Z80_CACHE_LABEL( base, 0x9f )
       SBC(A);
       break;
     case 0xa0:		/* AND A,B */
+      Z80_CACHE_LABEL( base, 0xa0 )
       AND(B);
       break;
     case 0xa1:		/* AND A,C */
+      Z80_CACHE_LABEL( base, 0xa1 )
       AND(C);
       break;
     case 0xa2:		/* AND A,D */
+      Z80_CACHE_LABEL( base, 0xa2 )
       AND(D);
       break;
     case 0xa3:		/* AND A,E */
+      Z80_CACHE_LABEL( base, 0xa3 )
       AND(E);
       break;
     case 0xa4:		/* AND A,H */
+      Z80_CACHE_LABEL( base, 0xa4 )
       AND(H);
       break;
     case 0xa5:		/* AND A,L */
+      Z80_CACHE_LABEL( base, 0xa5 )
       AND(L);
       break;
     case 0xa6:		/* AND A,(HL) */
+      Z80_CACHE_LABEL( base, 0xa6 )
       {
 	libspectrum_byte bytetemp = readbyte( HL );
 	AND(bytetemp);
       }
       break;
     case 0xa7:		/* AND A,A */
+      Z80_CACHE_LABEL( base, 0xa7 )
       AND(A);
       break;
     case 0xa8:		/* XOR A,B */
+      Z80_CACHE_LABEL( base, 0xa8 )
       XOR(B);
       break;
     case 0xa9:		/* XOR A,C */
+      Z80_CACHE_LABEL( base, 0xa9 )
       XOR(C);
       break;
     case 0xaa:		/* XOR A,D */
+      Z80_CACHE_LABEL( base, 0xaa )
       XOR(D);
       break;
     case 0xab:		/* XOR A,E */
+      Z80_CACHE_LABEL( base, 0xab )
       XOR(E);
       break;
     case 0xac:		/* XOR A,H */
+      Z80_CACHE_LABEL( base, 0xac )
       XOR(H);
       break;
     case 0xad:		/* XOR A,L */
+      Z80_CACHE_LABEL( base, 0xad )
       XOR(L);
       break;
     case 0xae:		/* XOR A,(HL) */
+      Z80_CACHE_LABEL( base, 0xae )
       {
 	libspectrum_byte bytetemp = readbyte( HL );
 	XOR(bytetemp);
       }
       break;
     case 0xaf:		/* XOR A,A */
+      Z80_CACHE_LABEL( base, 0xaf )
       XOR(A);
       break;
     case 0xb0:		/* OR A,B */
+      Z80_CACHE_LABEL( base, 0xb0 )
       OR(B);
       break;
     case 0xb1:		/* OR A,C */
+      Z80_CACHE_LABEL( base, 0xb1 )
       OR(C);
       break;
     case 0xb2:		/* OR A,D */
+      Z80_CACHE_LABEL( base, 0xb2 )
       OR(D);
       break;
     case 0xb3:		/* OR A,E */
+      Z80_CACHE_LABEL( base, 0xb3 )
       OR(E);
       break;
     case 0xb4:		/* OR A,H */
+      Z80_CACHE_LABEL( base, 0xb4 )
       OR(H);
       break;
     case 0xb5:		/* OR A,L */
+      Z80_CACHE_LABEL( base, 0xb5 )
       OR(L);
       break;
     case 0xb6:		/* OR A,(HL) */
+      Z80_CACHE_LABEL( base, 0xb6 )
       {
 	libspectrum_byte bytetemp = readbyte( HL );
 	OR(bytetemp);
       }
       break;
     case 0xb7:		/* OR A,A */
+      Z80_CACHE_LABEL( base, 0xb7 )
       OR(A);
       break;
     case 0xb8:		/* CP B */
+      Z80_CACHE_LABEL( base, 0xb8 )
       CP(B);
       break;
     case 0xb9:		/* CP C */
+      Z80_CACHE_LABEL( base, 0xb9 )
       CP(C);
       break;
     case 0xba:		/* CP D */
+      Z80_CACHE_LABEL( base, 0xba )
       CP(D);
       break;
     case 0xbb:		/* CP E */
+      Z80_CACHE_LABEL( base, 0xbb )
       CP(E);
       break;
     case 0xbc:		/* CP H */
+      Z80_CACHE_LABEL( base, 0xbc )
       CP(H);
       break;
     case 0xbd:		/* CP L */
+      Z80_CACHE_LABEL( base, 0xbd )
       CP(L);
       break;
     case 0xbe:		/* CP (HL) */
+      Z80_CACHE_LABEL( base, 0xbe )
       {
 	libspectrum_byte bytetemp = readbyte( HL );
 	CP(bytetemp);
       }
       break;
     case 0xbf:		/* CP A */
+      Z80_CACHE_LABEL( base, 0xbf )
       CP(A);
       break;
     case 0xc0:		/* RET NZ */
+      Z80_CACHE_LABEL( base, 0xc0 )
       contend_read_no_mreq( IR, 1 );
       if( PC==0x056c || PC == 0x0112 ) {
 	if( tape_load_trap() == 0 ) break;
       }
-      if( ! ( F & FLAG_Z ) ) { RET(); }
+      if( ! IS_FLAG_Z ) { RET(); }
       break;
     case 0xc1:		/* POP BC */
+      Z80_CACHE_LABEL( base, 0xc1 )
       POP16(C,B);
       break;
     case 0xc2:		/* JP NZ,nnnn */
+      Z80_CACHE_LABEL( base, 0xc2 )
       z80.memptr.b.l = readbyte(PC++);
       z80.memptr.b.h = readbyte(PC);
-      if( ! ( F & FLAG_Z ) ) {
+      if( ! IS_FLAG_Z ) {
 	JP();
       } else {
         PC++;
       }
       break;
     case 0xc3:		/* JP nnnn */
+      Z80_CACHE_LABEL( base, 0xc3 )
       z80.memptr.b.l = readbyte(PC++);
       z80.memptr.b.h = readbyte(PC);
       JP();
       break;
     case 0xc4:		/* CALL NZ,nnnn */
+      Z80_CACHE_LABEL( base, 0xc4 )
       z80.memptr.b.l = readbyte(PC++);
       z80.memptr.b.h = readbyte(PC);
-      if( ! ( F & FLAG_Z ) ) {
+      if( ! IS_FLAG_Z ) {
 	CALL();
       } else {
         PC++;
       }
       break;
     case 0xc5:		/* PUSH BC */
+      Z80_CACHE_LABEL( base, 0xc5 )
       contend_read_no_mreq( IR, 1 );
       PUSH16(C,B);
       break;
     case 0xc6:		/* ADD A,nn */
+      Z80_CACHE_LABEL( base, 0xc6 )
       {
 	libspectrum_byte bytetemp = readbyte( PC++ );
 	ADD(bytetemp);
       }
       break;
     case 0xc7:		/* RST 00 */
+      Z80_CACHE_LABEL( base, 0xc7 )
       contend_read_no_mreq( IR, 1 );
       RST(0x00);
       break;
     case 0xc8:		/* RET Z */
+      Z80_CACHE_LABEL( base, 0xc8 )
       contend_read_no_mreq( IR, 1 );
-      if( F & FLAG_Z ) { RET(); }
+      if( IS_FLAG_Z ) { RET(); }
       break;
     case 0xc9:		/* RET */
+      Z80_CACHE_LABEL( base, 0xc9 )
       RET();
       break;
     case 0xca:		/* JP Z,nnnn */
+      Z80_CACHE_LABEL( base, 0xca )
       z80.memptr.b.l = readbyte(PC++);
       z80.memptr.b.h = readbyte(PC);
-      if( F & FLAG_Z ) {
+      if( IS_FLAG_Z ) {
 	JP();
       } else {
         PC++;
       }
       break;
     case 0xcb:		/* shift CB */
+      Z80_CACHE_LABEL( base, 0xcb )
       {
 	libspectrum_byte opcode2;
 	contend_read( PC, 4 );
@@ -845,46 +1051,54 @@
       }
       break;
     case 0xcc:		/* CALL Z,nnnn */
+      Z80_CACHE_LABEL( base, 0xcc )
       z80.memptr.b.l = readbyte(PC++);
       z80.memptr.b.h = readbyte(PC);
-      if( F & FLAG_Z ) {
+      if( IS_FLAG_Z ) {
 	CALL();
       } else {
         PC++;
       }
       break;
     case 0xcd:		/* CALL nnnn */
+      Z80_CACHE_LABEL( base, 0xcd )
       z80.memptr.b.l = readbyte(PC++);
       z80.memptr.b.h = readbyte(PC);
       CALL();
       break;
     case 0xce:		/* ADC A,nn */
+      Z80_CACHE_LABEL( base, 0xce )
       {
 	libspectrum_byte bytetemp = readbyte( PC++ );
 	ADC(bytetemp);
       }
       break;
     case 0xcf:		/* RST 8 */
+      Z80_CACHE_LABEL( base, 0xcf )
       contend_read_no_mreq( IR, 1 );
       RST(0x08);
       break;
     case 0xd0:		/* RET NC */
+      Z80_CACHE_LABEL( base, 0xd0 )
       contend_read_no_mreq( IR, 1 );
-      if( ! ( F & FLAG_C ) ) { RET(); }
+      if( ! IS_FLAG_C ) { RET(); }
       break;
     case 0xd1:		/* POP DE */
+      Z80_CACHE_LABEL( base, 0xd1 )
       POP16(E,D);
       break;
     case 0xd2:		/* JP NC,nnnn */
+      Z80_CACHE_LABEL( base, 0xd2 )
       z80.memptr.b.l = readbyte(PC++);
       z80.memptr.b.h = readbyte(PC);
-      if( ! ( F & FLAG_C ) ) {
+      if( ! IS_FLAG_C ) {
 	JP();
       } else {
         PC++;
       }
       break;
     case 0xd3:		/* OUT (nn),A */
+      Z80_CACHE_LABEL( base, 0xd3 )
       {
 	libspectrum_byte nn = readbyte( PC++ );
 	libspectrum_word outtemp = nn | ( A << 8 );
@@ -894,33 +1108,39 @@
       }
       break;
     case 0xd4:		/* CALL NC,nnnn */
+      Z80_CACHE_LABEL( base, 0xd4 )
       z80.memptr.b.l = readbyte(PC++);
       z80.memptr.b.h = readbyte(PC);
-      if( ! ( F & FLAG_C ) ) {
+      if( ! IS_FLAG_C ) {
 	CALL();
       } else {
         PC++;
       }
       break;
     case 0xd5:		/* PUSH DE */
+      Z80_CACHE_LABEL( base, 0xd5 )
       contend_read_no_mreq( IR, 1 );
       PUSH16(E,D);
       break;
     case 0xd6:		/* SUB nn */
+      Z80_CACHE_LABEL( base, 0xd6 )
       {
 	libspectrum_byte bytetemp = readbyte( PC++ );
 	SUB(bytetemp);
       }
       break;
     case 0xd7:		/* RST 10 */
+      Z80_CACHE_LABEL( base, 0xd7 )
       contend_read_no_mreq( IR, 1 );
       RST(0x10);
       break;
     case 0xd8:		/* RET C */
+      Z80_CACHE_LABEL( base, 0xd8 )
       contend_read_no_mreq( IR, 1 );
-      if( F & FLAG_C ) { RET(); }
+      if( IS_FLAG_C ) { RET(); }
       break;
     case 0xd9:		/* EXX */
+      Z80_CACHE_LABEL( base, 0xd9 )
       {
 	libspectrum_word wordtemp;
 	wordtemp = BC; BC = BC_; BC_ = wordtemp;
@@ -929,15 +1149,17 @@
       }
       break;
     case 0xda:		/* JP C,nnnn */
+      Z80_CACHE_LABEL( base, 0xda )
       z80.memptr.b.l = readbyte(PC++);
       z80.memptr.b.h = readbyte(PC);
-      if( F & FLAG_C ) {
+      if( IS_FLAG_C ) {
 	JP();
       } else {
         PC++;
       }
       break;
     case 0xdb:		/* IN A,(nn) */
+      Z80_CACHE_LABEL( base, 0xdb )
       {
 	libspectrum_word intemp;
 	intemp = readbyte( PC++ ) + ( A << 8 );
@@ -947,15 +1169,17 @@
       }
       break;
     case 0xdc:		/* CALL C,nnnn */
+      Z80_CACHE_LABEL( base, 0xdc )
       z80.memptr.b.l = readbyte(PC++);
       z80.memptr.b.h = readbyte(PC);
-      if( F & FLAG_C ) {
+      if( IS_FLAG_C ) {
 	CALL();
       } else {
         PC++;
       }
       break;
     case 0xdd:		/* shift DD */
+      Z80_CACHE_LABEL( base, 0xdd )
       {
 	libspectrum_byte opcode2;
 	contend_read( PC, 4 );
@@ -966,7 +1190,9 @@
 #define REGISTER  IX
 #define REGISTERL IXL
 #define REGISTERH IXH
+#define Z80_CACHE_DDFD dd
 #include "z80_ddfd.c"
+#undef Z80_CACHE_DDFD
 #undef REGISTERH
 #undef REGISTERL
 #undef REGISTER
@@ -977,32 +1203,38 @@
       }
       break;
     case 0xde:		/* SBC A,nn */
+      Z80_CACHE_LABEL( base, 0xde )
       {
 	libspectrum_byte bytetemp = readbyte( PC++ );
 	SBC(bytetemp);
       }
       break;
     case 0xdf:		/* RST 18 */
+      Z80_CACHE_LABEL( base, 0xdf )
       contend_read_no_mreq( IR, 1 );
       RST(0x18);
       break;
     case 0xe0:		/* RET PO */
+      Z80_CACHE_LABEL( base, 0xe0 )
       contend_read_no_mreq( IR, 1 );
-      if( ! ( F & FLAG_P ) ) { RET(); }
+      if( ! IS_FLAG_P ) { RET(); }
       break;
     case 0xe1:		/* POP HL */
+      Z80_CACHE_LABEL( base, 0xe1 )
       POP16(L,H);
       break;
     case 0xe2:		/* JP PO,nnnn */
+      Z80_CACHE_LABEL( base, 0xe2 )
       z80.memptr.b.l = readbyte(PC++);
       z80.memptr.b.h = readbyte(PC);
-      if( ! ( F & FLAG_P ) ) {
+      if( ! IS_FLAG_P ) {
 	JP();
       } else {
         PC++;
       }
       break;
     case 0xe3:		/* EX (SP),HL */
+      Z80_CACHE_LABEL( base, 0xe3 )
       {
 	libspectrum_byte bytetempl, bytetemph;
 	bytetempl = readbyte( SP );
@@ -1015,59 +1247,69 @@
       }
       break;
     case 0xe4:		/* CALL PO,nnnn */
+      Z80_CACHE_LABEL( base, 0xe4 )
       z80.memptr.b.l = readbyte(PC++);
       z80.memptr.b.h = readbyte(PC);
-      if( ! ( F & FLAG_P ) ) {
+      if( ! IS_FLAG_P ) {
 	CALL();
       } else {
         PC++;
       }
       break;
     case 0xe5:		/* PUSH HL */
+      Z80_CACHE_LABEL( base, 0xe5 )
       contend_read_no_mreq( IR, 1 );
       PUSH16(L,H);
       break;
     case 0xe6:		/* AND nn */
+      Z80_CACHE_LABEL( base, 0xe6 )
       {
 	libspectrum_byte bytetemp = readbyte( PC++ );
 	AND(bytetemp);
       }
       break;
     case 0xe7:		/* RST 20 */
+      Z80_CACHE_LABEL( base, 0xe7 )
       contend_read_no_mreq( IR, 1 );
       RST(0x20);
       break;
     case 0xe8:		/* RET PE */
+      Z80_CACHE_LABEL( base, 0xe8 )
       contend_read_no_mreq( IR, 1 );
-      if( F & FLAG_P ) { RET(); }
+      if( IS_FLAG_P ) { RET(); }
       break;
     case 0xe9:		/* JP HL */
+      Z80_CACHE_LABEL( base, 0xe9 )
       PC=HL;		/* NB: NOT INDIRECT! */
       break;
     case 0xea:		/* JP PE,nnnn */
+      Z80_CACHE_LABEL( base, 0xea )
       z80.memptr.b.l = readbyte(PC++);
       z80.memptr.b.h = readbyte(PC);
-      if( F & FLAG_P ) {
+      if( IS_FLAG_P ) {
 	JP();
       } else {
         PC++;
       }
       break;
     case 0xeb:		/* EX DE,HL */
+      Z80_CACHE_LABEL( base, 0xeb )
       {
 	libspectrum_word wordtemp=DE; DE=HL; HL=wordtemp;
       }
       break;
     case 0xec:		/* CALL PE,nnnn */
+      Z80_CACHE_LABEL( base, 0xec )
       z80.memptr.b.l = readbyte(PC++);
       z80.memptr.b.h = readbyte(PC);
-      if( F & FLAG_P ) {
+      if( IS_FLAG_P ) {
 	CALL();
       } else {
         PC++;
       }
       break;
     case 0xed:		/* shift ED */
+      Z80_CACHE_LABEL( base, 0xed )
       {
 	libspectrum_byte opcode2;
 	contend_read( PC, 4 );
@@ -1083,76 +1325,90 @@
       }
       break;
     case 0xee:		/* XOR A,nn */
+      Z80_CACHE_LABEL( base, 0xee )
       {
 	libspectrum_byte bytetemp = readbyte( PC++ );
 	XOR(bytetemp);
       }
       break;
     case 0xef:		/* RST 28 */
+      Z80_CACHE_LABEL( base, 0xef )
       contend_read_no_mreq( IR, 1 );
       RST(0x28);
       break;
     case 0xf0:		/* RET P */
+      Z80_CACHE_LABEL( base, 0xf0 )
       contend_read_no_mreq( IR, 1 );
-      if( ! ( F & FLAG_S ) ) { RET(); }
+      if( ! IS_FLAG_S ) { RET(); }
       break;
     case 0xf1:		/* POP AF */
+      Z80_CACHE_LABEL( base, 0xf1 )
       POP16(F,A);
       break;
     case 0xf2:		/* JP P,nnnn */
+      Z80_CACHE_LABEL( base, 0xf2 )
       z80.memptr.b.l = readbyte(PC++);
       z80.memptr.b.h = readbyte(PC);
-      if( ! ( F & FLAG_S ) ) {
+      if( ! IS_FLAG_S ) {
 	JP();
       } else {
         PC++;
       }
       break;
     case 0xf3:		/* DI */
+      Z80_CACHE_LABEL( base, 0xf3 )
       IFF1=IFF2=0;
       break;
     case 0xf4:		/* CALL P,nnnn */
+      Z80_CACHE_LABEL( base, 0xf4 )
       z80.memptr.b.l = readbyte(PC++);
       z80.memptr.b.h = readbyte(PC);
-      if( ! ( F & FLAG_S ) ) {
+      if( ! IS_FLAG_S ) {
 	CALL();
       } else {
         PC++;
       }
       break;
     case 0xf5:		/* PUSH AF */
+      Z80_CACHE_LABEL( base, 0xf5 )
       contend_read_no_mreq( IR, 1 );
       PUSH16(F,A);
       break;
     case 0xf6:		/* OR nn */
+      Z80_CACHE_LABEL( base, 0xf6 )
       {
 	libspectrum_byte bytetemp = readbyte( PC++ );
 	OR(bytetemp);
       }
       break;
     case 0xf7:		/* RST 30 */
+      Z80_CACHE_LABEL( base, 0xf7 )
       contend_read_no_mreq( IR, 1 );
       RST(0x30);
       break;
     case 0xf8:		/* RET M */
+      Z80_CACHE_LABEL( base, 0xf8 )
       contend_read_no_mreq( IR, 1 );
-      if( F & FLAG_S ) { RET(); }
+      if( IS_FLAG_S ) { RET(); }
       break;
     case 0xf9:		/* LD SP,HL */
+      Z80_CACHE_LABEL( base, 0xf9 )
       contend_read_no_mreq( IR, 1 );
       contend_read_no_mreq( IR, 1 );
       SP = HL;
       break;
     case 0xfa:		/* JP M,nnnn */
+      Z80_CACHE_LABEL( base, 0xfa )
       z80.memptr.b.l = readbyte(PC++);
       z80.memptr.b.h = readbyte(PC);
-      if( F & FLAG_S ) {
+      if( IS_FLAG_S ) {
 	JP();
       } else {
         PC++;
       }
       break;
     case 0xfb:		/* EI */
+      Z80_CACHE_LABEL( base, 0xfb )
       /* Interrupts are not accepted immediately after an EI, but are
 	 accepted after the next instruction */
       IFF1 = IFF2 = 1;
@@ -1160,15 +1416,17 @@
       event_add( tstates + 1, z80_interrupt_event );
       break;
     case 0xfc:		/* CALL M,nnnn */
+      Z80_CACHE_LABEL( base, 0xfc )
       z80.memptr.b.l = readbyte(PC++);
       z80.memptr.b.h = readbyte(PC);
-      if( F & FLAG_S ) {
+      if( IS_FLAG_S ) {
 	CALL();
       } else {
         PC++;
       }
       break;
     case 0xfd:		/* shift FD */
+      Z80_CACHE_LABEL( base, 0xfd )
       {
 	libspectrum_byte opcode2;
 	contend_read( PC, 4 );
@@ -1179,7 +1437,9 @@
 #define REGISTER  IY
 #define REGISTERL IYL
 #define REGISTERH IYH
+#define Z80_CACHE_DDFD fd
 #include "z80_ddfd.c"
+#undef Z80_CACHE_DDFD
 #undef REGISTERH
 #undef REGISTERL
 #undef REGISTER
@@ -1190,12 +1450,275 @@
       }
       break;
     case 0xfe:		/* CP nn */
+      Z80_CACHE_LABEL( base, 0xfe )
       {
 	libspectrum_byte bytetemp = readbyte( PC++ );
 	CP(bytetemp);
       }
       break;
     case 0xff:		/* RST 38 */
+      Z80_CACHE_LABEL( base, 0xff )
       contend_read_no_mreq( IR, 1 );
       RST(0x38);
       break;
+
+#else			/* #ifndef Z80_CACHE_HANDLERS_ONLY */
+
+Z80_CACHE_HANDLER( base, 0x00 )
+Z80_CACHE_HANDLER( base, 0x01 )
+Z80_CACHE_HANDLER( base, 0x02 )
+Z80_CACHE_HANDLER( base, 0x03 )
+Z80_CACHE_HANDLER( base, 0x04 )
+Z80_CACHE_HANDLER( base, 0x05 )
+Z80_CACHE_HANDLER( base, 0x06 )
+Z80_CACHE_HANDLER( base, 0x07 )
+Z80_CACHE_HANDLER( base, 0x08 )
+Z80_CACHE_HANDLER( base, 0x09 )
+Z80_CACHE_HANDLER( base, 0x0a )
+Z80_CACHE_HANDLER( base, 0x0b )
+Z80_CACHE_HANDLER( base, 0x0c )
+Z80_CACHE_HANDLER( base, 0x0d )
+Z80_CACHE_HANDLER( base, 0x0e )
+Z80_CACHE_HANDLER( base, 0x0f )
+Z80_CACHE_HANDLER( base, 0x10 )
+Z80_CACHE_HANDLER( base, 0x11 )
+Z80_CACHE_HANDLER( base, 0x12 )
+Z80_CACHE_HANDLER( base, 0x13 )
+Z80_CACHE_HANDLER( base, 0x14 )
+Z80_CACHE_HANDLER( base, 0x15 )
+Z80_CACHE_HANDLER( base, 0x16 )
+Z80_CACHE_HANDLER( base, 0x17 )
+Z80_CACHE_HANDLER( base, 0x18 )
+Z80_CACHE_HANDLER( base, 0x19 )
+Z80_CACHE_HANDLER( base, 0x1a )
+Z80_CACHE_HANDLER( base, 0x1b )
+Z80_CACHE_HANDLER( base, 0x1c )
+Z80_CACHE_HANDLER( base, 0x1d )
+Z80_CACHE_HANDLER( base, 0x1e )
+Z80_CACHE_HANDLER( base, 0x1f )
+Z80_CACHE_HANDLER( base, 0x20 )
+Z80_CACHE_HANDLER( base, 0x21 )
+Z80_CACHE_HANDLER( base, 0x22 )
+Z80_CACHE_HANDLER( base, 0x23 )
+Z80_CACHE_HANDLER( base, 0x24 )
+Z80_CACHE_HANDLER( base, 0x25 )
+Z80_CACHE_HANDLER( base, 0x26 )
+Z80_CACHE_HANDLER( base, 0x27 )
+Z80_CACHE_HANDLER( base, 0x28 )
+Z80_CACHE_HANDLER( base, 0x29 )
+Z80_CACHE_HANDLER( base, 0x2a )
+Z80_CACHE_HANDLER( base, 0x2b )
+Z80_CACHE_HANDLER( base, 0x2c )
+Z80_CACHE_HANDLER( base, 0x2d )
+Z80_CACHE_HANDLER( base, 0x2e )
+Z80_CACHE_HANDLER( base, 0x2f )
+Z80_CACHE_HANDLER( base, 0x30 )
+Z80_CACHE_HANDLER( base, 0x31 )
+Z80_CACHE_HANDLER( base, 0x32 )
+Z80_CACHE_HANDLER( base, 0x33 )
+Z80_CACHE_HANDLER( base, 0x34 )
+Z80_CACHE_HANDLER( base, 0x35 )
+Z80_CACHE_HANDLER( base, 0x36 )
+Z80_CACHE_HANDLER( base, 0x37 )
+Z80_CACHE_HANDLER( base, 0x38 )
+Z80_CACHE_HANDLER( base, 0x39 )
+Z80_CACHE_HANDLER( base, 0x3a )
+Z80_CACHE_HANDLER( base, 0x3b )
+Z80_CACHE_HANDLER( base, 0x3c )
+Z80_CACHE_HANDLER( base, 0x3d )
+Z80_CACHE_HANDLER( base, 0x3e )
+Z80_CACHE_HANDLER( base, 0x3f )
+Z80_CACHE_HANDLER( base, 0x40 )
+Z80_CACHE_HANDLER( base, 0x41 )
+Z80_CACHE_HANDLER( base, 0x42 )
+Z80_CACHE_HANDLER( base, 0x43 )
+Z80_CACHE_HANDLER( base, 0x44 )
+Z80_CACHE_HANDLER( base, 0x45 )
+Z80_CACHE_HANDLER( base, 0x46 )
+Z80_CACHE_HANDLER( base, 0x47 )
+Z80_CACHE_HANDLER( base, 0x48 )
+Z80_CACHE_HANDLER( base, 0x49 )
+Z80_CACHE_HANDLER( base, 0x4a )
+Z80_CACHE_HANDLER( base, 0x4b )
+Z80_CACHE_HANDLER( base, 0x4c )
+Z80_CACHE_HANDLER( base, 0x4d )
+Z80_CACHE_HANDLER( base, 0x4e )
+Z80_CACHE_HANDLER( base, 0x4f )
+Z80_CACHE_HANDLER( base, 0x50 )
+Z80_CACHE_HANDLER( base, 0x51 )
+Z80_CACHE_HANDLER( base, 0x52 )
+Z80_CACHE_HANDLER( base, 0x53 )
+Z80_CACHE_HANDLER( base, 0x54 )
+Z80_CACHE_HANDLER( base, 0x55 )
+Z80_CACHE_HANDLER( base, 0x56 )
+Z80_CACHE_HANDLER( base, 0x57 )
+Z80_CACHE_HANDLER( base, 0x58 )
+Z80_CACHE_HANDLER( base, 0x59 )
+Z80_CACHE_HANDLER( base, 0x5a )
+Z80_CACHE_HANDLER( base, 0x5b )
+Z80_CACHE_HANDLER( base, 0x5c )
+Z80_CACHE_HANDLER( base, 0x5d )
+Z80_CACHE_HANDLER( base, 0x5e )
+Z80_CACHE_HANDLER( base, 0x5f )
+Z80_CACHE_HANDLER( base, 0x60 )
+Z80_CACHE_HANDLER( base, 0x61 )
+Z80_CACHE_HANDLER( base, 0x62 )
+Z80_CACHE_HANDLER( base, 0x63 )
+Z80_CACHE_HANDLER( base, 0x64 )
+Z80_CACHE_HANDLER( base, 0x65 )
+Z80_CACHE_HANDLER( base, 0x66 )
+Z80_CACHE_HANDLER( base, 0x67 )
+Z80_CACHE_HANDLER( base, 0x68 )
+Z80_CACHE_HANDLER( base, 0x69 )
+Z80_CACHE_HANDLER( base, 0x6a )
+Z80_CACHE_HANDLER( base, 0x6b )
+Z80_CACHE_HANDLER( base, 0x6c )
+Z80_CACHE_HANDLER( base, 0x6d )
+Z80_CACHE_HANDLER( base, 0x6e )
+Z80_CACHE_HANDLER( base, 0x6f )
+Z80_CACHE_HANDLER( base, 0x70 )
+Z80_CACHE_HANDLER( base, 0x71 )
+Z80_CACHE_HANDLER( base, 0x72 )
+Z80_CACHE_HANDLER( base, 0x73 )
+Z80_CACHE_HANDLER( base, 0x74 )
+Z80_CACHE_HANDLER( base, 0x75 )
+Z80_CACHE_HANDLER( base, 0x76 )
+Z80_CACHE_HANDLER( base, 0x77 )
+Z80_CACHE_HANDLER( base, 0x78 )
+Z80_CACHE_HANDLER( base, 0x79 )
+Z80_CACHE_HANDLER( base, 0x7a )
+Z80_CACHE_HANDLER( base, 0x7b )
+Z80_CACHE_HANDLER( base, 0x7c )
+Z80_CACHE_HANDLER( base, 0x7d )
+Z80_CACHE_HANDLER( base, 0x7e )
+Z80_CACHE_HANDLER( base, 0x7f )
+Z80_CACHE_HANDLER( base, 0x80 )
+Z80_CACHE_HANDLER( base, 0x81 )
+Z80_CACHE_HANDLER( base, 0x82 )
+Z80_CACHE_HANDLER( base, 0x83 )
+Z80_CACHE_HANDLER( base, 0x84 )
+Z80_CACHE_HANDLER( base, 0x85 )
+Z80_CACHE_HANDLER( base, 0x86 )
+Z80_CACHE_HANDLER( base, 0x87 )
+Z80_CACHE_HANDLER( base, 0x88 )
+Z80_CACHE_HANDLER( base, 0x89 )
+Z80_CACHE_HANDLER( base, 0x8a )
+Z80_CACHE_HANDLER( base, 0x8b )
+Z80_CACHE_HANDLER( base, 0x8c )
+Z80_CACHE_HANDLER( base, 0x8d )
+Z80_CACHE_HANDLER( base, 0x8e )
+Z80_CACHE_HANDLER( base, 0x8f )
+Z80_CACHE_HANDLER( base, 0x90 )
+Z80_CACHE_HANDLER( base, 0x91 )
+Z80_CACHE_HANDLER( base, 0x92 )
+Z80_CACHE_HANDLER( base, 0x93 )
+Z80_CACHE_HANDLER( base, 0x94 )
+Z80_CACHE_HANDLER( base, 0x95 )
+Z80_CACHE_HANDLER( base, 0x96 )
+Z80_CACHE_HANDLER( base, 0x97 )
+Z80_CACHE_HANDLER( base, 0x98 )
+Z80_CACHE_HANDLER( base, 0x99 )
+Z80_CACHE_HANDLER( base, 0x9a )
+Z80_CACHE_HANDLER( base, 0x9b )
+Z80_CACHE_HANDLER( base, 0x9c )
+Z80_CACHE_HANDLER( base, 0x9d )
+Z80_CACHE_HANDLER( base, 0x9e )
+Z80_CACHE_HANDLER( base, 0x9f )
+Z80_CACHE_HANDLER( base, 0xa0 )
+Z80_CACHE_HANDLER( base, 0xa1 )
+Z80_CACHE_HANDLER( base, 0xa2 )
+Z80_CACHE_HANDLER( base, 0xa3 )
+Z80_CACHE_HANDLER( base, 0xa4 )
+Z80_CACHE_HANDLER( base, 0xa5 )
+Z80_CACHE_HANDLER( base, 0xa6 )
+Z80_CACHE_HANDLER( base, 0xa7 )
+Z80_CACHE_HANDLER( base, 0xa8 )
+Z80_CACHE_HANDLER( base, 0xa9 )
+Z80_CACHE_HANDLER( base, 0xaa )
+Z80_CACHE_HANDLER( base, 0xab )
+Z80_CACHE_HANDLER( base, 0xac )
+Z80_CACHE_HANDLER( base, 0xad )
+Z80_CACHE_HANDLER( base, 0xae )
+Z80_CACHE_HANDLER( base, 0xaf )
+Z80_CACHE_HANDLER( base, 0xb0 )
+Z80_CACHE_HANDLER( base, 0xb1 )
+Z80_CACHE_HANDLER( base, 0xb2 )
+Z80_CACHE_HANDLER( base, 0xb3 )
+Z80_CACHE_HANDLER( base, 0xb4 )
+Z80_CACHE_HANDLER( base, 0xb5 )
+Z80_CACHE_HANDLER( base, 0xb6 )
+Z80_CACHE_HANDLER( base, 0xb7 )
+Z80_CACHE_HANDLER( base, 0xb8 )
+Z80_CACHE_HANDLER( base, 0xb9 )
+Z80_CACHE_HANDLER( base, 0xba )
+Z80_CACHE_HANDLER( base, 0xbb )
+Z80_CACHE_HANDLER( base, 0xbc )
+Z80_CACHE_HANDLER( base, 0xbd )
+Z80_CACHE_HANDLER( base, 0xbe )
+Z80_CACHE_HANDLER( base, 0xbf )
+Z80_CACHE_HANDLER( base, 0xc0 )
+Z80_CACHE_HANDLER( base, 0xc1 )
+Z80_CACHE_HANDLER( base, 0xc2 )
+Z80_CACHE_HANDLER( base, 0xc3 )
+Z80_CACHE_HANDLER( base, 0xc4 )
+Z80_CACHE_HANDLER( base, 0xc5 )
+Z80_CACHE_HANDLER( base, 0xc6 )
+Z80_CACHE_HANDLER( base, 0xc7 )
+Z80_CACHE_HANDLER( base, 0xc8 )
+Z80_CACHE_HANDLER( base, 0xc9 )
+Z80_CACHE_HANDLER( base, 0xca )
+Z80_CACHE_HANDLER( base, 0xcb )
+Z80_CACHE_HANDLER( base, 0xcc )
+Z80_CACHE_HANDLER( base, 0xcd )
+Z80_CACHE_HANDLER( base, 0xce )
+Z80_CACHE_HANDLER( base, 0xcf )
+Z80_CACHE_HANDLER( base, 0xd0 )
+Z80_CACHE_HANDLER( base, 0xd1 )
+Z80_CACHE_HANDLER( base, 0xd2 )
+Z80_CACHE_HANDLER( base, 0xd3 )
+Z80_CACHE_HANDLER( base, 0xd4 )
+Z80_CACHE_HANDLER( base, 0xd5 )
+Z80_CACHE_HANDLER( base, 0xd6 )
+Z80_CACHE_HANDLER( base, 0xd7 )
+Z80_CACHE_HANDLER( base, 0xd8 )
+Z80_CACHE_HANDLER( base, 0xd9 )
+Z80_CACHE_HANDLER( base, 0xda )
+Z80_CACHE_HANDLER( base, 0xdb )
+Z80_CACHE_HANDLER( base, 0xdc )
+Z80_CACHE_HANDLER( base, 0xdd )
+Z80_CACHE_HANDLER( base, 0xde )
+Z80_CACHE_HANDLER( base, 0xdf )
+Z80_CACHE_HANDLER( base, 0xe0 )
+Z80_CACHE_HANDLER( base, 0xe1 )
+Z80_CACHE_HANDLER( base, 0xe2 )
+Z80_CACHE_HANDLER( base, 0xe3 )
+Z80_CACHE_HANDLER( base, 0xe4 )
+Z80_CACHE_HANDLER( base, 0xe5 )
+Z80_CACHE_HANDLER( base, 0xe6 )
+Z80_CACHE_HANDLER( base, 0xe7 )
+Z80_CACHE_HANDLER( base, 0xe8 )
+Z80_CACHE_HANDLER( base, 0xe9 )
+Z80_CACHE_HANDLER( base, 0xea )
+Z80_CACHE_HANDLER( base, 0xeb )
+Z80_CACHE_HANDLER( base, 0xec )
+Z80_CACHE_HANDLER( base, 0xed )
+Z80_CACHE_HANDLER( base, 0xee )
+Z80_CACHE_HANDLER( base, 0xef )
+Z80_CACHE_HANDLER( base, 0xf0 )
+Z80_CACHE_HANDLER( base, 0xf1 )
+Z80_CACHE_HANDLER( base, 0xf2 )
+Z80_CACHE_HANDLER( base, 0xf3 )
+Z80_CACHE_HANDLER( base, 0xf4 )
+Z80_CACHE_HANDLER( base, 0xf5 )
+Z80_CACHE_HANDLER( base, 0xf6 )
+Z80_CACHE_HANDLER( base, 0xf7 )
+Z80_CACHE_HANDLER( base, 0xf8 )
+Z80_CACHE_HANDLER( base, 0xf9 )
+Z80_CACHE_HANDLER( base, 0xfa )
+Z80_CACHE_HANDLER( base, 0xfb )
+Z80_CACHE_HANDLER( base, 0xfc )
+Z80_CACHE_HANDLER( base, 0xfd )
+Z80_CACHE_HANDLER( base, 0xfe )
+Z80_CACHE_HANDLER( base, 0xff )
+
+#endif			/* #ifndef Z80_CACHE_HANDLERS_ONLY */
@@ -39,6 +39,7 @@
 #include "spectrum.h"
 #include "ui/ui.h"
 #include "z80.h"
+#include "z80_cache.h"
 #include "z80_internals.h"
 #include "z80_macros.h"
 
@@ -72,9 +73,15 @@ int z80_nmi_event;
 int z80_nmos_iff2_event;
 
 static void z80_init_tables(void);
+static void z80_end( void );
 static void z80_from_snapshot( libspectrum_snap *snap );
 static void z80_to_snapshot( libspectrum_snap *snap );
 static void z80_nmi( libspectrum_dword ts, int type, void *user_data );
+static void z80_state_save( int slot );
+static void z80_state_restore( int slot );
+
+/* The copies of the registers kept by z80_state_save() */
+static processor saved_z80[ MODULE_STATE_SLOTS ];
 
 static module_info_t z80_module_info = {
 
@@ -83,6 +90,8 @@ static module_info_t z80_module_info = {
   NULL,
   z80_from_snapshot,
   z80_to_snapshot,
+  z80_state_save,
+  z80_state_restore,
 
 };
 
@@ -114,9 +123,17 @@ z80_init( void *context )
 
   z80_debugger_variables_init();
 
+  z80_cache_flush();
+
   return 0;
 }
 
+static void
+z80_end( void )
+{
+  z80_cache_end();
+}
+
 void
 z80_register_startup( void )
 {
@@ -126,7 +143,8 @@ z80_register_startup( void )
     STARTUP_MANAGER_MODULE_SETUID,
   };
   startup_manager_register( STARTUP_MANAGER_MODULE_Z80, dependencies,
-                            ARRAY_SIZE( dependencies ), z80_init, NULL, NULL );
+                            ARRAY_SIZE( dependencies ), z80_init, NULL,
+                            z80_end );
 }
 
 /* Initalise the tables used to set flags */
@@ -315,6 +333,9 @@ z80_from_snapshot( libspectrum_snap *snap )
     libspectrum_snap_last_instruction_ei( snap ) ? tstates : -1;
 
   Q = libspectrum_snap_last_instruction_set_f( snap ) ? F : 0;
+
+  /* Memory has been replaced without going through writebyte_internal() */
+  z80_cache_flush();
 }
   
 static void
@@ -350,5 +371,17 @@ z80_to_snapshot( libspectrum_snap *snap )
   /* If last instruction set F but it's zero, it is saved as false, but the
      result of the next (hypothetically) SCF/CCF instruction it's
      independent of this flag */
-  libspectrum_snap_set_last_instruction_set_f( snap, !!Q );
+  libspectrum_snap_set_last_instruction_set_f( snap, !!Q_VALUE( Q ) );
+}
+
+static void
+z80_state_save( int slot )
+{
+  saved_z80[ slot ] = z80;
+}
+
+static void
+z80_state_restore( int slot )
+{
+  z80 = saved_z80[ slot ];
 }
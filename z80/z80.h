@@ -34,6 +34,19 @@ typedef union {
   libspectrum_word w;
 } regpair;
 
+/* How the flags left by the last flag-setting instruction are to be
+   worked out, if that has not been done yet */
+typedef enum z80_flags_op {
+  Z80_FLAGS_RESOLVED = 0,	/* F holds the flags */
+  Z80_FLAGS_ADD,		/* ADD and ADC */
+  Z80_FLAGS_SUB,		/* SUB, SBC and NEG */
+  Z80_FLAGS_CP,
+  Z80_FLAGS_AND,
+  Z80_FLAGS_OR,			/* OR and XOR */
+  Z80_FLAGS_INC,
+  Z80_FLAGS_DEC,
+} z80_flags_op;
+
 /* What's stored in the main processor */
 typedef struct {
   regpair af,bc,de,hl;
@@ -53,7 +66,15 @@ typedef struct {
      F register, before moving it back to F. The behaviour is deterministic in
      Zilog Z80 and nondeterministic in NEC Z80.
      https://www.worldofspectrum.org/forums/discussion/41704/ */
-  libspectrum_byte q;
+  libspectrum_word q;
+
+  /* The common arithmetic and logical instructions don't work out the
+     flags until something needs them: if flags_op is not
+     Z80_FLAGS_RESOLVED, only the carry flag in F is valid and the others
+     come from the operands and result stored here */
+  z80_flags_op flags_op;
+  libspectrum_byte flags_a, flags_b;
+  libspectrum_word flags_result;
 
   /* Interrupts were enabled at this time; do not accept any interrupts
      until tstates > this value */
@@ -68,10 +89,24 @@ void z80_reset( int hard_reset );
 int z80_interrupt( void );
 void z80_retn( void );
 
+/* The variants of the main execution loop */
+typedef enum z80_core_type {
+  Z80_CORE_HOOKED,		/* Supports everything */
+  Z80_CORE_CONTENDED,		/* No debugger or peripheral memory hooks */
+  Z80_CORE_UNCONTENDED,		/* As above, and no memory contention */
+
+  Z80_CORE_COUNT
+} z80_core_type;
+
 void z80_do_opcodes(void);
+void z80_do_opcodes_with_core( z80_core_type core );
+void z80_select_core( void );
+const char* z80_core_name( z80_core_type core );
 
 void z80_enable_interrupts( void );
 
+void z80_flags_resolve( void );
+
 extern processor z80;
 extern const libspectrum_byte halfcarry_add_table[];
 extern const libspectrum_byte halfcarry_sub_table[];
@@ -28,10 +28,10 @@ use Fuse;
 
 # The status of which flags relates to which condition
 
-# These conditions involve !( F & FLAG_<whatever> )
+# These conditions involve ! IS_FLAG_<whatever>
 my %not = map { $_ => 1 } qw( NC NZ P PO );
 
-# Use F & FLAG_<whatever>
+# Use IS_FLAG_<whatever>
 my %flag = (
 
       C => 'C', NC => 'C',
@@ -114,9 +114,9 @@ CALL
     } else {
 	my $condition_string;
 	if( defined $not{$condition} ) {
-	    $condition_string = "! ( F & FLAG_$flag{$condition} )";
+	    $condition_string = "! IS_FLAG_$flag{$condition}";
 	} else {
-	    $condition_string = "F & FLAG_$flag{$condition}";
+	    $condition_string = "IS_FLAG_$flag{$condition}";
 	}
 	print << "CALL";
       if( $condition_string ) {
@@ -525,7 +525,7 @@ sub opcode_CCF (@) {
     print << "CCF";
       F = ( F & ( FLAG_P | FLAG_Z | FLAG_S ) ) |
           ( ( F & FLAG_C ) ? FLAG_H : FLAG_C ) |
-          ( ( IS_CMOS ? A : ( ( last_Q ^ F ) | A ) ) & ( FLAG_3 | FLAG_5 ) );
+          ( ( IS_CMOS ? A : ( ( Q_VALUE( last_Q ) ^ F ) | A ) ) & ( FLAG_3 | FLAG_5 ) );
       Q = F;
 CCF
 }
@@ -723,9 +723,9 @@ sub opcode_JR (@) {
     } else {
 	my $condition_string;
 	if( defined $not{$condition} ) {
-	    $condition_string = "! ( F & FLAG_$flag{$condition} )";
+	    $condition_string = "! IS_FLAG_$flag{$condition}";
 	} else {
-	    $condition_string = "F & FLAG_$flag{$condition}";
+	    $condition_string = "IS_FLAG_$flag{$condition}";
 	}
 	print << "JR";
       if( $condition_string ) {
@@ -988,9 +988,9 @@ RET
         }
 
 	if( defined $not{$condition} ) {
-	    print "      if( ! ( F & FLAG_$flag{$condition} ) ) { RET(); }\n";
+	    print "      if( ! IS_FLAG_$flag{$condition} ) { RET(); }\n";
 	} else {
-	    print "      if( F & FLAG_$flag{$condition} ) { RET(); }\n";
+	    print "      if( IS_FLAG_$flag{$condition} ) { RET(); }\n";
 	}
     }
 }
@@ -1096,7 +1096,7 @@ sub opcode_SBC (@) { arithmetic_logical( 'SBC', $_[0], $_[1] ); }
 sub opcode_SCF (@) {
     print << "SCF";
       F = ( F & ( FLAG_P | FLAG_Z | FLAG_S ) ) |
-          ( ( IS_CMOS ? A : ( ( last_Q ^ F ) | A ) ) & ( FLAG_3 | FLAG_5 ) ) |
+          ( ( IS_CMOS ? A : ( ( Q_VALUE( last_Q ) ^ F ) | A ) ) & ( FLAG_3 | FLAG_5 ) ) |
           FLAG_C;
       Q = F;
 SCF
@@ -1163,7 +1163,9 @@ shift
 #define REGISTER  $register
 #define REGISTERL ${register}L
 #define REGISTERH ${register}H
+#define Z80_CACHE_DDFD $lc_opcode
 #include "z80_ddfd.c"
+#undef Z80_CACHE_DDFD
 #undef REGISTERH
 #undef REGISTERL
 #undef REGISTER
@@ -1182,6 +1184,16 @@ shift
     }
 }
 
+# Mark the start of an opcode's code for the predecode cache
+sub cache_label ($$) {
+
+    my( $prefix, $number ) = @_;
+
+    return if not defined $prefix;
+
+    print "      Z80_CACHE_LABEL( $prefix, $number )\n";
+}
+
 # Description of each file
 
 my %description = (
@@ -1194,10 +1206,24 @@ my %description = (
 
 );
 
+# The name used for each opcode's label in the predecode cache, or
+# undefined for opcodes which the cache never jumps to directly
+my %cache_prefix = (
+
+    'opcodes_base.dat'   => 'base',
+    'opcodes_cb.dat'     => 'cb',
+    'opcodes_ddfd.dat'   => 'Z80_CACHE_DDFD',
+    'opcodes_ed.dat'     => 'ed',
+
+);
+
 # Main program
 
 ( my $data_file = $ARGV[0] ) =~ s!.*/!!;
 
+my $cache_prefix = $cache_prefix{ $data_file };
+my @cache_numbers;
+
 print Fuse::GPL( $description{ $data_file }, '1999-2003 Philip Kendall' );
 
 print << "COMMENT";
@@ -1207,6 +1233,8 @@ print << "COMMENT";
 
 COMMENT
 
+print "#ifndef Z80_CACHE_HANDLERS_ONLY\n\n" if defined $cache_prefix;
+
 while(<>) {
 
     # Remove comments
@@ -1219,8 +1247,13 @@ while(<>) {
 
     my( $number, $opcode, $arguments, $extra ) = split;
 
+    if( defined $cache_prefix ) {
+	push @cache_numbers, $number;
+    }
+
     if( not defined $opcode ) {
 	print "    case $number:\n";
+	cache_label( $cache_prefix, $number );
 	next;
     }
 
@@ -1234,6 +1267,8 @@ while(<>) {
 
     print " */\n";
 
+    cache_label( $cache_prefix, $number );
+
     # Handle the undocumented rotate-shift-or-bit and store-in-register
     # opcodes specially
 
@@ -1299,3 +1334,12 @@ CODE
       break;
 NOPD
 }
+
+if( defined $cache_prefix ) {
+
+    print "\n#else\t\t\t/* #ifndef Z80_CACHE_HANDLERS_ONLY */\n\n";
+
+    print "Z80_CACHE_HANDLER( $cache_prefix, $_ )\n" foreach @cache_numbers;
+
+    print "\n#endif\t\t\t/* #ifndef Z80_CACHE_HANDLERS_ONLY */\n";
+}
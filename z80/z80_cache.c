@@ -0,0 +1,195 @@
+/* z80_cache.c: Predecode cache for the Z80 core
+   Copyright (c) 2026 Fuse contributors
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+   Author contact information:
+
+   E-mail: philip-fuse@shadowmagic.org.uk
+
+*/
+
+/* The cache remembers, for each address from which an instruction has
+   been executed, which of the core's handlers runs that instruction, so
+   the core can skip fetching and decoding the opcode and any prefix.
+   Only the opcode bytes are cached; operands are still read from memory
+   as normal, so an entry only needs to be forgotten when the byte at its
+   own address or the one after it is written */
+
+#include <config.h>
+
+#include <string.h>
+
+#include <libspectrum.h>
+
+#include "memory_pages.h"
+#include "z80_cache.h"
+
+z80_cache_block *z80_cache_map[ MEMORY_PAGES_IN_64K ];
+
+int z80_cache_used = 0;
+
+/* All blocks, keyed by source, page number and offset */
+static GHashTable *blocks = NULL;
+
+/* Used for any address nothing has been decoded from yet; it doesn't
+   match any real memory and every entry sends the core through the
+   normal decoder, so it is never written to */
+static z80_cache_block no_block;
+
+/* The block, if any, for what is currently paged in for writing at each
+   address, and the memory that was paged in when it was looked up */
+static z80_cache_block *write_block[ MEMORY_PAGES_IN_64K ];
+static const libspectrum_byte *write_data[ MEMORY_PAGES_IN_64K ];
+
+static gpointer
+block_key( int source, int page_num, libspectrum_word offset )
+{
+  return GUINT_TO_POINTER( source << 18 | page_num << 5 |
+                           offset >> MEMORY_PAGE_SIZE_LOGARITHM );
+}
+
+static void
+block_clear( z80_cache_block *block, const libspectrum_byte *data )
+{
+  block->data = data;
+  memset( block->entries, 0, sizeof( block->entries ) );
+}
+
+static void
+write_map_reset( void )
+{
+  size_t i;
+
+  for( i = 0; i < MEMORY_PAGES_IN_64K; i++ ) {
+    write_block[ i ] = NULL;
+    write_data[ i ] = NULL;
+  }
+}
+
+z80_cache_block*
+z80_cache_map_slot( int slot )
+{
+  memory_page *mapping = &memory_map_read[ slot ];
+  z80_cache_block *block;
+  gpointer key;
+
+  if( !blocks )
+    blocks = g_hash_table_new_full( NULL, NULL, NULL, libspectrum_free );
+
+  key = block_key( mapping->source, mapping->page_num, mapping->offset );
+  block = g_hash_table_lookup( blocks, key );
+
+  if( !block ) {
+    block = libspectrum_new( z80_cache_block, 1 );
+    block->source = mapping->source;
+    block->page_num = mapping->page_num;
+    block->offset = mapping->offset;
+    block_clear( block, mapping->page );
+    g_hash_table_insert( blocks, key, block );
+    write_map_reset();
+  } else if( block->data != mapping->page ) {
+    block_clear( block, mapping->page );
+    write_map_reset();
+  }
+
+  z80_cache_used = 1;
+  z80_cache_map[ slot ] = block;
+
+  return block;
+}
+
+libspectrum_word
+z80_cache_decode( libspectrum_word address )
+{
+  /* Read straight from the page the block covers; this isn't one of the
+     core's memory accesses, so the core tester mustn't trace it */
+  const libspectrum_byte *page =
+    memory_map_read_page[ address >> MEMORY_PAGE_SIZE_LOGARITHM ];
+  libspectrum_word position = address & MEMORY_PAGE_SIZE_MASK;
+  libspectrum_byte opcode = page[ position ];
+  int offset;
+
+  switch( opcode ) {
+  case 0xcb: offset = Z80_CACHE_OFFSET_cb; break;
+  case 0xdd: offset = Z80_CACHE_OFFSET_dd; break;
+  case 0xed: offset = Z80_CACHE_OFFSET_ed; break;
+  case 0xfd: offset = Z80_CACHE_OFFSET_fd; break;
+  default: return Z80_CACHE_OFFSET_base + opcode;
+  }
+
+  /* Both bytes must come from the same page so that a write to either
+     of them finds this entry */
+  if( position == MEMORY_PAGE_SIZE_MASK ) return Z80_CACHE_UNCACHEABLE;
+
+  return offset + page[ position + 1 ];
+}
+
+void
+z80_cache_write( libspectrum_word address )
+{
+  libspectrum_word bank = address >> MEMORY_PAGE_SIZE_LOGARITHM;
+  libspectrum_word offset = address & MEMORY_PAGE_SIZE_MASK;
+  memory_page *mapping = &memory_map_write[ bank ];
+  z80_cache_block *block;
+
+  if( write_data[ bank ] != mapping->page ) {
+    block = g_hash_table_lookup( blocks,
+                                 block_key( mapping->source,
+                                            mapping->page_num,
+                                            mapping->offset ) );
+    if( block && block->data != mapping->page ) block = NULL;
+
+    write_block[ bank ] = block;
+    write_data[ bank ] = mapping->page;
+  }
+
+  block = write_block[ bank ];
+  if( !block ) return;
+
+  /* This byte may be the opcode of one instruction and the prefixed
+     opcode of the one before it */
+  block->entries[ offset ] = Z80_CACHE_UNDECODED;
+  if( offset ) block->entries[ offset - 1 ] = Z80_CACHE_UNDECODED;
+}
+
+void
+z80_cache_flush( void )
+{
+  size_t i;
+
+  if( blocks ) g_hash_table_remove_all( blocks );
+
+  no_block.data = NULL;
+  for( i = 0; i < MEMORY_PAGE_SIZE; i++ )
+    no_block.entries[ i ] = Z80_CACHE_UNCACHEABLE;
+
+  for( i = 0; i < MEMORY_PAGES_IN_64K; i++ ) z80_cache_map[ i ] = &no_block;
+
+  write_map_reset();
+
+  z80_cache_used = 0;
+}
+
+void
+z80_cache_end( void )
+{
+  if( blocks ) {
+    g_hash_table_destroy( blocks );
+    blocks = NULL;
+  }
+
+  z80_cache_used = 0;
+}
@@ -0,0 +1,105 @@
+/* z80_cache.h: Predecode cache for the Z80 core
+   Copyright (c) 2026 Fuse contributors
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+   Author contact information:
+
+   E-mail: philip-fuse@shadowmagic.org.uk
+
+*/
+
+#ifndef FUSE_Z80_CACHE_H
+#define FUSE_Z80_CACHE_H
+
+#include <libspectrum.h>
+
+#include "memory_pages.h"
+
+/* Each entry in the cache is either one of these two values or the
+   index of the code for the instruction in the core's handler table */
+#define Z80_CACHE_UNDECODED 0
+#define Z80_CACHE_UNCACHEABLE 0xffff
+
+/* Where each opcode table starts in the handler table; any entry
+   greater than Z80_CACHE_OFFSET_cb has a prefix byte */
+#define Z80_CACHE_OFFSET_base 0x001
+#define Z80_CACHE_OFFSET_cb   0x101
+#define Z80_CACHE_OFFSET_ed   0x201
+#define Z80_CACHE_OFFSET_dd   0x301
+#define Z80_CACHE_OFFSET_fd   0x401
+#define Z80_CACHE_HANDLERS    0x501
+
+/* The decoded instructions for one memory page, identified by its
+   source, page number and offset */
+typedef struct z80_cache_block {
+
+  int source;
+  int page_num;
+  libspectrum_word offset;
+
+  const libspectrum_byte *data;	/* The memory these entries were decoded
+				   from */
+
+  libspectrum_word entries[ MEMORY_PAGE_SIZE ];
+
+} z80_cache_block;
+
+/* The block for the memory currently paged in at each address; check
+   the data pointer against memory_map_read[] before use */
+extern z80_cache_block *z80_cache_map[ MEMORY_PAGES_IN_64K ];
+
+/* Non-zero if anything has been decoded since the last flush */
+extern int z80_cache_used;
+
+/* Find the block for what is currently paged in at 'slot' */
+z80_cache_block* z80_cache_map_slot( int slot );
+
+/* Work out the entry for the instruction at 'address' */
+libspectrum_word z80_cache_decode( libspectrum_word address );
+
+/* Forget anything decoded from the byte just written at 'address' */
+void z80_cache_write( libspectrum_word address );
+
+/* Forget everything; used when memory is changed other than by
+   writebyte_internal() */
+void z80_cache_flush( void );
+
+void z80_cache_end( void );
+
+/* The generated opcode files mark the code for each instruction with
+   Z80_CACHE_LABEL(), which is redefined to produce a label when building
+   a core which uses the cache, and list each opcode with
+   Z80_CACHE_HANDLER() when included with Z80_CACHE_HANDLERS_ONLY
+   defined */
+#define Z80_CACHE_LABEL( prefix, number )
+
+#define Z80_CACHE_LABEL_NAME( prefix, number ) z80_cache_##prefix##_##number
+
+/* Used where the cache skips reading an opcode byte; the core tester's
+   trace shows every opcode fetch, so it still reads them */
+#ifndef CORETEST
+#define Z80_CACHE_FETCHED( address )
+#else			/* #ifndef CORETEST */
+#define Z80_CACHE_FETCHED( address ) readbyte_internal( address )
+#endif			/* #ifndef CORETEST */
+
+#define Z80_CACHE_HANDLER( prefix, number ) \
+  Z80_CACHE_HANDLER_ENTRY( prefix, number )
+#define Z80_CACHE_HANDLER_ENTRY( prefix, number ) \
+  [ Z80_CACHE_OFFSET_##prefix + number ] = \
+    &&Z80_CACHE_LABEL_NAME( prefix, number ),
+
+#endif			/* #ifndef FUSE_Z80_CACHE_H */
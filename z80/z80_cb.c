@@ -24,25 +24,34 @@
 /* NB: this file is autogenerated by './z80/z80.pl' from 'opcodes_cb.dat',
    and included in 'z80_ops.c' */
 
+#ifndef Z80_CACHE_HANDLERS_ONLY
+
     case 0x00:		/* RLC B */
+      Z80_CACHE_LABEL( cb, 0x00 )
       RLC(B);
       break;
     case 0x01:		/* RLC C */
+      Z80_CACHE_LABEL( cb, 0x01 )
       RLC(C);
       break;
     case 0x02:		/* RLC D */
+      Z80_CACHE_LABEL( cb, 0x02 )
       RLC(D);
       break;
     case 0x03:		/* RLC E */
+      Z80_CACHE_LABEL( cb, 0x03 )
       RLC(E);
       break;
     case 0x04:		/* RLC H */
+      Z80_CACHE_LABEL( cb, 0x04 )
       RLC(H);
       break;
     case 0x05:		/* RLC L */
+      Z80_CACHE_LABEL( cb, 0x05 )
       RLC(L);
       break;
     case 0x06:		/* RLC (HL) */
+      Z80_CACHE_LABEL( cb, 0x06 )
       {
 	libspectrum_byte bytetemp = readbyte(HL);
 	contend_read_no_mreq( HL, 1 );
@@ -51,27 +60,35 @@
       }
       break;
     case 0x07:		/* RLC A */
+      Z80_CACHE_LABEL( cb, 0x07 )
       RLC(A);
       break;
     case 0x08:		/* RRC B */
+      Z80_CACHE_LABEL( cb, 0x08 )
       RRC(B);
       break;
     case 0x09:		/* RRC C */
+      Z80_CACHE_LABEL( cb, 0x09 )
       RRC(C);
       break;
     case 0x0a:		/* RRC D */
+      Z80_CACHE_LABEL( cb, 0x0a )
       RRC(D);
       break;
     case 0x0b:		/* RRC E */
+      Z80_CACHE_LABEL( cb, 0x0b )
       RRC(E);
       break;
     case 0x0c:		/* RRC H */
+      Z80_CACHE_LABEL( cb, 0x0c )
       RRC(H);
       break;
     case 0x0d:		/* RRC L */
+      Z80_CACHE_LABEL( cb, 0x0d )
       RRC(L);
       break;
     case 0x0e:		/* RRC (HL) */
+      Z80_CACHE_LABEL( cb, 0x0e )
       {
 	libspectrum_byte bytetemp = readbyte(HL);
 	contend_read_no_mreq( HL, 1 );
@@ -80,27 +97,35 @@
       }
       break;
     case 0x0f:		/* RRC A */
+      Z80_CACHE_LABEL( cb, 0x0f )
       RRC(A);
       break;
     case 0x10:		/* RL B */
+      Z80_CACHE_LABEL( cb, 0x10 )
       RL(B);
       break;
     case 0x11:		/* RL C */
+      Z80_CACHE_LABEL( cb, 0x11 )
       RL(C);
       break;
     case 0x12:		/* RL D */
+      Z80_CACHE_LABEL( cb, 0x12 )
       RL(D);
       break;
     case 0x13:		/* RL E */
+      Z80_CACHE_LABEL( cb, 0x13 )
       RL(E);
       break;
     case 0x14:		/* RL H */
+      Z80_CACHE_LABEL( cb, 0x14 )
       RL(H);
       break;
     case 0x15:		/* RL L */
+      Z80_CACHE_LABEL( cb, 0x15 )
       RL(L);
       break;
     case 0x16:		/* RL (HL) */
+      Z80_CACHE_LABEL( cb, 0x16 )
       {
 	libspectrum_byte bytetemp = readbyte(HL);
 	contend_read_no_mreq( HL, 1 );
@@ -109,27 +134,35 @@
       }
       break;
     case 0x17:		/* RL A */
+      Z80_CACHE_LABEL( cb, 0x17 )
       RL(A);
       break;
     case 0x18:		/* RR B */
+      Z80_CACHE_LABEL( cb, 0x18 )
       RR(B);
       break;
     case 0x19:		/* RR C */
+      Z80_CACHE_LABEL( cb, 0x19 )
       RR(C);
       break;
     case 0x1a:		/* RR D */
+      Z80_CACHE_LABEL( cb, 0x1a )
       RR(D);
       break;
     case 0x1b:		/* RR E */
+      Z80_CACHE_LABEL( cb, 0x1b )
       RR(E);
       break;
     case 0x1c:		/* RR H */
+      Z80_CACHE_LABEL( cb, 0x1c )
       RR(H);
       break;
     case 0x1d:		/* RR L */
+      Z80_CACHE_LABEL( cb, 0x1d )
       RR(L);
       break;
     case 0x1e:		/* RR (HL) */
+      Z80_CACHE_LABEL( cb, 0x1e )
       {
 	libspectrum_byte bytetemp = readbyte(HL);
 	contend_read_no_mreq( HL, 1 );
@@ -138,27 +171,35 @@
       }
       break;
     case 0x1f:		/* RR A */
+      Z80_CACHE_LABEL( cb, 0x1f )
       RR(A);
       break;
     case 0x20:		/* SLA B */
+      Z80_CACHE_LABEL( cb, 0x20 )
       SLA(B);
       break;
     case 0x21:		/* SLA C */
+      Z80_CACHE_LABEL( cb, 0x21 )
       SLA(C);
       break;
     case 0x22:		/* SLA D */
+      Z80_CACHE_LABEL( cb, 0x22 )
       SLA(D);
       break;
     case 0x23:		/* SLA E */
+      Z80_CACHE_LABEL( cb, 0x23 )
       SLA(E);
       break;
     case 0x24:		/* SLA H */
+      Z80_CACHE_LABEL( cb, 0x24 )
       SLA(H);
       break;
     case 0x25:		/* SLA L */
+      Z80_CACHE_LABEL( cb, 0x25 )
       SLA(L);
       break;
     case 0x26:		/* SLA (HL) */
+      Z80_CACHE_LABEL( cb, 0x26 )
       {
 	libspectrum_byte bytetemp = readbyte(HL);
 	contend_read_no_mreq( HL, 1 );
@@ -167,27 +208,35 @@
       }
       break;
     case 0x27:		/* SLA A */
+      Z80_CACHE_LABEL( cb, 0x27 )
       SLA(A);
       break;
     case 0x28:		/* SRA B */
+      Z80_CACHE_LABEL( cb, 0x28 )
       SRA(B);
       break;
     case 0x29:		/* SRA C */
+      Z80_CACHE_LABEL( cb, 0x29 )
       SRA(C);
       break;
     case 0x2a:		/* SRA D */
+      Z80_CACHE_LABEL( cb, 0x2a )
       SRA(D);
       break;
     case 0x2b:		/* SRA E */
+      Z80_CACHE_LABEL( cb, 0x2b )
       SRA(E);
       break;
     case 0x2c:		/* SRA H */
+      Z80_CACHE_LABEL( cb, 0x2c )
       SRA(H);
       break;
     case 0x2d:		/* SRA L */
+      Z80_CACHE_LABEL( cb, 0x2d )
       SRA(L);
       break;
     case 0x2e:		/* SRA (HL) */
+      Z80_CACHE_LABEL( cb, 0x2e )
       {
 	libspectrum_byte bytetemp = readbyte(HL);
 	contend_read_no_mreq( HL, 1 );
@@ -196,27 +245,35 @@
       }
       break;
     case 0x2f:		/* SRA A */
+      Z80_CACHE_LABEL( cb, 0x2f )
       SRA(A);
       break;
     case 0x30:		/* SLL B */
+      Z80_CACHE_LABEL( cb, 0x30 )
       SLL(B);
       break;
     case 0x31:		/* SLL C */
+      Z80_CACHE_LABEL( cb, 0x31 )
       SLL(C);
       break;
     case 0x32:		/* SLL D */
+      Z80_CACHE_LABEL( cb, 0x32 )
       SLL(D);
       break;
     case 0x33:		/* SLL E */
+      Z80_CACHE_LABEL( cb, 0x33 )
       SLL(E);
       break;
     case 0x34:		/* SLL H */
+      Z80_CACHE_LABEL( cb, 0x34 )
       SLL(H);
       break;
     case 0x35:		/* SLL L */
+      Z80_CACHE_LABEL( cb, 0x35 )
       SLL(L);
       break;
     case 0x36:		/* SLL (HL) */
+      Z80_CACHE_LABEL( cb, 0x36 )
       {
 	libspectrum_byte bytetemp = readbyte(HL);
 	contend_read_no_mreq( HL, 1 );
@@ -225,27 +282,35 @@
       }
       break;
     case 0x37:		/* SLL A */
+      Z80_CACHE_LABEL( cb, 0x37 )
       SLL(A);
       break;
     case 0x38:		/* SRL B */
+      Z80_CACHE_LABEL( cb, 0x38 )
       SRL(B);
       break;
     case 0x39:		/* SRL C */
+      Z80_CACHE_LABEL( cb, 0x39 )
       SRL(C);
       break;
     case 0x3a:		/* SRL D */
+      Z80_CACHE_LABEL( cb, 0x3a )
       SRL(D);
       break;
     case 0x3b:		/* SRL E */
+      Z80_CACHE_LABEL( cb, 0x3b )
       SRL(E);
       break;
     case 0x3c:		/* SRL H */
+      Z80_CACHE_LABEL( cb, 0x3c )
       SRL(H);
       break;
     case 0x3d:		/* SRL L */
+      Z80_CACHE_LABEL( cb, 0x3d )
       SRL(L);
       break;
     case 0x3e:		/* SRL (HL) */
+      Z80_CACHE_LABEL( cb, 0x3e )
       {
 	libspectrum_byte bytetemp = readbyte(HL);
 	contend_read_no_mreq( HL, 1 );
@@ -254,27 +319,35 @@
       }
       break;
     case 0x3f:		/* SRL A */
+      Z80_CACHE_LABEL( cb, 0x3f )
       SRL(A);
       break;
     case 0x40:		/* BIT 0,B */
+      Z80_CACHE_LABEL( cb, 0x40 )
       BIT( 0, B );
       break;
     case 0x41:		/* BIT 0,C */
+      Z80_CACHE_LABEL( cb, 0x41 )
       BIT( 0, C );
       break;
     case 0x42:		/* BIT 0,D */
+      Z80_CACHE_LABEL( cb, 0x42 )
       BIT( 0, D );
       break;
     case 0x43:		/* BIT 0,E */
+      Z80_CACHE_LABEL( cb, 0x43 )
       BIT( 0, E );
       break;
     case 0x44:		/* BIT 0,H */
+      Z80_CACHE_LABEL( cb, 0x44 )
       BIT( 0, H );
       break;
     case 0x45:		/* BIT 0,L */
+      Z80_CACHE_LABEL( cb, 0x45 )
       BIT( 0, L );
       break;
     case 0x46:		/* BIT 0,(HL) */
+      Z80_CACHE_LABEL( cb, 0x46 )
       {
 	libspectrum_byte bytetemp = readbyte( HL );
 	contend_read_no_mreq( HL, 1 );
@@ -282,27 +355,35 @@
       }
       break;
     case 0x47:		/* BIT 0,A */
+      Z80_CACHE_LABEL( cb, 0x47 )
       BIT( 0, A );
       break;
     case 0x48:		/* BIT 1,B */
+      Z80_CACHE_LABEL( cb, 0x48 )
       BIT( 1, B );
       break;
     case 0x49:		/* BIT 1,C */
+      Z80_CACHE_LABEL( cb, 0x49 )
       BIT( 1, C );
       break;
     case 0x4a:		/* BIT 1,D */
+      Z80_CACHE_LABEL( cb, 0x4a )
       BIT( 1, D );
       break;
     case 0x4b:		/* BIT 1,E */
+      Z80_CACHE_LABEL( cb, 0x4b )
       BIT( 1, E );
       break;
     case 0x4c:		/* BIT 1,H */
+      Z80_CACHE_LABEL( cb, 0x4c )
       BIT( 1, H );
       break;
     case 0x4d:		/* BIT 1,L */
+      Z80_CACHE_LABEL( cb, 0x4d )
       BIT( 1, L );
       break;
     case 0x4e:		/* BIT 1,(HL) */
+      Z80_CACHE_LABEL( cb, 0x4e )
       {
 	libspectrum_byte bytetemp = readbyte( HL );
 	contend_read_no_mreq( HL, 1 );
@@ -310,27 +391,35 @@
       }
       break;
     case 0x4f:		/* BIT 1,A */
+      Z80_CACHE_LABEL( cb, 0x4f )
       BIT( 1, A );
       break;
     case 0x50:		/* BIT 2,B */
+      Z80_CACHE_LABEL( cb, 0x50 )
       BIT( 2, B );
       break;
     case 0x51:		/* BIT 2,C */
+      Z80_CACHE_LABEL( cb, 0x51 )
       BIT( 2, C );
       break;
     case 0x52:		/* BIT 2,D */
+      Z80_CACHE_LABEL( cb, 0x52 )
       BIT( 2, D );
       break;
     case 0x53:		/* BIT 2,E */
+      Z80_CACHE_LABEL( cb, 0x53 )
       BIT( 2, E );
       break;
     case 0x54:		/* BIT 2,H */
+      Z80_CACHE_LABEL( cb, 0x54 )
       BIT( 2, H );
       break;
     case 0x55:		/* BIT 2,L */
+      Z80_CACHE_LABEL( cb, 0x55 )
       BIT( 2, L );
       break;
     case 0x56:		/* BIT 2,(HL) */
+      Z80_CACHE_LABEL( cb, 0x56 )
       {
 	libspectrum_byte bytetemp = readbyte( HL );
 	contend_read_no_mreq( HL, 1 );
@@ -338,27 +427,35 @@
       }
       break;
     case 0x57:		/* BIT 2,A */
+      Z80_CACHE_LABEL( cb, 0x57 )
       BIT( 2, A );
       break;
     case 0x58:		/* BIT 3,B */
+      Z80_CACHE_LABEL( cb, 0x58 )
       BIT( 3, B );
       break;
     case 0x59:		/* BIT 3,C */
+      Z80_CACHE_LABEL( cb, 0x59 )
       BIT( 3, C );
       break;
     case 0x5a:		/* BIT 3,D */
+      Z80_CACHE_LABEL( cb, 0x5a )
       BIT( 3, D );
       break;
     case 0x5b:		/* BIT 3,E */
+      Z80_CACHE_LABEL( cb, 0x5b )
       BIT( 3, E );
       break;
     case 0x5c:		/* BIT 3,H */
+      Z80_CACHE_LABEL( cb, 0x5c )
       BIT( 3, H );
       break;
     case 0x5d:		/* BIT 3,L */
+      Z80_CACHE_LABEL( cb, 0x5d )
       BIT( 3, L );
       break;
     case 0x5e:		/* BIT 3,(HL) */
+      Z80_CACHE_LABEL( cb, 0x5e )
       {
 	libspectrum_byte bytetemp = readbyte( HL );
 	contend_read_no_mreq( HL, 1 );
@@ -366,27 +463,35 @@
       }
       break;
     case 0x5f:		/* BIT 3,A */
+      Z80_CACHE_LABEL( cb, 0x5f )
       BIT( 3, A );
       break;
     case 0x60:		/* BIT 4,B */
+      Z80_CACHE_LABEL( cb, 0x60 )
       BIT( 4, B );
       break;
     case 0x61:		/* BIT 4,C */
+      Z80_CACHE_LABEL( cb, 0x61 )
       BIT( 4, C );
       break;
     case 0x62:		/* BIT 4,D */
+      Z80_CACHE_LABEL( cb, 0x62 )
       BIT( 4, D );
       break;
     case 0x63:		/* BIT 4,E */
+      Z80_CACHE_LABEL( cb, 0x63 )
       BIT( 4, E );
       break;
     case 0x64:		/* BIT 4,H */
+      Z80_CACHE_LABEL( cb, 0x64 )
       BIT( 4, H );
       break;
     case 0x65:		/* BIT 4,L */
+      Z80_CACHE_LABEL( cb, 0x65 )
       BIT( 4, L );
       break;
     case 0x66:		/* BIT 4,(HL) */
+      Z80_CACHE_LABEL( cb, 0x66 )
       {
 	libspectrum_byte bytetemp = readbyte( HL );
 	contend_read_no_mreq( HL, 1 );
@@ -394,27 +499,35 @@
       }
       break;
     case 0x67:		/* BIT 4,A */
+      Z80_CACHE_LABEL( cb, 0x67 )
       BIT( 4, A );
       break;
     case 0x68:		/* BIT 5,B */
+      Z80_CACHE_LABEL( cb, 0x68 )
       BIT( 5, B );
       break;
     case 0x69:		/* BIT 5,C */
+      Z80_CACHE_LABEL( cb, 0x69 )
       BIT( 5, C );
       break;
     case 0x6a:		/* BIT 5,D */
+      Z80_CACHE_LABEL( cb, 0x6a )
       BIT( 5, D );
       break;
     case 0x6b:		/* BIT 5,E */
+      Z80_CACHE_LABEL( cb, 0x6b )
       BIT( 5, E );
       break;
     case 0x6c:		/* BIT 5,H */
+      Z80_CACHE_LABEL( cb, 0x6c )
       BIT( 5, H );
       break;
     case 0x6d:		/* BIT 5,L */
+      Z80_CACHE_LABEL( cb, 0x6d )
       BIT( 5, L );
       break;
     case 0x6e:		/* BIT 5,(HL) */
+      Z80_CACHE_LABEL( cb, 0x6e )
       {
 	libspectrum_byte bytetemp = readbyte( HL );
 	contend_read_no_mreq( HL, 1 );
@@ -422,27 +535,35 @@
       }
       break;
     case 0x6f:		/* BIT 5,A */
+      Z80_CACHE_LABEL( cb, 0x6f )
       BIT( 5, A );
       break;
     case 0x70:		/* BIT 6,B */
+      Z80_CACHE_LABEL( cb, 0x70 )
       BIT( 6, B );
       break;
     case 0x71:		/* BIT 6,C */
+      Z80_CACHE_LABEL( cb, 0x71 )
       BIT( 6, C );
       break;
     case 0x72:		/* BIT 6,D */
+      Z80_CACHE_LABEL( cb, 0x72 )
       BIT( 6, D );
       break;
     case 0x73:		/* BIT 6,E */
+      Z80_CACHE_LABEL( cb, 0x73 )
       BIT( 6, E );
       break;
     case 0x74:		/* BIT 6,H */
+      Z80_CACHE_LABEL( cb, 0x74 )
       BIT( 6, H );
       break;
     case 0x75:		/* BIT 6,L */
+      Z80_CACHE_LABEL( cb, 0x75 )
       BIT( 6, L );
       break;
     case 0x76:		/* BIT 6,(HL) */
+      Z80_CACHE_LABEL( cb, 0x76 )
       {
 	libspectrum_byte bytetemp = readbyte( HL );
 	contend_read_no_mreq( HL, 1 );
@@ -450,27 +571,35 @@
       }
       break;
     case 0x77:		/* BIT 6,A */
+      Z80_CACHE_LABEL( cb, 0x77 )
       BIT( 6, A );
       break;
     case 0x78:		/* BIT 7,B */
+      Z80_CACHE_LABEL( cb, 0x78 )
       BIT( 7, B );
       break;
     case 0x79:		/* BIT 7,C */
+      Z80_CACHE_LABEL( cb, 0x79 )
       BIT( 7, C );
       break;
     case 0x7a:		/* BIT 7,D */
+      Z80_CACHE_LABEL( cb, 0x7a )
       BIT( 7, D );
       break;
     case 0x7b:		/* BIT 7,E */
+      Z80_CACHE_LABEL( cb, 0x7b )
       BIT( 7, E );
       break;
     case 0x7c:		/* BIT 7,H */
+      Z80_CACHE_LABEL( cb, 0x7c )
       BIT( 7, H );
       break;
     case 0x7d:		/* BIT 7,L */
+      Z80_CACHE_LABEL( cb, 0x7d )
       BIT( 7, L );
       break;
     case 0x7e:		/* BIT 7,(HL) */
+      Z80_CACHE_LABEL( cb, 0x7e )
       {
 	libspectrum_byte bytetemp = readbyte( HL );
 	contend_read_no_mreq( HL, 1 );
@@ -478,27 +607,35 @@
       }
       break;
     case 0x7f:		/* BIT 7,A */
+      Z80_CACHE_LABEL( cb, 0x7f )
       BIT( 7, A );
       break;
     case 0x80:		/* RES 0,B */
+      Z80_CACHE_LABEL( cb, 0x80 )
       B &= 0xfe;
       break;
     case 0x81:		/* RES 0,C */
+      Z80_CACHE_LABEL( cb, 0x81 )
       C &= 0xfe;
       break;
     case 0x82:		/* RES 0,D */
+      Z80_CACHE_LABEL( cb, 0x82 )
       D &= 0xfe;
       break;
     case 0x83:		/* RES 0,E */
+      Z80_CACHE_LABEL( cb, 0x83 )
       E &= 0xfe;
       break;
     case 0x84:		/* RES 0,H */
+      Z80_CACHE_LABEL( cb, 0x84 )
       H &= 0xfe;
       break;
     case 0x85:		/* RES 0,L */
+      Z80_CACHE_LABEL( cb, 0x85 )
       L &= 0xfe;
       break;
     case 0x86:		/* RES 0,(HL) */
+      Z80_CACHE_LABEL( cb, 0x86 )
       {
 	libspectrum_byte bytetemp = readbyte( HL );
 	contend_read_no_mreq( HL, 1 );
@@ -506,27 +643,35 @@
       }
       break;
     case 0x87:		/* RES 0,A */
+      Z80_CACHE_LABEL( cb, 0x87 )
       A &= 0xfe;
       break;
     case 0x88:		/* RES 1,B */
+      Z80_CACHE_LABEL( cb, 0x88 )
       B &= 0xfd;
       break;
     case 0x89:		/* RES 1,C */
+      Z80_CACHE_LABEL( cb, 0x89 )
       C &= 0xfd;
       break;
     case 0x8a:		/* RES 1,D */
+      Z80_CACHE_LABEL( cb, 0x8a )
       D &= 0xfd;
       break;
     case 0x8b:		/* RES 1,E */
+      Z80_CACHE_LABEL( cb, 0x8b )
       E &= 0xfd;
       break;
     case 0x8c:		/* RES 1,H */
+      Z80_CACHE_LABEL( cb, 0x8c )
       H &= 0xfd;
       break;
     case 0x8d:		/* RES 1,L */
+      Z80_CACHE_LABEL( cb, 0x8d )
       L &= 0xfd;
       break;
     case 0x8e:		/* RES 1,(HL) */
+      Z80_CACHE_LABEL( cb, 0x8e )
       {
 	libspectrum_byte bytetemp = readbyte( HL );
 	contend_read_no_mreq( HL, 1 );
@@ -534,27 +679,35 @@
       }
       break;
     case 0x8f:		/* RES 1,A */
+      Z80_CACHE_LABEL( cb, 0x8f )
       A &= 0xfd;
       break;
     case 0x90:		/* RES 2,B */
+      Z80_CACHE_LABEL( cb, 0x90 )
       B &= 0xfb;
       break;
     case 0x91:		/* RES 2,C */
+      Z80_CACHE_LABEL( cb, 0x91 )
       C &= 0xfb;
       break;
     case 0x92:		/* RES 2,D */
+      Z80_CACHE_LABEL( cb, 0x92 )
       D &= 0xfb;
       break;
     case 0x93:		/* RES 2,E */
+      Z80_CACHE_LABEL( cb, 0x93 )
       E &= 0xfb;
       break;
     case 0x94:		/* RES 2,H */
+      Z80_CACHE_LABEL( cb, 0x94 )
       H &= 0xfb;
       break;
     case 0x95:		/* RES 2,L */
+      Z80_CACHE_LABEL( cb, 0x95 )
       L &= 0xfb;
       break;
     case 0x96:		/* RES 2,(HL) */
+      Z80_CACHE_LABEL( cb, 0x96 )
       {
 	libspectrum_byte bytetemp = readbyte( HL );
 	contend_read_no_mreq( HL, 1 );
@@ -562,27 +715,35 @@
       }
       break;
     case 0x97:		/* RES 2,A */
+      Z80_CACHE_LABEL( cb, 0x97 )
       A &= 0xfb;
       break;
     case 0x98:		/* RES 3,B */
+      Z80_CACHE_LABEL( cb, 0x98 )
       B &= 0xf7;
       break;
     case 0x99:		/* RES 3,C */
+      Z80_CACHE_LABEL( cb, 0x99 )
       C &= 0xf7;
       break;
     case 0x9a:		/* RES 3,D */
+      Z80_CACHE_LABEL( cb, 0x9a )
       D &= 0xf7;
       break;
     case 0x9b:		/* RES 3,E */
+      Z80_CACHE_LABEL( cb, 0x9b )
       E &= 0xf7;
       break;
     case 0x9c:		/* RES 3,H */
+      Z80_CACHE_LABEL( cb, 0x9c )
       H &= 0xf7;
       break;
     case 0x9d:		/* RES 3,L */
+      Z80_CACHE_LABEL( cb, 0x9d )
       L &= 0xf7;
       break;
     case 0x9e:		/* RES 3,(HL) */
+      Z80_CACHE_LABEL( cb, 0x9e )
       {
 	libspectrum_byte bytetemp = readbyte( HL );
 	contend_read_no_mreq( HL, 1 );
@@ -590,27 +751,35 @@
       }
       break;
     case 0x9f:		/* RES 3,A */
+      Z80_CACHE_LABEL( cb, 0x9f )
       A &= 0xf7;
       break;
     case 0xa0:		/* RES 4,B */
+      Z80_CACHE_LABEL( cb, 0xa0 )
       B &= 0xef;
       break;
     case 0xa1:		/* RES 4,C */
+      Z80_CACHE_LABEL( cb, 0xa1 )
       C &= 0xef;
       break;
     case 0xa2:		/* RES 4,D */
+      Z80_CACHE_LABEL( cb, 0xa2 )
       D &= 0xef;
       break;
     case 0xa3:		/* RES 4,E */
+      Z80_CACHE_LABEL( cb, 0xa3 )
       E &= 0xef;
       break;
     case 0xa4:		/* RES 4,H */
+      Z80_CACHE_LABEL( cb, 0xa4 )
       H &= 0xef;
       break;
     case 0xa5:		/* RES 4,L */
+      Z80_CACHE_LABEL( cb, 0xa5 )
       L &= 0xef;
       break;
     case 0xa6:		/* RES 4,(HL) */
+      Z80_CACHE_LABEL( cb, 0xa6 )
       {
 	libspectrum_byte bytetemp = readbyte( HL );
 	contend_read_no_mreq( HL, 1 );
@@ -618,27 +787,35 @@
       }
       break;
     case 0xa7:		/* RES 4,A */
+      Z80_CACHE_LABEL( cb, 0xa7 )
       A &= 0xef;
       break;
     case 0xa8:		/* RES 5,B */
+      Z80_CACHE_LABEL( cb, 0xa8 )
       B &= 0xdf;
       break;
     case 0xa9:		/* RES 5,C */
+      Z80_CACHE_LABEL( cb, 0xa9 )
       C &= 0xdf;
       break;
     case 0xaa:		/* RES 5,D */
+      Z80_CACHE_LABEL( cb, 0xaa )
       D &= 0xdf;
       break;
     case 0xab:		/* RES 5,E */
+      Z80_CACHE_LABEL( cb, 0xab )
       E &= 0xdf;
       break;
     case 0xac:		/* RES 5,H */
+      Z80_CACHE_LABEL( cb, 0xac )
       H &= 0xdf;
       break;
     case 0xad:		/* RES 5,L */
+      Z80_CACHE_LABEL( cb, 0xad )
       L &= 0xdf;
       break;
     case 0xae:		/* RES 5,(HL) */
+      Z80_CACHE_LABEL( cb, 0xae )
       {
 	libspectrum_byte bytetemp = readbyte( HL );
 	contend_read_no_mreq( HL, 1 );
@@ -646,27 +823,35 @@
       }
       break;
     case 0xaf:		/* RES 5,A */
+      Z80_CACHE_LABEL( cb, 0xaf )
       A &= 0xdf;
       break;
     case 0xb0:		/* RES 6,B */
+      Z80_CACHE_LABEL( cb, 0xb0 )
       B &= 0xbf;
       break;
     case 0xb1:		/* RES 6,C */
+      Z80_CACHE_LABEL( cb, 0xb1 )
       C &= 0xbf;
       break;
     case 0xb2:		/* RES 6,D */
+      Z80_CACHE_LABEL( cb, 0xb2 )
       D &= 0xbf;
       break;
     case 0xb3:		/* RES 6,E */
+      Z80_CACHE_LABEL( cb, 0xb3 )
       E &= 0xbf;
       break;
     case 0xb4:		/* RES 6,H */
+      Z80_CACHE_LABEL( cb, 0xb4 )
       H &= 0xbf;
       break;
     case 0xb5:		/* RES 6,L */
+      Z80_CACHE_LABEL( cb, 0xb5 )
       L &= 0xbf;
       break;
     case 0xb6:		/* RES 6,(HL) */
+      Z80_CACHE_LABEL( cb, 0xb6 )
       {
 	libspectrum_byte bytetemp = readbyte( HL );
 	contend_read_no_mreq( HL, 1 );
@@ -674,27 +859,35 @@
       }
       break;
     case 0xb7:		/* RES 6,A */
+      Z80_CACHE_LABEL( cb, 0xb7 )
       A &= 0xbf;
       break;
     case 0xb8:		/* RES 7,B */
+      Z80_CACHE_LABEL( cb, 0xb8 )
       B &= 0x7f;
       break;
     case 0xb9:		/* RES 7,C */
+      Z80_CACHE_LABEL( cb, 0xb9 )
       C &= 0x7f;
       break;
     case 0xba:		/* RES 7,D */
+      Z80_CACHE_LABEL( cb, 0xba )
       D &= 0x7f;
       break;
     case 0xbb:		/* RES 7,E */
+      Z80_CACHE_LABEL( cb, 0xbb )
       E &= 0x7f;
       break;
     case 0xbc:		/* RES 7,H */
+      Z80_CACHE_LABEL( cb, 0xbc )
       H &= 0x7f;
       break;
     case 0xbd:		/* RES 7,L */
+      Z80_CACHE_LABEL( cb, 0xbd )
       L &= 0x7f;
       break;
     case 0xbe:		/* RES 7,(HL) */
+      Z80_CACHE_LABEL( cb, 0xbe )
       {
 	libspectrum_byte bytetemp = readbyte( HL );
 	contend_read_no_mreq( HL, 1 );
@@ -702,27 +895,35 @@
       }
       break;
     case 0xbf:		/* RES 7,A */
+      Z80_CACHE_LABEL( cb, 0xbf )
       A &= 0x7f;
       break;
     case 0xc0:		/* SET 0,B */
+      Z80_CACHE_LABEL( cb, 0xc0 )
       B |= 0x01;
       break;
     case 0xc1:		/* SET 0,C */
+      Z80_CACHE_LABEL( cb, 0xc1 )
       C |= 0x01;
       break;
     case 0xc2:		/* SET 0,D */
+      Z80_CACHE_LABEL( cb, 0xc2 )
       D |= 0x01;
       break;
     case 0xc3:		/* SET 0,E */
+      Z80_CACHE_LABEL( cb, 0xc3 )
       E |= 0x01;
       break;
     case 0xc4:		/* SET 0,H */
+      Z80_CACHE_LABEL( cb, 0xc4 )
       H |= 0x01;
       break;
     case 0xc5:		/* SET 0,L */
+      Z80_CACHE_LABEL( cb, 0xc5 )
       L |= 0x01;
       break;
     case 0xc6:		/* SET 0,(HL) */
+      Z80_CACHE_LABEL( cb, 0xc6 )
       {
 	libspectrum_byte bytetemp = readbyte( HL );
 	contend_read_no_mreq( HL, 1 );
@@ -730,27 +931,35 @@
       }
       break;
     case 0xc7:		/* SET 0,A */
+      Z80_CACHE_LABEL( cb, 0xc7 )
       A |= 0x01;
       break;
     case 0xc8:		/* SET 1,B */
+      Z80_CACHE_LABEL( cb, 0xc8 )
       B |= 0x02;
       break;
     case 0xc9:		/* SET 1,C */
+      Z80_CACHE_LABEL( cb, 0xc9 )
       C |= 0x02;
       break;
     case 0xca:		/* SET 1,D */
+      Z80_CACHE_LABEL( cb, 0xca )
       D |= 0x02;
       break;
     case 0xcb:		/* SET 1,E */
+      Z80_CACHE_LABEL( cb, 0xcb )
       E |= 0x02;
       break;
     case 0xcc:		/* SET 1,H */
+      Z80_CACHE_LABEL( cb, 0xcc )
       H |= 0x02;
       break;
     case 0xcd:		/* SET 1,L */
+      Z80_CACHE_LABEL( cb, 0xcd )
       L |= 0x02;
       break;
     case 0xce:		/* SET 1,(HL) */
+      Z80_CACHE_LABEL( cb, 0xce )
       {
 	libspectrum_byte bytetemp = readbyte( HL );
 	contend_read_no_mreq( HL, 1 );
@@ -758,27 +967,35 @@
       }
       break;
     case 0xcf:		/* SET 1,A */
+      Z80_CACHE_LABEL( cb, 0xcf )
       A |= 0x02;
       break;
     case 0xd0:		/* SET 2,B */
+      Z80_CACHE_LABEL( cb, 0xd0 )
       B |= 0x04;
       break;
     case 0xd1:		/* SET 2,C */
+      Z80_CACHE_LABEL( cb, 0xd1 )
       C |= 0x04;
       break;
     case 0xd2:		/* SET 2,D */
+      Z80_CACHE_LABEL( cb, 0xd2 )
       D |= 0x04;
       break;
     case 0xd3:		/* SET 2,E */
+      Z80_CACHE_LABEL( cb, 0xd3 )
       E |= 0x04;
       break;
     case 0xd4:		/* SET 2,H */
+      Z80_CACHE_LABEL( cb, 0xd4 )
       H |= 0x04;
       break;
     case 0xd5:		/* SET 2,L */
+      Z80_CACHE_LABEL( cb, 0xd5 )
       L |= 0x04;
       break;
     case 0xd6:		/* SET 2,(HL) */
+      Z80_CACHE_LABEL( cb, 0xd6 )
       {
 	libspectrum_byte bytetemp = readbyte( HL );
 	contend_read_no_mreq( HL, 1 );
@@ -786,27 +1003,35 @@
       }
       break;
     case 0xd7:		/* SET 2,A */
+      Z80_CACHE_LABEL( cb, 0xd7 )
       A |= 0x04;
       break;
     case 0xd8:		/* SET 3,B */
+      Z80_CACHE_LABEL( cb, 0xd8 )
       B |= 0x08;
       break;
     case 0xd9:		/* SET 3,C */
+      Z80_CACHE_LABEL( cb, 0xd9 )
       C |= 0x08;
       break;
     case 0xda:		/* SET 3,D */
+      Z80_CACHE_LABEL( cb, 0xda )
       D |= 0x08;
       break;
     case 0xdb:		/* SET 3,E */
+      Z80_CACHE_LABEL( cb, 0xdb )
       E |= 0x08;
       break;
     case 0xdc:		/* SET 3,H */
+      Z80_CACHE_LABEL( cb, 0xdc )
       H |= 0x08;
       break;
     case 0xdd:		/* SET 3,L */
+      Z80_CACHE_LABEL( cb, 0xdd )
       L |= 0x08;
       break;
     case 0xde:		/* SET 3,(HL) */
+      Z80_CACHE_LABEL( cb, 0xde )
       {
 	libspectrum_byte bytetemp = readbyte( HL );
 	contend_read_no_mreq( HL, 1 );
@@ -814,27 +1039,35 @@
       }
       break;
     case 0xdf:		/* SET 3,A */
+      Z80_CACHE_LABEL( cb, 0xdf )
       A |= 0x08;
       break;
     case 0xe0:		/* SET 4,B */
+      Z80_CACHE_LABEL( cb, 0xe0 )
       B |= 0x10;
       break;
     case 0xe1:		/* SET 4,C */
+      Z80_CACHE_LABEL( cb, 0xe1 )
       C |= 0x10;
       break;
     case 0xe2:		/* SET 4,D */
+      Z80_CACHE_LABEL( cb, 0xe2 )
       D |= 0x10;
       break;
     case 0xe3:		/* SET 4,E */
+      Z80_CACHE_LABEL( cb, 0xe3 )
       E |= 0x10;
       break;
     case 0xe4:		/* SET 4,H */
+      Z80_CACHE_LABEL( cb, 0xe4 )
       H |= 0x10;
       break;
     case 0xe5:		/* SET 4,L */
+      Z80_CACHE_LABEL( cb, 0xe5 )
       L |= 0x10;
       break;
     case 0xe6:		/* SET 4,(HL) */
+      Z80_CACHE_LABEL( cb, 0xe6 )
       {
 	libspectrum_byte bytetemp = readbyte( HL );
 	contend_read_no_mreq( HL, 1 );
@@ -842,27 +1075,35 @@
       }
       break;
     case 0xe7:		/* SET 4,A */
+      Z80_CACHE_LABEL( cb, 0xe7 )
       A |= 0x10;
       break;
     case 0xe8:		/* SET 5,B */
+      Z80_CACHE_LABEL( cb, 0xe8 )
       B |= 0x20;
       break;
     case 0xe9:		/* SET 5,C */
+      Z80_CACHE_LABEL( cb, 0xe9 )
       C |= 0x20;
       break;
     case 0xea:		/* SET 5,D */
+      Z80_CACHE_LABEL( cb, 0xea )
       D |= 0x20;
       break;
     case 0xeb:		/* SET 5,E */
+      Z80_CACHE_LABEL( cb, 0xeb )
       E |= 0x20;
       break;
     case 0xec:		/* SET 5,H */
+      Z80_CACHE_LABEL( cb, 0xec )
       H |= 0x20;
       break;
     case 0xed:		/* SET 5,L */
+      Z80_CACHE_LABEL( cb, 0xed )
       L |= 0x20;
       break;
     case 0xee:		/* SET 5,(HL) */
+      Z80_CACHE_LABEL( cb, 0xee )
       {
 	libspectrum_byte bytetemp = readbyte( HL );
 	contend_read_no_mreq( HL, 1 );
@@ -870,27 +1111,35 @@
       }
       break;
     case 0xef:		/* SET 5,A */
+      Z80_CACHE_LABEL( cb, 0xef )
       A |= 0x20;
       break;
     case 0xf0:		/* SET 6,B */
+      Z80_CACHE_LABEL( cb, 0xf0 )
       B |= 0x40;
       break;
     case 0xf1:		/* SET 6,C */
+      Z80_CACHE_LABEL( cb, 0xf1 )
       C |= 0x40;
       break;
     case 0xf2:		/* SET 6,D */
+      Z80_CACHE_LABEL( cb, 0xf2 )
       D |= 0x40;
       break;
     case 0xf3:		/* SET 6,E */
+      Z80_CACHE_LABEL( cb, 0xf3 )
       E |= 0x40;
       break;
     case 0xf4:		/* SET 6,H */
+      Z80_CACHE_LABEL( cb, 0xf4 )
       H |= 0x40;
       break;
     case 0xf5:		/* SET 6,L */
+      Z80_CACHE_LABEL( cb, 0xf5 )
       L |= 0x40;
       break;
     case 0xf6:		/* SET 6,(HL) */
+      Z80_CACHE_LABEL( cb, 0xf6 )
       {
 	libspectrum_byte bytetemp = readbyte( HL );
 	contend_read_no_mreq( HL, 1 );
@@ -898,27 +1147,35 @@
       }
       break;
     case 0xf7:		/* SET 6,A */
+      Z80_CACHE_LABEL( cb, 0xf7 )
       A |= 0x40;
       break;
     case 0xf8:		/* SET 7,B */
+      Z80_CACHE_LABEL( cb, 0xf8 )
       B |= 0x80;
       break;
     case 0xf9:		/* SET 7,C */
+      Z80_CACHE_LABEL( cb, 0xf9 )
       C |= 0x80;
       break;
     case 0xfa:		/* SET 7,D */
+      Z80_CACHE_LABEL( cb, 0xfa )
       D |= 0x80;
       break;
     case 0xfb:		/* SET 7,E */
+      Z80_CACHE_LABEL( cb, 0xfb )
       E |= 0x80;
       break;
     case 0xfc:		/* SET 7,H */
+      Z80_CACHE_LABEL( cb, 0xfc )
       H |= 0x80;
       break;
     case 0xfd:		/* SET 7,L */
+      Z80_CACHE_LABEL( cb, 0xfd )
       L |= 0x80;
       break;
     case 0xfe:		/* SET 7,(HL) */
+      Z80_CACHE_LABEL( cb, 0xfe )
       {
 	libspectrum_byte bytetemp = readbyte( HL );
 	contend_read_no_mreq( HL, 1 );
@@ -926,5 +1183,267 @@
       }
       break;
     case 0xff:		/* SET 7,A */
+      Z80_CACHE_LABEL( cb, 0xff )
       A |= 0x80;
       break;
+
+#else			/* #ifndef Z80_CACHE_HANDLERS_ONLY */
+
+Z80_CACHE_HANDLER( cb, 0x00 )
+Z80_CACHE_HANDLER( cb, 0x01 )
+Z80_CACHE_HANDLER( cb, 0x02 )
+Z80_CACHE_HANDLER( cb, 0x03 )
+Z80_CACHE_HANDLER( cb, 0x04 )
+Z80_CACHE_HANDLER( cb, 0x05 )
+Z80_CACHE_HANDLER( cb, 0x06 )
+Z80_CACHE_HANDLER( cb, 0x07 )
+Z80_CACHE_HANDLER( cb, 0x08 )
+Z80_CACHE_HANDLER( cb, 0x09 )
+Z80_CACHE_HANDLER( cb, 0x0a )
+Z80_CACHE_HANDLER( cb, 0x0b )
+Z80_CACHE_HANDLER( cb, 0x0c )
+Z80_CACHE_HANDLER( cb, 0x0d )
+Z80_CACHE_HANDLER( cb, 0x0e )
+Z80_CACHE_HANDLER( cb, 0x0f )
+Z80_CACHE_HANDLER( cb, 0x10 )
+Z80_CACHE_HANDLER( cb, 0x11 )
+Z80_CACHE_HANDLER( cb, 0x12 )
+Z80_CACHE_HANDLER( cb, 0x13 )
+Z80_CACHE_HANDLER( cb, 0x14 )
+Z80_CACHE_HANDLER( cb, 0x15 )
+Z80_CACHE_HANDLER( cb, 0x16 )
+Z80_CACHE_HANDLER( cb, 0x17 )
+Z80_CACHE_HANDLER( cb, 0x18 )
+Z80_CACHE_HANDLER( cb, 0x19 )
+Z80_CACHE_HANDLER( cb, 0x1a )
+Z80_CACHE_HANDLER( cb, 0x1b )
+Z80_CACHE_HANDLER( cb, 0x1c )
+Z80_CACHE_HANDLER( cb, 0x1d )
+Z80_CACHE_HANDLER( cb, 0x1e )
+Z80_CACHE_HANDLER( cb, 0x1f )
+Z80_CACHE_HANDLER( cb, 0x20 )
+Z80_CACHE_HANDLER( cb, 0x21 )
+Z80_CACHE_HANDLER( cb, 0x22 )
+Z80_CACHE_HANDLER( cb, 0x23 )
+Z80_CACHE_HANDLER( cb, 0x24 )
+Z80_CACHE_HANDLER( cb, 0x25 )
+Z80_CACHE_HANDLER( cb, 0x26 )
+Z80_CACHE_HANDLER( cb, 0x27 )
+Z80_CACHE_HANDLER( cb, 0x28 )
+Z80_CACHE_HANDLER( cb, 0x29 )
+Z80_CACHE_HANDLER( cb, 0x2a )
+Z80_CACHE_HANDLER( cb, 0x2b )
+Z80_CACHE_HANDLER( cb, 0x2c )
+Z80_CACHE_HANDLER( cb, 0x2d )
+Z80_CACHE_HANDLER( cb, 0x2e )
+Z80_CACHE_HANDLER( cb, 0x2f )
+Z80_CACHE_HANDLER( cb, 0x30 )
+Z80_CACHE_HANDLER( cb, 0x31 )
+Z80_CACHE_HANDLER( cb, 0x32 )
+Z80_CACHE_HANDLER( cb, 0x33 )
+Z80_CACHE_HANDLER( cb, 0x34 )
+Z80_CACHE_HANDLER( cb, 0x35 )
+Z80_CACHE_HANDLER( cb, 0x36 )
+Z80_CACHE_HANDLER( cb, 0x37 )
+Z80_CACHE_HANDLER( cb, 0x38 )
+Z80_CACHE_HANDLER( cb, 0x39 )
+Z80_CACHE_HANDLER( cb, 0x3a )
+Z80_CACHE_HANDLER( cb, 0x3b )
+Z80_CACHE_HANDLER( cb, 0x3c )
+Z80_CACHE_HANDLER( cb, 0x3d )
+Z80_CACHE_HANDLER( cb, 0x3e )
+Z80_CACHE_HANDLER( cb, 0x3f )
+Z80_CACHE_HANDLER( cb, 0x40 )
+Z80_CACHE_HANDLER( cb, 0x41 )
+Z80_CACHE_HANDLER( cb, 0x42 )
+Z80_CACHE_HANDLER( cb, 0x43 )
+Z80_CACHE_HANDLER( cb, 0x44 )
+Z80_CACHE_HANDLER( cb, 0x45 )
+Z80_CACHE_HANDLER( cb, 0x46 )
+Z80_CACHE_HANDLER( cb, 0x47 )
+Z80_CACHE_HANDLER( cb, 0x48 )
+Z80_CACHE_HANDLER( cb, 0x49 )
+Z80_CACHE_HANDLER( cb, 0x4a )
+Z80_CACHE_HANDLER( cb, 0x4b )
+Z80_CACHE_HANDLER( cb, 0x4c )
+Z80_CACHE_HANDLER( cb, 0x4d )
+Z80_CACHE_HANDLER( cb, 0x4e )
+Z80_CACHE_HANDLER( cb, 0x4f )
+Z80_CACHE_HANDLER( cb, 0x50 )
+Z80_CACHE_HANDLER( cb, 0x51 )
+Z80_CACHE_HANDLER( cb, 0x52 )
+Z80_CACHE_HANDLER( cb, 0x53 )
+Z80_CACHE_HANDLER( cb, 0x54 )
+Z80_CACHE_HANDLER( cb, 0x55 )
+Z80_CACHE_HANDLER( cb, 0x56 )
+Z80_CACHE_HANDLER( cb, 0x57 )
+Z80_CACHE_HANDLER( cb, 0x58 )
+Z80_CACHE_HANDLER( cb, 0x59 )
+Z80_CACHE_HANDLER( cb, 0x5a )
+Z80_CACHE_HANDLER( cb, 0x5b )
+Z80_CACHE_HANDLER( cb, 0x5c )
+Z80_CACHE_HANDLER( cb, 0x5d )
+Z80_CACHE_HANDLER( cb, 0x5e )
+Z80_CACHE_HANDLER( cb, 0x5f )
+Z80_CACHE_HANDLER( cb, 0x60 )
+Z80_CACHE_HANDLER( cb, 0x61 )
+Z80_CACHE_HANDLER( cb, 0x62 )
+Z80_CACHE_HANDLER( cb, 0x63 )
+Z80_CACHE_HANDLER( cb, 0x64 )
+Z80_CACHE_HANDLER( cb, 0x65 )
+Z80_CACHE_HANDLER( cb, 0x66 )
+Z80_CACHE_HANDLER( cb, 0x67 )
+Z80_CACHE_HANDLER( cb, 0x68 )
+Z80_CACHE_HANDLER( cb, 0x69 )
+Z80_CACHE_HANDLER( cb, 0x6a )
+Z80_CACHE_HANDLER( cb, 0x6b )
+Z80_CACHE_HANDLER( cb, 0x6c )
+Z80_CACHE_HANDLER( cb, 0x6d )
+Z80_CACHE_HANDLER( cb, 0x6e )
+Z80_CACHE_HANDLER( cb, 0x6f )
+Z80_CACHE_HANDLER( cb, 0x70 )
+Z80_CACHE_HANDLER( cb, 0x71 )
+Z80_CACHE_HANDLER( cb, 0x72 )
+Z80_CACHE_HANDLER( cb, 0x73 )
+Z80_CACHE_HANDLER( cb, 0x74 )
+Z80_CACHE_HANDLER( cb, 0x75 )
+Z80_CACHE_HANDLER( cb, 0x76 )
+Z80_CACHE_HANDLER( cb, 0x77 )
+Z80_CACHE_HANDLER( cb, 0x78 )
+Z80_CACHE_HANDLER( cb, 0x79 )
+Z80_CACHE_HANDLER( cb, 0x7a )
+Z80_CACHE_HANDLER( cb, 0x7b )
+Z80_CACHE_HANDLER( cb, 0x7c )
+Z80_CACHE_HANDLER( cb, 0x7d )
+Z80_CACHE_HANDLER( cb, 0x7e )
+Z80_CACHE_HANDLER( cb, 0x7f )
+Z80_CACHE_HANDLER( cb, 0x80 )
+Z80_CACHE_HANDLER( cb, 0x81 )
+Z80_CACHE_HANDLER( cb, 0x82 )
+Z80_CACHE_HANDLER( cb, 0x83 )
+Z80_CACHE_HANDLER( cb, 0x84 )
+Z80_CACHE_HANDLER( cb, 0x85 )
+Z80_CACHE_HANDLER( cb, 0x86 )
+Z80_CACHE_HANDLER( cb, 0x87 )
+Z80_CACHE_HANDLER( cb, 0x88 )
+Z80_CACHE_HANDLER( cb, 0x89 )
+Z80_CACHE_HANDLER( cb, 0x8a )
+Z80_CACHE_HANDLER( cb, 0x8b )
+Z80_CACHE_HANDLER( cb, 0x8c )
+Z80_CACHE_HANDLER( cb, 0x8d )
+Z80_CACHE_HANDLER( cb, 0x8e )
+Z80_CACHE_HANDLER( cb, 0x8f )
+Z80_CACHE_HANDLER( cb, 0x90 )
+Z80_CACHE_HANDLER( cb, 0x91 )
+Z80_CACHE_HANDLER( cb, 0x92 )
+Z80_CACHE_HANDLER( cb, 0x93 )
+Z80_CACHE_HANDLER( cb, 0x94 )
+Z80_CACHE_HANDLER( cb, 0x95 )
+Z80_CACHE_HANDLER( cb, 0x96 )
+Z80_CACHE_HANDLER( cb, 0x97 )
+Z80_CACHE_HANDLER( cb, 0x98 )
+Z80_CACHE_HANDLER( cb, 0x99 )
+Z80_CACHE_HANDLER( cb, 0x9a )
+Z80_CACHE_HANDLER( cb, 0x9b )
+Z80_CACHE_HANDLER( cb, 0x9c )
+Z80_CACHE_HANDLER( cb, 0x9d )
+Z80_CACHE_HANDLER( cb, 0x9e )
+Z80_CACHE_HANDLER( cb, 0x9f )
+Z80_CACHE_HANDLER( cb, 0xa0 )
+Z80_CACHE_HANDLER( cb, 0xa1 )
+Z80_CACHE_HANDLER( cb, 0xa2 )
+Z80_CACHE_HANDLER( cb, 0xa3 )
+Z80_CACHE_HANDLER( cb, 0xa4 )
+Z80_CACHE_HANDLER( cb, 0xa5 )
+Z80_CACHE_HANDLER( cb, 0xa6 )
+Z80_CACHE_HANDLER( cb, 0xa7 )
+Z80_CACHE_HANDLER( cb, 0xa8 )
+Z80_CACHE_HANDLER( cb, 0xa9 )
+Z80_CACHE_HANDLER( cb, 0xaa )
+Z80_CACHE_HANDLER( cb, 0xab )
+Z80_CACHE_HANDLER( cb, 0xac )
+Z80_CACHE_HANDLER( cb, 0xad )
+Z80_CACHE_HANDLER( cb, 0xae )
+Z80_CACHE_HANDLER( cb, 0xaf )
+Z80_CACHE_HANDLER( cb, 0xb0 )
+Z80_CACHE_HANDLER( cb, 0xb1 )
+Z80_CACHE_HANDLER( cb, 0xb2 )
+Z80_CACHE_HANDLER( cb, 0xb3 )
+Z80_CACHE_HANDLER( cb, 0xb4 )
+Z80_CACHE_HANDLER( cb, 0xb5 )
+Z80_CACHE_HANDLER( cb, 0xb6 )
+Z80_CACHE_HANDLER( cb, 0xb7 )
+Z80_CACHE_HANDLER( cb, 0xb8 )
+Z80_CACHE_HANDLER( cb, 0xb9 )
+Z80_CACHE_HANDLER( cb, 0xba )
+Z80_CACHE_HANDLER( cb, 0xbb )
+Z80_CACHE_HANDLER( cb, 0xbc )
+Z80_CACHE_HANDLER( cb, 0xbd )
+Z80_CACHE_HANDLER( cb, 0xbe )
+Z80_CACHE_HANDLER( cb, 0xbf )
+Z80_CACHE_HANDLER( cb, 0xc0 )
+Z80_CACHE_HANDLER( cb, 0xc1 )
+Z80_CACHE_HANDLER( cb, 0xc2 )
+Z80_CACHE_HANDLER( cb, 0xc3 )
+Z80_CACHE_HANDLER( cb, 0xc4 )
+Z80_CACHE_HANDLER( cb, 0xc5 )
+Z80_CACHE_HANDLER( cb, 0xc6 )
+Z80_CACHE_HANDLER( cb, 0xc7 )
+Z80_CACHE_HANDLER( cb, 0xc8 )
+Z80_CACHE_HANDLER( cb, 0xc9 )
+Z80_CACHE_HANDLER( cb, 0xca )
+Z80_CACHE_HANDLER( cb, 0xcb )
+Z80_CACHE_HANDLER( cb, 0xcc )
+Z80_CACHE_HANDLER( cb, 0xcd )
+Z80_CACHE_HANDLER( cb, 0xce )
+Z80_CACHE_HANDLER( cb, 0xcf )
+Z80_CACHE_HANDLER( cb, 0xd0 )
+Z80_CACHE_HANDLER( cb, 0xd1 )
+Z80_CACHE_HANDLER( cb, 0xd2 )
+Z80_CACHE_HANDLER( cb, 0xd3 )
+Z80_CACHE_HANDLER( cb, 0xd4 )
+Z80_CACHE_HANDLER( cb, 0xd5 )
+Z80_CACHE_HANDLER( cb, 0xd6 )
+Z80_CACHE_HANDLER( cb, 0xd7 )
+Z80_CACHE_HANDLER( cb, 0xd8 )
+Z80_CACHE_HANDLER( cb, 0xd9 )
+Z80_CACHE_HANDLER( cb, 0xda )
+Z80_CACHE_HANDLER( cb, 0xdb )
+Z80_CACHE_HANDLER( cb, 0xdc )
+Z80_CACHE_HANDLER( cb, 0xdd )
+Z80_CACHE_HANDLER( cb, 0xde )
+Z80_CACHE_HANDLER( cb, 0xdf )
+Z80_CACHE_HANDLER( cb, 0xe0 )
+Z80_CACHE_HANDLER( cb, 0xe1 )
+Z80_CACHE_HANDLER( cb, 0xe2 )
+Z80_CACHE_HANDLER( cb, 0xe3 )
+Z80_CACHE_HANDLER( cb, 0xe4 )
+Z80_CACHE_HANDLER( cb, 0xe5 )
+Z80_CACHE_HANDLER( cb, 0xe6 )
+Z80_CACHE_HANDLER( cb, 0xe7 )
+Z80_CACHE_HANDLER( cb, 0xe8 )
+Z80_CACHE_HANDLER( cb, 0xe9 )
+Z80_CACHE_HANDLER( cb, 0xea )
+Z80_CACHE_HANDLER( cb, 0xeb )
+Z80_CACHE_HANDLER( cb, 0xec )
+Z80_CACHE_HANDLER( cb, 0xed )
+Z80_CACHE_HANDLER( cb, 0xee )
+Z80_CACHE_HANDLER( cb, 0xef )
+Z80_CACHE_HANDLER( cb, 0xf0 )
+Z80_CACHE_HANDLER( cb, 0xf1 )
+Z80_CACHE_HANDLER( cb, 0xf2 )
+Z80_CACHE_HANDLER( cb, 0xf3 )
+Z80_CACHE_HANDLER( cb, 0xf4 )
+Z80_CACHE_HANDLER( cb, 0xf5 )
+Z80_CACHE_HANDLER( cb, 0xf6 )
+Z80_CACHE_HANDLER( cb, 0xf7 )
+Z80_CACHE_HANDLER( cb, 0xf8 )
+Z80_CACHE_HANDLER( cb, 0xf9 )
+Z80_CACHE_HANDLER( cb, 0xfa )
+Z80_CACHE_HANDLER( cb, 0xfb )
+Z80_CACHE_HANDLER( cb, 0xfc )
+Z80_CACHE_HANDLER( cb, 0xfd )
+Z80_CACHE_HANDLER( cb, 0xfe )
+Z80_CACHE_HANDLER( cb, 0xff )
+
+#endif			/* #ifndef Z80_CACHE_HANDLERS_ONLY */
@@ -0,0 +1,408 @@
+/* z80_core.c: The main Z80 execution loop
+   Copyright (c) 1999-2005 Philip Kendall, Witold Filipczyk
+   Copyright (c) 2015 Stuart Brady
+   Copyright (c) 2015 Gergely Szasz
+   Copyright (c) 2015 Sergio Baldoví
+   Copyright (c) 2026 Fuse contributors
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+   Author contact information:
+
+   E-mail: philip-fuse@shadowmagic.org.uk
+
+*/
+
+/* This file is included by z80_ops.c once for each variant of the core,
+   with the following defined:
+
+   Z80_CORE_FUNCTION: the name of the function to define
+   Z80_CORE_CONTENDED: 0 if memory contention can be ignored
+   Z80_CORE_READBYTE, Z80_CORE_WRITEBYTE: if defined, used in place of
+     readbyte() and writebyte() for all data accesses
+   Z80_CORE_CACHE: if defined, the core can use the predecode cache
+*/
+
+#ifdef Z80_CORE_READBYTE
+#define readbyte Z80_CORE_READBYTE
+#endif
+
+#ifdef Z80_CORE_WRITEBYTE
+#define writebyte Z80_CORE_WRITEBYTE
+#endif
+
+#ifdef Z80_CORE_CACHE
+#undef Z80_CACHE_LABEL
+#define Z80_CACHE_LABEL( prefix, number ) \
+  Z80_CACHE_LABEL_NAME( prefix, number ):
+#define Z80_CORE_COUNT_CHECK active_checks++;
+#else				/* #ifdef Z80_CORE_CACHE */
+#define Z80_CORE_COUNT_CHECK
+#endif				/* #ifdef Z80_CORE_CACHE */
+
+/* Execute Z80 opcodes until the next event */
+static void
+Z80_CORE_FUNCTION( void )
+{
+#ifdef HAVE_ENOUGH_MEMORY
+  libspectrum_byte opcode = 0x00;
+#endif
+  libspectrum_word last_Q = 0;
+
+  int even_m1 =
+    machine_current->capabilities & LIBSPECTRUM_MACHINE_CAPABILITY_EVEN_M1; 
+
+#ifdef Z80_CORE_CACHE
+
+  /* Where the code for each entry in the predecode cache starts */
+  static const void * const cache_handlers[ Z80_CACHE_HANDLERS ] = {
+#define Z80_CACHE_HANDLERS_ONLY
+#include "z80/opcodes_base.c"
+#include "z80/z80_cb.c"
+#include "z80/z80_ed.c"
+#define Z80_CACHE_DDFD dd
+#include "z80/z80_ddfd.c"
+#undef Z80_CACHE_DDFD
+#define Z80_CACHE_DDFD fd
+#include "z80/z80_ddfd.c"
+#undef Z80_CACHE_DDFD
+#undef Z80_CACHE_HANDLERS_ONLY
+  };
+
+  int active_checks = 0, use_cache;
+
+#endif				/* #ifdef Z80_CORE_CACHE */
+
+#ifdef __GNUC__
+
+#undef SETUP_CHECK
+#define SETUP_CHECK( label, condition ) \
+  if( condition ) { \
+    cgoto[ next ] = &&label; next = pos_##label + 1; Z80_CORE_COUNT_CHECK \
+  } \
+  check++;
+
+#undef SETUP_NEXT
+#define SETUP_NEXT( label ) \
+  if( next != check ) { cgoto[ next ] = &&label; } \
+  next = check;
+
+  void *cgoto[ numchecks ]; size_t next = 0; size_t check = 0;
+
+#include "z80_checks.h"
+
+#endif				/* #ifdef __GNUC__ */
+
+#ifdef Z80_CORE_CACHE
+  /* The cache skips all the per-instruction checks, so can be used only
+     when none of them are needed */
+  use_cache = settings_current.predecode_cache && !active_checks;
+#endif				/* #ifdef Z80_CORE_CACHE */
+
+  while( tstates < event_next_event ) {
+
+#ifdef Z80_CORE_CACHE
+
+    if( use_cache ) {
+      int slot = PC >> MEMORY_PAGE_SIZE_LOGARITHM;
+      z80_cache_block *block = z80_cache_map[ slot ];
+      libspectrum_word entry;
+
+      if( block->data != memory_map_read_page[ slot ] )
+        block = z80_cache_map_slot( slot );
+
+      entry = block->entries[ PC & MEMORY_PAGE_SIZE_MASK ];
+
+      if( entry == Z80_CACHE_UNDECODED ) {
+        entry = z80_cache_decode( PC );
+        if( entry != Z80_CACHE_UNCACHEABLE && !cache_handlers[ entry ] )
+          entry = Z80_CACHE_UNCACHEABLE;
+        block->entries[ PC & MEMORY_PAGE_SIZE_MASK ] = entry;
+      }
+
+      /* Do exactly what the fetch and any prefix would have done, then
+         go straight to the code for the instruction */
+      if( entry != Z80_CACHE_UNCACHEABLE ) {
+        contend_read( PC, 4 );
+        Z80_CACHE_FETCHED( PC );
+        PC++; R++;
+        last_Q = Q;
+        Q = 0;
+
+        if( entry >= Z80_CACHE_OFFSET_cb ) {
+          contend_read( PC, 4 );
+          Z80_CACHE_FETCHED( PC );
+          PC++; R++;
+        }
+
+        goto *cache_handlers[ entry ];
+      }
+    }
+
+#endif				/* #ifdef Z80_CORE_CACHE */
+
+    /* Profiler */
+    CHECK( profile, profile_active )
+
+    profile_map( PC );
+
+    END_CHECK
+
+    /* Coverage for the fuzzer */
+    CHECK( fuzz, fuzz_active )
+
+    fuzz_coverage[ PC >> 3 ] |= 1 << ( PC & 0x07 );
+
+    END_CHECK
+
+    /* If we're due an end of frame from RZX playback, generate one */
+    CHECK( rzx, rzx_playback )
+
+    if( R + rzx_instructions_offset >= rzx_instruction_count ) {
+      event_add( tstates, spectrum_frame_event );
+      break;		/* And break out of the execution loop to let
+			   the interrupt happen */
+    }
+
+    END_CHECK
+
+    /* Check if the debugger should become active at this point */
+    CHECK( debugger, debugger_mode != DEBUGGER_MODE_INACTIVE )
+
+    /* Only instructions on pages with breakpoints need checking, unless
+       the debugger is to stop at the next one anyway */
+    if( ( debugger_mode == DEBUGGER_MODE_HALTED ||
+          memory_execute_watched( PC ) ) &&
+        debugger_check( DEBUGGER_BREAKPOINT_TYPE_EXECUTE, PC ) ) {
+      debugger_trap();
+
+#ifdef Z80_CORE_READBYTE
+      /* Any read or write breakpoints set while stopped need the full
+         core */
+      if( debugger_memory_watched ) break;
+#endif				/* #ifdef Z80_CORE_READBYTE */
+    }
+
+    END_CHECK
+
+    CHECK( beta, beta_available )
+
+#define NOT_128_TYPE_OR_IS_48_TYPE ( !( machine_current->capabilities & \
+            LIBSPECTRUM_MACHINE_CAPABILITY_128_MEMORY ) || \
+            machine_current->ram.current_rom )
+
+    if( beta_active ) {
+      if( NOT_128_TYPE_OR_IS_48_TYPE && PC >= 16384 ) {
+	beta_unpage();
+      }
+    } else if( ( PC & beta_pc_mask ) == beta_pc_value &&
+               NOT_128_TYPE_OR_IS_48_TYPE ) {
+      beta_page();
+    }
+
+    END_CHECK
+
+    CHECK( plusd, plusd_available )
+
+    if( PC == 0x0008 || PC == 0x003a || PC == 0x0066 || PC == 0x028e ) {
+      plusd_page();
+    }
+
+    END_CHECK
+
+    CHECK( didaktik80, didaktik80_available )
+
+    if( PC == 0x0000 || PC == 0x0008 ) {
+      didaktik80_page();
+    } else if( PC == 0x1700 ) {
+      didaktik80_unpage();
+    }
+
+    END_CHECK
+
+    CHECK( disciple, disciple_available )
+
+    if( PC == 0x0001 || PC == 0x0008 || PC == 0x0066 || PC == 0x028e ) {
+      disciple_page();
+    }
+
+    END_CHECK
+
+    CHECK( usource, usource_available )
+
+    if( PC == 0x2bae ) {
+      usource_toggle();
+    }
+
+    END_CHECK
+
+    CHECK( multiface, multiface_activated )
+
+    if( PC == 0x0066 ) {
+      multiface_setic8();
+    }
+
+    END_CHECK
+
+    CHECK( if1p, if1_available )
+
+    if( PC == 0x0008 || PC == 0x1708 ) {
+      if1_page();
+    }
+
+    END_CHECK
+
+    CHECK( divide_early, settings_current.divide_enabled )
+    
+    if( ( PC & 0xff00 ) == 0x3d00 ) {
+      divide_set_automap( 1 );
+    }
+    
+    END_CHECK
+
+    CHECK( divmmc_early, settings_current.divmmc_enabled )
+    
+    if( ( PC & 0xff00 ) == 0x3d00 ) {
+      divmmc_set_automap( 1 );
+    }
+    
+    END_CHECK
+
+    CHECK( spectranet_page, spectranet_available && !settings_current.spectranet_disable )
+
+    if( PC == 0x0008 || ((PC & 0xfff8) == 0x3ff8) )
+      spectranet_page( 0 );
+
+    if( PC == spectranet_programmable_trap &&
+      spectranet_programmable_trap_active )
+      event_add( 0, z80_nmi_event );
+
+    END_CHECK
+
+  opcode_delay:
+
+    contend_read( PC, 4 );
+
+    /* Check to see if M1 cycles happen on even tstates */
+    CHECK( evenm1, even_m1 )
+
+    if( tstates & 1 ) {
+      if( ++tstates == event_next_event ) {
+	break;
+      }
+    }
+
+    END_CHECK
+
+  run_opcode:
+    /* Do the instruction fetch; readbyte_internal used here to avoid
+       triggering read breakpoints */
+    opcode = readbyte_internal( PC );
+
+    CHECK( if1u, if1_available )
+
+    if( PC == 0x0700 ) {
+      if1_unpage();
+    }
+
+    END_CHECK
+
+    CHECK( divide_late, settings_current.divide_enabled )
+
+    if( ( PC & 0xfff8 ) == 0x1ff8 ) {
+      divide_set_automap( 0 );
+    } else if( (PC == 0x0000) || (PC == 0x0008) || (PC == 0x0038)
+      || (PC == 0x0066) || (PC == 0x04c6) || (PC == 0x0562) ) {
+      divide_set_automap( 1 );
+    }
+    
+    END_CHECK
+
+    CHECK( divmmc_late, settings_current.divmmc_enabled )
+
+    if( ( PC & 0xfff8 ) == 0x1ff8 ) {
+      divmmc_set_automap( 0 );
+    } else if( (PC == 0x0000) || (PC == 0x0008) || (PC == 0x0038)
+      || (PC == 0x0066) || (PC == 0x04c6) || (PC == 0x0562) ) {
+      divmmc_set_automap( 1 );
+    }
+    
+    END_CHECK
+
+    CHECK( opus, opus_available )
+
+    if( opus_active ) {
+      if( PC == 0x1748 ) {
+        opus_unpage();
+      }
+    } else if( PC == 0x0008 || PC == 0x0048 || PC == 0x1708 ) {
+      opus_page();
+    }
+
+    END_CHECK
+
+    CHECK( spectranet_unpage, spectranet_available )
+
+    if( PC == 0x007c )
+      spectranet_unpage();
+
+    END_CHECK
+
+    CHECK( z80_iff2_read, z80.iff2_read )
+
+    z80.iff2_read = 0;
+    /* Execute *one* instruction before reevaluating the checks */
+    event_add( tstates, z80_nmos_iff2_event );
+
+    END_CHECK
+
+    CHECK( didaktik80snap, didaktik80_snap )
+
+    if( PC == 0x0066 && !didaktik80_active ) {
+      opcode = 0xc7;	/* RST 00 */
+      didaktik80_snap = 0; /* FIXME: this should be a time-based reset */
+    }
+
+    END_CHECK
+
+    CHECK( svg_capture, svg_capture_active )
+
+    svg_capture();
+
+    END_CHECK
+
+  end_opcode:
+    PC++; R++;
+    last_Q = Q; /* keep Q value from previous opcode for SCF and CCF */
+    Q = 0;      /* preempt Q value assuming next opcode doesn't set flags */
+
+    switch(opcode) {
+#include "z80/opcodes_base.c"
+    }
+
+  }
+
+  /* Leave everything outside the core able to use F directly */
+  z80_flags_resolve();
+}
+
+#ifdef Z80_CORE_CACHE
+#undef Z80_CACHE_LABEL
+#define Z80_CACHE_LABEL( prefix, number )
+#endif				/* #ifdef Z80_CORE_CACHE */
+
+#undef Z80_CORE_COUNT_CHECK
+#undef readbyte
+#undef writebyte
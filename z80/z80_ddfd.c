@@ -24,7 +24,10 @@
 /* NB: this file is autogenerated by './z80/z80.pl' from 'opcodes_ddfd.dat',
    and included in 'z80_ops.c' */
 
+#ifndef Z80_CACHE_HANDLERS_ONLY
+
     case 0x09:		/* ADD REGISTER,BC */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x09 )
       contend_read_no_mreq( IR, 1 );
       contend_read_no_mreq( IR, 1 );
       contend_read_no_mreq( IR, 1 );
@@ -35,6 +38,7 @@
       ADD16(REGISTER,BC);
       break;
     case 0x19:		/* ADD REGISTER,DE */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x19 )
       contend_read_no_mreq( IR, 1 );
       contend_read_no_mreq( IR, 1 );
       contend_read_no_mreq( IR, 1 );
@@ -45,27 +49,34 @@
       ADD16(REGISTER,DE);
       break;
     case 0x21:		/* LD REGISTER,nnnn */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x21 )
       REGISTERL=readbyte(PC++);
       REGISTERH=readbyte(PC++);
       break;
     case 0x22:		/* LD (nnnn),REGISTER */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x22 )
       LD16_NNRR(REGISTERL,REGISTERH);
       break;
     case 0x23:		/* INC REGISTER */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x23 )
 	contend_read_no_mreq( IR, 1 );
 	contend_read_no_mreq( IR, 1 );
 	REGISTER++;
       break;
     case 0x24:		/* INC REGISTERH */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x24 )
       INC(REGISTERH);
       break;
     case 0x25:		/* DEC REGISTERH */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x25 )
       DEC(REGISTERH);
       break;
     case 0x26:		/* LD REGISTERH,nn */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x26 )
       REGISTERH = readbyte( PC++ );
       break;
     case 0x29:		/* ADD REGISTER,REGISTER */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x29 )
       contend_read_no_mreq( IR, 1 );
       contend_read_no_mreq( IR, 1 );
       contend_read_no_mreq( IR, 1 );
@@ -76,23 +87,29 @@
       ADD16(REGISTER,REGISTER);
       break;
     case 0x2a:		/* LD REGISTER,(nnnn) */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x2a )
       LD16_RRNN(REGISTERL,REGISTERH);
       break;
     case 0x2b:		/* DEC REGISTER */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x2b )
 	contend_read_no_mreq( IR, 1 );
 	contend_read_no_mreq( IR, 1 );
 	REGISTER--;
       break;
     case 0x2c:		/* INC REGISTERL */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x2c )
       INC(REGISTERL);
       break;
     case 0x2d:		/* DEC REGISTERL */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x2d )
       DEC(REGISTERL);
       break;
     case 0x2e:		/* LD REGISTERL,nn */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x2e )
       REGISTERL = readbyte( PC++ );
       break;
     case 0x34:		/* INC (REGISTER+dd) */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x34 )
       {
 	libspectrum_byte offset, bytetemp;
 	offset = readbyte( PC );
@@ -107,6 +124,7 @@
       }
       break;
     case 0x35:		/* DEC (REGISTER+dd) */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x35 )
       {
 	libspectrum_byte offset, bytetemp;
 	offset = readbyte( PC );
@@ -121,6 +139,7 @@
       }
       break;
     case 0x36:		/* LD (REGISTER+dd),nn */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x36 )
       {
 	libspectrum_byte offset, value;
 	offset = readbyte( PC++ );
@@ -131,6 +150,7 @@
       }
       break;
     case 0x39:		/* ADD REGISTER,SP */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x39 )
       contend_read_no_mreq( IR, 1 );
       contend_read_no_mreq( IR, 1 );
       contend_read_no_mreq( IR, 1 );
@@ -141,12 +161,15 @@
       ADD16(REGISTER,SP);
       break;
     case 0x44:		/* LD B,REGISTERH */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x44 )
       B=REGISTERH;
       break;
     case 0x45:		/* LD B,REGISTERL */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x45 )
       B=REGISTERL;
       break;
     case 0x46:		/* LD B,(REGISTER+dd) */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x46 )
       {
 	libspectrum_byte offset;
 	offset = readbyte( PC );
@@ -158,12 +181,15 @@
       }
       break;
     case 0x4c:		/* LD C,REGISTERH */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x4c )
       C=REGISTERH;
       break;
     case 0x4d:		/* LD C,REGISTERL */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x4d )
       C=REGISTERL;
       break;
     case 0x4e:		/* LD C,(REGISTER+dd) */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x4e )
       {
 	libspectrum_byte offset;
 	offset = readbyte( PC );
@@ -175,12 +201,15 @@
       }
       break;
     case 0x54:		/* LD D,REGISTERH */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x54 )
       D=REGISTERH;
       break;
     case 0x55:		/* LD D,REGISTERL */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x55 )
       D=REGISTERL;
       break;
     case 0x56:		/* LD D,(REGISTER+dd) */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x56 )
       {
 	libspectrum_byte offset;
 	offset = readbyte( PC );
@@ -192,12 +221,15 @@
       }
       break;
     case 0x5c:		/* LD E,REGISTERH */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x5c )
       E=REGISTERH;
       break;
     case 0x5d:		/* LD E,REGISTERL */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x5d )
       E=REGISTERL;
       break;
     case 0x5e:		/* LD E,(REGISTER+dd) */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x5e )
       {
 	libspectrum_byte offset;
 	offset = readbyte( PC );
@@ -209,23 +241,30 @@
       }
       break;
     case 0x60:		/* LD REGISTERH,B */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x60 )
       REGISTERH=B;
       break;
     case 0x61:		/* LD REGISTERH,C */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x61 )
       REGISTERH=C;
       break;
     case 0x62:		/* LD REGISTERH,D */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x62 )
       REGISTERH=D;
       break;
     case 0x63:		/* LD REGISTERH,E */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x63 )
       REGISTERH=E;
       break;
     case 0x64:		/* LD REGISTERH,REGISTERH */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x64 )
       break;
     case 0x65:		/* LD REGISTERH,REGISTERL */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x65 )
       REGISTERH=REGISTERL;
       break;
     case 0x66:		/* LD H,(REGISTER+dd) */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x66 )
       {
 	libspectrum_byte offset;
 	offset = readbyte( PC );
@@ -237,26 +276,34 @@
       }
       break;
     case 0x67:		/* LD REGISTERH,A */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x67 )
       REGISTERH=A;
       break;
     case 0x68:		/* LD REGISTERL,B */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x68 )
       REGISTERL=B;
       break;
     case 0x69:		/* LD REGISTERL,C */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x69 )
       REGISTERL=C;
       break;
     case 0x6a:		/* LD REGISTERL,D */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x6a )
       REGISTERL=D;
       break;
     case 0x6b:		/* LD REGISTERL,E */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x6b )
       REGISTERL=E;
       break;
     case 0x6c:		/* LD REGISTERL,REGISTERH */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x6c )
       REGISTERL=REGISTERH;
       break;
     case 0x6d:		/* LD REGISTERL,REGISTERL */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x6d )
       break;
     case 0x6e:		/* LD L,(REGISTER+dd) */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x6e )
       {
 	libspectrum_byte offset;
 	offset = readbyte( PC );
@@ -268,9 +315,11 @@
       }
       break;
     case 0x6f:		/* LD REGISTERL,A */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x6f )
       REGISTERL=A;
       break;
     case 0x70:		/* LD (REGISTER+dd),B */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x70 )
       {
 	libspectrum_byte offset;
 	offset = readbyte( PC );
@@ -282,6 +331,7 @@
       }
       break;
     case 0x71:		/* LD (REGISTER+dd),C */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x71 )
       {
 	libspectrum_byte offset;
 	offset = readbyte( PC );
@@ -293,6 +343,7 @@
       }
       break;
     case 0x72:		/* LD (REGISTER+dd),D */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x72 )
       {
 	libspectrum_byte offset;
 	offset = readbyte( PC );
@@ -304,6 +355,7 @@
       }
       break;
     case 0x73:		/* LD (REGISTER+dd),E */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x73 )
       {
 	libspectrum_byte offset;
 	offset = readbyte( PC );
@@ -315,6 +367,7 @@
       }
       break;
     case 0x74:		/* LD (REGISTER+dd),H */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x74 )
       {
 	libspectrum_byte offset;
 	offset = readbyte( PC );
@@ -326,6 +379,7 @@
       }
       break;
     case 0x75:		/* LD (REGISTER+dd),L */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x75 )
       {
 	libspectrum_byte offset;
 	offset = readbyte( PC );
@@ -337,6 +391,7 @@
       }
       break;
     case 0x77:		/* LD (REGISTER+dd),A */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x77 )
       {
 	libspectrum_byte offset;
 	offset = readbyte( PC );
@@ -348,12 +403,15 @@
       }
       break;
     case 0x7c:		/* LD A,REGISTERH */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x7c )
       A=REGISTERH;
       break;
     case 0x7d:		/* LD A,REGISTERL */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x7d )
       A=REGISTERL;
       break;
     case 0x7e:		/* LD A,(REGISTER+dd) */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x7e )
       {
 	libspectrum_byte offset;
 	offset = readbyte( PC );
@@ -365,12 +423,15 @@
       }
       break;
     case 0x84:		/* ADD A,REGISTERH */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x84 )
       ADD(REGISTERH);
       break;
     case 0x85:		/* ADD A,REGISTERL */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x85 )
       ADD(REGISTERL);
       break;
     case 0x86:		/* ADD A,(REGISTER+dd) */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x86 )
       {
 	libspectrum_byte offset, bytetemp;
 	offset = readbyte( PC );
@@ -383,12 +444,15 @@
       }
       break;
     case 0x8c:		/* ADC A,REGISTERH */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x8c )
       ADC(REGISTERH);
       break;
     case 0x8d:		/* ADC A,REGISTERL */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x8d )
       ADC(REGISTERL);
       break;
     case 0x8e:		/* ADC A,(REGISTER+dd) */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x8e )
       {
 	libspectrum_byte offset, bytetemp;
 	offset = readbyte( PC );
@@ -401,12 +465,15 @@
       }
       break;
     case 0x94:		/* SUB A,REGISTERH */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x94 )
       SUB(REGISTERH);
       break;
     case 0x95:		/* SUB A,REGISTERL */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x95 )
       SUB(REGISTERL);
       break;
     case 0x96:		/* SUB A,(REGISTER+dd) */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x96 )
       {
 	libspectrum_byte offset, bytetemp;
 	offset = readbyte( PC );
@@ -419,12 +486,15 @@
       }
       break;
     case 0x9c:		/* SBC A,REGISTERH */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x9c )
       SBC(REGISTERH);
       break;
     case 0x9d:		/* SBC A,REGISTERL */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x9d )
       SBC(REGISTERL);
       break;
     case 0x9e:		/* SBC A,(REGISTER+dd) */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0x9e )
       {
 	libspectrum_byte offset, bytetemp;
 	offset = readbyte( PC );
@@ -437,12 +507,15 @@
       }
       break;
     case 0xa4:		/* AND A,REGISTERH */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0xa4 )
       AND(REGISTERH);
       break;
     case 0xa5:		/* AND A,REGISTERL */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0xa5 )
       AND(REGISTERL);
       break;
     case 0xa6:		/* AND A,(REGISTER+dd) */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0xa6 )
       {
 	libspectrum_byte offset, bytetemp;
 	offset = readbyte( PC );
@@ -455,12 +528,15 @@
       }
       break;
     case 0xac:		/* XOR A,REGISTERH */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0xac )
       XOR(REGISTERH);
       break;
     case 0xad:		/* XOR A,REGISTERL */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0xad )
       XOR(REGISTERL);
       break;
     case 0xae:		/* XOR A,(REGISTER+dd) */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0xae )
       {
 	libspectrum_byte offset, bytetemp;
 	offset = readbyte( PC );
@@ -473,12 +549,15 @@
       }
       break;
     case 0xb4:		/* OR A,REGISTERH */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0xb4 )
       OR(REGISTERH);
       break;
     case 0xb5:		/* OR A,REGISTERL */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0xb5 )
       OR(REGISTERL);
       break;
     case 0xb6:		/* OR A,(REGISTER+dd) */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0xb6 )
       {
 	libspectrum_byte offset, bytetemp;
 	offset = readbyte( PC );
@@ -491,12 +570,15 @@
       }
       break;
     case 0xbc:		/* CP A,REGISTERH */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0xbc )
       CP(REGISTERH);
       break;
     case 0xbd:		/* CP A,REGISTERL */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0xbd )
       CP(REGISTERL);
       break;
     case 0xbe:		/* CP A,(REGISTER+dd) */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0xbe )
       {
 	libspectrum_byte offset, bytetemp;
 	offset = readbyte( PC );
@@ -509,6 +591,7 @@
       }
       break;
     case 0xcb:		/* shift DDFDCB */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0xcb )
       {
 	libspectrum_byte opcode3;
 	contend_read( PC, 3 );
@@ -527,9 +610,11 @@
       }
       break;
     case 0xe1:		/* POP REGISTER */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0xe1 )
       POP16(REGISTERL,REGISTERH);
       break;
     case 0xe3:		/* EX (SP),REGISTER */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0xe3 )
       {
 	libspectrum_byte bytetempl, bytetemph;
 	bytetempl = readbyte( SP );
@@ -542,13 +627,16 @@
       }
       break;
     case 0xe5:		/* PUSH REGISTER */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0xe5 )
       contend_read_no_mreq( IR, 1 );
       PUSH16(REGISTERL,REGISTERH);
       break;
     case 0xe9:		/* JP REGISTER */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0xe9 )
       PC=REGISTER;		/* NB: NOT INDIRECT! */
       break;
     case 0xf9:		/* LD SP,REGISTER */
+      Z80_CACHE_LABEL( Z80_CACHE_DDFD, 0xf9 )
       contend_read_no_mreq( IR, 1 );
       contend_read_no_mreq( IR, 1 );
       SP = REGISTER;
@@ -563,3 +651,94 @@
 #else			/* #ifdef HAVE_ENOUGH_MEMORY */
       return 1;
 #endif			/* #ifdef HAVE_ENOUGH_MEMORY */
+
+#else			/* #ifndef Z80_CACHE_HANDLERS_ONLY */
+
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x09 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x19 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x21 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x22 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x23 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x24 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x25 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x26 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x29 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x2a )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x2b )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x2c )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x2d )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x2e )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x34 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x35 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x36 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x39 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x44 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x45 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x46 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x4c )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x4d )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x4e )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x54 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x55 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x56 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x5c )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x5d )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x5e )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x60 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x61 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x62 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x63 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x64 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x65 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x66 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x67 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x68 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x69 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x6a )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x6b )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x6c )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x6d )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x6e )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x6f )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x70 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x71 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x72 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x73 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x74 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x75 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x77 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x7c )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x7d )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x7e )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x84 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x85 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x86 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x8c )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x8d )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x8e )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x94 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x95 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x96 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x9c )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x9d )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0x9e )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0xa4 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0xa5 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0xa6 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0xac )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0xad )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0xae )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0xb4 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0xb5 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0xb6 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0xbc )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0xbd )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0xbe )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0xcb )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0xe1 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0xe3 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0xe5 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0xe9 )
+Z80_CACHE_HANDLER( Z80_CACHE_DDFD, 0xf9 )
+
+#endif			/* #ifndef Z80_CACHE_HANDLERS_ONLY */
@@ -124,7 +124,18 @@ DEBUGGER_CALLBACKS(IY)
 
 DEBUGGER_CALLBACKS(I)
 
-DEBUGGER_CALLBACKS(Q)
+/* Q may just be marked as the same as F */
+static libspectrum_dword
+get_Q( void )
+{
+  return Q_VALUE( Q );
+}
+
+static void
+set_Q( libspectrum_dword value )
+{
+  Q = value & 0xff;
+}
 
 static libspectrum_dword
 get_R( void )
@@ -24,14 +24,19 @@
 /* NB: this file is autogenerated by './z80/z80.pl' from 'opcodes_ed.dat',
    and included in 'z80_ops.c' */
 
+#ifndef Z80_CACHE_HANDLERS_ONLY
+
     case 0x40:		/* IN B,(C) */
+      Z80_CACHE_LABEL( ed, 0x40 )
       Z80_IN( B, BC );
       break;
     case 0x41:		/* OUT (C),B */
+      Z80_CACHE_LABEL( ed, 0x41 )
       writeport( BC, B );
       z80.memptr.w = BC + 1;
       break;
     case 0x42:		/* SBC HL,BC */
+      Z80_CACHE_LABEL( ed, 0x42 )
       contend_read_no_mreq( IR, 1 );
       contend_read_no_mreq( IR, 1 );
       contend_read_no_mreq( IR, 1 );
@@ -42,16 +47,25 @@
       SBC16(BC);
       break;
     case 0x43:		/* LD (nnnn),BC */
+      Z80_CACHE_LABEL( ed, 0x43 )
       LD16_NNRR(C,B);
       break;
     case 0x44:
+      Z80_CACHE_LABEL( ed, 0x44 )
     case 0x4c:
+      Z80_CACHE_LABEL( ed, 0x4c )
     case 0x54:
+      Z80_CACHE_LABEL( ed, 0x54 )
     case 0x5c:
+      Z80_CACHE_LABEL( ed, 0x5c )
     case 0x64:
+      Z80_CACHE_LABEL( ed, 0x64 )
     case 0x6c:
+      Z80_CACHE_LABEL( ed, 0x6c )
     case 0x74:
+      Z80_CACHE_LABEL( ed, 0x74 )
     case 0x7c:		/* NEG */
+      Z80_CACHE_LABEL( ed, 0x7c )
       {
 	libspectrum_byte bytetemp=A;
 	A=0;
@@ -59,35 +73,51 @@
       }
       break;
     case 0x45:
+      Z80_CACHE_LABEL( ed, 0x45 )
     case 0x4d:
+      Z80_CACHE_LABEL( ed, 0x4d )
     case 0x55:
+      Z80_CACHE_LABEL( ed, 0x55 )
     case 0x5d:
+      Z80_CACHE_LABEL( ed, 0x5d )
     case 0x65:
+      Z80_CACHE_LABEL( ed, 0x65 )
     case 0x6d:
+      Z80_CACHE_LABEL( ed, 0x6d )
     case 0x75:
+      Z80_CACHE_LABEL( ed, 0x75 )
     case 0x7d:		/* RETN */
+      Z80_CACHE_LABEL( ed, 0x7d )
       IFF1=IFF2;
       RET();
       z80_retn();
       break;
     case 0x46:
+      Z80_CACHE_LABEL( ed, 0x46 )
     case 0x4e:
+      Z80_CACHE_LABEL( ed, 0x4e )
     case 0x66:
+      Z80_CACHE_LABEL( ed, 0x66 )
     case 0x6e:		/* IM 0 */
+      Z80_CACHE_LABEL( ed, 0x6e )
       IM=0;
       break;
     case 0x47:		/* LD I,A */
+      Z80_CACHE_LABEL( ed, 0x47 )
       contend_read_no_mreq( IR, 1 );
       I=A;
       break;
     case 0x48:		/* IN C,(C) */
+      Z80_CACHE_LABEL( ed, 0x48 )
       Z80_IN( C, BC );
       break;
     case 0x49:		/* OUT (C),C */
+      Z80_CACHE_LABEL( ed, 0x49 )
       writeport( BC, C );
       z80.memptr.w = BC + 1;
       break;
     case 0x4a:		/* ADC HL,BC */
+      Z80_CACHE_LABEL( ed, 0x4a )
       contend_read_no_mreq( IR, 1 );
       contend_read_no_mreq( IR, 1 );
       contend_read_no_mreq( IR, 1 );
@@ -98,22 +128,27 @@
       ADC16(BC);
       break;
     case 0x4b:		/* LD BC,(nnnn) */
+      Z80_CACHE_LABEL( ed, 0x4b )
       LD16_RRNN(C,B);
       break;
     case 0x4f:		/* LD R,A */
+      Z80_CACHE_LABEL( ed, 0x4f )
       contend_read_no_mreq( IR, 1 );
       /* Keep the RZX instruction counter right */
       rzx_instructions_offset += ( R - A );
       R=R7=A;
       break;
     case 0x50:		/* IN D,(C) */
+      Z80_CACHE_LABEL( ed, 0x50 )
       Z80_IN( D, BC );
       break;
     case 0x51:		/* OUT (C),D */
+      Z80_CACHE_LABEL( ed, 0x51 )
       writeport( BC, D );
       z80.memptr.w = BC + 1;
       break;
     case 0x52:		/* SBC HL,DE */
+      Z80_CACHE_LABEL( ed, 0x52 )
       contend_read_no_mreq( IR, 1 );
       contend_read_no_mreq( IR, 1 );
       contend_read_no_mreq( IR, 1 );
@@ -124,13 +159,17 @@
       SBC16(DE);
       break;
     case 0x53:		/* LD (nnnn),DE */
+      Z80_CACHE_LABEL( ed, 0x53 )
       LD16_NNRR(E,D);
       break;
     case 0x56:
+      Z80_CACHE_LABEL( ed, 0x56 )
     case 0x76:		/* IM 1 */
+      Z80_CACHE_LABEL( ed, 0x76 )
       IM=1;
       break;
     case 0x57:		/* LD A,I */
+      Z80_CACHE_LABEL( ed, 0x57 )
       contend_read_no_mreq( IR, 1 );
       A=I;
       F = ( F & FLAG_C ) | sz53_table[A] | ( IFF2 ? FLAG_V : 0 );
@@ -139,13 +178,16 @@
       event_add( tstates, z80_nmos_iff2_event );
       break;
     case 0x58:		/* IN E,(C) */
+      Z80_CACHE_LABEL( ed, 0x58 )
       Z80_IN( E, BC );
       break;
     case 0x59:		/* OUT (C),E */
+      Z80_CACHE_LABEL( ed, 0x59 )
       writeport( BC, E );
       z80.memptr.w = BC + 1;
       break;
     case 0x5a:		/* ADC HL,DE */
+      Z80_CACHE_LABEL( ed, 0x5a )
       contend_read_no_mreq( IR, 1 );
       contend_read_no_mreq( IR, 1 );
       contend_read_no_mreq( IR, 1 );
@@ -156,13 +198,17 @@
       ADC16(DE);
       break;
     case 0x5b:		/* LD DE,(nnnn) */
+      Z80_CACHE_LABEL( ed, 0x5b )
       LD16_RRNN(E,D);
       break;
     case 0x5e:
+      Z80_CACHE_LABEL( ed, 0x5e )
     case 0x7e:		/* IM 2 */
+      Z80_CACHE_LABEL( ed, 0x7e )
       IM=2;
       break;
     case 0x5f:		/* LD A,R */
+      Z80_CACHE_LABEL( ed, 0x5f )
       contend_read_no_mreq( IR, 1 );
       A=(R&0x7f) | (R7&0x80);
       F = ( F & FLAG_C ) | sz53_table[A] | ( IFF2 ? FLAG_V : 0 );
@@ -171,13 +217,16 @@
       event_add( tstates, z80_nmos_iff2_event );
       break;
     case 0x60:		/* IN H,(C) */
+      Z80_CACHE_LABEL( ed, 0x60 )
       Z80_IN( H, BC );
       break;
     case 0x61:		/* OUT (C),H */
+      Z80_CACHE_LABEL( ed, 0x61 )
       writeport( BC, H );
       z80.memptr.w = BC + 1;
       break;
     case 0x62:		/* SBC HL,HL */
+      Z80_CACHE_LABEL( ed, 0x62 )
       contend_read_no_mreq( IR, 1 );
       contend_read_no_mreq( IR, 1 );
       contend_read_no_mreq( IR, 1 );
@@ -188,9 +237,11 @@
       SBC16(HL);
       break;
     case 0x63:		/* LD (nnnn),HL */
+      Z80_CACHE_LABEL( ed, 0x63 )
       LD16_NNRR(L,H);
       break;
     case 0x67:		/* RRD */
+      Z80_CACHE_LABEL( ed, 0x67 )
       {
 	libspectrum_byte bytetemp = readbyte( HL );
 	contend_read_no_mreq( HL, 1 ); contend_read_no_mreq( HL, 1 );
@@ -203,13 +254,16 @@
       }
       break;
     case 0x68:		/* IN L,(C) */
+      Z80_CACHE_LABEL( ed, 0x68 )
       Z80_IN( L, BC );
       break;
     case 0x69:		/* OUT (C),L */
+      Z80_CACHE_LABEL( ed, 0x69 )
       writeport( BC, L );
       z80.memptr.w = BC + 1;
       break;
     case 0x6a:		/* ADC HL,HL */
+      Z80_CACHE_LABEL( ed, 0x6a )
       contend_read_no_mreq( IR, 1 );
       contend_read_no_mreq( IR, 1 );
       contend_read_no_mreq( IR, 1 );
@@ -220,9 +274,11 @@
       ADC16(HL);
       break;
     case 0x6b:		/* LD HL,(nnnn) */
+      Z80_CACHE_LABEL( ed, 0x6b )
       LD16_RRNN(L,H);
       break;
     case 0x6f:		/* RLD */
+      Z80_CACHE_LABEL( ed, 0x6f )
       {
 	libspectrum_byte bytetemp = readbyte( HL );
 	contend_read_no_mreq( HL, 1 ); contend_read_no_mreq( HL, 1 );
@@ -235,16 +291,19 @@
       }
       break;
     case 0x70:		/* IN F,(C) */
+      Z80_CACHE_LABEL( ed, 0x70 )
       {
 	libspectrum_byte bytetemp;
 	Z80_IN( bytetemp, BC );
       }
       break;
     case 0x71:		/* OUT (C),0 */
+      Z80_CACHE_LABEL( ed, 0x71 )
       writeport( BC, IS_CMOS ? 0xff : 0 );
       z80.memptr.w = BC + 1;
       break;
     case 0x72:		/* SBC HL,SP */
+      Z80_CACHE_LABEL( ed, 0x72 )
       contend_read_no_mreq( IR, 1 );
       contend_read_no_mreq( IR, 1 );
       contend_read_no_mreq( IR, 1 );
@@ -255,16 +314,20 @@
       SBC16(SP);
       break;
     case 0x73:		/* LD (nnnn),SP */
+      Z80_CACHE_LABEL( ed, 0x73 )
       LD16_NNRR(SPL,SPH);
       break;
     case 0x78:		/* IN A,(C) */
+      Z80_CACHE_LABEL( ed, 0x78 )
       Z80_IN( A, BC );
       break;
     case 0x79:		/* OUT (C),A */
+      Z80_CACHE_LABEL( ed, 0x79 )
       writeport( BC, A );
       z80.memptr.w = BC + 1;
       break;
     case 0x7a:		/* ADC HL,SP */
+      Z80_CACHE_LABEL( ed, 0x7a )
       contend_read_no_mreq( IR, 1 );
       contend_read_no_mreq( IR, 1 );
       contend_read_no_mreq( IR, 1 );
@@ -275,9 +338,11 @@
       ADC16(SP);
       break;
     case 0x7b:		/* LD SP,(nnnn) */
+      Z80_CACHE_LABEL( ed, 0x7b )
       LD16_RRNN(SPL,SPH);
       break;
     case 0xa0:		/* LDI */
+      Z80_CACHE_LABEL( ed, 0xa0 )
       {
 	libspectrum_byte bytetemp=readbyte( HL );
 	BC--;
@@ -291,6 +356,7 @@
       }
       break;
     case 0xa1:		/* CPI */
+      Z80_CACHE_LABEL( ed, 0xa1 )
       {
 	libspectrum_byte value = readbyte( HL ), bytetemp = A - value,
 	  lookup = ( (        A & 0x08 ) >> 3 ) |
@@ -310,6 +376,7 @@
       }
       break;
     case 0xa2:		/* INI */
+      Z80_CACHE_LABEL( ed, 0xa2 )
       {
 	libspectrum_byte initemp, initemp2;
 
@@ -328,6 +395,7 @@
       }
       break;
     case 0xa3:		/* OUTI */
+      Z80_CACHE_LABEL( ed, 0xa3 )
       {
 	libspectrum_byte outitemp, outitemp2;
 
@@ -347,6 +415,7 @@
       }
       break;
     case 0xa8:		/* LDD */
+      Z80_CACHE_LABEL( ed, 0xa8 )
       {
 	libspectrum_byte bytetemp=readbyte( HL );
 	BC--;
@@ -360,6 +429,7 @@
       }
       break;
     case 0xa9:		/* CPD */
+      Z80_CACHE_LABEL( ed, 0xa9 )
       {
 	libspectrum_byte value = readbyte( HL ), bytetemp = A - value,
 	  lookup = ( (        A & 0x08 ) >> 3 ) |
@@ -379,6 +449,7 @@
       }
       break;
     case 0xaa:		/* IND */
+      Z80_CACHE_LABEL( ed, 0xaa )
       {
 	libspectrum_byte initemp, initemp2;
 
@@ -397,6 +468,7 @@
       }
       break;
     case 0xab:		/* OUTD */
+      Z80_CACHE_LABEL( ed, 0xab )
       {
 	libspectrum_byte outitemp, outitemp2;
 
@@ -416,6 +488,7 @@
       }
       break;
     case 0xb0:		/* LDIR */
+      Z80_CACHE_LABEL( ed, 0xb0 )
       {
 	libspectrum_byte bytetemp=readbyte( HL );
 	writebyte(DE,bytetemp);
@@ -436,6 +509,7 @@
       }
       break;
     case 0xb1:		/* CPIR */
+      Z80_CACHE_LABEL( ed, 0xb1 )
       {
 	libspectrum_byte value = readbyte( HL ), bytetemp = A - value,
 	  lookup = ( (        A & 0x08 ) >> 3 ) |
@@ -464,6 +538,7 @@
       }
       break;
     case 0xb2:		/* INIR */
+      Z80_CACHE_LABEL( ed, 0xb2 )
       {
 	libspectrum_byte initemp, initemp2;
 
@@ -490,6 +565,7 @@
       }
       break;
     case 0xb3:		/* OTIR */
+      Z80_CACHE_LABEL( ed, 0xb3 )
       {
 	libspectrum_byte outitemp, outitemp2;
 
@@ -516,6 +592,7 @@
       }
       break;
     case 0xb8:		/* LDDR */
+      Z80_CACHE_LABEL( ed, 0xb8 )
       {
 	libspectrum_byte bytetemp=readbyte( HL );
 	writebyte(DE,bytetemp);
@@ -536,6 +613,7 @@
       }
       break;
     case 0xb9:		/* CPDR */
+      Z80_CACHE_LABEL( ed, 0xb9 )
       {
 	libspectrum_byte value = readbyte( HL ), bytetemp = A - value,
 	  lookup = ( (        A & 0x08 ) >> 3 ) |
@@ -564,6 +642,7 @@
       }
       break;
     case 0xba:		/* INDR */
+      Z80_CACHE_LABEL( ed, 0xba )
       {
 	libspectrum_byte initemp, initemp2;
 
@@ -590,6 +669,7 @@
       }
       break;
     case 0xbb:		/* OTDR */
+      Z80_CACHE_LABEL( ed, 0xbb )
       {
 	libspectrum_byte outitemp, outitemp2;
 
@@ -616,7 +696,92 @@
       }
       break;
     case 0xfb:		/* slttrap */
+      Z80_CACHE_LABEL( ed, 0xfb )
       slt_trap( HL, A );
       break;
     default:		/* All other opcodes are NOPD */
       break;
+
+#else			/* #ifndef Z80_CACHE_HANDLERS_ONLY */
+
+Z80_CACHE_HANDLER( ed, 0x40 )
+Z80_CACHE_HANDLER( ed, 0x41 )
+Z80_CACHE_HANDLER( ed, 0x42 )
+Z80_CACHE_HANDLER( ed, 0x43 )
+Z80_CACHE_HANDLER( ed, 0x44 )
+Z80_CACHE_HANDLER( ed, 0x4c )
+Z80_CACHE_HANDLER( ed, 0x54 )
+Z80_CACHE_HANDLER( ed, 0x5c )
+Z80_CACHE_HANDLER( ed, 0x64 )
+Z80_CACHE_HANDLER( ed, 0x6c )
+Z80_CACHE_HANDLER( ed, 0x74 )
+Z80_CACHE_HANDLER( ed, 0x7c )
+Z80_CACHE_HANDLER( ed, 0x45 )
+Z80_CACHE_HANDLER( ed, 0x4d )
+Z80_CACHE_HANDLER( ed, 0x55 )
+Z80_CACHE_HANDLER( ed, 0x5d )
+Z80_CACHE_HANDLER( ed, 0x65 )
+Z80_CACHE_HANDLER( ed, 0x6d )
+Z80_CACHE_HANDLER( ed, 0x75 )
+Z80_CACHE_HANDLER( ed, 0x7d )
+Z80_CACHE_HANDLER( ed, 0x46 )
+Z80_CACHE_HANDLER( ed, 0x4e )
+Z80_CACHE_HANDLER( ed, 0x66 )
+Z80_CACHE_HANDLER( ed, 0x6e )
+Z80_CACHE_HANDLER( ed, 0x47 )
+Z80_CACHE_HANDLER( ed, 0x48 )
+Z80_CACHE_HANDLER( ed, 0x49 )
+Z80_CACHE_HANDLER( ed, 0x4a )
+Z80_CACHE_HANDLER( ed, 0x4b )
+Z80_CACHE_HANDLER( ed, 0x4f )
+Z80_CACHE_HANDLER( ed, 0x50 )
+Z80_CACHE_HANDLER( ed, 0x51 )
+Z80_CACHE_HANDLER( ed, 0x52 )
+Z80_CACHE_HANDLER( ed, 0x53 )
+Z80_CACHE_HANDLER( ed, 0x56 )
+Z80_CACHE_HANDLER( ed, 0x76 )
+Z80_CACHE_HANDLER( ed, 0x57 )
+Z80_CACHE_HANDLER( ed, 0x58 )
+Z80_CACHE_HANDLER( ed, 0x59 )
+Z80_CACHE_HANDLER( ed, 0x5a )
+Z80_CACHE_HANDLER( ed, 0x5b )
+Z80_CACHE_HANDLER( ed, 0x5e )
+Z80_CACHE_HANDLER( ed, 0x7e )
+Z80_CACHE_HANDLER( ed, 0x5f )
+Z80_CACHE_HANDLER( ed, 0x60 )
+Z80_CACHE_HANDLER( ed, 0x61 )
+Z80_CACHE_HANDLER( ed, 0x62 )
+Z80_CACHE_HANDLER( ed, 0x63 )
+Z80_CACHE_HANDLER( ed, 0x67 )
+Z80_CACHE_HANDLER( ed, 0x68 )
+Z80_CACHE_HANDLER( ed, 0x69 )
+Z80_CACHE_HANDLER( ed, 0x6a )
+Z80_CACHE_HANDLER( ed, 0x6b )
+Z80_CACHE_HANDLER( ed, 0x6f )
+Z80_CACHE_HANDLER( ed, 0x70 )
+Z80_CACHE_HANDLER( ed, 0x71 )
+Z80_CACHE_HANDLER( ed, 0x72 )
+Z80_CACHE_HANDLER( ed, 0x73 )
+Z80_CACHE_HANDLER( ed, 0x78 )
+Z80_CACHE_HANDLER( ed, 0x79 )
+Z80_CACHE_HANDLER( ed, 0x7a )
+Z80_CACHE_HANDLER( ed, 0x7b )
+Z80_CACHE_HANDLER( ed, 0xa0 )
+Z80_CACHE_HANDLER( ed, 0xa1 )
+Z80_CACHE_HANDLER( ed, 0xa2 )
+Z80_CACHE_HANDLER( ed, 0xa3 )
+Z80_CACHE_HANDLER( ed, 0xa8 )
+Z80_CACHE_HANDLER( ed, 0xa9 )
+Z80_CACHE_HANDLER( ed, 0xaa )
+Z80_CACHE_HANDLER( ed, 0xab )
+Z80_CACHE_HANDLER( ed, 0xb0 )
+Z80_CACHE_HANDLER( ed, 0xb1 )
+Z80_CACHE_HANDLER( ed, 0xb2 )
+Z80_CACHE_HANDLER( ed, 0xb3 )
+Z80_CACHE_HANDLER( ed, 0xb8 )
+Z80_CACHE_HANDLER( ed, 0xb9 )
+Z80_CACHE_HANDLER( ed, 0xba )
+Z80_CACHE_HANDLER( ed, 0xbb )
+Z80_CACHE_HANDLER( ed, 0xfb )
+
+#endif			/* #ifndef Z80_CACHE_HANDLERS_ONLY */
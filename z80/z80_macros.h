@@ -27,8 +27,13 @@
 
 /* Macros used for accessing the registers */
 #define A   z80.af.b.h
-#define F   z80.af.b.l
-#define AF  z80.af.w
+#define F   Z80_F_RESOLVE( z80.af.b.l )
+#define AF  Z80_F_RESOLVE( z80.af.w )
+
+/* Any access to F works out the flags first if the last instruction to
+   set them left that until later */
+#define Z80_F_RESOLVE( reg ) \
+  ( *( z80.flags_op ? ( z80_flags_resolve(), &(reg) ) : &(reg) ) )
 
 #define B   z80.bc.b.h
 #define C   z80.bc.b.l
@@ -88,6 +93,12 @@
 
 #define Q z80.q
 
+/* The value Q is given by instructions which don't work out the flags
+   immediately: Q is then the same as F */
+#define Z80_Q_FLAGS 0x100
+
+#define Q_VALUE( q ) ( (q) == Z80_Q_FLAGS ? F : (q) )
+
 /* The flags */
 
 #define FLAG_C	0x01
@@ -100,24 +111,53 @@
 #define FLAG_Z	0x40
 #define FLAG_S	0x80
 
+/* Test the flags used by conditional instructions. The carry flag is
+   always kept up to date and the sign and zero flags come straight from
+   the result, so these don't need to work out all of F */
+#define IS_FLAG_C ( z80.af.b.l & FLAG_C )
+#define IS_FLAG_P ( F & FLAG_P )
+#define IS_FLAG_S \
+  ( z80.flags_op ? z80.flags_result & 0x80 : z80.af.b.l & FLAG_S )
+#define IS_FLAG_Z \
+  ( z80.flags_op ? !( z80.flags_result & 0xff ) : z80.af.b.l & FLAG_Z )
+
+/* Record what's needed to work out the flags later, setting only the
+   carry flag now */
+#define DEFER_FLAGS( op, result, carry ) \
+  z80.flags_op = (op); \
+  z80.flags_result = (result); \
+  z80.af.b.l = (carry); \
+  Q = Z80_Q_FLAGS;
+
+/* As above, for the instructions whose half carry and overflow flags
+   depend on the operands */
+#define DEFER_FLAGS_OPERANDS( op, first, second, result, carry ) \
+  z80.flags_a = (first); z80.flags_b = (second); \
+  DEFER_FLAGS( op, result, carry )
+
 /* Get the appropriate contended memory delay. Use a macro for performance
    reasons in the main core, but a function for flexibility when building
    the core tester */
 
 #ifndef CORETEST
 
+/* Z80_CORE_CONTENDED is redefined to 0 while building the core variant
+   for machines with no contention, which lets the compiler drop the
+   checks completely */
+#define Z80_CORE_CONTENDED 1
+
 #define contend_read(address,time) \
-  if( memory_map_read[ (address) >> MEMORY_PAGE_SIZE_LOGARITHM ].contended ) \
+  if( Z80_CORE_CONTENDED && memory_read_contended( address ) ) \
     tstates += ula_contention[ tstates ]; \
   tstates += (time);
 
 #define contend_read_no_mreq(address,time) \
-  if( memory_map_read[ (address) >> MEMORY_PAGE_SIZE_LOGARITHM ].contended ) \
+  if( Z80_CORE_CONTENDED && memory_read_contended( address ) ) \
     tstates += ula_contention_no_mreq[ tstates ]; \
   tstates += (time);
 
 #define contend_write_no_mreq(address,time) \
-  if( memory_map_write[ (address) >> MEMORY_PAGE_SIZE_LOGARITHM ].contended ) \
+  if( Z80_CORE_CONTENDED && memory_write_contended( address ) ) \
     tstates += ula_contention_no_mreq[ tstates ]; \
   tstates += (time);
 
@@ -133,21 +173,14 @@ void contend_write_no_mreq( libspectrum_word address, libspectrum_dword time );
 #define AND(value)\
 {\
   A &= (value);\
-  F = FLAG_H | sz53p_table[A];\
-  Q = F;\
+  DEFER_FLAGS( Z80_FLAGS_AND, A, 0 );\
 }
 
 #define ADC(value)\
 {\
-  libspectrum_word adctemp = A + (value) + ( F & FLAG_C ); \
-  libspectrum_byte lookup = ( (       A & 0x88 ) >> 3 ) | \
-			    ( ( (value) & 0x88 ) >> 2 ) | \
-			    ( ( adctemp & 0x88 ) >> 1 );  \
+  libspectrum_word adctemp = A + (value) + IS_FLAG_C; \
+  DEFER_FLAGS_OPERANDS( Z80_FLAGS_ADD, A, (value), adctemp, adctemp >> 8 );\
   A=adctemp;\
-  F = ( adctemp & 0x100 ? FLAG_C : 0 ) |\
-    halfcarry_add_table[lookup & 0x07] | overflow_add_table[lookup >> 4] |\
-    sz53_table[A];\
-  Q = F;\
 }
 
 #define ADC16(value)\
@@ -169,14 +202,8 @@ void contend_write_no_mreq( libspectrum_word address, libspectrum_dword time );
 #define ADD(value)\
 {\
   libspectrum_word addtemp = A + (value); \
-  libspectrum_byte lookup = ( (       A & 0x88 ) >> 3 ) | \
-			    ( ( (value) & 0x88 ) >> 2 ) | \
-			    ( ( addtemp & 0x88 ) >> 1 );  \
+  DEFER_FLAGS_OPERANDS( Z80_FLAGS_ADD, A, (value), addtemp, addtemp >> 8 );\
   A=addtemp;\
-  F = ( addtemp & 0x100 ? FLAG_C : 0 ) |\
-    halfcarry_add_table[lookup & 0x07] | overflow_add_table[lookup >> 4] |\
-    sz53_table[A];\
-  Q = F;\
 }
 
 #define ADD16(value1,value2)\
@@ -222,15 +249,8 @@ void contend_write_no_mreq( libspectrum_word address, libspectrum_dword time );
 #define CP(value)\
 {\
   libspectrum_word cptemp = A - value; \
-  libspectrum_byte lookup = ( (       A & 0x88 ) >> 3 ) | \
-			    ( ( (value) & 0x88 ) >> 2 ) | \
-			    ( (  cptemp & 0x88 ) >> 1 );  \
-  F = ( cptemp & 0x100 ? FLAG_C : ( cptemp ? 0 : FLAG_Z ) ) | FLAG_N |\
-    halfcarry_sub_table[lookup & 0x07] |\
-    overflow_sub_table[lookup >> 4] |\
-    ( value & ( FLAG_3 | FLAG_5 ) ) |\
-    ( cptemp & FLAG_S );\
-  Q = F;\
+  DEFER_FLAGS_OPERANDS( Z80_FLAGS_CP, A, (value), cptemp,\
+                        ( cptemp >> 8 ) & FLAG_C );\
 }
 
 /* Macro for the {DD,FD} CB dd xx rotate/shift instructions */
@@ -245,10 +265,8 @@ break
 
 #define DEC(value)\
 {\
-  F = ( F & FLAG_C ) | ( (value)&0x0f ? 0 : FLAG_H ) | FLAG_N;\
   (value)--;\
-  F |= ( (value)==0x7f ? FLAG_V : 0 ) | sz53_table[value];\
-  Q = F;\
+  DEFER_FLAGS( Z80_FLAGS_DEC, (value), IS_FLAG_C );\
 }
 
 #define Z80_IN( reg, port )\
@@ -262,9 +280,7 @@ break
 #define INC(value)\
 {\
   (value)++;\
-  F = ( F & FLAG_C ) | ( (value)==0x80 ? FLAG_V : 0 ) |\
-  ( (value)&0x0f ? 0 : FLAG_H ) | sz53_table[(value)];\
-  Q = F;\
+  DEFER_FLAGS( Z80_FLAGS_INC, (value), IS_FLAG_C );\
 }
 
 #define LD16_NNRR(regl,regh)\
@@ -308,8 +324,7 @@ break
 #define OR(value)\
 {\
   A |= (value);\
-  F = sz53p_table[A];\
-  Q = F;\
+  DEFER_FLAGS( Z80_FLAGS_OR, A, 0 );\
 }
 
 #define POP16(regl,regh)\
@@ -370,15 +385,10 @@ break
 
 #define SBC(value)\
 {\
-  libspectrum_word sbctemp = A - (value) - ( F & FLAG_C ); \
-  libspectrum_byte lookup = ( (       A & 0x88 ) >> 3 ) | \
-			    ( ( (value) & 0x88 ) >> 2 ) | \
-			    ( ( sbctemp & 0x88 ) >> 1 );  \
+  libspectrum_word sbctemp = A - (value) - IS_FLAG_C; \
+  DEFER_FLAGS_OPERANDS( Z80_FLAGS_SUB, A, (value), sbctemp,\
+                        ( sbctemp >> 8 ) & FLAG_C );\
   A=sbctemp;\
-  F = ( sbctemp & 0x100 ? FLAG_C : 0 ) | FLAG_N |\
-    halfcarry_sub_table[lookup & 0x07] | overflow_sub_table[lookup >> 4] |\
-    sz53_table[A];\
-  Q = F;\
 }
 
 #define SBC16(value)\
@@ -432,21 +442,15 @@ break
 #define SUB(value)\
 {\
   libspectrum_word subtemp = A - (value); \
-  libspectrum_byte lookup = ( (       A & 0x88 ) >> 3 ) | \
-			    ( ( (value) & 0x88 ) >> 2 ) | \
-			    (  (subtemp & 0x88 ) >> 1 );  \
+  DEFER_FLAGS_OPERANDS( Z80_FLAGS_SUB, A, (value), subtemp,\
+                        ( subtemp >> 8 ) & FLAG_C );\
   A=subtemp;\
-  F = ( subtemp & 0x100 ? FLAG_C : 0 ) | FLAG_N |\
-    halfcarry_sub_table[lookup & 0x07] | overflow_sub_table[lookup >> 4] |\
-    sz53_table[A];\
-  Q = F;\
 }
 
 #define XOR(value)\
 {\
   A ^= (value);\
-  F = sz53p_table[A];\
-  Q = F;\
+  DEFER_FLAGS( Z80_FLAGS_OR, A, 0 );\
 }
 
 #endif		/* #ifndef FUSE_Z80_MACROS_H */
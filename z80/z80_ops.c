@@ -30,6 +30,7 @@
 
 #include "debugger/debugger.h"
 #include "event.h"
+#include "fuzz/fuzz.h"
 #include "machine.h"
 #include "memory_pages.h"
 #include "periph.h"
@@ -52,6 +53,7 @@
 #include "svg.h"
 #include "tape.h"
 #include "z80.h"
+#include "z80_cache.h"
 
 #include "z80_macros.h"
 
@@ -108,261 +110,242 @@ enum {
 static libspectrum_byte opcode = 0x00;
 #endif
 
-/* Execute Z80 opcodes until the next event */
+/* Which core to use when nothing needs to see individual memory
+   accesses; set by z80_select_core() */
+static z80_core_type machine_core = Z80_CORE_HOOKED;
+
+/* Work out the flags left by an instruction which recorded its operands
+   and result rather than doing so itself; called via the F macro */
 void
-z80_do_opcodes( void )
+z80_flags_resolve( void )
 {
-#ifdef HAVE_ENOUGH_MEMORY
-  libspectrum_byte opcode = 0x00;
-#endif
-  libspectrum_byte last_Q;
-
-  int even_m1 =
-    machine_current->capabilities & LIBSPECTRUM_MACHINE_CAPABILITY_EVEN_M1; 
-
-#ifdef __GNUC__
-
-#undef SETUP_CHECK
-#define SETUP_CHECK( label, condition ) \
-  if( condition ) { cgoto[ next ] = &&label; next = pos_##label + 1; } \
-  check++;
-
-#undef SETUP_NEXT
-#define SETUP_NEXT( label ) \
-  if( next != check ) { cgoto[ next ] = &&label; } \
-  next = check;
-
-  void *cgoto[ numchecks ]; size_t next = 0; size_t check = 0;
-
-#include "z80_checks.h"
-
-#endif				/* #ifdef __GNUC__ */
-
-  while( tstates < event_next_event ) {
-
-    /* Profiler */
-    CHECK( profile, profile_active )
-
-    profile_map( PC );
-
-    END_CHECK
-
-    /* If we're due an end of frame from RZX playback, generate one */
-    CHECK( rzx, rzx_playback )
-
-    if( R + rzx_instructions_offset >= rzx_instruction_count ) {
-      event_add( tstates, spectrum_frame_event );
-      break;		/* And break out of the execution loop to let
-			   the interrupt happen */
-    }
-
-    END_CHECK
-
-    /* Check if the debugger should become active at this point */
-    CHECK( debugger, debugger_mode != DEBUGGER_MODE_INACTIVE )
-
-    if( debugger_check( DEBUGGER_BREAKPOINT_TYPE_EXECUTE, PC ) )
-      debugger_trap();
-
-    END_CHECK
-
-    CHECK( beta, beta_available )
-
-#define NOT_128_TYPE_OR_IS_48_TYPE ( !( machine_current->capabilities & \
-            LIBSPECTRUM_MACHINE_CAPABILITY_128_MEMORY ) || \
-            machine_current->ram.current_rom )
-
-    if( beta_active ) {
-      if( NOT_128_TYPE_OR_IS_48_TYPE && PC >= 16384 ) {
-	beta_unpage();
-      }
-    } else if( ( PC & beta_pc_mask ) == beta_pc_value &&
-               NOT_128_TYPE_OR_IS_48_TYPE ) {
-      beta_page();
-    }
-
-    END_CHECK
-
-    CHECK( plusd, plusd_available )
-
-    if( PC == 0x0008 || PC == 0x003a || PC == 0x0066 || PC == 0x028e ) {
-      plusd_page();
-    }
-
-    END_CHECK
-
-    CHECK( didaktik80, didaktik80_available )
-
-    if( PC == 0x0000 || PC == 0x0008 ) {
-      didaktik80_page();
-    } else if( PC == 0x1700 ) {
-      didaktik80_unpage();
-    }
-
-    END_CHECK
-
-    CHECK( disciple, disciple_available )
-
-    if( PC == 0x0001 || PC == 0x0008 || PC == 0x0066 || PC == 0x028e ) {
-      disciple_page();
-    }
-
-    END_CHECK
-
-    CHECK( usource, usource_available )
-
-    if( PC == 0x2bae ) {
-      usource_toggle();
-    }
-
-    END_CHECK
+  libspectrum_byte result = z80.flags_result, flags, lookup;
 
-    CHECK( multiface, multiface_activated )
+  lookup = ( ( z80.flags_a & 0x88 ) >> 3 ) |
+           ( ( z80.flags_b & 0x88 ) >> 2 ) |
+           ( ( z80.flags_result & 0x88 ) >> 1 );
 
-    if( PC == 0x0066 ) {
-      multiface_setic8();
-    }
-
-    END_CHECK
-
-    CHECK( if1p, if1_available )
-
-    if( PC == 0x0008 || PC == 0x1708 ) {
-      if1_page();
-    }
-
-    END_CHECK
+  /* Only the carry flag is already in F */
+  flags = z80.af.b.l & FLAG_C;
 
-    CHECK( divide_early, settings_current.divide_enabled )
-    
-    if( ( PC & 0xff00 ) == 0x3d00 ) {
-      divide_set_automap( 1 );
-    }
-    
-    END_CHECK
-
-    CHECK( divmmc_early, settings_current.divmmc_enabled )
-    
-    if( ( PC & 0xff00 ) == 0x3d00 ) {
-      divmmc_set_automap( 1 );
-    }
-    
-    END_CHECK
+  switch( z80.flags_op ) {
 
-    CHECK( spectranet_page, spectranet_available && !settings_current.spectranet_disable )
+  case Z80_FLAGS_RESOLVED:
+    flags = z80.af.b.l;
+    break;
 
-    if( PC == 0x0008 || ((PC & 0xfff8) == 0x3ff8) )
-      spectranet_page( 0 );
+  case Z80_FLAGS_ADD:
+    flags |= halfcarry_add_table[ lookup & 0x07 ] |
+             overflow_add_table[ lookup >> 4 ] | sz53_table[ result ];
+    break;
 
-    if( PC == spectranet_programmable_trap &&
-      spectranet_programmable_trap_active )
-      event_add( 0, z80_nmi_event );
+  case Z80_FLAGS_SUB:
+    flags |= FLAG_N | halfcarry_sub_table[ lookup & 0x07 ] |
+             overflow_sub_table[ lookup >> 4 ] | sz53_table[ result ];
+    break;
 
-    END_CHECK
+  case Z80_FLAGS_CP:
+    /* The undocumented flags come from the operand, not the result */
+    flags |= ( result ? 0 : FLAG_Z ) | FLAG_N |
+             halfcarry_sub_table[ lookup & 0x07 ] |
+             overflow_sub_table[ lookup >> 4 ] |
+             ( z80.flags_b & ( FLAG_3 | FLAG_5 ) ) | ( result & FLAG_S );
+    break;
 
-  opcode_delay:
+  case Z80_FLAGS_AND:
+    flags |= FLAG_H | sz53p_table[ result ];
+    break;
 
-    contend_read( PC, 4 );
+  case Z80_FLAGS_OR:
+    flags |= sz53p_table[ result ];
+    break;
 
-    /* Check to see if M1 cycles happen on even tstates */
-    CHECK( evenm1, even_m1 )
+  case Z80_FLAGS_INC:
+    flags |= ( result == 0x80 ? FLAG_V : 0 ) |
+             ( result & 0x0f ? 0 : FLAG_H ) | sz53_table[ result ];
+    break;
 
-    if( tstates & 1 ) {
-      if( ++tstates == event_next_event ) {
-	break;
-      }
-    }
+  case Z80_FLAGS_DEC:
+    flags |= ( ( result & 0x0f ) == 0x0f ? FLAG_H : 0 ) | FLAG_N |
+             ( result == 0x7f ? FLAG_V : 0 ) | sz53_table[ result ];
+    break;
 
-    END_CHECK
+  }
 
-  run_opcode:
-    /* Do the instruction fetch; readbyte_internal used here to avoid
-       triggering read breakpoints */
-    opcode = readbyte_internal( PC );
+  z80.af.b.l = flags;
+  z80.flags_op = Z80_FLAGS_RESOLVED;
 
-    CHECK( if1u, if1_available )
+  if( z80.q == Z80_Q_FLAGS ) z80.q = flags;
+}
 
-    if( PC == 0x0700 ) {
-      if1_unpage();
-    }
+/* The full core, used whenever the debugger or a peripheral needs to see
+   memory accesses. The core tester can also build it with the predecode
+   cache, so that the tests run through the cache */
+#if defined( CORETEST_CACHE ) && defined( __GNUC__ )
+#define Z80_CORE_CACHE
+#endif			/* #if defined( CORETEST_CACHE ) && ... */
 
-    END_CHECK
+#define Z80_CORE_FUNCTION z80_do_opcodes_hooked
+#include "z80/z80_core.c"
+#undef Z80_CORE_FUNCTION
+#undef Z80_CORE_CACHE
 
-    CHECK( divide_late, settings_current.divide_enabled )
+#if defined( HAVE_ENOUGH_MEMORY ) && !defined( CORETEST )
 
-    if( ( PC & 0xfff8 ) == 0x1ff8 ) {
-      divide_set_automap( 0 );
-    } else if( (PC == 0x0000) || (PC == 0x0008) || (PC == 0x0038)
-      || (PC == 0x0066) || (PC == 0x04c6) || (PC == 0x0562) ) {
-      divide_set_automap( 1 );
-    }
-    
-    END_CHECK
+/* Memory accesses for the cores used when there are no debugger or
+   peripheral memory hooks */
 
-    CHECK( divmmc_late, settings_current.divmmc_enabled )
+/* Writes to ordinary RAM are done here rather than by a call to
+   writebyte_internal() */
+static inline void
+writebyte_fast( libspectrum_word address, libspectrum_byte b )
+{
+  libspectrum_byte *memory =
+    memory_map_write_page[ address >> MEMORY_PAGE_SIZE_LOGARITHM ];
+
+  if( memory ) {
+    memory[ address & MEMORY_PAGE_SIZE_MASK ] = b;
+    if( z80_cache_used ) z80_cache_write( address );
+  } else {
+    writebyte_internal( address, b );
+  }
+}
 
-    if( ( PC & 0xfff8 ) == 0x1ff8 ) {
-      divmmc_set_automap( 0 );
-    } else if( (PC == 0x0000) || (PC == 0x0008) || (PC == 0x0038)
-      || (PC == 0x0066) || (PC == 0x04c6) || (PC == 0x0562) ) {
-      divmmc_set_automap( 1 );
-    }
-    
-    END_CHECK
+static inline libspectrum_byte
+readbyte_contended( libspectrum_word address )
+{
+  if( memory_read_contended( address ) )
+    tstates += ula_contention[ tstates ];
+  tstates += 3;
 
-    CHECK( opus, opus_available )
+  return readbyte_internal( address );
+}
 
-    if( opus_active ) {
-      if( PC == 0x1748 ) {
-        opus_unpage();
-      }
-    } else if( PC == 0x0008 || PC == 0x0048 || PC == 0x1708 ) {
-      opus_page();
-    }
+static inline void
+writebyte_contended( libspectrum_word address, libspectrum_byte b )
+{
+  if( memory_write_contended( address ) )
+    tstates += ula_contention[ tstates ];
+  tstates += 3;
 
-    END_CHECK
+  writebyte_fast( address, b );
+}
 
-    CHECK( spectranet_unpage, spectranet_available )
+static inline libspectrum_byte
+readbyte_uncontended( libspectrum_word address )
+{
+  tstates += 3;
 
-    if( PC == 0x007c )
-      spectranet_unpage();
+  return readbyte_internal( address );
+}
 
-    END_CHECK
+static inline void
+writebyte_uncontended( libspectrum_word address, libspectrum_byte b )
+{
+  tstates += 3;
 
-    CHECK( z80_iff2_read, z80.iff2_read )
+  writebyte_fast( address, b );
+}
 
-    z80.iff2_read = 0;
-    /* Execute *one* instruction before reevaluating the checks */
-    event_add( tstates, z80_nmos_iff2_event );
+/* These cores can also use the predecode cache, which jumps straight
+   to the code for each instruction so needs labels as values */
+#ifdef __GNUC__
+#define Z80_CORE_CACHE
+#endif				/* #ifdef __GNUC__ */
 
-    END_CHECK
+#define Z80_CORE_FUNCTION z80_do_opcodes_contended
+#define Z80_CORE_READBYTE readbyte_contended
+#define Z80_CORE_WRITEBYTE writebyte_contended
+#include "z80/z80_core.c"
+#undef Z80_CORE_WRITEBYTE
+#undef Z80_CORE_READBYTE
+#undef Z80_CORE_FUNCTION
+
+/* For machines with no contention at all, eg the Pentagon and Scorpion */
+#undef Z80_CORE_CONTENDED
+#define Z80_CORE_CONTENDED 0
+#define Z80_CORE_FUNCTION z80_do_opcodes_uncontended
+#define Z80_CORE_READBYTE readbyte_uncontended
+#define Z80_CORE_WRITEBYTE writebyte_uncontended
+#include "z80/z80_core.c"
+#undef Z80_CORE_WRITEBYTE
+#undef Z80_CORE_READBYTE
+#undef Z80_CORE_FUNCTION
+#undef Z80_CORE_CONTENDED
+#define Z80_CORE_CONTENDED 1
+#undef Z80_CORE_CACHE
+
+static void ( * const cores[ Z80_CORE_COUNT ] )( void ) = {
+  z80_do_opcodes_hooked,
+  z80_do_opcodes_contended,
+  z80_do_opcodes_uncontended,
+};
 
-    CHECK( didaktik80snap, didaktik80_snap )
+#else			/* #if defined( HAVE_ENOUGH_MEMORY ) && ... */
 
-    if( PC == 0x0066 && !didaktik80_active ) {
-      opcode = 0xc7;	/* RST 00 */
-      didaktik80_snap = 0; /* FIXME: this should be a time-based reset */
-    }
+/* Only build the one core if we're short of memory or just testing it */
+static void ( * const cores[ Z80_CORE_COUNT ] )( void ) = {
+  z80_do_opcodes_hooked,
+  z80_do_opcodes_hooked,
+  z80_do_opcodes_hooked,
+};
 
-    END_CHECK
+#endif			/* #if defined( HAVE_ENOUGH_MEMORY ) && ... */
 
-    CHECK( svg_capture, svg_capture_active )
+static const char * const core_names[ Z80_CORE_COUNT ] = {
+  "hooked",
+  "contended",
+  "uncontended",
+};
 
-    svg_capture();
+/* Choose the core for the current machine; called whenever the contention
+   tables are rebuilt */
+void
+z80_select_core( void )
+{
+#ifndef CORETEST
+  libspectrum_dword i;
 
-    END_CHECK
+  /* The memory has just been reset too, so anything decoded is stale */
+  z80_cache_flush();
 
-  end_opcode:
-    PC++; R++;
-    last_Q = Q; /* keep Q value from previous opcode for SCF and CCF */
-    Q = 0;      /* preempt Q value assuming next opcode doesn't set flags */
+  machine_core = Z80_CORE_UNCONTENDED;
 
-    switch(opcode) {
-#include "z80/opcodes_base.c"
+  for( i = 0; i < machine_current->timings.tstates_per_frame; i++ ) {
+    if( ula_contention[ i ] || ula_contention_no_mreq[ i ] ) {
+      machine_core = Z80_CORE_CONTENDED;
+      break;
     }
+  }
+#endif				/* #ifndef CORETEST */
+}
 
+/* Execute Z80 opcodes until the next event */
+void
+z80_do_opcodes( void )
+{
+  /* Which memory hooks are needed can change only between calls as,
+     like the checks in the core itself, they are changed only by events
+     or by the debugger, which leaves the other cores if it sets any read
+     or write breakpoints. Other breakpoints are checked by every core */
+  if( debugger_memory_watched || opus_available || spectranet_available ) {
+    z80_do_opcodes_hooked();
+  } else {
+    cores[ machine_core ]();
   }
+}
 
+/* Execute Z80 opcodes until the next event with a specific core */
+void
+z80_do_opcodes_with_core( z80_core_type core )
+{
+  cores[ core ]();
+}
+
+const char*
+z80_core_name( z80_core_type core )
+{
+  return core_names[ core ];
 }
 
 #ifndef HAVE_ENOUGH_MEMORY